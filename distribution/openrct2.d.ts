@@ -212,6 +212,25 @@ declare global {
          */
         getRandom(min: number, max: number): number;
 
+        /**
+         * Starts running code on a background thread, in its own script context that has no
+         * access to the game or to the rest of the plugin. Values are passed between the
+         * two as JSON by posting messages. Within the worker, postMessage(value) sends a value
+         * back to the plugin, onmessage is called with each value posted to the worker, and
+         * console.log writes to the console. To work on the state of the park, post the parts
+         * it needs to the worker, e.g. from map.queryEntities or map.getTileData.
+         * @param code The code the worker runs.
+         * @param callback The function to be called on the game thread with each value the
+         * worker posts.
+         */
+        createWorker(code: string, callback: (message: any) => void): Worker;
+
+        /**
+         * Gets how long each plugin has spent in each hook and in its timers since the
+         * timings were last reset with the plugin_timings console command.
+         */
+        getPluginTimings(): PluginTiming[];
+
         /**
          * Formats a new string using the given format string and the arguments.
          * @param fmt The format string, e.g. "Guests: {COMMA16}"
@@ -251,22 +270,44 @@ declare global {
         executeAction(action: ActionType, args: object, callback: (result: GameActionResult) => void): void;
         executeAction(action: string, args: object, callback: (result: GameActionResult) => void): void;
 
+        /**
+         * Queries a custom action for each of the given arguments, as a single game action.
+         * The query function of the action is called with each item in turn, the costs are
+         * added up and the first error is returned.
+         * @param action The name of the custom action.
+         * @param args The parameters for each call of the action.
+         * @param callback The function to be called with the combined result.
+         */
+        queryActionBatch(action: string, args: object[], callback: (result: GameActionResult) => void): void;
+
+        /**
+         * Executes a custom action for each of the given arguments, as a single game action
+         * that is sent over the network in one go. Every item is queried first, so nothing is
+         * executed if any of them fail. The action hooks are called once for the whole batch,
+         * with args set to the array.
+         * @param action The name of the custom action.
+         * @param args The parameters for each call of the action.
+         * @param callback The function to be called with the combined result.
+         */
+        executeActionBatch(action: string, args: object[], callback: (result: GameActionResult) => void): void;
+
         /**
          * Subscribes to the given hook.
+         * @param options Lets events be skipped without calling the callback for them.
          */
-        subscribe(hook: HookType, callback: Function): IDisposable;
+        subscribe(hook: HookType, callback: Function, options?: SubscribeOptions): IDisposable;
 
-        subscribe(hook: "action.query", callback: (e: GameActionEventArgs) => void): IDisposable;
-        subscribe(hook: "action.execute", callback: (e: GameActionEventArgs) => void): IDisposable;
-        subscribe(hook: "interval.tick", callback: () => void): IDisposable;
-        subscribe(hook: "interval.day", callback: () => void): IDisposable;
-        subscribe(hook: "network.chat", callback: (e: NetworkChatEventArgs) => void): IDisposable;
-        subscribe(hook: "network.authenticate", callback: (e: NetworkAuthenticateEventArgs) => void): IDisposable;
-        subscribe(hook: "network.join", callback: (e: NetworkEventArgs) => void): IDisposable;
-        subscribe(hook: "network.leave", callback: (e: NetworkEventArgs) => void): IDisposable;
-        subscribe(hook: "ride.ratings.calculate", callback: (e: RideRatingsCalculateArgs) => void): IDisposable;
-        subscribe(hook: "action.location", callback: (e: ActionLocationArgs) => void): IDisposable;
-        subscribe(hook: "guest.generation", callback: (id: number) => void): IDisposable;
+        subscribe(hook: "action.query", callback: (e: GameActionEventArgs) => void, options?: SubscribeOptions): IDisposable;
+        subscribe(hook: "action.execute", callback: (e: GameActionEventArgs) => void, options?: SubscribeOptions): IDisposable;
+        subscribe(hook: "interval.tick", callback: () => void, options?: SubscribeOptions): IDisposable;
+        subscribe(hook: "interval.day", callback: () => void, options?: SubscribeOptions): IDisposable;
+        subscribe(hook: "network.chat", callback: (e: NetworkChatEventArgs) => void, options?: SubscribeOptions): IDisposable;
+        subscribe(hook: "network.authenticate", callback: (e: NetworkAuthenticateEventArgs) => void, options?: SubscribeOptions): IDisposable;
+        subscribe(hook: "network.join", callback: (e: NetworkEventArgs) => void, options?: SubscribeOptions): IDisposable;
+        subscribe(hook: "network.leave", callback: (e: NetworkEventArgs) => void, options?: SubscribeOptions): IDisposable;
+        subscribe(hook: "ride.ratings.calculate", callback: (e: RideRatingsCalculateArgs) => void, options?: SubscribeOptions): IDisposable;
+        subscribe(hook: "action.location", callback: (e: ActionLocationArgs) => void, options?: SubscribeOptions): IDisposable;
+        subscribe(hook: "guest.generation", callback: (id: number) => void, options?: SubscribeOptions): IDisposable;
 
         /**
          * Registers a function to be called every so often in realtime, specified by the given delay.
@@ -297,6 +338,68 @@ declare global {
         clearTimeout(handle: number): void;
     }
 
+    interface Worker {
+        /**
+         * Sends a value to the worker's onmessage function.
+         */
+        postMessage(message: any): void;
+
+        /**
+         * Stops the worker once it has finished what it is running. No more messages are
+         * received from it.
+         */
+        terminate(): void;
+    }
+
+    interface PluginTiming {
+        /**
+         * The name of the plugin.
+         */
+        plugin: string;
+
+        /**
+         * The hook that was called, or "timers" for callbacks registered with
+         * `setInterval` and `setTimeout`.
+         */
+        type: HookType | "timers";
+
+        /**
+         * The number of times the callbacks were called.
+         */
+        calls: number;
+
+        /**
+         * The total time spent in the callbacks, in milliseconds.
+         */
+        totalTime: number;
+
+        /**
+         * The longest time spent in a single call, in milliseconds.
+         */
+        maxTime: number;
+    }
+
+    /**
+     * Options for skipping events of a hook natively, so the script is not called for
+     * events it is not interested in.
+     */
+    interface SubscribeOptions {
+        /**
+         * Only every nth event is passed to the callback, e.g. 10 for every tenth tick.
+         * Events are counted rather than timed, so every client in a multiplayer game
+         * skips the same events.
+         * @default 1
+         */
+        every?: number;
+
+        /**
+         * For action.query and action.execute, the names of the actions to pass to the
+         * callback. Events for any other action are skipped without being counted
+         * towards every. Ignored by other hooks.
+         */
+        filter?: string[];
+    }
+
     interface Configuration {
         getAll(namespace: string): { [name: string]: any };
         get<T>(key: string): T | undefined;
@@ -468,6 +571,10 @@ declare global {
         readonly action: string;
         readonly isClientOnly: boolean;
         readonly args: object;
+        /**
+         * Whether args holds the arguments for each item of a custom action batch.
+         */
+        readonly isBatch?: boolean;
         result: GameActionResult;
     }
 
@@ -563,6 +670,78 @@ declare global {
         getEntity(id: number): Entity;
         getAllEntities(type: EntityType): Entity[];
         getAllEntities(type: "peep"): Peep[];
+
+        /**
+         * Reads the given fields of every entity of a type at once, which is much faster than reading them from each
+         * entity returned by getAllEntities. Each field is returned as an array with one value per entity, in the same
+         * order for every field. Fields that do not apply to an entity, such as happiness for staff, are 0.
+         * @param type The type of entity, the same as for getAllEntities.
+         * @param fields The fields to read: id, x, y, z, energy, energyTarget, mass, happiness, happinessTarget, nausea,
+         * nauseaTarget, hunger, thirst, toilet, cash, minIntensity, maxIntensity or nauseaTolerance.
+         */
+        queryEntities(type: EntityType | "peep", fields: string[]): EntityQueryResult;
+
+        /**
+         * Copies every entity of a type as it is now. The copy does not change as the game
+         * carries on, so expensive statistics can be worked out from it a part at a time over
+         * many ticks rather than all within one tick.
+         * @param type The type of entity, the same as for getAllEntities.
+         */
+        captureEntities(type: EntityType | "peep"): EntitySnapshot;
+
+        /**
+         * Reads the elements of every tile in a range of tiles in one go. The tiles are stored
+         * one after another, row by row starting at x, y, with each tile's elements in the same
+         * order as Tile.elements. Every element is 16 bytes:
+         *   byte 0: bits 2-5 are the element type (0 = surface, 1 = footpath, 2 = track,
+         *           3 = small scenery, 4 = entrance, 5 = wall, 6 = large scenery, 7 = banner),
+         *           bits 0-1 the direction.
+         *   byte 1: bits 0-3 are the occupied quadrants, bit 4 is set for ghosts and bit 7 is set
+         *           on the last element of each tile.
+         *   byte 2: the base height.
+         *   byte 3: the clearance height.
+         *   byte 4: the owner.
+         *   bytes 5-15: data specific to the element type, as stored in park files.
+         * @param x The x coordinate of the first tile, in tiles.
+         * @param y The y coordinate of the first tile, in tiles.
+         * @param width The number of tiles to read along x.
+         * @param height The number of tiles to read along y.
+         */
+        getTileData(x: number, y: number, width: number, height: number): ArrayBuffer;
+
+        /**
+         * Replaces the elements of every tile in a range of tiles, using the same layout as
+         * getTileData. Each tile must have exactly one surface element. The whole buffer is
+         * checked before anything changes, so the map is left as it was if it is invalid.
+         * This changes the game state, so it can only be called from a context that can, such
+         * as the execute function of a custom game action.
+         */
+        setTileData(x: number, y: number, width: number, height: number, data: ArrayBuffer): void;
+    }
+
+    interface EntityQueryResult {
+        /** The number of entities that were read. */
+        readonly count: number;
+        [field: string]: Int32Array | number;
+    }
+
+    /**
+     * A copy of entities returned by map.captureEntities.
+     */
+    interface EntitySnapshot {
+        /** The game tick the entities were copied on. */
+        readonly tick: number;
+
+        /** The number of entities that were copied. */
+        readonly count: number;
+
+        /**
+         * Reads fields of the copied entities, the same as map.queryEntities.
+         * @param fields The fields to read.
+         * @param start The index of the first entity to read.
+         * @param count The number of entities to read, defaults to all of them after start.
+         */
+        query(fields: string[], start?: number, count?: number): EntityQueryResult;
     }
 
     type TileElementType =
@@ -2399,19 +2578,41 @@ declare global {
      * Based on node.js net.Socket, see https://nodejs.org/api/net.html for more information.
      */
     interface Socket {
+        /**
+         * The number of bytes that have been written but not sent yet.
+         */
+        readonly writableLength: number;
+
         connect(port: number, host: string, callback: Function): Socket;
         destroy(error: object): Socket;
         setNoDelay(noDelay: boolean): Socket;
-        end(data?: string): Socket;
-        write(data: string): boolean;
+
+        /**
+         * Sets how received data is passed to data listeners. "utf8", the default, passes
+         * strings. "arraybuffer" passes the received bytes as they are, without decoding them.
+         */
+        setEncoding(encoding: "utf8" | "arraybuffer"): Socket;
+
+        /**
+         * Closes the connection once everything that has been written has been sent.
+         */
+        end(data?: string | ArrayBuffer | ArrayBufferView): Socket;
+
+        /**
+         * Sends the given data. Returns false if the data had to be queued, in which case a
+         * drain event is raised once everything queued has been sent.
+         */
+        write(data: string | ArrayBuffer | ArrayBufferView): boolean;
 
         on(event: "close", callback: (hadError: boolean) => void): Socket;
         on(event: "error", callback: (hadError: boolean) => void): Socket;
-        on(event: "data", callback: (data: string) => void): Socket;
+        on(event: "data", callback: (data: string | ArrayBuffer) => void): Socket;
+        on(event: "drain", callback: () => void): Socket;
 
         off(event: "close", callback: (hadError: boolean) => void): Socket;
         off(event: "error", callback: (hadError: boolean) => void): Socket;
-        off(event: "data", callback: (data: string) => void): Socket;
+        off(event: "data", callback: (data: string | ArrayBuffer) => void): Socket;
+        off(event: "drain", callback: () => void): Socket;
     }
 
     interface TitleSequence {
@@ -51,6 +51,11 @@ namespace OpenRCT2::Audio
     struct ISDLAudioSource : public IAudioSource
     {
         [[nodiscard]] virtual AudioFormat GetFormat() const abstract;
+
+        /**
+         * Converts the source to the given format so the mixer does not have to convert it while mixing.
+         */
+        virtual bool Convert(const AudioFormat* format) abstract;
     };
 
     struct ISDLAudioChannel : public IAudioChannel
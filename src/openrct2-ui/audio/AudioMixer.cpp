@@ -12,6 +12,7 @@
 
 #include <SDL.h>
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <list>
 #include <openrct2/Context.h>
@@ -48,6 +49,14 @@ namespace OpenRCT2::Audio
         std::vector<uint8_t> _convertBuffer;
         std::vector<uint8_t> _effectBuffer;
 
+        // Resamplers of finished channels, kept for reuse by new channels
+        std::vector<SpeexResamplerState*> _resamplerPool;
+
+        // Float submixes, one per mixer group, used when the device format is 16-bit
+        static constexpr size_t NUM_MIXER_GROUPS = static_cast<size_t>(MixerGroup::TitleMusic) + 1;
+        std::array<std::vector<float>, NUM_MIXER_GROUPS> _groupBuses;
+        std::array<bool, NUM_MIXER_GROUPS> _groupBusUsed{};
+
     public:
         AudioMixerImpl()
         {
@@ -90,8 +99,9 @@ namespace OpenRCT2::Audio
         {
             // Free channels
             Lock();
-            for (IAudioChannel* channel : _channels)
+            for (auto* channel : _channels)
             {
+                ReleaseResampler(channel);
                 delete channel;
             }
             _channels.clear();
@@ -122,6 +132,18 @@ namespace OpenRCT2::Audio
             _convertBuffer.shrink_to_fit();
             _effectBuffer.clear();
             _effectBuffer.shrink_to_fit();
+
+            // Free pooled resamplers, the next device may have a different number of channels
+            for (auto* resampler : _resamplerPool)
+            {
+                speex_resampler_destroy(resampler);
+            }
+            _resamplerPool.clear();
+            for (auto& bus : _groupBuses)
+            {
+                bus.clear();
+                bus.shrink_to_fit();
+            }
         }
 
         void Lock() override
@@ -136,6 +158,17 @@ namespace OpenRCT2::Audio
 
         IAudioChannel* Play(IAudioSource* source, int32_t loop, bool deleteondone, bool deletesourceondone) override
         {
+            // Sounds are converted when they are loaded, streams are converted ahead of the mixer from here on.
+            // The length check is there because NullAudioSource does not implement GetFormat.
+            if (source->GetLength() > 0)
+            {
+                auto sdlSource = static_cast<ISDLAudioSource*>(source);
+                if (sdlSource->GetFormat() != _format)
+                {
+                    sdlSource->Convert(&_format);
+                }
+            }
+
             Lock();
             ISDLAudioChannel* channel = AudioChannel::Create();
             if (channel != nullptr)
@@ -213,6 +246,7 @@ namespace OpenRCT2::Audio
 
             // Zero the output buffer
             std::fill_n(dst, length, 0);
+            _groupBusUsed.fill(false);
 
             // Mix channels onto output buffer
             auto it = _channels.begin();
@@ -227,6 +261,7 @@ namespace OpenRCT2::Audio
                 }
                 if ((channel->IsDone() && channel->DeleteOnDone()) || channel->IsStopping())
                 {
+                    ReleaseResampler(channel);
                     delete channel;
                     it = _channels.erase(it);
                 }
@@ -235,6 +270,11 @@ namespace OpenRCT2::Audio
                     it++;
                 }
             }
+
+            if (_format.format == AUDIO_S16SYS)
+            {
+                MixGroupBuses(reinterpret_cast<int16_t*>(dst), length / sizeof(int16_t));
+            }
         }
 
         void UpdateAdjustedSound()
@@ -322,6 +362,15 @@ namespace OpenRCT2::Audio
                 buffer = _effectBuffer.data();
             }
 
+            if (_format.format == AUDIO_S16SYS)
+            {
+                // Pan, volume and mixing are done in one pass on to the channel's group bus
+                auto numOutputSamples = std::min(length, bufferLen) / sizeof(int16_t);
+                AccumulateS16(channel, static_cast<const int16_t*>(buffer), numOutputSamples, length / sizeof(int16_t));
+                channel->UpdateOldVolume();
+                return;
+            }
+
             // Apply panning and volume
             ApplyPan(channel, buffer, bufferLen, byteRate);
             int32_t mixVolume = ApplyVolume(channel, buffer, bufferLen);
@@ -344,11 +393,24 @@ namespace OpenRCT2::Audio
         {
             int32_t byteRate = _format.GetByteRate();
 
-            // Create resampler
+            if (UseLinearResampling(channel))
+            {
+                return ApplyLinearResample(srcBuffer, srcSamples, dstSamples, inRate, outRate) * byteRate;
+            }
+
+            // Take a resampler from the pool or create one
             SpeexResamplerState* resampler = channel->GetResampler();
             if (resampler == nullptr)
             {
-                resampler = speex_resampler_init(_format.channels, _format.freq, _format.freq, 0, nullptr);
+                if (!_resamplerPool.empty())
+                {
+                    resampler = _resamplerPool.back();
+                    _resamplerPool.pop_back();
+                }
+                else
+                {
+                    resampler = speex_resampler_init(_format.channels, _format.freq, _format.freq, 0, nullptr);
+                }
                 channel->SetResampler(resampler);
             }
             speex_resampler_set_rate(resampler, inRate, outRate);
@@ -362,6 +424,67 @@ namespace OpenRCT2::Audio
             return outLen * byteRate;
         }
 
+        bool UseLinearResampling(const ISDLAudioChannel* channel) const
+        {
+            switch (gConfigSound.resampling_quality)
+            {
+                case ResamplingQuality::Low:
+                    return true;
+                case ResamplingQuality::High:
+                    return false;
+                default:
+                {
+                    // Quiet and distant sounds are not worth the cost of the full resampler
+                    float volume = channel->GetVolume() * GetGroupVolume(channel->GetGroup());
+                    return volume < MIXER_VOLUME_MAX / 4;
+                }
+            }
+        }
+
+        /**
+         * Resample the given buffer into _effectBuffer by interpolating between neighbouring frames, returns the
+         * number of frames written. Assumes that srcBuffer is 16-bit in the same format as _format.
+         */
+        size_t ApplyLinearResample(
+            const void* srcBuffer, int32_t srcSamples, int32_t dstSamples, int32_t inRate, int32_t outRate)
+        {
+            if (srcSamples <= 0 || inRate <= 0 || outRate <= 0)
+            {
+                return 0;
+            }
+
+            auto src = static_cast<const int16_t*>(srcBuffer);
+            auto dst = reinterpret_cast<int16_t*>(_effectBuffer.data());
+            auto numChannels = _format.channels;
+            double step = static_cast<double>(inRate) / outRate;
+            auto numFrames = std::min<int32_t>(dstSamples, static_cast<int32_t>(srcSamples / step));
+            for (int32_t i = 0; i < numFrames; i++)
+            {
+                double position = i * step;
+                auto index0 = static_cast<int32_t>(position);
+                auto index1 = std::min(index0 + 1, srcSamples - 1);
+                auto t = static_cast<float>(position - index0);
+                for (int32_t c = 0; c < numChannels; c++)
+                {
+                    float sample0 = src[index0 * numChannels + c];
+                    float sample1 = src[index1 * numChannels + c];
+                    dst[i * numChannels + c] = static_cast<int16_t>(sample0 + (sample1 - sample0) * t);
+                }
+            }
+            return numFrames;
+        }
+
+        void ReleaseResampler(ISDLAudioChannel* channel)
+        {
+            auto* resampler = channel->GetResampler();
+            if (resampler != nullptr)
+            {
+                speex_resampler_reset_mem(resampler);
+                _resamplerPool.push_back(resampler);
+                channel->SetResampler(nullptr);
+            }
+        }
+
         void ApplyPan(const IAudioChannel* channel, void* buffer, size_t len, size_t sampleSize)
         {
             if (channel->GetPan() != 0.5f && _format.channels == 2)
@@ -378,13 +501,115 @@ namespace OpenRCT2::Audio
             }
         }
 
-        int32_t ApplyVolume(const IAudioChannel* channel, void* buffer, size_t len)
+        /**
+         * Adds the channel's samples on to its group bus, applying the channel's volume and pan, both faded over the
+         * length of the buffer from their previous values.
+         */
+        void AccumulateS16(const IAudioChannel* channel, const int16_t* src, size_t numSamples, size_t busLength)
+        {
+            auto groupIndex = static_cast<size_t>(channel->GetGroup());
+            auto& bus = _groupBuses[groupIndex];
+            if (!_groupBusUsed[groupIndex])
+            {
+                bus.resize(busLength);
+                std::fill(bus.begin(), bus.end(), 0.0f);
+                _groupBusUsed[groupIndex] = true;
+            }
+            numSamples = std::min(numSamples, bus.size());
+
+            constexpr float volumeScale = 1.0f / MIXER_VOLUME_MAX;
+            float startVolume = channel->GetOldVolume() * volumeScale;
+            float endVolume = channel->IsStopping() ? 0.0f : channel->GetVolume() * volumeScale;
+
+            float* dst = bus.data();
+            if (_format.channels == 2)
+            {
+                bool pan = channel->GetPan() != 0.5f;
+                float startL = startVolume * (pan ? channel->GetOldVolumeL() : 1.0f);
+                float startR = startVolume * (pan ? channel->GetOldVolumeR() : 1.0f);
+                float endL = endVolume * (pan ? channel->GetVolumeL() : 1.0f);
+                float endR = endVolume * (pan ? channel->GetVolumeR() : 1.0f);
+
+                auto numFrames = numSamples / 2;
+                float dt = numFrames != 0 ? 1.0f / static_cast<float>(numFrames) : 0.0f;
+                float deltaL = (endL - startL) * dt;
+                float deltaR = (endR - startR) * dt;
+                for (size_t i = 0; i < numFrames; i++)
+                {
+                    float t = static_cast<float>(i);
+                    dst[i * 2 + 0] += static_cast<float>(src[i * 2 + 0]) * (startL + deltaL * t);
+                    dst[i * 2 + 1] += static_cast<float>(src[i * 2 + 1]) * (startR + deltaR * t);
+                }
+            }
+            else
+            {
+                float dt = numSamples != 0 ? 1.0f / static_cast<float>(numSamples) : 0.0f;
+                float delta = (endVolume - startVolume) * dt;
+                for (size_t i = 0; i < numSamples; i++)
+                {
+                    dst[i] += static_cast<float>(src[i]) * (startVolume + delta * static_cast<float>(i));
+                }
+            }
+        }
+
+        /**
+         * Mixes the group buses used for this chunk on to the output buffer, clipping once at the end.
+         */
+        void MixGroupBuses(int16_t* dst, size_t numSamples)
+        {
+            bool anyUsed = false;
+            std::array<float, NUM_MIXER_GROUPS> groupVolumes{};
+            for (size_t i = 0; i < NUM_MIXER_GROUPS; i++)
+            {
+                if (_groupBusUsed[i])
+                {
+                    groupVolumes[i] = GetGroupVolume(static_cast<MixerGroup>(i));
+                    anyUsed = true;
+                }
+            }
+            if (!anyUsed)
+            {
+                return;
+            }
+
+            auto& mix = _groupBuses[0];
+            if (!_groupBusUsed[0])
+            {
+                mix.resize(numSamples);
+                std::fill(mix.begin(), mix.end(), 0.0f);
+            }
+            else if (groupVolumes[0] != 1.0f)
+            {
+                for (auto& sample : mix)
+                {
+                    sample *= groupVolumes[0];
+                }
+            }
+            for (size_t i = 1; i < NUM_MIXER_GROUPS; i++)
+            {
+                if (_groupBusUsed[i])
+                {
+                    const float* src = _groupBuses[i].data();
+                    float volume = groupVolumes[i];
+                    for (size_t j = 0; j < numSamples; j++)
+                    {
+                        mix[j] += src[j] * volume;
+                    }
+                }
+            }
+            for (size_t i = 0; i < numSamples; i++)
+            {
+                dst[i] = static_cast<int16_t>(std::clamp(mix[i], -32768.0f, 32767.0f));
+            }
+        }
+
+        float GetGroupVolume(MixerGroup group) const
         {
             float volumeAdjust = _volume;
             volumeAdjust *= gConfigSound.master_sound_enabled ? (static_cast<float>(gConfigSound.master_volume) / 100.0f)
                                                               : 0.0f;
 
-            switch (channel->GetGroup())
+            switch (group)
             {
                 case MixerGroup::Sound:
                     volumeAdjust *= _adjustSoundVolume;
@@ -400,6 +625,12 @@ namespace OpenRCT2::Audio
                     volumeAdjust *= _adjustMusicVolume;
                     break;
             }
+            return volumeAdjust;
+        }
+
+        int32_t ApplyVolume(const IAudioChannel* channel, void* buffer, size_t len)
+        {
+            float volumeAdjust = GetGroupVolume(channel->GetGroup());
 
             int32_t startVolume = channel->GetOldVolume() * volumeAdjust;
             int32_t endVolume = channel->GetVolume() * volumeAdjust;
@@ -489,8 +720,8 @@ namespace OpenRCT2::Audio
 
         bool Convert(SDL_AudioCVT* cvt, const void* src, size_t len)
         {
-            // tofix: there seems to be an issue with converting audio using SDL_ConvertAudio in the callback vs preconverted,
-            // can cause pops and static depending on sample rate and channels
+            // Only used for sources that could not be converted up front. Converting in the callback can cause pops and
+            // static depending on sample rate and channels.
             bool result = false;
             if (len != 0 && cvt->len_mult != 0)
             {
@@ -12,32 +12,58 @@
 
 #include <SDL.h>
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <openrct2/audio/AudioSource.h>
 #include <openrct2/common.h>
+#include <thread>
+#include <vector>
 
 namespace OpenRCT2::Audio
 {
     /**
      * An audio source where raw PCM data is streamed directly from
-     * a file.
+     * a file. When converted to another format, the data is read and converted
+     * ahead of the mixer on a background thread.
      */
     class FileAudioSource final : public ISDLAudioSource
     {
     private:
+        // Number of source frames read and converted at a time
+        static constexpr size_t DECODE_CHUNK_FRAMES = 16384;
+        // Number of converted chunks kept ahead of the mixer
+        static constexpr size_t DECODE_CHUNKS_AHEAD = 4;
+
         AudioFormat _format = {};
         SDL_RWops* _rw = nullptr;
         uint64_t _dataBegin = 0;
         uint64_t _dataLength = 0;
 
+        // Conversion to the output format
+        AudioFormat _sourceFormat = {};
+        SDL_AudioCVT _cvt = {};
+        uint64_t _convertedLength = 0;
+        std::thread _decodeThread;
+        std::mutex _decodeMutex;
+        std::condition_variable _decodeCondition;
+        std::vector<uint8_t> _ringBuffer;
+        size_t _ringStart = 0;
+        size_t _ringCount = 0;
+        uint64_t _ringOffset = 0;
+        uint64_t _decodeSourceOffset = 0;
+        uint32_t _decodeGeneration = 0;
+        bool _decodeStop = false;
+
     public:
         ~FileAudioSource() override
         {
+            StopDecoding();
             Unload();
         }
 
         [[nodiscard]] uint64_t GetLength() const override
         {
-            return _dataLength;
+            return _decodeThread.joinable() ? _convertedLength : _dataLength;
         }
 
         [[nodiscard]] AudioFormat GetFormat() const override
@@ -47,6 +73,11 @@ namespace OpenRCT2::Audio
 
         size_t Read(void* dst, uint64_t offset, size_t len) override
         {
+            if (_decodeThread.joinable())
+            {
+                return ReadConverted(dst, offset, len);
+            }
+
             size_t bytesRead = 0;
             int64_t currentPosition = SDL_RWtell(_rw);
             if (currentPosition != -1)
@@ -143,7 +174,165 @@ namespace OpenRCT2::Audio
             return true;
         }
 
+        bool Convert(const AudioFormat* format) override
+        {
+            if (*format == _format || _decodeThread.joinable())
+            {
+                return false;
+            }
+            if (SDL_BuildAudioCVT(
+                    &_cvt, _format.format, _format.channels, _format.freq, format->format, format->channels, format->freq)
+                < 0)
+            {
+                return false;
+            }
+
+            _sourceFormat = _format;
+            _format = *format;
+            auto sourceFrames = _dataLength / _sourceFormat.GetByteRate();
+            _convertedLength = (sourceFrames * _format.freq / _sourceFormat.freq) * _format.GetByteRate();
+
+            auto maxChunkLength = static_cast<size_t>(
+                DECODE_CHUNK_FRAMES * _sourceFormat.GetByteRate() * _cvt.len_ratio + 16 * _format.GetByteRate());
+            _ringBuffer.resize(maxChunkLength * DECODE_CHUNKS_AHEAD);
+            _ringStart = 0;
+            _ringCount = 0;
+            _ringOffset = 0;
+            _decodeSourceOffset = 0;
+            _decodeStop = false;
+            _decodeThread = std::thread([this, maxChunkLength]() { DecodeLoop(maxChunkLength); });
+            return true;
+        }
+
     private:
+        uint64_t GetSourceOffset(uint64_t offset) const
+        {
+            auto frame = offset / _format.GetByteRate();
+            auto sourceFrame = frame * _sourceFormat.freq / _format.freq;
+            return std::min(sourceFrame * _sourceFormat.GetByteRate(), _dataLength);
+        }
+
+        size_t ReadConverted(void* dst, uint64_t offset, size_t len)
+        {
+            if (offset >= _convertedLength)
+            {
+                return 0;
+            }
+            len = static_cast<size_t>(std::min<uint64_t>(len, _convertedLength - offset));
+
+            std::unique_lock<std::mutex> lock(_decodeMutex);
+            if (offset != _ringOffset)
+            {
+                // The channel has seeked, throw away what has been decoded and start again from the new position
+                _ringStart = 0;
+                _ringCount = 0;
+                _ringOffset = offset;
+                _decodeSourceOffset = GetSourceOffset(offset);
+                _decodeGeneration++;
+                _decodeCondition.notify_all();
+            }
+
+            // Only wait when nothing has been decoded yet, e.g. straight after a seek
+            _decodeCondition.wait(lock, [this]() { return _ringCount != 0 || _decodeSourceOffset >= _dataLength; });
+
+            auto dst8 = static_cast<uint8_t*>(dst);
+            size_t bytesRead = 0;
+            if (_ringCount == 0)
+            {
+                // The converted data came out slightly shorter than estimated, pad the end with silence
+                std::fill_n(dst8, len, static_cast<uint8_t>(_format.format == AUDIO_U8 ? 0x80 : 0));
+                bytesRead = len;
+            }
+            else
+            {
+                bytesRead = std::min(len, _ringCount);
+                auto firstLen = std::min(bytesRead, _ringBuffer.size() - _ringStart);
+                std::copy_n(_ringBuffer.data() + _ringStart, firstLen, dst8);
+                std::copy_n(_ringBuffer.data(), bytesRead - firstLen, dst8 + firstLen);
+                _ringStart = (_ringStart + bytesRead) % _ringBuffer.size();
+                _ringCount -= bytesRead;
+                _decodeCondition.notify_all();
+            }
+            _ringOffset += bytesRead;
+            return bytesRead;
+        }
+
+        void DecodeLoop(size_t maxChunkLength)
+        {
+            auto sourceByteRate = static_cast<size_t>(_sourceFormat.GetByteRate());
+            std::vector<uint8_t> chunk(DECODE_CHUNK_FRAMES * sourceByteRate * _cvt.len_mult);
+            std::unique_lock<std::mutex> lock(_decodeMutex);
+            while (true)
+            {
+                _decodeCondition.wait(lock, [this, maxChunkLength]() {
+                    return _decodeStop
+                        || (_decodeSourceOffset < _dataLength && _ringCount + maxChunkLength <= _ringBuffer.size());
+                });
+                if (_decodeStop)
+                {
+                    break;
+                }
+
+                auto generation = _decodeGeneration;
+                auto sourceOffset = _decodeSourceOffset;
+                lock.unlock();
+
+                // Read and convert the next chunk without holding the lock so the mixer is not kept waiting
+                auto chunkLength = static_cast<size_t>(
+                    std::min<uint64_t>(DECODE_CHUNK_FRAMES * sourceByteRate, _dataLength - sourceOffset));
+                size_t bytesRead = 0;
+                if (SDL_RWseek(_rw, _dataBegin + sourceOffset, RW_SEEK_SET) != -1)
+                {
+                    bytesRead = SDL_RWread(_rw, chunk.data(), 1, chunkLength);
+                }
+                size_t convertedLength = 0;
+                if (bytesRead != 0)
+                {
+                    auto cvt = _cvt;
+                    cvt.buf = chunk.data();
+                    cvt.len = static_cast<int32_t>(bytesRead);
+                    if (SDL_ConvertAudio(&cvt) >= 0)
+                    {
+                        convertedLength = std::min<size_t>(cvt.len_cvt, maxChunkLength);
+                    }
+                }
+
+                lock.lock();
+                if (generation != _decodeGeneration)
+                {
+                    continue;
+                }
+                if (bytesRead == 0)
+                {
+                    // Treat a read error as the end of the data so the mixer is not left waiting
+                    _decodeSourceOffset = _dataLength;
+                }
+                else
+                {
+                    auto end = (_ringStart + _ringCount) % _ringBuffer.size();
+                    auto firstLen = std::min(convertedLength, _ringBuffer.size() - end);
+                    std::copy_n(chunk.data(), firstLen, _ringBuffer.data() + end);
+                    std::copy_n(chunk.data() + firstLen, convertedLength - firstLen, _ringBuffer.data());
+                    _ringCount += convertedLength;
+                    _decodeSourceOffset += bytesRead;
+                }
+                _decodeCondition.notify_all();
+            }
+        }
+
+        void StopDecoding()
+        {
+            if (_decodeThread.joinable())
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_decodeMutex);
+                    _decodeStop = true;
+                }
+                _decodeCondition.notify_all();
+                _decodeThread.join();
+            }
+        }
+
         static uint32_t FindChunk(SDL_RWops* rw, uint32_t wantedId)
         {
             uint32_t subchunkId = SDL_ReadLE32(rw);
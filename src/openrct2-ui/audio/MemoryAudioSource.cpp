@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <openrct2/audio/AudioSource.h>
 #include <openrct2/common.h>
+#include <openrct2/core/MemoryUsage.h>
 #include <vector>
 
 namespace OpenRCT2::Audio
@@ -29,6 +30,7 @@ namespace OpenRCT2::Audio
         std::vector<uint8_t> _data;
         uint8_t* _dataSDL = nullptr;
         size_t _length = 0;
+        size_t _memoryUsage = 0;
 
         const uint8_t* GetData()
         {
@@ -86,6 +88,7 @@ namespace OpenRCT2::Audio
                     _format.format = spec->format;
                     _format.channels = spec->channels;
                     _length = audioLen;
+                    SetMemoryUsage(_length);
                     result = true;
                 }
                 else
@@ -135,6 +138,7 @@ namespace OpenRCT2::Audio
                     {
                         _data.resize(_length);
                         SDL_RWread(rw, _data.data(), _length, 1);
+                        SetMemoryUsage(_data.capacity());
                         result = true;
                     }
                     catch (const std::bad_alloc&)
@@ -151,7 +155,7 @@ namespace OpenRCT2::Audio
             return result;
         }
 
-        bool Convert(const AudioFormat* format)
+        bool Convert(const AudioFormat* format) override
         {
             if (*format != _format)
             {
@@ -173,6 +177,7 @@ namespace OpenRCT2::Audio
                         _data = std::move(cvtBuffer);
                         _length = cvt.len_cvt;
                         _format = *format;
+                        SetMemoryUsage(_data.capacity());
                         return true;
                     }
                 }
@@ -192,6 +197,16 @@ namespace OpenRCT2::Audio
             _dataSDL = nullptr;
 
             _length = 0;
+            SetMemoryUsage(0);
+        }
+
+        void SetMemoryUsage(size_t memoryUsage)
+        {
+            if (memoryUsage > _memoryUsage)
+                MemoryUsage::Add(MemoryUsage::Category::Audio, memoryUsage - _memoryUsage);
+            else
+                MemoryUsage::Remove(MemoryUsage::Category::Audio, _memoryUsage - memoryUsage);
+            _memoryUsage = memoryUsage;
         }
     };
 
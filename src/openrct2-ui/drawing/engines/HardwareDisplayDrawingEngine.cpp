@@ -10,7 +10,10 @@
 #include "DrawingEngineFactory.hpp"
 
 #include <SDL.h>
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <openrct2/Game.h>
 #include <openrct2/common.h>
 #include <openrct2/config/Config.h>
@@ -50,6 +53,14 @@ private:
 
     std::vector<uint32_t> _dirtyVisualsTime;
 
+    // What the screen texture was last updated with, so only the blocks that changed since have to be converted and
+    // uploaded. Colours that have changed since are set in _changedColours.
+    std::vector<uint8_t> _presentedBits;
+    std::vector<uint8_t> _convertedPixels;
+    std::array<bool, 256> _changedColours{};
+    bool _anyColourChanged = false;
+    bool _textureOutdated = true;
+
     bool smoothNN = false;
 
 public:
@@ -153,6 +164,7 @@ public:
         _screenTextureFormat = SDL_AllocFormat(format);
 
         ConfigureBits(width, height, width);
+        _textureOutdated = true;
     }
 
     void SetPalette(const GamePalette& palette) override
@@ -161,7 +173,13 @@ public:
         {
             for (int32_t i = 0; i < 256; i++)
             {
-                _paletteHWMapped[i] = SDL_MapRGB(_screenTextureFormat, palette[i].Red, palette[i].Green, palette[i].Blue);
+                auto colour = SDL_MapRGB(_screenTextureFormat, palette[i].Red, palette[i].Green, palette[i].Blue);
+                if (_paletteHWMapped[i] != colour)
+                {
+                    _paletteHWMapped[i] = colour;
+                    _changedColours[i] = true;
+                    _anyColourChanged = true;
+                }
             }
 
 #ifdef __ENABLE_LIGHTFX__
@@ -217,12 +235,12 @@ private:
                 lightfx_render_to_texture(pixels, pitch, _bits, _width, _height, _paletteHWMapped, _lightPaletteHWMapped);
                 SDL_UnlockTexture(_screenTexture);
             }
+            _textureOutdated = true;
         }
         else
 #endif
         {
-            CopyBitsToTexture(
-                _screenTexture, _bits, static_cast<int32_t>(_width), static_cast<int32_t>(_height), _paletteHWMapped);
+            UpdateScreenTexture();
         }
         if (smoothNN)
         {
@@ -256,51 +274,127 @@ private:
         }
     }
 
-    void CopyBitsToTexture(SDL_Texture* texture, uint8_t* src, int32_t width, int32_t height, const uint32_t* palette)
+    void UpdateScreenTexture()
     {
-        void* pixels;
-        int32_t pitch;
-        if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) == 0)
+        const auto bitsSize = static_cast<size_t>(_pitch) * _height;
+        if (_textureOutdated || _presentedBits.size() != bitsSize)
         {
-            int32_t padding = pitch - (width * 4);
-            if (pitch == width * 4)
+            void* pixels;
+            int32_t pitch;
+            if (SDL_LockTexture(_screenTexture, nullptr, &pixels, &pitch) == 0)
             {
-                uint32_t* dst = static_cast<uint32_t*>(pixels);
-                for (int32_t i = width * height; i > 0; i--)
-                {
-                    *dst++ = palette[*src++];
-                }
+                SDL_Rect rect = { 0, 0, static_cast<int32_t>(_width), static_cast<int32_t>(_height) };
+                ConvertBits(static_cast<uint8_t*>(pixels), pitch, rect);
+                SDL_UnlockTexture(_screenTexture);
             }
-            else
+            _presentedBits.assign(_bits, _bits + bitsSize);
+            _textureOutdated = false;
+        }
+        else
+        {
+            // Anything can draw to the screen without invalidating it, such as the cursor of a text box or the weather,
+            // so what changed is found by comparing with what was presented last. Each row of blocks gets one rectangle,
+            // from the first to the last block that changed in it.
+            const auto blockWidth = static_cast<int32_t>(_dirtyGrid.BlockWidth);
+            const auto blockHeight = static_cast<int32_t>(_dirtyGrid.BlockHeight);
+            const auto width = static_cast<int32_t>(_width);
+            const auto height = static_cast<int32_t>(_height);
+            for (int32_t top = 0; top < height; top += blockHeight)
             {
-                if (pitch == (width * 2) + padding)
+                const auto bottom = std::min(top + blockHeight, height);
+                int32_t left = width;
+                int32_t right = 0;
+                for (int32_t x = 0; x < width; x += blockWidth)
                 {
-                    uint16_t* dst = static_cast<uint16_t*>(pixels);
-                    for (int32_t y = height; y > 0; y--)
+                    const auto blockRight = std::min(x + blockWidth, width);
+                    if (IsBlockChanged(x, top, blockRight, bottom))
                     {
-                        for (int32_t x = width; x > 0; x--)
-                        {
-                            const uint8_t lower = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
-                            const uint8_t upper = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
-                            *dst++ = (lower << 8) | upper;
-                        }
-                        dst = reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(dst) + padding);
+                        left = std::min(left, x);
+                        right = blockRight;
                     }
                 }
-                else if (pitch == width + padding)
+                if (left < right)
                 {
-                    uint8_t* dst = static_cast<uint8_t*>(pixels);
-                    for (int32_t y = height; y > 0; y--)
+                    UpdateScreenTextureRect({ left, top, right - left, bottom - top });
+                }
+            }
+        }
+
+        _changedColours.fill(false);
+        _anyColourChanged = false;
+    }
+
+    bool IsBlockChanged(int32_t left, int32_t top, int32_t right, int32_t bottom) const
+    {
+        for (int32_t y = top; y < bottom; y++)
+        {
+            const auto offset = static_cast<size_t>(y) * _pitch + left;
+            if (std::memcmp(_bits + offset, _presentedBits.data() + offset, right - left) != 0)
+            {
+                return true;
+            }
+        }
+        if (_anyColourChanged)
+        {
+            for (int32_t y = top; y < bottom; y++)
+            {
+                const auto* src = _bits + static_cast<size_t>(y) * _pitch;
+                for (int32_t x = left; x < right; x++)
+                {
+                    if (_changedColours[src[x]])
                     {
-                        for (int32_t x = width; x > 0; x--)
-                        {
-                            *dst++ = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
-                        }
-                        dst += padding;
+                        return true;
                     }
                 }
             }
-            SDL_UnlockTexture(texture);
+        }
+        return false;
+    }
+
+    void UpdateScreenTextureRect(const SDL_Rect& rect)
+    {
+        const auto bytesPerPixel = static_cast<int32_t>(_screenTextureFormat->BytesPerPixel);
+        const auto pitch = rect.w * bytesPerPixel;
+        _convertedPixels.resize(static_cast<size_t>(pitch) * rect.h);
+        ConvertBits(_convertedPixels.data(), pitch, rect);
+        SDL_UpdateTexture(_screenTexture, &rect, _convertedPixels.data(), pitch);
+
+        for (int32_t y = rect.y; y < rect.y + rect.h; y++)
+        {
+            const auto offset = static_cast<size_t>(y) * _pitch + rect.x;
+            std::copy_n(_bits + offset, rect.w, _presentedBits.data() + offset);
+        }
+    }
+
+    void ConvertBits(uint8_t* dst, int32_t dstPitch, const SDL_Rect& rect) const
+    {
+        for (int32_t y = 0; y < rect.h; y++)
+        {
+            const auto* src = _bits + static_cast<size_t>(rect.y + y) * _pitch + rect.x;
+            auto* dstRow = dst + static_cast<size_t>(y) * dstPitch;
+            switch (_screenTextureFormat->BytesPerPixel)
+            {
+                case 4:
+                    for (int32_t x = 0; x < rect.w; x++)
+                    {
+                        const auto colour = _paletteHWMapped[src[x]];
+                        std::memcpy(dstRow + x * 4, &colour, 4);
+                    }
+                    break;
+                case 2:
+                    for (int32_t x = 0; x < rect.w; x++)
+                    {
+                        const auto colour = static_cast<uint16_t>(_paletteHWMapped[src[x]]);
+                        std::memcpy(dstRow + x * 2, &colour, 2);
+                    }
+                    break;
+                case 1:
+                    for (int32_t x = 0; x < rect.w; x++)
+                    {
+                        dstRow[x] = static_cast<uint8_t>(_paletteHWMapped[src[x]]);
+                    }
+                    break;
+            }
         }
     }
 
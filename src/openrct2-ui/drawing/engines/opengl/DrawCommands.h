@@ -43,6 +43,13 @@ public:
         }
         return _instances[_numInstances++];
     }
+    void reserve(size_t count)
+    {
+        if (_numInstances + count > _instances.size())
+        {
+            _instances.resize((_numInstances + count) << 1);
+        }
+    }
     T& insert(const T& value)
     {
         if (_numInstances + 1 > _instances.size())
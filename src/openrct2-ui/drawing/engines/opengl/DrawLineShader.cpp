@@ -32,7 +32,6 @@ DrawLineShader::DrawLineShader()
     GetLocations();
 
     glGenBuffers(1, &_vbo);
-    glGenBuffers(1, &_vboInstances);
     glGenVertexArrays(1, &_vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
@@ -48,15 +47,6 @@ DrawLineShader::DrawLineShader()
     glVertexAttribPointer(
         vVertMat + 3, 2, GL_FLOAT, GL_FALSE, sizeof(VDStruct), reinterpret_cast<void*>(offsetof(VDStruct, mat[3])));
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vboInstances);
-    glVertexAttribIPointer(vClip, 4, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, clip)));
-    glVertexAttribIPointer(
-        vBounds, 4, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, bounds)));
-    glVertexAttribIPointer(
-        vColour, 1, GL_UNSIGNED_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, colour)));
-    glVertexAttribIPointer(
-        vDepth, 1, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, depth)));
-
     glEnableVertexAttribArray(vVertMat + 0);
     glEnableVertexAttribArray(vVertMat + 1);
     glEnableVertexAttribArray(vVertMat + 2);
@@ -102,8 +92,17 @@ void DrawLineShader::DrawInstances(const LineCommandBatch& instances)
 {
     glBindVertexArray(_vao);
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vboInstances);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(DrawLineCommand) * instances.size(), instances.data(), GL_STREAM_DRAW);
+    // The instances are at a different offset in the stream buffer every time, so the attributes are pointed at them again.
+    auto offset = _instances.Write(instances.data(), sizeof(DrawLineCommand) * instances.size());
+    glVertexAttribIPointer(
+        vClip, 4, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offset + offsetof(DrawLineCommand, clip)));
+    glVertexAttribIPointer(
+        vBounds, 4, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offset + offsetof(DrawLineCommand, bounds)));
+    glVertexAttribIPointer(
+        vColour, 1, GL_UNSIGNED_INT, sizeof(DrawLineCommand),
+        reinterpret_cast<void*>(offset + offsetof(DrawLineCommand, colour)));
+    glVertexAttribIPointer(
+        vDepth, 1, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offset + offsetof(DrawLineCommand, depth)));
 
     glDrawArraysInstanced(GL_LINES, 0, 2, static_cast<GLsizei>(instances.size()));
 }
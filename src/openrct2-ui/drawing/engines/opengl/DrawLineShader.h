@@ -12,6 +12,7 @@
 #include "DrawCommands.h"
 #include "GLSLTypes.h"
 #include "OpenGLShaderProgram.h"
+#include "StreamBuffer.h"
 
 class DrawLineShader final : public OpenGLShaderProgram
 {
@@ -26,7 +27,7 @@ private:
     GLuint vVertMat;
 
     GLuint _vbo;
-    GLuint _vboInstances;
+    StreamBuffer _instances;
     GLuint _vao;
 
 public:
@@ -0,0 +1,163 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_OPENGL
+
+#    include "GpuProfiler.h"
+
+#    include "TextureCache.h"
+
+#    include <chrono>
+
+using namespace OpenRCT2;
+
+// Frames whose queries have not finished by then are dropped, rather than keeping ever more queries around.
+constexpr size_t GPU_PROFILER_MAX_PENDING_FRAMES = 8;
+
+GpuProfiler::~GpuProfiler()
+{
+    Reset();
+}
+
+void GpuProfiler::BeginFrame(const TextureCache& textureCache)
+{
+    _active = FrameProfiler::Get().IsEnabled();
+    if (!_active)
+    {
+        Reset();
+        return;
+    }
+
+    _frame.Queries.clear();
+    _frame.Sample = {};
+    _frameStartAtlasMisses = textureCache.GetNumAtlasMisses();
+    _frameStartUploadedBytes = textureCache.GetNumUploadedBytes();
+}
+
+void GpuProfiler::EndFrame(const TextureCache& textureCache)
+{
+    if (!_active)
+        return;
+
+    _frame.Sample.Valid = true;
+    _frame.Sample.AtlasMisses = textureCache.GetNumAtlasMisses() - _frameStartAtlasMisses;
+    _frame.Sample.UploadedBytes += textureCache.GetNumUploadedBytes() - _frameStartUploadedBytes;
+    _pendingFrames.push_back(std::move(_frame));
+    _frame = {};
+
+    ReadFinishedFrames();
+}
+
+void GpuProfiler::BeginPart(GpuTimePart part)
+{
+    if (!_active || _inPart)
+        return;
+
+    auto query = AllocateQuery();
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    _frame.Queries.emplace_back(part, query);
+    _inPart = true;
+}
+
+void GpuProfiler::EndPart()
+{
+    if (!_inPart)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    _inPart = false;
+}
+
+void GpuProfiler::RecordBatch(size_t numInstances, size_t numBytes)
+{
+    if (!_active)
+        return;
+
+    _frame.Sample.NumBatches++;
+    _frame.Sample.NumInstances += numInstances;
+    _frame.Sample.UploadedBytes += numBytes;
+}
+
+GLuint GpuProfiler::AllocateQuery()
+{
+    if (_freeQueries.empty())
+    {
+        GLuint query;
+        glGenQueries(1, &query);
+        return query;
+    }
+
+    auto query = _freeQueries.back();
+    _freeQueries.pop_back();
+    return query;
+}
+
+void GpuProfiler::ReadFinishedFrames()
+{
+    auto& profiler = FrameProfiler::Get();
+    while (!_pendingFrames.empty())
+    {
+        auto& frame = _pendingFrames.front();
+        if (_pendingFrames.size() <= GPU_PROFILER_MAX_PENDING_FRAMES)
+        {
+            // The GPU finishes the queries in order, once the last one is available so are the others.
+            if (!frame.Queries.empty())
+            {
+                GLint available = GL_FALSE;
+                glGetQueryObjectiv(frame.Queries.back().second, GL_QUERY_RESULT_AVAILABLE, &available);
+                if (available == GL_FALSE)
+                    break;
+            }
+
+            for (const auto& [part, query] : frame.Queries)
+            {
+                GLuint64 elapsed = 0;
+                glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+                frame.Sample.Parts[static_cast<size_t>(part)] += std::chrono::nanoseconds(elapsed);
+            }
+            profiler.RecordGpuSample(frame.Sample);
+        }
+
+        for (const auto& query : frame.Queries)
+        {
+            _freeQueries.push_back(query.second);
+        }
+        _pendingFrames.pop_front();
+    }
+}
+
+void GpuProfiler::Reset()
+{
+    if (_inPart)
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+        _inPart = false;
+    }
+    for (const auto& frame : _pendingFrames)
+    {
+        for (const auto& query : frame.Queries)
+        {
+            _freeQueries.push_back(query.second);
+        }
+    }
+    for (const auto& query : _frame.Queries)
+    {
+        _freeQueries.push_back(query.second);
+    }
+    _pendingFrames.clear();
+    _frame = {};
+
+    if (!_freeQueries.empty())
+    {
+        glDeleteQueries(static_cast<GLsizei>(_freeQueries.size()), _freeQueries.data());
+        _freeQueries.clear();
+    }
+}
+
+#endif /* DISABLE_OPENGL */
@@ -0,0 +1,72 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "OpenGLAPI.h"
+
+#include <deque>
+#include <openrct2/FrameProfiler.h>
+#include <openrct2/common.h>
+#include <utility>
+#include <vector>
+
+class TextureCache;
+
+/**
+ * Measures how long the GPU spends on each pass of a frame with GL_TIME_ELAPSED queries, along with how much work was
+ * submitted for it. The results of the queries are only read once the GPU has got to them, a few frames later, so the
+ * CPU never waits for the GPU. Nothing is measured while the frame profiler is disabled.
+ */
+class GpuProfiler final
+{
+private:
+    struct Frame
+    {
+        std::vector<std::pair<OpenRCT2::GpuTimePart, GLuint>> Queries;
+        OpenRCT2::ProfilerGpuSample Sample;
+    };
+
+    bool _active{};
+    bool _inPart{};
+    Frame _frame;
+    std::deque<Frame> _pendingFrames;
+    std::vector<GLuint> _freeQueries;
+    uint64_t _frameStartAtlasMisses{};
+    uint64_t _frameStartUploadedBytes{};
+
+public:
+    GpuProfiler() = default;
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    void BeginFrame(const TextureCache& textureCache);
+
+    /**
+     * Queues the measurements of the frame and passes those of the oldest frames the GPU has finished to the frame
+     * profiler.
+     */
+    void EndFrame(const TextureCache& textureCache);
+
+    /**
+     * Times the GL commands until EndPart. Parts can not be nested, but the same part may be timed several times in a
+     * frame.
+     */
+    void BeginPart(OpenRCT2::GpuTimePart part);
+    void EndPart();
+
+    void RecordBatch(size_t numInstances, size_t numBytes);
+
+private:
+    GLuint AllocateQuery();
+    void ReadFinishedFrames();
+    void Reset();
+};
@@ -14,7 +14,9 @@
 #    if OPENGL_NO_LINK
 
 #        define OPENGL_PROC(TYPE, PROC) TYPE PROC = nullptr;
+#        define OPENGL_OPTIONAL_PROC OPENGL_PROC
 #        include "OpenGLAPIProc.h"
+#        undef OPENGL_OPTIONAL_PROC
 #        undef OPENGL_PROC
 
 #        include <SDL_video.h>
@@ -30,7 +32,9 @@ static const char* TryLoadAllProcAddresses()
                     return #PROC;                                                                                              \
                 }                                                                                                              \
             }
+#        define OPENGL_OPTIONAL_PROC(TYPE, PROC) PROC = reinterpret_cast<TYPE>(SDL_GL_GetProcAddress(#PROC));
 #        include "OpenGLAPIProc.h"
+#        undef OPENGL_OPTIONAL_PROC
 #        undef OPENGL_PROC
 
     return nullptr;
@@ -74,4 +78,23 @@ bool OpenGLAPI::Initialise()
     return true;
 }
 
+bool OpenGLAPI::IsProgramBinarySupported()
+{
+#    ifdef OPENGL_NO_LINK
+    if (glGetProgramBinary == nullptr || glProgramBinary == nullptr || glProgramParameteri == nullptr)
+    {
+        return false;
+    }
+#    endif
+
+    // Some platforms return addresses for functions the driver does not support, so there must also be a binary format.
+    GLint numFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+    if (glGetError() != GL_NO_ERROR)
+    {
+        return false;
+    }
+    return numFormats > 0;
+}
+
 #endif /* DISABLE_OPENGL */
@@ -38,6 +38,7 @@
 #    define glTexImage3D __static__glTexImage3D
 #    define glGetIntegerv __static__glGetIntegerv
 #    define glGetTexImage __static__glGetTexImage
+#    define glGetString __static__glGetString
 
 #endif
 
@@ -74,6 +75,7 @@
 #    undef glTexImage3D
 #    undef glGetIntegerv
 #    undef glGetTexImage
+#    undef glGetString
 
 // 1.1 function signatures
 using PFNGLBEGINPROC = void(APIENTRYP)(GLenum mode);
@@ -106,9 +108,12 @@ using PFNGLTEXIMAGE3DPROC = void(APIENTRYP)(
     GLenum type, const GLvoid* data);
 using PFNGLGETINTERGERVPROC = void(APIENTRYP)(GLenum pname, GLint* data);
 using PFNGLGETTEXIMAGEPROC = void(APIENTRYP)(GLenum target, GLint level, GLenum format, GLenum type, GLvoid* img);
+using PFNGLGETSTRINGPROC = const GLubyte*(APIENTRYP)(GLenum name);
 
 #    define OPENGL_PROC(TYPE, PROC) extern TYPE PROC;
+#    define OPENGL_OPTIONAL_PROC OPENGL_PROC
 #    include "OpenGLAPIProc.h"
+#    undef OPENGL_OPTIONAL_PROC
 #    undef OPENGL_PROC
 
 #endif /* OPENGL_NO_LINK */
@@ -127,6 +132,11 @@ namespace OpenGLAPI
 {
     bool Initialise();
     void SetTexture(uint16_t index, GLenum type, GLuint texture);
+
+    /**
+     * Whether linked shader programs can be retrieved and loaded again, so they do not have to be compiled every time.
+     */
+    bool IsProgramBinarySupported();
 } // namespace OpenGLAPI
 
 namespace OpenGLState
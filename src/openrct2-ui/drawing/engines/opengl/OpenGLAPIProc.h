@@ -7,7 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
-#ifndef OPENGL_PROC
+#if !defined(OPENGL_PROC) || !defined(OPENGL_OPTIONAL_PROC)
 #    error "Do not include OpenGLAPIProc.h directly. Include OpenGLAPI.h instead."
 #endif
 
@@ -36,15 +36,19 @@ OPENGL_PROC(PFNGLTEXSUBIMAGE3DPROC, glTexSubImage3D)
 OPENGL_PROC(PFNGLTEXIMAGE3DPROC, glTexImage3D)
 OPENGL_PROC(PFNGLGETINTERGERVPROC, glGetIntegerv)
 OPENGL_PROC(PFNGLGETTEXIMAGEPROC, glGetTexImage)
+OPENGL_PROC(PFNGLGETSTRINGPROC, glGetString)
 
 // 2.0+ function pointers
 OPENGL_PROC(PFNGLATTACHSHADERPROC, glAttachShader)
+OPENGL_PROC(PFNGLBEGINQUERYPROC, glBeginQuery)
 OPENGL_PROC(PFNGLBINDBUFFERPROC, glBindBuffer)
 OPENGL_PROC(PFNGLBINDFRAGDATALOCATIONPROC, glBindFragDataLocation)
 OPENGL_PROC(PFNGLBINDFRAMEBUFFERPROC, glBindFramebuffer)
 OPENGL_PROC(PFNGLBINDVERTEXARRAYPROC, glBindVertexArray)
 OPENGL_PROC(PFNGLBLITFRAMEBUFFERPROC, glBlitFramebuffer)
 OPENGL_PROC(PFNGLBUFFERDATAPROC, glBufferData)
+OPENGL_PROC(PFNGLBUFFERSUBDATAPROC, glBufferSubData)
+OPENGL_PROC(PFNGLCLIENTWAITSYNCPROC, glClientWaitSync)
 OPENGL_PROC(PFNGLCLEARBUFFERFVPROC, glClearBufferfv)
 OPENGL_PROC(PFNGLCLEARBUFFERUIVPROC, glClearBufferuiv)
 OPENGL_PROC(PFNGLCOMPILESHADERPROC, glCompileShader)
@@ -53,21 +57,29 @@ OPENGL_PROC(PFNGLCREATESHADERPROC, glCreateShader)
 OPENGL_PROC(PFNGLDELETEBUFFERSPROC, glDeleteBuffers)
 OPENGL_PROC(PFNGLDELETEFRAMEBUFFERSPROC, glDeleteFramebuffers)
 OPENGL_PROC(PFNGLDELETEPROGRAMPROC, glDeleteProgram)
+OPENGL_PROC(PFNGLDELETEQUERIESPROC, glDeleteQueries)
 OPENGL_PROC(PFNGLDELETESHADERPROC, glDeleteShader)
+OPENGL_PROC(PFNGLDELETESYNCPROC, glDeleteSync)
 OPENGL_PROC(PFNGLDELETEVERTEXARRAYSPROC, glDeleteVertexArrays)
 OPENGL_PROC(PFNGLDETACHSHADERPROC, glDetachShader)
 OPENGL_PROC(PFNGLENABLEVERTEXATTRIBARRAYPROC, glEnableVertexAttribArray)
+OPENGL_PROC(PFNGLENDQUERYPROC, glEndQuery)
+OPENGL_PROC(PFNGLFENCESYNCPROC, glFenceSync)
 OPENGL_PROC(PFNGLFRAMEBUFFERTEXTURE2DPROC, glFramebufferTexture2D)
 OPENGL_PROC(PFNGLGETATTRIBLOCATIONPROC, glGetAttribLocation)
 OPENGL_PROC(PFNGLGENBUFFERSPROC, glGenBuffers)
 OPENGL_PROC(PFNGLGENFRAMEBUFFERSPROC, glGenFramebuffers)
+OPENGL_PROC(PFNGLGENQUERIESPROC, glGenQueries)
 OPENGL_PROC(PFNGLGETPROGRAMINFOLOGPROC, glGetProgramInfoLog)
 OPENGL_PROC(PFNGLGETPROGRAMIVPROC, glGetProgramiv)
+OPENGL_PROC(PFNGLGETQUERYOBJECTIVPROC, glGetQueryObjectiv)
+OPENGL_PROC(PFNGLGETQUERYOBJECTUI64VPROC, glGetQueryObjectui64v)
 OPENGL_PROC(PFNGLGETSHADERINFOLOGPROC, glGetShaderInfoLog)
 OPENGL_PROC(PFNGLGETSHADERIVPROC, glGetShaderiv)
 OPENGL_PROC(PFNGLGETUNIFORMLOCATIONPROC, glGetUniformLocation)
 OPENGL_PROC(PFNGLGENVERTEXARRAYSPROC, glGenVertexArrays)
 OPENGL_PROC(PFNGLLINKPROGRAMPROC, glLinkProgram)
+OPENGL_PROC(PFNGLMAPBUFFERRANGEPROC, glMapBufferRange)
 OPENGL_PROC(PFNGLSHADERSOURCEPROC, glShaderSource)
 OPENGL_PROC(PFNGLUNIFORM1IPROC, glUniform1i)
 OPENGL_PROC(PFNGLUNIFORM1IVPROC, glUniform1iv)
@@ -78,9 +90,15 @@ OPENGL_PROC(PFNGLUNIFORM2FPROC, glUniform2f)
 OPENGL_PROC(PFNGLUNIFORM4FPROC, glUniform4f)
 OPENGL_PROC(PFNGLUNIFORM4IPROC, glUniform4i)
 OPENGL_PROC(PFNGLUNIFORM4FVPROC, glUniform4fv)
+OPENGL_PROC(PFNGLUNMAPBUFFERPROC, glUnmapBuffer)
 OPENGL_PROC(PFNGLUSEPROGRAMPROC, glUseProgram)
 OPENGL_PROC(PFNGLVERTEXATTRIBIPOINTERPROC, glVertexAttribIPointer)
 OPENGL_PROC(PFNGLVERTEXATTRIBPOINTERPROC, glVertexAttribPointer)
 OPENGL_PROC(PFNGLDRAWARRAYSINSTANCEDPROC, glDrawArraysInstanced)
 OPENGL_PROC(PFNGLVERTEXATTRIBDIVISORPROC, glVertexAttribDivisor)
 OPENGL_PROC(PFNGLBLENDFUNCSEPARATEPROC, glBlendFuncSeparate)
+
+// Optional function pointers, left as nullptr if the driver does not provide them
+OPENGL_OPTIONAL_PROC(PFNGLGETPROGRAMBINARYPROC, glGetProgramBinary)
+OPENGL_OPTIONAL_PROC(PFNGLPROGRAMBINARYPROC, glProgramBinary)
+OPENGL_OPTIONAL_PROC(PFNGLPROGRAMPARAMETERIPROC, glProgramParameteri)
@@ -15,6 +15,7 @@
 #    include "DrawLineShader.h"
 #    include "DrawRectShader.h"
 #    include "GLSLTypes.h"
+#    include "GpuProfiler.h"
 #    include "OpenGLAPI.h"
 #    include "OpenGLFramebuffer.h"
 #    include "SwapFramebuffer.h"
@@ -33,11 +34,13 @@
 #    include <openrct2/drawing/IDrawingEngine.h>
 #    include <openrct2/drawing/LightFX.h>
 #    include <openrct2/drawing/Weather.h>
+#    include <openrct2/drawing/X8DrawingEngine.h>
 #    include <openrct2/interface/Screenshot.h>
 #    include <openrct2/ui/UiContext.h>
 #    include <openrct2/util/Util.h>
 #    include <openrct2/world/Climate.h>
 #    include <unordered_map>
+#    include <vector>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
@@ -64,6 +67,7 @@ private:
     SwapFramebuffer* _swapFramebuffer = nullptr;
 
     TextureCache* _textureCache = nullptr;
+    GpuProfiler _gpuProfiler;
 
     int32_t _offsetX = 0;
     int32_t _offsetY = 0;
@@ -74,6 +78,7 @@ private:
     ScreenCoordsXY _spriteOffset;
 
     int32_t _drawCount = 0;
+    bool _frameSaved = false;
 
     struct
     {
@@ -91,6 +96,10 @@ public:
     {
         return _textureCache;
     }
+    GpuProfiler& GetGpuProfiler()
+    {
+        return _gpuProfiler;
+    }
     const OpenGLFramebuffer& GetFinalFramebuffer() const
     {
         return _swapFramebuffer->GetFinalFramebuffer();
@@ -109,8 +118,20 @@ public:
     void DrawSpriteRawMasked(int32_t x, int32_t y, uint32_t maskImage, uint32_t colourImage) override;
     void DrawSpriteSolid(uint32_t image, int32_t x, int32_t y, uint8_t colour) override;
     void DrawGlyph(uint32_t image, int32_t x, int32_t y, const PaletteMap& palette) override;
+    void DrawSprites(const SpriteDrawCall* sprites, size_t count) override;
 
     void FlushCommandBuffers();
+    void CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy);
+
+    /**
+     * Keeps a copy of the frame drawn so far, which RestoreFrame puts back at the start of the next draw.
+     */
+    void SaveFrame();
+    void RestoreFrame();
+    bool IsFrameSaved() const
+    {
+        return _frameSaved;
+    }
 
     void FlushLines();
     void FlushRectangles();
@@ -144,34 +165,36 @@ public:
         uint8_t patternStartXOffset = xStart % patternXSpace;
         uint8_t patternStartYOffset = yStart % patternYSpace;
 
-        const auto* dpi = _drawingContext->GetDPI();
+        // The frame is kept between draws. Rather than drawing the area under the weather again next frame, the frame
+        // is copied before the first weather is drawn over it and copied back at the start of the next draw.
+        if (!_drawingContext->IsFrameSaved())
+        {
+            _drawingContext->FlushCommandBuffers();
+            _drawingContext->SaveFrame();
+        }
 
-        uint32_t pixelOffset = (dpi->pitch + dpi->width) * y + x;
+        const auto* dpi = _drawingContext->GetDPI();
+        const int32_t right = std::min(x + width, dpi->x + dpi->width);
+        const int32_t bottom = std::min(y + height, dpi->y + dpi->height);
         uint8_t patternYPos = patternStartYOffset % patternYSpace;
-
-        for (; height != 0; height--)
+        for (int32_t pixelY = y; pixelY < bottom; pixelY++)
         {
             auto patternX = pattern[patternYPos * 2];
             if (patternX != 0xFF)
             {
-                uint32_t finalPixelOffset = width + pixelOffset;
-
-                uint32_t xPixelOffset = pixelOffset;
-                xPixelOffset += (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
-
                 auto patternPixel = pattern[patternYPos * 2 + 1];
-                for (; xPixelOffset < finalPixelOffset; xPixelOffset += patternXSpace)
+                int32_t pixelX = x + (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
+                for (; pixelX < right; pixelX += patternXSpace)
                 {
-                    int32_t pixelX = xPixelOffset % dpi->width;
-                    int32_t pixelY = (xPixelOffset / dpi->width) % dpi->height;
-
                     _drawingContext->DrawLine(patternPixel, { { pixelX, pixelY }, { pixelX + 1, pixelY + 1 } });
                 }
             }
 
-            pixelOffset += dpi->pitch + dpi->width;
             patternYPos++;
-            patternYPos %= patternYSpace;
+            if (patternYPos == patternYSpace)
+            {
+                patternYPos = 0;
+            }
         }
     }
 };
@@ -191,6 +214,9 @@ private:
 
     rct_drawpixelinfo _bitsDPI = {};
 
+    DirtyGrid _dirtyGrid = {};
+    std::vector<DirtyRect> _dirtyRects;
+
     OpenGLDrawingContext* _drawingContext;
 
     ApplyPaletteShader* _applyPaletteShader = nullptr;
@@ -221,6 +247,7 @@ public:
         delete _screenFramebuffer;
 
         delete _drawingContext;
+        delete[] _dirtyGrid.Blocks;
         delete[] _bits;
 
         SDL_GL_DeleteContext(_context);
@@ -257,6 +284,7 @@ public:
         ConfigureBits(width, height, width);
         ConfigureCanvas();
         _drawingContext->Resize(width, height);
+        _dirtyGrid.Configure(width, height);
     }
 
     void SetPalette(const GamePalette& palette) override
@@ -290,6 +318,7 @@ public:
 
     void Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom) override
     {
+        _dirtyGrid.Invalidate(left, top, right, bottom);
     }
 
     void BeginDraw() override
@@ -297,6 +326,7 @@ public:
         assert(_screenFramebuffer != nullptr);
 
         _drawingContext->StartNewDraw();
+        _drawingContext->RestoreFrame();
     }
 
     void EndDraw() override
@@ -314,6 +344,9 @@ public:
             _screenFramebuffer->Bind();
         }
 
+        auto& gpuProfiler = _drawingContext->GetGpuProfiler();
+        gpuProfiler.BeginPart(GpuTimePart::Palette);
+
         _applyPaletteShader->Use();
         _applyPaletteShader->SetTexture(_drawingContext->GetFinalFramebuffer().GetTexture());
         _applyPaletteShader->Draw();
@@ -328,14 +361,22 @@ public:
             _screenFramebuffer->Copy(*_scaleFramebuffer, GL_LINEAR);
         }
 
+        gpuProfiler.EndPart();
+        gpuProfiler.EndFrame(*_drawingContext->GetTextureCache());
+
         CheckGLError();
         Display();
     }
 
     void PaintWindows() override
     {
+        window_reset_visibilities();
+
+        // Like the software engine, only the regions that have been invalidated are drawn again. They are drawn before
+        // the viewports are updated too, so panned viewports do not move pixels that are out of date.
+        DrawAllDirtyBlocks();
         window_update_all_viewports();
-        window_draw_all(&_bitsDPI, 0, 0, _width, _height);
+        DrawAllDirtyBlocks();
     }
 
     void PaintWeather() override
@@ -355,7 +396,24 @@ public:
 
     void CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy) override
     {
-        // Not applicable for this engine
+        if (dx == 0 && dy == 0)
+            return;
+
+        // Adjust for move off screen, see X8DrawingEngine::CopyRect
+        int32_t lmargin = std::min(x - dx, 0);
+        int32_t rmargin = std::min(static_cast<int32_t>(_width) - (x - dx + width), 0);
+        int32_t tmargin = std::min(y - dy, 0);
+        int32_t bmargin = std::min(static_cast<int32_t>(_height) - (y - dy + height), 0);
+        x -= lmargin;
+        y -= tmargin;
+        width += lmargin + rmargin;
+        height += tmargin + bmargin;
+        if (width <= 0 || height <= 0)
+            return;
+
+        // Everything drawn so far this frame has to be in the framebuffer before it is moved.
+        _drawingContext->FlushCommandBuffers();
+        _drawingContext->CopyRect(x, y, width, height, dx, dy);
     }
 
     IDrawingContext* GetDrawingContext(rct_drawpixelinfo* dpi) override
@@ -371,7 +429,7 @@ public:
 
     DRAWING_ENGINE_FLAGS GetFlags() override
     {
-        return DEF_NONE;
+        return DEF_DIRTY_OPTIMISATIONS;
     }
 
     void InvalidateImage(uint32_t image) override
@@ -385,6 +443,22 @@ public:
     }
 
 private:
+    void DrawAllDirtyBlocks()
+    {
+        _dirtyGrid.CollectDirtyRects(_dirtyRects);
+        for (const auto& rect : _dirtyRects)
+        {
+            auto left = rect.X * _dirtyGrid.BlockWidth;
+            auto top = rect.Y * _dirtyGrid.BlockHeight;
+            auto right = std::min(_width, left + rect.Columns * _dirtyGrid.BlockWidth);
+            auto bottom = std::min(_height, top + rect.Rows * _dirtyGrid.BlockHeight);
+            if (right > left && bottom > top)
+            {
+                window_draw_all(&_bitsDPI, left, top, right, bottom);
+            }
+        }
+    }
+
     static OpenGLVersion GetOpenGLVersion()
     {
         CheckGLError(); // Clear Any Errors
@@ -527,6 +601,7 @@ void OpenGLDrawingContext::Resize(int32_t width, int32_t height)
     // Re-create canvas framebuffer
     delete _swapFramebuffer;
     _swapFramebuffer = new SwapFramebuffer(width, height);
+    _frameSaved = false;
 }
 
 void OpenGLDrawingContext::ResetPalette()
@@ -538,6 +613,8 @@ void OpenGLDrawingContext::StartNewDraw()
 {
     _drawCount = 0;
     _swapFramebuffer->Clear();
+    _gpuProfiler.BeginFrame(*_textureCache);
+    _textureCache->BeginFrame();
 }
 
 void OpenGLDrawingContext::Clear(uint8_t paletteIndex)
@@ -629,8 +706,10 @@ void OpenGLDrawingContext::DrawSprite(uint32_t image, int32_t x, int32_t y, uint
             zoomedDPI.width = _dpi->width >> 1;
             zoomedDPI.pitch = _dpi->pitch;
             zoomedDPI.zoom_level = _dpi->zoom_level - 1;
+            auto* dpi = _dpi;
             SetDPI(&zoomedDPI);
             DrawSprite((image & 0xFFF80000) | (g1Id - g1Element->zoomed_offset), x >> 1, y >> 1, tertiaryColour);
+            SetDPI(dpi);
             return;
         }
         if (g1Element->flags & G1_FLAG_NO_ZOOM_DRAW)
@@ -877,7 +956,8 @@ void OpenGLDrawingContext::DrawGlyph(uint32_t image, int32_t x, int32_t y, const
         return;
     }
 
-    const auto texture = _textureCache->GetOrLoadGlyphTexture(image, palette);
+    const auto texture = _textureCache->GetOrLoadGlyphTexture(image);
+    const auto paletteRow = _textureCache->GetOrAddGlyphPalette(palette);
 
     int32_t left = x + g1Element->x_offset;
     int32_t top = y + g1Element->y_offset;
@@ -915,13 +995,28 @@ void OpenGLDrawingContext::DrawGlyph(uint32_t image, int32_t x, int32_t y, const
     command.texColourBounds = texture.normalizedBounds;
     command.texMaskAtlas = 0;
     command.texMaskBounds = { 0.0f, 0.0f, 0.0f, 0.0f };
-    command.palettes = { 0, 0, 0 };
-    command.flags = 0;
+    // Remapped by the shader through the single palette of the glyph.
+    command.palettes = { paletteRow, 0, 0 };
+    command.flags = 1;
     command.colour = 0;
     command.bounds = { left, top, right, bottom };
     command.depth = _drawCount++;
 }
 
+void OpenGLDrawingContext::DrawSprites(const SpriteDrawCall* sprites, size_t count)
+{
+    // Most sprites are opaque, so room for all of them is made up front.
+    _commandBuffers.rects.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto& sprite = sprites[i];
+        if (sprite.IsMasked)
+            DrawSpriteRawMasked(sprite.X, sprite.Y, sprite.Image, sprite.Colour);
+        else
+            DrawSprite(sprite.Image, sprite.X, sprite.Y, sprite.Colour);
+    }
+}
+
 void OpenGLDrawingContext::FlushCommandBuffers()
 {
     glEnable(GL_DEPTH_TEST);
@@ -937,14 +1032,38 @@ void OpenGLDrawingContext::FlushCommandBuffers()
     HandleTransparency();
 }
 
+void OpenGLDrawingContext::CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy)
+{
+    _swapFramebuffer->CopyRect(x, y, width, height, dx, dy);
+}
+
+void OpenGLDrawingContext::SaveFrame()
+{
+    _swapFramebuffer->SaveFinal();
+    _frameSaved = true;
+}
+
+void OpenGLDrawingContext::RestoreFrame()
+{
+    if (_frameSaved)
+    {
+        _swapFramebuffer->RestoreFinal();
+        _frameSaved = false;
+    }
+}
+
 void OpenGLDrawingContext::FlushLines()
 {
     if (_commandBuffers.lines.empty())
         return;
 
+    _gpuProfiler.BeginPart(GpuTimePart::Lines);
     _drawLineShader->Use();
     _drawLineShader->DrawInstances(_commandBuffers.lines);
+    _gpuProfiler.EndPart();
 
+    const auto numLines = _commandBuffers.lines.size();
+    _gpuProfiler.RecordBatch(numLines, numLines * sizeof(DrawLineCommand));
     _commandBuffers.lines.clear();
 }
 
@@ -956,10 +1075,14 @@ void OpenGLDrawingContext::FlushRectangles()
     OpenGLAPI::SetTexture(0, GL_TEXTURE_2D_ARRAY, _textureCache->GetAtlasesTexture());
     OpenGLAPI::SetTexture(1, GL_TEXTURE_2D, _textureCache->GetPaletteTexture());
 
+    _gpuProfiler.BeginPart(GpuTimePart::Rectangles);
     _drawRectShader->Use();
     _drawRectShader->SetInstances(_commandBuffers.rects);
     _drawRectShader->DrawInstances();
+    _gpuProfiler.EndPart();
 
+    const auto numRects = _commandBuffers.rects.size();
+    _gpuProfiler.RecordBatch(numRects, numRects * sizeof(DrawRectCommand));
     _commandBuffers.rects.clear();
 }
 
@@ -970,9 +1093,12 @@ void OpenGLDrawingContext::HandleTransparency()
         return;
     }
 
+    _gpuProfiler.BeginPart(GpuTimePart::Transparency);
     _drawRectShader->Use();
     _drawRectShader->SetInstances(_commandBuffers.transparent);
 
+    // The instances are uploaded once and drawn for every layer that is peeled.
+    const auto numInstances = _commandBuffers.transparent.size();
     int32_t max_depth = MaxTransparencyDepth(_commandBuffers.transparent);
     for (int32_t i = 0; i < max_depth; ++i)
     {
@@ -993,7 +1119,9 @@ void OpenGLDrawingContext::HandleTransparency()
         _drawRectShader->Use();
         _drawRectShader->DrawInstances();
         _swapFramebuffer->ApplyTransparency(*_applyTransparencyShader, _textureCache->GetPaletteTexture());
+        _gpuProfiler.RecordBatch(numInstances, i == 0 ? numInstances * sizeof(DrawRectCommand) : 0);
     }
+    _gpuProfiler.EndPart();
 
     _commandBuffers.transparent.clear();
 }
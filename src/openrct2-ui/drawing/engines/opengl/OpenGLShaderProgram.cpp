@@ -13,19 +13,22 @@
 
 #    include <openrct2/Context.h>
 #    include <openrct2/PlatformEnvironment.h>
+#    include <openrct2/Diagnostic.h>
 #    include <openrct2/core/Console.hpp>
+#    include <openrct2/core/File.h>
 #    include <openrct2/core/FileStream.h>
 #    include <openrct2/core/Path.hpp>
 #    include <openrct2/core/String.hpp>
 
 using namespace OpenRCT2;
 
-OpenGLShader::OpenGLShader(const char* name, GLenum type)
+static constexpr uint32_t BINARY_MAGIC_NUMBER = 0x42534752; // RGSB
+static constexpr uint16_t BINARY_VERSION = 1;
+
+OpenGLShader::OpenGLShader(const char* name, GLenum type, const std::string& sourceCode)
 {
     _type = type;
 
-    auto path = GetPath(name);
-    auto sourceCode = ReadSourceCode(path);
     auto sourceCodeStr = sourceCode.c_str();
 
     _id = glCreateShader(type);
@@ -40,7 +43,7 @@ OpenGLShader::OpenGLShader(const char* name, GLenum type)
         glGetShaderInfoLog(_id, sizeof(buffer), nullptr, buffer);
         glDeleteShader(_id);
 
-        Console::Error::WriteLine("Error compiling %s", path.c_str());
+        Console::Error::WriteLine("Error compiling %s", GetPath(name, type).c_str());
         Console::Error::WriteLine(buffer);
 
         throw std::runtime_error("Error compiling shader.");
@@ -57,12 +60,12 @@ GLuint OpenGLShader::GetShaderId()
     return _id;
 }
 
-std::string OpenGLShader::GetPath(const std::string& name)
+std::string OpenGLShader::GetPath(const std::string& name, GLenum type)
 {
     auto env = GetContext()->GetPlatformEnvironment();
     auto shadersPath = env->GetDirectoryPath(DIRBASE::OPENRCT2, DIRID::SHADER);
     auto path = Path::Combine(shadersPath, name);
-    if (_type == GL_VERTEX_SHADER)
+    if (type == GL_VERTEX_SHADER)
     {
         path += ".vert";
     }
@@ -90,13 +93,38 @@ std::string OpenGLShader::ReadSourceCode(const std::string& path)
 
 OpenGLShaderProgram::OpenGLShaderProgram(const char* name)
 {
-    _vertexShader = new OpenGLShader(name, GL_VERTEX_SHADER);
-    _fragmentShader = new OpenGLShader(name, GL_FRAGMENT_SHADER);
+    auto vertexSourceCode = OpenGLShader::ReadSourceCode(OpenGLShader::GetPath(name, GL_VERTEX_SHADER));
+    auto fragmentSourceCode = OpenGLShader::ReadSourceCode(OpenGLShader::GetPath(name, GL_FRAGMENT_SHADER));
 
     _id = glCreateProgram();
+
+    // Compiling and linking takes a long time on some drivers, so the linked program is kept and loaded again for as long
+    // as neither the shaders nor the driver change.
+    const bool canCacheBinary = OpenGLAPI::IsProgramBinarySupported();
+    std::string binaryPath;
+    std::string driver;
+    uint64_t sourceHash{};
+    if (canCacheBinary)
+    {
+        binaryPath = GetBinaryPath(name);
+        driver = GetDriverName();
+        sourceHash = HashSourceCode(vertexSourceCode, fragmentSourceCode);
+        if (LoadBinary(binaryPath, driver, sourceHash))
+        {
+            return;
+        }
+    }
+
+    _vertexShader = new OpenGLShader(name, GL_VERTEX_SHADER, vertexSourceCode);
+    _fragmentShader = new OpenGLShader(name, GL_FRAGMENT_SHADER, fragmentSourceCode);
+
     glAttachShader(_id, _vertexShader->GetShaderId());
     glAttachShader(_id, _fragmentShader->GetShaderId());
     glBindFragDataLocation(_id, 0, "oColour");
+    if (canCacheBinary)
+    {
+        glProgramParameteri(_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
 
     if (!Link())
     {
@@ -109,6 +137,11 @@ OpenGLShaderProgram::OpenGLShaderProgram(const char* name)
 
         throw std::runtime_error("Failed to link OpenGL shader.");
     }
+
+    if (canCacheBinary)
+    {
+        SaveBinary(binaryPath, driver, sourceHash);
+    }
 }
 
 OpenGLShaderProgram::~OpenGLShaderProgram()
@@ -154,4 +187,110 @@ bool OpenGLShaderProgram::Link()
     return linkStatus == GL_TRUE;
 }
 
+bool OpenGLShaderProgram::LoadBinary(const std::string& path, const std::string& driver, uint64_t sourceHash)
+{
+    if (!File::Exists(path))
+    {
+        return false;
+    }
+
+    try
+    {
+        auto fs = FileStream(path, FILE_MODE_OPEN);
+        if (fs.ReadValue<uint32_t>() != BINARY_MAGIC_NUMBER || fs.ReadValue<uint16_t>() != BINARY_VERSION
+            || fs.ReadStdString() != driver || fs.ReadValue<uint64_t>() != sourceHash)
+        {
+            return false;
+        }
+
+        auto format = fs.ReadValue<uint32_t>();
+        auto length = fs.ReadValue<uint32_t>();
+        if (length == 0 || length > MaxBinarySize)
+        {
+            return false;
+        }
+        auto binary = fs.ReadArray<uint8_t>(length);
+        glProgramBinary(_id, static_cast<GLenum>(format), binary.get(), static_cast<GLsizei>(length));
+    }
+    catch (const std::exception& e)
+    {
+        log_verbose("Unable to read shader binary '%s': %s", path.c_str(), e.what());
+        return false;
+    }
+
+    // Drivers may still reject a binary, the shaders are compiled again then.
+    GLint linkStatus;
+    glGetProgramiv(_id, GL_LINK_STATUS, &linkStatus);
+    return linkStatus == GL_TRUE;
+}
+
+void OpenGLShaderProgram::SaveBinary(const std::string& path, const std::string& driver, uint64_t sourceHash)
+{
+    GLint length = 0;
+    glGetProgramiv(_id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0 || static_cast<uint32_t>(length) > MaxBinarySize)
+    {
+        return;
+    }
+
+    std::vector<uint8_t> binary(static_cast<size_t>(length));
+    GLenum format{};
+    glGetProgramBinary(_id, length, &length, &format, binary.data());
+
+    try
+    {
+        Path::CreateDirectory(Path::GetDirectory(path));
+        auto fs = FileStream(path, FILE_MODE_WRITE);
+        fs.WriteValue<uint32_t>(BINARY_MAGIC_NUMBER);
+        fs.WriteValue<uint16_t>(BINARY_VERSION);
+        fs.WriteString(driver);
+        fs.WriteValue<uint64_t>(sourceHash);
+        fs.WriteValue<uint32_t>(format);
+        fs.WriteValue<uint32_t>(static_cast<uint32_t>(length));
+        fs.Write(binary.data(), static_cast<uint64_t>(length));
+        fs.Flush();
+    }
+    catch (const std::exception& e)
+    {
+        log_verbose("Unable to write shader binary '%s': %s", path.c_str(), e.what());
+    }
+}
+
+std::string OpenGLShaderProgram::GetBinaryPath(const char* name)
+{
+    auto env = GetContext()->GetPlatformEnvironment();
+    auto cachePath = env->GetDirectoryPath(DIRBASE::CACHE);
+    return Path::Combine(Path::Combine(cachePath, "shaders"), std::string(name) + ".bin");
+}
+
+std::string OpenGLShaderProgram::GetDriverName()
+{
+    std::string driver;
+    for (auto name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+    {
+        auto value = reinterpret_cast<const char*>(glGetString(name));
+        if (value != nullptr)
+        {
+            driver += value;
+        }
+        driver += '\n';
+    }
+    return driver;
+}
+
+uint64_t OpenGLShaderProgram::HashSourceCode(const std::string& vertexSourceCode, const std::string& fragmentSourceCode)
+{
+    // FNV-1a, the hash has to stay the same between runs of the game
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (const auto* sourceCode : { &vertexSourceCode, &fragmentSourceCode })
+    {
+        for (auto ch : *sourceCode)
+        {
+            hash ^= static_cast<uint8_t>(ch);
+            hash *= 0x100000001B3ULL;
+        }
+    }
+    return hash;
+}
+
 #endif /* DISABLE_OPENGL */
@@ -23,19 +23,20 @@ private:
     GLuint _id = 0;
 
 public:
-    OpenGLShader(const char* name, GLenum type);
+    OpenGLShader(const char* name, GLenum type, const std::string& sourceCode);
     ~OpenGLShader();
 
     GLuint GetShaderId();
 
-private:
-    std::string GetPath(const std::string& name);
+    static std::string GetPath(const std::string& name, GLenum type);
     static std::string ReadSourceCode(const std::string& path);
 };
 
 class OpenGLShaderProgram
 {
 private:
+    static constexpr uint32_t MaxBinarySize = 16 * 1024 * 1024; // 16 MiB
+
     GLuint _id = 0;
     OpenGLShader* _vertexShader = nullptr;
     OpenGLShader* _fragmentShader = nullptr;
@@ -51,4 +52,9 @@ public:
 
 private:
     bool Link();
+    bool LoadBinary(const std::string& path, const std::string& driver, uint64_t sourceHash);
+    void SaveBinary(const std::string& path, const std::string& driver, uint64_t sourceHash);
+    static std::string GetBinaryPath(const char* name);
+    static std::string GetDriverName();
+    static uint64_t HashSourceCode(const std::string& vertexSourceCode, const std::string& fragmentSourceCode);
 };
@@ -0,0 +1,68 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_OPENGL
+
+#    include "StreamBuffer.h"
+
+#    include <algorithm>
+#    include <cstring>
+
+// Large enough for the commands of a few busy frames, so the storage is not orphaned every frame.
+constexpr size_t STREAM_BUFFER_INITIAL_CAPACITY = 4 * 1024 * 1024;
+
+// Offsets are kept aligned, as some drivers are slow to read attributes that are not.
+constexpr size_t STREAM_BUFFER_ALIGNMENT = 64;
+
+StreamBuffer::StreamBuffer()
+{
+    glGenBuffers(1, &_buffer);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    glDeleteBuffers(1, &_buffer);
+}
+
+size_t StreamBuffer::Write(const void* data, size_t size)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+    if (size == 0)
+        return 0;
+
+    if (_offset + size > _capacity)
+    {
+        // Orphan the storage, the draws that have been issued keep using the old one.
+        _capacity = std::max(_capacity, STREAM_BUFFER_INITIAL_CAPACITY);
+        while (_capacity < size)
+        {
+            _capacity *= 2;
+        }
+        glBufferData(GL_ARRAY_BUFFER, _capacity, nullptr, GL_STREAM_DRAW);
+        _offset = 0;
+    }
+
+    const auto offset = _offset;
+    auto* mapped = glMapBufferRange(
+        GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (mapped != nullptr)
+    {
+        std::memcpy(mapped, data, size);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+    else
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+    }
+
+    _offset = (offset + size + STREAM_BUFFER_ALIGNMENT - 1) & ~(STREAM_BUFFER_ALIGNMENT - 1);
+    return offset;
+}
+
+#endif /* DISABLE_OPENGL */
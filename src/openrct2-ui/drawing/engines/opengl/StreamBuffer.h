@@ -0,0 +1,41 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "OpenGLAPI.h"
+
+#include <openrct2/common.h>
+
+/**
+ * A vertex buffer that is written to every frame. Data is appended through unsynchronised mappings of the part of the
+ * buffer that has not been written yet, so the driver never has to wait for draws that still read from the rest of it.
+ * Once the end is reached the storage is orphaned, which gives the driver the chance to hand out a fresh one while the
+ * old one is still in use.
+ */
+class StreamBuffer final
+{
+private:
+    GLuint _buffer = 0;
+    size_t _capacity = 0;
+    size_t _offset = 0;
+
+public:
+    StreamBuffer();
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    /**
+     * Copies the data to the buffer and leaves it bound to GL_ARRAY_BUFFER.
+     * @returns The offset of the data in the buffer, to be used for the attribute pointers.
+     */
+    size_t Write(const void* data, size_t size);
+};
@@ -21,6 +21,7 @@ SwapFramebuffer::SwapFramebuffer(int32_t width, int32_t height)
     : _opaqueFramebuffer(width, height)
     , _transparentFramebuffer(width, height)
     , _mixFramebuffer(width, height, false)
+    , _savedFramebuffer(width, height, false)
     , _backDepth(OpenGLFramebuffer::CreateDepthTexture(width, height))
 {
     _transparentFramebuffer.Bind();
@@ -55,4 +56,39 @@ void SwapFramebuffer::Clear()
     glClearBufferfv(GL_DEPTH, 0, depthValue);
 }
 
+void SwapFramebuffer::CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy)
+{
+    // Framebuffers are upside down compared to the screen. Blitting between overlapping regions of the same framebuffer
+    // is undefined, so the pixels are moved by way of the mix framebuffer, which is overwritten before it is used next.
+    const auto screenHeight = static_cast<int32_t>(_opaqueFramebuffer.GetHeight());
+    const auto srcLeft = x - dx;
+    const auto srcBottom = screenHeight - (y - dy) - height;
+    const auto dstBottom = screenHeight - y - height;
+
+    _mixFramebuffer.BindDraw();
+    _opaqueFramebuffer.BindRead();
+    glBlitFramebuffer(
+        srcLeft, srcBottom, srcLeft + width, srcBottom + height, srcLeft, srcBottom, srcLeft + width, srcBottom + height,
+        GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+    _opaqueFramebuffer.BindDraw();
+    _mixFramebuffer.BindRead();
+    glBlitFramebuffer(
+        srcLeft, srcBottom, srcLeft + width, srcBottom + height, x, dstBottom, x + width, dstBottom + height,
+        GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+    _opaqueFramebuffer.Bind();
+}
+
+void SwapFramebuffer::SaveFinal()
+{
+    _savedFramebuffer.Copy(_opaqueFramebuffer, GL_NEAREST);
+    _opaqueFramebuffer.Bind();
+}
+
+void SwapFramebuffer::RestoreFinal()
+{
+    _opaqueFramebuffer.Copy(_savedFramebuffer, GL_NEAREST);
+}
+
 #endif /* DISABLE_OPENGL */
@@ -29,6 +29,7 @@ private:
     OpenGLFramebuffer _opaqueFramebuffer;
     OpenGLFramebuffer _transparentFramebuffer;
     OpenGLFramebuffer _mixFramebuffer;
+    OpenGLFramebuffer _savedFramebuffer;
     GLuint _backDepth;
 
 public:
@@ -53,4 +54,15 @@ public:
 
     void ApplyTransparency(ApplyTransparencyShader& shader, GLuint paletteTex);
     void Clear();
+
+    /**
+     * Moves a rectangle of the final frame by the given offset, in screen coordinates.
+     */
+    void CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy);
+
+    /**
+     * Keeps a copy of the final frame, so something drawn over it for one frame only can be removed again by restoring it.
+     */
+    void SaveFinal();
+    void RestoreFinal();
 };
@@ -12,14 +12,26 @@
 #    include "TextureCache.h"
 
 #    include <algorithm>
+#    include <cstring>
+#    include <openrct2/Context.h>
+#    include <openrct2/FrameProfiler.h>
+#    include <openrct2/config/Config.h>
+#    include <openrct2/core/MemoryUsage.h>
 #    include <openrct2/drawing/Drawing.h>
 #    include <openrct2/util/Util.h>
 #    include <openrct2/world/Location.hpp>
 #    include <stdexcept>
 #    include <vector>
 
+using namespace OpenRCT2;
+
 constexpr uint32_t UNUSED_INDEX = 0xFFFFFFFF;
 
+// Glyph palettes are stored in the rows of the palette texture below the filter palettes.
+constexpr GLint PALETTE_ROWS = 256;
+constexpr GLint GLYPH_PALETTE_FIRST_ROW = PALETTE_TO_G1_OFFSET_COUNT + 5;
+constexpr size_t GLYPH_PALETTE_ROWS = PALETTE_ROWS - GLYPH_PALETTE_FIRST_ROW;
+
 TextureCache::TextureCache()
 {
     std::fill(_indexMap.begin(), _indexMap.end(), UNUSED_INDEX);
@@ -27,18 +39,38 @@ TextureCache::TextureCache()
 
 TextureCache::~TextureCache()
 {
+    WaitForPendingImages();
     FreeTextures();
 }
 
 void TextureCache::InvalidateImage(uint32_t image)
 {
     unique_lock lock(_mutex);
+    RemoveImage(image);
+}
 
+void TextureCache::RemoveImage(uint32_t image)
+{
     uint32_t index = _indexMap[image];
     if (index == UNUSED_INDEX)
         return;
 
     AtlasTextureInfo& elem = _textureCache.at(index);
+    if (!elem.loaded)
+    {
+        auto it = std::find_if(_pendingImages.begin(), _pendingImages.end(), [image](const auto& pendingImage) {
+            return pendingImage->Image == image && !pendingImage->IsCancelled;
+        });
+        if (it != _pendingImages.end())
+        {
+            // The image may be freed once it has been invalidated, so it must not still be decoding.
+            if (!(*it)->IsDecoded.load(std::memory_order_acquire))
+            {
+                WaitForPendingImages();
+            }
+            (*it)->IsCancelled = true;
+        }
+    }
 
     _atlases[elem.index].Free(elem);
     _indexMap[image] = UNUSED_INDEX;
@@ -77,7 +109,9 @@ BasicTextureInfo TextureCache::GetOrLoadImageTexture(uint32_t image)
         index = _indexMap[image];
         if (index != UNUSED_INDEX)
         {
-            const auto& info = _textureCache[index];
+            auto& entry = _textureCache[index];
+            entry.lastUsedFrame = _frame;
+            const auto& info = entry.loaded ? entry : _placeholder;
             return {
                 info.index,
                 info.normalizedBounds,
@@ -85,39 +119,41 @@ BasicTextureInfo TextureCache::GetOrLoadImageTexture(uint32_t image)
         }
     }
 
-    // Load new texture.
+    // Give the image a slot straight away, so it is only queued once.
     unique_lock lock(_mutex);
 
+    auto g1Element = gfx_get_g1_element(image);
+    if (g1Element == nullptr)
+    {
+        return _placeholder;
+    }
+
     index = static_cast<uint32_t>(_textureCache.size());
+    _numAtlasMisses++;
 
-    AtlasTextureInfo info = LoadImageTexture(image);
+    AtlasTextureInfo info = AllocateImage(g1Element->width, g1Element->height);
+    info.image = image;
+    info.lastUsedFrame = _frame;
 
     _textureCache.push_back(info);
     _indexMap[image] = index;
 
-    return info;
+    QueueImageTexture(image, info);
+
+    return _placeholder;
 }
 
-BasicTextureInfo TextureCache::GetOrLoadGlyphTexture(uint32_t image, const PaletteMap& paletteMap)
+BasicTextureInfo TextureCache::GetOrLoadGlyphTexture(uint32_t image)
 {
-    GlyphId glyphId{};
-    glyphId.Image = image;
-
     // Try to read cached texture first.
     {
         shared_lock lock(_mutex);
 
-        uint8_t glyphMap[8];
-        for (uint8_t i = 0; i < 8; i++)
-        {
-            glyphMap[i] = paletteMap[i];
-        }
-        std::copy_n(glyphMap, sizeof(glyphId.Palette), reinterpret_cast<uint8_t*>(&glyphId.Palette));
-
-        auto kvp = _glyphTextureMap.find(glyphId);
+        auto kvp = _glyphTextureMap.find(image);
         if (kvp != _glyphTextureMap.end())
         {
-            const auto& info = kvp->second;
+            auto& info = kvp->second;
+            info.lastUsedFrame = _frame;
             return {
                 info.index,
                 info.normalizedBounds,
@@ -128,12 +164,53 @@ BasicTextureInfo TextureCache::GetOrLoadGlyphTexture(uint32_t image, const Palet
     // Load new texture.
     unique_lock lock(_mutex);
 
-    auto cacheInfo = LoadGlyphTexture(image, paletteMap);
-    auto it = _glyphTextureMap.insert(std::make_pair(glyphId, cacheInfo));
+    _numAtlasMisses++;
+    auto cacheInfo = LoadGlyphTexture(image);
+    auto it = _glyphTextureMap.insert(std::make_pair(image, cacheInfo));
 
     return (*it.first).second;
 }
 
+GLint TextureCache::GetOrAddGlyphPalette(const PaletteMap& paletteMap)
+{
+    // Glyphs only use the first 8 colours, any others are left transparent like the software renderer does.
+    uint8_t glyphMap[PALETTE_ROWS]{};
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        glyphMap[i] = paletteMap[i];
+    }
+    uint64_t key;
+    std::memcpy(&key, glyphMap, sizeof(key));
+
+    {
+        shared_lock lock(_mutex);
+
+        auto kvp = _glyphPaletteRows.find(key);
+        if (kvp != _glyphPaletteRows.end())
+        {
+            return kvp->second;
+        }
+    }
+
+    unique_lock lock(_mutex);
+
+    // The rows are only reset when a frame begins, as the commands of the current frame may still use them. Should a
+    // single frame use more palettes than there are rows, the last row is shared.
+    auto row = GLYPH_PALETTE_FIRST_ROW + static_cast<GLint>(_glyphPaletteRows.size());
+    if (row >= PALETTE_ROWS)
+    {
+        row = PALETTE_ROWS - 1;
+    }
+
+    CreateTextures();
+    glBindTexture(GL_TEXTURE_2D, _paletteTexture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, row, PALETTE_ROWS, 1, GL_RED_INTEGER, GL_UNSIGNED_BYTE, glyphMap);
+    _numUploadedBytes += sizeof(glyphMap);
+
+    _glyphPaletteRows[key] = row;
+    return row;
+}
+
 void TextureCache::CreateTextures()
 {
     if (!_initialized)
@@ -166,13 +243,21 @@ void TextureCache::CreateTextures()
         _initialized = true;
         _atlasesTextureIndices = 0;
         _atlasesTextureCapacity = 0;
+
+        uint8_t emptyPixel = 0;
+        _placeholder = AllocateImage(1, 1);
+        _placeholder.loaded = true;
+        glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
+        glTexSubImage3D(
+            GL_TEXTURE_2D_ARRAY, 0, _placeholder.bounds.x, _placeholder.bounds.y, _placeholder.index, 1, 1, 1,
+            GL_RED_INTEGER, GL_UNSIGNED_BYTE, &emptyPixel);
     }
 }
 
 void TextureCache::GeneratePaletteTexture()
 {
-    static_assert(PALETTE_TO_G1_OFFSET_COUNT + 5 < 256, "Height of palette too large!");
-    constexpr int32_t height = 256;
+    static_assert(GLYPH_PALETTE_FIRST_ROW < PALETTE_ROWS, "Height of palette too large!");
+    constexpr int32_t height = PALETTE_ROWS;
     constexpr int32_t width = height;
     rct_drawpixelinfo dpi = CreateDPI(width, height);
 
@@ -197,6 +282,7 @@ void TextureCache::GeneratePaletteTexture()
     glBindTexture(GL_TEXTURE_2D, _paletteTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, width, height, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, dpi.bits);
     DeleteDPI(dpi);
+    _glyphPaletteRows.clear();
 }
 
 void TextureCache::EnlargeAtlasesTexture(GLuint newEntries)
@@ -223,6 +309,7 @@ void TextureCache::EnlargeAtlasesTexture(GLuint newEntries)
         glTexImage3D(
             GL_TEXTURE_2D_ARRAY, 0, GL_R8UI, _atlasesTextureDimensions, _atlasesTextureDimensions, _atlasesTextureCapacity, 0,
             GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
+        MemoryUsage::Set(MemoryUsage::Category::TextureCache, GetAllocatedBytes());
 
         // Restore old data
         if (!oldPixels.empty())
@@ -236,34 +323,372 @@ void TextureCache::EnlargeAtlasesTexture(GLuint newEntries)
     _atlasesTextureIndices = newIndices;
 }
 
-AtlasTextureInfo TextureCache::LoadImageTexture(uint32_t image)
+void TextureCache::QueueImageTexture(uint32_t image, const AtlasTextureInfo& info)
 {
-    rct_drawpixelinfo dpi = GetImageAsDPI(image, 0);
+    auto pendingImage = std::make_unique<PendingImage>();
+    pendingImage->Image = image;
+    pendingImage->Info = info;
+    auto* pendingImagePtr = pendingImage.get();
+    _pendingImages.push_back(std::move(pendingImage));
 
-    auto cacheInfo = AllocateImage(dpi.width, dpi.height);
-    cacheInfo.image = image;
+    if (gConfigGeneral.multithreading)
+    {
+        if (!_decodeTasks)
+        {
+            _decodeTasks.emplace(GetContext()->GetTaskScheduler());
+        }
+        _decodeTasks->Run([pendingImagePtr]() -> void { DecodeImage(*pendingImagePtr); });
+    }
+    else
+    {
+        DecodeImage(*pendingImagePtr);
+    }
+}
 
+void TextureCache::DecodeImage(PendingImage& pendingImage)
+{
+    auto g1Element = gfx_get_g1_element(pendingImage.Image);
+    int32_t width = g1Element->width;
+    int32_t height = g1Element->height;
+    pendingImage.Pixels.assign(static_cast<size_t>(width) * height, 0);
+
+    rct_drawpixelinfo dpi;
+    dpi.bits = pendingImage.Pixels.data();
+    dpi.pitch = 0;
+    dpi.x = 0;
+    dpi.y = 0;
+    dpi.width = width;
+    dpi.height = height;
+    dpi.zoom_level = 0;
+    gfx_draw_sprite_software(&dpi, ImageId::FromUInt32(pendingImage.Image), { -g1Element->x_offset, -g1Element->y_offset });
+
+    pendingImage.IsDecoded.store(true, std::memory_order_release);
+}
+
+void TextureCache::WaitForPendingImages()
+{
+    if (_decodeTasks)
+    {
+        _decodeTasks->Wait();
+    }
+}
+
+void TextureCache::BeginFrame()
+{
+    _frame++;
+    if (_frame % TEXTURE_CACHE_MAINTENANCE_INTERVAL == 0)
+    {
+        unique_lock lock(_mutex);
+        const auto budget = static_cast<size_t>(std::max(gConfigGeneral.texture_memory_budget, 0)) * 1024 * 1024;
+        EvictImages(budget);
+        CompactAtlases(budget);
+    }
+
+    // Start over once half of the glyph palette rows are used, so a frame never runs out of them.
+    if (_glyphPaletteRows.size() > GLYPH_PALETTE_ROWS / 2)
+    {
+        unique_lock lock(_mutex);
+        _glyphPaletteRows.clear();
+    }
+
+    UploadPendingImages();
+
+    auto& profiler = FrameProfiler::Get();
+    if (profiler.IsEnabled())
+    {
+        shared_lock lock(_mutex);
+        ProfilerTextureStats stats;
+        stats.NumImages = _textureCache.size() + _glyphTextureMap.size();
+        stats.NumPendingImages = _pendingImages.size();
+        stats.UsedBytes = GetUsedBytes();
+        stats.AllocatedBytes = GetAllocatedBytes();
+        stats.NumEvictedImages = _numEvictedImages;
+        stats.NumCompactions = _numCompactions;
+        profiler.RecordTextureStats(stats);
+    }
+}
+
+void TextureCache::EvictImages(size_t budget)
+{
+    if (budget == 0)
+        return;
+
+    auto usedBytes = GetUsedBytes();
+    if (usedBytes <= budget)
+        return;
+
+    struct Candidate
+    {
+        uint32_t LastUsedFrame;
+        const AtlasTextureInfo* Info;
+        std::optional<uint32_t> Glyph;
+    };
+    std::vector<Candidate> candidates;
+    for (const auto& info : _textureCache)
+    {
+        if (info.loaded && _frame - info.lastUsedFrame >= TEXTURE_CACHE_MIN_EVICTION_AGE)
+            candidates.push_back({ info.lastUsedFrame, &info, std::nullopt });
+    }
+    for (const auto& [glyph, info] : _glyphTextureMap)
+    {
+        if (_frame - info.lastUsedFrame >= TEXTURE_CACHE_MIN_EVICTION_AGE)
+            candidates.push_back({ info.lastUsedFrame, &info, glyph });
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.LastUsedFrame < b.LastUsedFrame;
+    });
+
+    // Evict down to below the budget, so the next few new images do not go over it again straight away.
+    const auto target = budget - (budget / 4);
+    std::vector<uint32_t> evictedImages;
+    std::vector<uint32_t> evictedGlyphs;
+    for (const auto& candidate : candidates)
+    {
+        if (usedBytes <= target)
+            break;
+
+        const auto imageSize = static_cast<size_t>(_atlases[candidate.Info->index].GetImageSize());
+        usedBytes -= imageSize * imageSize;
+        if (candidate.Glyph)
+            evictedGlyphs.push_back(*candidate.Glyph);
+        else
+            evictedImages.push_back(candidate.Info->image);
+    }
+
+    // The candidates point into the cache, so nothing is removed until they have all been looked at.
+    for (auto image : evictedImages)
+    {
+        RemoveImage(image);
+    }
+    for (auto glyph : evictedGlyphs)
+    {
+        auto it = _glyphTextureMap.find(glyph);
+        _atlases[it->second.index].Free(it->second);
+        _glyphTextureMap.erase(it);
+    }
+    _numEvictedImages += evictedImages.size() + evictedGlyphs.size();
+}
+
+void TextureCache::CompactAtlases(size_t budget)
+{
+    // Images that are still pending already have their slot, they would have to be moved while they are decoded.
+    if (!_initialized || !_pendingImages.empty())
+        return;
+
+    // Over the budget, the spare layers the texture array has grown by are freed as well.
+    const auto numRequiredAtlases = CountRequiredAtlases();
+    const bool isOverBudget = budget != 0 && GetAllocatedBytes() > budget;
+    if (isOverBudget)
+    {
+        if (_atlasesTextureCapacity <= numRequiredAtlases)
+            return;
+    }
+    else if (_atlases.size() - numRequiredAtlases < TEXTURE_CACHE_MIN_COMPACTION_ATLASES)
+    {
+        return;
+    }
+    const auto numFreedAtlases = _atlasesTextureCapacity - numRequiredAtlases;
+
+    const auto dimensions = static_cast<size_t>(_atlasesTextureDimensions);
+    const auto atlasBytes = dimensions * dimensions;
+    std::vector<uint8_t> oldPixels(atlasBytes * _atlasesTextureCapacity);
     glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
-    glTexSubImage3D(
-        GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, dpi.width, dpi.height, 1,
-        GL_RED_INTEGER, GL_UNSIGNED_BYTE, dpi.bits);
+    glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, oldPixels.data());
+
+    // Allocate every image again from new atlases, which packs each size of slot into as few atlases as possible.
+    _atlases.clear();
+    std::vector<uint8_t> newPixels;
+    auto moveImage = [&](AtlasTextureInfo& info) {
+        const auto width = info.bounds.z - info.bounds.x;
+        const auto height = info.bounds.w - info.bounds.y;
+        auto* atlas = FindAtlas(width, height);
+        if (atlas == nullptr)
+        {
+            atlas = &AddAtlas(width, height);
+            newPixels.resize(newPixels.size() + atlasBytes);
+        }
 
-    DeleteDPI(dpi);
+        auto newInfo = atlas->Allocate(width, height);
+        for (int32_t y = 0; y < height; y++)
+        {
+            const auto* src = oldPixels.data() + (info.index * atlasBytes) + ((info.bounds.y + y) * dimensions)
+                + info.bounds.x;
+            auto* dst = newPixels.data() + (newInfo.index * atlasBytes) + ((newInfo.bounds.y + y) * dimensions)
+                + newInfo.bounds.x;
+            std::copy_n(src, width, dst);
+        }
 
-    return cacheInfo;
+        info.index = newInfo.index;
+        info.slot = newInfo.slot;
+        info.bounds = newInfo.bounds;
+        info.normalizedBounds = newInfo.normalizedBounds;
+    };
+
+    moveImage(_placeholder);
+    for (auto& info : _textureCache)
+    {
+        moveImage(info);
+    }
+    for (auto& [glyph, info] : _glyphTextureMap)
+    {
+        moveImage(info);
+    }
+
+    _atlasesTextureIndices = static_cast<GLuint>(_atlases.size());
+    _atlasesTextureCapacity = _atlasesTextureIndices;
+    glTexImage3D(
+        GL_TEXTURE_2D_ARRAY, 0, GL_R8UI, _atlasesTextureDimensions, _atlasesTextureDimensions, _atlasesTextureCapacity, 0,
+        GL_RED_INTEGER, GL_UNSIGNED_BYTE, newPixels.data());
+    MemoryUsage::Set(MemoryUsage::Category::TextureCache, GetAllocatedBytes());
+    _numCompactions++;
+
+    log_verbose(
+        "Compacted texture atlases, %zu images in %u atlases (%zu freed).", _textureCache.size() + _glyphTextureMap.size(),
+        _atlasesTextureCapacity, numFreedAtlases);
+}
+
+size_t TextureCache::GetUsedBytes() const
+{
+    size_t usedBytes = 0;
+    for (const auto& atlas : _atlases)
+    {
+        const auto imageSize = static_cast<size_t>(atlas.GetImageSize());
+        usedBytes += static_cast<size_t>(atlas.GetTotalSlots() - atlas.GetFreeSlots()) * imageSize * imageSize;
+    }
+    return usedBytes;
+}
+
+size_t TextureCache::GetAllocatedBytes() const
+{
+    const auto dimensions = static_cast<size_t>(_atlasesTextureDimensions);
+    return dimensions * dimensions * _atlasesTextureCapacity;
+}
+
+size_t TextureCache::CountRequiredAtlases() const
+{
+    // Atlases of each slot size, by the order of the size.
+    std::unordered_map<int32_t, std::pair<int32_t, int32_t>> usedAndTotalSlots;
+    for (const auto& atlas : _atlases)
+    {
+        auto& [usedSlots, totalSlots] = usedAndTotalSlots[atlas.GetImageSize()];
+        usedSlots += atlas.GetTotalSlots() - atlas.GetFreeSlots();
+        totalSlots = atlas.GetTotalSlots();
+    }
+
+    size_t numAtlases = 0;
+    for (const auto& kvp : usedAndTotalSlots)
+    {
+        const auto& [usedSlots, totalSlots] = kvp.second;
+        numAtlases += static_cast<size_t>((usedSlots + totalSlots - 1) / totalSlots);
+    }
+    return numAtlases;
+}
+
+void TextureCache::UploadPendingImages()
+{
+    unique_lock lock(_mutex);
+
+    const auto isDecoded = [](const auto& pendingImage) {
+        return pendingImage->IsDecoded.load(std::memory_order_acquire);
+    };
+    _pendingImages.erase(
+        std::remove_if(
+            _pendingImages.begin(), _pendingImages.end(),
+            [&isDecoded](const auto& pendingImage) { return pendingImage->IsCancelled && isDecoded(pendingImage); }),
+        _pendingImages.end());
+    if (std::none_of(_pendingImages.begin(), _pendingImages.end(), isDecoded))
+        return;
+
+    // Skip a frame rather than wait for the driver to finish with the buffer.
+    auto& uploadBuffer = _uploadBuffers[_uploadBufferIndex];
+    if (uploadBuffer.Fence != nullptr)
+    {
+        if (glClientWaitSync(uploadBuffer.Fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+            return;
+
+        glDeleteSync(uploadBuffer.Fence);
+        uploadBuffer.Fence = nullptr;
+    }
+
+    if (uploadBuffer.Buffer == 0)
+    {
+        glGenBuffers(1, &uploadBuffer.Buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, uploadBuffer.Buffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, TEXTURE_CACHE_UPLOAD_BUFFER_SIZE, nullptr, GL_STREAM_DRAW);
+    }
+    else
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, uploadBuffer.Buffer);
+    }
+
+    // The fence has been passed, so the buffer can be written without the driver synchronising.
+    auto* mapped = static_cast<uint8_t*>(glMapBufferRange(
+        GL_PIXEL_UNPACK_BUFFER, 0, TEXTURE_CACHE_UPLOAD_BUFFER_SIZE,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+    if (mapped == nullptr)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return;
+    }
+
+    std::vector<std::pair<PendingImage*, size_t>> uploads;
+    size_t offset = 0;
+    for (auto& pendingImage : _pendingImages)
+    {
+        if (pendingImage->IsCancelled || !isDecoded(pendingImage))
+            continue;
+
+        // Atlases are never larger than the buffer, so every image fits into an empty one.
+        const auto& pixels = pendingImage->Pixels;
+        if (offset + pixels.size() > TEXTURE_CACHE_UPLOAD_BUFFER_SIZE)
+            break;
+
+        std::copy(pixels.begin(), pixels.end(), mapped + offset);
+        uploads.emplace_back(pendingImage.get(), offset);
+        offset += pixels.size();
+    }
+
+    if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE)
+    {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
+        for (auto& [pendingImage, pixelsOffset] : uploads)
+        {
+            const auto& info = pendingImage->Info;
+            glTexSubImage3D(
+                GL_TEXTURE_2D_ARRAY, 0, info.bounds.x, info.bounds.y, info.index, info.bounds.z - info.bounds.x,
+                info.bounds.w - info.bounds.y, 1, GL_RED_INTEGER, GL_UNSIGNED_BYTE,
+                reinterpret_cast<const GLvoid*>(static_cast<uintptr_t>(pixelsOffset)));
+
+            _textureCache[_indexMap[pendingImage->Image]].loaded = true;
+            pendingImage->IsUploaded = true;
+        }
+        uploadBuffer.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        _numUploadedBytes += offset;
+        _uploadBufferIndex = (_uploadBufferIndex + 1) % _uploadBuffers.size();
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    _pendingImages.erase(
+        std::remove_if(
+            _pendingImages.begin(), _pendingImages.end(),
+            [](const auto& pendingImage) { return pendingImage->IsUploaded; }),
+        _pendingImages.end());
 }
 
-AtlasTextureInfo TextureCache::LoadGlyphTexture(uint32_t image, const PaletteMap& paletteMap)
+AtlasTextureInfo TextureCache::LoadGlyphTexture(uint32_t image)
 {
-    rct_drawpixelinfo dpi = GetGlyphAsDPI(image, paletteMap);
+    rct_drawpixelinfo dpi = GetGlyphAsDPI(image);
 
     auto cacheInfo = AllocateImage(dpi.width, dpi.height);
     cacheInfo.image = image;
+    cacheInfo.loaded = true;
+    cacheInfo.lastUsedFrame = _frame;
 
     glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
     glTexSubImage3D(
         GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, dpi.width, dpi.height, 1,
         GL_RED_INTEGER, GL_UNSIGNED_BYTE, dpi.bits);
+    _numUploadedBytes += static_cast<uint64_t>(dpi.width) * dpi.height;
 
     DeleteDPI(dpi);
 
@@ -275,15 +700,36 @@ AtlasTextureInfo TextureCache::AllocateImage(int32_t imageWidth, int32_t imageHe
     CreateTextures();
 
     // Find an atlas that fits this image
+    auto* atlas = FindAtlas(imageWidth, imageHeight);
+    if (atlas != nullptr)
+    {
+        return atlas->Allocate(imageWidth, imageHeight);
+    }
+
+    // If there is no such atlas, then create a new one
+    auto& newAtlas = AddAtlas(imageWidth, imageHeight);
+
+    // Enlarge texture array to support new atlas
+    EnlargeAtlasesTexture(1);
+
+    // And allocate from the new atlas
+    return newAtlas.Allocate(imageWidth, imageHeight);
+}
+
+Atlas* TextureCache::FindAtlas(int32_t imageWidth, int32_t imageHeight)
+{
     for (Atlas& atlas : _atlases)
     {
         if (atlas.GetFreeSlots() > 0 && atlas.IsImageSuitable(imageWidth, imageHeight))
         {
-            return atlas.Allocate(imageWidth, imageHeight);
+            return &atlas;
         }
     }
+    return nullptr;
+}
 
-    // If there is no such atlas, then create a new one
+Atlas& TextureCache::AddAtlas(int32_t imageWidth, int32_t imageHeight)
+{
     if (static_cast<int32_t>(_atlases.size()) >= _atlasesTextureIndicesLimit)
     {
         throw std::runtime_error("more texture atlases required, but device limit reached!");
@@ -296,28 +742,12 @@ AtlasTextureInfo TextureCache::AllocateImage(int32_t imageWidth, int32_t imageHe
     log_verbose("new texture atlas #%d (size %d) allocated", atlasIndex, atlasSize);
 #    endif
 
-    _atlases.emplace_back(atlasIndex, atlasSize);
-    _atlases.back().Initialise(_atlasesTextureDimensions, _atlasesTextureDimensions);
-
-    // Enlarge texture array to support new atlas
-    EnlargeAtlasesTexture(1);
-
-    // And allocate from the new atlas
-    return _atlases.back().Allocate(imageWidth, imageHeight);
-}
-
-rct_drawpixelinfo TextureCache::GetImageAsDPI(uint32_t image, uint32_t tertiaryColour)
-{
-    auto g1Element = gfx_get_g1_element(image & 0x7FFFFUL);
-    int32_t width = g1Element->width;
-    int32_t height = g1Element->height;
-
-    rct_drawpixelinfo dpi = CreateDPI(width, height);
-    gfx_draw_sprite_software(&dpi, ImageId::FromUInt32(image, tertiaryColour), { -g1Element->x_offset, -g1Element->y_offset });
-    return dpi;
+    auto& atlas = _atlases.emplace_back(atlasIndex, atlasSize);
+    atlas.Initialise(_atlasesTextureDimensions, _atlasesTextureDimensions);
+    return atlas;
 }
 
-rct_drawpixelinfo TextureCache::GetGlyphAsDPI(uint32_t image, const PaletteMap& palette)
+rct_drawpixelinfo TextureCache::GetGlyphAsDPI(uint32_t image)
 {
     auto g1Element = gfx_get_g1_element(image & 0x7FFFFUL);
     int32_t width = g1Element->width;
@@ -326,14 +756,26 @@ rct_drawpixelinfo TextureCache::GetGlyphAsDPI(uint32_t image, const PaletteMap&
     rct_drawpixelinfo dpi = CreateDPI(width, height);
 
     const auto glyphCoords = ScreenCoordsXY{ -g1Element->x_offset, -g1Element->y_offset };
-    gfx_draw_sprite_palette_set_software(&dpi, ImageId::FromUInt32(image), glyphCoords, palette);
+    gfx_draw_sprite_palette_set_software(&dpi, ImageId::FromUInt32(image), glyphCoords, PaletteMap::GetDefault());
     return dpi;
 }
 
 void TextureCache::FreeTextures()
 {
+    for (auto& uploadBuffer : _uploadBuffers)
+    {
+        if (uploadBuffer.Fence != nullptr)
+        {
+            glDeleteSync(uploadBuffer.Fence);
+        }
+        glDeleteBuffers(1, &uploadBuffer.Buffer);
+        uploadBuffer = {};
+    }
+    _pendingImages.clear();
+
     // Free array texture
     glDeleteTextures(1, &_atlasesTexture);
+    MemoryUsage::Set(MemoryUsage::Category::TextureCache, 0);
     _textureCache.clear();
     std::fill(_indexMap.begin(), _indexMap.end(), UNUSED_INDEX);
 }
@@ -15,8 +15,12 @@
 #include <SDL_pixels.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <openrct2/common.h>
+#include <openrct2/core/TaskScheduler.h>
+#include <optional>
 #ifndef __MACOSX__
 #    include <shared_mutex>
 #endif
@@ -27,31 +31,6 @@ struct rct_drawpixelinfo;
 struct PaletteMap;
 enum class FilterPaletteID : int32_t;
 
-struct GlyphId
-{
-    uint32_t Image;
-    uint64_t Palette;
-
-    struct Hash
-    {
-        size_t operator()(const GlyphId& k) const
-        {
-            size_t hash = k.Image * 7;
-            hash += (k.Palette & 0xFFFFFFFFUL) * 13;
-            hash += (k.Palette >> 32UL) * 23;
-            return hash;
-        }
-    };
-
-    struct Equal
-    {
-        bool operator()(const GlyphId& lhs, const GlyphId& rhs) const
-        {
-            return lhs.Image == rhs.Image && lhs.Palette == rhs.Palette;
-        }
-    };
-};
-
 // This is the maximum width and height of each atlas, basically the
 // granularity at which new atlases are allocated (2048 -> 4 MB of VRAM)
 constexpr int32_t TEXTURE_CACHE_MAX_ATLAS_SIZE = 2048;
@@ -60,6 +39,20 @@ constexpr int32_t TEXTURE_CACHE_MAX_ATLAS_SIZE = 2048;
 // Must be a power of 2!
 constexpr int32_t TEXTURE_CACHE_SMALLEST_SLOT = 32;
 
+// Size and number of the pixel buffers images are uploaded through. Each frame fills one of them, so the driver can
+// still be reading the ones of the frames before.
+constexpr size_t TEXTURE_CACHE_UPLOAD_BUFFER_SIZE = 4 * 1024 * 1024;
+constexpr size_t TEXTURE_CACHE_UPLOAD_BUFFER_COUNT = 3;
+
+// How often, in frames, images are evicted to stay within the texture memory budget and atlases are compacted.
+constexpr uint32_t TEXTURE_CACHE_MAINTENANCE_INTERVAL = 256;
+
+// Images that have been drawn within this number of frames are never evicted.
+constexpr uint32_t TEXTURE_CACHE_MIN_EVICTION_AGE = 40;
+
+// Atlases are only compacted once at least this many of them can be freed, as it copies the whole texture array.
+constexpr size_t TEXTURE_CACHE_MIN_COMPACTION_ATLASES = 2;
+
 struct BasicTextureInfo
 {
     GLuint index;
@@ -72,6 +65,8 @@ struct AtlasTextureInfo : public BasicTextureInfo
     GLuint slot;
     ivec4 bounds;
     uint32_t image;
+    bool loaded;
+    uint32_t lastUsedFrame;
 };
 
 // Represents a texture atlas that images of a given maximum size can be allocated from
@@ -151,6 +146,16 @@ public:
         return static_cast<int32_t>(_freeSlots.size());
     }
 
+    [[nodiscard]] int32_t GetTotalSlots() const
+    {
+        return _cols * _rows;
+    }
+
+    [[nodiscard]] int32_t GetImageSize() const
+    {
+        return _imageSize;
+    }
+
     static int32_t CalculateImageSizeOrder(int32_t actualWidth, int32_t actualHeight)
     {
         int32_t actualSize = std::max(actualWidth, actualHeight);
@@ -199,11 +204,42 @@ private:
     GLuint _atlasesTextureIndices = 0;
     GLint _atlasesTextureIndicesLimit = 0;
     std::vector<Atlas> _atlases;
-    std::unordered_map<GlyphId, AtlasTextureInfo, GlyphId::Hash, GlyphId::Equal> _glyphTextureMap;
+    std::unordered_map<uint32_t, AtlasTextureInfo> _glyphTextureMap;
     std::vector<AtlasTextureInfo> _textureCache;
     std::array<uint32_t, 0x7FFFF> _indexMap;
 
     GLuint _paletteTexture = 0;
+    std::unordered_map<uint64_t, GLint> _glyphPaletteRows;
+
+    // An image that has been given a slot, but is still being decoded or waiting to be uploaded.
+    struct PendingImage
+    {
+        uint32_t Image{};
+        AtlasTextureInfo Info{};
+        std::vector<uint8_t> Pixels;
+        std::atomic_bool IsDecoded{};
+        bool IsCancelled{};
+        bool IsUploaded{};
+    };
+
+    struct UploadBuffer
+    {
+        GLuint Buffer{};
+        GLsync Fence{};
+    };
+
+    // Drawn instead of images that are not loaded yet, a slot that is left empty.
+    AtlasTextureInfo _placeholder{};
+    std::array<UploadBuffer, TEXTURE_CACHE_UPLOAD_BUFFER_COUNT> _uploadBuffers{};
+    size_t _uploadBufferIndex = 0;
+    std::vector<std::unique_ptr<PendingImage>> _pendingImages;
+    uint32_t _frame = 0;
+    uint64_t _numEvictedImages = 0;
+    uint64_t _numCompactions = 0;
+    uint64_t _numAtlasMisses = 0;
+    uint64_t _numUploadedBytes = 0;
+    // Declared last, so the tasks are finished before the images they decode are destroyed.
+    std::optional<OpenRCT2::TaskGroup> _decodeTasks;
 
 #ifndef __MACOSX__
     std::shared_mutex _mutex;
@@ -219,8 +255,39 @@ public:
     TextureCache();
     ~TextureCache();
     void InvalidateImage(uint32_t image);
+
+    /**
+     * Gets the texture of the image. Images that are not cached yet are decoded on worker threads and uploaded when a
+     * later frame begins, until then an empty placeholder is returned.
+     */
     BasicTextureInfo GetOrLoadImageTexture(uint32_t image);
-    BasicTextureInfo GetOrLoadGlyphTexture(uint32_t image, const PaletteMap& paletteMap);
+
+    /**
+     * Gets the texture of the glyph. Glyphs are stored with the colours of the sprite, which are remapped by the shader
+     * through the row of the palette texture returned by GetOrAddGlyphPalette, so each glyph is only uploaded once.
+     */
+    BasicTextureInfo GetOrLoadGlyphTexture(uint32_t image);
+    GLint GetOrAddGlyphPalette(const PaletteMap& paletteMap);
+
+    /**
+     * Must be called before the commands of a frame are recorded. Uploads the images that have finished decoding and
+     * every so often evicts the least recently used images to stay within the texture memory budget, after which
+     * atlases that have become mostly empty are compacted.
+     */
+    void BeginFrame();
+
+    /**
+     * The number of images and glyphs that were not in the atlases when they were needed, and the number of bytes of
+     * pixels uploaded to the textures, since the cache was created.
+     */
+    uint64_t GetNumAtlasMisses() const
+    {
+        return _numAtlasMisses;
+    }
+    uint64_t GetNumUploadedBytes() const
+    {
+        return _numUploadedBytes;
+    }
 
     GLuint GetAtlasesTexture();
     GLuint GetPaletteTexture();
@@ -230,11 +297,21 @@ private:
     void CreateTextures();
     void GeneratePaletteTexture();
     void EnlargeAtlasesTexture(GLuint newEntries);
-    AtlasTextureInfo LoadImageTexture(uint32_t image);
-    AtlasTextureInfo LoadGlyphTexture(uint32_t image, const PaletteMap& paletteMap);
+    void RemoveImage(uint32_t image);
+    void UploadPendingImages();
+    void EvictImages(size_t budget);
+    void CompactAtlases(size_t budget);
+    [[nodiscard]] size_t GetUsedBytes() const;
+    [[nodiscard]] size_t GetAllocatedBytes() const;
+    [[nodiscard]] size_t CountRequiredAtlases() const;
+    void QueueImageTexture(uint32_t image, const AtlasTextureInfo& info);
+    static void DecodeImage(PendingImage& pendingImage);
+    void WaitForPendingImages();
+    AtlasTextureInfo LoadGlyphTexture(uint32_t image);
     AtlasTextureInfo AllocateImage(int32_t imageWidth, int32_t imageHeight);
-    static rct_drawpixelinfo GetImageAsDPI(uint32_t image, uint32_t tertiaryColour);
-    static rct_drawpixelinfo GetGlyphAsDPI(uint32_t image, const PaletteMap& paletteMap);
+    Atlas* FindAtlas(int32_t imageWidth, int32_t imageHeight);
+    Atlas& AddAtlas(int32_t imageWidth, int32_t imageHeight);
+    static rct_drawpixelinfo GetGlyphAsDPI(uint32_t image);
     void FreeTextures();
 
     static rct_drawpixelinfo CreateDPI(int32_t width, int32_t height);
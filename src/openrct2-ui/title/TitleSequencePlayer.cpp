@@ -12,7 +12,11 @@
 #include "../interface/Window.h"
 
 #include <algorithm>
+#include <chrono>
+#include <future>
+#include <list>
 #include <memory>
+#include <optional>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
 #include <openrct2/GameState.h>
@@ -21,6 +25,7 @@
 #include <openrct2/common.h>
 #include <openrct2/core/Console.hpp>
 #include <openrct2/core/Guard.hpp>
+#include <openrct2/core/MemoryStream.h>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
 #include <openrct2/interface/Viewport.h>
@@ -45,6 +50,15 @@ using namespace OpenRCT2;
 class TitleSequencePlayer final : public ITitleSequencePlayer
 {
 private:
+    struct CachedPark
+    {
+        uint8_t SaveIndex{};
+        std::string HintPath;
+        std::vector<uint8_t> Data;
+    };
+
+    static constexpr size_t MaxCachedParks = 3;
+
     GameState& _gameState;
 
     std::unique_ptr<TitleSequence> _sequence;
@@ -55,6 +69,11 @@ private:
     int32_t _lastScreenHeight = 0;
     CoordsXY _viewCentreLocation = {};
 
+    // The data of the parks loaded most recently, most recent first, and the park read ahead for the next load command.
+    std::list<CachedPark> _cachedParks;
+    std::future<std::optional<CachedPark>> _prefetchedPark;
+    uint8_t _prefetchedSaveIndex = SAVE_INDEX_INVALID;
+
 public:
     explicit TitleSequencePlayer(GameState& gameState)
         : _gameState(gameState)
@@ -73,6 +92,14 @@ public:
 
     void Eject() override
     {
+        // The park being read ahead uses the sequence.
+        if (_prefetchedPark.valid())
+        {
+            _prefetchedPark.wait();
+            _prefetchedPark = {};
+        }
+        _prefetchedSaveIndex = SAVE_INDEX_INVALID;
+        _cachedParks.clear();
         _sequence = nullptr;
     }
 
@@ -282,12 +309,17 @@ private:
             {
                 bool loadSuccess = false;
                 uint8_t saveIndex = command.SaveIndex;
-                auto parkHandle = TitleSequenceGetParkHandle(*_sequence, saveIndex);
-                if (parkHandle != nullptr)
+                auto park = GetPark(saveIndex);
+                if (park != nullptr)
                 {
-                    loadSuccess = LoadParkFromStream(parkHandle->Stream.get(), parkHandle->HintPath);
+                    auto stream = OpenRCT2::MemoryStream(park->Data.data(), park->Data.size());
+                    loadSuccess = LoadParkFromStream(&stream, park->HintPath);
                 }
-                if (!loadSuccess)
+                if (loadSuccess)
+                {
+                    PrefetchNextPark();
+                }
+                else
                 {
                     if (_sequence->Saves.size() > saveIndex)
                     {
@@ -356,6 +388,117 @@ private:
         }
     }
 
+    /**
+     * Returns the data of the given park, from the cache or the park read ahead if possible, so the park does not have to
+     * be read and unzipped again while the title screen is waiting for it.
+     */
+    const CachedPark* GetPark(uint8_t saveIndex)
+    {
+        auto it = std::find_if(_cachedParks.begin(), _cachedParks.end(), [saveIndex](const CachedPark& park) {
+            return park.SaveIndex == saveIndex;
+        });
+        if (it != _cachedParks.end())
+        {
+            _cachedParks.splice(_cachedParks.begin(), _cachedParks, it);
+            return &_cachedParks.front();
+        }
+
+        std::optional<CachedPark> park;
+        if (_prefetchedPark.valid() && _prefetchedSaveIndex == saveIndex)
+        {
+            park = _prefetchedPark.get();
+            _prefetchedSaveIndex = SAVE_INDEX_INVALID;
+        }
+        if (!park)
+        {
+            park = ReadPark(*_sequence, saveIndex);
+        }
+        if (!park)
+        {
+            return nullptr;
+        }
+
+        _cachedParks.push_front(std::move(*park));
+        if (_cachedParks.size() > MaxCachedParks)
+        {
+            _cachedParks.pop_back();
+        }
+        return &_cachedParks.front();
+    }
+
+    /**
+     * Starts reading the park of the next load command on a background thread. Importing the park changes the game state,
+     * so only reading and unzipping the data is done ahead.
+     */
+    void PrefetchNextPark()
+    {
+        if (_prefetchedPark.valid())
+        {
+            if (_prefetchedPark.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                return;
+            }
+            if (_prefetchedSaveIndex != SAVE_INDEX_INVALID)
+            {
+                // Not used by the load command it was read for, keep it for when the park is loaded later.
+                auto park = _prefetchedPark.get();
+                if (park && _cachedParks.size() < MaxCachedParks)
+                {
+                    _cachedParks.push_back(std::move(*park));
+                }
+            }
+            _prefetchedPark = {};
+            _prefetchedSaveIndex = SAVE_INDEX_INVALID;
+        }
+
+        const auto numCommands = _sequence->Commands.size();
+        for (size_t i = 1; i < numCommands; i++)
+        {
+            const auto& command = _sequence->Commands[(_position + i) % numCommands];
+            if (command.Type == TitleScript::Load)
+            {
+                auto saveIndex = command.SaveIndex;
+                auto isCached = std::any_of(_cachedParks.begin(), _cachedParks.end(), [saveIndex](const CachedPark& park) {
+                    return park.SaveIndex == saveIndex;
+                });
+                if (!isCached)
+                {
+                    // The sequence is not changed or destroyed until Eject has waited for this.
+                    const TitleSequence* sequence = _sequence.get();
+                    _prefetchedSaveIndex = saveIndex;
+                    _prefetchedPark = std::async(
+                        std::launch::async, [sequence, saveIndex]() { return ReadPark(*sequence, saveIndex); });
+                }
+                break;
+            }
+        }
+    }
+
+    static std::optional<CachedPark> ReadPark(const TitleSequence& sequence, uint8_t saveIndex)
+    {
+        auto parkHandle = TitleSequenceGetParkHandle(sequence, saveIndex);
+        if (parkHandle == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        try
+        {
+            auto& stream = *parkHandle->Stream;
+            CachedPark park;
+            park.SaveIndex = saveIndex;
+            park.HintPath = parkHandle->HintPath;
+            park.Data.resize(static_cast<size_t>(stream.GetLength() - stream.GetPosition()));
+            stream.Read(park.Data.data(), park.Data.size());
+            return park;
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to read park '%s': %s", parkHandle->HintPath.c_str(), e.what());
+            return std::nullopt;
+        }
+    }
+
     bool LoadParkFromFile(const utf8* path)
     {
         log_verbose("TitleSequencePlayer::LoadParkFromFile(%s)", path);
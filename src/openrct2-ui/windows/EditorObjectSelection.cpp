@@ -252,7 +252,6 @@ struct list_item
 {
     const ObjectRepositoryItem* repositoryItem;
     rct_object_entry* entry;
-    std::unique_ptr<rct_object_filters> filter;
     uint8_t* flags;
 };
 
@@ -265,6 +264,44 @@ static int32_t _listSortType = RIDE_SORT_TYPE;
 static bool _listSortDescending = false;
 static std::unique_ptr<Object> _loadedObject;
 
+// The lower case name, path and ride type of every object in the repository, separated by a character that can not be
+// searched for, so searching does not have to convert them on every keystroke.
+static std::vector<std::string> _searchIndex;
+static std::string _filterStringLower;
+
+static void search_index_build()
+{
+    size_t numObjects = object_repository_get_items_count();
+    const ObjectRepositoryItem* items = object_repository_get_items();
+
+    _searchIndex.clear();
+    _searchIndex.reserve(numObjects);
+    for (size_t i = 0; i < numObjects; i++)
+    {
+        const ObjectRepositoryItem* item = &items[i];
+        auto& text = _searchIndex.emplace_back();
+        text = item->Name;
+        text += '\n';
+        text += item->Path;
+        if (item->ObjectEntry.GetType() == ObjectType::Ride)
+        {
+            text += '\n';
+            text += language_get_string(get_ride_type_string_id(item));
+        }
+        std::transform(
+            text.begin(), text.end(), text.begin(), [](char c) { return static_cast<char>(tolower(static_cast<uint8_t>(c))); });
+    }
+}
+
+static void filter_string_set(const char* text)
+{
+    safe_strcpy(_filter_string, text, sizeof(_filter_string));
+    _filterStringLower = _filter_string;
+    std::transform(_filterStringLower.begin(), _filterStringLower.end(), _filterStringLower.begin(), [](char c) {
+        return static_cast<char>(tolower(static_cast<uint8_t>(c)));
+    });
+}
+
 static void visible_list_dispose()
 {
     _listItems.clear();
@@ -302,15 +339,9 @@ static void visible_list_refresh(rct_window* w)
         if (objectType == get_selected_object_type(w) && !(selectionFlags & OBJECT_SELECTION_FLAG_6) && filter_source(item)
             && filter_string(item) && filter_chunks(item) && filter_selected(selectionFlags))
         {
-            auto filter = std::make_unique<rct_object_filters>();
-            filter->ride.category[0] = 0;
-            filter->ride.category[1] = 0;
-            filter->ride.ride_type = 0;
-
             list_item currentListItem;
             currentListItem.repositoryItem = item;
             currentListItem.entry = const_cast<rct_object_entry*>(&item->ObjectEntry);
-            currentListItem.filter = std::move(filter);
             currentListItem.flags = &_objectSelectionFlags[i];
             _listItems.push_back(std::move(currentListItem));
         }
@@ -347,6 +378,21 @@ static void visible_list_refresh(rct_window* w)
     w->Invalidate();
 }
 
+/**
+ * Removes the objects that no longer match the search text. Only valid when every object that matches the new text also
+ * matched the old one, the list then stays sorted and the rest of the repository does not have to be looked at.
+ */
+static void visible_list_narrow(rct_window* w)
+{
+    w->selected_list_item = -1;
+    _listItems.erase(
+        std::remove_if(
+            _listItems.begin(), _listItems.end(),
+            [](const list_item& listItem) { return !filter_string(listItem.repositoryItem); }),
+        _listItems.end());
+    w->Invalidate();
+}
+
 static void window_editor_object_selection_init_widgets()
 {
     auto& widgets = _window_editor_object_selection_widgets;
@@ -386,7 +432,8 @@ rct_window* window_editor_object_selection_open()
         | (1ULL << WIDX_LIST_SORT_TYPE) | (1UL << WIDX_LIST_SORT_RIDE);
 
     _filter_flags = gConfigInterface.object_selection_filter_flags;
-    std::fill_n(_filter_string, sizeof(_filter_string), 0x00);
+    filter_string_set("");
+    search_index_build();
 
     for (size_t i = WIDX_TAB_1; i < WIDX_TAB_1 + std::size(ObjectSelectionPages); i++)
     {
@@ -513,7 +560,7 @@ static void window_editor_object_selection_mouseup(rct_window* w, rct_widgetinde
             window_start_textbox(w, widgetIndex, STR_STRING, _filter_string, sizeof(_filter_string));
             break;
         case WIDX_FILTER_CLEAR_BUTTON:
-            std::fill_n(_filter_string, sizeof(_filter_string), 0x00);
+            filter_string_set("");
             filter_update_counts();
             w->scrolls->v_top = 0;
             visible_list_refresh(w);
@@ -1193,10 +1240,13 @@ static void window_editor_object_selection_scrollpaint(rct_window* w, rct_drawpi
     uint8_t paletteIndex = ColourMapA[w->colours[1]].mid_light;
     gfx_clear(dpi, paletteIndex);
 
-    screenCoords.y = 0;
-    for (const auto& listItem : _listItems)
+    // Only the rows that are in view are drawn, starting from the first one that is.
+    size_t firstIndex = static_cast<size_t>(std::max(0, dpi->y / SCROLLABLE_ROW_HEIGHT - 1));
+    screenCoords.y = static_cast<int32_t>(firstIndex) * SCROLLABLE_ROW_HEIGHT;
+    for (size_t i = firstIndex; i < _listItems.size() && screenCoords.y <= dpi->y + dpi->height; i++)
     {
-        if (screenCoords.y + SCROLLABLE_ROW_HEIGHT >= dpi->y && screenCoords.y <= dpi->y + dpi->height)
+        const auto& listItem = _listItems[i];
+        if (screenCoords.y + SCROLLABLE_ROW_HEIGHT >= dpi->y)
         {
             // Draw checkbox
             if (!(gScreenFlags & SCREEN_FLAGS_TRACK_MANAGER) && !(*listItem.flags & 0x20))
@@ -1424,13 +1474,19 @@ static void window_editor_object_selection_textinput(rct_window* w, rct_widgetin
     if (strcmp(_filter_string, text) == 0)
         return;
 
-    safe_strcpy(_filter_string, text, sizeof(_filter_string));
+    // Typing more of the same search can only remove objects from the list.
+    auto previousFilter = _filterStringLower;
+    filter_string_set(text);
+    bool narrowed = _filterStringLower.find(previousFilter) != std::string::npos;
 
     filter_update_counts();
 
     w->scrolls->v_top = 0;
 
-    visible_list_refresh(w);
+    if (narrowed)
+        visible_list_narrow(w);
+    else
+        visible_list_refresh(w);
     w->Invalidate();
 }
 
@@ -1464,35 +1520,13 @@ static bool filter_string(const ObjectRepositoryItem* item)
     if (item->Name.empty())
         return false;
 
-    // Get ride type
-    const char* rideTypeName = language_get_string(get_ride_type_string_id(item));
-
-    // Get object name (ride/vehicle for rides) and type name (rides only)
-    char name_lower[MAX_PATH];
-    char type_lower[MAX_PATH];
-    char object_path[MAX_PATH];
-    char filter_lower[sizeof(_filter_string)];
-    safe_strcpy(name_lower, item->Name.c_str(), MAX_PATH);
-    safe_strcpy(type_lower, rideTypeName, MAX_PATH);
-    safe_strcpy(object_path, item->Path.c_str(), MAX_PATH);
-    safe_strcpy(filter_lower, _filter_string, sizeof(_filter_string));
-
-    // Make use of lowercase characters only
-    for (int32_t i = 0; name_lower[i] != '\0'; i++)
-        name_lower[i] = static_cast<char>(tolower(name_lower[i]));
-    for (int32_t i = 0; type_lower[i] != '\0'; i++)
-        type_lower[i] = static_cast<char>(tolower(type_lower[i]));
-    for (int32_t i = 0; object_path[i] != '\0'; i++)
-        object_path[i] = static_cast<char>(tolower(object_path[i]));
-    for (int32_t i = 0; filter_lower[i] != '\0'; i++)
-        filter_lower[i] = static_cast<char>(tolower(filter_lower[i]));
+    // Objects added to the repository since the window was opened are not in the index yet.
+    size_t index = static_cast<size_t>(item - object_repository_get_items());
+    if (index >= _searchIndex.size())
+        search_index_build();
 
     // Check if the searched string exists in the name, ride type, or filename
-    bool inName = strstr(name_lower, filter_lower) != nullptr;
-    bool inRideType = (item->ObjectEntry.GetType() == ObjectType::Ride) && strstr(type_lower, filter_lower) != nullptr;
-    bool inPath = strstr(object_path, filter_lower) != nullptr;
-
-    return inName || inRideType || inPath;
+    return _searchIndex[index].find(_filterStringLower) != std::string::npos;
 }
 
 static bool sources_match(ObjectSourceGame source)
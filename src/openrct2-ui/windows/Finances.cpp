@@ -677,11 +677,10 @@ static void window_finances_financial_graph_mouseup(rct_window* w, rct_widgetind
  */
 static void window_finances_financial_graph_update(rct_window* w)
 {
-    // Tab animation
+    // Tab animation, the graph itself is invalidated by the finance and park code whenever its values change
     if (++w->frame_no >= WindowFinancesTabAnimationLoops[w->page])
         w->frame_no = 0;
-
-    w->Invalidate();
+    widget_invalidate(w, WIDX_TAB_2);
 }
 
 /**
@@ -785,11 +784,10 @@ static void window_finances_park_value_graph_mouseup(rct_window* w, rct_widgetin
  */
 static void window_finances_park_value_graph_update(rct_window* w)
 {
-    // Tab animation
+    // Tab animation, the graph itself is invalidated by the finance and park code whenever its values change
     if (++w->frame_no >= WindowFinancesTabAnimationLoops[w->page])
         w->frame_no = 0;
-
-    w->Invalidate();
+    widget_invalidate(w, WIDX_TAB_3);
 }
 
 /**
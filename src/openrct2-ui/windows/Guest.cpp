@@ -993,12 +993,12 @@ void window_guest_overview_paint(rct_window* w, rct_drawpixelinfo* dpi)
     int32_t i = 0;
     for (; i < PEEP_MAX_THOUGHTS; ++i)
     {
-        if (peep->Thoughts[i].type == PeepThoughtType::None)
+        if (peep->GetThoughts()[i].type == PeepThoughtType::None)
         {
             w->list_information_type = 0;
             return;
         }
-        if (peep->Thoughts[i].freshness == 1)
+        if (peep->GetThoughts()[i].freshness == 1)
         { // If a fresh thought
             break;
         }
@@ -1012,7 +1012,7 @@ void window_guest_overview_paint(rct_window* w, rct_drawpixelinfo* dpi)
     screenPos.x = widget->width() - w->list_information_type;
     {
         auto ft = Formatter();
-        peep_thought_set_format_args(&peep->Thoughts[i], ft);
+        peep_thought_set_format_args(&peep->GetThoughts()[i], ft);
         DrawTextBasic(&dpi_marquee, { screenPos.x, 0 }, STR_WINDOW_COLOUR_2_STRINGID, ft, { FontSpriteBase::SMALL });
     }
 }
@@ -1795,7 +1795,7 @@ void window_guest_thoughts_paint(rct_window* w, rct_drawpixelinfo* dpi)
     DrawTextBasic(dpi, screenCoords, STR_GUEST_RECENT_THOUGHTS_LABEL);
 
     screenCoords.y += 10;
-    for (const auto& thought : peep->Thoughts)
+    for (const auto& thought : peep->GetThoughts())
     {
         if (thought.type == PeepThoughtType::None)
             return;
@@ -22,6 +22,8 @@
 #include <openrct2/util/Util.h>
 #include <openrct2/world/Park.h>
 #include <openrct2/world/Sprite.h>
+#include <string>
+#include <string_view>
 #include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_GUESTS;
@@ -119,7 +121,26 @@ private:
         using CompareFunc = bool (*)(const GuestItem&, const GuestItem&);
 
         uint16_t Id;
-        char Name[256];
+        std::string Name;
+    };
+
+    /**
+     * The formatted name of a guest, which is kept until the guest is renamed or replaced by another guest.
+     */
+    struct GuestName
+    {
+        bool Valid{};
+        uint32_t GuestNumber{};
+        std::string CustomName;
+        std::string Name;
+    };
+
+    enum class GuestState : uint8_t
+    {
+        Hidden,
+        Visible,
+        Renamed,
+        Listed,
     };
 
     static constexpr const uint8_t SUMMARISED_GUEST_ROW_HEIGHT = SCROLLABLE_ROW_HEIGHT + 11;
@@ -145,6 +166,10 @@ private:
     std::vector<GuestItem> _guestList;
     std::optional<size_t> _highlightedIndex;
 
+    bool _realNames{};
+    std::vector<GuestName> _guestNames;
+    std::vector<GuestState> _guestStates;
+
     uint32_t _tabAnimationIndex{};
 
 public:
@@ -548,20 +573,15 @@ public:
         {
             case TabId::Individual:
             {
-                auto i = screenCoords.y / SCROLLABLE_ROW_HEIGHT;
-                i += static_cast<int32_t>(_selectedPage * GUESTS_PER_PAGE);
-                for (const auto& guestItem : _guestList)
+                auto i = static_cast<size_t>(screenCoords.y / SCROLLABLE_ROW_HEIGHT);
+                i += _selectedPage * GUESTS_PER_PAGE;
+                if (i < _guestList.size())
                 {
-                    if (i == 0)
+                    auto guest = GetEntity<Guest>(_guestList[i].Id);
+                    if (guest != nullptr)
                     {
-                        auto guest = GetEntity<Guest>(guestItem.Id);
-                        if (guest != nullptr)
-                        {
-                            window_guest_open(guest);
-                        }
-                        break;
+                        window_guest_open(guest);
                     }
-                    i--;
                 }
                 break;
             }
@@ -608,35 +628,102 @@ public:
         }
         else
         {
+            RefreshIndividualList();
+        }
+    }
+
+private:
+    /**
+     * Updates the sorted list of guests to the guests that now pass the filters. Guests that are still listed under the
+     * same name stay where they are, so only the names of new and renamed guests have to be formatted and only they
+     * have to be sorted into the list.
+     */
+    void RefreshIndividualList()
+    {
+        const bool realNames = (gParkFlags & PARK_FLAGS_SHOW_REAL_GUEST_NAMES) != 0;
+        if (realNames != _realNames)
+        {
+            // Every name and the order of the whole list has changed.
+            _realNames = realNames;
+            _guestNames.clear();
             _guestList.clear();
+        }
+        _guestNames.resize(MAX_ENTITIES);
+        _guestStates.assign(MAX_ENTITIES, GuestState::Hidden);
 
-            for (auto peep : EntityList<Guest>())
+        for (auto peep : EntityList<Guest>())
+        {
+            sprite_set_flashing(peep, false);
+            if (peep->OutsideOfPark)
+                continue;
+            if (_selectedFilter)
             {
-                sprite_set_flashing(peep, false);
-                if (peep->OutsideOfPark)
-                    continue;
-                if (_selectedFilter)
-                {
-                    if (!IsPeepInFilter(*peep))
-                        continue;
-                    sprite_set_flashing(peep, true);
-                }
-                if (!GuestShouldBeVisible(*peep))
+                if (!IsPeepInFilter(*peep))
                     continue;
+                sprite_set_flashing(peep, true);
+            }
 
-                auto& item = _guestList.emplace_back();
-                item.Id = peep->sprite_index;
+            bool renamed = UpdateGuestName(*peep);
+            if (!GuestShouldBeVisible(*peep))
+                continue;
 
-                Formatter ft;
-                peep->FormatNameTo(ft);
-                format_string(item.Name, sizeof(item.Name), STR_STRINGID, ft.Data());
-            }
+            _guestStates[peep->sprite_index] = renamed ? GuestState::Renamed : GuestState::Visible;
+        }
 
-            std::sort(_guestList.begin(), _guestList.end(), GetGuestCompareFunc());
+        // Drop the guests that are gone, filtered out or renamed, the rest of the list is still in order.
+        _guestList.erase(
+            std::remove_if(
+                _guestList.begin(), _guestList.end(),
+                [this](const GuestItem& item) {
+                    auto& state = _guestStates[item.Id];
+                    if (state != GuestState::Visible)
+                        return true;
+                    state = GuestState::Listed;
+                    return false;
+                }),
+            _guestList.end());
+
+        // Sort the guests that are new to the list on their own and merge them in.
+        const auto numKept = _guestList.size();
+        for (uint16_t i = 0; i < MAX_ENTITIES; i++)
+        {
+            if (_guestStates[i] == GuestState::Visible || _guestStates[i] == GuestState::Renamed)
+            {
+                _guestList.push_back({ i, _guestNames[i].Name });
+            }
+        }
+        if (_guestList.size() != numKept)
+        {
+            auto compare = GetGuestCompareFunc();
+            auto firstAdded = _guestList.begin() + numKept;
+            std::sort(firstAdded, _guestList.end(), compare);
+            std::inplace_merge(_guestList.begin(), firstAdded, _guestList.end(), compare);
         }
     }
 
-private:
+    /**
+     * Formats the name of the guest if it has not been formatted yet or has changed since.
+     * @return true if the name was formatted.
+     */
+    bool UpdateGuestName(const Guest& peep)
+    {
+        auto& guestName = _guestNames[peep.sprite_index];
+        std::string_view customName = peep.Name != nullptr ? peep.Name : "";
+        if (guestName.Valid && guestName.GuestNumber == peep.Id && guestName.CustomName == customName)
+            return false;
+
+        char name[256]{};
+        Formatter ft;
+        peep.FormatNameTo(ft);
+        format_string(name, sizeof(name), STR_STRINGID, ft.Data());
+
+        guestName.Valid = true;
+        guestName.GuestNumber = peep.Id;
+        guestName.CustomName = customName;
+        guestName.Name = name;
+        return true;
+    }
+
     void DrawTabImages(rct_drawpixelinfo& dpi)
     {
         // Tab 1 image
@@ -656,13 +743,16 @@ private:
 
     void DrawScrollIndividual(rct_drawpixelinfo& dpi)
     {
-        size_t index = 0;
-        auto y = static_cast<int32_t>(_selectedPage) * -GUEST_PAGE_HEIGHT;
-        for (const auto& guestItem : _guestList)
+        // Only the rows that are in view are drawn, starting from the first one that is.
+        const auto pageTop = static_cast<int32_t>(_selectedPage) * GUEST_PAGE_HEIGHT;
+        size_t index = static_cast<size_t>(std::max(0, (dpi.y + pageTop) / SCROLLABLE_ROW_HEIGHT - 1));
+        auto y = static_cast<int32_t>(index) * SCROLLABLE_ROW_HEIGHT - pageTop;
+        for (; index < _guestList.size() && y < 0x7FFF && y < dpi.y + dpi.height; index++, y += SCROLLABLE_ROW_HEIGHT)
         {
+            const auto& guestItem = _guestList[index];
+
             // Check if y is beyond the scroll control
-            if (y + SCROLLABLE_ROW_HEIGHT + 1 >= -0x7FFF && y + SCROLLABLE_ROW_HEIGHT + 1 > dpi.y && y < 0x7FFF
-                && y < dpi.y + dpi.height)
+            if (y + SCROLLABLE_ROW_HEIGHT + 1 >= -0x7FFF && y + SCROLLABLE_ROW_HEIGHT + 1 > dpi.y)
             {
                 // Highlight backcolour and text colour (format)
                 rct_string_id format = STR_BLACK_STRING;
@@ -699,7 +789,7 @@ private:
                         break;
                     case GuestViewType::Thoughts:
                         // For each thought
-                        for (const auto& thought : peep->Thoughts)
+                        for (const auto& thought : peep->GetThoughts())
                         {
                             if (thought.type == PeepThoughtType::None)
                                 break;
@@ -716,8 +806,6 @@ private:
                         break;
                 }
             }
-            y += SCROLLABLE_ROW_HEIGHT;
-            index++;
         }
     }
 
@@ -780,12 +868,8 @@ private:
 
         if (!_filterName.empty())
         {
-            char name[256]{};
-
-            Formatter ft;
-            peep.FormatNameTo(ft);
-            format_string(name, sizeof(name), STR_STRINGID, ft.Data());
-            if (strcasestr(name, _filterName.c_str()) == nullptr)
+            const auto& name = _guestNames[peep.sprite_index].Name;
+            if (strcasestr(name.c_str(), _filterName.c_str()) == nullptr)
             {
                 return false;
             }
@@ -886,7 +970,7 @@ private:
                 break;
             case GuestViewType::Thoughts:
             {
-                const auto& thought = peep.Thoughts[0];
+                const auto& thought = peep.GetThoughts()[0];
                 if (thought.type != PeepThoughtType::None && thought.freshness <= 5)
                 {
                     peep_thought_set_format_args(&thought, ft);
@@ -945,7 +1029,7 @@ private:
                 }
             }
         }
-        return strlogicalcmp(a.Name, b.Name) < 0;
+        return strlogicalcmp(a.Name.c_str(), b.Name.c_str()) < 0;
     }
 
     static GuestItem::CompareFunc GetGuestCompareFunc()
@@ -18,15 +18,19 @@
 #include <openrct2/FileClassifier.h>
 #include <openrct2/Game.h>
 #include <openrct2/GameState.h>
+#include <openrct2/ParkInfoCache.h>
+#include <openrct2/PlatformEnvironment.h>
 #include <openrct2/config/Config.h>
 #include <openrct2/core/FileScanner.h>
 #include <openrct2/core/Guard.hpp>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
+#include <openrct2/localisation/Date.h>
 #include <openrct2/localisation/Localisation.h>
 #include <openrct2/platform/Platform2.h>
 #include <openrct2/platform/platform.h>
 #include <openrct2/rct2/T6Exporter.h>
+#include <openrct2/ride/RideData.h>
 #include <openrct2/ride/TrackDesign.h>
 #include <openrct2/scenario/Scenario.h>
 #include <openrct2/title/TitleScreen.h>
@@ -83,6 +87,7 @@ static rct_widget window_loadsave_widgets[] =
 static void window_loadsave_close(rct_window *w);
 static void window_loadsave_mouseup(rct_window *w, rct_widgetindex widgetIndex);
 static void window_loadsave_resize(rct_window *w);
+static void window_loadsave_update(rct_window *w);
 static void window_loadsave_scrollgetsize(rct_window *w, int32_t scrollIndex, int32_t *width, int32_t *height);
 static void window_loadsave_scrollmousedown(rct_window *w, int32_t scrollIndex, const ScreenCoordsXY& screenCoords);
 static void window_loadsave_scrollmouseover(rct_window *w, int32_t scrollIndex, const ScreenCoordsXY& screenCoords);
@@ -97,6 +102,7 @@ static rct_window_event_list window_loadsave_events([](auto& events)
     events.close = &window_loadsave_close;
     events.mouse_up = &window_loadsave_mouseup;
     events.resize = &window_loadsave_resize;
+    events.update = &window_loadsave_update;
     events.get_scroll_size = &window_loadsave_scrollgetsize;
     events.scroll_mousedown = &window_loadsave_scrollmousedown;
     events.scroll_mouseover = &window_loadsave_scrollmouseover;
@@ -130,6 +136,8 @@ static std::function<void(int32_t result, std::string_view)> _loadSaveCallback;
 static TrackDesign* _trackDesign;
 
 static std::vector<LoadSaveListItem> _listItems;
+static std::unique_ptr<ParkInfoCache> _parkInfoCache;
+static uint32_t _parkInfoRevision;
 static char _directory[MAX_PATH];
 static char _shortenedDirectory[MAX_PATH];
 static char _parentDirectory[MAX_PATH];
@@ -324,6 +332,12 @@ static void window_loadsave_close(rct_window* w)
 {
     _listItems.clear();
     window_close_by_class(WC_LOADSAVE_OVERWRITE_PROMPT);
+
+    if (_parkInfoCache != nullptr)
+    {
+        _parkInfoCache->Request({});
+        _parkInfoCache->Save();
+    }
 }
 
 static void window_loadsave_resize(rct_window* w)
@@ -340,6 +354,32 @@ static void window_loadsave_resize(rct_window* w)
     }
 }
 
+static void window_loadsave_update(rct_window* w)
+{
+    // Redraw once the details of more parks have been read in the background.
+    if (_parkInfoCache != nullptr && _parkInfoCache->GetRevision() != _parkInfoRevision)
+    {
+        _parkInfoRevision = _parkInfoCache->GetRevision();
+        w->Invalidate();
+    }
+}
+
+static bool window_loadsave_shows_park_info()
+{
+    auto type = _type & 0x0E;
+    return type == LOADSAVETYPE_GAME || type == LOADSAVETYPE_SCENARIO;
+}
+
+static ParkInfoCache& window_loadsave_get_park_info_cache()
+{
+    if (_parkInfoCache == nullptr)
+    {
+        auto env = OpenRCT2::GetContext()->GetPlatformEnvironment();
+        _parkInfoCache = std::make_unique<ParkInfoCache>(env->GetFilePath(OpenRCT2::PATHID::CACHE_PARKS));
+    }
+    return *_parkInfoCache;
+}
+
 static bool browse(bool isSave, char* path, size_t pathSize)
 {
     file_dialog_desc desc = {};
@@ -624,6 +664,7 @@ static void window_loadsave_textinput(rct_window* w, rct_widgetindex widgetIndex
 }
 
 constexpr uint16_t DATE_TIME_GAP = 2;
+constexpr int32_t PARK_INFO_HEIGHT = 3 * LIST_ROW_HEIGHT + 4;
 
 static void window_loadsave_compute_max_date_width()
 {
@@ -680,12 +721,68 @@ static void window_loadsave_invalidate(rct_window* w)
     window_loadsave_widgets[WIDX_SORT_NAME].right = window_loadsave_widgets[WIDX_SORT_DATE].left - 1;
 
     window_loadsave_widgets[WIDX_SCROLL].right = w->width - 4;
-    window_loadsave_widgets[WIDX_SCROLL].bottom = w->height - 30;
+    window_loadsave_widgets[WIDX_SCROLL].bottom = w->height - 30 - (window_loadsave_shows_park_info() ? PARK_INFO_HEIGHT : 0);
 
     window_loadsave_widgets[WIDX_BROWSE].top = w->height - 24;
     window_loadsave_widgets[WIDX_BROWSE].bottom = w->height - 6;
 }
 
+static void window_loadsave_draw_park_info(rct_window* w, rct_drawpixelinfo* dpi)
+{
+    if (!window_loadsave_shows_park_info() || _parkInfoCache == nullptr || w->selected_list_item < 0
+        || w->selected_list_item >= static_cast<int32_t>(_listItems.size()))
+        return;
+
+    const auto& item = _listItems[w->selected_list_item];
+    if (item.type != TYPE_FILE)
+        return;
+
+    auto info = _parkInfoCache->Get(item.path, static_cast<uint64_t>(item.date_modified));
+    if (!info)
+        return;
+
+    const int32_t width = w->width - 8;
+    auto screenCoords = w->windowPos + ScreenCoordsXY{ 4, window_loadsave_widgets[WIDX_SCROLL].bottom + 4 };
+
+    auto ft = Formatter();
+    ft.Add<const char*>(info->Name.c_str());
+    ft.Add<uint16_t>(info->MonthsElapsed);
+    DrawTextEllipsised(dpi, screenCoords, width, STR_LOADSAVE_PARK_NAME_DATE, ft);
+    screenCoords.y += LIST_ROW_HEIGHT;
+
+    ft = Formatter();
+    ft.Add<uint16_t>(info->NumGuests);
+    ft.Add<money32>(info->Cash);
+    ft.Add<uint16_t>(info->ParkRating);
+    DrawTextEllipsised(dpi, screenCoords, width, STR_LOADSAVE_PARK_DETAILS, ft);
+    screenCoords.y += LIST_ROW_HEIGHT;
+
+    // The same arguments as the objective in the park window.
+    if (info->ObjectiveType >= std::size(ObjectiveNames))
+        return;
+
+    ft = Formatter();
+    if (info->ObjectiveType == OBJECTIVE_BUILD_THE_BEST)
+    {
+        rct_string_id rideTypeString = STR_NONE;
+        if (info->ObjectiveNumGuests < RIDE_TYPE_COUNT)
+        {
+            rideTypeString = GetRideTypeDescriptor(info->ObjectiveNumGuests).Naming.Name;
+        }
+        ft.Add<rct_string_id>(rideTypeString);
+    }
+    else
+    {
+        ft.Add<uint16_t>(info->ObjectiveNumGuests);
+        ft.Add<int16_t>(date_get_total_months(MONTH_OCTOBER, info->ObjectiveYear));
+        if (info->ObjectiveType == OBJECTIVE_FINISH_5_ROLLERCOASTERS)
+            ft.Add<uint16_t>(static_cast<uint16_t>(info->ObjectiveCurrency));
+        else
+            ft.Add<money32>(info->ObjectiveCurrency);
+    }
+    DrawTextEllipsised(dpi, screenCoords, width, ObjectiveNames[info->ObjectiveType], ft);
+}
+
 static void window_loadsave_paint(rct_window* w, rct_drawpixelinfo* dpi)
 {
     WindowDrawWidgets(w, dpi);
@@ -730,6 +827,8 @@ static void window_loadsave_paint(rct_window* w, rct_drawpixelinfo* dpi)
     DrawTextBasic(
         dpi, w->windowPos + ScreenCoordsXY{ sort_date_widget.left + 5, sort_date_widget.top + 1 }, STR_DATE, &id,
         { COLOUR_GREY });
+
+    window_loadsave_draw_park_info(w, dpi);
 }
 
 static void window_loadsave_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi, int32_t scrollIndex)
@@ -948,6 +1047,20 @@ static void window_loadsave_populate_list(rct_window* w, int32_t includeNewItem,
         window_loadsave_sort_list();
     }
 
+    // Only the details of the parks in this directory are read, any that were still to be read elsewhere are dropped.
+    if (window_loadsave_shows_park_info())
+    {
+        std::vector<std::pair<std::string, uint64_t>> files;
+        for (const auto& item : _listItems)
+        {
+            if (item.type == TYPE_FILE)
+            {
+                files.emplace_back(item.path, static_cast<uint64_t>(item.date_modified));
+            }
+        }
+        window_loadsave_get_park_info_cache().Request(std::move(files));
+    }
+
     w->Invalidate();
 }
 
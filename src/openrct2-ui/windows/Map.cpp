@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <openrct2-ui/interface/LandTool.h>
 #include <openrct2-ui/interface/Viewport.h>
@@ -187,6 +188,9 @@ static uint32_t _currentLine;
 /** rct2: 0x00F1AD68 */
 static std::vector<uint8_t> _mapImageData;
 
+// The change count of every tile when it was last drawn to _mapImageData, see map_get_tile_change_counts.
+static std::vector<uint32_t> _mapImageTileChangeCounts;
+
 static uint16_t _landRightsToolSize;
 
 static void window_map_init_map();
@@ -207,6 +211,8 @@ static void window_map_set_peep_spawn_tool_down(const ScreenCoordsXY& screenCoor
 static void map_window_increase_map_size();
 static void map_window_decrease_map_size();
 static void map_window_set_pixels(rct_window* w);
+static void map_window_set_tile_pixel(rct_window* w, const TileCoordsXY& tile);
+static void map_window_set_changed_tile_pixels(rct_window* w);
 
 static CoordsXY map_window_screen_to_map(ScreenCoordsXY screenCoords);
 
@@ -222,7 +228,11 @@ rct_window* window_map_open()
     w = window_bring_to_front_by_class(WC_MAP);
     if (w != nullptr)
     {
-        w->selected_tab = 0;
+        if (w->selected_tab != 0)
+        {
+            w->selected_tab = 0;
+            window_map_init_map();
+        }
         w->list_information_type = 0;
         return w;
     }
@@ -286,6 +296,8 @@ static void window_map_close(rct_window* w)
 {
     _mapImageData.clear();
     _mapImageData.shrink_to_fit();
+    _mapImageTileChangeCounts.clear();
+    _mapImageTileChangeCounts.shrink_to_fit();
     if ((input_test_flag(INPUT_FLAG_TOOL_ACTIVE)) && gCurrentToolWidget.window_classification == w->classification
         && gCurrentToolWidget.window_number == w->number)
     {
@@ -388,6 +400,7 @@ static void window_map_mouseup(rct_window* w, rct_widgetindex widgetIndex)
 
                 w->selected_tab = widgetIndex;
                 w->list_information_type = 0;
+                window_map_init_map();
             }
     }
 }
@@ -447,7 +460,11 @@ static void window_map_update(rct_window* w)
         window_map_centre_on_view_point();
     }
 
-    for (int32_t i = 0; i < 16; i++)
+    map_window_set_changed_tile_pixels(w);
+
+    // Not every change to what a tile looks like on the map invalidates it, e.g. a ride changing its type, so the
+    // whole map is still slowly redrawn a line at a time
+    for (int32_t i = 0; i < 2; i++)
         map_window_set_pixels(w);
 
     w->Invalidate();
@@ -907,6 +924,9 @@ static void window_map_init_map()
 {
     std::fill(_mapImageData.begin(), _mapImageData.end(), PALETTE_INDEX_10);
     _currentLine = 0;
+
+    // The whole map is drawn on the next update
+    _mapImageTileChangeCounts.clear();
 }
 
 /**
@@ -1541,6 +1561,98 @@ static uint16_t map_window_get_pixel_colour_ride(const CoordsXY& c)
     return colourB;
 }
 
+static uint16_t map_window_get_pixel_colour(rct_window* w, const CoordsXY& c)
+{
+    switch (w->selected_tab)
+    {
+        case PAGE_PEEPS:
+            return map_window_get_pixel_colour_peep(c);
+        case PAGE_RIDES:
+            return map_window_get_pixel_colour_ride(c);
+    }
+    return 0;
+}
+
+/**
+ * Draws a single tile, which takes up two pixels next to each other on the map image. The lines map_window_set_pixels
+ * draws depend on the rotation, the position of each tile on them is worked out the same way.
+ */
+static void map_window_set_tile_pixel(rct_window* w, const TileCoordsXY& tile)
+{
+    constexpr int32_t last = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    int32_t line = 0, i = 0;
+    switch (get_current_rotation())
+    {
+        case 0:
+            line = tile.x;
+            i = tile.y;
+            break;
+        case 1:
+            line = tile.y;
+            i = last - tile.x;
+            break;
+        case 2:
+            line = last - tile.x;
+            i = last - tile.y;
+            break;
+        case 3:
+            line = last - tile.y;
+            i = tile.x;
+            break;
+    }
+
+    const int32_t pos = (line * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1 + (i * (MAP_WINDOW_MAP_SIZE + 1));
+    const uint16_t colour = map_window_get_pixel_colour(w, tile.ToCoordsXY());
+    _mapImageData[pos] = (colour >> 8) & 0xFF;
+    _mapImageData[pos + 1] = colour;
+}
+
+/**
+ * Redraws the tiles that have changed since they were last drawn, which are found by comparing the change count of
+ * each tile a row at a time.
+ */
+static void map_window_set_changed_tile_pixels(rct_window* w)
+{
+    const auto& changeCounts = map_get_tile_change_counts();
+    if (changeCounts.size() != MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    if (changeCounts.size() != _mapImageTileChangeCounts.size())
+    {
+        // Draw the whole map at once, in the order the tiles are stored
+        _mapImageTileChangeCounts = changeCounts;
+        for (int32_t y = 1; y < gMapSize - 1; y++)
+        {
+            for (int32_t x = 1; x < gMapSize - 1; x++)
+            {
+                map_window_set_tile_pixel(w, { x, y });
+            }
+        }
+        return;
+    }
+
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        const size_t rowStart = y * MAXIMUM_MAP_SIZE_TECHNICAL;
+        const auto* current = changeCounts.data() + rowStart;
+        auto* drawn = _mapImageTileChangeCounts.data() + rowStart;
+        if (std::memcmp(current, drawn, MAXIMUM_MAP_SIZE_TECHNICAL * sizeof(*current)) == 0)
+            continue;
+
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            if (current[x] == drawn[x])
+                continue;
+
+            drawn[x] = current[x];
+            if (x > 0 && y > 0 && x < gMapSize - 1 && y < gMapSize - 1)
+            {
+                map_window_set_tile_pixel(w, { x, y });
+            }
+        }
+    }
+}
+
 static void map_window_set_pixels(rct_window* w)
 {
     uint16_t colour = 0;
@@ -1581,15 +1693,7 @@ static void map_window_set_pixels(rct_window* w)
     {
         if (x > 0 && y > 0 && x < gMapSizeUnits && y < gMapSizeUnits)
         {
-            switch (w->selected_tab)
-            {
-                case PAGE_PEEPS:
-                    colour = map_window_get_pixel_colour_peep({ x, y });
-                    break;
-                case PAGE_RIDES:
-                    colour = map_window_get_pixel_colour_ride({ x, y });
-                    break;
-            }
+            colour = map_window_get_pixel_colour(w, { x, y });
             destination[0] = (colour >> 8) & 0xFF;
             destination[1] = colour;
         }
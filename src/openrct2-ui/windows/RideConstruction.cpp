@@ -470,6 +470,22 @@ static void ride_construction_tooldown_entrance_exit(const ScreenCoordsXY& scree
 
 static track_type_t _currentPossibleRideConfigurations[32];
 
+/**
+ * The last piece the tool could not find a height to place a ghost for. Searching for one runs a track place action for
+ * every height up to the ride's limit, it is only repeated once the cursor, the piece or the map has changed.
+ */
+struct FailedGhostPlacement
+{
+    bool IsValid{};
+    ride_id_t RideIndex{};
+    CoordsXYZ Begin;
+    int32_t TrackType{};
+    int32_t TrackDirection{};
+    int32_t LiftHillAndAlternativeState{};
+    uint32_t MapVersion{};
+};
+static FailedGhostPlacement _failedGhostPlacement;
+
 static constexpr const rct_string_id RideConstructionSeatAngleRotationStrings[] = {
     STR_RIDE_CONSTRUCTION_SEAT_ROTATION_ANGLE_NEG_180, STR_RIDE_CONSTRUCTION_SEAT_ROTATION_ANGLE_NEG_135,
     STR_RIDE_CONSTRUCTION_SEAT_ROTATION_ANGLE_NEG_90,  STR_RIDE_CONSTRUCTION_SEAT_ROTATION_ANGLE_NEG_45,
@@ -3491,6 +3507,21 @@ void ride_construction_toolupdate_construct(const ScreenCoordsXY& screenCoords)
         return;
     }
 
+    if (_failedGhostPlacement.IsValid && _failedGhostPlacement.RideIndex == rideIndex
+        && _failedGhostPlacement.Begin == _currentTrackBegin && _failedGhostPlacement.TrackType == trackType
+        && _failedGhostPlacement.TrackDirection == trackDirection
+        && _failedGhostPlacement.LiftHillAndAlternativeState == liftHillAndAlternativeState
+        && _failedGhostPlacement.MapVersion == map_get_version())
+    {
+        map_invalidate_map_selection_tiles();
+        return;
+    }
+
+    const FailedGhostPlacement ghostPlacement{
+        true, rideIndex, _currentTrackBegin, trackType, trackDirection, liftHillAndAlternativeState, 0,
+    };
+    _failedGhostPlacement.IsValid = false;
+
     _previousTrackPiece = _currentTrackBegin;
     // search for appropriate z value for ghost, up to max ride height
     int numAttempts = (z <= MAX_TRACK_HEIGHT ? ((MAX_TRACK_HEIGHT - z) / COORDS_Z_STEP + 1) : 2);
@@ -3514,6 +3545,11 @@ void ride_construction_toolupdate_construct(const ScreenCoordsXY& screenCoords)
 
             _currentTrackBegin.z += 16;
         }
+        if (_currentTrackPrice == MONEY32_UNDEFINED)
+        {
+            _failedGhostPlacement = ghostPlacement;
+            _failedGhostPlacement.MapVersion = map_get_version();
+        }
 
         auto intent = Intent(INTENT_ACTION_UPDATE_MAZE_CONSTRUCTION);
         context_broadcast_intent(&intent);
@@ -3539,6 +3575,11 @@ void ride_construction_toolupdate_construct(const ScreenCoordsXY& screenCoords)
 
         _currentTrackBegin.z += 16;
     }
+    if (_currentTrackPrice == MONEY32_UNDEFINED)
+    {
+        _failedGhostPlacement = ghostPlacement;
+        _failedGhostPlacement.MapVersion = map_get_version();
+    }
 
     if (_autoRotatingShop && _rideConstructionState == RIDE_CONSTRUCTION_STATE_PLACE
         && ride->GetRideTypeDescriptor().HasFlag(RIDE_TYPE_FLAG_IS_SHOP))
@@ -9,6 +9,7 @@
 
 #include "../interface/Theme.h"
 
+#include <algorithm>
 #include <iterator>
 #include <openrct2-ui/interface/Dropdown.h>
 #include <openrct2-ui/interface/Widget.h>
@@ -24,6 +25,8 @@
 #include <openrct2/util/Util.h>
 #include <openrct2/windows/Intent.h>
 #include <openrct2/world/Park.h>
+#include <string>
+#include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_NONE;
 static constexpr const int32_t WH = 240;
@@ -575,8 +578,11 @@ static void window_ride_list_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi,
     gfx_fill_rect(
         dpi, { dpiCoords, dpiCoords + ScreenCoordsXY{ dpi->width, dpi->height } }, ColourMapA[w->colours[1]].mid_light);
 
-    auto y = 0;
-    for (auto i = 0; i < w->no_list_items; i++)
+    // Only the rows that are visible need to be drawn
+    auto firstRow = std::max(0, dpi->y / SCROLLABLE_ROW_HEIGHT);
+    auto lastRow = std::min<int32_t>(w->no_list_items, (dpi->y + dpi->height) / SCROLLABLE_ROW_HEIGHT + 1);
+    auto y = firstRow * SCROLLABLE_ROW_HEIGHT;
+    for (auto i = firstRow; i < lastRow; i++)
     {
         rct_string_id format = (_quickDemolishMode ? STR_RED_STRINGID : STR_BLACK_STRING);
         if (i == w->selected_list_item)
@@ -781,230 +787,95 @@ static void window_ride_list_draw_tab_images(rct_drawpixelinfo* dpi, rct_window*
         dpi, ImageId(sprite_idx), w->windowPos + ScreenCoordsXY{ w->widgets[WIDX_TAB_3].left, w->widgets[WIDX_TAB_3].top });
 }
 
+static int64_t window_ride_list_get_sort_value(const Ride& ride, int32_t informationType)
+{
+    switch (informationType)
+    {
+        case INFORMATION_TYPE_POPULARITY:
+            return ride.popularity;
+        case INFORMATION_TYPE_SATISFACTION:
+            return ride.satisfaction;
+        case INFORMATION_TYPE_PROFIT:
+            return ride.profit;
+        case INFORMATION_TYPE_TOTAL_CUSTOMERS:
+            return ride.total_customers;
+        case INFORMATION_TYPE_TOTAL_PROFIT:
+            return ride.total_profit;
+        case INFORMATION_TYPE_CUSTOMERS:
+            return ride_customers_per_hour(&ride);
+        case INFORMATION_TYPE_AGE:
+            return ride.build_date;
+        case INFORMATION_TYPE_INCOME:
+            return ride.income_per_hour;
+        case INFORMATION_TYPE_RUNNING_COST:
+            return ride.upkeep_cost;
+        case INFORMATION_TYPE_QUEUE_LENGTH:
+            return ride.GetTotalQueueLength();
+        case INFORMATION_TYPE_QUEUE_TIME:
+            return ride.GetMaxQueueTime();
+        case INFORMATION_TYPE_RELIABILITY:
+            return ride.reliability_percentage;
+        case INFORMATION_TYPE_DOWN_TIME:
+            return ride.downtime;
+        case INFORMATION_TYPE_GUESTS_FAVOURITE:
+            return ride.guests_favourite;
+        default:
+            return 0;
+    }
+}
+
 /**
  *
  *  rct2: 0x006B39A8
  */
 void window_ride_list_refresh_list(rct_window* w)
 {
-    int32_t list_index = 0;
-    for (auto& ridec : GetRideManager())
+    struct RideListItem
     {
-        auto ride = &ridec;
-        if (ride->GetClassification() != static_cast<RideClassification>(w->page)
-            || (ride->status == RideStatus::Closed && !ride_has_any_track_elements(ride)))
+        ride_id_t Id;
+        int64_t Value;
+        std::string Name;
+    };
+
+    // The sort key of each ride is worked out once, instead of every time two rides are compared
+    std::vector<RideListItem> items;
+    for (auto& ride : GetRideManager())
+    {
+        if (ride.GetClassification() != static_cast<RideClassification>(w->page)
+            || (ride.status == RideStatus::Closed && !ride_has_any_track_elements(&ride)))
             continue;
 
-        if (ride->window_invalidate_flags & RIDE_INVALIDATE_RIDE_LIST)
+        if (ride.window_invalidate_flags & RIDE_INVALIDATE_RIDE_LIST)
         {
-            ride->window_invalidate_flags &= ~RIDE_INVALIDATE_RIDE_LIST;
+            ride.window_invalidate_flags &= ~RIDE_INVALIDATE_RIDE_LIST;
         }
 
-        w->list_item_positions[list_index] = ride->id;
-        int32_t current_list_position = list_index;
-        switch (w->list_information_type)
-        {
-            case INFORMATION_TYPE_STATUS:
-            {
-                auto strA = ride->GetName();
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        auto strB = otherRide->GetName();
-                        if (strlogicalcmp(strA.c_str(), strB.c_str()) >= 0)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            }
-            case INFORMATION_TYPE_POPULARITY:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->popularity * 4 <= otherRide->popularity * 4)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_SATISFACTION:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->satisfaction * 5 <= otherRide->satisfaction * 5)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_PROFIT:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->profit <= otherRide->profit)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_TOTAL_CUSTOMERS:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->total_customers <= otherRide->total_customers)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_TOTAL_PROFIT:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->total_profit <= otherRide->total_profit)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_CUSTOMERS:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride_customers_per_hour(ride) <= ride_customers_per_hour(otherRide))
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_AGE:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->build_date <= otherRide->build_date)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_INCOME:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->income_per_hour <= otherRide->income_per_hour)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_RUNNING_COST:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->upkeep_cost <= otherRide->upkeep_cost)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_QUEUE_LENGTH:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->GetTotalQueueLength() <= otherRide->GetTotalQueueLength())
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_QUEUE_TIME:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->GetMaxQueueTime() <= otherRide->GetMaxQueueTime())
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_RELIABILITY:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->reliability_percentage <= otherRide->reliability_percentage)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_DOWN_TIME:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->downtime <= otherRide->downtime)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_GUESTS_FAVOURITE:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->guests_favourite <= otherRide->guests_favourite)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-        }
+        auto& item = items.emplace_back();
+        item.Id = ride.id;
+        if (w->list_information_type == INFORMATION_TYPE_STATUS)
+            item.Name = ride.GetName();
+        else
+            item.Value = window_ride_list_get_sort_value(ride, w->list_information_type);
+    }
+
+    // Names are listed in ascending order, everything else with the highest value first. Rides that compare equal keep
+    // the order they have in the ride manager.
+    if (w->list_information_type == INFORMATION_TYPE_STATUS)
+    {
+        std::stable_sort(items.begin(), items.end(), [](const RideListItem& a, const RideListItem& b) {
+            return strlogicalcmp(a.Name.c_str(), b.Name.c_str()) < 0;
+        });
+    }
+    else
+    {
+        std::stable_sort(
+            items.begin(), items.end(), [](const RideListItem& a, const RideListItem& b) { return a.Value > b.Value; });
+    }
 
+    int32_t list_index = 0;
+    for (const auto& item : items)
+    {
+        w->list_item_positions[list_index] = static_cast<uint8_t>(item.Id);
         list_index++;
     }
 
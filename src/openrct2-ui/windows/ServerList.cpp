@@ -157,8 +157,8 @@ rct_window* window_server_list_open()
 
 static void window_server_list_close(rct_window* w)
 {
+    // Resetting an unfinished fetch would wait for it on the game thread, leave it to be picked up when reopening.
     _serverList = {};
-    _fetchFuture = {};
 }
 
 static void window_server_list_mouseup(rct_window* w, rct_widgetindex widgetIndex)
@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <algorithm>
 #include <limits>
 #include <openrct2-ui/interface/Dropdown.h>
 #include <openrct2-ui/interface/Viewport.h>
@@ -29,6 +30,7 @@
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Park.h>
 #include <openrct2/world/Sprite.h>
+#include <string>
 #include <vector>
 
 enum
@@ -91,7 +93,23 @@ private:
         rct_string_id ActionHire;
     };
 
+    struct StaffListEntry
+    {
+        uint16_t SpriteIndex{};
+        uint32_t Id{};
+        std::string Name;
+
+        bool operator==(const StaffListEntry& other) const
+        {
+            return SpriteIndex == other.SpriteIndex && Id == other.Id && Name == other.Name;
+        }
+    };
+
     std::vector<uint16_t> _staffList;
+    // The staff that _staffList was last sorted from, in entity list order, so the list is only sorted again when
+    // someone has been hired, fired or renamed.
+    std::vector<StaffListEntry> _staffListEntries;
+    bool _staffListRealNames{};
     bool _quickFireMode{};
     std::optional<size_t> _highlightedIndex{};
     int32_t _selectedTab{};
@@ -343,29 +361,24 @@ public:
     void OnScrollMouseDown(int32_t scrollIndex, const ScreenCoordsXY& screenCoords) override
     {
         int32_t i = screenCoords.y / SCROLLABLE_ROW_HEIGHT;
-        for (auto spriteIndex : _staffList)
+        if (i < 0 || static_cast<size_t>(i) >= _staffList.size())
+            return;
+
+        auto spriteIndex = _staffList[i];
+        if (_quickFireMode)
         {
-            if (i == 0)
+            auto staffFireAction = StaffFireAction(spriteIndex);
+            GameActions::Execute(&staffFireAction);
+        }
+        else
+        {
+            auto peep = GetEntity<Staff>(spriteIndex);
+            if (peep != nullptr)
             {
-                if (_quickFireMode)
-                {
-                    auto staffFireAction = StaffFireAction(spriteIndex);
-                    GameActions::Execute(&staffFireAction);
-                }
-                else
-                {
-                    auto peep = GetEntity<Staff>(spriteIndex);
-                    if (peep != nullptr)
-                    {
-                        auto intent = Intent(WC_PEEP);
-                        intent.putExtra(INTENT_EXTRA_PEEP, peep);
-                        context_open_intent(&intent);
-                    }
-                }
-                break;
+                auto intent = Intent(WC_PEEP);
+                intent.putExtra(INTENT_EXTRA_PEEP, peep);
+                context_open_intent(&intent);
             }
-
-            i--;
         }
     }
 
@@ -381,10 +394,12 @@ public:
         const int32_t actionColumnSize = nonIconSpace * 0.58;
         const int32_t actionOffset = widgets[WIDX_STAFF_LIST_LIST].right - actionColumnSize - 15;
 
-        auto y = 0;
-        size_t i = 0;
-        for (auto spriteIndex : _staffList)
+        // Start at the first row that is visible rather than stepping over all the rows above it
+        size_t i = std::max(0, dpi.y - 11) / SCROLLABLE_ROW_HEIGHT;
+        auto y = static_cast<int32_t>(i) * SCROLLABLE_ROW_HEIGHT;
+        for (; i < _staffList.size(); i++)
         {
+            auto spriteIndex = _staffList[i];
             if (y > dpi.y + dpi.height)
             {
                 break;
@@ -444,7 +459,6 @@ public:
             }
 
             y += SCROLLABLE_ROW_HEIGHT;
-            i++;
         }
     }
 
@@ -481,20 +495,25 @@ public:
 
     void RefreshList()
     {
-        _staffList.clear();
-
+        std::vector<StaffListEntry> entries;
+        entries.reserve(_staffListEntries.size());
         for (auto peep : EntityList<Staff>())
         {
             sprite_set_flashing(peep, false);
             if (peep->AssignedStaffType == GetSelectedStaffType())
             {
                 sprite_set_flashing(peep, true);
-                _staffList.push_back(peep->sprite_index);
+                entries.push_back({ peep->sprite_index, peep->Id, peep->Name != nullptr ? peep->Name : "" });
             }
         }
 
-        std::sort(
-            _staffList.begin(), _staffList.end(), [](const uint16_t a, const uint16_t b) { return peep_compare(a, b) < 0; });
+        bool realNames = (gParkFlags & PARK_FLAGS_SHOW_REAL_GUEST_NAMES) != 0;
+        if (entries == _staffListEntries && realNames == _staffListRealNames)
+            return;
+
+        _staffListEntries = std::move(entries);
+        _staffListRealNames = realNames;
+        SortList();
     }
 
 private:
@@ -503,6 +522,57 @@ private:
         return static_cast<StaffType>(_selectedTab);
     }
 
+    void SortList()
+    {
+        struct SortKey
+        {
+            uint16_t SpriteIndex;
+            uint32_t Id;
+            std::string Name;
+        };
+
+        // Default names are numbered by Id, so names only need to be compared once someone has been renamed. Each name
+        // is then formatted once, rather than on every comparison.
+        auto compareNames = _staffListRealNames
+            || std::any_of(_staffListEntries.begin(), _staffListEntries.end(), [](const StaffListEntry& entry) {
+                   return !entry.Name.empty();
+               });
+
+        std::vector<SortKey> keys;
+        keys.reserve(_staffListEntries.size());
+        for (const auto& entry : _staffListEntries)
+        {
+            auto& key = keys.emplace_back();
+            key.SpriteIndex = entry.SpriteIndex;
+            key.Id = entry.Id;
+            if (compareNames)
+            {
+                auto peep = GetEntity<Staff>(entry.SpriteIndex);
+                if (peep != nullptr)
+                {
+                    key.Name = peep->GetName();
+                }
+            }
+        }
+
+        if (compareNames)
+        {
+            std::sort(keys.begin(), keys.end(), [](const SortKey& a, const SortKey& b) {
+                return strlogicalcmp(a.Name.c_str(), b.Name.c_str()) < 0;
+            });
+        }
+        else
+        {
+            std::sort(keys.begin(), keys.end(), [](const SortKey& a, const SortKey& b) { return a.Id < b.Id; });
+        }
+
+        _staffList.clear();
+        for (const auto& key : keys)
+        {
+            _staffList.push_back(key.SpriteIndex);
+        }
+    }
+
     void DrawTabImages(rct_drawpixelinfo& dpi) const
     {
         DrawTabImage(dpi, WINDOW_STAFF_LIST_TAB_HANDYMEN, PeepSpriteType::Handyman, gStaffHandymanColour);
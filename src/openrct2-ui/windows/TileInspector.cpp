@@ -420,6 +420,8 @@ static bool windowTileInspectorToolCtrlDown = false;
 static CoordsXY windowTileInspectorToolMap = {};
 static bool windowTileInspectorApplyToAll = false;
 static bool windowTileInspectorElementCopied = false;
+// The version of the selected tile when its elements were last counted, see map_get_tile_version.
+static uint64_t windowTileInspectorTileVersion = 0;
 static TileElement tileInspectorCopiedElement;
 
 static void window_tile_inspector_mouseup(rct_window* w, rct_widgetindex widgetIndex);
@@ -571,10 +573,49 @@ static void window_tile_inspector_load_tile(rct_window* w, TileElement* elementT
     } while (!(element++)->IsLastForTile());
 
     windowTileInspectorElementCount = numItems;
+    windowTileInspectorTileVersion = map_get_tile_version(TileCoordsXY(windowTileInspectorToolMap));
 
     w->Invalidate();
 }
 
+/**
+ * Counts the elements of the selected tile again if anything may have changed them since they were last counted, e.g.
+ * when someone else builds on the tile. The selection is kept unless the element it points at no longer exists.
+ */
+static void window_tile_inspector_refresh_tile(rct_window* w)
+{
+    auto tileVersion = map_get_tile_version(TileCoordsXY(windowTileInspectorToolMap));
+    if (tileVersion == windowTileInspectorTileVersion)
+        return;
+
+    windowTileInspectorTileVersion = tileVersion;
+
+    const TileElement* element = map_get_first_element_at(windowTileInspectorToolMap);
+    int16_t numItems = 0;
+    do
+    {
+        if (element == nullptr)
+            break;
+
+        numItems++;
+    } while (!(element++)->IsLastForTile());
+
+    if (numItems != windowTileInspectorElementCount)
+    {
+        if (windowTileInspectorSelectedIndex >= numItems)
+        {
+            window_tile_inspector_load_tile(w, nullptr);
+            return;
+        }
+        windowTileInspectorElementCount = numItems;
+        w->Invalidate();
+    }
+    else
+    {
+        widget_invalidate(w, WIDX_LIST);
+    }
+}
+
 static void window_tile_inspector_insert_corrupt_element(int32_t elementIndex)
 {
     openrct2_assert(elementIndex >= 0 && elementIndex < windowTileInspectorElementCount, "elementIndex out of range");
@@ -1165,12 +1206,17 @@ static void window_tile_inspector_mousedown(rct_window* w, rct_widgetindex widge
 static void window_tile_inspector_update(rct_window* w)
 {
     // Check if the mouse is hovering over the list
-    if (!WidgetIsHighlighted(w, WIDX_LIST))
+    if (!WidgetIsHighlighted(w, WIDX_LIST) && windowTileInspectorHighlightedIndex != -1)
     {
         windowTileInspectorHighlightedIndex = -1;
         widget_invalidate(w, WIDX_LIST);
     }
 
+    if (windowTileInspectorTileSelected)
+    {
+        window_tile_inspector_refresh_tile(w);
+    }
+
     if (gCurrentToolWidget.window_classification != WC_TILE_INSPECTOR)
         window_close(w);
 }
@@ -1417,11 +1463,9 @@ static void window_tile_inspector_invalidate(rct_window* w)
     WidgetSetEnabled(
         w, WIDX_BUTTON_MOVE_UP,
         (windowTileInspectorSelectedIndex != -1 && windowTileInspectorSelectedIndex < windowTileInspectorElementCount - 1));
-    widget_invalidate(w, WIDX_BUTTON_MOVE_UP);
 
     // Move Down button
     WidgetSetEnabled(w, WIDX_BUTTON_MOVE_DOWN, (windowTileInspectorSelectedIndex > 0));
-    widget_invalidate(w, WIDX_BUTTON_MOVE_DOWN);
 
     // Copy button
     WidgetSetEnabled(w, WIDX_BUTTON_COPY, windowTileInspectorSelectedIndex >= 0);
@@ -2254,12 +2298,26 @@ static void window_tile_inspector_scrollpaint(rct_window* w, rct_drawpixelinfo*
     if (!windowTileInspectorTileSelected)
         return;
 
+    // The first element is listed at the bottom. Only the rows inside the clip area are drawn, the elements below it are
+    // stepped over without drawing them.
+    const int32_t lastVisibleIndex = windowTileInspectorElementCount - 1 - dpi->y / SCROLLABLE_ROW_HEIGHT;
+    const int32_t firstVisibleIndex = windowTileInspectorElementCount - 1 - (dpi->y + dpi->height) / SCROLLABLE_ROW_HEIGHT;
+
     const TileElement* tileElement = map_get_first_element_at(windowTileInspectorToolMap);
 
     do
     {
         if (tileElement == nullptr)
             break;
+        if (i > lastVisibleIndex)
+            break;
+        if (i < firstVisibleIndex)
+        {
+            screenCoords.y -= SCROLLABLE_ROW_HEIGHT;
+            i++;
+            continue;
+        }
+
         const bool selectedRow = i == windowTileInspectorSelectedIndex;
         const bool hoveredRow = i == windowTileInspectorHighlightedIndex;
         int32_t type = tileElement->GetType();
@@ -103,8 +103,16 @@ static money32 _window_track_place_last_cost;
 
 static std::unique_ptr<TrackDesign> _trackDesign;
 
+// The outline only depends on the design and its rotation, so it is worked out once relative to the cursor tile and moved
+// around with the cursor from then on.
+static std::vector<CoordsXY> _windowTrackPlaceOutline;
+static bool _windowTrackPlaceOutlineValid;
+static uint8_t _windowTrackPlaceOutlineDirection;
+static bool _windowTrackPlaceOutlineSceneryToggle;
+
 static void window_track_place_clear_provisional();
 static int32_t window_track_place_get_base_z(const CoordsXY& loc);
+static void window_track_place_draw_outlines(const CoordsXY& loc);
 
 static void window_track_place_clear_mini_preview();
 static void window_track_place_draw_mini_preview(TrackDesign* td6);
@@ -152,6 +160,7 @@ rct_window* window_track_place_open(const track_design_file_ref* tdFileRef)
     show_gridlines();
     _window_track_place_last_cost = MONEY32_UNDEFINED;
     _windowTrackPlaceLast.setNull();
+    _windowTrackPlaceOutlineValid = false;
     _currentTrackPieceDirection = (2 - get_current_rotation()) & 3;
 
     window_track_place_clear_mini_preview();
@@ -174,6 +183,9 @@ static void window_track_place_close(rct_window* w)
     hide_gridlines();
     _window_track_place_mini_preview.clear();
     _window_track_place_mini_preview.shrink_to_fit();
+    _windowTrackPlaceOutline.clear();
+    _windowTrackPlaceOutline.shrink_to_fit();
+    _windowTrackPlaceOutlineValid = false;
     _trackDesign = nullptr;
 }
 
@@ -200,6 +212,7 @@ static void window_track_place_mouseup(rct_window* w, rct_widgetindex widgetInde
             _currentTrackPieceDirection = (0 - _currentTrackPieceDirection) & 3;
             w->Invalidate();
             _windowTrackPlaceLast.setNull();
+            _windowTrackPlaceOutlineValid = false;
             window_track_place_draw_mini_preview(_trackDesign.get());
             break;
         case WIDX_SELECT_DIFFERENT_DESIGN:
@@ -267,7 +280,7 @@ static void window_track_place_toolupdate(rct_window* w, rct_widgetindex widgetI
     // Check if tool map position has changed since last update
     if (mapCoords == _windowTrackPlaceLast)
     {
-        place_virtual_track(_trackDesign.get(), PTD_OPERATION_DRAW_OUTLINES, true, GetOrAllocateRide(0), { mapCoords, 0 });
+        window_track_place_draw_outlines(mapCoords);
         return;
     }
 
@@ -307,7 +320,38 @@ static void window_track_place_toolupdate(rct_window* w, rct_widgetindex widgetI
         widget_invalidate(w, WIDX_PRICE);
     }
 
-    place_virtual_track(_trackDesign.get(), PTD_OPERATION_DRAW_OUTLINES, true, GetOrAllocateRide(0), trackLoc);
+    window_track_place_draw_outlines(trackLoc);
+}
+
+static void window_track_place_draw_outlines(const CoordsXY& loc)
+{
+    if (_windowTrackPlaceOutlineValid && _windowTrackPlaceOutlineDirection == _currentTrackPieceDirection
+        && _windowTrackPlaceOutlineSceneryToggle == gTrackDesignSceneryToggle)
+    {
+        gMapSelectionTiles.clear();
+        for (const auto& offset : _windowTrackPlaceOutline)
+        {
+            gMapSelectionTiles.push_back(loc + offset);
+        }
+        gMapSelectArrowPosition = CoordsXYZ{ loc, tile_element_height(loc) };
+        gMapSelectArrowDirection = _currentTrackPieceDirection;
+        gMapSelectFlags |= MAP_SELECT_FLAG_ENABLE_CONSTRUCT;
+        gMapSelectFlags |= MAP_SELECT_FLAG_ENABLE_ARROW;
+        gMapSelectFlags &= ~MAP_SELECT_FLAG_GREEN;
+        map_invalidate_map_selection_tiles();
+        return;
+    }
+
+    place_virtual_track(_trackDesign.get(), PTD_OPERATION_DRAW_OUTLINES, true, GetOrAllocateRide(0), { loc, 0 });
+
+    _windowTrackPlaceOutline.clear();
+    for (const auto& tile : gMapSelectionTiles)
+    {
+        _windowTrackPlaceOutline.push_back(tile - loc);
+    }
+    _windowTrackPlaceOutlineValid = true;
+    _windowTrackPlaceOutlineDirection = _currentTrackPieceDirection;
+    _windowTrackPlaceOutlineSceneryToggle = gTrackDesignSceneryToggle;
 }
 
 /**
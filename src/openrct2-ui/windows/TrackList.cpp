@@ -23,6 +23,7 @@
 #include <openrct2/ride/TrackDesignRepository.h>
 #include <openrct2/sprites.h>
 #include <openrct2/windows/Intent.h>
+#include <string>
 #include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_SELECT_DESIGN;
@@ -95,8 +96,22 @@ static utf8 _filterString[USER_STRING_MAX_LENGTH];
 static std::vector<uint16_t> _filteredTrackIds;
 static uint16_t _loadedTrackDesignIndex;
 static std::unique_ptr<TrackDesign> _loadedTrackDesign;
+static std::string _loadedTrackDesignPath;
+static bool _loadedTrackDesignSceneryToggle;
 static std::vector<uint8_t> _trackDesignPreviewPixels;
 
+struct TrackDesignPreview
+{
+    std::string Path;
+    bool SceneryToggle{};
+    std::unique_ptr<TrackDesign> Design;
+    std::vector<uint8_t> Pixels;
+};
+
+// Designs that were previewed recently, so moving back and forth over the list does not load and draw them again.
+static constexpr size_t MAX_CACHED_PREVIEWS = 8;
+static std::vector<TrackDesignPreview> _cachedTrackDesignPreviews;
+
 static void track_list_load_designs(RideSelection item);
 static bool track_list_load_design_for_preview(utf8* path);
 
@@ -150,6 +165,7 @@ rct_window* window_track_list_open(RideSelection item)
 
     _loadedTrackDesign = nullptr;
     _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
+    _cachedTrackDesignPreviews.clear();
 
     return w;
 }
@@ -198,6 +214,8 @@ static void window_track_list_close(rct_window* w)
     _loadedTrackDesign = nullptr;
     _trackDesignPreviewPixels.clear();
     _trackDesignPreviewPixels.shrink_to_fit();
+    _cachedTrackDesignPreviews.clear();
+    _cachedTrackDesignPreviews.shrink_to_fit();
 
     // Dispose track list
     for (auto& trackDesign : _trackDesigns)
@@ -797,6 +815,34 @@ static void track_list_load_designs(RideSelection item)
 
 static bool track_list_load_design_for_preview(utf8* path)
 {
+    if (_loadedTrackDesign != nullptr)
+    {
+        if (_cachedTrackDesignPreviews.size() >= MAX_CACHED_PREVIEWS)
+        {
+            _cachedTrackDesignPreviews.erase(_cachedTrackDesignPreviews.begin());
+        }
+        _cachedTrackDesignPreviews.push_back(
+            { std::move(_loadedTrackDesignPath), _loadedTrackDesignSceneryToggle, std::move(_loadedTrackDesign),
+              std::move(_trackDesignPreviewPixels) });
+    }
+
+    _loadedTrackDesignPath = path;
+    _loadedTrackDesignSceneryToggle = gTrackDesignSceneryToggle;
+    _trackDesignPreviewPixels.resize(4 * TRACK_PREVIEW_IMAGE_SIZE);
+
+    // The preview depends on whether scenery is shown, so only reuse one drawn with the same setting
+    auto it = std::find_if(
+        _cachedTrackDesignPreviews.begin(), _cachedTrackDesignPreviews.end(), [path](const TrackDesignPreview& preview) {
+            return preview.SceneryToggle == gTrackDesignSceneryToggle && preview.Path == path;
+        });
+    if (it != _cachedTrackDesignPreviews.end())
+    {
+        _loadedTrackDesign = std::move(it->Design);
+        _trackDesignPreviewPixels = std::move(it->Pixels);
+        _cachedTrackDesignPreviews.erase(it);
+        return true;
+    }
+
     _loadedTrackDesign = track_design_open(path);
     if (_loadedTrackDesign != nullptr)
     {
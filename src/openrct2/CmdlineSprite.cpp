@@ -14,6 +14,7 @@
 #include "core/FileStream.h"
 #include "core/Imaging.h"
 #include "core/Json.hpp"
+#include "core/TaskScheduler.h"
 #include "drawing/Drawing.h"
 #include "drawing/ImageImporter.h"
 #include "object/ObjectLimits.h"
@@ -25,6 +26,8 @@
 #include <cmath>
 #include <cstring>
 #include <optional>
+#include <string>
+#include <vector>
 
 #ifdef _WIN32
 #    include "core/String.hpp"
@@ -174,6 +177,7 @@ bool SpriteFile::Save(const utf8* path)
             }
             stream.Write(Data.data(), Header.total_size);
         }
+        stream.Flush();
         return true;
     }
     catch (IOException&)
@@ -597,7 +601,17 @@ int32_t cmdline_for_sprite(const char** argv, int32_t argc)
 
         fprintf(stdout, "Building: %s\n", spriteFilePath);
 
-        json_t sprite_description;
+        // Read the whole description first, so the images can be imported in parallel and then added in order
+        struct SpriteBuildEntry
+        {
+            std::string ImagePath;
+            int16_t XOffset{};
+            int16_t YOffset{};
+            bool KeepPalette{};
+            bool ForceBmp{};
+            std::optional<ImageImporter::ImportResult> Result;
+        };
+        std::vector<SpriteBuildEntry> entries;
 
         // Note: jsonSprite is deliberately left non-const: json_t behaviour changes when const
         for (auto& [jsonKey, jsonSprite] : jsonSprites.items())
@@ -619,24 +633,43 @@ int32_t cmdline_for_sprite(const char** argv, int32_t argc)
             json_t x_offset = jsonSprite["x_offset"];
             json_t y_offset = jsonSprite["y_offset"];
 
-            bool keep_palette = Json::GetString(jsonSprite["palette"]) == "keep";
-            bool forceBmp = !jsonSprite["palette"].is_null() && Json::GetBoolean(jsonSprite["forceBmp"]);
+            auto& entry = entries.emplace_back();
+            entry.ImagePath = platform_get_absolute_path(strPath.c_str(), directoryPath);
+            entry.XOffset = Json::GetNumber<int16_t>(x_offset);
+            entry.YOffset = Json::GetNumber<int16_t>(y_offset);
+            entry.KeepPalette = Json::GetString(jsonSprite["palette"]) == "keep";
+            entry.ForceBmp = !jsonSprite["palette"].is_null() && Json::GetBoolean(jsonSprite["forceBmp"]);
+        }
 
-            auto imagePath = platform_get_absolute_path(strPath.c_str(), directoryPath);
+        // Each image is imported on its own task, the results are kept per entry so the file does not depend on the
+        // order the tasks finish in.
+        {
+            OpenRCT2::TaskScheduler scheduler;
+            OpenRCT2::TaskGroup tasks(scheduler);
+            for (auto& entry : entries)
+            {
+                auto* pendingEntry = &entry;
+                tasks.Run([pendingEntry]() {
+                    pendingEntry->Result = SpriteImageImport(
+                        pendingEntry->ImagePath.c_str(), pendingEntry->XOffset, pendingEntry->YOffset,
+                        pendingEntry->KeepPalette, pendingEntry->ForceBmp, gSpriteMode);
+                });
+            }
+            tasks.Wait();
+        }
 
-            auto importResult = SpriteImageImport(
-                imagePath.c_str(), Json::GetNumber<int16_t>(x_offset), Json::GetNumber<int16_t>(y_offset), keep_palette,
-                forceBmp, gSpriteMode);
-            if (importResult == std::nullopt)
+        for (auto& entry : entries)
+        {
+            if (entry.Result == std::nullopt)
             {
-                fprintf(stderr, "Could not import image file: %s\nCanceling\n", imagePath.c_str());
+                fprintf(stderr, "Could not import image file: %s\nCanceling\n", entry.ImagePath.c_str());
                 return -1;
             }
 
-            spriteFile.AddImage(importResult.value());
+            spriteFile.AddImage(entry.Result.value());
 
             if (!silent)
-                fprintf(stdout, "Added: %s\n", imagePath.c_str());
+                fprintf(stdout, "Added: %s\n", entry.ImagePath.c_str());
         }
 
         if (!spriteFile.Save(spriteFilePath))
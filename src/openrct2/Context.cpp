@@ -14,6 +14,8 @@
 #include "Context.h"
 #include "Editor.h"
 #include "FileClassifier.h"
+#include "FramePacer.h"
+#include "FrameProfiler.h"
 #include "Game.h"
 #include "GameState.h"
 #include "GameStateSnapshots.h"
@@ -23,6 +25,7 @@
 #include "ParkImporter.h"
 #include "PlatformEnvironment.h"
 #include "ReplayManager.h"
+#include "StartupProfiler.h"
 #include "Version.h"
 #include "actions/GameAction.h"
 #include "audio/AudioContext.h"
@@ -37,6 +40,7 @@
 #include "core/MemoryStream.h"
 #include "core/Path.hpp"
 #include "core/String.hpp"
+#include "core/TaskScheduler.h"
 #include "drawing/IDrawingEngine.h"
 #include "drawing/LightFX.h"
 #include "interface/Chat.h"
@@ -94,6 +98,7 @@ namespace OpenRCT2
         std::shared_ptr<IUiContext> const _uiContext;
 
         // Services
+        std::unique_ptr<TaskScheduler> _taskScheduler;
         std::unique_ptr<LocalisationService> _localisationService;
         std::unique_ptr<IObjectRepository> _objectRepository;
         std::unique_ptr<IObjectManager> _objectManager;
@@ -119,7 +124,8 @@ namespace OpenRCT2
 
         bool _initialised = false;
         bool _isWindowMinimised = false;
-        uint32_t _lastTick = 0;
+        FramePacer _framePacer;
+        FramePacer::Clock::time_point _lastTick{};
         float _accumulator = 0.0f;
         float _timeScale = 1.0f;
         uint32_t _lastUpdateTime = 0;
@@ -129,6 +135,8 @@ namespace OpenRCT2
         // false.
         bool _finished = false;
 
+        std::future<void> _repositoryScanFuture;
+        StartupProfiler _startupProfiler;
         std::future<void> _versionCheckFuture;
         NewVersionInfo _newVersionInfo;
         bool _hasNewVersionInfo = false;
@@ -146,6 +154,7 @@ namespace OpenRCT2
             : _env(env)
             , _audioContext(audioContext)
             , _uiContext(uiContext)
+            , _taskScheduler(std::make_unique<TaskScheduler>())
             , _localisationService(std::make_unique<LocalisationService>(env))
 #ifdef ENABLE_SCRIPTING
             , _scriptEngine(_stdInOutConsole, *env)
@@ -163,6 +172,7 @@ namespace OpenRCT2
             // NOTE: We must shutdown all systems here before Instance is set back to null.
             //       If objects use GetContext() in their destructor things won't go well.
 
+            WaitForRepositoryScan();
             GameActions::ClearQueue();
             network_close();
             window_close_all();
@@ -228,11 +238,13 @@ namespace OpenRCT2
 
         ITrackDesignRepository* GetTrackDesignRepository() override
         {
+            WaitForRepositoryScan();
             return _trackDesignRepository.get();
         }
 
         IScenarioRepository* GetScenarioRepository() override
         {
+            WaitForRepositoryScan();
             return _scenarioRepository.get();
         }
 
@@ -261,6 +273,11 @@ namespace OpenRCT2
             return _painter.get();
         }
 
+        TaskScheduler& GetTaskScheduler() override
+        {
+            return *_taskScheduler;
+        }
+
         int32_t RunOpenRCT2(int argc, const char** argv) override
         {
             if (Initialise())
@@ -346,6 +363,7 @@ namespace OpenRCT2
                 throw std::runtime_error("Context already initialised.");
             }
             _initialised = true;
+            _startupProfiler.Begin(gOpenRCT2StartupProfile);
 
             crash_init();
 
@@ -359,6 +377,7 @@ namespace OpenRCT2
                 gConfigGeneral.last_run_version = String::Duplicate(OPENRCT2_VERSION);
                 config_save_default();
             }
+            _startupProfiler.EndPhase("Crash reporting and config");
 
             try
             {
@@ -379,6 +398,7 @@ namespace OpenRCT2
                     return false;
                 }
             }
+            _startupProfiler.EndPhase("Language pack");
 
             // TODO add configuration option to allow multiple instances
             // if (!gOpenRCT2Headless && !platform_lock_single_instance()) {
@@ -439,21 +459,22 @@ namespace OpenRCT2
             {
                 _uiContext->CreateWindow();
             }
+            _startupProfiler.EndPhase("Services and window");
 
             EnsureUserContentDirectoriesExist();
 
+            // Track designs and scenarios are not needed until the player asks for them, so they are scanned in the
+            // background while the objects are loaded and the title screen starts.
+            BeginRepositoryScan();
+
             // TODO Ideally we want to delay this until we show the title so that we can
             //      still open the game window and draw a progress screen for the creation
             //      of the object cache.
             _objectRepository->LoadOrConstruct(_localisationService->GetCurrentLanguage());
+            _startupProfiler.EndPhase("Object index");
 
-            // TODO Like objects, this can take a while if there are a lot of track designs
-            //      its also really something really we might want to do in the background
-            //      as its not required until the player wants to place a new ride.
-            _trackDesignRepository->Scan(_localisationService->GetCurrentLanguage());
-
-            _scenarioRepository->Scan(_localisationService->GetCurrentLanguage());
             TitleSequenceManager::Scan();
+            _startupProfiler.EndPhase("Title sequences");
 
             if (!gOpenRCT2Headless)
             {
@@ -462,10 +483,12 @@ namespace OpenRCT2
                 InitRideSoundsAndInfo();
                 gGameSoundsOff = !gConfigSound.master_sound_enabled;
             }
+            _startupProfiler.EndPhase("Audio");
 
             network_set_env(_env);
             chat_init();
             CopyOriginalUserFilesOver();
+            _startupProfiler.EndPhase("User files");
 
             if (!gOpenRCT2NoGraphics)
             {
@@ -477,6 +500,7 @@ namespace OpenRCT2
                 lightfx_init();
 #endif
             }
+            _startupProfiler.EndPhase("Base graphics");
 
             gScenarioTicks = 0;
             input_reset_place_obj_modifier();
@@ -487,7 +511,15 @@ namespace OpenRCT2
 
             _titleScreen = std::make_unique<TitleScreen>(*_gameState);
             _uiContext->Initialise();
+            _startupProfiler.EndPhase("Game state and UI");
 
+            if (gOpenRCT2StartupProfile)
+            {
+                // The scan finishes in the background otherwise, wait for it so that it is part of the report.
+                WaitForRepositoryScan();
+                _startupProfiler.EndPhase("Track design and scenario index");
+                _startupProfiler.Report();
+            }
             return true;
         }
 
@@ -959,7 +991,7 @@ namespace OpenRCT2
             bool useVariableFrame = ShouldRunVariableFrame();
             if (_variableFrame != useVariableFrame)
             {
-                _lastTick = 0;
+                _lastTick = {};
                 _variableFrame = useVariableFrame;
 
                 // Switching from variable to fixed frame requires reseting
@@ -979,24 +1011,31 @@ namespace OpenRCT2
             }
         }
 
-        void RunFixedFrame()
+        float GetElapsedMilliseconds(FramePacer::Clock::time_point currentTick)
         {
-            uint32_t currentTick = platform_get_ticks();
-
-            if (_lastTick == 0)
+            if (_lastTick == FramePacer::Clock::time_point{})
             {
                 _lastTick = currentTick;
             }
 
-            float elapsed = (currentTick - _lastTick) * _timeScale;
+            float elapsed = std::chrono::duration<float, std::milli>(currentTick - _lastTick).count() * _timeScale;
             _lastTick = currentTick;
+            return elapsed;
+        }
+
+        void RunFixedFrame()
+        {
+            auto currentTick = FramePacer::Clock::now();
+
+            float elapsed = GetElapsedMilliseconds(currentTick);
             _accumulator = std::min(_accumulator + elapsed, static_cast<float>(GAME_UPDATE_MAX_THRESHOLD));
 
             _uiContext->ProcessMessages();
 
             if (_accumulator < GAME_UPDATE_TIME_MS)
             {
-                platform_sleep(GAME_UPDATE_TIME_MS - _accumulator - 1);
+                auto remaining = std::chrono::duration<float, std::milli>((GAME_UPDATE_TIME_MS - _accumulator) / _timeScale);
+                FramePacer::SleepUntil(currentTick + std::chrono::duration_cast<FramePacer::Clock::duration>(remaining));
                 return;
             }
 
@@ -1012,28 +1051,30 @@ namespace OpenRCT2
 
             if (!_isWindowMinimised && !gOpenRCT2Headless)
             {
+                auto& profiler = FrameProfiler::Get();
+                profiler.BeginFrame();
                 _drawingEngine->BeginDraw();
                 _painter->Paint(*_drawingEngine);
                 _drawingEngine->EndDraw();
+                profiler.EndFrame();
             }
         }
 
         void RunVariableFrame()
         {
-            uint32_t currentTick = platform_get_ticks();
+            // Input is read as late as the frame rate limit allows, so it is as recent as possible once presented.
+            _framePacer.BeginFrame(gConfigGeneral.frame_rate_limit);
+            auto currentTick = FramePacer::Clock::now();
 
             auto& tweener = EntityTweener::Get();
 
             bool draw = !_isWindowMinimised && !gOpenRCT2Headless;
-            if (_lastTick == 0)
+            if (_lastTick == FramePacer::Clock::time_point{})
             {
                 tweener.Reset();
-                _lastTick = currentTick;
             }
 
-            float elapsed = (currentTick - _lastTick) * _timeScale;
-
-            _lastTick = currentTick;
+            float elapsed = GetElapsedMilliseconds(currentTick);
             _accumulator = std::min(_accumulator + elapsed, static_cast<float>(GAME_UPDATE_MAX_THRESHOLD));
 
             _uiContext->ProcessMessages();
@@ -1061,9 +1102,18 @@ namespace OpenRCT2
                 const float alpha = std::min(_accumulator / static_cast<float>(GAME_UPDATE_TIME_MS), 1.0f);
                 tweener.Tween(alpha);
 
+                auto& profiler = FrameProfiler::Get();
+                profiler.BeginFrame();
                 _drawingEngine->BeginDraw();
                 _painter->Paint(*_drawingEngine);
                 _drawingEngine->EndDraw();
+                _framePacer.EndFrame();
+                profiler.RecordPresentLatency(_framePacer.GetLastPresentLatency());
+                profiler.EndFrame();
+            }
+            else
+            {
+                _framePacer.EndFrame();
             }
         }
 
@@ -1141,6 +1191,34 @@ namespace OpenRCT2
             }
         }
 
+        /**
+         * Scans the track designs and scenarios on another thread. Neither repository is handed out until the scan has
+         * finished, so nothing may ask the context for them while scanning.
+         */
+        void BeginRepositoryScan()
+        {
+            auto language = _localisationService->GetCurrentLanguage();
+            _repositoryScanFuture = std::async(std::launch::async, [this, language] {
+                try
+                {
+                    _trackDesignRepository->Scan(language);
+                    _scenarioRepository->Scan(language);
+                }
+                catch (const std::exception& e)
+                {
+                    log_error("Unable to scan track designs and scenarios: %s", e.what());
+                }
+            });
+        }
+
+        void WaitForRepositoryScan()
+        {
+            if (_repositoryScanFuture.valid())
+            {
+                _repositoryScanFuture.get();
+            }
+        }
+
         /**
          * Copy saved games and landscapes to user directory
          */
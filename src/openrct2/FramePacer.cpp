@@ -0,0 +1,76 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace OpenRCT2;
+
+// Sleeping can wake up late by about a millisecond, so the end of a wait is spent spinning instead.
+static constexpr auto SPIN_TIME = std::chrono::milliseconds(2);
+
+// How much each frame changes the predicted frame time, and how much more time than predicted a frame is given so a
+// slightly slower frame is still presented on time.
+static constexpr double FRAME_TIME_SMOOTHING = 0.1;
+static constexpr double FRAME_TIME_MARGIN = 1.25;
+
+void FramePacer::BeginFrame(int32_t frameRateLimit)
+{
+    if (frameRateLimit <= 0)
+    {
+        _period = Clock::duration::zero();
+        _frameStart = Clock::now();
+        return;
+    }
+
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frameRateLimit));
+    const auto predictedFrameTime = std::min(
+        std::chrono::duration_cast<Clock::duration>(_predictedFrameTime * FRAME_TIME_MARGIN), period);
+    if (period != _period)
+    {
+        // The first frame at a new limit is started straight away.
+        _period = period;
+        _nextPresent = Clock::now() + predictedFrameTime;
+    }
+
+    SleepUntil(_nextPresent - predictedFrameTime);
+    _frameStart = Clock::now();
+}
+
+void FramePacer::EndFrame()
+{
+    const auto now = Clock::now();
+    _lastPresentLatency = now - _frameStart;
+    _predictedFrameTime += (std::chrono::duration<double>(_lastPresentLatency) - _predictedFrameTime) * FRAME_TIME_SMOOTHING;
+
+    if (_period != Clock::duration::zero())
+    {
+        // A frame that missed its time pushes the ones after it back, rather than having them try to catch up.
+        _nextPresent += _period;
+        if (_nextPresent < now)
+        {
+            _nextPresent = now + _period;
+        }
+    }
+}
+
+void FramePacer::SleepUntil(Clock::time_point time)
+{
+    const auto sleepTime = time - Clock::now() - SPIN_TIME;
+    if (sleepTime > Clock::duration::zero())
+    {
+        std::this_thread::sleep_for(sleepTime);
+    }
+    while (Clock::now() < time)
+    {
+        std::this_thread::yield();
+    }
+}
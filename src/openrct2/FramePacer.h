@@ -0,0 +1,61 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+#include <chrono>
+
+namespace OpenRCT2
+{
+    /**
+     * Schedules frames when the frame rate is limited. Rather than drawing a frame straight away and then waiting for the
+     * rest of the frame time, each frame is started as late as the time the recent frames took allows, so the input it
+     * reads is as recent as possible when it is presented. The waiting sleeps for most of the time and only spins for the
+     * last moment, as sleeping alone is not precise enough on most platforms.
+     */
+    class FramePacer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        Clock::duration _period{};
+        Clock::time_point _nextPresent{};
+        Clock::time_point _frameStart{};
+        std::chrono::duration<double> _predictedFrameTime{};
+        Clock::duration _lastPresentLatency{};
+
+    public:
+        /**
+         * Waits until the next frame should be started to be presented on time at the given frame rate, or returns
+         * straight away if the frame rate is not limited.
+         */
+        void BeginFrame(int32_t frameRateLimit);
+
+        /**
+         * Must be called once the frame has been presented.
+         */
+        void EndFrame();
+
+        /**
+         * Gets the time from the start of the last frame, when its input was read, until it was presented.
+         */
+        Clock::duration GetLastPresentLatency() const
+        {
+            return _lastPresentLatency;
+        }
+
+        /**
+         * Sleeps until the given time, more precisely than the operating system sleeps on its own.
+         */
+        static void SleepUntil(Clock::time_point time);
+    };
+} // namespace OpenRCT2
@@ -0,0 +1,425 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FrameProfiler.h"
+
+#include "Game.h"
+#include "core/Json.hpp"
+#include "drawing/TTF.h"
+#include "util/Util.h"
+
+#include <algorithm>
+
+using namespace OpenRCT2;
+
+static constexpr const char* LogicTimePartNames[] = {
+    "NetworkUpdate",
+    "Date",
+    "Scenario",
+    "Climate",
+    "MapTiles",
+    "MapStashProvisionalElements",
+    "MapPathWideFlags",
+    "Peep",
+    "MapRestoreProvisionalElements",
+    "Vehicle",
+    "Misc",
+    "Ride",
+    "Park",
+    "Research",
+    "RideRatings",
+    "RideMeasurments",
+    "News",
+    "MapAnimation",
+    "Sounds",
+    "GameActions",
+    "NetworkFlush",
+    "Scripts",
+};
+static_assert(std::size(LogicTimePartNames) == static_cast<size_t>(LogicTimePart::Count));
+
+static constexpr const char* PaintTimePartNames[] = {
+    "Generate",
+    "Arrange",
+    "Draw",
+};
+static_assert(std::size(PaintTimePartNames) == static_cast<size_t>(PaintTimePart::Count));
+
+static constexpr const char* GpuTimePartNames[] = {
+    "Lines",
+    "Rectangles",
+    "Transparency",
+    "Palette",
+};
+static_assert(std::size(GpuTimePartNames) == static_cast<size_t>(GpuTimePart::Count));
+
+static FrameProfiler _frameProfiler;
+
+FrameProfiler::FrameProfiler()
+{
+    // Create every entry up front, so that UpdateLogic never allocates.
+    for (size_t i = 0; i < static_cast<size_t>(LogicTimePart::Count); i++)
+    {
+        _logicTimings.TimingInfo[static_cast<LogicTimePart>(i)].fill(ProfilerDuration::zero());
+    }
+}
+
+FrameProfiler& FrameProfiler::Get()
+{
+    return _frameProfiler;
+}
+
+void FrameProfiler::SetEnabled(bool value)
+{
+    if (_enabled != value)
+    {
+        _enabled = value;
+        _inFrame = false;
+    }
+}
+
+void FrameProfiler::Clear()
+{
+    for (auto& part : _logicTimings.TimingInfo)
+    {
+        part.second.fill(ProfilerDuration::zero());
+    }
+    _logicTimings.CurrentIdx = 0;
+    _numTicks = 0;
+    _frameIdx = 0;
+    _numFrames = 0;
+    _inFrame = false;
+    _numPendingWindowClasses = 0;
+    _textureStats.reset();
+}
+
+LogicTimings* FrameProfiler::BeginTick()
+{
+    if (!_enabled)
+        return nullptr;
+
+    // UpdateLogic may return before reaching every part, so clear the previous contents of the slot.
+    _pendingTickIdx = _logicTimings.CurrentIdx;
+    for (auto& part : _logicTimings.TimingInfo)
+    {
+        part.second[_pendingTickIdx] = ProfilerDuration::zero();
+    }
+    _tickStart[_pendingTickIdx] = ProfilerClock::now();
+    _tickNumber[_pendingTickIdx] = gCurrentTicks;
+    return &_logicTimings;
+}
+
+void FrameProfiler::EndTick()
+{
+    // The tick only counts if UpdateLogic got to the end of it and moved on to the next slot.
+    if (_enabled && _logicTimings.CurrentIdx != _pendingTickIdx)
+    {
+        _numTicks = std::min(_numTicks + 1, LOGIC_UPDATE_MEASUREMENTS_COUNT);
+    }
+}
+
+void FrameProfiler::BeginFrame()
+{
+    if (!_enabled)
+        return;
+
+    auto& frame = _frames[_frameIdx];
+    frame.Start = ProfilerClock::now();
+    frame.Duration = ProfilerDuration::zero();
+    frame.NumViewports = 0;
+    frame.PresentLatency = ProfilerDuration::zero();
+    frame.Gpu = {};
+    auto textCacheStats = ttf_get_cache_stats();
+    _frameTextCacheHits = textCacheStats.Hits;
+    _frameTextCacheMisses = textCacheStats.Misses;
+    _inFrame = true;
+}
+
+void FrameProfiler::EndFrame()
+{
+    if (!_inFrame)
+        return;
+
+    auto& frame = _frames[_frameIdx];
+    frame.Duration = ProfilerClock::now() - frame.Start;
+    auto textCacheStats = ttf_get_cache_stats();
+    frame.TextCacheHits = textCacheStats.Hits - _frameTextCacheHits;
+    frame.TextCacheMisses = textCacheStats.Misses - _frameTextCacheMisses;
+    frame.NumWindowClasses = _numPendingWindowClasses;
+    frame.WindowClasses = _pendingWindowClasses;
+    _numPendingWindowClasses = 0;
+    _frameIdx = (_frameIdx + 1) % PROFILER_FRAME_COUNT;
+    _numFrames = std::min(_numFrames + 1, PROFILER_FRAME_COUNT);
+    _inFrame = false;
+}
+
+void FrameProfiler::RecordTextureStats(const ProfilerTextureStats& stats)
+{
+    if (!_enabled)
+        return;
+
+    _textureStats = stats;
+}
+
+void FrameProfiler::RecordPresentLatency(ProfilerDuration latency)
+{
+    if (!_inFrame)
+        return;
+
+    _frames[_frameIdx].PresentLatency = latency;
+}
+
+void FrameProfiler::RecordGpuSample(const ProfilerGpuSample& sample)
+{
+    if (!_inFrame)
+        return;
+
+    _frames[_frameIdx].Gpu = sample;
+}
+
+void FrameProfiler::RecordViewportPaint(
+    const rct_viewport* viewport, size_t numColumns, ProfilerDuration generate, ProfilerDuration arrange,
+    ProfilerDuration draw)
+{
+    // Paints outside of a frame, e.g. for screenshots, are not part of the frame time.
+    if (!_inFrame)
+        return;
+
+    // A viewport is usually painted several times per frame, once for each dirty area it covers.
+    auto& frame = _frames[_frameIdx];
+    auto begin = frame.Viewports.begin();
+    auto end = begin + frame.NumViewports;
+    auto it = std::find_if(begin, end, [viewport](const ProfilerViewportSample& s) { return s.Viewport == viewport; });
+    if (it == end)
+    {
+        if (frame.NumViewports == PROFILER_MAX_VIEWPORTS)
+            return;
+
+        *it = {};
+        it->Viewport = viewport;
+        frame.NumViewports++;
+    }
+
+    it->NumColumns += static_cast<uint32_t>(numColumns);
+    it->Parts[EnumValue(PaintTimePart::Generate)] += generate;
+    it->Parts[EnumValue(PaintTimePart::Arrange)] += arrange;
+    it->Parts[EnumValue(PaintTimePart::Draw)] += draw;
+}
+
+ProfilerWindowSample* FrameProfiler::GetPendingWindowSample(uint8_t windowClass)
+{
+    auto begin = _pendingWindowClasses.begin();
+    auto end = begin + _numPendingWindowClasses;
+    auto it = std::find_if(begin, end, [windowClass](const ProfilerWindowSample& s) { return s.WindowClass == windowClass; });
+    if (it == end)
+    {
+        if (_numPendingWindowClasses == PROFILER_MAX_WINDOW_CLASSES)
+            return nullptr;
+
+        *it = {};
+        it->WindowClass = windowClass;
+        _numPendingWindowClasses++;
+    }
+    return &*it;
+}
+
+void FrameProfiler::RecordWindowDraw(uint8_t windowClass, ProfilerDuration duration)
+{
+    if (!_inFrame)
+        return;
+
+    auto sample = GetPendingWindowSample(windowClass);
+    if (sample != nullptr)
+    {
+        sample->NumDraws++;
+        sample->DrawDuration += duration;
+    }
+}
+
+void FrameProfiler::RecordWindowInvalidate(uint8_t windowClass, uint64_t numPixels)
+{
+    if (!_enabled)
+        return;
+
+    auto sample = GetPendingWindowSample(windowClass);
+    if (sample != nullptr)
+    {
+        sample->NumInvalidations++;
+        sample->InvalidatedPixels += numPixels;
+    }
+}
+
+size_t FrameProfiler::GetTickIdx(size_t age) const
+{
+    return (_logicTimings.CurrentIdx + LOGIC_UPDATE_MEASUREMENTS_COUNT - 1 - age) % LOGIC_UPDATE_MEASUREMENTS_COUNT;
+}
+
+ProfilerDuration FrameProfiler::GetTickPartEnd(size_t idx, LogicTimePart part) const
+{
+    return _logicTimings.TimingInfo.at(part)[idx];
+}
+
+ProfilerDuration FrameProfiler::GetTickPartStart(size_t idx, LogicTimePart part) const
+{
+    // Parts are reported in the order they are declared, a part starts when the last part before it has finished.
+    auto start = ProfilerDuration::zero();
+    for (size_t i = 0; i < static_cast<size_t>(part); i++)
+    {
+        start = std::max(start, GetTickPartEnd(idx, static_cast<LogicTimePart>(i)));
+    }
+    return start;
+}
+
+ProfilerDuration FrameProfiler::GetTickPartDuration(size_t age, LogicTimePart part) const
+{
+    const auto idx = GetTickIdx(age);
+    const auto end = GetTickPartEnd(idx, part);
+    if (end == ProfilerDuration::zero())
+        return end;
+
+    return std::max(ProfilerDuration::zero(), end - GetTickPartStart(idx, part));
+}
+
+ProfilerDuration FrameProfiler::GetTickDuration(size_t age) const
+{
+    const auto idx = GetTickIdx(age);
+    auto duration = ProfilerDuration::zero();
+    for (const auto& part : _logicTimings.TimingInfo)
+    {
+        duration = std::max(duration, part.second[idx]);
+    }
+    return duration;
+}
+
+const ProfilerFrameSample& FrameProfiler::GetFrame(size_t age) const
+{
+    return _frames[(_frameIdx + PROFILER_FRAME_COUNT - 1 - age) % PROFILER_FRAME_COUNT];
+}
+
+using Microseconds = std::chrono::duration<double, std::micro>;
+
+static double GetTraceTimestamp(ProfilerClock::time_point origin, ProfilerClock::time_point time)
+{
+    return Microseconds(time - origin).count();
+}
+
+static json_t CreateTraceEvent(const char* name, const char* category, int32_t threadId, double ts, double dur)
+{
+    return json_t{ { "name", name }, { "cat", category }, { "ph", "X" }, { "pid", 1 },
+                   { "tid", threadId }, { "ts", ts },     { "dur", dur } };
+}
+
+void FrameProfiler::WriteChromeTrace(const std::string& path) const
+{
+    constexpr int32_t LogicThreadId = 1;
+    constexpr int32_t PaintThreadId = 2;
+
+    // Timestamps are relative to the oldest sample.
+    auto origin = ProfilerClock::time_point::max();
+    if (_numTicks > 0)
+        origin = std::min(origin, _tickStart[GetTickIdx(_numTicks - 1)]);
+    if (_numFrames > 0)
+        origin = std::min(origin, GetFrame(_numFrames - 1).Start);
+
+    auto events = json_t::array();
+    events.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", LogicThreadId },
+                       { "args", { { "name", "Logic" } } } });
+    events.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", PaintThreadId },
+                       { "args", { { "name", "Paint" } } } });
+
+    for (size_t age = _numTicks; age-- > 0;)
+    {
+        const auto idx = GetTickIdx(age);
+        const auto tickStart = GetTraceTimestamp(origin, _tickStart[idx]);
+
+        const auto tickDuration = Microseconds(GetTickDuration(age)).count();
+        auto tickEvent = CreateTraceEvent("Tick", "logic", LogicThreadId, tickStart, tickDuration);
+        tickEvent["args"] = { { "tick", _tickNumber[idx] } };
+        events.push_back(std::move(tickEvent));
+
+        for (size_t i = 0; i < static_cast<size_t>(LogicTimePart::Count); i++)
+        {
+            const auto part = static_cast<LogicTimePart>(i);
+            const auto duration = GetTickPartDuration(age, part);
+            if (duration == ProfilerDuration::zero())
+                continue;
+
+            const auto start = tickStart + Microseconds(GetTickPartStart(idx, part)).count();
+            events.push_back(
+                CreateTraceEvent(GetLogicTimePartName(part), "logic", LogicThreadId, start, Microseconds(duration).count()));
+        }
+    }
+
+    for (size_t age = _numFrames; age-- > 0;)
+    {
+        const auto& frame = GetFrame(age);
+        const auto frameStart = GetTraceTimestamp(origin, frame.Start);
+        events.push_back(CreateTraceEvent("Frame", "paint", PaintThreadId, frameStart, Microseconds(frame.Duration).count()));
+        events.push_back({ { "name", "TextCache" }, { "cat", "paint" }, { "ph", "C" }, { "pid", 1 },
+                           { "tid", PaintThreadId }, { "ts", frameStart },
+                           { "args", { { "Hits", frame.TextCacheHits }, { "Misses", frame.TextCacheMisses } } } });
+
+        if (frame.Gpu.Valid)
+        {
+            auto args = json_t{ { "batches", frame.Gpu.NumBatches },
+                                { "instances", frame.Gpu.NumInstances },
+                                { "uploadedBytes", frame.Gpu.UploadedBytes },
+                                { "atlasMisses", frame.Gpu.AtlasMisses } };
+            for (size_t p = 0; p < static_cast<size_t>(GpuTimePart::Count); p++)
+            {
+                args[GetGpuTimePartName(static_cast<GpuTimePart>(p))] = Microseconds(frame.Gpu.Parts[p]).count();
+            }
+            events.push_back({ { "name", "Gpu" }, { "cat", "paint" }, { "ph", "C" }, { "pid", 1 }, { "tid", PaintThreadId },
+                               { "ts", frameStart }, { "args", std::move(args) } });
+        }
+
+        // Viewports are painted interleaved with the rest of the frame, so their stages are reported as totals.
+        for (size_t i = 0; i < frame.NumViewports; i++)
+        {
+            const auto& viewport = frame.Viewports[i];
+            auto args = json_t{ { "viewport", i }, { "columns", viewport.NumColumns } };
+            for (size_t p = 0; p < static_cast<size_t>(PaintTimePart::Count); p++)
+            {
+                args[GetPaintTimePartName(static_cast<PaintTimePart>(p))] = Microseconds(viewport.Parts[p]).count();
+            }
+            events.push_back({ { "name", "Viewport" }, { "cat", "paint" }, { "ph", "C" }, { "pid", 1 },
+                               { "tid", PaintThreadId }, { "ts", frameStart }, { "id", i }, { "args", std::move(args) } });
+        }
+
+        for (size_t i = 0; i < frame.NumWindowClasses; i++)
+        {
+            const auto& window = frame.WindowClasses[i];
+            auto args = json_t{ { "draws", window.NumDraws },
+                                { "draw", Microseconds(window.DrawDuration).count() },
+                                { "invalidations", window.NumInvalidations },
+                                { "invalidatedPixels", window.InvalidatedPixels } };
+            events.push_back({ { "name", "Window" }, { "cat", "paint" }, { "ph", "C" }, { "pid", 1 },
+                               { "tid", PaintThreadId }, { "ts", frameStart }, { "id", window.WindowClass },
+                               { "args", std::move(args) } });
+        }
+    }
+
+    json_t trace = { { "traceEvents", std::move(events) }, { "displayTimeUnit", "ms" } };
+    Json::WriteToFile(path.c_str(), trace, -1);
+}
+
+const char* FrameProfiler::GetLogicTimePartName(LogicTimePart part)
+{
+    return LogicTimePartNames[EnumValue(part)];
+}
+
+const char* FrameProfiler::GetPaintTimePartName(PaintTimePart part)
+{
+    return PaintTimePartNames[EnumValue(part)];
+}
+
+const char* FrameProfiler::GetGpuTimePartName(GpuTimePart part)
+{
+    return GpuTimePartNames[EnumValue(part)];
+}
@@ -0,0 +1,210 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "GameState.h"
+#include "common.h"
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <string>
+
+struct rct_viewport;
+
+namespace OpenRCT2
+{
+    enum class PaintTimePart
+    {
+        Generate,
+        Arrange,
+        Draw,
+        Count,
+    };
+
+    // The passes of a frame of a hardware drawing engine that are timed on the GPU.
+    enum class GpuTimePart
+    {
+        Lines,
+        Rectangles,
+        Transparency,
+        Palette,
+        Count,
+    };
+
+    constexpr size_t PROFILER_FRAME_COUNT = 256;
+    constexpr size_t PROFILER_MAX_VIEWPORTS = 8;
+    constexpr size_t PROFILER_MAX_WINDOW_CLASSES = 16;
+
+    using ProfilerClock = std::chrono::high_resolution_clock;
+    using ProfilerDuration = std::chrono::duration<double>;
+
+    struct ProfilerViewportSample
+    {
+        const rct_viewport* Viewport{};
+        uint32_t NumColumns{};
+        // Generate and arrange run in parallel when multithreading is enabled, they are the sum over all columns.
+        std::array<ProfilerDuration, static_cast<size_t>(PaintTimePart::Count)> Parts{};
+    };
+
+    struct ProfilerWindowSample
+    {
+        uint8_t WindowClass{};
+        // How often windows of the class were drawn, a window is drawn once for each dirty area it overlaps.
+        uint32_t NumDraws{};
+        ProfilerDuration DrawDuration{};
+        // The invalidations made since the previous frame, including those made while updating the windows.
+        uint32_t NumInvalidations{};
+        uint64_t InvalidatedPixels{};
+    };
+
+    struct ProfilerGpuSample
+    {
+        bool Valid{};
+        std::array<ProfilerDuration, static_cast<size_t>(GpuTimePart::Count)> Parts{};
+        uint32_t NumBatches{};
+        uint64_t NumInstances{};
+        // Instance data and images written to textures.
+        uint64_t UploadedBytes{};
+        // How many images and glyphs were not in the texture atlases yet.
+        uint64_t AtlasMisses{};
+    };
+
+    struct ProfilerFrameSample
+    {
+        ProfilerClock::time_point Start;
+        ProfilerDuration Duration{};
+        size_t NumViewports{};
+        std::array<ProfilerViewportSample, PROFILER_MAX_VIEWPORTS> Viewports{};
+        size_t NumWindowClasses{};
+        std::array<ProfilerWindowSample, PROFILER_MAX_WINDOW_CLASSES> WindowClasses{};
+        // How often the widths and surfaces of TrueType text were found in the text cache during the frame.
+        uint64_t TextCacheHits{};
+        uint64_t TextCacheMisses{};
+        // From when the input of the frame was read until it was presented, only measured when uncap_fps is enabled.
+        ProfilerDuration PresentLatency{};
+        // The GPU timings only become known a few frames later, so this is the work of an earlier frame.
+        ProfilerGpuSample Gpu{};
+    };
+
+    // The state of the texture cache of a hardware drawing engine, as reported at the start of the last frame.
+    struct ProfilerTextureStats
+    {
+        size_t NumImages{};
+        size_t NumPendingImages{};
+        size_t UsedBytes{};
+        size_t AllocatedBytes{};
+        uint64_t NumEvictedImages{};
+        uint64_t NumCompactions{};
+    };
+
+    /**
+     * Records how long the stages of the game logic take for each tick and how long generating, arranging and drawing
+     * the paint structs of each viewport takes for each frame. Both are kept in ring buffers of the last
+     * LOGIC_UPDATE_MEASUREMENTS_COUNT ticks and PROFILER_FRAME_COUNT frames, so the profiler can be left running on a
+     * server and be inspected once it starts lagging.
+     */
+    class FrameProfiler
+    {
+    private:
+        bool _enabled{};
+
+        // The logic timings are cumulative from the start of the tick, as written by GameState::UpdateLogic.
+        LogicTimings _logicTimings;
+        std::array<ProfilerClock::time_point, LOGIC_UPDATE_MEASUREMENTS_COUNT> _tickStart{};
+        std::array<uint32_t, LOGIC_UPDATE_MEASUREMENTS_COUNT> _tickNumber{};
+        size_t _numTicks{};
+        size_t _pendingTickIdx{};
+
+        std::array<ProfilerFrameSample, PROFILER_FRAME_COUNT> _frames{};
+        size_t _frameIdx{};
+        size_t _numFrames{};
+        bool _inFrame{};
+        uint64_t _frameTextCacheHits{};
+        uint64_t _frameTextCacheMisses{};
+        // Windows are invalidated while they are updated, which happens before the frame they are drawn in begins.
+        size_t _numPendingWindowClasses{};
+        std::array<ProfilerWindowSample, PROFILER_MAX_WINDOW_CLASSES> _pendingWindowClasses{};
+        std::optional<ProfilerTextureStats> _textureStats;
+
+    public:
+        FrameProfiler();
+
+        static FrameProfiler& Get();
+
+        bool IsEnabled() const
+        {
+            return _enabled;
+        }
+        void SetEnabled(bool value);
+        void Clear();
+
+        /**
+         * Returns the timings to pass to GameState::UpdateLogic, or nullptr when the profiler is disabled.
+         */
+        LogicTimings* BeginTick();
+        void EndTick();
+
+        void BeginFrame();
+        void EndFrame();
+        void RecordViewportPaint(
+            const rct_viewport* viewport, size_t numColumns, ProfilerDuration generate, ProfilerDuration arrange,
+            ProfilerDuration draw);
+        void RecordWindowDraw(uint8_t windowClass, ProfilerDuration duration);
+        void RecordWindowInvalidate(uint8_t windowClass, uint64_t numPixels);
+        void RecordTextureStats(const ProfilerTextureStats& stats);
+        void RecordPresentLatency(ProfilerDuration latency);
+        void RecordGpuSample(const ProfilerGpuSample& sample);
+
+        /**
+         * Gets the texture cache stats, if the drawing engine has a texture cache.
+         */
+        const std::optional<ProfilerTextureStats>& GetTextureStats() const
+        {
+            return _textureStats;
+        }
+
+        size_t GetNumTicks() const
+        {
+            return _numTicks;
+        }
+        size_t GetNumFrames() const
+        {
+            return _numFrames;
+        }
+
+        /**
+         * Gets the duration of a part of the given tick, 0 being the most recent one.
+         */
+        ProfilerDuration GetTickPartDuration(size_t age, LogicTimePart part) const;
+        ProfilerDuration GetTickDuration(size_t age) const;
+
+        /**
+         * Gets the given frame, 0 being the most recent completed one.
+         */
+        const ProfilerFrameSample& GetFrame(size_t age) const;
+
+        /**
+         * Writes the recorded ticks and frames in the Chrome trace event format, as read by chrome://tracing and
+         * Perfetto.
+         */
+        void WriteChromeTrace(const std::string& path) const;
+
+        static const char* GetLogicTimePartName(LogicTimePart part);
+        static const char* GetPaintTimePartName(PaintTimePart part);
+        static const char* GetGpuTimePartName(GpuTimePart part);
+
+    private:
+        ProfilerWindowSample* GetPendingWindowSample(uint8_t windowClass);
+        size_t GetTickIdx(size_t age) const;
+        ProfilerDuration GetTickPartEnd(size_t idx, LogicTimePart part) const;
+        ProfilerDuration GetTickPartStart(size_t idx, LogicTimePart part) const;
+    };
+} // namespace OpenRCT2
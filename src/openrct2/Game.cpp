@@ -41,6 +41,7 @@
 #include "peep/Staff.h"
 #include "platform/Platform2.h"
 #include "rct1/RCT1.h"
+#include "rct2/S6Exporter.h"
 #include "ride/Ride.h"
 #include "ride/RideRatings.h"
 #include "ride/Station.h"
@@ -69,9 +70,12 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <future>
 #include <iterator>
 #include <memory>
 
+static std::future<void> _autosaveFuture;
+
 uint16_t gCurrentDeltaTime;
 uint8_t gGamePaused = 0;
 int32_t gGameSpeed = 1;
@@ -657,17 +661,17 @@ void save_game_as()
     delete intent;
 }
 
-static void limit_autosave_count(const size_t numberOfFilesToKeep, bool processLandscapeFolder)
+static void limit_autosave_count(
+    const IPlatformEnvironment& environment, const size_t numberOfFilesToKeep, bool processLandscapeFolder)
 {
     size_t autosavesCount = 0;
     size_t numAutosavesToDelete = 0;
 
-    auto environment = GetContext()->GetPlatformEnvironment();
-    auto folderDirectory = environment->GetDirectoryPath(DIRBASE::USER, DIRID::SAVE);
+    auto folderDirectory = environment.GetDirectoryPath(DIRBASE::USER, DIRID::SAVE);
     char const* fileFilter = "autosave_*.sv6";
     if (processLandscapeFolder)
     {
-        folderDirectory = environment->GetDirectoryPath(DIRBASE::USER, DIRID::LANDSCAPE);
+        folderDirectory = environment.GetDirectoryPath(DIRBASE::USER, DIRID::LANDSCAPE);
         fileFilter = "autosave_*.sc6";
     }
 
@@ -726,12 +730,12 @@ void game_autosave()
 {
     const char* subDirectory = "save";
     const char* fileExtension = ".sv6";
-    uint32_t saveFlags = 0x80000000;
+    bool isLandscape = false;
     if (gScreenFlags & SCREEN_FLAGS_EDITOR)
     {
         subDirectory = "landscape";
         fileExtension = ".sc6";
-        saveFlags |= 2;
+        isLandscape = true;
     }
 
     // Retrieve current time
@@ -743,9 +747,6 @@ void game_autosave()
         timeName, sizeof(timeName), "autosave_%04u-%02u-%02u_%02u-%02u-%02u%s", currentDate.year, currentDate.month,
         currentDate.day, currentTime.hour, currentTime.minute, currentTime.second, fileExtension);
 
-    int32_t autosavesToKeep = gConfigGeneral.autosave_amount;
-    limit_autosave_count(autosavesToKeep - 1, (gScreenFlags & SCREEN_FLAGS_EDITOR));
-
     utf8 path[MAX_PATH];
     utf8 backupPath[MAX_PATH];
     platform_get_user_directory(path, subDirectory, sizeof(path));
@@ -757,13 +758,56 @@ void game_autosave()
     safe_strcat(backupPath, fileExtension, sizeof(backupPath));
     safe_strcat(backupPath, ".bak", sizeof(backupPath));
 
-    if (Platform::FileExists(path))
+    // Only one autosave is written at a time, so that pruning never races with a previous autosave.
+    if (_autosaveFuture.valid())
+    {
+        _autosaveFuture.wait();
+    }
+
+    // Only taking the snapshot of the park has to happen on the game thread. Encoding and writing it, which takes most
+    // of the time on big parks, is left to another thread.
+    viewport_set_saved_view();
+    auto exporter = std::make_shared<S6Exporter>();
+    try
+    {
+        exporter->RemoveTracklessRides = true;
+        exporter->Export();
+    }
+    catch (const std::exception& e)
     {
-        platform_file_copy(path, backupPath, true);
+        log_error("Unable to save park: '%s'", e.what());
+        return;
     }
+    gfx_invalidate_screen();
 
-    if (!scenario_save(path, saveFlags))
-        Console::Error::WriteLine("Could not autosave the scenario. Is the save folder writeable?");
+    auto environment = GetContext()->GetPlatformEnvironment();
+    int32_t autosavesToKeep = gConfigGeneral.autosave_amount;
+    _autosaveFuture = std::async(
+        std::launch::async,
+        [exporter, environment, autosavesToKeep, isLandscape, path = std::string(path), backupPath = std::string(backupPath)] {
+            limit_autosave_count(*environment, autosavesToKeep - 1, isLandscape);
+            if (Platform::FileExists(path))
+            {
+                platform_file_copy(path.c_str(), backupPath.c_str(), true);
+            }
+
+            try
+            {
+                if (isLandscape)
+                {
+                    exporter->SaveScenario(path.c_str());
+                }
+                else
+                {
+                    exporter->SaveGame(path.c_str());
+                }
+            }
+            catch (const std::exception& e)
+            {
+                log_error("Unable to save park: '%s'", e.what());
+                Console::Error::WriteLine("Could not autosave the scenario. Is the save folder writeable?");
+            }
+        });
 }
 
 static void game_load_or_quit_no_save_prompt_callback(int32_t result, const utf8* path)
@@ -11,6 +11,7 @@
 
 #include "Context.h"
 #include "Editor.h"
+#include "FrameProfiler.h"
 #include "Game.h"
 #include "GameState.h"
 #include "GameStateSnapshots.h"
@@ -174,9 +175,11 @@ void GameState::Update()
     }
 
     // Update the game one or more times
+    auto& profiler = FrameProfiler::Get();
     for (uint32_t i = 0; i < numUpdates; i++)
     {
-        UpdateLogic();
+        UpdateLogic(profiler.BeginTick());
+        profiler.EndTick();
         if (gGameSpeed == 1)
         {
             if (input_get_state() == InputState::Reset || input_get_state() == InputState::Normal)
@@ -372,9 +375,12 @@ void GameState::UpdateLogic(LogicTimings* timings)
 
 #ifdef ENABLE_SCRIPTING
     auto& hookEngine = GetContext()->GetScriptEngine().GetHookEngine();
-    hookEngine.Call(HOOK_TYPE::INTERVAL_TICK, true);
+    if (hookEngine.HasSubscriptions(HOOK_TYPE::INTERVAL_TICK))
+    {
+        hookEngine.Call(HOOK_TYPE::INTERVAL_TICK, true);
+    }
 
-    if (day != _date.GetDay())
+    if (day != _date.GetDay() && hookEngine.HasSubscriptions(HOOK_TYPE::INTERVAL_DAY))
     {
         hookEngine.Call(HOOK_TYPE::INTERVAL_DAY, true);
     }
@@ -21,6 +21,11 @@
 #include "world/Particle.h"
 #include "world/Sprite.h"
 
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
 static constexpr size_t MaximumGameStateSnapshots = 32;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
 
@@ -30,6 +35,8 @@ struct GameStateSnapshot_t
     {
         tick = mv.tick;
         storedSprites = std::move(mv.storedSprites);
+        capturedSprites = std::move(mv.capturedSprites);
+        capturedSpritesPending = mv.capturedSpritesPending;
         return *this;
     }
 
@@ -39,8 +46,78 @@ struct GameStateSnapshot_t
     OpenRCT2::MemoryStream storedSprites;
     OpenRCT2::MemoryStream parkParameters;
 
-    // Must pass a function that can access the sprite.
-    void SerialiseSprites(std::function<rct_sprite*(const size_t)> getEntity, const size_t numSprites, bool saving)
+    // The serialised entities of a captured snapshot by sprite index. Entities that did not change between captures share
+    // their data with the snapshots before, storedSprites is only written from them once the snapshot is sent or compared.
+    std::vector<std::pair<uint32_t, std::shared_ptr<const std::vector<uint8_t>>>> capturedSprites;
+    bool capturedSpritesPending = false;
+
+    void WriteCapturedSprites()
+    {
+        if (!capturedSpritesPending)
+            return;
+
+        storedSprites.SetPosition(0);
+        DataSerialiser ds(true, storedSprites);
+
+        uint32_t numSavedSprites = static_cast<uint32_t>(capturedSprites.size());
+        ds << numSavedSprites;
+        for (const auto& [spriteIdx, data] : capturedSprites)
+        {
+            ds << spriteIdx;
+            storedSprites.Write(data->data(), data->size());
+        }
+        capturedSpritesPending = false;
+    }
+
+    // Serialises the type of the sprite followed by its data, the same way for every sprite in storedSprites.
+    static void SerialiseSprite(DataSerialiser& ds, rct_sprite& sprite, GuestColdData* guestColdData)
+    {
+        ds << sprite.base.Type;
+
+        switch (sprite.base.Type)
+        {
+            case EntityType::Vehicle:
+                reinterpret_cast<Vehicle&>(sprite).Serialise(ds);
+                break;
+            case EntityType::Guest:
+                if (guestColdData != nullptr)
+                    reinterpret_cast<Guest&>(sprite).Serialise(ds, *guestColdData);
+                else
+                    reinterpret_cast<Guest&>(sprite).Serialise(ds);
+                break;
+            case EntityType::Staff:
+                reinterpret_cast<Staff&>(sprite).Serialise(ds);
+                break;
+            case EntityType::Litter:
+                reinterpret_cast<Litter&>(sprite).Serialise(ds);
+                break;
+            case EntityType::MoneyEffect:
+                reinterpret_cast<MoneyEffect&>(sprite).Serialise(ds);
+                break;
+            case EntityType::Balloon:
+                reinterpret_cast<Balloon&>(sprite).Serialise(ds);
+                break;
+            case EntityType::Duck:
+                reinterpret_cast<Duck&>(sprite).Serialise(ds);
+                break;
+            case EntityType::JumpingFountain:
+                reinterpret_cast<JumpingFountain&>(sprite).Serialise(ds);
+                break;
+            case EntityType::SteamParticle:
+                reinterpret_cast<SteamParticle&>(sprite).Serialise(ds);
+                break;
+            case EntityType::Null:
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Must pass a function that can access the sprite. Guests are serialised with the cold data in guestColdData when
+    // it is given, so that loading a snapshot does not overwrite the cold data of the guests in the park.
+    void SerialiseSprites(
+        std::function<rct_sprite*(const size_t)> getEntity, const size_t numSprites, bool saving,
+        std::vector<GuestColdData>* guestColdData = nullptr)
     {
         const bool loading = !saving;
 
@@ -82,44 +159,7 @@ struct GameStateSnapshot_t
                 log_error("Entity index corrupted!");
                 return;
             }
-            auto& sprite = *entity;
-
-            ds << sprite.base.Type;
-
-            switch (sprite.base.Type)
-            {
-                case EntityType::Vehicle:
-                    reinterpret_cast<Vehicle&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Guest:
-                    reinterpret_cast<Guest&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Staff:
-                    reinterpret_cast<Staff&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Litter:
-                    reinterpret_cast<Litter&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::MoneyEffect:
-                    reinterpret_cast<MoneyEffect&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Balloon:
-                    reinterpret_cast<Balloon&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Duck:
-                    reinterpret_cast<Duck&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::JumpingFountain:
-                    reinterpret_cast<JumpingFountain&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::SteamParticle:
-                    reinterpret_cast<SteamParticle&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Null:
-                    break;
-                default:
-                    break;
-            }
+            SerialiseSprite(ds, *entity, guestColdData != nullptr ? &guestColdData->at(spriteIdx) : nullptr);
         }
     }
 };
@@ -129,6 +169,7 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     virtual void Reset() override final
     {
         _snapshots.clear();
+        _capturedEntities.clear();
     }
 
     virtual GameStateSnapshot_t& CreateSnapshot() override final
@@ -145,12 +186,84 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         snapshot.srand0 = srand0;
     }
 
+    // Entities are stored in pool slots only as big as their own type, so only that many bytes of them can be read.
+    static size_t GetEntitySize(EntityType type)
+    {
+        switch (type)
+        {
+            case EntityType::Vehicle:
+                return sizeof(Vehicle);
+            case EntityType::Guest:
+                return sizeof(Guest);
+            case EntityType::Staff:
+                return sizeof(Staff);
+            case EntityType::Litter:
+                return sizeof(Litter);
+            case EntityType::SteamParticle:
+                return sizeof(SteamParticle);
+            case EntityType::MoneyEffect:
+                return sizeof(MoneyEffect);
+            case EntityType::CrashedVehicleParticle:
+                return sizeof(VehicleCrashParticle);
+            case EntityType::ExplosionCloud:
+                return sizeof(ExplosionCloud);
+            case EntityType::CrashSplash:
+                return sizeof(CrashSplashParticle);
+            case EntityType::ExplosionFlare:
+                return sizeof(ExplosionFlare);
+            case EntityType::JumpingFountain:
+                return sizeof(JumpingFountain);
+            case EntityType::Balloon:
+                return sizeof(Balloon);
+            case EntityType::Duck:
+                return sizeof(Duck);
+            default:
+                return sizeof(SpriteBase);
+        }
+    }
+
     virtual void Capture(GameStateSnapshot_t& snapshot) override final
     {
-        snapshot.SerialiseSprites(
-            [](const size_t index) { return reinterpret_cast<rct_sprite*>(GetEntity(index)); }, MAX_ENTITIES, true);
+        // Serialising an entity only depends on its own bytes and those of its cold data, so an entity that is byte for
+        // byte the same as when it was last captured can reuse the data serialised then.
+        _capturedEntities.resize(MAX_ENTITIES);
 
-        // log_info("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.storedSprites.GetLength()));
+        snapshot.capturedSprites.clear();
+        for (size_t i = 0; i < MAX_ENTITIES; i++)
+        {
+            auto& captured = _capturedEntities[i];
+            auto entity = reinterpret_cast<rct_sprite*>(GetEntity(i));
+            if (entity == nullptr || entity->base.Type == EntityType::Null)
+            {
+                captured.Data = nullptr;
+                continue;
+            }
+
+            const GuestColdData* coldData = nullptr;
+            if (entity->base.Type == EntityType::Guest)
+                coldData = &reinterpret_cast<Guest&>(*entity).GetColdData();
+
+            const auto entitySize = GetEntitySize(entity->base.Type);
+            if (captured.Data == nullptr || captured.Bytes.size() != entitySize
+                || std::memcmp(captured.Bytes.data(), entity, entitySize) != 0
+                || (coldData != nullptr && std::memcmp(captured.ColdData.data(), coldData, sizeof(GuestColdData)) != 0))
+            {
+                captured.Bytes.resize(entitySize);
+                std::memcpy(captured.Bytes.data(), entity, entitySize);
+                if (coldData != nullptr)
+                    std::memcpy(captured.ColdData.data(), coldData, sizeof(GuestColdData));
+
+                _captureStream.SetPosition(0);
+                DataSerialiser ds(true, _captureStream);
+                GameStateSnapshot_t::SerialiseSprite(ds, *entity, nullptr);
+
+                auto data = static_cast<const uint8_t*>(_captureStream.GetData());
+                captured.Data = std::make_shared<const std::vector<uint8_t>>(
+                    data, data + static_cast<size_t>(_captureStream.GetPosition()));
+            }
+            snapshot.capturedSprites.emplace_back(static_cast<uint32_t>(i), captured.Data);
+        }
+        snapshot.capturedSpritesPending = true;
     }
 
     virtual const GameStateSnapshot_t* GetLinkedSnapshot(uint32_t tick) const override final
@@ -165,13 +278,16 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void SerialiseSnapshot(GameStateSnapshot_t& snapshot, DataSerialiser& ds) const override final
     {
+        if (ds.IsSaving())
+            snapshot.WriteCapturedSprites();
+
         ds << snapshot.tick;
         ds << snapshot.srand0;
         ds << snapshot.storedSprites;
         ds << snapshot.parkParameters;
     }
 
-    std::vector<rct_sprite> BuildSpriteList(GameStateSnapshot_t& snapshot) const
+    std::vector<rct_sprite> BuildSpriteList(GameStateSnapshot_t& snapshot, std::vector<GuestColdData>& guestColdData) const
     {
         std::vector<rct_sprite> spriteList;
         spriteList.resize(MAX_ENTITIES);
@@ -182,7 +298,12 @@ struct GameStateSnapshots final : public IGameStateSnapshots
             sprite.base.Type = EntityType::Null;
         }
 
-        snapshot.SerialiseSprites([&spriteList](const size_t index) { return &spriteList[index]; }, MAX_ENTITIES, false);
+        guestColdData.clear();
+        guestColdData.resize(MAX_ENTITIES);
+
+        snapshot.WriteCapturedSprites();
+        snapshot.SerialiseSprites(
+            [&spriteList](const size_t index) { return &spriteList[index]; }, MAX_ENTITIES, false, &guestColdData);
 
         return spriteList;
     }
@@ -277,6 +398,23 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         COMPARE_FIELD(Staff, StaffBinsEmptied);
     }
 
+    void CompareGuestColdData(
+        const GuestColdData& spriteBase, const GuestColdData& spriteCmp, GameStateSpriteChange_t& changeData) const
+    {
+        for (size_t i = 0; i < spriteBase.RideTypesBeenOn.size(); i++)
+        {
+            COMPARE_FIELD(GuestColdData, RideTypesBeenOn[i]);
+        }
+        for (size_t i = 0; i < spriteBase.RidesBeenOn.size(); i++)
+        {
+            COMPARE_FIELD(GuestColdData, RidesBeenOn[i]);
+        }
+        for (int i = 0; i < PEEP_MAX_THOUGHTS; i++)
+        {
+            COMPARE_FIELD(GuestColdData, Thoughts[i]);
+        }
+    }
+
     void CompareSpriteDataGuest(const Guest& spriteBase, const Guest& spriteCmp, GameStateSpriteChange_t& changeData) const
     {
         CompareSpriteDataPeep(spriteBase, spriteCmp, changeData);
@@ -294,31 +432,18 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         COMPARE_FIELD(Guest, Intensity);
         COMPARE_FIELD(Guest, NauseaTolerance);
         COMPARE_FIELD(Guest, PaidOnDrink);
-        for (int i = 0; i < 16; i++)
-        {
-            COMPARE_FIELD(Guest, RideTypesBeenOn[i]);
-        }
         COMPARE_FIELD(Guest, ItemFlags);
         COMPARE_FIELD(Guest, Photo2RideRef);
         COMPARE_FIELD(Guest, Photo3RideRef);
         COMPARE_FIELD(Guest, Photo4RideRef);
         COMPARE_FIELD(Guest, GuestNextInQueue);
         COMPARE_FIELD(Guest, TimeInQueue);
-        for (int i = 0; i < 32; i++)
-        {
-            COMPARE_FIELD(Guest, RidesBeenOn[i]);
-        }
-
         COMPARE_FIELD(Guest, CashInPocket);
         COMPARE_FIELD(Guest, CashSpent);
         COMPARE_FIELD(Guest, ParkEntryTime);
         COMPARE_FIELD(Guest, RejoinQueueTimeout);
         COMPARE_FIELD(Guest, PreviousRide);
         COMPARE_FIELD(Guest, PreviousRideTimeOut);
-        for (int i = 0; i < PEEP_MAX_THOUGHTS; i++)
-        {
-            COMPARE_FIELD(Guest, Thoughts[i]);
-        }
         COMPARE_FIELD(Guest, GuestHeadingToRideId);
         COMPARE_FIELD(Guest, GuestIsLostCountdown);
         COMPARE_FIELD(Guest, Photo1RideRef);
@@ -502,7 +627,9 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         COMPARE_FIELD(MiscEntity, frame);
     }
 
-    void CompareSpriteData(const rct_sprite& spriteBase, const rct_sprite& spriteCmp, GameStateSpriteChange_t& changeData) const
+    void CompareSpriteData(
+        const rct_sprite& spriteBase, const GuestColdData& coldBase, const rct_sprite& spriteCmp, const GuestColdData& coldCmp,
+        GameStateSpriteChange_t& changeData) const
     {
         CompareSpriteDataCommon(spriteBase.base, spriteCmp.base, changeData);
         if (spriteBase.base.Type == spriteCmp.base.Type)
@@ -512,6 +639,7 @@ struct GameStateSnapshots final : public IGameStateSnapshots
                 case EntityType::Guest:
                     CompareSpriteDataGuest(
                         static_cast<const Guest&>(spriteBase.base), static_cast<const Guest&>(spriteCmp.base), changeData);
+                    CompareGuestColdData(coldBase, coldCmp, changeData);
                     break;
                 case EntityType::Staff:
                     CompareSpriteDataStaff(
@@ -576,8 +704,10 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         res.srand0Left = base.srand0;
         res.srand0Right = cmp.srand0;
 
-        std::vector<rct_sprite> spritesBase = BuildSpriteList(const_cast<GameStateSnapshot_t&>(base));
-        std::vector<rct_sprite> spritesCmp = BuildSpriteList(const_cast<GameStateSnapshot_t&>(cmp));
+        std::vector<GuestColdData> coldBase;
+        std::vector<GuestColdData> coldCmp;
+        std::vector<rct_sprite> spritesBase = BuildSpriteList(const_cast<GameStateSnapshot_t&>(base), coldBase);
+        std::vector<rct_sprite> spritesCmp = BuildSpriteList(const_cast<GameStateSnapshot_t&>(cmp), coldCmp);
 
         for (uint32_t i = 0; i < static_cast<uint32_t>(spritesBase.size()); i++)
         {
@@ -608,7 +738,7 @@ struct GameStateSnapshots final : public IGameStateSnapshots
             }
             else
             {
-                CompareSpriteData(spriteBase, spriteCmp, changeData);
+                CompareSpriteData(spriteBase, coldBase[i], spriteCmp, coldCmp[i], changeData);
                 if (changeData.diffs.size() == 0)
                 {
                     changeData.changeType = GameStateSpriteChange_t::EQUAL;
@@ -733,7 +863,17 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     }
 
 private:
+    // An entity as it was when it was last captured, along with what it was serialised to.
+    struct CapturedEntity
+    {
+        std::vector<uint8_t> Bytes;
+        std::array<uint8_t, sizeof(GuestColdData)> ColdData{};
+        std::shared_ptr<const std::vector<uint8_t>> Data;
+    };
+
     CircularBuffer<std::unique_ptr<GameStateSnapshot_t>, MaximumGameStateSnapshots> _snapshots;
+    std::vector<CapturedEntity> _capturedEntities;
+    OpenRCT2::MemoryStream _captureStream;
 };
 
 std::unique_ptr<IGameStateSnapshots> CreateGameStateSnapshots()
@@ -80,7 +80,8 @@ struct IGameStateSnapshots
     virtual void LinkSnapshot(GameStateSnapshot_t& snapshot, uint32_t tick, uint32_t srand0) = 0;
 
     /*
-     * This will fill the snapshot with the current game state in a compact form.
+     * This will fill the snapshot with the current game state in a compact form. Only the entities that have changed
+     * since the previous capture are serialised again, the others share their data with the previous snapshot.
      */
     virtual void Capture(GameStateSnapshot_t& snapshot) = 0;
 
@@ -47,6 +47,7 @@ extern bool gOpenRCT2Headless;
 extern bool gOpenRCT2NoGraphics;
 extern bool gOpenRCT2ShowChangelog;
 extern bool gOpenRCT2SilentBreakpad;
+extern bool gOpenRCT2StartupProfile;
 extern utf8 gSilentRecordingName[MAX_PATH];
 
 #ifndef DISABLE_NETWORK
@@ -10,6 +10,7 @@
 #include "ParkImporter.h"
 
 #include "Context.h"
+#include "Diagnostic.h"
 #include "core/Path.hpp"
 #include "core/String.hpp"
 #include "object/ObjectManager.h"
@@ -35,6 +36,39 @@ namespace ParkImporter
         return parkImporter;
     }
 
+    std::optional<ParkFileInfo> LoadInfo(const std::string& path)
+    {
+        std::string extension = Path::GetExtension(path);
+        std::unique_ptr<IParkImporter> parkImporter;
+        if (ExtensionIsRCT1(extension))
+        {
+            parkImporter = CreateS4();
+        }
+        else if (String::Equals(extension, ".sc6", true) || String::Equals(extension, ".sv6", true))
+        {
+            auto context = OpenRCT2::GetContext();
+            parkImporter = CreateS6(context->GetObjectRepository());
+        }
+        else
+        {
+            return std::nullopt;
+        }
+
+        try
+        {
+            ParkFileInfo info;
+            if (parkImporter->LoadInfo(path.c_str(), &info))
+            {
+                return info;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            log_verbose("Unable to read the details of '%s': %s", path.c_str(), e.what());
+        }
+        return std::nullopt;
+    }
+
     bool ExtensionIsRCT1(const std::string& extension)
     {
         return String::Equals(extension, ".sc4", true) || String::Equals(extension, ".sv4", true);
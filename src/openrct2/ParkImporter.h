@@ -14,6 +14,7 @@
 #include "object/Object.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,22 @@ namespace OpenRCT2
 
 struct scenario_index_entry;
 
+/**
+ * The details of a park that can be shown without loading it, such as in the load / save window.
+ */
+struct ParkFileInfo
+{
+    std::string Name;
+    uint16_t MonthsElapsed{};
+    uint16_t NumGuests{};
+    money32 Cash{};
+    uint16_t ParkRating{};
+    uint8_t ObjectiveType{};
+    uint8_t ObjectiveYear{};
+    uint16_t ObjectiveNumGuests{}; // The ride type for OBJECTIVE_BUILD_THE_BEST.
+    money32 ObjectiveCurrency{};   // The minimum excitement for OBJECTIVE_FINISH_5_ROLLERCOASTERS.
+};
+
 struct ParkLoadResult final
 {
 public:
@@ -53,6 +70,11 @@ public:
 
     virtual void Import() abstract;
     virtual bool GetDetails(scenario_index_entry* dst) abstract;
+
+    /**
+     * Reads just enough of the park to fill in its details, without loading any objects or the map.
+     */
+    virtual bool LoadInfo(const utf8* path, ParkFileInfo* dst) abstract;
 };
 
 namespace ParkImporter
@@ -61,6 +83,8 @@ namespace ParkImporter
     std::unique_ptr<IParkImporter> CreateS4();
     std::unique_ptr<IParkImporter> CreateS6(IObjectRepository& objectRepository);
 
+    std::optional<ParkFileInfo> LoadInfo(const std::string& path);
+
     bool ExtensionIsRCT1(const std::string& extension);
     bool ExtensionIsScenario(const std::string& extension);
 } // namespace ParkImporter
@@ -0,0 +1,196 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ParkInfoCache.h"
+
+#include "Diagnostic.h"
+#include "core/Console.hpp"
+#include "core/DataSerialiser.h"
+#include "core/File.h"
+#include "core/FileStream.h"
+#include "core/MemoryStream.h"
+#include "core/Path.hpp"
+
+#include <algorithm>
+
+static constexpr uint32_t MAGIC_NUMBER = 0x4B524150; // PARK
+static constexpr uint16_t VERSION = 1;
+
+ParkInfoCache::ParkInfoCache(const std::string& cachePath)
+    : _cachePath(cachePath)
+{
+    Load();
+}
+
+ParkInfoCache::~ParkInfoCache()
+{
+    Cancel();
+}
+
+std::optional<ParkFileInfo> ParkInfoCache::Get(const std::string& path, uint64_t lastModified)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(path);
+    if (it == _entries.end() || it->second.LastModified != lastModified || !it->second.Valid)
+        return std::nullopt;
+    return it->second.Info;
+}
+
+void ParkInfoCache::Request(std::vector<std::pair<std::string, uint64_t>> files)
+{
+    Cancel();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        files.erase(
+            std::remove_if(
+                files.begin(), files.end(),
+                [this](const std::pair<std::string, uint64_t>& file) {
+                    auto it = _entries.find(file.first);
+                    return it != _entries.end() && it->second.LastModified == file.second;
+                }),
+            files.end());
+    }
+    if (files.empty())
+        return;
+
+    _cancelled = false;
+    _readFuture = std::async(std::launch::async, [this, files = std::move(files)]() {
+        for (const auto& [path, lastModified] : files)
+        {
+            if (_cancelled)
+                break;
+
+            // Files the details can not be read from are remembered too, so they are not read again.
+            Entry entry;
+            entry.LastModified = lastModified;
+            auto info = ParkImporter::LoadInfo(path);
+            if (info)
+            {
+                entry.Valid = true;
+                entry.Info = std::move(*info);
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _entries[path] = std::move(entry);
+            _changed = true;
+            _revision++;
+        }
+    });
+}
+
+uint32_t ParkInfoCache::GetRevision() const
+{
+    return _revision;
+}
+
+void ParkInfoCache::Save()
+{
+    OpenRCT2::MemoryStream ms;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_changed)
+            return;
+
+        DataSerialiser ds(true, ms);
+        uint32_t magicNumber = MAGIC_NUMBER;
+        uint16_t version = VERSION;
+        uint32_t numEntries = static_cast<uint32_t>(_entries.size());
+        ds << magicNumber;
+        ds << version;
+        ds << numEntries;
+        for (auto& [path, entry] : _entries)
+        {
+            auto entryPath = path;
+            SerialiseEntry(ds, entryPath, entry);
+        }
+        _changed = false;
+    }
+
+    try
+    {
+        log_verbose("ParkInfoCache: Writing '%s'", _cachePath.c_str());
+        Path::CreateDirectory(Path::GetDirectory(_cachePath));
+        auto fs = OpenRCT2::FileStream(_cachePath, OpenRCT2::FILE_MODE_WRITE);
+        fs.Write(ms.GetData(), ms.GetLength());
+        fs.Flush();
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Unable to save park details: '%s'.", _cachePath.c_str());
+        Console::Error::WriteLine("%s", e.what());
+    }
+}
+
+void ParkInfoCache::Cancel()
+{
+    if (_readFuture.valid())
+    {
+        _cancelled = true;
+        _readFuture.wait();
+        _readFuture = {};
+    }
+}
+
+void ParkInfoCache::Load()
+{
+    if (!File::Exists(_cachePath))
+        return;
+
+    try
+    {
+        log_verbose("ParkInfoCache: Loading '%s'", _cachePath.c_str());
+        auto data = File::ReadAllBytes(_cachePath);
+        OpenRCT2::MemoryStream ms(data.data(), data.size());
+        DataSerialiser ds(false, ms);
+
+        uint32_t magicNumber{};
+        uint16_t version{};
+        uint32_t numEntries{};
+        ds << magicNumber;
+        ds << version;
+        if (magicNumber != MAGIC_NUMBER || version != VERSION)
+            return;
+
+        ds << numEntries;
+        for (uint32_t i = 0; i < numEntries; i++)
+        {
+            std::string path;
+            Entry entry;
+            SerialiseEntry(ds, path, entry);
+            _entries[path] = std::move(entry);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Unable to load park details: '%s'.", _cachePath.c_str());
+        Console::Error::WriteLine("%s", e.what());
+        _entries.clear();
+    }
+}
+
+void ParkInfoCache::SerialiseEntry(DataSerialiser& ds, std::string& path, Entry& entry)
+{
+    ds << path;
+    ds << entry.LastModified;
+    ds << entry.Valid;
+    if (entry.Valid)
+    {
+        auto& info = entry.Info;
+        ds << info.Name;
+        ds << info.MonthsElapsed;
+        ds << info.NumGuests;
+        ds << info.Cash;
+        ds << info.ParkRating;
+        ds << info.ObjectiveType;
+        ds << info.ObjectiveYear;
+        ds << info.ObjectiveNumGuests;
+        ds << info.ObjectiveCurrency;
+    }
+}
@@ -0,0 +1,78 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "ParkImporter.h"
+#include "common.h"
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class DataSerialiser;
+
+/**
+ * Remembers the details of park files by their path and modification time, so browsing a directory of parks only has to
+ * read the files that are new or have changed since they were last shown. Details that are not known yet are read on
+ * a background thread.
+ */
+class ParkInfoCache final
+{
+private:
+    struct Entry
+    {
+        uint64_t LastModified{};
+        bool Valid{};
+        ParkFileInfo Info;
+    };
+
+    std::string const _cachePath;
+    std::mutex _mutex;
+    std::unordered_map<std::string, Entry> _entries;
+    bool _changed{};
+    std::atomic<uint32_t> _revision{};
+    std::atomic_bool _cancelled{};
+    std::future<void> _readFuture;
+
+public:
+    explicit ParkInfoCache(const std::string& cachePath);
+    ~ParkInfoCache();
+
+    /**
+     * Returns the details of the park, if they have been read and the file has not changed since.
+     */
+    std::optional<ParkFileInfo> Get(const std::string& path, uint64_t lastModified);
+
+    /**
+     * Reads the details of each of the given parks that are not known yet on a background thread. Any files that have not
+     * been read from an earlier request are dropped.
+     */
+    void Request(std::vector<std::pair<std::string, uint64_t>> files);
+
+    /**
+     * Increases every time the details of a park have been read, so windows know when to redraw.
+     */
+    uint32_t GetRevision() const;
+
+    /**
+     * Writes the cache to disk if anything has been added to it.
+     */
+    void Save();
+
+private:
+    void Cancel();
+    void Load();
+    static void SerialiseEntry(DataSerialiser& ds, std::string& path, Entry& entry);
+};
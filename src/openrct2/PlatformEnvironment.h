@@ -59,6 +59,7 @@ namespace OpenRCT2
         CACHE_OBJECTS,           // Object repository cache (objects.idx).
         CACHE_TRACKS,            // Track repository cache (tracks.idx).
         CACHE_SCENARIOS,         // Scenario repository cache (scenarios.idx).
+        CACHE_PARKS,             // Park details cache for the load / save window (parks.idx).
         MP_DAT,                  // Mega Park data, Steam RCT1 only (\RCTdeluxe_install\Data\mp.dat)
         NETWORK_GROUPS,          // Server groups with permissions (groups.json).
         NETWORK_SERVERS,         // Saved servers (servers.cfg).
@@ -11,6 +11,7 @@
 
 #include "Context.h"
 #include "Game.h"
+#include "GameState.h"
 #include "GameStateSnapshots.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
@@ -24,6 +25,7 @@
 #include "actions/TrackPlaceAction.h"
 #include "config/Config.h"
 #include "core/DataSerialiser.h"
+#include "core/Memory.hpp"
 #include "core/Path.hpp"
 #include "management/NewsItem.h"
 #include "object/ObjectManager.h"
@@ -34,6 +36,7 @@
 #include "world/Sprite.h"
 #include "zlib.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -77,6 +80,16 @@ namespace OpenRCT2
         OpenRCT2::MemoryStream data;
     };
 
+    // The state of the park at a tick during the recording, so playback can start from there instead of from the start.
+    struct ReplayKeyframe
+    {
+        uint32_t tick = 0;
+        uint64_t uncompressedSize = 0;
+        OpenRCT2::MemoryStream parkData; // Compressed.
+        OpenRCT2::MemoryStream parkParams;
+        OpenRCT2::MemoryStream cheatData;
+    };
+
     struct ReplayRecordData
     {
         uint32_t magic;
@@ -94,15 +107,22 @@ namespace OpenRCT2
         std::vector<std::pair<uint32_t, rct_sprite_checksum>> checksums;
         uint32_t checksumIndex;
         OpenRCT2::MemoryStream gameStateSnapshots;
+        std::vector<ReplayKeyframe> keyframes;
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 4;
+        static constexpr uint16_t ReplayVersion = 5;
+        static constexpr uint16_t ReplayMinimumVersion = 4;
+        static constexpr uint16_t ReplayKeyframesVersion = 5;
         static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
         static constexpr int ReplayCompressionLevel = 9;
         static constexpr int NormalRecordingChecksumTicks = 1;
         static constexpr int SilentRecordingChecksumTicks = 40; // Same as network server
+        static constexpr uint32_t KeyframeTicks = 40 * 60 * 10;  // Every 10 minutes of game time.
+        static constexpr int KeyframeCompressionLevel = 1;
+        static constexpr uint32_t SegmentTicks = 40 * 60 * 60; // Every hour of game time.
+        static constexpr size_t SegmentMaxCommands = 20000;
 
         enum class ReplayMode
         {
@@ -173,6 +193,16 @@ namespace OpenRCT2
                     StopRecording();
                     return;
                 }
+
+                if (gCurrentTicks >= _nextKeyframeTick)
+                {
+                    AddKeyframe();
+                }
+
+                if (ShouldStartNewSegment())
+                {
+                    StartNewSegment();
+                }
             }
             else if (_mode == ReplayMode::PLAYING)
             {
@@ -242,23 +272,10 @@ namespace OpenRCT2
 
             replayData->filePath = name;
 
-            auto context = GetContext();
-            auto& objManager = context->GetObjectManager();
-            auto objects = objManager.GetPackableObjects();
-
-            auto s6exporter = std::make_unique<S6Exporter>();
-            s6exporter->ExportObjectsList = objects;
-            s6exporter->Export();
-            s6exporter->SaveGame(&replayData->parkData);
+            SaveParkState(replayData->parkData, replayData->parkParams, replayData->cheatData);
 
             replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
 
-            DataSerialiser parkParamsDs(true, replayData->parkParams);
-            SerialiseParkParameters(parkParamsDs);
-
-            DataSerialiser cheatDataDs(true, replayData->cheatData);
-            SerialiseCheats(cheatDataDs);
-
             TakeGameStateSnapshot(replayData->gameStateSnapshots);
 
             if (_mode != ReplayMode::NORMALISATION)
@@ -267,6 +284,8 @@ namespace OpenRCT2
             _currentRecording = std::move(replayData);
             _recordType = rt;
             _nextChecksumTick = gCurrentTicks + 1;
+            _nextKeyframeTick = gCurrentTicks + KeyframeTicks;
+            _segmentIndex = 0;
 
             return true;
         }
@@ -283,57 +302,8 @@ namespace OpenRCT2
                 return true;
             }
 
-            _currentRecording->tickEnd = gCurrentTicks;
-
-            {
-                rct_sprite_checksum checksum = sprite_checksum();
-                AddChecksum(gCurrentTicks, std::move(checksum));
-            }
-
-            TakeGameStateSnapshot(_currentRecording->gameStateSnapshots);
-
-            // Serialise Body.
-            DataSerialiser recSerialiser(true);
-            Serialise(recSerialiser, *_currentRecording);
-
-            const auto& stream = recSerialiser.GetStream();
-            unsigned long streamLength = static_cast<unsigned long>(stream.GetLength());
-            unsigned long compressLength = compressBound(streamLength);
-
-            MemoryStream data(compressLength);
-
-            ReplayRecordFile file{ _currentRecording->magic, _currentRecording->version, streamLength, data };
-
-            auto compressBuf = std::make_unique<unsigned char[]>(compressLength);
-            compress2(
-                compressBuf.get(), &compressLength, static_cast<const unsigned char*>(stream.GetData()), stream.GetLength(),
-                ReplayCompressionLevel);
-            file.data.Write(compressBuf.get(), compressLength);
-
-            DataSerialiser fileSerialiser(true);
-            fileSerialiser << file.magic;
-            fileSerialiser << file.version;
-            fileSerialiser << file.uncompressedSize;
-            fileSerialiser << file.data;
-
-            bool result = false;
-
-            const std::string& outFile = _currentRecording->filePath;
-
-            FILE* fp = fopen(outFile.c_str(), "wb");
-            if (fp)
-            {
-                const auto& fileStream = fileSerialiser.GetStream();
-                fwrite(fileStream.GetData(), 1, fileStream.GetLength(), fp);
-                fclose(fp);
-
-                result = true;
-            }
-            else
-            {
-                log_error("Unable to write to file '%s'", outFile.c_str());
-                result = false;
-            }
+            FinishRecording(*_currentRecording);
+            bool result = WriteRecording(*_currentRecording, _currentRecording->filePath);
 
             // When normalizing the output we don't touch the mode.
             if (_mode != ReplayMode::NORMALISATION)
@@ -406,6 +376,8 @@ namespace OpenRCT2
 
                     std::string outputFile = Path::Combine(outputPath, uniqueFileName);
                     snapshots->LogCompareDataToFile(outputFile, cmpData);
+
+                    _playbackDifferences += snapshots->GetCompareDataText(cmpData);
                 }
             }
             catch (const std::runtime_error& err)
@@ -414,7 +386,7 @@ namespace OpenRCT2
             }
         }
 
-        virtual bool StartPlayback(const std::string& file) override
+        virtual bool StartPlayback(const std::string& file, uint32_t tick /*= 0*/) override
         {
             if (_mode != ReplayMode::NONE && _mode != ReplayMode::NORMALISATION)
                 return false;
@@ -435,10 +407,25 @@ namespace OpenRCT2
 
             gCurrentTicks = replayData->tickStart;
 
+            _playbackDifferences.clear();
             LoadAndCompareSnapshot(replayData->gameStateSnapshots);
 
+            uint32_t targetTick = replayData->tickStart + std::min(tick, replayData->tickEnd - replayData->tickStart);
+            if (targetTick != gCurrentTicks && !LoadKeyframe(*replayData, targetTick))
+            {
+                log_error("Unable to load keyframe.");
+                return false;
+            }
+
+            // Skip the checksums of the ticks that were skipped by starting from a keyframe.
+            replayData->checksumIndex = 0;
+            while (replayData->checksumIndex < replayData->checksums.size()
+                   && replayData->checksums[replayData->checksumIndex].first < gCurrentTicks)
+            {
+                replayData->checksumIndex++;
+            }
+
             _currentReplay = std::move(replayData);
-            _currentReplay->checksumIndex = 0;
             _faultyChecksumIndex = -1;
 
             // Make sure game is not paused.
@@ -447,6 +434,11 @@ namespace OpenRCT2
             if (_mode != ReplayMode::NORMALISATION)
                 _mode = ReplayMode::PLAYING;
 
+            if (gCurrentTicks < targetTick)
+            {
+                FastForward(targetTick);
+            }
+
             return true;
         }
 
@@ -455,6 +447,16 @@ namespace OpenRCT2
             return _faultyChecksumIndex != -1;
         }
 
+        virtual uint32_t GetPlaybackMismatchTick() const override
+        {
+            return _faultyChecksumTick;
+        }
+
+        virtual const std::string& GetPlaybackStateDifferences() const override
+        {
+            return _playbackDifferences;
+        }
+
         virtual bool StopPlayback() override
         {
             if (_mode != ReplayMode::PLAYING && _mode != ReplayMode::NORMALISATION)
@@ -484,7 +486,7 @@ namespace OpenRCT2
         {
             _mode = ReplayMode::NORMALISATION;
 
-            if (!StartPlayback(file))
+            if (!StartPlayback(file, 0))
             {
                 return false;
             }
@@ -501,6 +503,89 @@ namespace OpenRCT2
         }
 
     private:
+        /**
+         * Ends the recording at the current tick, so it can be compared with the game state at the end during playback.
+         */
+        void FinishRecording(ReplayRecordData& data)
+        {
+            data.tickEnd = gCurrentTicks;
+            data.checksums.emplace_back(gCurrentTicks, sprite_checksum());
+            TakeGameStateSnapshot(data.gameStateSnapshots);
+        }
+
+        bool WriteRecording(ReplayRecordData& data, const std::string& outFile)
+        {
+            // Serialise Body.
+            DataSerialiser recSerialiser(true);
+            Serialise(recSerialiser, data);
+
+            const auto& stream = recSerialiser.GetStream();
+            unsigned long streamLength = static_cast<unsigned long>(stream.GetLength());
+            unsigned long compressLength = compressBound(streamLength);
+
+            // Compress straight into the buffer of the stream that is serialised, rather than copying it in afterwards.
+            auto compressBuf = Memory::Allocate<unsigned char>(compressLength);
+            compress2(
+                compressBuf, &compressLength, static_cast<const unsigned char*>(stream.GetData()), stream.GetLength(),
+                ReplayCompressionLevel);
+            MemoryStream compressed(
+                compressBuf, compressLength, MEMORY_ACCESS::READ | MEMORY_ACCESS::WRITE | MEMORY_ACCESS::OWNER);
+
+            ReplayRecordFile file{ data.magic, data.version, streamLength, std::move(compressed) };
+
+            DataSerialiser fileSerialiser(true);
+            fileSerialiser << file.magic;
+            fileSerialiser << file.version;
+            fileSerialiser << file.uncompressedSize;
+            fileSerialiser << file.data;
+
+            FILE* fp = fopen(outFile.c_str(), "wb");
+            if (fp == nullptr)
+            {
+                log_error("Unable to write to file '%s'", outFile.c_str());
+                return false;
+            }
+
+            const auto& fileStream = fileSerialiser.GetStream();
+            fwrite(fileStream.GetData(), 1, fileStream.GetLength(), fp);
+            fclose(fp);
+            return true;
+        }
+
+        bool ShouldStartNewSegment() const
+        {
+            return gCurrentTicks - _currentRecording->tickStart >= SegmentTicks
+                || _currentRecording->commands.size() >= SegmentMaxCommands;
+        }
+
+        /**
+         * Writes what has been recorded so far to a file of its own and carries on recording from the current game state,
+         * so a long recording never holds more than one segment in memory. Every segment can be played back on its own.
+         * Silent recordings only keep the last finished segment, normal recordings keep all of them numbered in order.
+         */
+        void StartNewSegment()
+        {
+            auto segment = std::move(_currentRecording);
+            auto tickEnd = segment->tickEnd;
+
+            std::string suffix = _recordType == RecordType::SILENT ? "previous" : std::to_string(++_segmentIndex);
+            std::string segmentPath = Path::Combine(
+                Path::GetDirectory(segment->filePath),
+                Path::GetFileNameWithoutExtension(segment->filePath) + "." + suffix + ".sv6r");
+
+            FinishRecording(*segment);
+            if (WriteRecording(*segment, segmentPath))
+            {
+                log_verbose("Replay segment written to '%s'", segmentPath.c_str());
+            }
+
+            auto segmentIndex = _segmentIndex;
+            _mode = ReplayMode::NONE;
+            uint32_t maxTicks = tickEnd == k_MaxReplayTicks ? k_MaxReplayTicks : tickEnd - gCurrentTicks;
+            StartRecording(segment->filePath, maxTicks, _recordType);
+            _segmentIndex = segmentIndex;
+        }
+
         int ChecksumTicksDelta() const
         {
             switch (_recordType)
@@ -513,17 +598,35 @@ namespace OpenRCT2
             }
         }
 
-        bool LoadReplayDataMap(ReplayRecordData& data)
+        void SaveParkState(MemoryStream& parkData, MemoryStream& parkParams, MemoryStream& cheatData)
+        {
+            auto context = GetContext();
+            auto& objManager = context->GetObjectManager();
+            auto objects = objManager.GetPackableObjects();
+
+            auto s6exporter = std::make_unique<S6Exporter>();
+            s6exporter->ExportObjectsList = objects;
+            s6exporter->Export();
+            s6exporter->SaveGame(&parkData);
+
+            DataSerialiser parkParamsDs(true, parkParams);
+            SerialiseParkParameters(parkParamsDs);
+
+            DataSerialiser cheatDataDs(true, cheatData);
+            SerialiseCheats(cheatDataDs);
+        }
+
+        bool LoadParkState(MemoryStream& parkData, MemoryStream& parkParams, MemoryStream& cheatData)
         {
             try
             {
-                data.parkData.SetPosition(0);
+                parkData.SetPosition(0);
 
                 auto context = GetContext();
                 auto& objManager = context->GetObjectManager();
                 auto importer = ParkImporter::CreateS6(context->GetObjectRepository());
 
-                auto loadResult = importer->LoadFromStream(&data.parkData, false);
+                auto loadResult = importer->LoadFromStream(&parkData, false);
                 objManager.LoadObjects(loadResult.RequiredObjects.data(), loadResult.RequiredObjects.size());
 
                 importer->Import();
@@ -531,13 +634,15 @@ namespace OpenRCT2
                 EntityTweener::Get().Reset();
 
                 // Load all map global variables.
-                DataSerialiser parkParamsDs(false, data.parkParams);
+                parkParams.SetPosition(0);
+                DataSerialiser parkParamsDs(false, parkParams);
                 SerialiseParkParameters(parkParamsDs);
 
                 // New cheats might not be serialised, make sure they are using their defaults.
                 CheatsReset();
 
-                DataSerialiser cheatDataDs(false, data.cheatData);
+                cheatData.SetPosition(0);
+                DataSerialiser cheatDataDs(false, cheatData);
                 SerialiseCheats(cheatDataDs);
 
                 game_load_init();
@@ -551,6 +656,93 @@ namespace OpenRCT2
             return true;
         }
 
+        bool LoadReplayDataMap(ReplayRecordData& data)
+        {
+            return LoadParkState(data.parkData, data.parkParams, data.cheatData);
+        }
+
+        void AddKeyframe()
+        {
+            // Game actions recorded for this tick have already changed the park, so they would be replayed twice from a
+            // keyframe taken now. Try again on the next tick instead.
+            auto& commands = _currentRecording->commands;
+            if (!commands.empty() && commands.rbegin()->tick >= gCurrentTicks)
+                return;
+
+            ReplayKeyframe keyframe;
+            keyframe.tick = gCurrentTicks;
+
+            MemoryStream parkData;
+            SaveParkState(parkData, keyframe.parkParams, keyframe.cheatData);
+
+            // Keyframes are kept in memory for the whole recording, so they are compressed straight away.
+            unsigned long parkDataLength = static_cast<unsigned long>(parkData.GetLength());
+            unsigned long compressLength = compressBound(parkDataLength);
+            auto compressBuf = Memory::Allocate<unsigned char>(compressLength);
+            compress2(
+                compressBuf, &compressLength, static_cast<const unsigned char*>(parkData.GetData()), parkDataLength,
+                KeyframeCompressionLevel);
+            keyframe.uncompressedSize = parkDataLength;
+            keyframe.parkData = MemoryStream(
+                compressBuf, compressLength, MEMORY_ACCESS::READ | MEMORY_ACCESS::WRITE | MEMORY_ACCESS::OWNER);
+
+            _currentRecording->keyframes.push_back(std::move(keyframe));
+            _nextKeyframeTick = gCurrentTicks + KeyframeTicks;
+        }
+
+        /**
+         * Loads the last keyframe at or before the given tick, if there is one, and drops the game actions before it.
+         * Returns false if the keyframe could not be loaded.
+         */
+        bool LoadKeyframe(ReplayRecordData& data, uint32_t tick)
+        {
+            auto it = std::find_if(data.keyframes.rbegin(), data.keyframes.rend(), [tick](const ReplayKeyframe& keyframe) {
+                return keyframe.tick <= tick;
+            });
+            if (it == data.keyframes.rend())
+                return true;
+
+            auto& keyframe = *it;
+            auto buff = Memory::Allocate<unsigned char>(keyframe.uncompressedSize);
+            unsigned long outSize = static_cast<unsigned long>(keyframe.uncompressedSize);
+            uncompress(
+                buff, &outSize, static_cast<const unsigned char*>(keyframe.parkData.GetData()),
+                static_cast<unsigned long>(keyframe.parkData.GetLength()));
+            if (outSize != keyframe.uncompressedSize)
+            {
+                Memory::Free(buff);
+                return false;
+            }
+            MemoryStream parkData(buff, outSize, MEMORY_ACCESS::READ | MEMORY_ACCESS::WRITE | MEMORY_ACCESS::OWNER);
+
+            if (!LoadParkState(parkData, keyframe.parkParams, keyframe.cheatData))
+                return false;
+
+            gCurrentTicks = keyframe.tick;
+
+            auto& commands = data.commands;
+            commands.erase(
+                commands.begin(), std::find_if(commands.begin(), commands.end(), [&keyframe](const ReplayCommand& command) {
+                    return command.tick >= keyframe.tick;
+                }));
+            return true;
+        }
+
+        /**
+         * Runs the game logic as fast as possible until the given tick without drawing anything in between.
+         */
+        void FastForward(uint32_t tick)
+        {
+            auto* gameState = GetContext()->GetGameState();
+
+            _fastForwarding = true;
+            while (_mode == ReplayMode::PLAYING && gCurrentTicks < tick && _faultyChecksumIndex == -1)
+            {
+                gameState->UpdateLogic();
+            }
+            _fastForwarding = false;
+        }
+
         bool ReadReplayFromFile(const std::string& file, MemoryStream& stream)
         {
             FILE* fp = fopen(file.c_str(), "rb");
@@ -588,17 +780,16 @@ namespace OpenRCT2
                 fileSerializer << recFile.uncompressedSize;
                 fileSerializer << recFile.data;
 
-                auto buff = std::make_unique<unsigned char[]>(recFile.uncompressedSize);
+                auto buff = Memory::Allocate<unsigned char>(recFile.uncompressedSize);
                 unsigned long outSize = recFile.uncompressedSize;
-                uncompress(
-                    static_cast<unsigned char*>(buff.get()), &outSize,
-                    static_cast<const unsigned char*>(recFile.data.GetData()), recFile.data.GetLength());
+                uncompress(buff, &outSize, static_cast<const unsigned char*>(recFile.data.GetData()), recFile.data.GetLength());
                 if (outSize != recFile.uncompressedSize)
                 {
+                    Memory::Free(buff);
                     return false;
                 }
-                stream.SetPosition(0);
-                stream.Write(buff.get(), outSize);
+                // The stream takes ownership of the decompressed data instead of copying it.
+                stream = MemoryStream(buff, outSize, MEMORY_ACCESS::READ | MEMORY_ACCESS::WRITE | MEMORY_ACCESS::OWNER);
             }
 
             return true;
@@ -710,7 +901,7 @@ namespace OpenRCT2
 
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == ReplayVersion;
+            return data.version >= ReplayMinimumVersion && data.version <= ReplayVersion;
         }
 
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
@@ -783,6 +974,26 @@ namespace OpenRCT2
             }
 
             serialiser << data.gameStateSnapshots;
+
+            if (data.version >= ReplayKeyframesVersion)
+            {
+                uint32_t countKeyframes = static_cast<uint32_t>(data.keyframes.size());
+                serialiser << countKeyframes;
+
+                if (serialiser.IsLoading())
+                {
+                    data.keyframes.resize(countKeyframes);
+                }
+
+                for (auto& keyframe : data.keyframes)
+                {
+                    serialiser << keyframe.tick;
+                    serialiser << keyframe.uncompressedSize;
+                    serialiser << keyframe.parkData;
+                    serialiser << keyframe.parkParams;
+                    serialiser << keyframe.cheatData;
+                }
+            }
             return true;
         }
 
@@ -809,6 +1020,8 @@ namespace OpenRCT2
                         "Different sprite checksum at tick %u (Replay Tick: %u) ; Saved: %s, Current: %s", gCurrentTicks,
                         replayTick, savedChecksum.second.ToString().c_str(), checksum.ToString().c_str());
 
+                    if (_faultyChecksumIndex == -1)
+                        _faultyChecksumTick = gCurrentTicks;
                     _faultyChecksumIndex = checksumIndex;
                 }
                 else
@@ -856,8 +1069,8 @@ namespace OpenRCT2
                     isPositionValid = true;
                 }
 
-                // Focus camera on event.
-                if (isPositionValid && !result->Position.isNull())
+                // Focus camera on event, nothing is drawn while fast forwarding so it would only be wasted work.
+                if (isPositionValid && !result->Position.isNull() && !_fastForwarding)
                 {
                     auto* mainWindow = window_get_main();
                     if (mainWindow != nullptr)
@@ -873,9 +1086,14 @@ namespace OpenRCT2
         std::unique_ptr<ReplayRecordData> _currentRecording;
         std::unique_ptr<ReplayRecordData> _currentReplay;
         int32_t _faultyChecksumIndex = -1;
+        uint32_t _faultyChecksumTick = 0;
+        std::string _playbackDifferences;
         uint32_t _commandId = 0;
         uint32_t _nextChecksumTick = 0;
         uint32_t _nextReplayTick = 0;
+        uint32_t _nextKeyframeTick = 0;
+        uint32_t _segmentIndex = 0;
+        bool _fastForwarding = false;
         RecordType _recordType = RecordType::NORMAL;
     };
 
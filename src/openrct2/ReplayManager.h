@@ -58,8 +58,24 @@ namespace OpenRCT2
         virtual bool StopRecording(bool discard = false) = 0;
         virtual bool GetCurrentReplayInfo(ReplayRecordInfo& info) const = 0;
 
-        virtual bool StartPlayback(const std::string& file) = 0;
+        /**
+         * Starts playing the replay back. When a tick is given, playback starts from the closest keyframe before that many
+         * ticks into the replay and runs ahead to it without drawing.
+         */
+        virtual bool StartPlayback(const std::string& file, uint32_t tick = 0) = 0;
         virtual bool IsPlaybackStateMismatching() const = 0;
+
+        /**
+         * The tick of the first checksum that did not match during the last playback, only valid if the playback state was
+         * mismatching.
+         */
+        virtual uint32_t GetPlaybackMismatchTick() const = 0;
+
+        /**
+         * The entity differences between the recorded and the played back game state snapshots of the last playback,
+         * empty if they matched.
+         */
+        virtual const std::string& GetPlaybackStateDifferences() const = 0;
         virtual bool StopPlayback() = 0;
 
         virtual bool NormaliseReplay(const std::string& inputFile, const std::string& outputFile) = 0;
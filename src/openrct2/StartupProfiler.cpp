@@ -0,0 +1,56 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "StartupProfiler.h"
+
+#include "core/Console.hpp"
+#include "platform/Platform2.h"
+
+using namespace OpenRCT2;
+
+void StartupProfiler::Begin(bool enabled)
+{
+    _enabled = enabled;
+    _phases.clear();
+    if (_enabled)
+    {
+        _phaseStart = Clock::now();
+        _phaseBytesRead = Platform::GetProcessBytesRead();
+    }
+}
+
+void StartupProfiler::EndPhase(const char* name)
+{
+    if (!_enabled)
+        return;
+
+    auto now = Clock::now();
+    auto bytesRead = Platform::GetProcessBytesRead();
+    _phases.push_back({ name, now - _phaseStart, bytesRead - _phaseBytesRead });
+    _phaseStart = now;
+    _phaseBytesRead = bytesRead;
+}
+
+void StartupProfiler::Report() const
+{
+    if (!_enabled)
+        return;
+
+    auto totalDuration = std::chrono::duration<double, std::milli>::zero();
+    uint64_t totalBytesRead = 0;
+    Console::WriteLine("Startup profile:");
+    Console::WriteLine("  %-32s %10s %12s", "Phase", "Time (ms)", "Read (KiB)");
+    for (const auto& phase : _phases)
+    {
+        Console::WriteLine("  %-32s %10.2f %12.1f", phase.Name, phase.Duration.count(), phase.BytesRead / 1024.0);
+        totalDuration += phase.Duration;
+        totalBytesRead += phase.BytesRead;
+    }
+    Console::WriteLine("  %-32s %10.2f %12.1f", "Total", totalDuration.count(), totalBytesRead / 1024.0);
+}
@@ -0,0 +1,45 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+#include <chrono>
+#include <vector>
+
+namespace OpenRCT2
+{
+    /**
+     * Records how long each phase of the context initialisation takes and how many bytes the process read from files
+     * during it. Phases follow each other, a phase ends when the next one is started.
+     */
+    class StartupProfiler
+    {
+    private:
+        using Clock = std::chrono::high_resolution_clock;
+
+        struct Phase
+        {
+            const char* Name;
+            std::chrono::duration<double, std::milli> Duration;
+            uint64_t BytesRead;
+        };
+
+        bool _enabled{};
+        std::vector<Phase> _phases;
+        Clock::time_point _phaseStart;
+        uint64_t _phaseBytesRead{};
+
+    public:
+        void Begin(bool enabled);
+        void EndPhase(const char* name);
+        void Report() const;
+    };
+} // namespace OpenRCT2
@@ -47,7 +47,7 @@ private:
      * Function to clear the flag that is set to prevent cost duplication
      * when using the clear scenery tool with large scenery.
      */
-    static void ResetClearLargeSceneryFlag();
+    static void ResetClearLargeSceneryFlag(const MapRange& range);
 
     static bool MapCanClearAt(const CoordsXY& location);
 };
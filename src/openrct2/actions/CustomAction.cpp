@@ -13,9 +13,10 @@
 #    include "../Context.h"
 #    include "../scripting/ScriptEngine.h"
 
-CustomAction::CustomAction(const std::string& id, const std::string& json)
+CustomAction::CustomAction(const std::string& id, const std::string& json, bool isBatch)
     : _id(id)
     , _json(json)
+    , _isBatch(isBatch)
 {
 }
 
@@ -29,6 +30,11 @@ std::string CustomAction::GetJson() const
     return _json;
 }
 
+bool CustomAction::IsBatch() const
+{
+    return _isBatch;
+}
+
 uint16_t CustomAction::GetActionFlags() const
 {
     return GameAction::GetActionFlags() | GameActions::Flags::AllowWhilePaused;
@@ -37,19 +43,19 @@ uint16_t CustomAction::GetActionFlags() const
 void CustomAction::Serialise(DataSerialiser& stream)
 {
     GameAction::Serialise(stream);
-    stream << DS_TAG(_id) << DS_TAG(_json);
+    stream << DS_TAG(_id) << DS_TAG(_json) << DS_TAG(_isBatch);
 }
 
 GameActions::Result::Ptr CustomAction::Query() const
 {
     auto& scriptingEngine = OpenRCT2::GetContext()->GetScriptEngine();
-    return scriptingEngine.QueryOrExecuteCustomGameAction(_id, _json, false);
+    return scriptingEngine.QueryOrExecuteCustomGameAction(_id, _json, false, _isBatch);
 }
 
 GameActions::Result::Ptr CustomAction::Execute() const
 {
     auto& scriptingEngine = OpenRCT2::GetContext()->GetScriptEngine();
-    return scriptingEngine.QueryOrExecuteCustomGameAction(_id, _json, true);
+    return scriptingEngine.QueryOrExecuteCustomGameAction(_id, _json, true, _isBatch);
 }
 
 #endif
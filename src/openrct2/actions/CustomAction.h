@@ -18,14 +18,20 @@ DEFINE_GAME_ACTION(CustomAction, GameCommand::Custom, GameActions::Result)
 private:
     std::string _id;
     std::string _json;
+    bool _isBatch{};
 
 public:
     CustomAction() = default;
-    CustomAction(const std::string& id, const std::string& json);
+    CustomAction(const std::string& id, const std::string& json, bool isBatch = false);
 
     std::string GetId() const;
     std::string GetJson() const;
 
+    /**
+     * Whether the JSON is an array of arguments, each of which is passed to the plug-in's handler in turn.
+     */
+    bool IsBatch() const;
+
     uint16_t GetActionFlags() const override;
 
     void Serialise(DataSerialiser & stream) override;
@@ -93,7 +93,12 @@ GameActions::Result::Ptr FootpathPlaceFromTrackAction::Execute() const
     // Force ride construction to recheck area
     _currentTrackSelectionFlags |= TRACK_SELECTION_FLAG_RECHECK;
 
-    return ElementInsertExecute(std::move(res));
+    res = ElementInsertExecute(std::move(res));
+    if (res->Error == GameActions::Status::Ok && !(GetFlags() & GAME_COMMAND_FLAG_GHOST))
+    {
+        footpath_update_path_wide_flags_around(_loc);
+    }
+    return res;
 }
 
 GameActions::Result::Ptr FootpathPlaceFromTrackAction::ElementInsertQuery(GameActions::Result::Ptr res) const
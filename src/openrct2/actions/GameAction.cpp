@@ -23,12 +23,16 @@
 #include "../scripting/ScriptEngine.h"
 #include "../ui/UiContext.h"
 #include "../ui/WindowManager.h"
+#include "../world/Map.h"
 #include "../world/MoneyEffect.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 
 #include <algorithm>
+#include <chrono>
+#include <deque>
 #include <iterator>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -83,36 +87,104 @@ namespace GameActions
         return message;
     }
 
-    struct QueuedGameAction
+    /**
+     * Actions waiting to be run, in order of their tick and then the order they were queued in. There is one bucket of
+     * actions per tick, which are almost always added at the back and taken from the front. The storage of emptied
+     * buckets is kept for later ticks, so bursts of actions do not keep allocating.
+     */
+    class GameActionQueue
     {
-        uint32_t tick;
-        uint32_t uniqueId;
-        GameAction::Ptr action;
+    private:
+        static constexpr size_t MaxSpareBuckets = 16;
 
-        explicit QueuedGameAction(uint32_t t, std::unique_ptr<GameAction>&& ga, uint32_t id)
-            : tick(t)
-            , uniqueId(id)
-            , action(std::move(ga))
+        struct TickBucket
         {
+            uint32_t Tick{};
+            size_t Next{};
+            std::vector<GameAction::Ptr> Actions;
+        };
+
+        std::deque<TickBucket> _buckets;
+        std::vector<std::vector<GameAction::Ptr>> _spareActions;
+
+    public:
+        bool IsEmpty() const
+        {
+            return _buckets.empty();
+        }
+
+        uint32_t GetFrontTick() const
+        {
+            return _buckets.front().Tick;
         }
 
-        bool operator<(const QueuedGameAction& comp) const
+        const GameAction* GetFront() const
         {
-            // First sort by tick
-            if (tick < comp.tick)
-                return true;
-            if (tick > comp.tick)
-                return false;
-
-            // If the ticks are equal sort by commandIndex
-            return uniqueId < comp.uniqueId;
+            const auto& bucket = _buckets.front();
+            return bucket.Actions[bucket.Next].get();
+        }
+
+        void Push(uint32_t tick, GameAction::Ptr&& action)
+        {
+            auto it = _buckets.end();
+            while (it != _buckets.begin() && std::prev(it)->Tick > tick)
+            {
+                --it;
+            }
+
+            if (it != _buckets.begin() && std::prev(it)->Tick == tick)
+            {
+                std::prev(it)->Actions.push_back(std::move(action));
+                return;
+            }
+
+            TickBucket bucket;
+            bucket.Tick = tick;
+            if (!_spareActions.empty())
+            {
+                bucket.Actions = std::move(_spareActions.back());
+                _spareActions.pop_back();
+            }
+            bucket.Actions.push_back(std::move(action));
+            _buckets.insert(it, std::move(bucket));
+        }
+
+        GameAction::Ptr Pop()
+        {
+            auto& bucket = _buckets.front();
+            auto action = std::move(bucket.Actions[bucket.Next++]);
+            if (bucket.Next == bucket.Actions.size())
+            {
+                RecycleFront();
+            }
+            return action;
+        }
+
+        void Clear()
+        {
+            while (!_buckets.empty())
+            {
+                RecycleFront();
+            }
+        }
+
+    private:
+        void RecycleFront()
+        {
+            auto& actions = _buckets.front().Actions;
+            if (_spareActions.size() < MaxSpareBuckets)
+            {
+                actions.clear();
+                _spareActions.push_back(std::move(actions));
+            }
+            _buckets.pop_front();
         }
     };
 
     static GameActionFactory _actions[EnumValue(GameCommand::Count)];
-    static std::multiset<QueuedGameAction> _actionQueue;
-    static uint32_t _nextUniqueId = 0;
+    static GameActionQueue _actionQueue;
     static bool _suspended = false;
+    static ActionStats _stats[EnumValue(GameCommand::Count)];
 
     GameActionFactory Register(GameCommand id, GameActionFactory factory)
     {
@@ -134,6 +206,25 @@ namespace GameActions
         return false;
     }
 
+    const ActionStats& GetStats(GameCommand id)
+    {
+        const auto idx = static_cast<size_t>(id);
+        Guard::Assert(idx < std::size(_stats));
+        return _stats[idx];
+    }
+
+    void ResetStats()
+    {
+        std::fill(std::begin(_stats), std::end(_stats), ActionStats{});
+    }
+
+    static ActionStats& GetStatsForAction(const GameAction* action)
+    {
+        auto& stats = _stats[EnumValue(action->GetType())];
+        stats.Name = action->GetName();
+        return stats;
+    }
+
     void SuspendQueue()
     {
         _suspended = true;
@@ -158,7 +249,7 @@ namespace GameActions
             // as that normally happens when receiving them over network.
             ga->SetPlayer(network_get_current_player_id());
         }
-        _actionQueue.emplace(tick, std::move(ga), _nextUniqueId++);
+        _actionQueue.Push(tick, std::move(ga));
     }
 
     void ProcessQueue()
@@ -171,31 +262,34 @@ namespace GameActions
 
         const uint32_t currentTick = gCurrentTicks;
 
-        while (_actionQueue.begin() != _actionQueue.end())
+        while (!_actionQueue.IsEmpty())
         {
             // run all the game commands at the current tick
-            const QueuedGameAction& queued = *_actionQueue.begin();
+            const uint32_t queuedTick = _actionQueue.GetFrontTick();
 
             if (network_get_mode() == NETWORK_MODE_CLIENT)
             {
-                if (queued.tick < currentTick)
+                if (queuedTick < currentTick)
                 {
                     // This should never happen.
+                    const GameAction* queuedAction = _actionQueue.GetFront();
                     Guard::Assert(
                         false,
-                        "Discarding game action %s (%u) from tick behind current tick, ID: %08X, Action Tick: %08X, Current "
-                        "Tick: "
+                        "Discarding game action %s (%u) from tick behind current tick, Action Tick: %08X, Current Tick: "
                         "%08X\n",
-                        queued.action->GetName(), queued.action->GetType(), queued.uniqueId, queued.tick, currentTick);
+                        queuedAction->GetName(), queuedAction->GetType(), queuedTick, currentTick);
                 }
-                else if (queued.tick > currentTick)
+                else if (queuedTick > currentTick)
                 {
                     return;
                 }
             }
 
+            // Taken off the queue before it runs, as running it may queue more actions.
+            GameAction::Ptr queued = _actionQueue.Pop();
+
             // Remove ghost scenery so it doesn't interfere with incoming network command
-            switch (queued.action->GetType())
+            switch (queued->GetType())
             {
                 case GameCommand::PlaceWall:
                 case GameCommand::PlaceLargeScenery:
@@ -207,7 +301,7 @@ namespace GameActions
                     break;
             }
 
-            GameAction* action = queued.action.get();
+            GameAction* action = queued.get();
             action->SetFlags(action->GetFlags() | GAME_COMMAND_FLAG_NETWORKED);
 
             Guard::Assert(action != nullptr);
@@ -218,14 +312,12 @@ namespace GameActions
                 // Relay this action to all other clients.
                 network_send_game_action(action);
             }
-
-            _actionQueue.erase(_actionQueue.begin());
         }
     }
 
     void ClearQueue()
     {
-        _actionQueue.clear();
+        _actionQueue.Clear();
     }
 
     void Initialize()
@@ -306,7 +398,14 @@ namespace GameActions
             return result;
         }
 
+        auto startTime = std::chrono::high_resolution_clock::now();
         auto result = action->Query();
+        std::chrono::nanoseconds queryTime = std::chrono::high_resolution_clock::now() - startTime;
+
+        auto& stats = GetStatsForAction(action);
+        stats.NumQueries++;
+        stats.TotalQueryTime += queryTime;
+        stats.MaxQueryTime = std::max(stats.MaxQueryTime, queryTime);
 
         if (result->Error == GameActions::Status::Ok)
         {
@@ -453,7 +552,17 @@ namespace GameActions
             LogActionBegin(logContext, action);
 
             // Execute the action, changing the game state
+            auto tileChangesBefore = map_get_tile_change_count();
+            auto startTime = std::chrono::high_resolution_clock::now();
             result = action->Execute();
+            std::chrono::nanoseconds executeTime = std::chrono::high_resolution_clock::now() - startTime;
+            map_on_all_tiles_changed();
+
+            auto& stats = GetStatsForAction(action);
+            stats.NumExecutes++;
+            stats.TotalExecuteTime += executeTime;
+            stats.MaxExecuteTime = std::max(stats.MaxExecuteTime, executeTime);
+            stats.TilesChanged += map_get_tile_change_count() - tileChangesBefore;
 #ifdef ENABLE_SCRIPTING
             if (result->Error == GameActions::Status::Ok)
             {
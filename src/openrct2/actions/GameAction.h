@@ -17,6 +17,7 @@
 #include "../world/Map.h"
 
 #include <array>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -413,6 +414,26 @@ namespace GameActions
 
     GameActionFactory Register(GameCommand id, GameActionFactory action);
 
+    /**
+     * How long one type of action has spent being queried and executed since the stats were last reset, and how many
+     * tiles it changed. Actions run from within other actions are counted as well, so they are also part of the totals of
+     * the action that ran them.
+     */
+    struct ActionStats
+    {
+        const char* Name{};
+        uint64_t NumQueries{};
+        std::chrono::nanoseconds TotalQueryTime{};
+        std::chrono::nanoseconds MaxQueryTime{};
+        uint64_t NumExecutes{};
+        std::chrono::nanoseconds TotalExecuteTime{};
+        std::chrono::nanoseconds MaxExecuteTime{};
+        uint64_t TilesChanged{};
+    };
+
+    const ActionStats& GetStats(GameCommand id);
+    void ResetStats();
+
     template<typename T> static GameActionFactory Register()
     {
         GameActionFactory factory = []() -> GameAction* { return new T(); };
@@ -89,6 +89,7 @@ GameActions::Result::Ptr LandSetRightsAction::QueryExecute(bool isExecuting) con
     }
 
     // Game command modified to accept selection size
+    MapInvalidationBatch invalidationBatch;
     for (auto y = validRange.GetTop(); y <= validRange.GetBottom(); y += COORDS_XY_STEP)
     {
         for (auto x = validRange.GetLeft(); x <= validRange.GetRight(); x += COORDS_XY_STEP)
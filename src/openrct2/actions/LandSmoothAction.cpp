@@ -52,6 +52,8 @@ GameActions::Result::Ptr LandSmoothAction::Query() const
 
 GameActions::Result::Ptr LandSmoothAction::Execute() const
 {
+    // The changed tiles are redrawn as one area rather than tile by tile.
+    MapInvalidationBatch invalidationBatch;
     return SmoothLand(true);
 }
 
@@ -148,7 +148,7 @@ GameActions::Result::Ptr RideDemolishAction::DemolishRide(Ride* ride) const
         uint8_t ride_id_offset = _rideIndex / 8;
 
         // clear ride from potentially being in RidesBeenOn
-        peep->RidesBeenOn[ride_id_offset] &= ~(1 << ride_id_bit);
+        peep->GetRidesBeenOn()[ride_id_offset] &= ~(1 << ride_id_bit);
         if (peep->State == PeepState::Watching)
         {
             if (peep->CurrentRide == _rideIndex)
@@ -210,19 +210,20 @@ GameActions::Result::Ptr RideDemolishAction::DemolishRide(Ride* ride) const
             peep->FavouriteRide = RIDE_ID_NULL;
         }
 
+        auto& thoughts = peep->GetThoughts();
         for (int32_t i = 0; i < PEEP_MAX_THOUGHTS; i++)
         {
             // Don't touch items after the first NONE thought as they are not valid
             // fixes issues with clearing out bad thought data in multiplayer
-            if (peep->Thoughts[i].type == PeepThoughtType::None)
+            if (thoughts[i].type == PeepThoughtType::None)
                 break;
 
-            if (peep->Thoughts[i].type != PeepThoughtType::None && peep->Thoughts[i].item == _rideIndex)
+            if (thoughts[i].type != PeepThoughtType::None && thoughts[i].item == _rideIndex)
             {
                 // Clear top thought, push others up
-                memmove(&peep->Thoughts[i], &peep->Thoughts[i + 1], sizeof(rct_peep_thought) * (PEEP_MAX_THOUGHTS - i - 1));
-                peep->Thoughts[PEEP_MAX_THOUGHTS - 1].type = PeepThoughtType::None;
-                peep->Thoughts[PEEP_MAX_THOUGHTS - 1].item = PEEP_THOUGHT_ITEM_NONE;
+                memmove(&thoughts[i], &thoughts[i + 1], sizeof(rct_peep_thought) * (PEEP_MAX_THOUGHTS - i - 1));
+                thoughts[PEEP_MAX_THOUGHTS - 1].type = PeepThoughtType::None;
+                thoughts[PEEP_MAX_THOUGHTS - 1].item = PEEP_THOUGHT_ITEM_NONE;
                 // Next iteration, check the new thought at this index
                 i--;
             }
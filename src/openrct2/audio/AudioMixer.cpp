@@ -70,7 +70,7 @@ void* Mixer_Play_Effect(SoundId id, int32_t loop, int32_t volume, float pan, dou
 void Mixer_Stop_Channel(void* channel)
 {
     auto mixer = GetMixer();
-    if (mixer != nullptr)
+    if (mixer != nullptr && channel != nullptr)
     {
         mixer->Stop(static_cast<IAudioChannel*>(channel));
     }
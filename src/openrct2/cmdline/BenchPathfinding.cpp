@@ -0,0 +1,258 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../Game.h"
+#    include "../Intro.h"
+#    include "../OpenRCT2.h"
+#    include "../peep/GuestPathfinding.h"
+#    include "../peep/Peep.h"
+#    include "../platform/Platform2.h"
+#    include "../scenario/Scenario.h"
+#    include "../world/EntityList.h"
+#    include "../world/Map.h"
+
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+/**
+ * A copy of a guest taken before the benchmark, the pathfinding changes the guests it is run for.
+ */
+struct GuestSnapshot
+{
+    Guest* Target;
+    Guest Saved;
+    GuestColdData SavedColdData;
+};
+
+static std::unique_ptr<IContext> LoadParkForPathfinding(benchmark::State& state, const std::string& filename)
+{
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        state.SkipWithError("Context initialization failed.");
+        return nullptr;
+    }
+    if (!context->LoadParkFromFile(filename))
+    {
+        state.SkipWithError("Failed to load file!");
+        return nullptr;
+    }
+
+    gIntroState = IntroState::None;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+    return context;
+}
+
+/**
+ * Takes a snapshot of the walking guests in the park, which are the ones that look for a new direction at junctions.
+ */
+static std::vector<GuestSnapshot> GetWalkingGuests(bool withGoalOnly)
+{
+    std::vector<GuestSnapshot> guests;
+    for (auto* guest : EntityList<Guest>())
+    {
+        if (guest->State != PeepState::Walking || guest->x == LOCATION_NULL || guest->GetNextIsSurface())
+            continue;
+        if (withGoalOnly && !direction_valid(guest->PathfindGoal.direction))
+            continue;
+
+        guests.push_back({ guest, *guest, guest->GetColdData() });
+    }
+    return guests;
+}
+
+static void RestoreGuests(const std::vector<GuestSnapshot>& guests)
+{
+    for (const auto& snapshot : guests)
+    {
+        *snapshot.Target = snapshot.Saved;
+        snapshot.Target->GetColdData() = snapshot.SavedColdData;
+    }
+}
+
+static void SetPathfindingCounters(benchmark::State& state, size_t numGuests)
+{
+    const auto& statistics = PathfindGetStatistics();
+    state.counters["guests"] = static_cast<double>(numGuests);
+    state.counters["junctions"] = benchmark::Counter(
+        static_cast<double>(statistics.Searches), benchmark::Counter::kAvgIterations);
+    state.counters["cached_junctions"] = benchmark::Counter(
+        static_cast<double>(statistics.CachedSearches), benchmark::Counter::kAvgIterations);
+    state.counters["tiles_checked"] = benchmark::Counter(
+        static_cast<double>(statistics.TilesChecked), benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * Times guest_path_finding for every walking guest, as if they had all arrived at the middle of their tile. When cold,
+ * the map is marked as changed before every iteration, so no search is remembered from the previous one.
+ */
+static void BM_guest_path_finding(benchmark::State& state, const std::string& filename, bool cold)
+{
+    auto context = LoadParkForPathfinding(state, filename);
+    if (context == nullptr)
+        return;
+
+    const auto guests = GetWalkingGuests(false);
+    const auto savedRand = scenario_rand_state();
+    PathfindResetStatistics();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        RestoreGuests(guests);
+        scenario_rand_seed(savedRand.s0, savedRand.s1);
+        if (cold)
+            map_on_all_tiles_changed();
+        PathfindResetTickBudget();
+        state.ResumeTiming();
+
+        for (const auto& snapshot : guests)
+        {
+            benchmark::DoNotOptimize(guest_path_finding(snapshot.Target));
+        }
+    }
+    RestoreGuests(guests);
+    scenario_rand_seed(savedRand.s0, savedRand.s1);
+
+    // Items per second is the number of decisions per second, its inverse is the time taken by each decision.
+    state.SetItemsProcessed(state.iterations() * guests.size());
+    SetPathfindingCounters(state, guests.size());
+}
+
+/**
+ * Times peep_pathfind_choose_direction for every walking guest that is heading somewhere, towards the goal they are
+ * currently heading for.
+ */
+static void BM_peep_pathfind_choose_direction(benchmark::State& state, const std::string& filename, bool cold)
+{
+    auto context = LoadParkForPathfinding(state, filename);
+    if (context == nullptr)
+        return;
+
+    const auto guests = GetWalkingGuests(true);
+    PathfindResetStatistics();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        RestoreGuests(guests);
+        if (cold)
+            map_on_all_tiles_changed();
+        PathfindResetTickBudget();
+        state.ResumeTiming();
+
+        for (const auto& snapshot : guests)
+        {
+            auto* guest = snapshot.Target;
+            gPeepPathFindGoalPosition = { guest->PathfindGoal.x, guest->PathfindGoal.y, guest->PathfindGoal.z };
+            gPeepPathFindIgnoreForeignQueues = true;
+            gPeepPathFindQueueRideIndex = guest->GuestHeadingToRideId;
+            benchmark::DoNotOptimize(peep_pathfind_choose_direction(TileCoordsXYZ{ guest->NextLoc }, guest));
+        }
+    }
+    RestoreGuests(guests);
+
+    state.SetItemsProcessed(state.iterations() * guests.size());
+    SetPathfindingCounters(state, guests.size());
+}
+
+static void RegisterPathfindingBenchmarks(const std::string& filename)
+{
+    const std::pair<const char*, bool> variants[] = {
+        { "cold", true },
+        { "warm", false },
+    };
+    for (const auto& [variantName, cold] : variants)
+    {
+        auto decisionName = filename + "/guest_path_finding/" + variantName;
+        benchmark::RegisterBenchmark(decisionName.c_str(), BM_guest_path_finding, filename, cold)
+            ->Unit(benchmark::kMicrosecond);
+
+        auto directionName = filename + "/peep_pathfind_choose_direction/" + variantName;
+        benchmark::RegisterBenchmark(directionName.c_str(), BM_peep_pathfind_choose_direction, filename, cold)
+            ->Unit(benchmark::kMicrosecond);
+    }
+}
+
+static int CmdlineForBenchPathfinding(int argc, const char* const* argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (Platform::FileExists(argv[i]))
+        {
+            RegisterPathfindingBenchmarks(argv[i]);
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchPathfinding(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = static_cast<const char* const*>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchPathfinding(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchPathfinding(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchPathfindingCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file>... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchPathfinding),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchPathfinding), CommandTableEnd
+#endif // USE_BENCHMARK
+};
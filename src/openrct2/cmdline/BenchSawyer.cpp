@@ -0,0 +1,173 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../core/File.h"
+#    include "../core/MemoryStream.h"
+#    include "../platform/Platform2.h"
+#    include "../rct12/SawyerChunkReader.h"
+#    include "../rct12/SawyerChunkWriter.h"
+
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+/**
+ * Reads every chunk of an SV6 or SC6 file, stopping before the checksum at the end of the file.
+ */
+static std::vector<std::shared_ptr<SawyerChunk>> ReadSawyerChunks(const std::vector<uint8_t>& data)
+{
+    std::vector<std::shared_ptr<SawyerChunk>> chunks;
+    MemoryStream ms(data.data(), data.size());
+    SawyerChunkReader reader(&ms);
+    while (ms.GetPosition() + 4 < ms.GetLength())
+    {
+        chunks.push_back(reader.ReadChunk());
+    }
+    return chunks;
+}
+
+static size_t GetUncompressedLength(const std::vector<std::shared_ptr<SawyerChunk>>& chunks)
+{
+    size_t length = 0;
+    for (const auto& chunk : chunks)
+    {
+        length += chunk->GetLength();
+    }
+    return length;
+}
+
+static void BM_sawyer_decode(benchmark::State& state, const std::string& filename)
+{
+    auto data = File::ReadAllBytes(filename);
+    size_t uncompressedLength = 0;
+    try
+    {
+        uncompressedLength = GetUncompressedLength(ReadSawyerChunks(data));
+    }
+    catch (const std::exception& e)
+    {
+        state.SkipWithError(e.what());
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ReadSawyerChunks(data));
+    }
+    state.SetBytesProcessed(state.iterations() * uncompressedLength);
+}
+
+static void BM_sawyer_encode(benchmark::State& state, const std::string& filename)
+{
+    std::vector<std::shared_ptr<SawyerChunk>> chunks;
+    try
+    {
+        chunks = ReadSawyerChunks(File::ReadAllBytes(filename));
+    }
+    catch (const std::exception& e)
+    {
+        state.SkipWithError(e.what());
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        MemoryStream ms;
+        SawyerChunkWriter writer(&ms);
+        for (const auto& chunk : chunks)
+        {
+            writer.WriteChunk(chunk.get());
+        }
+        benchmark::DoNotOptimize(ms.GetData());
+    }
+    state.SetBytesProcessed(state.iterations() * GetUncompressedLength(chunks));
+}
+
+static void RegisterSawyerBenchmarks(const std::string& filename)
+{
+    auto decodeName = filename + "/sawyer_decode";
+    benchmark::RegisterBenchmark(decodeName.c_str(), BM_sawyer_decode, filename)->Unit(benchmark::kMillisecond);
+
+    auto encodeName = filename + "/sawyer_encode";
+    benchmark::RegisterBenchmark(encodeName.c_str(), BM_sawyer_encode, filename)->Unit(benchmark::kMillisecond);
+}
+
+static int CmdlineForBenchSawyer(int argc, const char* const* argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (Platform::FileExists(argv[i]))
+        {
+            RegisterSawyerBenchmarks(argv[i]);
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchSawyer(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = static_cast<const char* const*>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchSawyer(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchSawyer(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchSawyerCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file>... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchSawyer),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchSawyer), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -17,6 +17,7 @@
 #    include "../OpenRCT2.h"
 #    include "../audio/audio.h"
 #    include "../core/Console.hpp"
+#    include "../core/TaskScheduler.h"
 #    include "../core/Imaging.h"
 #    include "../drawing/Drawing.h"
 #    include "../interface/Viewport.h"
@@ -32,6 +33,7 @@
 #    include <benchmark/benchmark.h>
 #    include <cstdint>
 #    include <iterator>
+#    include <thread>
 #    include <vector>
 
 static void fixup_pointers(std::vector<RecordedPaintSession>& s)
@@ -157,6 +159,45 @@ static void BM_paint_session_arrange(benchmark::State& state, const std::vector<
     delete[] local_s;
 }
 
+// Arranges all recorded column sessions at once, split across state.range(0) threads.
+static void BM_paint_session_arrange_parallel(benchmark::State& state, const std::vector<RecordedPaintSession> inputSessions)
+{
+    auto sessions = inputSessions;
+    RecordedPaintSession* local_s = new RecordedPaintSession[std::size(sessions)];
+    fixup_pointers(sessions);
+    std::copy_n(sessions.cbegin(), std::size(sessions), local_s);
+
+    std::vector<PaintSessionCore*> cores;
+    for (auto& session : sessions)
+    {
+        cores.push_back(&session.Session);
+    }
+
+    OpenRCT2::TaskScheduler scheduler(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::copy_n(local_s, std::size(sessions), sessions.begin());
+        state.ResumeTiming();
+        PaintSessionArrange(cores.data(), cores.size(), scheduler);
+        benchmark::DoNotOptimize(sessions);
+    }
+    state.SetItemsProcessed(state.iterations() * std::size(sessions));
+    delete[] local_s;
+}
+
+static void RegisterPaintSessionArrangeBenchmarks(const char* name, const std::vector<RecordedPaintSession>& sessions)
+{
+    benchmark::RegisterBenchmark(name, BM_paint_session_arrange, sessions);
+
+    const auto maxThreads = std::max<int>(1, std::thread::hardware_concurrency());
+    auto parallelName = std::string(name) + "/parallel";
+    benchmark::RegisterBenchmark(parallelName.c_str(), BM_paint_session_arrange_parallel, sessions)
+        ->RangeMultiplier(2)
+        ->Range(1, maxThreads)
+        ->UseRealTime();
+}
+
 static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
 {
     {
@@ -170,7 +211,7 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
         {
             quad = reinterpret_cast<paint_struct*>(-1);
         }
-        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions);
+        RegisterPaintSessionArrangeBenchmarks("baseline", sessions);
     }
 
     // Google benchmark does stuff to argv. It doesn't modify the pointees,
@@ -188,7 +229,7 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
             // Register benchmark for sv6 if valid
             std::vector<RecordedPaintSession> sessions = extract_paint_session(argv[i]);
             if (!sessions.empty())
-                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions);
+                RegisterPaintSessionArrangeBenchmarks(argv[i], sessions);
         }
         else
         {
@@ -0,0 +1,134 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../OpenRCT2.h"
+#    include "../PlatformEnvironment.h"
+#    include "../core/File.h"
+#    include "../platform/platform.h"
+
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <memory>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+/**
+ * Deletes the object, track design and scenario indexes, so that the next initialisation has to build them again.
+ */
+static void DeleteRepositoryIndexes()
+{
+    auto env = CreatePlatformEnvironment();
+    for (auto pathId : { PATHID::CACHE_OBJECTS, PATHID::CACHE_TRACKS, PATHID::CACHE_SCENARIOS })
+    {
+        auto path = env->GetFilePath(pathId);
+        if (File::Exists(path))
+        {
+            File::Delete(path);
+        }
+    }
+}
+
+/**
+ * Times the initialisation of a headless context, including the track design and scenario scan that finishes in the
+ * background. When cold, the indexes are deleted before every iteration. The files themselves are likely to be in the
+ * page cache either way.
+ */
+static void BM_context_initialise(benchmark::State& state, bool cold)
+{
+    for (auto _ : state)
+    {
+        if (cold)
+        {
+            state.PauseTiming();
+            DeleteRepositoryIndexes();
+            state.ResumeTiming();
+        }
+
+        auto context = CreateContext();
+        if (!context->Initialise())
+        {
+            state.SkipWithError("Context initialization failed.");
+            break;
+        }
+        benchmark::DoNotOptimize(context->GetScenarioRepository());
+
+        state.PauseTiming();
+        context.reset();
+        state.ResumeTiming();
+    }
+}
+
+static int CmdlineForBenchStartup(int argc, const char* const* argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    benchmark::RegisterBenchmark("context_initialise/cold", BM_context_initialise, true)->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("context_initialise/warm", BM_context_initialise, false)->Unit(benchmark::kMillisecond);
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchStartup(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = static_cast<const char* const*>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchStartup(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchStartup(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchStartupCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchStartup),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchStartup), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -0,0 +1,192 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../Game.h"
+#    include "../Intro.h"
+#    include "../OpenRCT2.h"
+#    include "../interface/Viewport.h"
+#    include "../paint/Paint.h"
+#    include "../platform/Platform2.h"
+#    include "../world/Map.h"
+
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+static constexpr int32_t PaintColumnWidth = 32;
+
+static std::unique_ptr<IContext> LoadParkWithLayout(
+    benchmark::State& state, const std::string& filename, TileElementLayout layout)
+{
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        state.SkipWithError("Context initialization failed.");
+        return nullptr;
+    }
+    if (!context->LoadParkFromFile(filename))
+    {
+        state.SkipWithError("Failed to load file!");
+        return nullptr;
+    }
+
+    gIntroState = IntroState::None;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+    SetTileElementLayout(layout);
+    return context;
+}
+
+static void BM_map_update_tiles(benchmark::State& state, const std::string& filename, TileElementLayout layout)
+{
+    auto context = LoadParkWithLayout(state, filename, layout);
+    if (context == nullptr)
+        return;
+
+    for (auto _ : state)
+    {
+        map_update_tiles();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Generates the paint structs for the whole map in 32 pixel columns, the same way viewport_paint splits a viewport.
+static void BM_paint_generate(benchmark::State& state, const std::string& filename, TileElementLayout layout)
+{
+    auto context = LoadParkWithLayout(state, filename, layout);
+    if (context == nullptr)
+        return;
+
+    const int32_t width = (gMapSize * 32 * 2) + 8;
+    const int32_t height = (gMapSize * 32 * 1) + 128;
+
+    const int32_t centreX = (gMapSize / 2) * 32 + 16;
+    const int32_t centreY = (gMapSize / 2) * 32 + 16;
+    const int32_t centreZ = tile_element_height({ centreX, centreY });
+    const int32_t viewX = (centreY - centreX) - (width / 2);
+    const int32_t viewY = ((centreX + centreY) / 2) - centreZ - (height / 2);
+
+    gCurrentRotation = 0;
+    reset_all_sprite_quadrant_placements();
+
+    size_t numColumns = 0;
+    for (auto _ : state)
+    {
+        numColumns = 0;
+        for (int32_t x = 0; x < width; x += PaintColumnWidth)
+        {
+            rct_drawpixelinfo dpi{};
+            dpi.x = viewX + x;
+            dpi.y = viewY;
+            dpi.width = PaintColumnWidth;
+            dpi.height = height;
+
+            paint_session* session = PaintSessionAlloc(&dpi, 0);
+            PaintSessionGenerate(session);
+            benchmark::DoNotOptimize(session->Quadrants);
+            PaintSessionFree(session);
+            numColumns++;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numColumns);
+}
+
+static void RegisterTileLayoutBenchmarks(const std::string& filename)
+{
+    const std::pair<const char*, TileElementLayout> layouts[] = {
+        { "row_major", TileElementLayout::RowMajor },
+        { "morton", TileElementLayout::Morton },
+    };
+    for (const auto& [layoutName, layout] : layouts)
+    {
+        auto updateName = filename + "/map_update_tiles/" + layoutName;
+        benchmark::RegisterBenchmark(updateName.c_str(), BM_map_update_tiles, filename, layout);
+
+        auto paintName = filename + "/paint_generate/" + layoutName;
+        benchmark::RegisterBenchmark(paintName.c_str(), BM_paint_generate, filename, layout)
+            ->Unit(benchmark::kMillisecond);
+    }
+}
+
+static int CmdlineForBenchTileLayout(int argc, const char* const* argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (Platform::FileExists(argv[i]))
+        {
+            RegisterTileLayoutBenchmarks(argv[i]);
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchTileLayout(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = static_cast<const char* const*>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchTileLayout(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchTileLayout(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchTileLayoutCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file>... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchTileLayout),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchTileLayout), CommandTableEnd
+#endif // USE_BENCHMARK
+};
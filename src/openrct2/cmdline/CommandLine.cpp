@@ -15,7 +15,15 @@
 #include "../platform/Platform2.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <thread>
+
+#ifndef _WIN32
+#    include <sys/wait.h>
+#    include <unistd.h>
+#endif
 
 #pragma region CommandLineArgEnumerator
 
@@ -511,6 +519,78 @@ namespace CommandLine
         return Platform::HandleSpecialCommandLineArgument(argument);
     }
 
+#ifndef _WIN32
+    bool RunInParallel(size_t count, const std::function<bool(size_t)>& func)
+    {
+        const size_t maxRunning = std::max(1u, std::thread::hardware_concurrency());
+        size_t numRunning = 0;
+        bool success = true;
+
+        auto waitForProcess = [&numRunning, &success]() {
+            int status = 0;
+            if (wait(&status) == -1)
+            {
+                success = false;
+                numRunning = 0;
+                return;
+            }
+            numRunning--;
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != EXITCODE_OK)
+            {
+                success = false;
+            }
+        };
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (numRunning >= maxRunning)
+            {
+                waitForProcess();
+            }
+
+            // Anything still buffered would otherwise be written by both processes.
+            std::fflush(stdout);
+            std::fflush(stderr);
+
+            auto pid = fork();
+            if (pid == 0)
+            {
+                // Leave without running any destructors, the state they would clean up is shared with the other processes.
+                bool result = func(i);
+                std::fflush(stdout);
+                std::fflush(stderr);
+                std::_Exit(result ? EXITCODE_OK : EXITCODE_FAIL);
+            }
+            if (pid == -1)
+            {
+                Console::Error::WriteLine("Unable to start a new process.");
+                success = false;
+                continue;
+            }
+            numRunning++;
+        }
+
+        while (numRunning > 0)
+        {
+            waitForProcess();
+        }
+        return success;
+    }
+#else
+    bool RunInParallel(size_t count, const std::function<bool(size_t)>& func)
+    {
+        bool success = true;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!func(i))
+            {
+                success = false;
+            }
+        }
+        return success;
+    }
+#endif
+
     const CommandLineOptionDefinition* FindOption(const CommandLineOptionDefinition* options, char shortName)
     {
         for (const CommandLineOptionDefinition* option = options; option->Type != 255; option++)
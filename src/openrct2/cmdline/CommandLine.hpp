@@ -11,6 +11,8 @@
 
 #include "../common.h"
 
+#include <functional>
+
 /**
  * Class for enumerating and retrieving values for a set of command line arguments.
  */
@@ -119,7 +121,13 @@ namespace CommandLine
     extern const CommandLineCommand BenchGfxCommands[];
     extern const CommandLineCommand BenchSpriteSortCommands[];
     extern const CommandLineCommand BenchUpdateCommands[];
+    extern const CommandLineCommand BenchPathfindingCommands[];
+    extern const CommandLineCommand BenchRideUpdateCommands[];
+    extern const CommandLineCommand BenchTileLayoutCommands[];
+    extern const CommandLineCommand BenchSawyerCommands[];
+    extern const CommandLineCommand BenchStartupCommands[];
     extern const CommandLineCommand SimulateCommands[];
+    extern const CommandLineCommand ReplayCommands[];
 
     extern const CommandLineExample RootExamples[];
 
@@ -127,5 +135,14 @@ namespace CommandLine
     exitcode_t HandleCommandDefault();
 
     exitcode_t HandleCommandConvert(CommandLineArgEnumerator* enumerator);
+    exitcode_t HandleCommandConvertBatch(CommandLineArgEnumerator* enumerator);
     exitcode_t HandleCommandUri(CommandLineArgEnumerator* enumerator);
+
+    /**
+     * Calls func for each index up to count, each call in a process of its own with as many running at once as there
+     * are hardware threads. The processes are forked from the current one, so everything already loaded is shared
+     * between them. Returns true if every call returned true. Where processes can not be forked, the calls are made one
+     * after another instead.
+     */
+    bool RunInParallel(size_t count, const std::function<bool(size_t)>& func);
 } // namespace CommandLine
@@ -7,20 +7,52 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../Context.h"
 #include "../FileClassifier.h"
 #include "../OpenRCT2.h"
 #include "../ParkImporter.h"
+#include "../TrackImporter.h"
 #include "../common.h"
 #include "../core/Console.hpp"
+#include "../core/FileScanner.h"
 #include "../core/Path.hpp"
+#include "../core/TaskScheduler.h"
 #include "../interface/Window.h"
+#include "../platform/platform.h"
 #include "../rct2/S6Exporter.h"
+#include "../rct2/T6Exporter.h"
+#include "../ride/TrackDesign.h"
 #include "CommandLine.hpp"
 
+#include <chrono>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+/**
+ * A file found by a batch conversion and the outcome of converting it.
+ */
+struct BatchConversionJob
+{
+    std::string SourcePath;
+    std::string RelativePath;
+    std::string DestinationPath;
+    uint32_t SourceFileType{};
+    bool Succeeded{};
+    std::string Error;
+    double Milliseconds{};
+};
 
 static void WriteConvertFromAndToMessage(uint32_t sourceFileType, uint32_t destinationFileType);
 static const utf8* GetFileTypeFriendlyName(uint32_t fileType);
+static std::vector<BatchConversionJob> GetBatchConversionJobs(
+    const std::string& sourceDirectory, const std::string& destinationDirectory);
+static void RunBatchConversionJob(BatchConversionJob& job);
+static void ConvertPark(const BatchConversionJob& job);
+static void ConvertTrackDesign(const BatchConversionJob& job);
 
 exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerator)
 {
@@ -137,6 +169,204 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     return EXITCODE_OK;
 }
 
+exitcode_t CommandLine::HandleCommandConvertBatch(CommandLineArgEnumerator* enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    const utf8* rawSourceDirectory;
+    if (!enumerator->TryPopString(&rawSourceDirectory))
+    {
+        Console::Error::WriteLine("Expected a source directory.");
+        return EXITCODE_FAIL;
+    }
+    auto sourceDirectory = Path::GetAbsolute(rawSourceDirectory);
+    if (!Path::DirectoryExists(sourceDirectory))
+    {
+        Console::Error::WriteLine("Source directory '%s' does not exist.", sourceDirectory.c_str());
+        return EXITCODE_FAIL;
+    }
+
+    const utf8* rawDestinationDirectory;
+    if (!enumerator->TryPopString(&rawDestinationDirectory))
+    {
+        Console::Error::WriteLine("Expected a destination directory.");
+        return EXITCODE_FAIL;
+    }
+    auto destinationDirectory = Path::GetAbsolute(rawDestinationDirectory);
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    // One context, and so one object repository, is shared by every file in the batch.
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    auto jobs = GetBatchConversionJobs(sourceDirectory, destinationDirectory);
+    for (const auto& job : jobs)
+    {
+        auto directory = Path::GetDirectory(job.DestinationPath);
+        if (!platform_ensure_directory_exists(directory.c_str()))
+        {
+            Console::Error::WriteLine("Could not create directory %s.", directory.c_str());
+            return EXITCODE_FAIL;
+        }
+    }
+
+    // Track designs are independent of the game state, so they are converted on all workers while the parks, which
+    // each replace the whole game state, are converted one after another on this thread.
+    auto startTime = std::chrono::high_resolution_clock::now();
+    {
+        TaskGroup tasks(context->GetTaskScheduler());
+        for (auto& job : jobs)
+        {
+            if (job.SourceFileType == FILE_EXTENSION_TD4 || job.SourceFileType == FILE_EXTENSION_TD6)
+            {
+                auto* trackDesignJob = &job;
+                tasks.Run([trackDesignJob]() { RunBatchConversionJob(*trackDesignJob); });
+            }
+        }
+        for (auto& job : jobs)
+        {
+            if (job.SourceFileType != FILE_EXTENSION_TD4 && job.SourceFileType != FILE_EXTENSION_TD6)
+            {
+                RunBatchConversionJob(job);
+            }
+        }
+        tasks.Wait();
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - startTime;
+
+    size_t numFailed = 0;
+    for (const auto& job : jobs)
+    {
+        if (job.Succeeded)
+        {
+            Console::WriteLine("%10.1f ms  %s", job.Milliseconds, job.RelativePath.c_str());
+        }
+        else
+        {
+            Console::Error::WriteLine("Failed to convert '%s': %s", job.RelativePath.c_str(), job.Error.c_str());
+            numFailed++;
+        }
+    }
+    Console::WriteLine(
+        "Converted %zu of %zu files in %.1f ms, %zu failed.", jobs.size() - numFailed, jobs.size(), duration.count(),
+        numFailed);
+    return numFailed == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+static std::vector<BatchConversionJob> GetBatchConversionJobs(
+    const std::string& sourceDirectory, const std::string& destinationDirectory)
+{
+    std::vector<BatchConversionJob> jobs;
+    auto pattern = Path::Combine(sourceDirectory, "*.sc4;*.sv4;*.sc6;*.sv6;*.td4;*.td6");
+    auto scanner = Path::ScanDirectory(pattern, true);
+    while (scanner->Next())
+    {
+        auto& job = jobs.emplace_back();
+        job.SourcePath = scanner->GetPath();
+        job.RelativePath = scanner->GetPathRelative();
+        job.SourceFileType = get_file_extension_type(job.SourcePath.c_str());
+
+        const char* destinationExtension;
+        switch (job.SourceFileType)
+        {
+            case FILE_EXTENSION_SC4:
+            case FILE_EXTENSION_SC6:
+                destinationExtension = ".sc6";
+                break;
+            case FILE_EXTENSION_TD4:
+            case FILE_EXTENSION_TD6:
+                destinationExtension = ".td6";
+                break;
+            default:
+                destinationExtension = ".sv6";
+                break;
+        }
+        auto extensionLength = Path::GetExtension(job.RelativePath).size();
+        auto relativePathWithoutExtension = job.RelativePath.substr(0, job.RelativePath.size() - extensionLength);
+        job.DestinationPath = Path::Combine(destinationDirectory, relativePathWithoutExtension + destinationExtension);
+    }
+    return jobs;
+}
+
+static void RunBatchConversionJob(BatchConversionJob& job)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+    try
+    {
+        if (job.SourceFileType == FILE_EXTENSION_TD4 || job.SourceFileType == FILE_EXTENSION_TD6)
+        {
+            ConvertTrackDesign(job);
+        }
+        else
+        {
+            ConvertPark(job);
+        }
+        job.Succeeded = true;
+    }
+    catch (const std::exception& e)
+    {
+        job.Error = e.what();
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - startTime;
+    job.Milliseconds = duration.count();
+}
+
+static void ConvertPark(const BatchConversionJob& job)
+{
+    // Loading a scenario resets the park, as converting a single scenario does.
+    auto context = GetContext();
+    if (!context->LoadParkFromFile(job.SourcePath))
+    {
+        throw std::runtime_error("Unable to load park.");
+    }
+
+    // HACK remove the main window so it saves the park with the
+    //      correct initial view
+    window_close_by_class(WC_MAIN_WINDOW);
+
+    auto exporter = std::make_unique<S6Exporter>();
+    exporter->Export();
+    if (job.SourceFileType == FILE_EXTENSION_SC4 || job.SourceFileType == FILE_EXTENSION_SC6)
+    {
+        exporter->SaveScenario(job.DestinationPath.c_str());
+    }
+    else
+    {
+        exporter->SaveGame(job.DestinationPath.c_str());
+    }
+}
+
+static void ConvertTrackDesign(const BatchConversionJob& job)
+{
+    auto importer = TrackImporter::Create(job.SourcePath);
+    if (!importer->Load(job.SourcePath.c_str()))
+    {
+        throw std::runtime_error("Unable to load track design.");
+    }
+    auto trackDesign = importer->Import();
+    if (trackDesign == nullptr)
+    {
+        throw std::runtime_error("Unable to import track design.");
+    }
+
+    T6Exporter exporter(trackDesign.get());
+    if (!exporter.SaveTrack(job.DestinationPath.c_str()))
+    {
+        throw std::runtime_error("Unable to save track design.");
+    }
+}
+
 static void WriteConvertFromAndToMessage(uint32_t sourceFileType, uint32_t destinationFileType)
 {
     const utf8* sourceFileTypeName = GetFileTypeFriendlyName(sourceFileType);
@@ -0,0 +1,118 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../ReplayManager.h"
+#include "../core/Console.hpp"
+#include "../core/FileScanner.h"
+#include "../core/Path.hpp"
+#include "../platform/platform.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleReplayVerify(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::ReplayCommands[]{
+    // Main commands
+    DefineCommand("verify", "<directory>", nullptr, HandleReplayVerify), CommandTableEnd
+};
+
+static bool VerifyReplay(IContext& context, const std::string& replayPath)
+{
+    auto* replayManager = context.GetReplayManager();
+    if (!replayManager->StartPlayback(replayPath))
+    {
+        Console::WriteLine("FAILED %s: unable to start playback", replayPath.c_str());
+        return false;
+    }
+
+    // Keep playing after a checksum mismatch, so the game state at the end is still compared with the recorded one.
+    auto* gameState = context.GetGameState();
+    while (replayManager->IsReplaying())
+    {
+        gameState->UpdateLogic();
+    }
+
+    const auto& differences = replayManager->GetPlaybackStateDifferences();
+    if (!replayManager->IsPlaybackStateMismatching() && differences.empty())
+    {
+        Console::WriteLine("OK %s", replayPath.c_str());
+        return true;
+    }
+
+    if (replayManager->IsPlaybackStateMismatching())
+    {
+        Console::WriteLine(
+            "FAILED %s: first diverging tick %u", replayPath.c_str(), replayManager->GetPlaybackMismatchTick());
+    }
+    else
+    {
+        Console::WriteLine("FAILED %s: game state differs", replayPath.c_str());
+    }
+
+    std::istringstream lines(differences);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        Console::WriteLine("  %s", line.c_str());
+    }
+    return false;
+}
+
+static exitcode_t HandleReplayVerify(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* directory;
+    if (!argEnumerator->TryPopString(&directory))
+    {
+        Console::Error::WriteLine("Expected a directory of replays.");
+        return EXITCODE_FAIL;
+    }
+
+    std::vector<std::string> replayPaths;
+    auto scanner = Path::ScanDirectory(Path::Combine(directory, "*.sv6r"), true);
+    while (scanner->Next())
+    {
+        replayPaths.push_back(scanner->GetPath());
+    }
+    std::sort(replayPaths.begin(), replayPaths.end());
+
+    if (replayPaths.empty())
+    {
+        Console::Error::WriteLine("No replays found in '%s'.", directory);
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    // Every replay is played back in a process of its own, sharing everything loaded when the context was initialised.
+    Console::WriteLine("Verifying %u replays...", static_cast<uint32_t>(replayPaths.size()));
+    bool success = CommandLine::RunInParallel(
+        replayPaths.size(), [&context, &replayPaths](size_t i) { return VerifyReplay(*context, replayPaths[i]); });
+
+    return success ? EXITCODE_OK : EXITCODE_FAIL;
+}
@@ -58,6 +58,8 @@ static utf8* _openrct2DataPath = nullptr;
 static utf8* _rct1DataPath = nullptr;
 static utf8* _rct2DataPath = nullptr;
 static bool _silentBreakpad = false;
+static bool _startupProfile = false;
+static bool _batch = false;
 
 // clang-format off
 static constexpr const CommandLineOptionDefinition StandardOptions[]
@@ -78,6 +80,8 @@ static constexpr const CommandLineOptionDefinition StandardOptions[]
     { CMDLINE_TYPE_STRING,  &_openrct2DataPath, NAC, "openrct2-data-path", "path to the OpenRCT2 data directory (containing languages)" },
     { CMDLINE_TYPE_STRING,  &_rct1DataPath,     NAC, "rct1-data-path",     "path to the RollerCoaster Tycoon 1 data directory (containing data/csg1.dat)" },
     { CMDLINE_TYPE_STRING,  &_rct2DataPath,     NAC, "rct2-data-path",     "path to the RollerCoaster Tycoon 2 data directory (containing data/g1.dat)" },
+    { CMDLINE_TYPE_SWITCH,  &_startupProfile,   NAC, "startup-profile",    "print how long each phase of startup takes"                 },
+    { CMDLINE_TYPE_SWITCH,  &_batch,            NAC, "batch",              "convert every park and track design in the source directory" },
 #ifdef USE_BREAKPAD
     { CMDLINE_TYPE_SWITCH,  &_silentBreakpad,  NAC, "silent-breakpad",   "make breakpad crash reporting silent"                       },
 #endif // USE_BREAKPAD
@@ -93,6 +97,7 @@ static exitcode_t HandleCommandJoin(CommandLineArgEnumerator * enumerator);
 #endif
 static exitcode_t HandleCommandSetRCT2(CommandLineArgEnumerator * enumerator);
 static exitcode_t HandleCommandScanObjects(CommandLineArgEnumerator * enumerator);
+static exitcode_t HandleCommandConvert(CommandLineArgEnumerator * enumerator);
 
 #if defined(_WIN32) && !defined(__MINGW32__)
 
@@ -127,7 +132,7 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineCommand("join",     "<hostname>",             StandardOptions, HandleCommandJoin   ),
 #endif
     DefineCommand("set-rct2", "<path>",                 StandardOptions, HandleCommandSetRCT2),
-    DefineCommand("convert",  "<source> <destination>", StandardOptions, CommandLine::HandleCommandConvert),
+    DefineCommand("convert",  "<source> <destination>", StandardOptions, HandleCommandConvert),
     DefineCommand("scan-objects", "<path>",             StandardOptions, HandleCommandScanObjects),
     DefineCommand("handle-uri", "openrct2://.../",      StandardOptions, CommandLine::HandleCommandUri),
 
@@ -136,12 +141,18 @@ const CommandLineCommand CommandLine::RootCommands[]
 #endif
 
     // Sub-commands
-    DefineSubCommand("screenshot",      CommandLine::ScreenshotCommands       ),
-    DefineSubCommand("sprite",          CommandLine::SpriteCommands           ),
-    DefineSubCommand("benchgfx",        CommandLine::BenchGfxCommands         ),
-    DefineSubCommand("benchspritesort", CommandLine::BenchSpriteSortCommands  ),
-    DefineSubCommand("benchsimulate",   CommandLine::BenchUpdateCommands      ),
-    DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
+    DefineSubCommand("screenshot",       CommandLine::ScreenshotCommands       ),
+    DefineSubCommand("sprite",           CommandLine::SpriteCommands           ),
+    DefineSubCommand("benchgfx",         CommandLine::BenchGfxCommands         ),
+    DefineSubCommand("benchspritesort",  CommandLine::BenchSpriteSortCommands  ),
+    DefineSubCommand("benchsimulate",    CommandLine::BenchUpdateCommands      ),
+    DefineSubCommand("benchpathfinding", CommandLine::BenchPathfindingCommands ),
+    DefineSubCommand("benchrideupdate",  CommandLine::BenchRideUpdateCommands  ),
+    DefineSubCommand("benchtilelayout",  CommandLine::BenchTileLayoutCommands  ),
+    DefineSubCommand("benchstartup",     CommandLine::BenchStartupCommands     ),
+    DefineSubCommand("benchsawyer",      CommandLine::BenchSawyerCommands      ),
+    DefineSubCommand("simulate",         CommandLine::SimulateCommands         ),
+    DefineSubCommand("replay",           CommandLine::ReplayCommands           ),
     CommandTableEnd
 };
 
@@ -196,6 +207,7 @@ exitcode_t CommandLine::HandleCommandDefault()
     gOpenRCT2Headless = _headless;
     gOpenRCT2NoGraphics = _headless;
     gOpenRCT2SilentBreakpad = _silentBreakpad || _headless;
+    gOpenRCT2StartupProfile = _startupProfile;
 
     if (_userDataPath != nullptr)
     {
@@ -413,6 +425,16 @@ static exitcode_t HandleCommandScanObjects([[maybe_unused]] CommandLineArgEnumer
     return EXITCODE_OK;
 }
 
+static exitcode_t HandleCommandConvert(CommandLineArgEnumerator* enumerator)
+{
+    // --batch is one of the standard options, so it has already been parsed by the time a command is handled
+    if (_batch)
+    {
+        return CommandLine::HandleCommandConvertBatch(enumerator);
+    }
+    return CommandLine::HandleCommandConvert(enumerator);
+}
+
 #if defined(_WIN32) && !defined(__MINGW32__)
 static exitcode_t HandleCommandRegisterShell([[maybe_unused]] CommandLineArgEnumerator* enumerator)
 {
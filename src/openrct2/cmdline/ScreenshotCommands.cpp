@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../core/Console.hpp"
 #include "../interface/Screenshot.h"
 #include "CommandLine.hpp"
 
@@ -29,12 +30,14 @@ static constexpr const CommandLineOptionDefinition ScreenshotOptionsDef[]
 };
 
 static exitcode_t HandleScreenshot(CommandLineArgEnumerator *argEnumerator);
+static exitcode_t HandleScreenshotBatch(CommandLineArgEnumerator *argEnumerator);
 
 const CommandLineCommand CommandLine::ScreenshotCommands[]
 {
     // Main commands
     DefineCommand("", "<file> <output_image> <width> <height> [<x> <y> <zoom> <rotation>]", ScreenshotOptionsDef, HandleScreenshot),
     DefineCommand("", "<file> <output_image> giant <zoom> <rotation>",                      ScreenshotOptionsDef, HandleScreenshot),
+    DefineCommand("batch", "<job_file>",                                                    ScreenshotOptionsDef, HandleScreenshotBatch),
     CommandTableEnd
 };
 // clang-format on
@@ -50,3 +53,21 @@ static exitcode_t HandleScreenshot(CommandLineArgEnumerator* argEnumerator)
     }
     return EXITCODE_OK;
 }
+
+static exitcode_t HandleScreenshotBatch(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* jobPath;
+    if (!argEnumerator->TryPopString(&jobPath))
+    {
+        Console::Error::WriteLine("Expected a job file.");
+        return EXITCODE_FAIL;
+    }
+
+    // Each line of the job file holds the arguments of one screenshot command, e.g. "park.sv6 park.png giant 0 0".
+    int32_t result = cmdline_for_screenshot_batch(jobPath, &_options);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
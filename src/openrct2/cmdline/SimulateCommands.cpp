@@ -12,37 +12,145 @@
 #include "../GameState.h"
 #include "../OpenRCT2.h"
 #include "../core/Console.hpp"
+#include "../core/Path.hpp"
 #include "../network/network.h"
+#include "../object/ObjectManager.h"
 #include "../platform/platform.h"
+#include "../rct2/S6Exporter.h"
 #include "../world/Sprite.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <memory>
+#include <string>
+#include <vector>
 
 using namespace OpenRCT2;
 
+// How often the number of ticks run per second is reported.
+static constexpr std::chrono::seconds ReportInterval{ 10 };
+
+static int32_t _checkpointTicks = 0;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition SimulateOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_checkpointTicks, NAC, "checkpoint", "save the park every given number of ticks and once done" },
+    OptionTableEnd
+};
+// clang-format on
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
 
-const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
-                                                          DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
+const CommandLineCommand CommandLine::SimulateCommands[]{
+    // Main commands
+    DefineCommand("", "<sv6-file> [<sv6-file> ...] <ticks>", SimulateOptions, HandleSimulate), CommandTableEnd
 };
 
+static bool SaveCheckpoint(const std::string& path)
+{
+    try
+    {
+        auto s6exporter = std::make_unique<S6Exporter>();
+        s6exporter->ExportObjectsList = GetContext()->GetObjectManager().GetPackableObjects();
+        s6exporter->Export();
+        s6exporter->SaveGame(path.c_str());
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Unable to save '%s': %s", path.c_str(), e.what());
+        return false;
+    }
+}
+
+static void ReportTicksPerSecond(
+    const char* inputPath, uint32_t ticksRun, uint32_t ticks, std::chrono::duration<double> elapsed)
+{
+    double ticksPerSecond = elapsed.count() > 0 ? ticksRun / elapsed.count() : 0;
+    Console::WriteLine("%s: %u/%u ticks, %.0f ticks/s", inputPath, ticksRun, ticks, ticksPerSecond);
+}
+
+/**
+ * Runs the ticks back to back as fast as they can be, rather than at the rate the game normally runs at.
+ */
+static bool SimulatePark(IContext& context, const char* inputPath, uint32_t ticks, bool showPath)
+{
+    if (!context.LoadParkFromFile(inputPath))
+    {
+        return false;
+    }
+
+    std::string path = inputPath;
+    auto checkpointPath = Path::Combine(Path::GetDirectory(path), Path::GetFileNameWithoutExtension(path) + "_simulated.sv6");
+    auto checkpointTicks = static_cast<uint32_t>(std::max(_checkpointTicks, 0));
+
+    Console::WriteLine("Running %d ticks...", ticks);
+    auto* gameState = context.GetGameState();
+    auto startTime = std::chrono::steady_clock::now();
+    auto nextReportTime = startTime + ReportInterval;
+    for (uint32_t i = 0; i < ticks; i++)
+    {
+        gameState->UpdateLogic();
+
+        uint32_t ticksRun = i + 1;
+        if (checkpointTicks != 0 && ticksRun % checkpointTicks == 0 && ticksRun != ticks)
+        {
+            SaveCheckpoint(checkpointPath);
+        }
+
+        // Only look at the clock every so often, a tick can take less time than reading it.
+        if ((ticksRun & 1023) == 0)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= nextReportTime)
+            {
+                ReportTicksPerSecond(inputPath, ticksRun, ticks, now - startTime);
+                nextReportTime = now + ReportInterval;
+            }
+        }
+    }
+    ReportTicksPerSecond(inputPath, ticks, ticks, std::chrono::steady_clock::now() - startTime);
+
+    if (checkpointTicks != 0 && !SaveCheckpoint(checkpointPath))
+    {
+        return false;
+    }
+
+    if (showPath)
+        Console::WriteLine("Completed %s: %s", inputPath, sprite_checksum().ToString().c_str());
+    else
+        Console::WriteLine("Completed: %s", sprite_checksum().ToString().c_str());
+    return true;
+}
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 {
     const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
     int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
 
+    // Options have already been handled and can only be at the end of the command line.
+    for (int32_t i = 0; i < argc; i++)
+    {
+        if (argv[i][0] == '-')
+        {
+            argc = i;
+            break;
+        }
+    }
+
     if (argc < 2)
     {
-        Console::Error::WriteLine("Missing arguments <sv6-file> <ticks>.");
+        Console::Error::WriteLine("Missing arguments <sv6-file> [<sv6-file> ...] <ticks>.");
         return EXITCODE_FAIL;
     }
 
     core_init();
 
-    const char* inputPath = argv[0];
-    uint32_t ticks = atol(argv[1]);
+    std::vector<const char*> inputPaths(argv, argv + argc - 1);
+    uint32_t ticks = atol(argv[argc - 1]);
 
     gOpenRCT2Headless = true;
 
@@ -53,17 +161,24 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
     std::unique_ptr<IContext> context(CreateContext());
     if (context->Initialise())
     {
-        if (!context->LoadParkFromFile(inputPath))
+        bool success = true;
+        if (inputPaths.size() == 1)
         {
-            return EXITCODE_FAIL;
+            success = SimulatePark(*context, inputPaths[0], ticks, false);
         }
-
-        Console::WriteLine("Running %d ticks...", ticks);
-        for (uint32_t i = 0; i < ticks; i++)
+        else
         {
-            context->GetGameState()->UpdateLogic();
+            // The game state is global, so every park is simulated in a process of its own. They share everything that
+            // was loaded when the context was initialised, such as the object repository and the g1 data.
+            success = CommandLine::RunInParallel(
+                inputPaths.size(), [&context, &inputPaths, ticks](size_t i) {
+                    return SimulatePark(*context, inputPaths[i], ticks, true);
+                });
+        }
+        if (!success)
+        {
+            return EXITCODE_FAIL;
         }
-        Console::WriteLine("Completed: %s", sprite_checksum().ToString().c_str());
     }
     else
     {
@@ -102,6 +102,12 @@ namespace Config
         ConfigEnumEntry<ScaleQuality>("SMOOTH_NEAREST_NEIGHBOUR", ScaleQuality::SmoothNearestNeighbour),
     });
 
+    static const auto Enum_ResamplingQuality = ConfigEnum<ResamplingQuality>({
+        ConfigEnumEntry<ResamplingQuality>("LOW", ResamplingQuality::Low),
+        ConfigEnumEntry<ResamplingQuality>("MEDIUM", ResamplingQuality::Medium),
+        ConfigEnumEntry<ResamplingQuality>("HIGH", ResamplingQuality::High),
+    });
+
     static const auto Enum_Sort = ConfigEnum<Sort>({
         ConfigEnumEntry<Sort>("NAME_ASCENDING", Sort::NameAscending),
         ConfigEnumEntry<Sort>("NAME_DESCENDING", Sort::NameDescending),
@@ -183,6 +189,7 @@ namespace Config
                 "drawing_engine", DrawingEngine::Software, Enum_DrawingEngine);
             model->uncap_fps = reader->GetBoolean("uncap_fps", false);
             model->use_vsync = reader->GetBoolean("use_vsync", true);
+            model->frame_rate_limit = reader->GetInt32("frame_rate_limit", 0);
             model->virtual_floor_style = reader->GetEnum<VirtualFloorStyles>(
                 "virtual_floor_style", VirtualFloorStyles::Glassy, Enum_VirtualFloorStyle);
             model->date_format = reader->GetEnum<int32_t>("date_format", platform_get_locale_date_format(), Enum_DateFormat);
@@ -209,6 +216,10 @@ namespace Config
                 "scale_quality", ScaleQuality::SmoothNearestNeighbour, Enum_ScaleQuality);
             model->show_fps = reader->GetBoolean("show_fps", false);
             model->multithreading = reader->GetBoolean("multi_threading", false);
+            model->morton_tile_layout = reader->GetBoolean("morton_tile_layout", false);
+            model->pathfinding_tick_budget = reader->GetInt32("pathfinding_tick_budget", 0);
+            model->multithreaded_pathfinding = reader->GetBoolean("multithreaded_pathfinding", false);
+            model->texture_memory_budget = reader->GetInt32("texture_memory_budget", 0);
             model->trap_cursor = reader->GetBoolean("trap_cursor", false);
             model->auto_open_shops = reader->GetBoolean("auto_open_shops", false);
             model->scenario_select_mode = reader->GetInt32("scenario_select_mode", SCENARIO_SELECT_MODE_ORIGIN);
@@ -266,6 +277,7 @@ namespace Config
         writer->WriteEnum<DrawingEngine>("drawing_engine", model->drawing_engine, Enum_DrawingEngine);
         writer->WriteBoolean("uncap_fps", model->uncap_fps);
         writer->WriteBoolean("use_vsync", model->use_vsync);
+        writer->WriteInt32("frame_rate_limit", model->frame_rate_limit);
         writer->WriteEnum<int32_t>("date_format", model->date_format, Enum_DateFormat);
         writer->WriteBoolean("auto_staff", model->auto_staff_placement);
         writer->WriteBoolean("handymen_mow_default", model->handymen_mow_default);
@@ -286,6 +298,10 @@ namespace Config
         writer->WriteEnum<ScaleQuality>("scale_quality", model->scale_quality, Enum_ScaleQuality);
         writer->WriteBoolean("show_fps", model->show_fps);
         writer->WriteBoolean("multi_threading", model->multithreading);
+        writer->WriteBoolean("morton_tile_layout", model->morton_tile_layout);
+        writer->WriteInt32("pathfinding_tick_budget", model->pathfinding_tick_budget);
+        writer->WriteBoolean("multithreaded_pathfinding", model->multithreaded_pathfinding);
+        writer->WriteInt32("texture_memory_budget", model->texture_memory_budget);
         writer->WriteBoolean("trap_cursor", model->trap_cursor);
         writer->WriteBoolean("auto_open_shops", model->auto_open_shops);
         writer->WriteInt32("scenario_select_mode", model->scenario_select_mode);
@@ -363,6 +379,8 @@ namespace Config
             model->ride_music_enabled = reader->GetBoolean("ride_music", true);
             model->ride_music_volume = reader->GetInt32("ride_music_volume", 100);
             model->audio_focus = reader->GetBoolean("audio_focus", false);
+            model->resampling_quality = reader->GetEnum<ResamplingQuality>(
+                "resampling_quality", ResamplingQuality::Medium, Enum_ResamplingQuality);
         }
     }
 
@@ -379,6 +397,7 @@ namespace Config
         writer->WriteBoolean("ride_music", model->ride_music_enabled);
         writer->WriteInt32("ride_music_volume", model->ride_music_volume);
         writer->WriteBoolean("audio_focus", model->audio_focus);
+        writer->WriteEnum<ResamplingQuality>("resampling_quality", model->resampling_quality, Enum_ResamplingQuality);
     }
 
     static void ReadNetwork(IIniReader* reader)
@@ -422,6 +441,7 @@ namespace Config
             model->log_server_actions = reader->GetBoolean("log_server_actions", false);
             model->pause_server_if_no_clients = reader->GetBoolean("pause_server_if_no_clients", false);
             model->desync_debugging = reader->GetBoolean("desync_debugging", false);
+            model->stats_dump_interval = reader->GetInt32("stats_dump_interval", 0);
         }
     }
 
@@ -449,6 +469,7 @@ namespace Config
         writer->WriteBoolean("log_server_actions", model->log_server_actions);
         writer->WriteBoolean("pause_server_if_no_clients", model->pause_server_if_no_clients);
         writer->WriteBoolean("desync_debugging", model->desync_debugging);
+        writer->WriteInt32("stats_dump_interval", model->stats_dump_interval);
     }
 
     static void ReadNotifications(IIniReader* reader)
@@ -550,6 +571,7 @@ namespace Config
             auto model = &gConfigPlugin;
             model->enable_hot_reloading = reader->GetBoolean("enable_hot_reloading", false);
             model->allowed_hosts = reader->GetString("allowed_hosts", "");
+            model->tick_budget = reader->GetInt32("tick_budget", 0);
         }
     }
 
@@ -559,6 +581,7 @@ namespace Config
         writer->WriteSection("plugin");
         writer->WriteBoolean("enable_hot_reloading", model->enable_hot_reloading);
         writer->WriteString("allowed_hosts", model->allowed_hosts);
+        writer->WriteInt32("tick_budget", model->tick_budget);
     }
 
     static bool SetDefaults()
@@ -618,6 +641,7 @@ namespace Config
             WriteNotifications(writer.get());
             WriteFont(writer.get());
             WritePlugin(writer.get());
+            fs.Flush();
             return true;
         }
         catch (const std::exception& ex)
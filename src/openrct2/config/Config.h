@@ -18,6 +18,7 @@
 enum class MeasurementFormat : int32_t;
 enum class TemperatureUnit : int32_t;
 enum class ScaleQuality : int32_t;
+enum class ResamplingQuality : int32_t;
 enum class Sort : int32_t;
 enum class VirtualFloorStyles : int32_t;
 enum class DrawingEngine : int32_t;
@@ -40,8 +41,13 @@ struct GeneralConfiguration
     ScaleQuality scale_quality;
     bool uncap_fps;
     bool use_vsync;
+    int32_t frame_rate_limit;
     bool show_fps;
     bool multithreading;
+    bool morton_tile_layout;
+    int32_t pathfinding_tick_budget;
+    bool multithreaded_pathfinding;
+    int32_t texture_memory_budget;
     bool minimize_fullscreen_focus_loss;
     bool disable_screensaver;
 
@@ -138,6 +144,7 @@ struct SoundConfiguration
     bool ride_music_enabled;
     uint8_t ride_music_volume;
     bool audio_focus;
+    ResamplingQuality resampling_quality;
 };
 
 struct NetworkConfiguration
@@ -162,6 +169,7 @@ struct NetworkConfiguration
     bool log_server_actions;
     bool pause_server_if_no_clients;
     bool desync_debugging;
+    int32_t stats_dump_interval;
 };
 
 struct NotificationConfiguration
@@ -208,6 +216,7 @@ struct PluginConfiguration
 {
     bool enable_hot_reloading;
     std::string allowed_hosts;
+    int32_t tick_budget;
 };
 
 enum class Sort : int32_t
@@ -231,6 +240,13 @@ enum class ScaleQuality : int32_t
     SmoothNearestNeighbour
 };
 
+enum class ResamplingQuality : int32_t
+{
+    Low,    // Linear interpolation for all sounds
+    Medium, // Linear interpolation for quiet sounds only
+    High,
+};
+
 enum class MeasurementFormat : int32_t
 {
     Imperial,
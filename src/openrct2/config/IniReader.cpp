@@ -17,6 +17,7 @@
 #include <cctype>
 #include <initializer_list>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -130,10 +131,10 @@ public:
     bool GetBoolean(const std::string& name, bool defaultValue) const override
     {
         bool result = defaultValue;
-        std::string value;
-        if (TryGetString(name, &value))
+        auto value = FindValue(name);
+        if (value != nullptr)
         {
-            result = String::Equals(value, "true", true);
+            result = String::Equals(*value, "true", true);
         }
         return result;
     }
@@ -141,12 +142,12 @@ public:
     int32_t GetInt32(const std::string& name, int32_t defaultValue) const override
     {
         int32_t result = defaultValue;
-        std::string value;
-        if (TryGetString(name, &value))
+        auto value = FindValue(name);
+        if (value != nullptr)
         {
             try
             {
-                result = std::stoi(value);
+                result = std::stoi(*value);
             }
             catch (const std::exception&)
             {
@@ -158,12 +159,12 @@ public:
     int64_t GetInt64(const std::string& name, int64_t defaultValue) const override
     {
         int64_t result = defaultValue;
-        std::string value;
-        if (TryGetString(name, &value))
+        auto value = FindValue(name);
+        if (value != nullptr)
         {
             try
             {
-                result = std::stoll(value);
+                result = std::stoll(*value);
             }
             catch (const std::exception&)
             {
@@ -175,12 +176,12 @@ public:
     float GetFloat(const std::string& name, float defaultValue) const override
     {
         float result = defaultValue;
-        std::string value;
-        if (TryGetString(name, &value))
+        auto value = FindValue(name);
+        if (value != nullptr)
         {
             try
             {
-                result = std::stof(value);
+                result = std::stof(*value);
             }
             catch (const std::exception&)
             {
@@ -201,17 +202,27 @@ public:
 
     bool TryGetString(const std::string& name, std::string* outValue) const override
     {
-        auto it = _values.find(name);
-        if (it == _values.end())
+        auto value = FindValue(name);
+        if (value == nullptr)
         {
             return false;
         }
 
-        *outValue = it->second;
+        *outValue = *value;
         return true;
     }
 
 private:
+    const std::string* FindValue(const std::string& name) const
+    {
+        auto it = _values.find(name);
+        if (it == _values.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
     void RemoveBOM()
     {
         if (_buffer.size() < 3)
@@ -256,14 +267,14 @@ private:
         std::string sectionName;
         LineRange lineRange;
 
+        std::string trimStorage;
         for (size_t i = 0; i < _lines.size(); i++)
         {
-            std::string line = GetLine(i);
-            line = String::Trim(line);
+            auto line = Trim(GetLine(i), trimStorage);
             if (line.size() > 3 && line[0] == '[')
             {
                 size_t endIndex = line.find_first_of(']');
-                if (endIndex != std::string::npos)
+                if (endIndex != std::string_view::npos)
                 {
                     // Add last section
                     if (!sectionName.empty())
@@ -273,7 +284,7 @@ private:
                     }
 
                     // Set up new section
-                    sectionName = line.substr(1, endIndex - 1);
+                    sectionName = std::string(line.substr(1, endIndex - 1));
                     lineRange.Start = i;
                 }
             }
@@ -297,26 +308,49 @@ private:
 
     void ParseValue(size_t lineIndex)
     {
-        std::string line = GetLine(lineIndex);
-        line = TrimComment(line);
+        auto line = TrimComment(GetLine(lineIndex));
 
         // Find assignment character
         size_t equalsIndex = line.find_first_of('=');
-        if (equalsIndex == std::string::npos)
+        if (equalsIndex == std::string_view::npos)
         {
             return;
         }
 
         // Get the key and value
-        std::string key = String::Trim(line.substr(0, equalsIndex));
-        std::string value = String::Trim(line.substr(equalsIndex + 1));
+        std::string keyStorage;
+        std::string valueStorage;
+        auto key = Trim(line.substr(0, equalsIndex), keyStorage);
+        auto value = Trim(line.substr(equalsIndex + 1), valueStorage);
 
         value = UnquoteValue(value);
-        value = UnescapeValue(value);
-        _values[key] = value;
+        _values.insert_or_assign(std::string(key), UnescapeValue(value));
+    }
+
+    /**
+     * Trims the white space off both ends of the string without copying it. Only when the string starts or ends with a
+     * multibyte character, which could be white space, is the full trim used with the given storage for its result.
+     */
+    static std::string_view Trim(std::string_view s, std::string& storage)
+    {
+        auto isAsciiSpace = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f'; };
+        while (!s.empty() && isAsciiSpace(s.front()))
+        {
+            s.remove_prefix(1);
+        }
+        while (!s.empty() && isAsciiSpace(s.back()))
+        {
+            s.remove_suffix(1);
+        }
+        if (!s.empty() && (static_cast<uint8_t>(s.front()) >= 0x80 || static_cast<uint8_t>(s.back()) >= 0x80))
+        {
+            storage = String::Trim(std::string(s));
+            return storage;
+        }
+        return s;
     }
 
-    std::string TrimComment(const std::string& s)
+    static std::string_view TrimComment(std::string_view s)
     {
         char inQuotes = 0;
         bool escaped = false;
@@ -340,9 +374,9 @@ private:
         return s;
     }
 
-    std::string UnquoteValue(const std::string& s)
+    static std::string_view UnquoteValue(std::string_view s)
     {
-        std::string result = s;
+        auto result = s;
         size_t length = s.size();
         if (length >= 2)
         {
@@ -354,11 +388,11 @@ private:
         return result;
     }
 
-    std::string UnescapeValue(const std::string& s)
+    static std::string UnescapeValue(std::string_view s)
     {
-        if (s.find_first_of('\\') == std::string::npos)
+        if (s.find_first_of('\\') == std::string_view::npos)
         {
-            return s;
+            return std::string(s);
         }
 
         bool escaped = false;
@@ -378,12 +412,11 @@ private:
         return sb.GetStdString();
     }
 
-    std::string GetLine(size_t index)
+    std::string_view GetLine(size_t index) const
     {
-        utf8* szBuffer = reinterpret_cast<utf8*>(_buffer.data());
+        auto szBuffer = reinterpret_cast<const utf8*>(_buffer.data());
         auto span = _lines[index];
-        auto line = std::string(szBuffer + span.Start, span.Length);
-        return line;
+        return std::string_view(szBuffer + span.Start, span.Length);
     }
 };
 
@@ -12,6 +12,8 @@
 #include "../common.h"
 #include "IStream.hpp"
 
+#include <vector>
+
 namespace OpenRCT2
 {
     /**
@@ -25,9 +27,22 @@ namespace OpenRCT2
         static constexpr uint64_t Seed = 0xcbf29ce484222325ULL;
         static constexpr uint64_t Prime = 0x00000100000001B3ULL;
 
+        std::vector<uint64_t>* _recordedWords = nullptr;
+
     public:
         ChecksumStream(std::array<std::byte, 20>& buf);
 
+        /**
+         * Appends every word that is checksummed from now on to the given list, until it is set to nullptr. Checksumming
+         * the recorded words again with WriteWords gives the same checksum as writing the data they came from.
+         */
+        void SetRecordedWords(std::vector<uint64_t>* words)
+        {
+            _recordedWords = words;
+        }
+
+        void WriteWords(const std::vector<uint64_t>& words);
+
         virtual ~ChecksumStream() = default;
 
         const void* GetData() const override
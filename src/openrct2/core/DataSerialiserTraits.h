@@ -23,11 +23,14 @@
 #include "Endianness.h"
 #include "MemoryStream.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 template<typename T> struct DataSerializerTraits_t
 {
@@ -294,6 +297,49 @@ template<> struct DataSerializerTraits_t<OpenRCT2::MemoryStream>
     }
 };
 
+/**
+ * Reads and writes runs of elements with a single stream call when the elements are stored as their own bytes: enums as
+ * they are in memory and integers in big endian order, which only needs a byte swap on little endian hosts.
+ */
+template<typename _Ty> struct DataSerializerTraitsBulk
+{
+    static constexpr bool IsSupported = std::is_enum_v<_Ty>
+        || std::is_base_of_v<DataSerializerTraitsIntegral<_Ty>, DataSerializerTraits_t<_Ty>>;
+
+    static void encode(OpenRCT2::IStream* stream, const _Ty* data, size_t count)
+    {
+        if constexpr (std::is_enum_v<_Ty> || sizeof(_Ty) == 1)
+        {
+            stream->Write(data, count * sizeof(_Ty));
+        }
+        else
+        {
+            constexpr size_t ChunkSize = 256 / sizeof(_Ty);
+            _Ty swapped[ChunkSize];
+            for (size_t i = 0; i < count; i += ChunkSize)
+            {
+                const size_t chunkCount = std::min(ChunkSize, count - i);
+                for (size_t j = 0; j < chunkCount; j++)
+                {
+                    swapped[j] = ByteSwapBE(data[i + j]);
+                }
+                stream->Write(swapped, chunkCount * sizeof(_Ty));
+            }
+        }
+    }
+    static void decode(OpenRCT2::IStream* stream, _Ty* data, size_t count)
+    {
+        stream->Read(data, count * sizeof(_Ty));
+        if constexpr (!std::is_enum_v<_Ty> && sizeof(_Ty) != 1)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                data[i] = ByteSwapBE(data[i]);
+            }
+        }
+    }
+};
+
 template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
 {
     static void encode(OpenRCT2::IStream* stream, const _Ty (&val)[_Size])
@@ -302,10 +348,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerTraitsBulk<_Ty>::IsSupported)
         {
-            s.encode(stream, sub);
+            DataSerializerTraitsBulk<_Ty>::encode(stream, std::data(val), std::size(val));
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, _Ty (&val)[_Size])
@@ -317,10 +370,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerTraitsBulk<_Ty>::IsSupported)
+        {
+            DataSerializerTraitsBulk<_Ty>::decode(stream, std::data(val), std::size(val));
+        }
+        else
         {
-            s.decode(stream, sub);
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.decode(stream, sub);
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const _Ty (&val)[_Size])
@@ -364,10 +424,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerTraitsBulk<_Ty>::IsSupported)
         {
-            s.encode(stream, sub);
+            DataSerializerTraitsBulk<_Ty>::encode(stream, std::data(val), std::size(val));
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, std::array<_Ty, _Size>& val)
@@ -379,10 +446,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerTraitsBulk<_Ty>::IsSupported)
+        {
+            DataSerializerTraitsBulk<_Ty>::decode(stream, std::data(val), std::size(val));
+        }
+        else
         {
-            s.decode(stream, sub);
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.decode(stream, sub);
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const std::array<_Ty, _Size>& val)
@@ -406,10 +480,17 @@ template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerTraitsBulk<_Ty>::IsSupported)
         {
-            s.encode(stream, sub);
+            DataSerializerTraitsBulk<_Ty>::encode(stream, std::data(val), std::size(val));
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, std::vector<_Ty>& val)
@@ -418,12 +499,21 @@ template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
         stream->Read(&len);
         len = ByteSwapBE(len);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto i = 0; i < len; ++i)
+        if constexpr (DataSerializerTraitsBulk<_Ty>::IsSupported)
         {
-            _Ty sub{};
-            s.decode(stream, sub);
-            val.push_back(std::move(sub));
+            const auto offset = val.size();
+            val.resize(offset + len);
+            DataSerializerTraitsBulk<_Ty>::decode(stream, val.data() + offset, len);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto i = 0; i < len; ++i)
+            {
+                _Ty sub{};
+                s.decode(stream, sub);
+                val.push_back(std::move(sub));
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const std::vector<_Ty>& val)
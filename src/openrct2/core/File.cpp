@@ -115,6 +115,7 @@ namespace File
     {
         auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_WRITE);
         fs.Write(buffer, length);
+        fs.Flush();
     }
 
     uint64_t GetLastModified(const std::string& path)
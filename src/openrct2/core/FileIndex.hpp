@@ -9,19 +9,25 @@
 
 #pragma once
 
+#include "../Context.h"
 #include "../common.h"
 #include "Console.hpp"
 #include "DataSerialiser.h"
 #include "File.h"
 #include "FileScanner.h"
 #include "FileStream.h"
-#include "JobPool.h"
+#include "MemoryStream.h"
 #include "Path.hpp"
+#include "TaskScheduler.h"
 
 #include <chrono>
-#include <list>
+#include <limits>
+#include <numeric>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
@@ -35,18 +41,50 @@ private:
         uint32_t PathChecksum = 0;
     };
 
+    // A file that has the same size and modification time as when it was indexed does not need to be indexed again.
+    struct FileStamp
+    {
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+
+        bool operator==(const FileStamp& other) const
+        {
+            return Size == other.Size && LastModified == other.LastModified;
+        }
+    };
+
     struct ScanResult
     {
         DirectoryStats const Stats;
         std::vector<std::string> const Files;
+        std::vector<FileStamp> const Stamps;
 
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
+        ScanResult(DirectoryStats stats, std::vector<std::string> files, std::vector<FileStamp> stamps)
             : Stats(stats)
-            , Files(files)
+            , Files(std::move(files))
+            , Stamps(std::move(stamps))
         {
         }
     };
 
+    static constexpr uint32_t NO_ITEM = std::numeric_limits<uint32_t>::max();
+
+    // Saved after the items for every file that was indexed, including the files no item could be created for.
+    struct IndexedFile
+    {
+        std::string Path;
+        FileStamp Stamp;
+        uint32_t ItemIndex = NO_ITEM;
+    };
+
+    struct LoadedIndex
+    {
+        // Whether the directories are unchanged since the index was written.
+        bool UpToDate = false;
+        std::vector<TItem> Items;
+        std::vector<IndexedFile> Files;
+    };
+
     struct FileIndexHeader
     {
         uint32_t HeaderSize = sizeof(FileIndexHeader);
@@ -59,7 +97,7 @@ private:
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -97,29 +135,24 @@ public:
     /**
      * Queries and directories and loads the index header. If the index is up to date,
      * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Only the files that were added or changed since the index was written are indexed again.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
         auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
-        if (std::get<0>(readIndexResult))
+        auto index = ReadIndexFile(language, scanResult.Stats);
+        if (index.UpToDate)
         {
             // Index was loaded
-            items = std::get<1>(readIndexResult);
+            return std::move(index.Items);
         }
-        else
-        {
-            // Index was not loaded
-            items = Build(language, scanResult);
-        }
-        return items;
+        return Build(language, scanResult, &index);
     }
 
     std::vector<TItem> Rebuild(int32_t language) const
     {
         auto scanResult = Scan();
-        auto items = Build(language, scanResult);
+        auto items = Build(language, scanResult, nullptr);
         return items;
     }
 
@@ -140,6 +173,7 @@ private:
     {
         DirectoryStats stats{};
         std::vector<std::string> files;
+        std::vector<FileStamp> stamps;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
@@ -160,19 +194,20 @@ private:
                 stats.PathChecksum += GetPathChecksum(path);
 
                 files.push_back(std::move(path));
+                stamps.push_back({ fileInfo->Size, fileInfo->LastModified });
             }
         }
-        return ScanResult(stats, files);
+        return ScanResult(stats, std::move(files), std::move(stamps));
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, const ScanResult& scanResult, const size_t* rangeStart, const size_t* rangeEnd,
+        std::vector<std::optional<TItem>>& fileItems, std::atomic<size_t>& processed, std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
-        for (size_t i = rangeStart; i < rangeEnd; i++)
+        for (auto it = rangeStart; it != rangeEnd; it++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            const auto fileIndex = *it;
+            const auto& filePath = scanResult.Files.at(fileIndex);
 
             if (_log_levels[static_cast<uint8_t>(DiagnosticLevel::Verbose)])
             {
@@ -183,28 +218,62 @@ private:
             auto item = Create(language, filePath);
             if (std::get<0>(item))
             {
-                items.push_back(std::get<1>(item));
+                fileItems[fileIndex] = std::move(std::get<1>(item));
             }
 
             processed++;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    /**
+     * Creates the items for the scanned files and writes the index. Files that have the same stamp as in the previous
+     * index keep the item they had, so only new and changed files are loaded.
+     */
+    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult, LoadedIndex* previousIndex) const
     {
-        std::vector<TItem> allItems;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
+        const size_t numFiles = scanResult.Files.size();
+        std::vector<std::optional<TItem>> fileItems(numFiles);
+        std::vector<size_t> filesToIndex;
+        if (previousIndex != nullptr && !previousIndex->Files.empty())
+        {
+            std::unordered_map<std::string_view, const IndexedFile*> previousFiles;
+            for (const auto& indexedFile : previousIndex->Files)
+            {
+                previousFiles.emplace(indexedFile.Path, &indexedFile);
+            }
+            for (size_t i = 0; i < numFiles; i++)
+            {
+                auto it = previousFiles.find(scanResult.Files[i]);
+                if (it == previousFiles.end() || !(it->second->Stamp == scanResult.Stamps[i]))
+                {
+                    filesToIndex.push_back(i);
+                }
+                else if (it->second->ItemIndex < previousIndex->Items.size())
+                {
+                    fileItems[i] = std::move(previousIndex->Items[it->second->ItemIndex]);
+                }
+            }
+        }
+        else
+        {
+            filesToIndex.resize(numFiles);
+            std::iota(filesToIndex.begin(), filesToIndex.end(), 0);
+        }
+
+        Console::WriteLine("Building %s (%zu items)", _name.c_str(), filesToIndex.size());
 
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        const size_t totalCount = scanResult.Files.size();
+        const size_t totalCount = filesToIndex.size();
         if (totalCount > 0)
         {
-            JobPool jobPool;
+            // Use the context's scheduler, commands that run without a context get a scheduler of their own.
+            auto context = OpenRCT2::GetContext();
+            std::optional<OpenRCT2::TaskScheduler> localScheduler;
+            auto& scheduler = context != nullptr ? context->GetTaskScheduler() : localScheduler.emplace();
+            OpenRCT2::TaskGroup tasks(scheduler);
             std::mutex printLock; // For verbose prints.
 
-            std::list<std::vector<TItem>> containers;
-
             size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
             std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
@@ -221,24 +290,36 @@ private:
                     stepSize = totalCount - rangeStart;
                 }
 
-                auto& items = containers.emplace_back();
-
-                jobPool.AddTask(std::bind(
-                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), rangeStart, rangeStart + stepSize,
-                    std::ref(items), std::ref(processed), std::ref(printLock)));
+                // Every range writes the items of different files, no locking is needed.
+                const size_t* first = filesToIndex.data() + rangeStart;
+                const size_t* last = first + stepSize;
+                tasks.Run([this, language, &scanResult, first, last, &fileItems, &processed, &printLock]() {
+                    BuildRange(language, scanResult, first, last, fileItems, processed, printLock);
+                });
 
                 reportProgress();
             }
 
-            jobPool.Join(reportProgress);
+            tasks.Wait(reportProgress);
+        }
 
-            for (const auto& itr : containers)
+        // Items are kept in the order of the files, the same as a full build.
+        std::vector<TItem> allItems;
+        std::vector<IndexedFile> indexedFiles;
+        indexedFiles.reserve(numFiles);
+        for (size_t i = 0; i < numFiles; i++)
+        {
+            auto& indexedFile = indexedFiles.emplace_back();
+            indexedFile.Path = scanResult.Files[i];
+            indexedFile.Stamp = scanResult.Stamps[i];
+            if (fileItems[i].has_value())
             {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
+                indexedFile.ItemIndex = static_cast<uint32_t>(allItems.size());
+                allItems.push_back(std::move(*fileItems[i]));
             }
         }
 
-        WriteIndexFile(language, scanResult.Stats, allItems);
+        WriteIndexFile(language, scanResult.Stats, allItems, indexedFiles);
 
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration<float>(endTime - startTime);
@@ -247,10 +328,21 @@ private:
         return allItems;
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    static void SerialiseIndexedFile(DataSerialiser& ds, IndexedFile& indexedFile)
     {
-        bool loadedItems = false;
-        std::vector<TItem> items;
+        ds << indexedFile.Path;
+        ds << indexedFile.Stamp.Size;
+        ds << indexedFile.Stamp.LastModified;
+        ds << indexedFile.ItemIndex;
+    }
+
+    /**
+     * Reads the index file. The items and the indexed files are also returned when the directories have changed since
+     * the index was written, so that the unchanged files do not need to be indexed again.
+     */
+    LoadedIndex ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    {
+        LoadedIndex index;
         if (File::Exists(_indexPath))
         {
             try
@@ -261,23 +353,36 @@ private:
                 // Read header, check if we need to re-scan
                 auto header = fs.ReadValue<FileIndexHeader>();
                 if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language)
                 {
-                    items.reserve(header.NumItems);
-                    DataSerialiser ds(false, fs);
-                    // Directory is the same, just read the saved items
+                    index.Items.reserve(header.NumItems);
+
+                    // Items are made of many small fields, read them from memory rather than separately from the file.
+                    std::vector<uint8_t> data(static_cast<size_t>(fs.GetLength() - fs.GetPosition()));
+                    fs.Read(data.data(), data.size());
+                    OpenRCT2::MemoryStream ms(data.data(), data.size());
+                    DataSerialiser ds(false, ms);
                     for (uint32_t i = 0; i < header.NumItems; i++)
                     {
                         TItem item;
                         Serialise(ds, item);
-                        items.emplace_back(std::move(item));
+                        index.Items.emplace_back(std::move(item));
                     }
-                    loadedItems = true;
+
+                    uint32_t numFiles{};
+                    ds << numFiles;
+                    index.Files.resize(numFiles);
+                    for (auto& indexedFile : index.Files)
+                    {
+                        SerialiseIndexedFile(ds, indexedFile);
+                    }
+
+                    index.UpToDate = header.Stats.TotalFiles == stats.TotalFiles
+                        && header.Stats.TotalFileSize == stats.TotalFileSize
+                        && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
+                        && header.Stats.PathChecksum == stats.PathChecksum;
                 }
-                else
+                if (!index.UpToDate)
                 {
                     Console::WriteLine("%s out of date", _name.c_str());
                 }
@@ -286,12 +391,14 @@ private:
             {
                 Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
                 Console::Error::WriteLine("%s", e.what());
+                index = {};
             }
         }
-        return std::make_tuple(loadedItems, std::move(items));
+        return index;
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, std::vector<TItem>& items) const
+    void WriteIndexFile(
+        int32_t language, const DirectoryStats& stats, std::vector<TItem>& items, std::vector<IndexedFile>& indexedFiles) const
     {
         try
         {
@@ -309,12 +416,23 @@ private:
             header.NumItems = static_cast<uint32_t>(items.size());
             fs.WriteValue(header);
 
-            DataSerialiser ds(true, fs);
+            OpenRCT2::MemoryStream ms;
+            DataSerialiser ds(true, ms);
             // Write items
             for (auto& item : items)
             {
                 Serialise(ds, item);
             }
+
+            // Write the files the items were created from
+            uint32_t numFiles = static_cast<uint32_t>(indexedFiles.size());
+            ds << numFiles;
+            for (auto& indexedFile : indexedFiles)
+            {
+                SerialiseIndexedFile(ds, indexedFile);
+            }
+            fs.Write(ms.GetData(), ms.GetLength());
+            fs.Flush();
         }
         catch (const std::exception& e)
         {
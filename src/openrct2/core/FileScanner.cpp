@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../Context.h"
 #include "../common.h"
 
 #ifdef _WIN32
@@ -14,7 +15,9 @@
 #endif
 
 #if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#    include <cstring>
 #    include <dirent.h>
+#    include <fcntl.h>
 #    include <sys/stat.h>
 #    include <sys/types.h>
 #    include <unistd.h>
@@ -27,8 +30,11 @@
 #include "Memory.hpp"
 #include "Path.hpp"
 #include "String.hpp"
+#include "TaskScheduler.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <stack>
 #include <string>
 #include <vector>
@@ -39,6 +45,8 @@ enum class DIRECTORY_CHILD_TYPE
     DC_FILE,
 };
 
+struct DirectoryListing;
+
 struct DirectoryChild
 {
     DIRECTORY_CHILD_TYPE Type;
@@ -47,6 +55,15 @@ struct DirectoryChild
     // Files only
     uint64_t Size = 0;
     uint64_t LastModified = 0;
+
+    // Directories only, the listing read ahead by a recursive scan
+    std::unique_ptr<DirectoryListing> Listing;
+};
+
+struct DirectoryListing
+{
+    std::string Path;
+    std::vector<DirectoryChild> Children;
 };
 
 static uint32_t GetPathChecksum(const utf8* path);
@@ -122,7 +139,14 @@ public:
         if (!_started)
         {
             _started = true;
-            PushState(_rootPath);
+            if (_recurse)
+            {
+                PushState(ReadTree(_rootPath));
+            }
+            else
+            {
+                PushState(_rootPath);
+            }
         }
 
         while (!_directoryStack.empty())
@@ -140,11 +164,18 @@ public:
                 {
                     if (_recurse)
                     {
-                        utf8 childPath[MAX_PATH];
-                        String::Set(childPath, sizeof(childPath), state->Path.c_str());
-                        Path::Append(childPath, sizeof(childPath), child->Name.c_str());
-
-                        PushState(childPath);
+                        if (child->Listing != nullptr)
+                        {
+                            PushState(std::move(*child->Listing));
+                        }
+                        else
+                        {
+                            utf8 childPath[MAX_PATH];
+                            String::Set(childPath, sizeof(childPath), state->Path.c_str());
+                            Path::Append(childPath, sizeof(childPath), child->Name.c_str());
+
+                            PushState(childPath);
+                        }
                     }
                 }
                 else if (PatternMatch(child->Name))
@@ -171,7 +202,53 @@ private:
         newState.Path = directory;
         newState.Index = -1;
         GetDirectoryChildren(newState.Listing, directory);
-        _directoryStack.push(newState);
+        _directoryStack.push(std::move(newState));
+    }
+
+    void PushState(DirectoryListing&& listing)
+    {
+        DirectoryState newState;
+        newState.Path = std::move(listing.Path);
+        newState.Listing = std::move(listing.Children);
+        newState.Index = -1;
+        _directoryStack.push(std::move(newState));
+    }
+
+    /**
+     * Reads the listings of the directory and all its sub directories up front. Each directory is read on its own task,
+     * so the round trips of slow (e.g. network) file systems overlap. The listings are kept in the tree they were found
+     * in, so the files are still returned in the same order as a scan that reads one directory at a time.
+     */
+    DirectoryListing ReadTree(const std::string& path)
+    {
+        // Use the context's scheduler, scans that run without a context get a scheduler of their own.
+        auto context = OpenRCT2::GetContext();
+        std::optional<OpenRCT2::TaskScheduler> localScheduler;
+        auto& scheduler = context != nullptr ? context->GetTaskScheduler() : localScheduler.emplace();
+
+        DirectoryListing root;
+        root.Path = path;
+        OpenRCT2::TaskGroup tasks(scheduler);
+        ReadListing(tasks, &root);
+        tasks.Wait();
+        return root;
+    }
+
+    void ReadListing(OpenRCT2::TaskGroup& tasks, DirectoryListing* listing)
+    {
+        // The children are not added to or removed from after this, the tasks can keep pointers to their listings.
+        GetDirectoryChildren(listing->Children, listing->Path);
+        for (auto& child : listing->Children)
+        {
+            if (child.Type == DIRECTORY_CHILD_TYPE::DC_DIRECTORY)
+            {
+                child.Listing = std::make_unique<DirectoryListing>();
+                child.Listing->Path = Path::Combine(listing->Path, child.Name);
+
+                auto childListing = child.Listing.get();
+                tasks.Run([this, &tasks, childListing]() { ReadListing(tasks, childListing); });
+            }
+        }
     }
 
     bool PatternMatch(const std::string& fileName)
@@ -228,8 +305,10 @@ public:
         auto pattern = path + "\\*";
         auto wPattern = String::ToWideChar(pattern.c_str());
 
+        // The short names are not needed and a larger buffer means fewer round trips on network shares.
         WIN32_FIND_DATAW findData;
-        HANDLE hFile = FindFirstFileW(wPattern.c_str(), &findData);
+        HANDLE hFile = FindFirstFileExW(
+            wPattern.c_str(), FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
         if (hFile != INVALID_HANDLE_VALUE)
         {
             do
@@ -278,30 +357,34 @@ public:
 
     void GetDirectoryChildren(std::vector<DirectoryChild>& children, const std::string& path) override
     {
-        struct dirent** namelist;
-        int32_t count = scandir(path.c_str(), &namelist, FilterFunc, alphasort);
-        if (count > 0)
+        DIR* dir = opendir(path.c_str());
+        if (dir == nullptr)
         {
-            for (int32_t i = 0; i < count; i++)
+            return;
+        }
+
+        // The entries are looked up relative to the open directory, so the path does not have to be resolved again
+        // for each of them.
+        const int32_t dirFd = dirfd(dir);
+        const size_t firstChild = children.size();
+        const struct dirent* node;
+        while ((node = readdir(dir)) != nullptr)
+        {
+            if (!String::Equals(node->d_name, ".") && !String::Equals(node->d_name, ".."))
             {
-                const struct dirent* node = namelist[i];
-                if (!String::Equals(node->d_name, ".") && !String::Equals(node->d_name, ".."))
-                {
-                    children.push_back(CreateChild(path.c_str(), node));
-                }
-                free(namelist[i]);
+                children.push_back(CreateChild(dirFd, node));
             }
-            free(namelist);
         }
-    }
+        closedir(dir);
 
-private:
-    static int32_t FilterFunc(const struct dirent* d)
-    {
-        return 1;
+        // Same order as scandir with alphasort.
+        std::sort(children.begin() + firstChild, children.end(), [](const DirectoryChild& a, const DirectoryChild& b) {
+            return strcoll(a.Name.c_str(), b.Name.c_str()) < 0;
+        });
     }
 
-    static DirectoryChild CreateChild(const utf8* directory, const struct dirent* node)
+private:
+    static DirectoryChild CreateChild(int32_t dirFd, const struct dirent* node)
     {
         DirectoryChild result;
         result.Name = std::string(node->d_name);
@@ -313,16 +396,10 @@ private:
         {
             result.Type = DIRECTORY_CHILD_TYPE::DC_FILE;
 
-            // Get the full path of the file
-            size_t pathSize = String::SizeOf(directory) + 1 + String::SizeOf(node->d_name) + 1;
-            utf8* path = Memory::Allocate<utf8>(pathSize);
-            String::Set(path, pathSize, directory);
-            Path::Append(path, pathSize, node->d_name);
-
             struct stat statInfo
             {
             };
-            int32_t statRes = stat(path, &statInfo);
+            int32_t statRes = fstatat(dirFd, node->d_name, &statInfo, 0);
             if (statRes != -1)
             {
                 result.Size = statInfo.st_size;
@@ -333,8 +410,6 @@ private:
                     result.Type = DIRECTORY_CHILD_TYPE::DC_DIRECTORY;
                 }
             }
-
-            Memory::Free(path);
         }
         return result;
     }
@@ -9,6 +9,7 @@
 
 #include "FileStream.h"
 
+#include "../Diagnostic.h"
 #include "Path.hpp"
 #include "String.hpp"
 
@@ -32,17 +33,17 @@
 
 namespace OpenRCT2
 {
-    FileStream::FileStream(const fs::path& path, int32_t fileMode)
-        : FileStream(path.u8string(), fileMode)
+    FileStream::FileStream(const fs::path& path, int32_t fileMode, size_t bufferSize)
+        : FileStream(path.u8string(), fileMode, bufferSize)
     {
     }
 
-    FileStream::FileStream(const std::string& path, int32_t fileMode)
-        : FileStream(path.c_str(), fileMode)
+    FileStream::FileStream(const std::string& path, int32_t fileMode, size_t bufferSize)
+        : FileStream(path.c_str(), fileMode, bufferSize)
     {
     }
 
-    FileStream::FileStream(const utf8* path, int32_t fileMode)
+    FileStream::FileStream(const utf8* path, int32_t fileMode, size_t bufferSize)
     {
         const char* mode;
         switch (fileMode)
@@ -108,6 +109,25 @@ namespace OpenRCT2
 #endif
 
         _ownsFilePtr = true;
+
+        if (fileMode == FILE_MODE_APPEND)
+        {
+            _filePosition = _fileSize;
+            _bufferPosition = _fileSize;
+        }
+
+        // There is no point in a buffer larger than a file that is only read
+        if (fileMode == FILE_MODE_OPEN)
+        {
+            bufferSize = static_cast<size_t>(std::min<uint64_t>(bufferSize, _fileSize));
+        }
+        if (bufferSize != 0)
+        {
+            // The stream's own buffer replaces the C library's, rather than the data being copied through both
+            setvbuf(_file, nullptr, _IONBF, 0);
+            _buffer.reset(new uint8_t[bufferSize]);
+            _bufferSize = bufferSize;
+        }
     }
 
     FileStream::~FileStream()
@@ -115,6 +135,14 @@ namespace OpenRCT2
         if (!_disposed)
         {
             _disposed = true;
+            try
+            {
+                Flush();
+            }
+            catch (const std::exception& e)
+            {
+                log_error("%s", e.what());
+            }
             if (_ownsFilePtr)
             {
                 fclose(_file);
@@ -139,7 +167,7 @@ namespace OpenRCT2
 
     uint64_t FileStream::GetPosition() const
     {
-        return ftello(_file);
+        return _bufferPosition + _bufferOffset;
     }
 
     void FileStream::SetPosition(uint64_t position)
@@ -149,48 +177,229 @@ namespace OpenRCT2
 
     void FileStream::Seek(int64_t offset, int32_t origin)
     {
+        uint64_t position;
         switch (origin)
         {
             case STREAM_SEEK_BEGIN:
-                fseeko(_file, offset, SEEK_SET);
+                position = offset;
                 break;
             case STREAM_SEEK_CURRENT:
-                fseeko(_file, offset, SEEK_CUR);
+                position = GetPosition() + offset;
                 break;
             case STREAM_SEEK_END:
-                fseeko(_file, offset, SEEK_END);
+                position = _fileSize + offset;
                 break;
+            default:
+                return;
+        }
+
+        // Moving within the data that has been read ahead keeps it
+        if (!_bufferDirty && position >= _bufferPosition && position <= _bufferPosition + _bufferLength)
+        {
+            _bufferOffset = static_cast<size_t>(position - _bufferPosition);
+            return;
         }
+
+        FlushBuffer();
+        _bufferPosition = position;
+        _bufferLength = 0;
+        _bufferOffset = 0;
     }
 
     void FileStream::Read(void* buffer, uint64_t length)
     {
-        if (fread(buffer, 1, static_cast<size_t>(length), _file) == length)
+        if (TryRead(buffer, length) == length)
         {
             return;
         }
         throw IOException("Attempted to read past end of file.");
     }
 
+    void FileStream::Read1(void* buffer)
+    {
+        Read<1>(buffer);
+    }
+
+    void FileStream::Read2(void* buffer)
+    {
+        Read<2>(buffer);
+    }
+
+    void FileStream::Read4(void* buffer)
+    {
+        Read<4>(buffer);
+    }
+
+    void FileStream::Read8(void* buffer)
+    {
+        Read<8>(buffer);
+    }
+
+    void FileStream::Read16(void* buffer)
+    {
+        Read<16>(buffer);
+    }
+
     void FileStream::Write(const void* buffer, uint64_t length)
     {
         if (length == 0)
         {
             return;
         }
-        if (fwrite(buffer, static_cast<size_t>(length), 1, _file) != 1)
+
+        if (!_bufferDirty)
         {
-            throw IOException("Unable to write to file.");
+            // Collect writes from the current position, any data that was read ahead is dropped
+            _bufferPosition = GetPosition();
+            _bufferLength = 0;
+            _bufferOffset = 0;
+            _bufferDirty = true;
         }
 
-        uint64_t position = GetPosition();
-        _fileSize = std::max(_fileSize, position);
+        if (length > _bufferSize - _bufferLength)
+        {
+            FlushBuffer();
+            if (length >= _bufferSize)
+            {
+                // Too large to be worth collecting, write it straight to the file
+                WriteToFile(buffer, static_cast<size_t>(length));
+                _bufferPosition += length;
+                _fileSize = std::max(_fileSize, _bufferPosition);
+                return;
+            }
+            _bufferDirty = true;
+        }
+
+        std::memcpy(_buffer.get() + _bufferLength, buffer, static_cast<size_t>(length));
+        _bufferLength += static_cast<size_t>(length);
+        _bufferOffset = _bufferLength;
+        _fileSize = std::max(_fileSize, _bufferPosition + _bufferLength);
+    }
+
+    void FileStream::Write1(const void* buffer)
+    {
+        Write<1>(buffer);
+    }
+
+    void FileStream::Write2(const void* buffer)
+    {
+        Write<2>(buffer);
+    }
+
+    void FileStream::Write4(const void* buffer)
+    {
+        Write<4>(buffer);
+    }
+
+    void FileStream::Write8(const void* buffer)
+    {
+        Write<8>(buffer);
+    }
+
+    void FileStream::Write16(const void* buffer)
+    {
+        Write<16>(buffer);
     }
 
     uint64_t FileStream::TryRead(void* buffer, uint64_t length)
     {
-        size_t readBytes = fread(buffer, 1, static_cast<size_t>(length), _file);
-        return readBytes;
+        FlushBuffer();
+
+        auto dst = static_cast<uint8_t*>(buffer);
+        auto readLength = static_cast<size_t>(std::min<uint64_t>(length, _bufferLength - _bufferOffset));
+        if (readLength != 0)
+        {
+            std::memcpy(dst, _buffer.get() + _bufferOffset, readLength);
+            _bufferOffset += readLength;
+        }
+
+        auto remainingLength = static_cast<size_t>(length) - readLength;
+        if (remainingLength != 0)
+        {
+            // The buffer has been used up, so the stream is at its end
+            _bufferPosition += _bufferLength;
+            _bufferLength = 0;
+            _bufferOffset = 0;
+            if (remainingLength >= _bufferSize)
+            {
+                auto fileReadLength = ReadFromFile(dst + readLength, remainingLength);
+                _bufferPosition += fileReadLength;
+                readLength += fileReadLength;
+            }
+            else
+            {
+                _bufferLength = ReadFromFile(_buffer.get(), _bufferSize);
+                auto bufferReadLength = std::min(remainingLength, _bufferLength);
+                std::memcpy(dst + readLength, _buffer.get(), bufferReadLength);
+                _bufferOffset = bufferReadLength;
+                readLength += bufferReadLength;
+            }
+        }
+        return readLength;
+    }
+
+    void FileStream::Flush()
+    {
+        FlushBuffer();
+        if (_canWrite && fflush(_file) != 0)
+        {
+            throw IOException("Unable to write to file.");
+        }
+    }
+
+    void FileStream::FlushBuffer()
+    {
+        if (_bufferDirty)
+        {
+            _bufferDirty = false;
+            if (_bufferLength != 0)
+            {
+                WriteToFile(_buffer.get(), _bufferLength);
+            }
+            _bufferPosition += _bufferLength;
+            _bufferLength = 0;
+            _bufferOffset = 0;
+        }
+    }
+
+    void FileStream::MoveFilePosition(uint64_t position, FileAccess access)
+    {
+        // The C library requires the file to be positioned between reading and writing, even at the same position
+        if (_filePosition != position || (_fileAccess != access && _fileAccess != FileAccess::None))
+        {
+            if (fseeko(_file, position, SEEK_SET) != 0)
+            {
+                _fileAccess = FileAccess::None;
+                throw IOException("Unable to seek file.");
+            }
+            _filePosition = position;
+        }
+        _fileAccess = access;
+    }
+
+    /**
+     * Reads from the file at _bufferPosition, which is where the buffer starts.
+     */
+    size_t FileStream::ReadFromFile(void* buffer, size_t length)
+    {
+        MoveFilePosition(_bufferPosition, FileAccess::Read);
+        auto readLength = fread(buffer, 1, length, _file);
+        _filePosition += readLength;
+        return readLength;
+    }
+
+    /**
+     * Writes to the file at _bufferPosition, which is where the buffer starts.
+     */
+    void FileStream::WriteToFile(const void* buffer, size_t length)
+    {
+        MoveFilePosition(_bufferPosition, FileAccess::Write);
+        if (fwrite(buffer, length, 1, _file) != 1)
+        {
+            _fileAccess = FileAccess::None;
+            throw IOException("Unable to write to file.");
+        }
+        _filePosition += length;
     }
 
     const void* FileStream::GetData() const
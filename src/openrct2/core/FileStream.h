@@ -13,6 +13,10 @@
 #include "FileSystem.hpp"
 #include "IStream.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
 namespace OpenRCT2
 {
     enum
@@ -23,11 +27,24 @@ namespace OpenRCT2
     };
 
     /**
-     * A stream for reading and writing to files.
+     * A stream for reading and writing to files. Reads and writes go through a buffer of the stream's own, so that
+     * serialising many small values does not cost a call into the C library each. Reads fill the buffer with the data
+     * that follows, writes are collected in it until it is full or the stream moves elsewhere. A buffer size of 0 leaves
+     * buffering to the C library.
      */
     class FileStream final : public IStream
     {
+    public:
+        static constexpr size_t DefaultBufferSize = 64 * 1024;
+
     private:
+        enum class FileAccess : uint8_t
+        {
+            None,
+            Read,
+            Write,
+        };
+
         FILE* _file = nullptr;
         bool _ownsFilePtr = false;
         bool _canRead = false;
@@ -35,10 +52,23 @@ namespace OpenRCT2
         bool _disposed = false;
         uint64_t _fileSize = 0;
 
+        // Where the C library's file position is and what it was last used for, so it is only moved when necessary.
+        uint64_t _filePosition = 0;
+        FileAccess _fileAccess = FileAccess::None;
+
+        // The buffer holds the data of the file from _bufferPosition, either read ahead or waiting to be written
+        // when _bufferDirty is set. The stream's position is _bufferPosition + _bufferOffset.
+        std::unique_ptr<uint8_t[]> _buffer;
+        size_t _bufferSize = 0;
+        uint64_t _bufferPosition = 0;
+        size_t _bufferLength = 0;
+        size_t _bufferOffset = 0;
+        bool _bufferDirty = false;
+
     public:
-        FileStream(const fs::path& path, int32_t fileMode);
-        FileStream(const std::string& path, int32_t fileMode);
-        FileStream(const utf8* path, int32_t fileMode);
+        FileStream(const fs::path& path, int32_t fileMode, size_t bufferSize = DefaultBufferSize);
+        FileStream(const std::string& path, int32_t fileMode, size_t bufferSize = DefaultBufferSize);
+        FileStream(const utf8* path, int32_t fileMode, size_t bufferSize = DefaultBufferSize);
         ~FileStream() override;
 
         bool CanRead() const override;
@@ -49,10 +79,63 @@ namespace OpenRCT2
 
         void SetPosition(uint64_t position) override;
         void Seek(int64_t offset, int32_t origin) override;
+
         void Read(void* buffer, uint64_t length) override;
+        void Read1(void* buffer) override;
+        void Read2(void* buffer) override;
+        void Read4(void* buffer) override;
+        void Read8(void* buffer) override;
+        void Read16(void* buffer) override;
+
+        template<size_t N> void Read(void* buffer)
+        {
+            if (!_bufferDirty && _bufferLength - _bufferOffset >= N)
+            {
+                std::memcpy(buffer, _buffer.get() + _bufferOffset, N);
+                _bufferOffset += N;
+            }
+            else
+            {
+                Read(buffer, N);
+            }
+        }
+
         void Write(const void* buffer, uint64_t length) override;
+        void Write1(const void* buffer) override;
+        void Write2(const void* buffer) override;
+        void Write4(const void* buffer) override;
+        void Write8(const void* buffer) override;
+        void Write16(const void* buffer) override;
+
+        template<size_t N> void Write(const void* buffer)
+        {
+            if (_bufferDirty && _bufferSize - _bufferLength >= N)
+            {
+                std::memcpy(_buffer.get() + _bufferLength, buffer, N);
+                _bufferLength += N;
+                _bufferOffset = _bufferLength;
+                _fileSize = std::max(_fileSize, _bufferPosition + _bufferLength);
+            }
+            else
+            {
+                Write(buffer, N);
+            }
+        }
+
         uint64_t TryRead(void* buffer, uint64_t length) override;
         const void* GetData() const override;
+
+        /**
+         * Writes any buffered data to the file. Throws an IOException if it can not be written, which the destructor
+         * can only log, so streams that are written to should be flushed before they are closed.
+         */
+        void Flush();
+
+    private:
+        void FlushBuffer();
+        void MoveFilePosition(uint64_t position, FileAccess access);
+        size_t ReadFromFile(void* buffer, size_t length);
+        void WriteToFile(const void* buffer, size_t length);
     };
 
 } // namespace OpenRCT2
@@ -7,7 +7,9 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdio>
 #include <stdexcept>
 
@@ -15,6 +17,7 @@
 #    include <windows.h>
 #elif defined(__linux__)
 #    include <fcntl.h>
+#    include <poll.h>
 #    include <sys/inotify.h>
 #    include <sys/types.h>
 #    include <unistd.h>
@@ -60,7 +63,7 @@ void FileWatcher::FileDescriptor::Close()
 
 FileWatcher::WatchDescriptor::WatchDescriptor(int fd, const std::string& path)
     : Fd(fd)
-    , Wd(inotify_add_watch(fd, path.c_str(), IN_CLOSE_WRITE))
+    , Wd(inotify_add_watch(fd, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE))
     , Path(path)
 {
     if (Wd >= 0)
@@ -79,9 +82,25 @@ FileWatcher::WatchDescriptor::~WatchDescriptor()
     inotify_rm_watch(Fd, Wd);
     log_verbose("FileWatcher: inotify watch removed");
 }
+
+/**
+ * Watches the directory and every directory below it, inotify does not watch directory trees by itself.
+ */
+void FileWatcher::AddWatches(const std::string& directoryPath)
+{
+    _watchDescs.push_back(std::make_unique<WatchDescriptor>(_fileDesc.Fd, directoryPath));
+    for (auto& p : fs::recursive_directory_iterator(directoryPath))
+    {
+        if (p.status().type() == fs::file_type::directory)
+        {
+            _watchDescs.push_back(std::make_unique<WatchDescriptor>(_fileDesc.Fd, p.path().string()));
+        }
+    }
+}
 #endif
 
-FileWatcher::FileWatcher(const std::string& directoryPath)
+FileWatcher::FileWatcher(const std::string& directoryPath, ChangedCallback onFileChanged)
+    : _onFileChanged(std::move(onFileChanged))
 {
 #ifdef _WIN32
     _path = directoryPath;
@@ -94,14 +113,7 @@ FileWatcher::FileWatcher(const std::string& directoryPath)
     }
 #elif defined(__linux__)
     _fileDesc.Initialise();
-    _watchDescs.emplace_back(_fileDesc.Fd, directoryPath);
-    for (auto& p : fs::recursive_directory_iterator(directoryPath))
-    {
-        if (p.status().type() == fs::file_type::directory)
-        {
-            _watchDescs.emplace_back(_fileDesc.Fd, p.path().string());
-        }
-    }
+    AddWatches(directoryPath);
 #else
     throw std::runtime_error("FileWatcher not supported on this platform.");
 #endif
@@ -120,8 +132,8 @@ FileWatcher::~FileWatcher()
 #    endif
     CloseHandle(_directoryHandle);
 #elif defined(__linux__)
+    // The watch thread wakes up regularly to check this, the descriptors are closed once it has stopped
     _finished = true;
-    _fileDesc.Close();
 #else
     return;
 #endif
@@ -131,15 +143,16 @@ FileWatcher::~FileWatcher()
 void FileWatcher::WatchDirectory()
 {
 #if defined(_WIN32)
-    std::array<char, 1024> eventData;
+    std::array<char, 16384> eventData;
     DWORD bytesReturned;
     while (ReadDirectoryChangesW(
-        _directoryHandle, eventData.data(), static_cast<DWORD>(eventData.size()), TRUE, FILE_NOTIFY_CHANGE_LAST_WRITE,
-        &bytesReturned, nullptr, nullptr))
+        _directoryHandle, eventData.data(), static_cast<DWORD>(eventData.size()), TRUE,
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, &bytesReturned, nullptr, nullptr))
     {
-        auto onFileChanged = OnFileChanged;
-        if (onFileChanged)
+        if (_onFileChanged && bytesReturned != 0)
         {
+            // A single save often produces several notifications for the same file, only report it once
+            std::vector<std::string> changedPaths;
             FILE_NOTIFY_INFORMATION* notifyInfo;
             size_t offset = 0;
             do
@@ -147,52 +160,106 @@ void FileWatcher::WatchDirectory()
                 notifyInfo = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(eventData.data() + offset);
                 offset += notifyInfo->NextEntryOffset;
 
+                if (notifyInfo->Action == FILE_ACTION_REMOVED || notifyInfo->Action == FILE_ACTION_RENAMED_OLD_NAME)
+                    continue;
+
                 std::wstring fileNameW(notifyInfo->FileName, notifyInfo->FileNameLength / sizeof(wchar_t));
                 auto fileName = String::ToUtf8(fileNameW);
-                auto path = fs::path(_path) / fs::path(fileName);
-                onFileChanged(path.u8string());
+                auto path = (fs::path(_path) / fs::path(fileName)).u8string();
+                if (std::find(changedPaths.begin(), changedPaths.end(), path) == changedPaths.end())
+                {
+                    changedPaths.push_back(std::move(path));
+                }
             } while (notifyInfo->NextEntryOffset != 0);
+
+            for (const auto& path : changedPaths)
+            {
+                _onFileChanged(path);
+            }
         }
     }
 #elif defined(__linux__)
+    // Changed files are held back until nothing has happened to them for a moment, editors tend to write a file in
+    // several steps and the file should only be picked up once it is complete.
+    constexpr auto DebounceTime = std::chrono::milliseconds(250);
+
     log_verbose("FileWatcher: reading event data...");
-    std::array<char, 1024> eventData;
+    alignas(inotify_event) std::array<char, 4096> eventData;
+    std::vector<std::string> pendingPaths;
+    auto lastEventTime = std::chrono::steady_clock::now();
     while (!_finished)
     {
-        int length = read(_fileDesc.Fd, eventData.data(), eventData.size());
-        if (length >= 0)
+        pollfd pollDesc{};
+        pollDesc.fd = _fileDesc.Fd;
+        pollDesc.events = POLLIN;
+        if (poll(&pollDesc, 1, pendingPaths.empty() ? 500 : 50) > 0 && (pollDesc.revents & POLLIN))
         {
-            log_verbose("FileWatcher: inotify event data received");
-            auto onFileChanged = OnFileChanged;
-            if (onFileChanged)
+            ssize_t length;
+            while ((length = read(_fileDesc.Fd, eventData.data(), eventData.size())) > 0)
             {
-                int offset = 0;
+                log_verbose("FileWatcher: inotify event data received");
+                ssize_t offset = 0;
                 while (offset < length)
                 {
                     auto e = reinterpret_cast<inotify_event*>(eventData.data() + offset);
-                    if ((e->mask & IN_CLOSE_WRITE) && !(e->mask & IN_ISDIR))
+                    offset += sizeof(inotify_event) + e->len;
+
+                    // Find watch descriptor
+                    int wd = e->wd;
+                    auto findResult = std::find_if(
+                        _watchDescs.begin(), _watchDescs.end(),
+                        [wd](const std::unique_ptr<WatchDescriptor>& watchDesc) { return wd == watchDesc->Wd; });
+                    if (findResult == _watchDescs.end())
+                        continue;
+
+                    if (e->mask & IN_IGNORED)
                     {
-                        log_verbose("FileWatcher: inotify event received for %s", e->name);
+                        // The directory has gone, so has its watch
+                        _watchDescs.erase(findResult);
+                        continue;
+                    }
+                    if (e->len == 0)
+                        continue;
 
-                        // Find watch descriptor
-                        int wd = e->wd;
-                        auto findResult = std::find_if(
-                            _watchDescs.begin(), _watchDescs.end(),
-                            [wd](const WatchDescriptor& watchDesc) { return wd == watchDesc.Wd; });
-                        if (findResult != _watchDescs.end())
+                    auto path = (fs::path((*findResult)->Path) / fs::path(e->name)).string();
+                    if (e->mask & IN_ISDIR)
+                    {
+                        if (e->mask & (IN_CREATE | IN_MOVED_TO))
                         {
-                            auto directory = findResult->Path;
-                            auto path = fs::path(directory) / fs::path(e->name);
-                            onFileChanged(path);
+                            try
+                            {
+                                AddWatches(path);
+                            }
+                            catch (const std::exception& ex)
+                            {
+                                log_verbose("FileWatcher: unable to watch new directory: %s", ex.what());
+                            }
                         }
                     }
-                    offset += sizeof(inotify_event) + e->len;
+                    else if (e->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                    {
+                        log_verbose("FileWatcher: inotify event received for %s", e->name);
+                        if (std::find(pendingPaths.begin(), pendingPaths.end(), path) == pendingPaths.end())
+                        {
+                            pendingPaths.push_back(std::move(path));
+                        }
+                        lastEventTime = std::chrono::steady_clock::now();
+                    }
                 }
             }
         }
 
-        // Sleep for 1/2 second
-        usleep(500000);
+        if (!pendingPaths.empty() && std::chrono::steady_clock::now() - lastEventTime >= DebounceTime)
+        {
+            if (_onFileChanged)
+            {
+                for (const auto& path : pendingPaths)
+                {
+                    _onFileChanged(path);
+                }
+            }
+            pendingPaths.clear();
+        }
     }
 #endif
 }
@@ -9,7 +9,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <string>
 #include <thread>
 #include <vector>
@@ -19,12 +21,17 @@ typedef void* HANDLE;
 #endif
 
 /**
- * Creates a new thread that watches a directory tree for file modifications.
+ * Creates a new thread that watches a directory tree for file modifications. Changes are reported on the watch thread
+ * once a file has been quiet for a short while, so a burst of writes to the same file is only reported once.
  */
 class FileWatcher
 {
+public:
+    using ChangedCallback = std::function<void(const std::string& path)>;
+
 private:
     std::thread _watchThread;
+    ChangedCallback const _onFileChanged;
 #if defined(_WIN32)
     std::string _path;
     HANDLE _directoryHandle{};
@@ -49,19 +56,27 @@ private:
     };
 
     FileDescriptor _fileDesc;
-    std::vector<WatchDescriptor> _watchDescs;
+    std::vector<std::unique_ptr<WatchDescriptor>> _watchDescs;
 #endif
 
 public:
-    std::function<void(const std::string& path)> OnFileChanged;
-
-    FileWatcher(const std::string& directoryPath);
+    /**
+     * @param onFileChanged Called on the watch thread with the path of each file that has been written, created or
+     *                      moved into the directory tree.
+     */
+    FileWatcher(const std::string& directoryPath, ChangedCallback onFileChanged);
     ~FileWatcher();
 
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
 private:
 #if defined(_WIN32) || defined(__linux__)
-    bool _finished{};
+    std::atomic_bool _finished{};
 #endif
 
+#if defined(__linux__)
+    void AddWatches(const std::string& directoryPath);
+#endif
     void WatchDirectory();
 };
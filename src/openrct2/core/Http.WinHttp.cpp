@@ -172,6 +172,13 @@ namespace Http
             if (hSession == nullptr)
                 ThrowWin32Exception("WinHttpOpen");
 
+            if (req.timeout != 0)
+            {
+                auto timeoutMs = static_cast<int>(req.timeout * 1000);
+                if (!WinHttpSetTimeouts(hSession, timeoutMs, timeoutMs, timeoutMs, timeoutMs))
+                    ThrowWin32Exception("WinHttpSetTimeouts");
+            }
+
             auto wHostName = std::wstring(url.lpszHostName, url.dwHostNameLength);
             hConnect = WinHttpConnect(hSession, wHostName.c_str(), url.nPort, 0);
             if (hConnect == nullptr)
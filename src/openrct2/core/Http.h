@@ -49,6 +49,8 @@ namespace Http
         Method method = Method::GET;
         std::string body = "";
         bool forceIPv4 = false;
+        // Maximum time in seconds the whole request may take, 0 for no limit.
+        uint32_t timeout = 0;
     };
 
     Response Do(const Request& req);
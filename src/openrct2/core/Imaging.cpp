@@ -13,16 +13,19 @@
 
 #include "../Version.h"
 #include "../drawing/Drawing.h"
+#include "../util/Util.h"
 #include "Guard.hpp"
 #include "IStream.hpp"
 #include "Memory.hpp"
 #include "String.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <png.h>
 #include <stdexcept>
 #include <unordered_map>
+#include <zlib.h>
 
 namespace Imaging
 {
@@ -162,14 +165,89 @@ namespace Imaging
         }
     }
 
-    static void WritePng(std::ostream& ostream, const Image& image)
+    class PngWriter
     {
-        png_structp png_ptr = nullptr;
-        png_colorp png_palette = nullptr;
-        try
+    private:
+        png_structp _png{};
+        png_infop _info{};
+        png_colorp _palette{};
+
+    public:
+        PngWriter(std::ostream& ostream, const Image& image)
         {
-            png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
-            if (png_ptr == nullptr)
+            try
+            {
+                WriteHeader(ostream, image);
+            }
+            catch (const std::exception&)
+            {
+                Release();
+                throw;
+            }
+        }
+
+        ~PngWriter()
+        {
+            Release();
+        }
+
+        PngWriter(const PngWriter&) = delete;
+        PngWriter& operator=(const PngWriter&) = delete;
+
+        void WriteRows(const uint8_t* pixels, uint32_t rows, uint32_t stride)
+        {
+            // Set error handler
+            if (setjmp(png_jmpbuf(_png)))
+            {
+                throw std::runtime_error("PNG ERROR");
+            }
+
+            for (uint32_t y = 0; y < rows; y++)
+            {
+                png_write_row(_png, const_cast<png_byte*>(pixels));
+                pixels += stride;
+            }
+        }
+
+        void Finish()
+        {
+            // Set error handler
+            if (setjmp(png_jmpbuf(_png)))
+            {
+                throw std::runtime_error("PNG ERROR");
+            }
+
+            png_write_end(_png, nullptr);
+        }
+
+        /**
+         * Writes image data that has already been filtered and compressed as a zlib stream, followed by the end of the
+         * file. Used instead of WriteRows and Finish.
+         */
+        void WriteCompressedData(const uint8_t* data, size_t length)
+        {
+            // Set error handler
+            if (setjmp(png_jmpbuf(_png)))
+            {
+                throw std::runtime_error("PNG ERROR");
+            }
+
+            constexpr size_t MaxDataChunkLength = 1024 * 1024;
+            for (size_t offset = 0; offset < length; offset += MaxDataChunkLength)
+            {
+                auto chunkLength = std::min(MaxDataChunkLength, length - offset);
+                png_write_chunk(_png, reinterpret_cast<png_const_bytep>("IDAT"), data + offset, chunkLength);
+            }
+
+            // png_write_end only knows about data written by png_write_row
+            png_write_chunk(_png, reinterpret_cast<png_const_bytep>("IEND"), nullptr, 0);
+        }
+
+    private:
+        void WriteHeader(std::ostream& ostream, const Image& image)
+        {
+            _png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
+            if (_png == nullptr)
             {
                 throw std::runtime_error("png_create_write_struct failed.");
             }
@@ -179,8 +257,8 @@ namespace Imaging
             text_ptr[0].text = const_cast<char*>(gVersionInfoFull);
             text_ptr[0].compression = PNG_TEXT_COMPRESSION_zTXt;
 
-            auto info_ptr = png_create_info_struct(png_ptr);
-            if (info_ptr == nullptr)
+            _info = png_create_info_struct(_png);
+            if (_info == nullptr)
             {
                 throw std::runtime_error("png_create_info_struct failed.");
             }
@@ -193,25 +271,25 @@ namespace Imaging
                 }
 
                 // Set the palette
-                png_palette = static_cast<png_colorp>(png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof(png_color)));
-                if (png_palette == nullptr)
+                _palette = static_cast<png_colorp>(png_malloc(_png, PNG_MAX_PALETTE_LENGTH * sizeof(png_color)));
+                if (_palette == nullptr)
                 {
                     throw std::runtime_error("png_malloc failed.");
                 }
                 for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
                 {
                     const auto& entry = (*image.Palette)[static_cast<uint16_t>(i)];
-                    png_palette[i].blue = entry.Blue;
-                    png_palette[i].green = entry.Green;
-                    png_palette[i].red = entry.Red;
+                    _palette[i].blue = entry.Blue;
+                    _palette[i].green = entry.Green;
+                    _palette[i].red = entry.Red;
                 }
-                png_set_PLTE(png_ptr, info_ptr, png_palette, PNG_MAX_PALETTE_LENGTH);
+                png_set_PLTE(_png, _info, _palette, PNG_MAX_PALETTE_LENGTH);
             }
 
-            png_set_write_fn(png_ptr, &ostream, PngWriteData, PngFlush);
+            png_set_write_fn(_png, &ostream, PngWriteData, PngFlush);
 
             // Set error handler
-            if (setjmp(png_jmpbuf(png_ptr)))
+            if (setjmp(png_jmpbuf(_png)))
             {
                 throw std::runtime_error("PNG ERROR");
             }
@@ -221,33 +299,198 @@ namespace Imaging
             if (image.Depth == 8)
             {
                 png_byte transparentIndex = 0;
-                png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
+                png_set_tRNS(_png, _info, &transparentIndex, 1, nullptr);
                 colourType = PNG_COLOR_TYPE_PALETTE;
             }
-            png_set_text(png_ptr, info_ptr, text_ptr, 1);
+            png_set_text(_png, _info, text_ptr, 1);
             png_set_IHDR(
-                png_ptr, info_ptr, image.Width, image.Height, 8, colourType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+                _png, _info, image.Width, image.Height, 8, colourType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
                 PNG_FILTER_TYPE_DEFAULT);
-            png_write_info(png_ptr, info_ptr);
+            png_write_info(_png, _info);
+        }
 
-            // Write pixels
-            auto pixels = image.Pixels.data();
-            for (uint32_t y = 0; y < image.Height; y++)
+        void Release()
+        {
+            if (_png != nullptr)
             {
-                png_write_row(png_ptr, const_cast<png_byte*>(pixels));
-                pixels += image.Stride;
+                png_free(_png, _palette);
+                png_destroy_write_struct(&_png, &_info);
             }
+            _palette = nullptr;
+        }
+    };
 
-            png_write_end(png_ptr, nullptr);
-            png_destroy_info_struct(png_ptr, &info_ptr);
-            png_free(png_ptr, png_palette);
-            png_destroy_write_struct(&png_ptr, nullptr);
+    static int32_t GetZlibLevel(PngCompression compression)
+    {
+        switch (compression)
+        {
+            case PngCompression::Fast:
+                return 1;
+            case PngCompression::Small:
+                return 9;
+            default:
+                return 6;
         }
-        catch (const std::exception&)
+    }
+
+    static uint32_t GetFilterCost(const uint8_t* row, size_t length)
+    {
+        // The heuristic libpng uses: the sum of the filtered bytes as signed values
+        uint32_t cost = 0;
+        for (size_t i = 0; i < length; i++)
         {
-            png_free(png_ptr, png_palette);
-            png_destroy_write_struct(&png_ptr, nullptr);
-            throw;
+            cost += row[i] < 128 ? row[i] : 256 - row[i];
+        }
+        return cost;
+    }
+
+    static uint8_t PaethPredictor(uint8_t left, uint8_t above, uint8_t upperLeft)
+    {
+        int32_t p = left + above - upperLeft;
+        int32_t pa = std::abs(p - left);
+        int32_t pb = std::abs(p - above);
+        int32_t pc = std::abs(p - upperLeft);
+        if (pa <= pb && pa <= pc)
+            return left;
+        if (pb <= pc)
+            return above;
+        return upperLeft;
+    }
+
+    /**
+     * Filters a row of a 32-bit image with each of the PNG filters and keeps the one that is likely to compress best,
+     * as libpng does. The row before the first one is all zeros.
+     */
+    static void FilterRowAdaptive(const uint8_t* src, const uint8_t* above, size_t length, uint8_t* dst, uint8_t* scratch)
+    {
+        constexpr size_t BytesPerPixel = 4;
+        dst[0] = PNG_FILTER_VALUE_NONE;
+        std::memcpy(dst + 1, src, length);
+        auto bestCost = GetFilterCost(dst + 1, length);
+
+        for (uint8_t filter = PNG_FILTER_VALUE_SUB; filter <= PNG_FILTER_VALUE_PAETH; filter++)
+        {
+            for (size_t x = 0; x < length; x++)
+            {
+                uint8_t left = x >= BytesPerPixel ? src[x - BytesPerPixel] : 0;
+                uint8_t up = above != nullptr ? above[x] : 0;
+                uint8_t upperLeft = above != nullptr && x >= BytesPerPixel ? above[x - BytesPerPixel] : 0;
+                uint8_t prediction;
+                switch (filter)
+                {
+                    case PNG_FILTER_VALUE_SUB:
+                        prediction = left;
+                        break;
+                    case PNG_FILTER_VALUE_UP:
+                        prediction = up;
+                        break;
+                    case PNG_FILTER_VALUE_AVG:
+                        prediction = static_cast<uint8_t>((left + up) / 2);
+                        break;
+                    default:
+                        prediction = PaethPredictor(left, up, upperLeft);
+                        break;
+                }
+                scratch[x] = static_cast<uint8_t>(src[x] - prediction);
+            }
+
+            auto cost = GetFilterCost(scratch, length);
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                dst[0] = filter;
+                std::memcpy(dst + 1, scratch, length);
+            }
+        }
+    }
+
+    /**
+     * Writes a whole image with the image data compressed on all threads by util_zlib_deflate, and libpng writing
+     * everything around it. Rows are filtered as libpng would: palette images unfiltered, 32-bit images adaptively.
+     */
+    static void WritePng(std::ostream& ostream, const Image& image, PngCompression compression)
+    {
+        if (image.Depth != 8 && image.Depth != 32)
+        {
+            throw std::runtime_error("Unsupported image depth.");
+        }
+
+        const size_t rowLength = static_cast<size_t>(image.Width) * (image.Depth / 8);
+        if (image.Height != 0 && image.Pixels.size() < (image.Height - 1) * static_cast<size_t>(image.Stride) + rowLength)
+        {
+            throw std::runtime_error("Image is smaller than its dimensions.");
+        }
+
+        // Each row is prefixed by its filter type.
+        std::vector<uint8_t> filtered((rowLength + 1) * image.Height);
+        std::vector<uint8_t> scratch(rowLength);
+        for (uint32_t y = 0; y < image.Height; y++)
+        {
+            const auto* src = image.Pixels.data() + y * static_cast<size_t>(image.Stride);
+            auto* dst = filtered.data() + y * (rowLength + 1);
+            if (image.Depth == 8)
+            {
+                dst[0] = PNG_FILTER_VALUE_NONE;
+                std::memcpy(dst + 1, src, rowLength);
+            }
+            else
+            {
+                const auto* above = y == 0 ? nullptr : src - image.Stride;
+                FilterRowAdaptive(src, above, rowLength, dst, scratch.data());
+            }
+        }
+
+        std::vector<uint8_t> compressed;
+        if (!util_zlib_deflate(filtered.data(), filtered.size(), compressed, GetZlibLevel(compression)))
+        {
+            throw std::runtime_error("Unable to compress image.");
+        }
+
+        PngWriter writer(ostream, image);
+        writer.WriteCompressedData(compressed.data(), compressed.size());
+    }
+
+    static std::ofstream OpenOutputFile(std::string_view path)
+    {
+#if defined(_WIN32) && !defined(__MINGW32__)
+        auto pathW = String::ToWideChar(path);
+        return std::ofstream(pathW, std::ios::binary);
+#else
+        return std::ofstream(std::string(path), std::ios::binary);
+#endif
+    }
+
+    struct PngStripWriter::State
+    {
+        std::ofstream Stream;
+        std::unique_ptr<PngWriter> Writer;
+    };
+
+    PngStripWriter::PngStripWriter(std::string_view path, const Image& image)
+        : _state(std::make_unique<State>())
+    {
+        _state->Stream = OpenOutputFile(path);
+        if (!_state->Stream.is_open())
+        {
+            throw std::runtime_error("Unable to open file for writing.");
+        }
+        _state->Writer = std::make_unique<PngWriter>(_state->Stream, image);
+    }
+
+    PngStripWriter::~PngStripWriter() = default;
+
+    void PngStripWriter::WriteRows(const uint8_t* pixels, uint32_t rows, uint32_t stride)
+    {
+        _state->Writer->WriteRows(pixels, rows, stride);
+    }
+
+    void PngStripWriter::Finish()
+    {
+        _state->Writer->Finish();
+        _state->Stream.flush();
+        if (_state->Stream.fail())
+        {
+            throw std::runtime_error("Unable to write file.");
         }
     }
 
@@ -329,22 +572,27 @@ namespace Imaging
         return ReadFromStream(istream, format);
     }
 
-    void WriteToFile(std::string_view path, const Image& image, IMAGE_FORMAT format)
+    void WriteToFile(std::string_view path, const Image& image, IMAGE_FORMAT format, PngCompression compression)
     {
         switch (format)
         {
             case IMAGE_FORMAT::AUTOMATIC:
-                WriteToFile(path, image, GetImageFormatFromPath(path));
+                WriteToFile(path, image, GetImageFormatFromPath(path), compression);
                 break;
             case IMAGE_FORMAT::PNG:
+            case IMAGE_FORMAT::PNG_32:
             {
-#if defined(_WIN32) && !defined(__MINGW32__)
-                auto pathW = String::ToWideChar(path);
-                std::ofstream fs(pathW, std::ios::binary);
-#else
-                std::ofstream fs(std::string(path), std::ios::binary);
-#endif
-                WritePng(fs, image);
+                auto fs = OpenOutputFile(path);
+                if (!fs.is_open())
+                {
+                    throw std::runtime_error("Unable to open file for writing.");
+                }
+                WritePng(fs, image, compression);
+                fs.flush();
+                if (fs.fail())
+                {
+                    throw std::runtime_error("Unable to write file.");
+                }
                 break;
             }
             default:
@@ -29,6 +29,16 @@ enum class IMAGE_FORMAT
     PNG_32, // Force load to 32bpp buffer
 };
 
+/**
+ * How hard to compress written PNG files, trading file size for encoding time.
+ */
+enum class PngCompression
+{
+    Fast,
+    Default,
+    Small,
+};
+
 struct Image
 {
     // Meta
@@ -49,7 +59,31 @@ namespace Imaging
     IMAGE_FORMAT GetImageFormatFromPath(std::string_view path);
     Image ReadFromFile(std::string_view path, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
     Image ReadFromBuffer(const std::vector<uint8_t>& buffer, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
-    void WriteToFile(std::string_view path, const Image& image, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
+    void WriteToFile(
+        std::string_view path, const Image& image, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC,
+        PngCompression compression = PngCompression::Default);
+
+    /**
+     * Writes a PNG file a strip of rows at a time, so that large images never have to be held in memory at once. The
+     * width, height, depth and palette of the image passed to the constructor describe the file, its pixels are unused.
+     */
+    class PngStripWriter
+    {
+    private:
+        struct State;
+        std::unique_ptr<State> _state;
+
+    public:
+        PngStripWriter(std::string_view path, const Image& image);
+        ~PngStripWriter();
+
+        void WriteRows(const uint8_t* pixels, uint32_t rows, uint32_t stride);
+
+        /**
+         * Writes the end of the file, all rows of the image must have been written.
+         */
+        void Finish();
+    };
 
     void SetReader(IMAGE_FORMAT format, ImageReaderFunc impl);
 } // namespace Imaging
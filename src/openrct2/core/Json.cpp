@@ -56,6 +56,7 @@ namespace Json
         // Write to file
         auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_WRITE);
         fs.Write(jsonOutput.data(), jsonOutput.size());
+        fs.Flush();
     }
 
     void WriteToFile(const fs::path& path, const json_t& jsonData, int indentSize)
@@ -0,0 +1,149 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MappedFile.h"
+
+#include "../Diagnostic.h"
+#include "FileStream.h"
+#include "String.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace OpenRCT2
+{
+    MappedFile::MappedFile(const std::string& path)
+    {
+        if (Map(path))
+            return;
+
+        auto fs = FileStream(path, FILE_MODE_OPEN);
+        _length = static_cast<size_t>(fs.GetLength());
+        _buffer = fs.ReadArray<uint8_t>(_length);
+        _data = _buffer.get();
+    }
+
+    MappedFile::MappedFile(MappedFile&& mv) noexcept
+        : _data(std::exchange(mv._data, nullptr))
+        , _length(std::exchange(mv._length, 0))
+        , _mapped(std::exchange(mv._mapped, false))
+        , _buffer(std::move(mv._buffer))
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Reset();
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& mv) noexcept
+    {
+        if (this != &mv)
+        {
+            Reset();
+            _data = std::exchange(mv._data, nullptr);
+            _length = std::exchange(mv._length, 0);
+            _mapped = std::exchange(mv._mapped, false);
+            _buffer = std::move(mv._buffer);
+        }
+        return *this;
+    }
+
+    void MappedFile::Reset()
+    {
+        if (_mapped)
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(_data);
+#else
+            munmap(_data, _length);
+#endif
+        }
+        _buffer.reset();
+        _data = nullptr;
+        _length = 0;
+        _mapped = false;
+    }
+
+#ifdef _WIN32
+    bool MappedFile::Map(const std::string& path)
+    {
+        auto pathW = String::ToWideChar(path);
+        auto file = CreateFileW(
+            pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0
+            || static_cast<uint64_t>(fileSize.QuadPart) > SIZE_MAX)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        // The view keeps the mapping alive, so neither handle is needed once it has been created.
+        auto mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr)
+            return false;
+
+        auto view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(mapping);
+        if (view == nullptr)
+        {
+            log_verbose("Unable to map '%s', reading it instead.", path.c_str());
+            return false;
+        }
+
+        _data = static_cast<uint8_t*>(view);
+        _length = static_cast<size_t>(fileSize.QuadPart);
+        _mapped = true;
+        return true;
+    }
+#else
+    bool MappedFile::Map(const std::string& path)
+    {
+        auto fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            return false;
+
+        // Only regular files can be mapped, anything else is left to FileStream to reject.
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size == 0
+            || static_cast<uint64_t>(fileStat.st_size) > SIZE_MAX)
+        {
+            close(fd);
+            return false;
+        }
+
+        auto length = static_cast<size_t>(fileStat.st_size);
+        auto view = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (view == MAP_FAILED)
+        {
+            log_verbose("Unable to map '%s', reading it instead.", path.c_str());
+            return false;
+        }
+
+        _data = static_cast<uint8_t*>(view);
+        _length = length;
+        _mapped = true;
+        return true;
+    }
+#endif
+} // namespace OpenRCT2
@@ -0,0 +1,62 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <memory>
+#include <string>
+
+namespace OpenRCT2
+{
+    /**
+     * The contents of a file mapped into memory. The pages are copy-on-write, so they are shared with every other
+     * process that maps the same file until they are written to. If the file can not be mapped, it is read into memory
+     * instead.
+     */
+    class MappedFile final
+    {
+    private:
+        uint8_t* _data = nullptr;
+        size_t _length = 0;
+        bool _mapped = false;
+        std::unique_ptr<uint8_t[]> _buffer;
+
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string& path);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&& mv) noexcept;
+        ~MappedFile();
+
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&& mv) noexcept;
+
+        uint8_t* GetData() const
+        {
+            return _data;
+        }
+
+        size_t GetLength() const
+        {
+            return _length;
+        }
+
+        bool IsMapped() const
+        {
+            return _mapped;
+        }
+
+        void Reset();
+
+    private:
+        bool Map(const std::string& path);
+    };
+} // namespace OpenRCT2
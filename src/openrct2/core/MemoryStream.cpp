@@ -89,6 +89,11 @@ namespace OpenRCT2
     {
         if (this != &mv)
         {
+            if (_access & MEMORY_ACCESS::OWNER)
+            {
+                Memory::Free(_data);
+            }
+
             _access = mv._access;
             _dataCapacity = mv._dataCapacity;
             _data = mv._data;
@@ -122,6 +127,17 @@ namespace OpenRCT2
         return _data;
     }
 
+    void MemoryStream::Reserve(size_t capacity)
+    {
+        if ((_access & MEMORY_ACCESS::OWNER) && _dataCapacity < capacity)
+        {
+            uint64_t position = GetPosition();
+            _dataCapacity = capacity;
+            _data = Memory::Reallocate(_data, _dataCapacity);
+            _position = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(_data) + static_cast<uintptr_t>(position));
+        }
+    }
+
     bool MemoryStream::CanRead() const
     {
         return (_access & MEMORY_ACCESS::READ) != 0;
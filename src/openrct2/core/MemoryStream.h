@@ -52,6 +52,12 @@ namespace OpenRCT2
         void* GetDataCopy() const;
         void* TakeData();
 
+        /**
+         * Grows the buffer of an owning stream so that it can hold at least the given number of bytes without being
+         * reallocated, useful when the final size of what is about to be written is roughly known.
+         */
+        void Reserve(size_t capacity);
+
         ///////////////////////////////////////////////////////////////////////////
         // ISteam methods
         ///////////////////////////////////////////////////////////////////////////
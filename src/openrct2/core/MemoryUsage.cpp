@@ -0,0 +1,78 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MemoryUsage.h"
+
+#include "../util/Util.h"
+
+#include <array>
+#include <atomic>
+#include <iterator>
+
+namespace OpenRCT2::MemoryUsage
+{
+    static constexpr const char* CategoryNames[] = {
+        "tileElements", "entities", "objectImages", "paintEntries", "textureCache", "audio", "scripting",
+    };
+    static_assert(std::size(CategoryNames) == EnumValue(Category::Count));
+
+    struct Counter
+    {
+        std::atomic<size_t> Current{};
+        std::atomic<size_t> Peak{};
+    };
+
+    static std::array<Counter, EnumValue(Category::Count)> _counters;
+
+    static void UpdatePeak(Counter& counter, size_t current)
+    {
+        auto peak = counter.Peak.load(std::memory_order_relaxed);
+        while (current > peak && !counter.Peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void Add(Category category, size_t bytes)
+    {
+        auto& counter = _counters[EnumValue(category)];
+        const auto current = counter.Current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        UpdatePeak(counter, current);
+    }
+
+    void Remove(Category category, size_t bytes)
+    {
+        _counters[EnumValue(category)].Current.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    void Set(Category category, size_t bytes)
+    {
+        auto& counter = _counters[EnumValue(category)];
+        counter.Current.store(bytes, std::memory_order_relaxed);
+        UpdatePeak(counter, bytes);
+    }
+
+    Stats GetStats(Category category)
+    {
+        const auto& counter = _counters[EnumValue(category)];
+        return { counter.Current.load(std::memory_order_relaxed), counter.Peak.load(std::memory_order_relaxed) };
+    }
+
+    const char* GetName(Category category)
+    {
+        return CategoryNames[EnumValue(category)];
+    }
+
+    void ResetPeaks()
+    {
+        for (auto& counter : _counters)
+        {
+            counter.Peak.store(counter.Current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+} // namespace OpenRCT2::MemoryUsage
@@ -0,0 +1,54 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Counts the memory held by the larger subsystems, so it can be seen where the memory of a running game goes. The
+ * subsystems report their allocations themselves, which can be done from any thread.
+ */
+namespace OpenRCT2::MemoryUsage
+{
+    enum class Category : uint8_t
+    {
+        TileElements,
+        Entities,
+        ObjectImages,
+        PaintEntries,
+        TextureCache,
+        Audio,
+        Scripting,
+        Count,
+    };
+
+    struct Stats
+    {
+        size_t Current{};
+        size_t Peak{};
+    };
+
+    void Add(Category category, size_t bytes);
+    void Remove(Category category, size_t bytes);
+
+    /**
+     * Replaces the amount counted for a category, for subsystems that are easier to measure than to follow.
+     */
+    void Set(Category category, size_t bytes);
+
+    Stats GetStats(Category category);
+    const char* GetName(Category category);
+
+    /**
+     * Sets the peak of every category to what is in use now.
+     */
+    void ResetPeaks();
+} // namespace OpenRCT2::MemoryUsage
@@ -0,0 +1,289 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+using namespace OpenRCT2;
+
+// Number of times an idle worker or waiting thread looks for work before going to sleep.
+static constexpr size_t WorkerSpinCount = 64;
+
+static thread_local const TaskScheduler* _currentScheduler = nullptr;
+static thread_local size_t _currentQueueIndex = 0;
+
+bool TaskScheduler::TaskQueue::PushBack(const Task& task)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    if (Count == QueueCapacity)
+        return false;
+
+    Tasks[(Head + Count) % QueueCapacity] = task;
+    Count++;
+    return true;
+}
+
+bool TaskScheduler::TaskQueue::PopBack(Task& task)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    if (Count == 0)
+        return false;
+
+    Count--;
+    task = Tasks[(Head + Count) % QueueCapacity];
+    return true;
+}
+
+bool TaskScheduler::TaskQueue::PopFront(Task& task)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    if (Count == 0)
+        return false;
+
+    task = Tasks[Head];
+    Head = (Head + 1) % QueueCapacity;
+    Count--;
+    return true;
+}
+
+TaskScheduler::TaskScheduler(size_t numThreads)
+{
+    numThreads = std::max<size_t>(numThreads, 1);
+    for (size_t i = 0; i < numThreads; i++)
+    {
+        _queues.push_back(std::make_unique<TaskQueue>());
+    }
+    for (size_t i = 1; i < numThreads; i++)
+    {
+        _threads.emplace_back(&TaskScheduler::RunWorker, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _shouldStop = true;
+    }
+    _sleepCondition.notify_all();
+
+    for (auto& th : _threads)
+    {
+        assert(th.joinable() != false);
+        th.join();
+    }
+}
+
+size_t TaskScheduler::CountThreads() const
+{
+    return _threads.size() + 1;
+}
+
+void TaskScheduler::Submit(const Task& task)
+{
+    if (!_queues[GetQueueIndex()]->PushBack(task))
+    {
+        // Queue is full, run the task straight away rather than allocating more space.
+        auto inlineTask = task;
+        RunTask(inlineTask);
+        return;
+    }
+
+    _numQueued.fetch_add(1);
+    if (_numSleeping.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _sleepCondition.notify_one();
+    }
+    NotifyWaiters();
+}
+
+bool TaskScheduler::TryRunTask()
+{
+    if (_numQueued.load() == 0)
+        return false;
+
+    const auto queueIndex = GetQueueIndex();
+    const auto numQueues = _queues.size();
+
+    Task task;
+    bool found = _queues[queueIndex]->PopBack(task);
+    for (size_t i = 1; !found && i < numQueues; i++)
+    {
+        found = _queues[(queueIndex + i) % numQueues]->PopFront(task);
+    }
+    if (!found)
+        return false;
+
+    _numQueued.fetch_sub(1);
+    RunTask(task);
+    return true;
+}
+
+size_t TaskScheduler::GetQueueIndex() const
+{
+    return _currentScheduler == this ? _currentQueueIndex : 0;
+}
+
+void TaskScheduler::RunWorker(size_t queueIndex)
+{
+    _currentScheduler = this;
+    _currentQueueIndex = queueIndex;
+
+    size_t idleCount = 0;
+    while (!_shouldStop.load(std::memory_order_relaxed))
+    {
+        if (TryRunTask())
+        {
+            idleCount = 0;
+            continue;
+        }
+
+        if (++idleCount < WorkerSpinCount)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Registering as sleeping before checking the queue count means a submitter either sees this thread as
+        // sleeping and wakes it, or this thread sees the newly queued task.
+        _numSleeping.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _sleepCondition.wait(lock, [this]() { return _shouldStop || _numQueued.load() > 0; });
+        }
+        _numSleeping.fetch_sub(1);
+        idleCount = 0;
+    }
+}
+
+void TaskScheduler::WaitForChange(const TaskGroup& group, size_t pending)
+{
+    // As with sleeping workers, registering before checking means a task that is queued or completes afterwards
+    // either sees this thread waiting and wakes it, or is seen by the check.
+    _numWaiting.fetch_add(1);
+    {
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _waitCondition.wait(lock, [&]() { return _numQueued.load() > 0 || group._pending.load() != pending; });
+    }
+    _numWaiting.fetch_sub(1);
+}
+
+void TaskScheduler::NotifyWaiters()
+{
+    if (_numWaiting.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _waitCondition.notify_all();
+    }
+}
+
+void TaskScheduler::RunTask(Task& task)
+{
+    auto* group = task.Group;
+    auto& scheduler = group->_scheduler;
+    try
+    {
+        task.Invoke(task.Storage);
+    }
+    catch (...)
+    {
+        group->SetException(std::current_exception());
+    }
+
+    // The group can be destroyed as soon as its last task has completed, so it is not used after this.
+    group->_pending.fetch_sub(1);
+    scheduler.NotifyWaiters();
+}
+
+TaskGroup::TaskGroup(TaskScheduler& scheduler)
+    : _scheduler(scheduler)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    // Exceptions nobody waited for are dropped, a destructor must not throw.
+    WaitForTasks(nullptr);
+}
+
+void TaskGroup::Wait()
+{
+    WaitForTasks(nullptr);
+    RethrowException();
+}
+
+void TaskGroup::Wait(const std::function<void()>& reportFn)
+{
+    WaitForTasks(&reportFn);
+    RethrowException();
+}
+
+void TaskGroup::WaitForTasks(const std::function<void()>* reportFn)
+{
+    size_t idleCount = 0;
+    auto lastPending = _pending.load();
+    while (lastPending != 0)
+    {
+        if (_scheduler.TryRunTask())
+        {
+            idleCount = 0;
+        }
+        else if (++idleCount < WorkerSpinCount)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            // The remaining tasks are running on other threads.
+            _scheduler.WaitForChange(*this, lastPending);
+            idleCount = 0;
+        }
+
+        const auto pending = _pending.load();
+        if (pending != lastPending)
+        {
+            lastPending = pending;
+            if (reportFn != nullptr && *reportFn)
+            {
+                (*reportFn)();
+            }
+        }
+    }
+}
+
+void TaskGroup::SetException(std::exception_ptr exception)
+{
+    std::lock_guard<std::mutex> lock(_exceptionMutex);
+    if (_exception == nullptr)
+    {
+        _exception = std::move(exception);
+    }
+}
+
+void TaskGroup::RethrowException()
+{
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(_exceptionMutex);
+        exception = std::exchange(_exception, nullptr);
+    }
+    if (exception != nullptr)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+size_t TaskGroup::CountPending() const
+{
+    return _pending.load();
+}
@@ -0,0 +1,151 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace OpenRCT2
+{
+    class TaskGroup;
+
+    /**
+     * A unit of work that can be moved between queues without allocating. The callable is stored inline, so it must be
+     * small and trivially copyable, i.e. a lambda capturing references, pointers and plain values.
+     */
+    struct Task
+    {
+        static constexpr size_t StorageSize = 64;
+
+        void (*Invoke)(void* storage){};
+        TaskGroup* Group{};
+        alignas(std::max_align_t) std::byte Storage[StorageSize]{};
+    };
+
+    /**
+     * Runs tasks on a fixed set of worker threads. Each worker has its own queue; a worker runs the most recently
+     * queued task of its own queue and steals the oldest task from other queues when its own queue is empty. Threads
+     * that are not workers submit to a shared queue. Threads waiting on a TaskGroup run queued tasks until the group
+     * has finished, so task groups can be nested, and block once none of the queued tasks are left to run.
+     */
+    class TaskScheduler
+    {
+        friend class TaskGroup;
+
+    private:
+        static constexpr size_t QueueCapacity = 1024;
+
+        struct TaskQueue
+        {
+            std::mutex Mutex;
+            std::array<Task, QueueCapacity> Tasks;
+            size_t Head{};
+            size_t Count{};
+
+            bool PushBack(const Task& task);
+            bool PopBack(Task& task);
+            bool PopFront(Task& task);
+        };
+
+        // Queue 0 is shared by all threads that are not workers of this scheduler.
+        std::vector<std::unique_ptr<TaskQueue>> _queues;
+        std::vector<std::thread> _threads;
+        std::atomic<size_t> _numQueued{};
+        std::atomic<size_t> _numSleeping{};
+        std::atomic<size_t> _numWaiting{};
+        std::atomic_bool _shouldStop{};
+        std::mutex _sleepMutex;
+        std::condition_variable _sleepCondition;
+        std::condition_variable _waitCondition;
+
+    public:
+        /**
+         * @param numThreads The number of threads running tasks, including the thread waiting on a task group.
+         */
+        explicit TaskScheduler(size_t numThreads = std::thread::hardware_concurrency());
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        size_t CountThreads() const;
+
+    private:
+        void Submit(const Task& task);
+        bool TryRunTask();
+        size_t GetQueueIndex() const;
+        void RunWorker(size_t queueIndex);
+        void WaitForChange(const TaskGroup& group, size_t pending);
+        void NotifyWaiters();
+        static void RunTask(Task& task);
+    };
+
+    /**
+     * A fork / join set of tasks. Tasks are added with Run and Wait blocks until all of them have completed, running
+     * queued tasks on the calling thread in the meantime. The first exception thrown by a task is rethrown by Wait once
+     * all tasks have completed. The group waits for its tasks when it is destroyed.
+     */
+    class TaskGroup
+    {
+        friend class TaskScheduler;
+
+    private:
+        TaskScheduler& _scheduler;
+        std::atomic<size_t> _pending{};
+        std::mutex _exceptionMutex;
+        std::exception_ptr _exception;
+
+    public:
+        explicit TaskGroup(TaskScheduler& scheduler);
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        template<typename TFn> void Run(const TFn& fn)
+        {
+            static_assert(sizeof(TFn) <= Task::StorageSize, "Task is too large, capture by reference instead.");
+            static_assert(alignof(TFn) <= alignof(std::max_align_t), "Task alignment is not supported.");
+            static_assert(std::is_trivially_copyable_v<TFn>, "Task must be trivially copyable.");
+
+            Task task;
+            task.Invoke = [](void* storage) { (*static_cast<TFn*>(storage))(); };
+            task.Group = this;
+            new (task.Storage) TFn(fn);
+
+            _pending.fetch_add(1, std::memory_order_relaxed);
+            _scheduler.Submit(task);
+        }
+
+        void Wait();
+
+        /**
+         * Waits for all tasks, calling reportFn on this thread each time the number of outstanding tasks has changed.
+         */
+        void Wait(const std::function<void()>& reportFn);
+
+        size_t CountPending() const;
+
+    private:
+        void WaitForTasks(const std::function<void()>* reportFn);
+        void SetException(std::exception_ptr exception);
+        void RethrowException();
+    };
+} // namespace OpenRCT2
@@ -9,9 +9,13 @@
 
 #include "Zip.h"
 
+#include "File.h"
 #include "IStream.hpp"
 
 #include <algorithm>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #ifndef __ANDROID__
 #    include <zip.h>
 #endif
@@ -65,6 +69,106 @@ bool IZipArchive::Exists(std::string_view path) const
     return GetIndexFromPath(path).has_value();
 }
 
+namespace
+{
+    /**
+     * Archives opened for reading that are not in use, most recently released first. Only idle archives are kept, so
+     * an archive is never used by more than one thread at a time.
+     */
+    class SharedZipArchives
+    {
+    private:
+        static constexpr size_t MaxIdleArchives = 16;
+
+        struct IdleArchive
+        {
+            std::string Path;
+            uint64_t LastModified{};
+            uint64_t Size{};
+            std::unique_ptr<IZipArchive> Archive;
+        };
+
+        std::mutex _mutex;
+        std::list<IdleArchive> _idle;
+
+    public:
+        std::shared_ptr<IZipArchive> Open(std::string_view path)
+        {
+            auto pathString = std::string(path);
+            auto lastModified = File::GetLastModified(pathString);
+            auto size = File::GetSize(pathString);
+
+            std::unique_ptr<IZipArchive> archive;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it = std::find_if(
+                    _idle.begin(), _idle.end(), [&pathString](const IdleArchive& idle) { return idle.Path == pathString; });
+                if (it != _idle.end())
+                {
+                    if (it->LastModified == lastModified && it->Size == size)
+                    {
+                        archive = std::move(it->Archive);
+                    }
+                    _idle.erase(it);
+                }
+            }
+
+            if (archive == nullptr)
+            {
+                archive = Zip::TryOpen(path, ZIP_ACCESS::READ);
+                if (archive == nullptr)
+                {
+                    return nullptr;
+                }
+            }
+
+            auto rawArchive = archive.release();
+            return std::shared_ptr<IZipArchive>(
+                rawArchive, [this, pathString = std::move(pathString), lastModified, size](IZipArchive* released) {
+                    Release(pathString, lastModified, size, std::unique_ptr<IZipArchive>(released));
+                });
+        }
+
+        void Clear()
+        {
+            std::list<IdleArchive> idle;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                idle.swap(_idle);
+            }
+        }
+
+    private:
+        void Release(const std::string& path, uint64_t lastModified, uint64_t size, std::unique_ptr<IZipArchive> archive)
+        {
+            std::unique_ptr<IZipArchive> evicted;
+            std::lock_guard<std::mutex> lock(_mutex);
+            _idle.push_front({ path, lastModified, size, std::move(archive) });
+            if (_idle.size() > MaxIdleArchives)
+            {
+                // Closed once the lock is released.
+                evicted = std::move(_idle.back().Archive);
+                _idle.pop_back();
+            }
+        }
+    };
+
+    SharedZipArchives _sharedArchives;
+} // namespace
+
+namespace Zip
+{
+    std::shared_ptr<IZipArchive> OpenShared(std::string_view path)
+    {
+        return _sharedArchives.Open(path);
+    }
+
+    void CloseShared()
+    {
+        _sharedArchives.Clear();
+    }
+} // namespace Zip
+
 #ifndef __ANDROID__
 
 class ZipArchive final : public IZipArchive
@@ -74,6 +178,9 @@ private:
     ZIP_ACCESS _access;
     std::vector<std::vector<uint8_t>> _writeBuffers;
 
+    // Index of each normalised file name, only for archives opened for reading as their names can not change.
+    std::unordered_map<std::string, size_t> _indexByName;
+
 public:
     ZipArchive(std::string_view path, ZIP_ACCESS access)
     {
@@ -91,6 +198,16 @@ public:
         }
 
         _access = access;
+        if (access == ZIP_ACCESS::READ)
+        {
+            auto numFiles = GetNumFiles();
+            _indexByName.reserve(numFiles);
+            for (size_t i = 0; i < numFiles; i++)
+            {
+                // Keep the first match, like the search through all names does.
+                _indexByName.emplace(NormalisePath(GetFileName(i)), i);
+            }
+        }
     }
 
     ~ZipArchive() override
@@ -127,6 +244,21 @@ public:
         }
     }
 
+    std::optional<size_t> GetIndexFromPath(std::string_view path) const override
+    {
+        if (_access != ZIP_ACCESS::READ)
+        {
+            return IZipArchive::GetIndexFromPath(path);
+        }
+
+        auto it = _indexByName.find(NormalisePath(path));
+        if (it != _indexByName.end() && !it->first.empty())
+        {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
     std::vector<uint8_t> GetFileData(std::string_view path) const override
     {
         std::vector<uint8_t> result;
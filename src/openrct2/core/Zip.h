@@ -47,7 +47,7 @@ struct IZipArchive
     virtual void DeleteFile(std::string_view path) abstract;
     virtual void RenameFile(std::string_view path, std::string_view newPath) abstract;
 
-    std::optional<size_t> GetIndexFromPath(std::string_view path) const;
+    virtual std::optional<size_t> GetIndexFromPath(std::string_view path) const;
     bool Exists(std::string_view path) const;
 };
 
@@ -61,4 +61,16 @@ namespace Zip
 {
     std::unique_ptr<IZipArchive> Open(std::string_view path, ZIP_ACCESS zipAccess);
     std::unique_ptr<IZipArchive> TryOpen(std::string_view path, ZIP_ACCESS zipAccess);
+
+    /**
+     * Opens a zip file for reading, reusing an archive that was opened before if the file has not changed since, so
+     * its central directory does not have to be read again. The archive is only used by the caller until it is
+     * released, after which it is kept open for the next caller. Returns nullptr if the file can not be opened.
+     */
+    std::shared_ptr<IZipArchive> OpenShared(std::string_view path);
+
+    /**
+     * Closes all archives kept open by OpenShared that are not in use.
+     */
+    void CloseShared();
 } // namespace Zip
@@ -10,6 +10,7 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "Drawing.h"
+#include "LightFX.h"
 
 #ifdef __AVX2__
 
@@ -42,6 +43,105 @@ void mask_avx2(
     }
 }
 
+// Looks up 32 pixels in a 256 entry table without a gather, the same as the SSE4.1 version. _mm256_shuffle_epi8 shuffles
+// each 128 bit lane on its own, so every row of the table is copied into both lanes.
+static __m256i RemapPixels(const uint8_t* table, __m256i pixels)
+{
+    const __m256i lowNibbleMask = _mm256_set1_epi8(0x0F);
+    const __m256i low = _mm256_and_si256(pixels, lowNibbleMask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(pixels, 4), lowNibbleMask);
+    __m256i result = _mm256_setzero_si256();
+    for (int32_t row = 0; row < 16; row++)
+    {
+        const __m256i entries = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + row * 16)));
+        const __m256i isRow = _mm256_cmpeq_epi8(high, _mm256_set1_epi8(static_cast<char>(row)));
+        result = _mm256_blendv_epi8(result, _mm256_shuffle_epi8(entries, low), isRow);
+    }
+    return result;
+}
+
+void rle_run_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, const uint8_t* paletteTable, DrawBlendOp blendOp)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i pixels = source;
+        if (blendOp & BLEND_SRC)
+        {
+            pixels = RemapPixels(paletteTable, source);
+        }
+        else if (blendOp & BLEND_DST)
+        {
+            pixels = RemapPixels(paletteTable, dest);
+        }
+
+        // Keep the destination wherever the source or the remapped pixel is transparent
+        const __m256i transparent = _mm256_or_si256(_mm256_cmpeq_epi8(source, zero), _mm256_cmpeq_epi8(pixels, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(pixels, dest, transparent));
+    }
+    rle_run_scalar(src + i, dst + i, length - i, paletteTable, blendOp);
+}
+
+#    ifdef __ENABLE_LIGHTFX__
+
+void lightfx_accumulate_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, uint32_t intensity)
+{
+    const __m256i factor = _mm256_set1_epi16(static_cast<int16_t>(intensity + 1));
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        // Unpacking and packing both work within each 128 bit lane, so the pixels end up where they started
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i lo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(source, zero), factor), 8);
+        const __m256i hi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(source, zero), factor), 8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_adds_epu8(dest, _mm256_packus_epi16(lo, hi)));
+    }
+    lightfx_accumulate_scalar(src + i, dst + i, length - i, intensity);
+}
+
+void lightfx_mix_avx2(
+    const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t length,
+    const uint32_t* palette, const uint32_t* lightPalette)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i everyChannel = _mm256_set1_epi32(0x01010101);
+    const __m256i six = _mm256_set1_epi16(6);
+    const auto paletteBase = reinterpret_cast<const int*>(palette);
+    const auto lightPaletteBase = reinterpret_cast<const int*>(lightPalette);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(bits + i)));
+        const __m256i dark = _mm256_i32gather_epi32(paletteBase, indices, 4);
+        const __m256i lit = _mm256_i32gather_epi32(lightPaletteBase, indices, 4);
+
+        // Repeat the intensity of each pixel in all four of its channels
+        const __m256i intensity = _mm256_mullo_epi32(
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(light + i))), everyChannel);
+
+        // See lightfx_mix_sse4_1
+        const __m256i lo = _mm256_add_epi16(
+            _mm256_unpacklo_epi8(dark, zero),
+            _mm256_mulhi_epu16(
+                _mm256_unpacklo_epi8(zero, lit), _mm256_mullo_epi16(_mm256_unpacklo_epi8(intensity, zero), six)));
+        const __m256i hi = _mm256_add_epi16(
+            _mm256_unpackhi_epi8(dark, zero),
+            _mm256_mulhi_epu16(
+                _mm256_unpackhi_epi8(zero, lit), _mm256_mullo_epi16(_mm256_unpackhi_epi8(intensity, zero), six)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    lightfx_mix_scalar(bits + i, light + i, dst + i, length - i, palette, lightPalette);
+}
+
+#    endif // __ENABLE_LIGHTFX__
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -55,4 +155,26 @@ void mask_avx2(
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void rle_run_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, const uint8_t* paletteTable, DrawBlendOp blendOp)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+#    ifdef __ENABLE_LIGHTFX__
+
+void lightfx_accumulate_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, uint32_t intensity)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void lightfx_mix_avx2(
+    const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t length,
+    const uint32_t* palette, const uint32_t* lightPalette)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+#    endif // __ENABLE_LIGHTFX__
+
 #endif // __AVX2__
@@ -9,9 +9,59 @@
 
 #include "Drawing.h"
 
+#include "../Diagnostic.h"
+#include "../util/Util.h"
+
 #include <algorithm>
 #include <cstring>
 
+void (*rle_run_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, const uint8_t* paletteTable, DrawBlendOp blendOp)
+    = rle_run_scalar;
+
+void rle_run_scalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, const uint8_t* paletteTable, DrawBlendOp blendOp)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        uint8_t pixel = src[i];
+        if (pixel == 0)
+            continue;
+
+        if (blendOp & BLEND_SRC)
+        {
+            pixel = paletteTable[pixel];
+        }
+        else if (blendOp & BLEND_DST)
+        {
+            pixel = paletteTable[dst[i]];
+        }
+        if (pixel != 0)
+        {
+            dst[i] = pixel;
+        }
+    }
+}
+
+void rle_run_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 RLE run function");
+        rle_run_fn = rle_run_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 RLE run function");
+        rle_run_fn = rle_run_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar RLE run function");
+        rle_run_fn = rle_run_scalar;
+    }
+}
+
 template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteMagnify(DrawSpriteArgs& args)
 {
     auto dpi = args.DPI;
@@ -95,6 +145,14 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
     auto zoom = 1 << TZoom;
     auto dstLineWidth = (static_cast<size_t>(dpi->width) >> TZoom) + dpi->pitch;
 
+    // At full size each run is contiguous in both the source and the destination, so it can be drawn in one go,
+    // unless the op blends the source with the destination which needs a table per source colour.
+    constexpr bool isRemap = (TBlendOp & (BLEND_SRC | BLEND_DST)) != 0;
+    constexpr bool canDrawRuns = TZoom == 0 && (TBlendOp & BLEND_TRANSPARENT) != 0
+        && ((TBlendOp & BLEND_SRC) == 0 || (TBlendOp & BLEND_DST) == 0);
+    const uint8_t* paletteTable = isRemap ? args.PalMap.GetTable() : nullptr;
+    const bool drawRuns = canDrawRuns && (!isRemap || paletteTable != nullptr);
+
     // Move up to the first line of the image if source_y_start is negative. Why does this even occur?
     if (srcY < 0)
     {
@@ -163,6 +221,13 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
                     std::memcpy(dst, src, numPixels);
                 }
             }
+            else if (drawRuns)
+            {
+                if (numPixels > 0)
+                {
+                    rle_run_fn(src, dst, static_cast<size_t>(numPixels), paletteTable, TBlendOp);
+                }
+            }
             else
             {
                 auto& paletteMap = args.PalMap;
@@ -12,12 +12,15 @@
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
 #include "../core/FileStream.h"
+#include "../core/MappedFile.h"
+#include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../platform/platform.h"
 #include "../sprites.h"
 #include "../ui/UiContext.h"
 #include "../util/Util.h"
 #include "Drawing.h"
+#include "RemappedSpriteCache.h"
 #include "ScrollingText.h"
 
 #include <algorithm>
@@ -154,6 +157,19 @@ static void read_and_convert_gxdat(IStream* stream, size_t count, bool is_rctc,
     }
 }
 
+/**
+ * Returns the element data that follows the element headers in a mapped gx file, making sure it is all there.
+ */
+static uint8_t* get_gxdat_data(const rct_gx& gx, const IStream& stream)
+{
+    auto dataOffset = stream.GetPosition();
+    if (dataOffset + gx.header.total_size > gx.file.GetLength())
+    {
+        throw IOException("Element data extends past the end of the file.");
+    }
+    return gx.file.GetData() + dataOffset;
+}
+
 void mask_scalar(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap)
@@ -198,7 +214,8 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
     try
     {
         auto path = Path::Combine(env.GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        _g1.file = MappedFile(path);
+        auto fs = MemoryStream(_g1.file.GetData(), _g1.file.GetLength());
         _g1.header = fs.ReadValue<rct_g1_header>();
 
         log_verbose("g1.dat, number of entries: %u", _g1.header.num_entries);
@@ -214,18 +231,19 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
         read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
         gTinyFontAntiAliased = is_rctc;
 
-        // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
+        // Element data is used straight from the mapped file
+        auto data = get_gxdat_data(_g1, fs);
 
         // Fix entry data offsets
         for (uint32_t i = 0; i < _g1.header.num_entries; i++)
         {
-            _g1.elements[i].offset += reinterpret_cast<uintptr_t>(_g1.data.get());
+            _g1.elements[i].offset += reinterpret_cast<uintptr_t>(data);
         }
         return true;
     }
     catch (const std::exception&)
     {
+        _g1.file.Reset();
         _g1.elements.clear();
         _g1.elements.shrink_to_fit();
 
@@ -241,21 +259,24 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
-    _g1.data.reset();
+    RemappedSpriteCache::ClearAll();
+    _g1.file.Reset();
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
 }
 
 void gfx_unload_g2()
 {
-    _g2.data.reset();
+    RemappedSpriteCache::ClearAll();
+    _g2.file.Reset();
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
 }
 
 void gfx_unload_csg()
 {
-    _csg.data.reset();
+    RemappedSpriteCache::ClearAll();
+    _csg.file.Reset();
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
 }
@@ -270,25 +291,27 @@ bool gfx_load_g2()
     safe_strcat_path(path, "g2.dat", MAX_PATH);
     try
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        _g2.file = MappedFile(path);
+        auto fs = MemoryStream(_g2.file.GetData(), _g2.file.GetLength());
         _g2.header = fs.ReadValue<rct_g1_header>();
 
         // Read element headers
         _g2.elements.resize(_g2.header.num_entries);
         read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements.data());
 
-        // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
+        // Element data is used straight from the mapped file
+        auto data = get_gxdat_data(_g2, fs);
 
         // Fix entry data offsets
         for (uint32_t i = 0; i < _g2.header.num_entries; i++)
         {
-            _g2.elements[i].offset += reinterpret_cast<uintptr_t>(_g2.data.get());
+            _g2.elements[i].offset += reinterpret_cast<uintptr_t>(data);
         }
         return true;
     }
     catch (const std::exception&)
     {
+        _g2.file.Reset();
         _g2.elements.clear();
         _g2.elements.shrink_to_fit();
 
@@ -317,7 +340,7 @@ bool gfx_load_csg()
     try
     {
         auto fileHeader = FileStream(pathHeaderPath, FILE_MODE_OPEN);
-        auto fileData = FileStream(pathDataPath, FILE_MODE_OPEN);
+        auto fileData = MappedFile(pathDataPath);
         size_t fileHeaderSize = fileHeader.GetLength();
         size_t fileDataSize = fileData.GetLength();
 
@@ -334,13 +357,13 @@ bool gfx_load_csg()
         _csg.elements.resize(_csg.header.num_entries);
         read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
 
-        // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
+        // Element data is used straight from the mapped file
+        _csg.file = std::move(fileData);
 
         // Fix entry data offsets
         for (uint32_t i = 0; i < _csg.header.num_entries; i++)
         {
-            _csg.elements[i].offset += reinterpret_cast<uintptr_t>(_csg.data.get());
+            _csg.elements[i].offset += reinterpret_cast<uintptr_t>(_csg.file.GetData());
             // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
             if (_csg.elements[i].flags & G1_FLAG_HAS_ZOOM_SPRITE)
             {
@@ -352,6 +375,7 @@ bool gfx_load_csg()
     }
     catch (const std::exception&)
     {
+        _csg.file.Reset();
         _csg.elements.clear();
         _csg.elements.shrink_to_fit();
 
@@ -360,6 +384,22 @@ bool gfx_load_csg()
     }
 }
 
+namespace
+{
+    // The remap palettes are filled in for every image drawn, so each thread drawing sprites fills in copies of its own.
+    struct RemapPalettes
+    {
+        uint8_t Peep[256];
+        uint8_t Other[256];
+
+        RemapPalettes()
+        {
+            std::copy_n(gPeepPalette, sizeof(Peep), Peep);
+            std::copy_n(gOtherPalette, sizeof(Other), Other);
+        }
+    };
+} // namespace
+
 static std::optional<PaletteMap> FASTCALL gfx_draw_sprite_get_palette(ImageId imageId)
 {
     if (!imageId.HasSecondary())
@@ -373,10 +413,11 @@ static std::optional<PaletteMap> FASTCALL gfx_draw_sprite_get_palette(ImageId im
     }
     else
     {
-        auto paletteMap = PaletteMap(gPeepPalette);
+        thread_local RemapPalettes palettes;
+        auto paletteMap = PaletteMap(palettes.Peep);
         if (imageId.HasTertiary())
         {
-            paletteMap = PaletteMap(gOtherPalette);
+            paletteMap = PaletteMap(palettes.Other);
             auto tertiaryPaletteMap = GetPaletteMapForColour(imageId.GetTertiary());
             if (tertiaryPaletteMap)
             {
@@ -403,10 +444,21 @@ static std::optional<PaletteMap> FASTCALL gfx_draw_sprite_get_palette(ImageId im
     }
 }
 
+static void FASTCALL gfx_draw_sprite_palette_set_software(
+    rct_drawpixelinfo* dpi, ImageId imageId, const ScreenCoordsXY& coords, const PaletteMap* paletteMap);
+
 void FASTCALL gfx_draw_sprite_software(rct_drawpixelinfo* dpi, ImageId imageId, const ScreenCoordsXY& spriteCoords)
 {
     if (imageId.HasValue())
     {
+        // Recoloured sprites that are not blended with what is behind them can be drawn from the remapped sprite cache,
+        // which is left to look up the palette map only when it is needed.
+        if (imageId.HasPrimary() && !imageId.IsBlended())
+        {
+            gfx_draw_sprite_palette_set_software(dpi, imageId, spriteCoords, nullptr);
+            return;
+        }
+
         auto palette = gfx_draw_sprite_get_palette(imageId);
         if (!palette)
         {
@@ -427,6 +479,16 @@ void FASTCALL gfx_draw_sprite_software(rct_drawpixelinfo* dpi, ImageId imageId,
  */
 void FASTCALL gfx_draw_sprite_palette_set_software(
     rct_drawpixelinfo* dpi, ImageId imageId, const ScreenCoordsXY& coords, const PaletteMap& paletteMap)
+{
+    gfx_draw_sprite_palette_set_software(dpi, imageId, coords, &paletteMap);
+}
+
+/**
+ * @param paletteMap The palette map to draw with, or nullptr to draw with the remap of the image id, using the remapped
+ * sprite cache for RLE sprites.
+ */
+static void FASTCALL gfx_draw_sprite_palette_set_software(
+    rct_drawpixelinfo* dpi, ImageId imageId, const ScreenCoordsXY& coords, const PaletteMap* paletteMap)
 {
     int32_t x = coords.x;
     int32_t y = coords.y;
@@ -575,7 +637,43 @@ void FASTCALL gfx_draw_sprite_palette_set_software(
     // Move the pointer to the start point of the destination
     dest_pointer += ((dpi->width / zoom_level) + dpi->pitch) * dest_start_y + dest_start_x;
 
-    DrawSpriteArgs args(dpi, imageId, paletteMap, *g1, source_start_x, source_start_y, width, height, dest_pointer);
+    if (paletteMap == nullptr)
+    {
+        std::optional<PaletteMap> palette;
+        if (g1->flags & G1_FLAG_RLE_COMPRESSION)
+        {
+            auto& cache = GetRemappedSpriteCache();
+            const auto* remapped = cache.Get(imageId, *g1);
+            if (remapped == nullptr)
+            {
+                palette = gfx_draw_sprite_get_palette(imageId);
+                if (palette)
+                {
+                    remapped = cache.Add(imageId, *g1, *palette);
+                }
+            }
+            if (remapped != nullptr)
+            {
+                // The remap has already been applied, so the runs only need to be copied
+                DrawSpriteArgs args(
+                    dpi, ImageId(imageId.GetIndex()), PaletteMap::GetDefault(), *remapped, source_start_x, source_start_y,
+                    width, height, dest_pointer);
+                gfx_sprite_to_buffer(args);
+                return;
+            }
+        }
+        else
+        {
+            palette = gfx_draw_sprite_get_palette(imageId);
+        }
+
+        const auto& drawPalette = palette ? *palette : PaletteMap::GetDefault();
+        DrawSpriteArgs args(dpi, imageId, drawPalette, *g1, source_start_x, source_start_y, width, height, dest_pointer);
+        gfx_sprite_to_buffer(args);
+        return;
+    }
+
+    DrawSpriteArgs args(dpi, imageId, *paletteMap, *g1, source_start_x, source_start_y, width, height, dest_pointer);
     gfx_sprite_to_buffer(args);
 }
 
@@ -724,6 +822,7 @@ const rct_g1_element* gfx_get_g1_element(int32_t image_id)
 
 void gfx_set_g1_element(int32_t imageId, const rct_g1_element* g1)
 {
+    RemappedSpriteCache::InvalidateAll(static_cast<uint32_t>(imageId));
     bool isTemp = imageId == SPR_TEMP;
     bool isValid = (imageId >= SPR_IMAGE_LIST_BEGIN && imageId < SPR_IMAGE_LIST_END)
         || (imageId >= SPR_SCROLLING_TEXT_START && imageId < SPR_SCROLLING_TEXT_END);
@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../Context.h"
 #include "../common.h"
 #include "../config/Config.h"
 #include "../core/String.hpp"
@@ -21,6 +22,10 @@
 #include "TTF.h"
 
 #include <algorithm>
+#include <array>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 
 using namespace OpenRCT2;
 
@@ -38,6 +43,112 @@ enum : uint32_t
 
 static int32_t ttf_get_string_width(std::string_view text, FontSpriteBase fontSpriteBase, bool noFormatting);
 
+namespace
+{
+    enum class TextLayoutKind : uint8_t
+    {
+        Width,
+        WidthNoFormatting,
+        Wrap,
+        Clip,
+    };
+
+    struct TextLayout
+    {
+        std::string Key;
+        // The text with the line breaks inserted or the ellipsis appended, for wrapped and clipped text.
+        std::string Text;
+        int32_t Width{};
+        int32_t NumLines{};
+    };
+
+    /**
+     * Remembers the widths, line breaks and clipping of the strings windows measure every frame, keyed by the text, the
+     * width it is laid out in and the font. The least recently used layouts are dropped once there are too many.
+     */
+    class TextLayoutCache
+    {
+    private:
+        static constexpr size_t MaxLayouts = 4096;
+
+        std::mutex _mutex;
+        std::list<TextLayout> _layouts;
+        std::unordered_map<std::string_view, std::list<TextLayout>::iterator> _layoutsByKey;
+
+    public:
+        static std::string& GetKey(TextLayoutKind kind, std::string_view text, int32_t width, FontSpriteBase fontSpriteBase)
+        {
+            thread_local std::string key;
+            key.clear();
+            key.push_back(static_cast<char>(kind));
+            key.push_back(static_cast<char>(fontSpriteBase));
+            key.push_back(LocalisationService_UseTrueTypeFont() ? 1 : 0);
+            key.append(reinterpret_cast<const char*>(&width), sizeof(width));
+            key.append(text);
+            return key;
+        }
+
+        template<typename TFunc> void GetOrAdd(const std::string& key, TextLayout& layout, TFunc&& create)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it = _layoutsByKey.find(key);
+                if (it != _layoutsByKey.end())
+                {
+                    _layouts.splice(_layouts.begin(), _layouts, it->second);
+                    layout.Text = it->second->Text;
+                    layout.Width = it->second->Width;
+                    layout.NumLines = it->second->NumLines;
+                    return;
+                }
+            }
+
+            create(layout);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_layoutsByKey.find(key) != _layoutsByKey.end())
+                return;
+
+            auto& added = _layouts.emplace_front();
+            added.Key = key;
+            added.Text = layout.Text;
+            added.Width = layout.Width;
+            added.NumLines = layout.NumLines;
+            _layoutsByKey.emplace(added.Key, _layouts.begin());
+            if (_layouts.size() > MaxLayouts)
+            {
+                _layoutsByKey.erase(_layouts.back().Key);
+                _layouts.pop_back();
+            }
+        }
+
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _layoutsByKey.clear();
+            _layouts.clear();
+        }
+    };
+} // namespace
+
+static TextLayoutCache _textLayoutCache;
+
+void gfx_invalidate_text_layouts()
+{
+    _textLayoutCache.Clear();
+}
+
+static int32_t gfx_get_string_width_cached(std::string_view text, FontSpriteBase fontSpriteBase, bool noFormatting)
+{
+    auto kind = noFormatting ? TextLayoutKind::WidthNoFormatting : TextLayoutKind::Width;
+    const auto& key = TextLayoutCache::GetKey(kind, text, 0, fontSpriteBase);
+    TextLayout layout;
+    _textLayoutCache.GetOrAdd(key, layout, [&](TextLayout& created) {
+        created.Width = ttf_get_string_width(text, fontSpriteBase, noFormatting);
+    });
+    return layout.Width;
+}
+
 /**
  *
  *  rct2: 0x006C23B1
@@ -80,14 +191,17 @@ int32_t gfx_get_string_width_new_lined(std::string_view text, FontSpriteBase fon
  */
 int32_t gfx_get_string_width(std::string_view text, FontSpriteBase fontSpriteBase)
 {
-    return ttf_get_string_width(text, fontSpriteBase, false);
+    return gfx_get_string_width_cached(text, fontSpriteBase, false);
 }
 
 int32_t gfx_get_string_width_no_formatting(std::string_view text, FontSpriteBase fontSpriteBase)
 {
-    return ttf_get_string_width(text, fontSpriteBase, true);
+    return gfx_get_string_width_cached(text, fontSpriteBase, true);
 }
 
+static int32_t gfx_clip_string_uncached(utf8* text, int32_t width, FontSpriteBase fontSpriteBase);
+static int32_t gfx_wrap_string_uncached(utf8* text, int32_t width, FontSpriteBase fontSpriteBase, int32_t* outNumLines);
+
 /**
  * Clip the text in buffer to width, add ellipsis and return the new width of the clipped string
  *
@@ -103,8 +217,26 @@ int32_t gfx_clip_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
         return 0;
     }
 
+    const auto& key = TextLayoutCache::GetKey(TextLayoutKind::Clip, text, width, fontSpriteBase);
+    TextLayout layout;
+    _textLayoutCache.GetOrAdd(key, layout, [&](TextLayout& created) {
+        // The ellipsis can make the clipped text a few bytes longer than the text it came from
+        auto length = std::strlen(text);
+        thread_local std::string buffer;
+        buffer.assign(text, length);
+        buffer.resize(length + 8);
+        created.Width = gfx_clip_string_uncached(buffer.data(), width, fontSpriteBase);
+        created.Text = buffer.c_str();
+    });
+
+    std::memcpy(text, layout.Text.c_str(), layout.Text.size() + 1);
+    return layout.Width;
+}
+
+static int32_t gfx_clip_string_uncached(utf8* text, int32_t width, FontSpriteBase fontSpriteBase)
+{
     // If width of the full string is less than allowed width then we don't need to clip
-    auto clippedWidth = gfx_get_string_width(text, fontSpriteBase);
+    auto clippedWidth = ttf_get_string_width(text, fontSpriteBase, false);
     if (clippedWidth <= width)
     {
         return clippedWidth;
@@ -126,7 +258,7 @@ int32_t gfx_clip_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
             // Add the ellipsis before checking the width
             buffer.append("...");
 
-            auto currentWidth = gfx_get_string_width(buffer, fontSpriteBase);
+            auto currentWidth = ttf_get_string_width(buffer, fontSpriteBase, false);
             if (currentWidth < width)
             {
                 bestLength = buffer.size();
@@ -154,7 +286,7 @@ int32_t gfx_clip_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
             buffer.append(cb);
         }
     }
-    return gfx_get_string_width(text, fontSpriteBase);
+    return ttf_get_string_width(text, fontSpriteBase, false);
 }
 
 /**
@@ -171,6 +303,31 @@ int32_t gfx_clip_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
  * font_height (ebx) - out
  */
 int32_t gfx_wrap_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase, int32_t* outNumLines)
+{
+    const auto& key = TextLayoutCache::GetKey(TextLayoutKind::Wrap, text, width, fontSpriteBase);
+    TextLayout layout;
+    _textLayoutCache.GetOrAdd(key, layout, [&](TextLayout& created) {
+        // The wrapped text has a null in place of each line break, so it is kept with its length
+        auto length = std::strlen(text);
+        thread_local std::string buffer;
+        buffer.assign(text, length + 1);
+        buffer.resize(buffer.size() + length + 1);
+        created.Width = gfx_wrap_string_uncached(buffer.data(), width, fontSpriteBase, &created.NumLines);
+        created.Text.assign(buffer.data(), std::strlen(buffer.data()));
+        for (int32_t i = 0; i < created.NumLines; i++)
+        {
+            created.Text.push_back('\0');
+            created.Text.append(buffer.data() + created.Text.size());
+        }
+    });
+
+    std::memcpy(text, layout.Text.data(), layout.Text.size());
+    text[layout.Text.size()] = '\0';
+    *outNumLines = layout.NumLines;
+    return layout.Width;
+}
+
+static int32_t gfx_wrap_string_uncached(utf8* text, int32_t width, FontSpriteBase fontSpriteBase, int32_t* outNumLines)
 {
     constexpr size_t NULL_INDEX = std::numeric_limits<size_t>::max();
     thread_local std::string buffer;
@@ -194,7 +351,7 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
                 utf8_write_codepoint(cb, codepoint);
                 buffer.append(cb);
 
-                auto lineWidth = gfx_get_string_width(&buffer[currentLineIndex], fontSpriteBase);
+                auto lineWidth = ttf_get_string_width(&buffer[currentLineIndex], fontSpriteBase, false);
                 if (lineWidth <= width || (splitIndex == NULL_INDEX && bestSplitIndex == NULL_INDEX))
                 {
                     if (codepoint == ' ')
@@ -218,7 +375,7 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
                     buffer.insert(buffer.begin() + splitIndex, '\0');
 
                     // Recalculate the line length after splitting
-                    lineWidth = gfx_get_string_width(&buffer[currentLineIndex], fontSpriteBase);
+                    lineWidth = ttf_get_string_width(&buffer[currentLineIndex], fontSpriteBase, false);
                     maxWidth = std::max(maxWidth, lineWidth);
                     numLines++;
 
@@ -238,7 +395,7 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
         {
             buffer.push_back('\0');
 
-            auto lineWidth = gfx_get_string_width(&buffer[currentLineIndex], fontSpriteBase);
+            auto lineWidth = ttf_get_string_width(&buffer[currentLineIndex], fontSpriteBase, false);
             maxWidth = std::max(maxWidth, lineWidth);
             numLines++;
 
@@ -253,7 +410,7 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, FontSpriteBase fontSpriteBase
     }
     {
         // Final line width calculation
-        auto lineWidth = gfx_get_string_width(&buffer[currentLineIndex], fontSpriteBase);
+        auto lineWidth = ttf_get_string_width(&buffer[currentLineIndex], fontSpriteBase, false);
         maxWidth = std::max(maxWidth, lineWidth);
     }
 
@@ -433,7 +590,32 @@ void DrawNewsTicker(
     gfx_draw_string(dpi, screenCoords, "", { colour });
     format_string(buffer, 256, format, args);
 
-    gfx_wrap_string(buffer, width, FontSpriteBase::SMALL, &numLines);
+    // The ticker is drawn every frame while the same news item scrolls in, so the wrapped text is kept until the text,
+    // width or font changes.
+    static std::string lastText;
+    static std::array<utf8, 256> lastWrappedText;
+    static int32_t lastWidth = -1;
+    static int32_t lastNumLines;
+    static uint32_t lastStringsVersion;
+    static bool lastUseTrueTypeFont;
+    auto& localisationService = GetContext()->GetLocalisationService();
+    auto stringsVersion = localisationService.GetStringsVersion();
+    auto useTrueTypeFont = localisationService.UseTrueTypeFont();
+    if (width != lastWidth || stringsVersion != lastStringsVersion || useTrueTypeFont != lastUseTrueTypeFont
+        || lastText != buffer)
+    {
+        lastText = buffer;
+        gfx_wrap_string(buffer, width, FontSpriteBase::SMALL, &lastNumLines);
+        std::copy_n(buffer, lastWrappedText.size(), lastWrappedText.begin());
+        lastWidth = width;
+        lastStringsVersion = stringsVersion;
+        lastUseTrueTypeFont = useTrueTypeFont;
+    }
+    else
+    {
+        std::copy(lastWrappedText.begin(), lastWrappedText.end(), buffer);
+    }
+    numLines = lastNumLines;
     lineHeight = font_get_line_height(FontSpriteBase::SMALL);
 
     int32_t numCharactersDrawn = 0;
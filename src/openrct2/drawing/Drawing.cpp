@@ -14,6 +14,7 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "../object/Object.h"
+#include "../paint/PaintTileCache.h"
 #include "../platform/platform.h"
 #include "../sprites.h"
 #include "../util/Util.h"
@@ -24,16 +25,15 @@
 
 const PaletteMap& PaletteMap::GetDefault()
 {
-    static bool initialised = false;
+    // Sprites can be drawn on several threads, so the map is filled in only once, when it is first used
     static uint8_t data[256];
-    static PaletteMap defaultMap(data);
-    if (!initialised)
-    {
+    static PaletteMap defaultMap = []() {
         for (size_t i = 0; i < sizeof(data); i++)
         {
             data[i] = static_cast<uint8_t>(i);
         }
-    }
+        return PaletteMap(data);
+    }();
     return defaultMap;
 }
 
@@ -73,6 +73,11 @@ uint8_t PaletteMap::Blend(uint8_t src, uint8_t dst) const
     return (*this)[idx];
 }
 
+const uint8_t* PaletteMap::GetTable() const
+{
+    return _dataLength >= 256 ? _data : nullptr;
+}
+
 void PaletteMap::Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length)
 {
     auto maxLength = std::min(_mapLength - srcIndex, _mapLength - dstIndex);
@@ -651,6 +656,7 @@ void load_palette()
  */
 void gfx_invalidate_screen()
 {
+    PaintTileCacheInvalidateAll();
     gfx_set_dirty_blocks({ { 0, 0 }, { context_get_width(), context_get_height() } });
 }
 
@@ -11,6 +11,7 @@
 #define _DRAWING_H_
 
 #include "../common.h"
+#include "../core/MappedFile.h"
 #include "../interface/Colour.h"
 #include "../interface/ZoomLevel.h"
 #include "../world/Location.hpp"
@@ -99,7 +100,7 @@ struct rct_gx
 {
     rct_g1_header header;
     std::vector<rct_g1_element> elements;
-    std::unique_ptr<uint8_t[]> data;
+    OpenRCT2::MappedFile file;
 };
 
 struct rct_drawpixelinfo
@@ -539,6 +540,12 @@ public:
     uint8_t& operator[](size_t index);
     uint8_t operator[](size_t index) const;
     uint8_t Blend(uint8_t src, uint8_t dst) const;
+
+    /**
+     * Returns the first map as a table of 256 entries, or nullptr if it is not that long.
+     */
+    const uint8_t* GetTable() const;
+
     void Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length);
 };
 
@@ -753,6 +760,7 @@ int32_t gfx_get_string_width_new_lined(std::string_view text, FontSpriteBase fon
 int32_t gfx_get_string_width_no_formatting(std::string_view text, FontSpriteBase fontSpriteBase);
 int32_t string_get_height_raw(std::string_view text, FontSpriteBase fontBase);
 int32_t gfx_clip_string(char* buffer, int32_t width, FontSpriteBase fontSpriteBase);
+void gfx_invalidate_text_layouts();
 void shorten_path(utf8* buffer, size_t bufferSize, const utf8* path, int32_t availableWidth, FontSpriteBase fontSpriteBase);
 void ttf_draw_string(
     rct_drawpixelinfo* dpi, const_utf8string text, int32_t colour, const ScreenCoordsXY& coords, bool noFormatting,
@@ -786,6 +794,22 @@ extern void (*mask_fn)(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap);
 
+/**
+ * Draws a run of RLE sprite pixels at full size. Source pixels of 0 are transparent. With BLEND_SRC the source pixels are
+ * remapped through the 256 entry palette table first, with BLEND_DST the destination pixels are, and pixels remapped to
+ * 0 are transparent as well. Blending both is not supported.
+ */
+void rle_run_scalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, const uint8_t* paletteTable, DrawBlendOp blendOp);
+void rle_run_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, const uint8_t* paletteTable, DrawBlendOp blendOp);
+void rle_run_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, const uint8_t* paletteTable, DrawBlendOp blendOp);
+void rle_run_init();
+
+extern void (*rle_run_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, const uint8_t* paletteTable, DrawBlendOp blendOp);
+
 std::optional<uint32_t> GetPaletteG1Index(colour_t paletteId);
 std::optional<PaletteMap> GetPaletteMapForColour(colour_t paletteId);
 
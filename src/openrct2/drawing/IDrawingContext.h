@@ -16,6 +16,19 @@ namespace OpenRCT2::Drawing
 {
     struct IDrawingEngine;
 
+    /**
+     * A sprite to draw as part of a batch. Masked sprites use the image as the mask and Colour as the colour image,
+     * other sprites use Colour as their tertiary colour.
+     */
+    struct SpriteDrawCall
+    {
+        uint32_t Image;
+        uint32_t Colour;
+        int32_t X;
+        int32_t Y;
+        bool IsMasked;
+    };
+
     struct IDrawingContext
     {
         virtual ~IDrawingContext()
@@ -32,5 +45,20 @@ namespace OpenRCT2::Drawing
         virtual void DrawSpriteRawMasked(int32_t x, int32_t y, uint32_t maskImage, uint32_t colourImage) abstract;
         virtual void DrawSpriteSolid(uint32_t image, int32_t x, int32_t y, uint8_t colour) abstract;
         virtual void DrawGlyph(uint32_t image, int32_t x, int32_t y, const PaletteMap& palette) abstract;
+
+        /**
+         * Draws the sprites in order, engines that can queue them in one go override this.
+         */
+        virtual void DrawSprites(const SpriteDrawCall* sprites, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                const auto& sprite = sprites[i];
+                if (sprite.IsMasked)
+                    DrawSpriteRawMasked(sprite.X, sprite.Y, sprite.Image, sprite.Colour);
+                else
+                    DrawSprite(sprite.Image, sprite.X, sprite.Y, sprite.Colour);
+            }
+        }
     };
 } // namespace OpenRCT2::Drawing
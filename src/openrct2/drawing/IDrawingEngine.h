@@ -32,6 +32,16 @@ enum DRAWING_ENGINE_FLAGS
      * Whether or not the engine will only draw changed blocks of the screen each frame.
      */
     DEF_DIRTY_OPTIMISATIONS = 1 << 0,
+
+    /**
+     * Whether or not sprites can be drawn to separate parts of the screen on several threads at once.
+     */
+    DEF_PARALLEL_DRAWING = 1 << 1,
+
+    /**
+     * Whether or not sprites are drawn into the bits of the drawpixelinfo, so they can be drawn to any buffer in memory.
+     */
+    DEF_DRAWS_TO_BITS = 1 << 2,
 };
 
 struct rct_drawpixelinfo;
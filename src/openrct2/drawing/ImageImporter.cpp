@@ -11,15 +11,39 @@
 
 #include "../core/Imaging.h"
 
+#include <array>
 #include <cstring>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 
 using namespace OpenRCT2::Drawing;
 using ImportResult = ImageImporter::ImportResult;
 
 constexpr int32_t PALETTE_TRANSPARENT = -1;
 
+namespace
+{
+    /**
+     * A palette rearranged for matching colours: a map from exact colours to their first index, and the colours of the
+     * entries that images may use split into separate channels, so the search for the closest one can be vectorised.
+     */
+    struct PaletteLookup
+    {
+        std::unordered_map<uint32_t, int32_t> Exact;
+        size_t NumChangable{};
+        std::array<int32_t, PALETTE_SIZE> Red{};
+        std::array<int32_t, PALETTE_SIZE> Green{};
+        std::array<int32_t, PALETTE_SIZE> Blue{};
+        std::array<int32_t, PALETTE_SIZE> Index{};
+    };
+
+    uint32_t GetColourKey(int32_t red, int32_t green, int32_t blue)
+    {
+        return (static_cast<uint32_t>(red) << 16) | (static_cast<uint32_t>(green) << 8) | static_cast<uint32_t>(blue);
+    }
+} // namespace
+
 ImportResult ImageImporter::Import(
     const Image& image, int32_t offsetX, int32_t offsetY, IMPORT_FLAGS flags, IMPORT_MODE mode) const
 {
@@ -282,18 +306,49 @@ int32_t ImageImporter::CalculatePaletteIndex(
     return paletteIndex;
 }
 
-int32_t ImageImporter::GetPaletteIndex(const GamePalette& palette, int16_t* colour)
+/**
+ * The palettes passed to the importer never change, so the lookup is kept for the last palette used on each thread.
+ */
+static const PaletteLookup& GetPaletteLookup(const GamePalette& palette, bool (*isChangable)(int32_t))
 {
-    if (!IsTransparentPixel(colour))
+    thread_local const GamePalette* lookupPalette = nullptr;
+    thread_local PaletteLookup lookup;
+    if (lookupPalette != &palette)
     {
+        lookup = {};
         for (int32_t i = 0; i < PALETTE_SIZE; i++)
         {
-            if (static_cast<int16_t>(palette[i].Red) == colour[0] && static_cast<int16_t>(palette[i].Green) == colour[1]
-                && static_cast<int16_t>(palette[i].Blue) == colour[2])
+            lookup.Exact.emplace(GetColourKey(palette[i].Red, palette[i].Green, palette[i].Blue), i);
+            if (isChangable(i))
             {
-                return i;
+                lookup.Red[lookup.NumChangable] = palette[i].Red;
+                lookup.Green[lookup.NumChangable] = palette[i].Green;
+                lookup.Blue[lookup.NumChangable] = palette[i].Blue;
+                lookup.Index[lookup.NumChangable] = i;
+                lookup.NumChangable++;
             }
         }
+        lookupPalette = &palette;
+    }
+    return lookup;
+}
+
+int32_t ImageImporter::GetPaletteIndex(const GamePalette& palette, int16_t* colour)
+{
+    if (!IsTransparentPixel(colour))
+    {
+        // Dithering can push channels out of range, those colours are not in any palette
+        if (colour[0] < 0 || colour[0] > 255 || colour[1] < 0 || colour[1] > 255 || colour[2] < 0 || colour[2] > 255)
+        {
+            return PALETTE_TRANSPARENT;
+        }
+
+        const auto& exact = GetPaletteLookup(palette, IsChangablePixel).Exact;
+        auto it = exact.find(GetColourKey(colour[0], colour[1], colour[2]));
+        if (it != exact.end())
+        {
+            return it->second;
+        }
     }
     return PALETTE_TRANSPARENT;
 }
@@ -325,22 +380,30 @@ bool ImageImporter::IsChangablePixel(int32_t paletteIndex)
 
 int32_t ImageImporter::GetClosestPaletteIndex(const GamePalette& palette, const int16_t* colour)
 {
-    auto smallestError = static_cast<uint32_t>(-1);
+    const auto& lookup = GetPaletteLookup(palette, IsChangablePixel);
+    const int32_t red = colour[0];
+    const int32_t green = colour[1];
+    const int32_t blue = colour[2];
+
+    // Work out the error of every candidate first, this loop has no branches so it can be vectorised
+    std::array<uint32_t, PALETTE_SIZE> errors;
+    for (size_t i = 0; i < lookup.NumChangable; i++)
+    {
+        const int32_t dr = lookup.Red[i] - red;
+        const int32_t dg = lookup.Green[i] - green;
+        const int32_t db = lookup.Blue[i] - blue;
+        errors[i] = static_cast<uint32_t>(dr * dr + dg * dg + db * db);
+    }
+
+    // The first of the equally close entries wins
     auto bestMatch = PALETTE_TRANSPARENT;
-    for (int32_t x = 0; x < PALETTE_SIZE; x++)
+    auto smallestError = static_cast<uint32_t>(-1);
+    for (size_t i = 0; i < lookup.NumChangable; i++)
     {
-        if (IsChangablePixel(x))
+        if (bestMatch == PALETTE_TRANSPARENT || smallestError > errors[i])
         {
-            uint32_t error = (static_cast<int16_t>(palette[x].Red) - colour[0])
-                    * (static_cast<int16_t>(palette[x].Red) - colour[0])
-                + (static_cast<int16_t>(palette[x].Green) - colour[1]) * (static_cast<int16_t>(palette[x].Green) - colour[1])
-                + (static_cast<int16_t>(palette[x].Blue) - colour[2]) * (static_cast<int16_t>(palette[x].Blue) - colour[2]);
-
-            if (smallestError == static_cast<uint32_t>(-1) || smallestError > error)
-            {
-                bestMatch = x;
-                smallestError = error;
-            }
+            bestMatch = lookup.Index[i];
+            smallestError = errors[i];
         }
     }
     return bestMatch;
@@ -11,9 +11,11 @@
 
 #    include "LightFX.h"
 
+#    include "../Context.h"
 #    include "../Game.h"
 #    include "../common.h"
 #    include "../config/Config.h"
+#    include "../core/TaskScheduler.h"
 #    include "../interface/Viewport.h"
 #    include "../interface/Window.h"
 #    include "../interface/Window_internal.h"
@@ -29,6 +31,10 @@
 #    include <algorithm>
 #    include <cmath>
 #    include <cstring>
+#    include <optional>
+#    include <vector>
+
+using namespace OpenRCT2;
 
 static uint8_t _bakedLightTexture_lantern_0[32 * 32];
 static uint8_t _bakedLightTexture_lantern_1[64 * 64];
@@ -87,6 +93,30 @@ static ZoomLevel _current_view_zoom_back_delay = 0;
 
 static GamePalette gPalette_light;
 
+// The part of a light texture that is visible on the screen, in pixels of the light buffer.
+struct LightRect
+{
+    const uint8_t* Read;
+    uint32_t ReadWidth;
+    int32_t X;
+    int32_t Y;
+    int32_t Width;
+    int32_t Height;
+    uint32_t Intensity;
+};
+
+static std::vector<LightRect> _lightRects;
+
+// The screen is lit and mixed in bands of this many rows, which are spread over the task scheduler when multithreading
+// is enabled.
+static constexpr int32_t LightBandHeight = 64;
+
+static void (*lightfx_accumulate_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, uint32_t intensity) = lightfx_accumulate_scalar;
+static void (*lightfx_mix_fn)(
+    const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t length,
+    const uint32_t* palette, const uint32_t* lightPalette) = lightfx_mix_scalar;
+
 static uint8_t calc_light_intensity_lantern(int32_t x, int32_t y)
 {
     double distance = static_cast<double>(x * x + y * y);
@@ -143,6 +173,25 @@ bool lightfx_for_vehicles_is_available()
 
 void lightfx_init()
 {
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 light functions");
+        lightfx_accumulate_fn = lightfx_accumulate_avx2;
+        lightfx_mix_fn = lightfx_mix_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 light functions");
+        lightfx_accumulate_fn = lightfx_accumulate_sse4_1;
+        lightfx_mix_fn = lightfx_mix_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar light functions");
+        lightfx_accumulate_fn = lightfx_accumulate_scalar;
+        lightfx_mix_fn = lightfx_mix_scalar;
+    }
+
     _LightListBack = _LightListA;
     _LightListFront = _LightListB;
 
@@ -450,6 +499,22 @@ void lightfx_update_viewport_settings()
     }
 }
 
+static void lightfx_render_lights_to_band(int32_t top, int32_t bottom)
+{
+    auto bufWriteBase = static_cast<uint8_t*>(_light_rendered_buffer_front);
+    for (const auto& rect : _lightRects)
+    {
+        const int32_t startY = std::max(top, rect.Y);
+        const int32_t endY = std::min(bottom, rect.Y + rect.Height);
+        for (int32_t y = startY; y < endY; y++)
+        {
+            lightfx_accumulate_fn(
+                rect.Read + (y - rect.Y) * rect.ReadWidth, bufWriteBase + y * _pixelInfo.width + rect.X, rect.Width,
+                rect.Intensity);
+        }
+    }
+}
+
 void lightfx_render_lights_to_frontbuffer()
 {
     if (_light_rendered_buffer_front == nullptr)
@@ -460,17 +525,16 @@ void lightfx_render_lights_to_frontbuffer()
     std::memset(_light_rendered_buffer_front, 0, _pixelInfo.width * _pixelInfo.height);
 
     _lightPolution_back = 0;
+    _lightRects.clear();
 
     //  log_warning("%i lights", LightListCurrentCountFront);
 
     for (uint32_t light = 0; light < LightListCurrentCountFront; light++)
     {
         const uint8_t* bufReadBase = nullptr;
-        uint8_t* bufWriteBase = static_cast<uint8_t*>(_light_rendered_buffer_front);
         uint32_t bufReadWidth, bufReadHeight;
         int32_t bufWriteX, bufWriteY;
         int32_t bufWriteWidth, bufWriteHeight;
-        uint32_t bufReadSkip, bufWriteSkip;
 
         lightlist_entry* entry = &_LightListFront[light];
 
@@ -542,10 +606,6 @@ void lightfx_render_lights_to_frontbuffer()
             bufReadBase += -bufWriteX;
             bufWriteWidth += bufWriteX;
         }
-        else
-        {
-            bufWriteBase += bufWriteX;
-        }
 
         if (bufWriteWidth <= 0)
             continue;
@@ -555,10 +615,6 @@ void lightfx_render_lights_to_frontbuffer()
             bufReadBase += -bufWriteY * bufReadWidth;
             bufWriteHeight += bufWriteY;
         }
-        else
-        {
-            bufWriteBase += bufWriteY * _pixelInfo.width;
-        }
 
         if (bufWriteHeight <= 0)
             continue;
@@ -582,40 +638,33 @@ void lightfx_render_lights_to_frontbuffer()
 
         _lightPolution_back += (bufWriteWidth * bufWriteHeight) / 256;
 
-        bufReadSkip = bufReadWidth - bufWriteWidth;
-        bufWriteSkip = _pixelInfo.width - bufWriteWidth;
+        _lightRects.push_back({ bufReadBase, bufReadWidth, std::max(bufWriteX, 0), std::max(bufWriteY, 0), bufWriteWidth,
+                                bufWriteHeight, entry->lightIntensity });
+    }
 
-        if (entry->lightIntensity == 0xFF)
-        {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
-            {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
-                {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + *bufReadBase);
-                    bufWriteBase++;
-                    bufReadBase++;
-                }
+    std::optional<TaskGroup> tasks;
+    if (gConfigGeneral.multithreading)
+    {
+        tasks.emplace(GetContext()->GetTaskScheduler());
+    }
 
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
-            }
+    // Each band only adds the lights that overlap it, so the bands can be lit in parallel
+    for (int32_t bandTop = 0; bandTop < _pixelInfo.height; bandTop += LightBandHeight)
+    {
+        const int32_t bandBottom = std::min<int32_t>(bandTop + LightBandHeight, _pixelInfo.height);
+        if (tasks)
+        {
+            tasks->Run([bandTop, bandBottom]() -> void { lightfx_render_lights_to_band(bandTop, bandBottom); });
         }
         else
         {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
-            {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
-                {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + (((*bufReadBase) * (1 + entry->lightIntensity)) >> 8));
-                    bufWriteBase++;
-                    bufReadBase++;
-                }
-
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
-            }
+            lightfx_render_lights_to_band(bandTop, bandBottom);
         }
     }
+    if (tasks)
+    {
+        tasks->Wait();
+    }
 }
 
 void* lightfx_get_front_buffer()
@@ -1045,31 +1094,84 @@ void lightfx_render_to_texture(
         return;
     }
 
-    for (uint32_t y = 0; y < height; y++)
+    struct MixArgs
     {
-        uintptr_t dstOffset = static_cast<uintptr_t>(y * dstPitch);
-        uint32_t* dst = reinterpret_cast<uint32_t*>(reinterpret_cast<uintptr_t>(dstPixels) + dstOffset);
-        for (uint32_t x = 0; x < width; x++)
+        uint8_t* DstPixels;
+        uint32_t DstPitch;
+        const uint8_t* Bits;
+        const uint8_t* LightBits;
+        uint32_t Width;
+        const uint32_t* Palette;
+        const uint32_t* LightPalette;
+    };
+    const MixArgs args = { static_cast<uint8_t*>(dstPixels), dstPitch, bits, lightBits, width, palette, lightPalette };
+
+    auto mixBand = [](const MixArgs& a, uint32_t top, uint32_t bottom) {
+        for (uint32_t y = top; y < bottom; y++)
         {
-            uint8_t* src = &bits[y * width + x];
-            uint32_t darkColour = palette[*src];
-            uint32_t lightColour = lightPalette[*src];
-            uint8_t lightIntensity = lightBits[y * width + x];
+            auto dst = reinterpret_cast<uint32_t*>(a.DstPixels + static_cast<size_t>(y) * a.DstPitch);
+            const size_t offset = static_cast<size_t>(y) * a.Width;
+            lightfx_mix_fn(a.Bits + offset, a.LightBits + offset, dst, a.Width, a.Palette, a.LightPalette);
+        }
+    };
 
-            uint32_t colour = 0;
-            if (lightIntensity == 0)
-            {
-                colour = darkColour;
-            }
-            else
-            {
-                colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
-                colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
-                colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
-                colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
-            }
-            *dst++ = colour;
+    std::optional<TaskGroup> tasks;
+    if (gConfigGeneral.multithreading)
+    {
+        tasks.emplace(GetContext()->GetTaskScheduler());
+    }
+
+    for (uint32_t bandTop = 0; bandTop < height; bandTop += LightBandHeight)
+    {
+        const uint32_t bandBottom = std::min<uint32_t>(bandTop + LightBandHeight, height);
+        if (tasks)
+        {
+            const MixArgs* argsPtr = &args;
+            tasks->Run([mixBand, argsPtr, bandTop, bandBottom]() -> void { mixBand(*argsPtr, bandTop, bandBottom); });
+        }
+        else
+        {
+            mixBand(args, bandTop, bandBottom);
+        }
+    }
+    if (tasks)
+    {
+        tasks->Wait();
+    }
+}
+
+void lightfx_accumulate_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, uint32_t intensity)
+{
+    // A full intensity of 0xFF multiplies by 256, which adds the texture as it is
+    for (size_t i = 0; i < length; i++)
+    {
+        dst[i] = std::min<uint32_t>(0xFF, dst[i] + ((src[i] * (1 + intensity)) >> 8));
+    }
+}
+
+void lightfx_mix_scalar(
+    const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t length,
+    const uint32_t* palette, const uint32_t* lightPalette)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        uint32_t darkColour = palette[bits[i]];
+        uint32_t lightColour = lightPalette[bits[i]];
+        uint8_t lightIntensity = light[i];
+
+        uint32_t colour = 0;
+        if (lightIntensity == 0)
+        {
+            colour = darkColour;
+        }
+        else
+        {
+            colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
+            colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
+            colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
+            colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
         }
+        dst[i] = colour;
     }
 }
 
@@ -78,6 +78,26 @@ void lightfx_render_to_texture(
     void* dstPixels, uint32_t dstPitch, uint8_t* bits, uint32_t width, uint32_t height, const uint32_t* palette,
     const uint32_t* lightPalette);
 
+/**
+ * Adds a row of a light texture scaled by (intensity + 1) / 256 to a row of the light buffer, saturating at 255.
+ */
+void lightfx_accumulate_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, uint32_t intensity);
+void lightfx_accumulate_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, uint32_t intensity);
+void lightfx_accumulate_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, uint32_t intensity);
+
+/**
+ * Converts a row of palette indices to colours, brightening each one towards its light colour by the light buffer.
+ */
+void lightfx_mix_scalar(
+    const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t length,
+    const uint32_t* palette, const uint32_t* lightPalette);
+void lightfx_mix_sse4_1(
+    const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t length,
+    const uint32_t* palette, const uint32_t* lightPalette);
+void lightfx_mix_avx2(
+    const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t length,
+    const uint32_t* palette, const uint32_t* lightPalette);
+
 #endif // __ENABLE_LIGHTFX__
 
 #endif
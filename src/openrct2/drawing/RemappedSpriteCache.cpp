@@ -0,0 +1,224 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RemappedSpriteCache.h"
+
+#include <algorithm>
+
+// Finds where the runs of the last line of an RLE sprite end, as the length of the data is not stored with it.
+static size_t GetRLESpriteLength(const rct_g1_element& g1)
+{
+    const auto* data = g1.offset;
+    size_t length = static_cast<size_t>(g1.height) * 2;
+    for (int32_t y = 0; y < g1.height; y++)
+    {
+        size_t position = data[y * 2] | (data[y * 2 + 1] << 8);
+        bool isEndOfLine;
+        do
+        {
+            auto dataSize = data[position];
+            isEndOfLine = (dataSize & 0x80) != 0;
+            position += 2 + (dataSize & 0x7F);
+        } while (!isEndOfLine);
+        length = std::max(length, position);
+    }
+    return length;
+}
+
+static void RemapRLESprite(uint8_t* data, int32_t height, const PaletteMap& paletteMap)
+{
+    for (int32_t y = 0; y < height; y++)
+    {
+        size_t position = data[y * 2] | (data[y * 2 + 1] << 8);
+        bool isEndOfLine;
+        do
+        {
+            auto dataSize = data[position];
+            isEndOfLine = (dataSize & 0x80) != 0;
+            dataSize &= 0x7F;
+
+            // Pixels remapped to 0 become transparent, the same as when the remap is applied while drawing
+            auto* pixels = data + position + 2;
+            for (uint8_t i = 0; i < dataSize; i++)
+            {
+                if (pixels[i] != 0)
+                {
+                    pixels[i] = paletteMap[pixels[i]];
+                }
+            }
+            position += 2 + dataSize;
+        } while (!isEndOfLine);
+    }
+}
+
+std::mutex RemappedSpriteCache::_cachesMutex;
+std::vector<RemappedSpriteCache*> RemappedSpriteCache::_caches;
+
+RemappedSpriteCache::RemappedSpriteCache()
+{
+    std::lock_guard<std::mutex> lock(_cachesMutex);
+    _caches.push_back(this);
+}
+
+RemappedSpriteCache::~RemappedSpriteCache()
+{
+    std::lock_guard<std::mutex> lock(_cachesMutex);
+    _caches.erase(std::remove(_caches.begin(), _caches.end(), this), _caches.end());
+}
+
+uint64_t RemappedSpriteCache::GetKey(ImageId imageId)
+{
+    return imageId.ToUInt32() | (static_cast<uint64_t>(imageId.GetTertiary()) << 32);
+}
+
+const rct_g1_element* RemappedSpriteCache::Get(ImageId imageId, const rct_g1_element& source)
+{
+    auto it = _entriesByKey.find(GetKey(imageId));
+    if (it == _entriesByKey.end())
+    {
+        _stats.Misses++;
+        return nullptr;
+    }
+
+    auto entry = it->second;
+    if (entry->SourceData != source.offset || entry->Element.width != source.width
+        || entry->Element.height != source.height)
+    {
+        Remove(entry);
+        _stats.Misses++;
+        return nullptr;
+    }
+
+    // Keep the most recently drawn sprites at the front
+    _entries.splice(_entries.begin(), _entries, entry);
+    _stats.Hits++;
+    return &entry->Element;
+}
+
+const rct_g1_element* RemappedSpriteCache::Add(ImageId imageId, const rct_g1_element& source, const PaletteMap& paletteMap)
+{
+    if (!(source.flags & G1_FLAG_RLE_COMPRESSION) || source.offset == nullptr || source.height <= 0)
+        return nullptr;
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    auto key = GetKey(imageId);
+    auto it = _entriesByKey.find(key);
+    if (it != _entriesByKey.end())
+    {
+        Remove(it->second);
+    }
+
+    Entry entry;
+    entry.Key = key;
+    entry.SourceData = source.offset;
+    entry.Data.assign(source.offset, source.offset + GetRLESpriteLength(source));
+    RemapRLESprite(entry.Data.data(), source.height, paletteMap);
+    entry.Element = source;
+
+    _stats.MemoryUsed += entry.Data.size();
+    _entries.push_front(std::move(entry));
+    auto& added = _entries.front();
+    added.Element.offset = added.Data.data();
+    _entriesByKey[key] = _entries.begin();
+    _numEntriesByIndex[imageId.GetIndex()]++;
+
+    while (_stats.MemoryUsed > MAX_MEMORY && _entries.size() > 1)
+    {
+        Remove(std::prev(_entries.end()));
+    }
+
+    _stats.DecodeTime += std::chrono::steady_clock::now() - startTime;
+    return &added.Element;
+}
+
+void RemappedSpriteCache::Invalidate(uint32_t imageIndex)
+{
+    if (_numEntriesByIndex.find(imageIndex) == _numEntriesByIndex.end())
+        return;
+
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        auto next = std::next(it);
+        if (ImageId::FromUInt32(static_cast<uint32_t>(it->Key)).GetIndex() == imageIndex)
+        {
+            Remove(it);
+        }
+        it = next;
+    }
+}
+
+void RemappedSpriteCache::Clear()
+{
+    _entries.clear();
+    _entriesByKey.clear();
+    _numEntriesByIndex.clear();
+    _stats.MemoryUsed = 0;
+}
+
+RemappedSpriteCache::Stats RemappedSpriteCache::GetStats() const
+{
+    auto stats = _stats;
+    stats.NumEntries = _entries.size();
+    return stats;
+}
+
+void RemappedSpriteCache::InvalidateAll(uint32_t imageIndex)
+{
+    std::lock_guard<std::mutex> lock(_cachesMutex);
+    for (auto* cache : _caches)
+    {
+        cache->Invalidate(imageIndex);
+    }
+}
+
+void RemappedSpriteCache::ClearAll()
+{
+    std::lock_guard<std::mutex> lock(_cachesMutex);
+    for (auto* cache : _caches)
+    {
+        cache->Clear();
+    }
+}
+
+RemappedSpriteCache::Stats RemappedSpriteCache::GetTotalStats()
+{
+    std::lock_guard<std::mutex> lock(_cachesMutex);
+    Stats total;
+    for (const auto* cache : _caches)
+    {
+        auto stats = cache->GetStats();
+        total.NumEntries += stats.NumEntries;
+        total.MemoryUsed += stats.MemoryUsed;
+        total.Hits += stats.Hits;
+        total.Misses += stats.Misses;
+        total.DecodeTime += stats.DecodeTime;
+    }
+    return total;
+}
+
+void RemappedSpriteCache::Remove(std::list<Entry>::iterator it)
+{
+    auto index = ImageId::FromUInt32(static_cast<uint32_t>(it->Key)).GetIndex();
+    auto itCount = _numEntriesByIndex.find(index);
+    if (itCount != _numEntriesByIndex.end() && --itCount->second == 0)
+    {
+        _numEntriesByIndex.erase(itCount);
+    }
+
+    _stats.MemoryUsed -= it->Data.size();
+    _entriesByKey.erase(it->Key);
+    _entries.erase(it);
+}
+
+RemappedSpriteCache& GetRemappedSpriteCache()
+{
+    thread_local RemappedSpriteCache cache;
+    return cache;
+}
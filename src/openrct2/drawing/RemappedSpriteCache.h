@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Drawing.h"
+
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Keeps copies of RLE sprites with the palette remap of their image id already applied, so drawing a recoloured guest or
+ * vehicle again copies its runs as they are instead of looking up every pixel in the palette map. Once the copies take
+ * up more than the budget, the ones drawn least recently are dropped. Only used by the software renderer, which can draw
+ * viewport columns on several threads at once, so each thread has a cache of its own.
+ */
+class RemappedSpriteCache final
+{
+public:
+    struct Stats
+    {
+        size_t NumEntries{};
+        size_t MemoryUsed{};
+        uint64_t Hits{};
+        uint64_t Misses{};
+        std::chrono::nanoseconds DecodeTime{};
+    };
+
+private:
+    static constexpr size_t MAX_MEMORY = 8 * 1024 * 1024;
+
+    struct Entry
+    {
+        uint64_t Key{};
+        const uint8_t* SourceData{};
+        rct_g1_element Element{};
+        std::vector<uint8_t> Data;
+    };
+
+    std::list<Entry> _entries;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> _entriesByKey;
+    std::unordered_map<uint32_t, uint32_t> _numEntriesByIndex;
+    Stats _stats;
+
+    static std::mutex _cachesMutex;
+    static std::vector<RemappedSpriteCache*> _caches;
+
+public:
+    RemappedSpriteCache();
+    RemappedSpriteCache(const RemappedSpriteCache&) = delete;
+    ~RemappedSpriteCache();
+
+    RemappedSpriteCache& operator=(const RemappedSpriteCache&) = delete;
+
+    /**
+     * Returns the remapped copy of the sprite, or nullptr if there is none or the sprite has changed since.
+     */
+    const rct_g1_element* Get(ImageId imageId, const rct_g1_element& source);
+
+    /**
+     * Remaps a copy of the RLE sprite with the palette map, which must be the one the image id selects.
+     */
+    const rct_g1_element* Add(ImageId imageId, const rct_g1_element& source, const PaletteMap& paletteMap);
+
+    /**
+     * Drops the copies of the image, for when it is replaced.
+     */
+    void Invalidate(uint32_t imageIndex);
+
+    void Clear();
+    Stats GetStats() const;
+
+    /**
+     * Drops the copies of the image from the cache of every thread. Must not be called while sprites are being drawn.
+     */
+    static void InvalidateAll(uint32_t imageIndex);
+
+    static void ClearAll();
+    static Stats GetTotalStats();
+
+private:
+    static uint64_t GetKey(ImageId imageId);
+    void Remove(std::list<Entry>::iterator it);
+};
+
+/**
+ * Returns the cache of the calling thread.
+ */
+RemappedSpriteCache& GetRemappedSpriteCache();
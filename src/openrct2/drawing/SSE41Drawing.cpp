@@ -10,6 +10,9 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "Drawing.h"
+#include "LightFX.h"
+
+#include <cstring>
 
 #ifdef __SSE4_1__
 
@@ -56,6 +59,105 @@ void mask_sse4_1(
     }
 }
 
+// Looks up 16 pixels in a 256 entry table without a gather. Each row of 16 entries is shuffled by the low nibble of
+// the pixels, and kept for the pixels whose high nibble is that row.
+static __m128i RemapPixels(const uint8_t* table, __m128i pixels)
+{
+    const __m128i lowNibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i low = _mm_and_si128(pixels, lowNibbleMask);
+    const __m128i high = _mm_and_si128(_mm_srli_epi16(pixels, 4), lowNibbleMask);
+    __m128i result = _mm_setzero_si128();
+    for (int32_t row = 0; row < 16; row++)
+    {
+        const __m128i entries = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + row * 16));
+        const __m128i isRow = _mm_cmpeq_epi8(high, _mm_set1_epi8(static_cast<char>(row)));
+        // _mm_shuffle_epi8 is SSSE3
+        result = _mm_blendv_epi8(result, _mm_shuffle_epi8(entries, low), isRow);
+    }
+    return result;
+}
+
+void rle_run_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, const uint8_t* paletteTable, DrawBlendOp blendOp)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i pixels = source;
+        if (blendOp & BLEND_SRC)
+        {
+            pixels = RemapPixels(paletteTable, source);
+        }
+        else if (blendOp & BLEND_DST)
+        {
+            pixels = RemapPixels(paletteTable, dest);
+        }
+
+        // Keep the destination wherever the source or the remapped pixel is transparent
+        const __m128i transparent = _mm_or_si128(_mm_cmpeq_epi8(source, zero), _mm_cmpeq_epi8(pixels, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(pixels, dest, transparent));
+    }
+    rle_run_scalar(src + i, dst + i, length - i, paletteTable, blendOp);
+}
+
+#    ifdef __ENABLE_LIGHTFX__
+
+void lightfx_accumulate_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, uint32_t intensity)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i factor = _mm_set1_epi16(static_cast<int16_t>(intensity + 1));
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(source), factor), 8);
+        const __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(source, zero), factor), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_adds_epu8(dest, _mm_packus_epi16(lo, hi)));
+    }
+    lightfx_accumulate_scalar(src + i, dst + i, length - i, intensity);
+}
+
+void lightfx_mix_sse4_1(
+    const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t length,
+    const uint32_t* palette, const uint32_t* lightPalette)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i everyChannel = _mm_set1_epi32(0x01010101);
+    const __m128i six = _mm_set1_epi16(6);
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        const __m128i dark = _mm_set_epi32(
+            static_cast<int32_t>(palette[bits[i + 3]]), static_cast<int32_t>(palette[bits[i + 2]]),
+            static_cast<int32_t>(palette[bits[i + 1]]), static_cast<int32_t>(palette[bits[i]]));
+        const __m128i lit = _mm_set_epi32(
+            static_cast<int32_t>(lightPalette[bits[i + 3]]), static_cast<int32_t>(lightPalette[bits[i + 2]]),
+            static_cast<int32_t>(lightPalette[bits[i + 1]]), static_cast<int32_t>(lightPalette[bits[i]]));
+
+        // Repeat the intensity of each pixel in all four of its channels
+        int32_t intensities;
+        std::memcpy(&intensities, light + i, sizeof(intensities));
+        const __m128i intensity = _mm_mullo_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(intensities)), everyChannel);
+
+        // dark + ((lit * intensity * 6) >> 8): unpacking the light colour into the high byte lets the high half of the
+        // multiply do the shift, and packing saturates at 255. An intensity of 0 leaves the dark colour as it is.
+        const __m128i lo = _mm_add_epi16(
+            _mm_unpacklo_epi8(dark, zero),
+            _mm_mulhi_epu16(_mm_unpacklo_epi8(zero, lit), _mm_mullo_epi16(_mm_unpacklo_epi8(intensity, zero), six)));
+        const __m128i hi = _mm_add_epi16(
+            _mm_unpackhi_epi8(dark, zero),
+            _mm_mulhi_epu16(_mm_unpackhi_epi8(zero, lit), _mm_mullo_epi16(_mm_unpackhi_epi8(intensity, zero), six)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    lightfx_mix_scalar(bits + i, light + i, dst + i, length - i, palette, lightPalette);
+}
+
+#    endif // __ENABLE_LIGHTFX__
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -69,4 +171,26 @@ void mask_sse4_1(
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+void rle_run_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, const uint8_t* paletteTable, DrawBlendOp blendOp)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+#    ifdef __ENABLE_LIGHTFX__
+
+void lightfx_accumulate_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, size_t length, uint32_t intensity)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void lightfx_mix_sse4_1(
+    const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t length,
+    const uint32_t* palette, const uint32_t* lightPalette)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+#    endif // __ENABLE_LIGHTFX__
+
 #endif // __SSE4_1__
@@ -21,30 +21,102 @@
 #include "TTF.h"
 
 #include <algorithm>
+#include <array>
+#include <list>
 #include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 using namespace OpenRCT2;
 
-struct rct_draw_scroll_text
+// What is drawn on a sign, without where it has scrolled to.
+struct rct_scroll_text_key
 {
     rct_string_id string_id;
     uint8_t string_args[32];
     colour_t colour;
+    uint8_t style;
+
+    bool operator==(const rct_scroll_text_key& other) const
+    {
+        return string_id == other.string_id && std::memcmp(string_args, other.string_args, sizeof(string_args)) == 0
+            && colour == other.colour && style == other.style;
+    }
+};
+
+struct rct_draw_scroll_text
+{
+    rct_scroll_text_key key;
     uint16_t position;
     uint16_t mode;
-    uint32_t id;
+    bool used;
     uint8_t bitmap[64 * 40];
 };
 
+struct rct_draw_scroll_text_key
+{
+    rct_scroll_text_key key;
+    uint16_t position;
+    uint16_t mode;
+
+    bool operator==(const rct_draw_scroll_text_key& other) const
+    {
+        return key == other.key && position == other.position && mode == other.mode;
+    }
+};
+
+// The text of a sign rendered once as a strip of 8 pixel high columns, so scrolling it only has to copy the columns to
+// their new positions instead of formatting and rendering the text again.
+struct rct_scroll_text_strip
+{
+    std::vector<std::array<uint8_t, 8>> columns;
+    // Whether the columns start over once the end is reached, or the rest of the sign is left blank.
+    bool wraps;
+    uint32_t last_used;
+};
+
+struct scroll_text_key_hash
+{
+    size_t operator()(const rct_scroll_text_key& key) const
+    {
+        size_t hash = std::hash<std::string_view>()(
+            std::string_view(reinterpret_cast<const char*>(key.string_args), sizeof(key.string_args)));
+        hash = hash * 31 + key.string_id;
+        hash = hash * 31 + key.colour;
+        return hash * 31 + key.style;
+    }
+
+    size_t operator()(const rct_draw_scroll_text_key& key) const
+    {
+        size_t hash = (*this)(key.key);
+        hash = hash * 31 + key.position;
+        return hash * 31 + key.mode;
+    }
+};
+
+enum : uint8_t
+{
+    SCROLL_TEXT_STYLE_TTF = 1 << 0,
+    SCROLL_TEXT_STYLE_UPPER_CASE = 1 << 1,
+    SCROLL_TEXT_STYLE_HINTING = 1 << 2,
+};
+
+static constexpr size_t MaxScrollingTextStrips = 1024;
+
 static rct_draw_scroll_text _drawScrollTextList[OpenRCT2::MaxScrollingTextEntries];
 static uint8_t _characterBitmaps[FONT_SPRITE_GLYPH_COUNT + SPR_G2_GLYPH_COUNT][8];
 static uint32_t _drawSCrollNextIndex = 0;
 static std::mutex _scrollingTextMutex;
 
-static void scrolling_text_set_bitmap_for_sprite(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour);
-static void scrolling_text_set_bitmap_for_ttf(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour);
+// The bitmaps in use by their contents and the order they were last used in, the least recently used one is replaced.
+static std::unordered_map<rct_draw_scroll_text_key, int32_t, scroll_text_key_hash> _drawScrollTextIndices;
+static std::list<int32_t> _drawScrollTextByAge;
+static std::array<std::list<int32_t>::iterator, OpenRCT2::MaxScrollingTextEntries> _drawScrollTextAges;
+static std::unordered_map<rct_scroll_text_key, rct_scroll_text_strip, scroll_text_key_hash> _scrollTextStrips;
+
+static void scrolling_text_set_strip_for_sprite(std::string_view text, colour_t colour, rct_scroll_text_strip& strip);
+static void scrolling_text_set_strip_for_ttf(std::string_view text, colour_t colour, rct_scroll_text_strip& strip);
 
 void scrolling_text_initialise_bitmaps()
 {
@@ -119,6 +191,9 @@ void scrolling_text_initialise_bitmaps()
 
         gfx_set_g1_element(imageId, &g1);
     }
+
+    // The text of the signs has to be rendered again with the new characters
+    scrolling_text_invalidate();
 }
 
 static uint8_t* font_sprite_get_codepoint_bitmap(int32_t codepoint)
@@ -134,41 +209,128 @@ static uint8_t* font_sprite_get_codepoint_bitmap(int32_t codepoint)
     }
 }
 
-static int32_t scrolling_text_get_matching_or_oldest(
-    rct_string_id stringId, Formatter& ft, uint16_t scroll, uint16_t scrollingMode, colour_t colour)
+static void scrolling_text_init_ages()
 {
-    uint32_t oldestId = 0xFFFFFFFF;
-    int32_t scrollIndex = -1;
-    for (size_t i = 0; i < std::size(_drawScrollTextList); i++)
+    _drawScrollTextByAge.clear();
+    for (int32_t i = 0; i < OpenRCT2::MaxScrollingTextEntries; i++)
     {
-        rct_draw_scroll_text* scrollText = &_drawScrollTextList[i];
-        if (oldestId >= scrollText->id)
-        {
-            oldestId = scrollText->id;
-            scrollIndex = static_cast<int32_t>(i);
-        }
+        _drawScrollTextAges[i] = _drawScrollTextByAge.insert(_drawScrollTextByAge.end(), i);
+    }
+}
 
-        // If exact match return the matching index
-        if (scrollText->string_id == stringId
-            && std::memcmp(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args)) == 0
-            && scrollText->colour == colour && scrollText->position == scroll && scrollText->mode == scrollingMode)
-        {
-            scrollText->id = _drawSCrollNextIndex;
-            return static_cast<int32_t>(i + SPR_SCROLLING_TEXT_START);
-        }
+static void scrolling_text_touch(int32_t scrollIndex)
+{
+    _drawScrollTextByAge.splice(_drawScrollTextByAge.end(), _drawScrollTextByAge, _drawScrollTextAges[scrollIndex]);
+}
+
+static int32_t scrolling_text_get_matching_or_oldest(const rct_draw_scroll_text_key& key)
+{
+    if (_drawScrollTextByAge.empty())
+    {
+        scrolling_text_init_ages();
     }
+
+    auto it = _drawScrollTextIndices.find(key);
+    if (it != _drawScrollTextIndices.end())
+    {
+        scrolling_text_touch(it->second);
+        return it->second + SPR_SCROLLING_TEXT_START;
+    }
+
+    auto scrollIndex = _drawScrollTextByAge.front();
+    scrolling_text_touch(scrollIndex);
     return scrollIndex;
 }
 
-static void scrolling_text_format(utf8* dst, size_t size, rct_draw_scroll_text* scrollText)
+static void scrolling_text_format(utf8* dst, size_t size, const rct_scroll_text_key& key)
 {
-    if (gConfigGeneral.upper_case_banners)
+    if (key.style & SCROLL_TEXT_STYLE_UPPER_CASE)
     {
-        format_string_to_upper(dst, size, scrollText->string_id, scrollText->string_args);
+        format_string_to_upper(dst, size, key.string_id, key.string_args);
     }
     else
     {
-        format_string(dst, size, scrollText->string_id, scrollText->string_args);
+        format_string(dst, size, key.string_id, key.string_args);
+    }
+}
+
+// Drops the strips that have not been used for the longest, once there are more than the limit.
+static void scrolling_text_trim_strips()
+{
+    if (_scrollTextStrips.size() <= MaxScrollingTextStrips)
+        return;
+
+    std::vector<uint32_t> lastUsed;
+    lastUsed.reserve(_scrollTextStrips.size());
+    for (const auto& [key, strip] : _scrollTextStrips)
+    {
+        lastUsed.push_back(strip.last_used);
+    }
+    auto threshold = lastUsed.begin() + lastUsed.size() / 4;
+    std::nth_element(lastUsed.begin(), threshold, lastUsed.end());
+    auto oldest = *threshold;
+    for (auto it = _scrollTextStrips.begin(); it != _scrollTextStrips.end();)
+    {
+        if (it->second.last_used < oldest)
+            it = _scrollTextStrips.erase(it);
+        else
+            it++;
+    }
+}
+
+static const rct_scroll_text_strip& scrolling_text_get_strip(const rct_scroll_text_key& key)
+{
+    auto it = _scrollTextStrips.find(key);
+    if (it != _scrollTextStrips.end())
+    {
+        it->second.last_used = _drawSCrollNextIndex;
+        return it->second;
+    }
+
+    scrolling_text_trim_strips();
+
+    // Create the string to draw
+    utf8 scrollString[256];
+    scrolling_text_format(scrollString, 256, key);
+
+    auto& strip = _scrollTextStrips[key];
+    strip.last_used = _drawSCrollNextIndex;
+    if (key.style & SCROLL_TEXT_STYLE_TTF)
+    {
+        scrolling_text_set_strip_for_ttf(scrollString, key.colour, strip);
+    }
+    else
+    {
+        scrolling_text_set_strip_for_sprite(scrollString, key.colour, strip);
+    }
+    return strip;
+}
+
+static void scrolling_text_draw_strip(
+    const rct_scroll_text_strip& strip, uint32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets)
+{
+    const auto numColumns = static_cast<uint32_t>(strip.columns.size());
+    if (numColumns == 0)
+        return;
+
+    for (auto column = scroll; *scrollPositionOffsets != -1; column++, scrollPositionOffsets++)
+    {
+        if (column >= numColumns && !strip.wraps)
+            return;
+
+        int16_t scrollPosition = *scrollPositionOffsets;
+        if (scrollPosition < 0)
+            continue;
+
+        auto dst = &bitmap[scrollPosition];
+        for (auto pixel : strip.columns[column % numColumns])
+        {
+            if (pixel != 0)
+                *dst = pixel;
+
+            // Jump to next row
+            dst += 64;
+        }
     }
 }
 
@@ -1440,11 +1602,15 @@ static constexpr const int16_t* _scrollPositions[MAX_SCROLLING_TEXT_MODES] = {
 
 void scrolling_text_invalidate()
 {
+    std::scoped_lock<std::mutex> lock(_scrollingTextMutex);
+
     for (auto& scrollText : _drawScrollTextList)
     {
-        scrollText.string_id = 0;
-        std::memset(scrollText.string_args, 0, sizeof(scrollText.string_args));
+        scrollText.used = false;
     }
+    _drawScrollTextIndices.clear();
+    _scrollTextStrips.clear();
+    scrolling_text_init_ages();
 }
 
 int32_t scrolling_text_setup(
@@ -1461,47 +1627,53 @@ int32_t scrolling_text_setup(
 
     _drawSCrollNextIndex++;
     ft.Rewind();
-    int32_t scrollIndex = scrolling_text_get_matching_or_oldest(stringId, ft, scroll, scrollingMode, colour);
+
+    rct_draw_scroll_text_key key{};
+    key.key.string_id = stringId;
+    std::memcpy(key.key.string_args, ft.Buf(), sizeof(key.key.string_args));
+    key.key.colour = colour;
+    if (LocalisationService_UseTrueTypeFont())
+        key.key.style |= SCROLL_TEXT_STYLE_TTF;
+    if (gConfigGeneral.upper_case_banners)
+        key.key.style |= SCROLL_TEXT_STYLE_UPPER_CASE;
+    if (gConfigFonts.enable_hinting)
+        key.key.style |= SCROLL_TEXT_STYLE_HINTING;
+    key.position = scroll;
+    key.mode = scrollingMode;
+
+    int32_t scrollIndex = scrolling_text_get_matching_or_oldest(key);
     if (scrollIndex >= SPR_SCROLLING_TEXT_START)
         return scrollIndex;
 
     // Setup scrolling text
     auto scrollText = &_drawScrollTextList[scrollIndex];
-    scrollText->string_id = stringId;
-    std::memcpy(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args));
-    scrollText->colour = colour;
+    if (scrollText->used)
+    {
+        _drawScrollTextIndices.erase({ scrollText->key, scrollText->position, scrollText->mode });
+    }
+    scrollText->key = key.key;
     scrollText->position = scroll;
     scrollText->mode = scrollingMode;
-    scrollText->id = _drawSCrollNextIndex;
-
-    // Create the string to draw
-    utf8 scrollString[256];
-    scrolling_text_format(scrollString, 256, scrollText);
+    scrollText->used = true;
+    _drawScrollTextIndices[key] = scrollIndex;
 
-    const int16_t* scrollingModePositions = _scrollPositions[scrollingMode];
+    const auto& strip = scrolling_text_get_strip(key.key);
 
     std::fill_n(scrollText->bitmap, 320 * 8, 0x00);
-    if (LocalisationService_UseTrueTypeFont())
-    {
-        scrolling_text_set_bitmap_for_ttf(scrollString, scroll, scrollText->bitmap, scrollingModePositions, colour);
-    }
-    else
-    {
-        scrolling_text_set_bitmap_for_sprite(scrollString, scroll, scrollText->bitmap, scrollingModePositions, colour);
-    }
+    scrolling_text_draw_strip(strip, scroll, scrollText->bitmap, _scrollPositions[scrollingMode]);
 
     uint32_t imageId = SPR_SCROLLING_TEXT_START + scrollIndex;
     drawing_engine_invalidate_image(imageId);
     return imageId;
 }
 
-static void scrolling_text_set_bitmap_for_sprite(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour)
+static void scrolling_text_set_strip_for_sprite(std::string_view text, colour_t colour, rct_scroll_text_strip& strip)
 {
     auto characterColour = colour;
     auto fmt = FmtString(text);
 
     // Repeat string a maximum of four times (eliminates possibility of infinite loop)
+    strip.wraps = false;
     for (auto i = 0; i < 4; i++)
     {
         for (const auto& token : fmt)
@@ -1515,30 +1687,17 @@ static void scrolling_text_set_bitmap_for_sprite(
                     auto characterBitmap = font_sprite_get_codepoint_bitmap(codepoint);
                     for (; characterWidth != 0; characterWidth--, characterBitmap++)
                     {
-                        // Skip any non-displayed columns
-                        if (scroll != 0)
+                        auto& column = strip.columns.emplace_back();
+                        column.fill(0);
+                        auto dst = column.begin();
+                        for (uint8_t char_bitmap = *characterBitmap; char_bitmap != 0; char_bitmap >>= 1)
                         {
-                            scroll--;
-                            continue;
-                        }
+                            if (char_bitmap & 1)
+                                *dst = characterColour;
 
-                        int16_t scrollPosition = *scrollPositionOffsets;
-                        if (scrollPosition == -1)
-                            return;
-
-                        if (scrollPosition > -1)
-                        {
-                            auto dst = &bitmap[scrollPosition];
-                            for (uint8_t char_bitmap = *characterBitmap; char_bitmap != 0; char_bitmap >>= 1)
-                            {
-                                if (char_bitmap & 1)
-                                    *dst = characterColour;
-
-                                // Jump to next row
-                                dst += 64;
-                            }
+                            // Jump to next row
+                            dst++;
                         }
-                        scrollPositionOffsets++;
                     }
                 }
             }
@@ -1555,14 +1714,13 @@ static void scrolling_text_set_bitmap_for_sprite(
     }
 }
 
-static void scrolling_text_set_bitmap_for_ttf(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour)
+static void scrolling_text_set_strip_for_ttf(std::string_view text, colour_t colour, rct_scroll_text_strip& strip)
 {
 #ifndef NO_TTF
     auto fontDesc = ttf_get_font_from_sprite_base(FontSpriteBase::TINY);
     if (fontDesc->font == nullptr)
     {
-        scrolling_text_set_bitmap_for_sprite(text, scroll, bitmap, scrollPositionOffsets, colour);
+        scrolling_text_set_strip_for_sprite(text, colour, strip);
         return;
     }
 
@@ -1587,6 +1745,9 @@ static void scrolling_text_set_bitmap_for_ttf(
         }
     }
 
+    // TrueType text wraps around forever
+    strip.wraps = true;
+
     auto surface = ttf_surface_cache_get_or_add(fontDesc->font, ttfBuffer.c_str());
     if (surface == nullptr)
     {
@@ -1606,46 +1767,32 @@ static void scrolling_text_set_bitmap_for_ttf(
 
     bool use_hinting = gConfigFonts.enable_hinting && fontDesc->hinting_threshold > 0;
 
-    for (int32_t x = 0;; x++)
+    strip.columns.resize(width);
+    for (int32_t x = 0; x < width; x++)
     {
-        if (x >= width)
-            x = 0;
+        auto& column = strip.columns[x];
+        column.fill(0);
+        auto dst = column.begin();
 
-        // Skip any non-displayed columns
-        if (scroll == 0)
+        for (int32_t y = min_vpos; y < max_vpos; y++)
         {
-            int16_t scrollPosition = *scrollPositionOffsets;
-            if (scrollPosition == -1)
-                return;
-
-            if (scrollPosition > -1)
+            uint8_t src_pixel = src[y * pitch + x];
+            if ((!use_hinting && src_pixel != 0) || src_pixel > 140)
             {
-                uint8_t* dst = &bitmap[scrollPosition];
-
-                for (int32_t y = min_vpos; y < max_vpos; y++)
-                {
-                    uint8_t src_pixel = src[y * pitch + x];
-                    if ((!use_hinting && src_pixel != 0) || src_pixel > 140)
-                    {
-                        // Centre of the glyph: use full colour.
-                        *dst = colour;
-                    }
-                    else if (use_hinting && src_pixel > fontDesc->hinting_threshold)
-                    {
-                        // Simulate font hinting by shading the background colour instead.
-                        *dst = blendColours(colour, *dst);
-                    }
-
-                    // Jump to next row
-                    dst += 64;
-                }
+                // Centre of the glyph: use full colour.
+                *dst = colour;
             }
-            scrollPositionOffsets++;
-        }
-        else
-        {
-            scroll--;
+            else if (use_hinting && src_pixel > fontDesc->hinting_threshold)
+            {
+                // Simulate font hinting by shading the background colour instead.
+                *dst = blendColours(colour, 0);
+            }
+
+            // Jump to next row
+            dst++;
         }
     }
+#else
+    scrolling_text_set_strip_for_sprite(text, colour, strip);
 #endif // NO_TTF
 }
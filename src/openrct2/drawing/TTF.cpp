@@ -10,7 +10,11 @@
 #ifndef NO_TTF
 
 #    include <atomic>
+#    include <list>
 #    include <mutex>
+#    include <string>
+#    include <unordered_map>
+#    include <utility>
 #    pragma clang diagnostic push
 #    pragma clang diagnostic ignored "-Wdocumentation"
 #    include <ft2build.h>
@@ -23,46 +27,49 @@
 #    include "../localisation/Localisation.h"
 #    include "../localisation/LocalisationService.h"
 #    include "../platform/platform.h"
+#    include "Drawing.h"
 #    include "TTF.h"
 
 static bool _ttfInitialised = false;
 
-#    define TTF_SURFACE_CACHE_SIZE 256
-#    define TTF_GETWIDTH_CACHE_SIZE 1024
+static constexpr size_t TTF_RUN_CACHE_MAX_RUNS = 4096;
+static constexpr size_t TTF_RUN_CACHE_MAX_MEMORY = 4 * 1024 * 1024;
 
-struct ttf_cache_entry
+// A run of text in one of the fonts, with its width and the surface it renders to once they are needed.
+struct ttf_run
 {
-    TTFSurface* surface;
     TTF_Font* font;
-    utf8* text;
+    std::string text;
+    uint32_t width;
+    bool hasWidth;
+    TTFSurface* surface;
     uint32_t lastUseTick;
 };
 
-struct ttf_getwidth_cache_entry
+// The text of the key points into the run it belongs to, so looking up a run does not have to copy the text.
+using ttf_run_key = std::pair<const TTF_Font*, std::string_view>;
+
+struct ttf_run_key_hash
 {
-    uint32_t width;
-    TTF_Font* font;
-    utf8* text;
-    uint32_t lastUseTick;
+    size_t operator()(const ttf_run_key& key) const
+    {
+        return std::hash<std::string_view>()(key.second) ^ (std::hash<const void*>()(key.first) * 31);
+    }
 };
 
-static ttf_cache_entry _ttfSurfaceCache[TTF_SURFACE_CACHE_SIZE] = {};
-static int32_t _ttfSurfaceCacheCount = 0;
-static int32_t _ttfSurfaceCacheHitCount = 0;
-static int32_t _ttfSurfaceCacheMissCount = 0;
+// The runs are kept in the order they were last used in, so the ones not used for the longest are dropped first.
+static std::list<ttf_run> _ttfRuns;
+static std::unordered_map<ttf_run_key, std::list<ttf_run>::iterator, ttf_run_key_hash> _ttfRunsByKey;
+static size_t _ttfRunsMemory = 0;
 
-static ttf_getwidth_cache_entry _ttfGetWidthCache[TTF_GETWIDTH_CACHE_SIZE] = {};
-static int32_t _ttfGetWidthCacheCount = 0;
-static int32_t _ttfGetWidthCacheHitCount = 0;
-static int32_t _ttfGetWidthCacheMissCount = 0;
+static std::atomic<uint64_t> _ttfRunCacheHitCount{};
+static std::atomic<uint64_t> _ttfRunCacheMissCount{};
 
 static std::mutex _mutex;
 
 static TTF_Font* ttf_open_font(const utf8* fontPath, int32_t ptSize);
 static void ttf_close_font(TTF_Font* font);
-static void ttf_surface_cache_dispose(ttf_cache_entry* entry);
-static void ttf_surface_cache_dispose_all();
-static void ttf_getwidth_cache_dispose_all();
+static void ttf_run_cache_dispose_all();
 static bool ttf_get_size(TTF_Font* font, std::string_view text, int32_t* outWidth, int32_t* outHeight);
 static void ttf_toggle_hinting(bool);
 static TTFSurface* ttf_render(TTF_Font* font, std::string_view text);
@@ -101,10 +108,9 @@ static void ttf_toggle_hinting(bool)
         TTF_SetFontHinting(fontDesc->font, use_hinting ? 1 : 0);
     }
 
-    if (_ttfSurfaceCacheCount)
-    {
-        ttf_surface_cache_dispose_all();
-    }
+    // Hinting changes both the widths and the surfaces of the runs
+    ttf_run_cache_dispose_all();
+    gfx_invalidate_text_layouts();
 }
 
 bool ttf_initialise()
@@ -153,8 +159,8 @@ void ttf_dispose()
     if (!_ttfInitialised)
         return;
 
-    ttf_surface_cache_dispose_all();
-    ttf_getwidth_cache_dispose_all();
+    ttf_run_cache_dispose_all();
+    gfx_invalidate_text_layouts();
 
     for (int32_t i = 0; i < FONT_SIZE_COUNT; i++)
     {
@@ -181,36 +187,74 @@ static void ttf_close_font(TTF_Font* font)
     TTF_CloseFont(font);
 }
 
-static uint32_t ttf_surface_cache_hash(TTF_Font* font, std::string_view text)
+static size_t ttf_run_get_memory(const ttf_run& run)
 {
-    uint32_t hash = static_cast<uint32_t>(((reinterpret_cast<uintptr_t>(font) * 23) ^ 0xAAAAAAAA) & 0xFFFFFFFF);
-    for (auto c : text)
+    size_t memory = sizeof(ttf_run) + run.text.size();
+    if (run.surface != nullptr)
     {
-        hash = ror32(hash, 3) ^ (c * 13);
+        memory += static_cast<size_t>(run.surface->pitch) * run.surface->h;
     }
-    return hash;
+    return memory;
 }
 
-static void ttf_surface_cache_dispose(ttf_cache_entry* entry)
+static void ttf_run_cache_remove(std::list<ttf_run>::iterator it)
 {
-    if (entry->surface != nullptr)
+    _ttfRunsMemory -= ttf_run_get_memory(*it);
+    _ttfRunsByKey.erase(ttf_run_key(it->font, it->text));
+    if (it->surface != nullptr)
     {
-        ttf_free_surface(entry->surface);
-        free(entry->text);
+        ttf_free_surface(it->surface);
+    }
+    _ttfRuns.erase(it);
+}
 
-        entry->surface = nullptr;
-        entry->font = nullptr;
-        entry->text = nullptr;
+static void ttf_run_cache_dispose_all()
+{
+    for (auto& run : _ttfRuns)
+    {
+        if (run.surface != nullptr)
+        {
+            ttf_free_surface(run.surface);
+        }
     }
+    _ttfRuns.clear();
+    _ttfRunsByKey.clear();
+    _ttfRunsMemory = 0;
 }
 
-static void ttf_surface_cache_dispose_all()
+static void ttf_run_cache_trim()
 {
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
+    while (!_ttfRuns.empty() && (_ttfRuns.size() > TTF_RUN_CACHE_MAX_RUNS || _ttfRunsMemory > TTF_RUN_CACHE_MAX_MEMORY))
     {
-        ttf_surface_cache_dispose(&_ttfSurfaceCache[i]);
-        _ttfSurfaceCacheCount--;
+        // The surfaces used in this draw may still be drawn from by the callers that looked them up
+        auto last = std::prev(_ttfRuns.end());
+        if (last->lastUseTick == gCurrentDrawCount)
+            break;
+
+        ttf_run_cache_remove(last);
+    }
+}
+
+static ttf_run& ttf_run_cache_get_or_add(TTF_Font* font, std::string_view text)
+{
+    auto it = _ttfRunsByKey.find(ttf_run_key(font, text));
+    if (it != _ttfRunsByKey.end())
+    {
+        _ttfRuns.splice(_ttfRuns.begin(), _ttfRuns, it->second);
+        it->second->lastUseTick = gCurrentDrawCount;
+        return *it->second;
     }
+
+    auto& run = _ttfRuns.emplace_front();
+    run.font = font;
+    run.text = text;
+    run.width = 0;
+    run.hasWidth = false;
+    run.surface = nullptr;
+    run.lastUseTick = gCurrentDrawCount;
+    _ttfRunsByKey.emplace(ttf_run_key(font, run.text), _ttfRuns.begin());
+    _ttfRunsMemory += ttf_run_get_memory(run);
+    return run;
 }
 
 void ttf_toggle_hinting()
@@ -221,129 +265,53 @@ void ttf_toggle_hinting()
 
 TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text)
 {
-    ttf_cache_entry* entry;
-
-    uint32_t hash = ttf_surface_cache_hash(font, text);
-    int32_t index = hash % TTF_SURFACE_CACHE_SIZE;
-
     FontLockHelper<std::mutex> lock(_mutex);
 
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
+    auto& run = ttf_run_cache_get_or_add(font, text);
+    if (run.surface != nullptr)
     {
-        entry = &_ttfSurfaceCache[index];
-
-        // Check if entry is a hit
-        if (entry->surface == nullptr)
-            break;
-        if (entry->font == font && String::Equals(entry->text, text))
-        {
-            _ttfSurfaceCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->surface;
-        }
-
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64)
-        {
-            break;
-        }
-
-        // Check if next entry is a hit
-        if (++index >= TTF_SURFACE_CACHE_SIZE)
-            index = 0;
+        _ttfRunCacheHitCount++;
+        return run.surface;
     }
 
-    // Cache miss, replace entry with new surface
-    entry = &_ttfSurfaceCache[index];
-    ttf_surface_cache_dispose(entry);
-
     TTFSurface* surface = ttf_render(font, text);
     if (surface == nullptr)
     {
         return nullptr;
     }
 
-    _ttfSurfaceCacheMissCount++;
-    // printf("CACHE HITS: %d   MISSES: %d)\n", _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount);
+    _ttfRunCacheMissCount++;
 
-    _ttfSurfaceCacheCount++;
-    entry->surface = surface;
-    entry->font = font;
-    entry->text = strndup(text.data(), text.size());
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->surface;
-}
-
-static void ttf_getwidth_cache_dispose(ttf_getwidth_cache_entry* entry)
-{
-    if (entry->text != nullptr)
-    {
-        free(entry->text);
-
-        entry->width = 0;
-        entry->font = nullptr;
-        entry->text = nullptr;
-    }
-}
-
-static void ttf_getwidth_cache_dispose_all()
-{
-    for (int32_t i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++)
-    {
-        ttf_getwidth_cache_dispose(&_ttfGetWidthCache[i]);
-        _ttfGetWidthCacheCount--;
-    }
+    // The surface is as wide as the text, so the width comes with it
+    _ttfRunsMemory -= ttf_run_get_memory(run);
+    run.surface = surface;
+    run.width = surface->w;
+    run.hasWidth = true;
+    _ttfRunsMemory += ttf_run_get_memory(run);
+    ttf_run_cache_trim();
+    return surface;
 }
 
 uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, std::string_view text)
 {
-    ttf_getwidth_cache_entry* entry;
-
-    uint32_t hash = ttf_surface_cache_hash(font, text);
-    int32_t index = hash % TTF_GETWIDTH_CACHE_SIZE;
-
     FontLockHelper<std::mutex> lock(_mutex);
 
-    for (int32_t i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++)
+    auto& run = ttf_run_cache_get_or_add(font, text);
+    if (run.hasWidth)
     {
-        entry = &_ttfGetWidthCache[index];
-
-        // Check if entry is a hit
-        if (entry->text == nullptr)
-            break;
-        if (entry->font == font && String::Equals(entry->text, text))
-        {
-            _ttfGetWidthCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->width;
-        }
-
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64)
-        {
-            break;
-        }
-
-        // Check if next entry is a hit
-        if (++index >= TTF_GETWIDTH_CACHE_SIZE)
-            index = 0;
+        _ttfRunCacheHitCount++;
+        return run.width;
     }
 
-    // Cache miss, replace entry with new width
-    entry = &_ttfGetWidthCache[index];
-    ttf_getwidth_cache_dispose(entry);
-
     int32_t width, height;
     ttf_get_size(font, text, &width, &height);
 
-    _ttfGetWidthCacheMissCount++;
+    _ttfRunCacheMissCount++;
 
-    _ttfGetWidthCacheCount++;
-    entry->width = width;
-    entry->font = font;
-    entry->text = strndup(text.data(), text.size());
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->width;
+    run.width = width;
+    run.hasWidth = true;
+    ttf_run_cache_trim();
+    return run.width;
 }
 
 TTFFontDescriptor* ttf_get_font_from_sprite_base(FontSpriteBase spriteBase)
@@ -384,10 +352,20 @@ void ttf_free_surface(TTFSurface* surface)
     free(surface);
 }
 
+TTFCacheStats ttf_get_cache_stats()
+{
+    return { _ttfRunCacheHitCount.load(), _ttfRunCacheMissCount.load() };
+}
+
 #else
 
 #    include "TTF.h"
 
+TTFCacheStats ttf_get_cache_stats()
+{
+    return {};
+}
+
 bool ttf_initialise()
 {
     return false;
@@ -13,9 +13,20 @@
 
 #include <string_view>
 
+struct TTFCacheStats
+{
+    uint64_t Hits{};
+    uint64_t Misses{};
+};
+
 bool ttf_initialise();
 void ttf_dispose();
 
+/**
+ * Returns how often the width or surface of a run of text has been found in the cache since the game started.
+ */
+TTFCacheStats ttf_get_cache_stats();
+
 #ifndef NO_TTF
 
 struct TTFSurface
@@ -32,16 +32,196 @@ using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
 using namespace OpenRCT2::Ui;
 
-X8WeatherDrawer::X8WeatherDrawer()
+void DirtyGrid::Configure(uint32_t width, uint32_t height)
 {
-    _weatherPixels = new WeatherPixel[_weatherPixelsCapacity];
+    // Blocks are as wide as a paint session column, so a small invalidation such as a moving entity only repaints the
+    // columns it touches. Adjacent dirty blocks are drawn together by CoalesceDirtyRects.
+    Width = width;
+    Height = height;
+    BlockShiftX = 5;
+    BlockShiftY = 6;
+    BlockWidth = 1 << BlockShiftX;
+    BlockHeight = 1 << BlockShiftY;
+    BlockColumns = (width >> BlockShiftX) + 1;
+    BlockRows = (height >> BlockShiftY) + 1;
+
+    // Nothing has been drawn at the new size yet.
+    delete[] Blocks;
+    Blocks = new uint8_t[BlockColumns * BlockRows];
+    std::fill_n(Blocks, BlockColumns * BlockRows, 0xFF);
+}
+
+void DirtyGrid::Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    left = std::max(left, 0);
+    top = std::max(top, 0);
+    right = std::min(right, static_cast<int32_t>(Width));
+    bottom = std::min(bottom, static_cast<int32_t>(Height));
+
+    if (left >= right)
+        return;
+    if (top >= bottom)
+        return;
+
+    right--;
+    bottom--;
+
+    left >>= BlockShiftX;
+    right >>= BlockShiftX;
+    top >>= BlockShiftY;
+    bottom >>= BlockShiftY;
+
+    for (int16_t y = top; y <= bottom; y++)
+    {
+        uint32_t yOffset = y * BlockColumns;
+        for (int16_t x = left; x <= right; x++)
+        {
+            Blocks[yOffset + x] = 0xFF;
+        }
+    }
+}
+
+void DirtyGrid::CollectDirtyRects(std::vector<DirtyRect>& rects)
+{
+    rects.clear();
+    for (uint32_t x = 0; x < BlockColumns; x++)
+    {
+        for (uint32_t y = 0; y < BlockRows; y++)
+        {
+            uint32_t yOffset = y * BlockColumns;
+            if (Blocks[yOffset + x] == 0)
+            {
+                continue;
+            }
+
+            // Determine columns
+            uint32_t xx;
+            for (xx = x; xx < BlockColumns; xx++)
+            {
+                if (Blocks[yOffset + xx] == 0)
+                {
+                    break;
+                }
+            }
+
+            // Check rows
+            uint32_t columns = xx - x;
+            auto rows = GetNumDirtyRows(x, y, columns);
+
+            // Unset dirty blocks
+            for (uint32_t top = y; top < y + rows; top++)
+            {
+                uint32_t topOffset = top * BlockColumns;
+                for (uint32_t left = x; left < x + columns; left++)
+                {
+                    Blocks[topOffset + left] = 0;
+                }
+            }
+
+            rects.push_back({ x, y, columns, rows });
+        }
+    }
+
+    CoalesceDirtyRects(rects);
 }
 
-X8WeatherDrawer::~X8WeatherDrawer()
+uint32_t DirtyGrid::GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns) const
 {
-    delete[] _weatherPixels;
+    uint32_t yy = y;
+
+    for (yy = y; yy < BlockRows; yy++)
+    {
+        uint32_t yyOffset = yy * BlockColumns;
+        for (uint32_t xx = x; xx < x + columns; xx++)
+        {
+            if (Blocks[yyOffset + xx] == 0)
+            {
+                return yy - y;
+            }
+        }
+    }
+    return yy - y;
+}
+
+/**
+ * Merges dirty rectangles that are close to each other, so that they are drawn with a single paint of each viewport
+ * instead of one per rectangle. Two rectangles are merged when the rectangle covering both contains at most
+ * DirtyRectMergeSlack blocks that are not dirty and does not partially overlap any other rectangle.
+ */
+void DirtyGrid::CoalesceDirtyRects(std::vector<DirtyRect>& rects)
+{
+    // The width of the old 128 pixel blocks in columns, merging never repaints more than those used to.
+    constexpr uint32_t DirtyRectMergeSlack = 4;
+
+    const auto getArea = [](const DirtyRect& rect) { return rect.Columns * rect.Rows; };
+    const auto getUnion = [](const DirtyRect& a, const DirtyRect& b) {
+        const auto left = std::min(a.X, b.X);
+        const auto top = std::min(a.Y, b.Y);
+        const auto right = std::max(a.X + a.Columns, b.X + b.Columns);
+        const auto bottom = std::max(a.Y + a.Rows, b.Y + b.Rows);
+        return DirtyRect{ left, top, right - left, bottom - top };
+    };
+    const auto intersects = [](const DirtyRect& a, const DirtyRect& b) {
+        return a.X < b.X + b.Columns && b.X < a.X + a.Columns && a.Y < b.Y + b.Rows && b.Y < a.Y + a.Rows;
+    };
+    const auto contains = [](const DirtyRect& a, const DirtyRect& b) {
+        return b.X >= a.X && b.Y >= a.Y && b.X + b.Columns <= a.X + a.Columns && b.Y + b.Rows <= a.Y + a.Rows;
+    };
+
+    // Merged rectangles are marked as empty and removed at the end of each pass.
+    bool merged;
+    do
+    {
+        merged = false;
+        for (size_t i = 0; i < rects.size(); i++)
+        {
+            if (rects[i].Columns == 0)
+                continue;
+
+            for (size_t j = i + 1; j < rects.size(); j++)
+            {
+                if (rects[j].Columns == 0)
+                    continue;
+
+                const auto combined = getUnion(rects[i], rects[j]);
+                if (getArea(combined) > getArea(rects[i]) + getArea(rects[j]) + DirtyRectMergeSlack)
+                    continue;
+
+                // Other rectangles inside the combined one are absorbed, so count them as dirty.
+                uint32_t dirtyArea = 0;
+                bool overlapsOther = false;
+                for (const auto& rect : rects)
+                {
+                    if (rect.Columns == 0)
+                        continue;
+                    if (contains(combined, rect))
+                        dirtyArea += getArea(rect);
+                    else if (intersects(combined, rect))
+                    {
+                        overlapsOther = true;
+                        break;
+                    }
+                }
+                if (overlapsOther || getArea(combined) > dirtyArea + DirtyRectMergeSlack)
+                    continue;
+
+                for (auto& rect : rects)
+                {
+                    if (rect.Columns != 0 && contains(combined, rect))
+                        rect.Columns = 0;
+                }
+                rects[i] = combined;
+                merged = true;
+            }
+        }
+
+        rects.erase(
+            std::remove_if(rects.begin(), rects.end(), [](const DirtyRect& rect) { return rect.Columns == 0; }),
+            rects.end());
+    } while (merged);
 }
 
+
 void X8WeatherDrawer::SetDPI(rct_drawpixelinfo* dpi)
 {
     _screenDPI = dpi;
@@ -57,62 +237,62 @@ void X8WeatherDrawer::Draw(
     uint8_t patternStartXOffset = xStart % patternXSpace;
     uint8_t patternStartYOffset = yStart % patternYSpace;
 
-    uint32_t pixelOffset = (_screenDPI->pitch + _screenDPI->width) * y + x;
+    const uint32_t stride = _screenDPI->pitch + _screenDPI->width;
+    uint32_t pixelOffset = stride * y + x;
     uint8_t patternYPos = patternStartYOffset % patternYSpace;
 
     uint8_t* screenBits = _screenDPI->bits;
-
-    // Stores the colours of changed pixels
-    WeatherPixel* newPixels = &_weatherPixels[_weatherPixelsCount];
     for (; height != 0; height--)
     {
         auto patternX = pattern[patternYPos * 2];
         if (patternX != 0xFF)
         {
-            if (_weatherPixelsCount < (_weatherPixelsCapacity - static_cast<uint32_t>(width)))
-            {
-                uint32_t finalPixelOffset = width + pixelOffset;
+            uint32_t finalPixelOffset = width + pixelOffset;
 
-                uint32_t xPixelOffset = pixelOffset;
-                xPixelOffset += (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
+            uint32_t xPixelOffset = pixelOffset;
+            xPixelOffset += (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
+            if (xPixelOffset < finalPixelOffset)
+            {
+                // Make room for the whole row up front, so the loop only has to draw and remember the pixels.
+                const size_t numRowPixels = (finalPixelOffset - xPixelOffset + patternXSpace - 1) / patternXSpace;
+                const size_t first = _weatherPixels.size();
+                _weatherPixels.resize(first + numRowPixels);
+                WeatherPixel* newPixels = &_weatherPixels[first];
 
                 auto patternPixel = pattern[patternYPos * 2 + 1];
                 for (; xPixelOffset < finalPixelOffset; xPixelOffset += patternXSpace)
                 {
-                    uint8_t current_pixel = screenBits[xPixelOffset];
-                    screenBits[xPixelOffset] = patternPixel;
-                    _weatherPixelsCount++;
-
                     // Store colour and position
-                    *newPixels++ = { xPixelOffset, current_pixel };
+                    *newPixels++ = { xPixelOffset, screenBits[xPixelOffset] };
+                    screenBits[xPixelOffset] = patternPixel;
                 }
             }
         }
 
-        pixelOffset += _screenDPI->pitch + _screenDPI->width;
+        pixelOffset += stride;
         patternYPos++;
-        patternYPos %= patternYSpace;
+        if (patternYPos == patternYSpace)
+        {
+            patternYPos = 0;
+        }
     }
 }
 
 void X8WeatherDrawer::Restore()
 {
-    if (_weatherPixelsCount > 0)
+    if (!_weatherPixels.empty())
     {
         uint32_t numPixels = (_screenDPI->width + _screenDPI->pitch) * _screenDPI->height;
         uint8_t* bits = _screenDPI->bits;
-        for (uint32_t i = 0; i < _weatherPixelsCount; i++)
+        // In reverse, where layers of rain or snow overlap the pixel gets the colour from before the first layer.
+        for (auto it = _weatherPixels.rbegin(); it != _weatherPixels.rend(); it++)
         {
-            WeatherPixel weatherPixel = _weatherPixels[i];
-            if (weatherPixel.Position >= numPixels)
+            if (it->Position < numPixels)
             {
-                // Pixel out of bounds, bail
-                break;
+                bits[it->Position] = it->Colour;
             }
-
-            bits[weatherPixel.Position] = weatherPixel.Colour;
         }
-        _weatherPixelsCount = 0;
+        _weatherPixels.clear();
     }
 }
 
@@ -123,7 +303,6 @@ void X8WeatherDrawer::Restore()
 
 X8DrawingEngine::X8DrawingEngine([[maybe_unused]] const std::shared_ptr<Ui::IUiContext>& uiContext)
 {
-    _drawingContext = new X8DrawingContext(this);
     _bitsDPI.DrawingEngine = this;
 #ifdef __ENABLE_LIGHTFX__
     lightfx_set_available(true);
@@ -133,7 +312,6 @@ X8DrawingEngine::X8DrawingEngine([[maybe_unused]] const std::shared_ptr<Ui::IUiC
 
 X8DrawingEngine::~X8DrawingEngine()
 {
-    delete _drawingContext;
     delete[] _dirtyGrid.Blocks;
     delete[] _bits;
 }
@@ -159,34 +337,7 @@ void X8DrawingEngine::SetVSync([[maybe_unused]] bool vsync)
 
 void X8DrawingEngine::Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom)
 {
-    left = std::max(left, 0);
-    top = std::max(top, 0);
-    right = std::min(right, static_cast<int32_t>(_width));
-    bottom = std::min(bottom, static_cast<int32_t>(_height));
-
-    if (left >= right)
-        return;
-    if (top >= bottom)
-        return;
-
-    right--;
-    bottom--;
-
-    left >>= _dirtyGrid.BlockShiftX;
-    right >>= _dirtyGrid.BlockShiftX;
-    top >>= _dirtyGrid.BlockShiftY;
-    bottom >>= _dirtyGrid.BlockShiftY;
-
-    uint32_t dirtyBlockColumns = _dirtyGrid.BlockColumns;
-    uint8_t* screenDirtyBlocks = _dirtyGrid.Blocks;
-    for (int16_t y = top; y <= bottom; y++)
-    {
-        uint32_t yOffset = y * dirtyBlockColumns;
-        for (int16_t x = left; x <= right; x++)
-        {
-            screenDirtyBlocks[yOffset + x] = 0xFF;
-        }
-    }
+    _dirtyGrid.Invalidate(left, top, right, bottom);
 }
 
 void X8DrawingEngine::BeginDraw()
@@ -272,8 +423,11 @@ std::string X8DrawingEngine::Screenshot()
 
 IDrawingContext* X8DrawingEngine::GetDrawingContext(rct_drawpixelinfo* dpi)
 {
-    _drawingContext->SetDPI(dpi);
-    return _drawingContext;
+    // Viewport columns can be drawn on several threads at once, so each thread draws with a context of its own
+    thread_local X8DrawingContext drawingContext(this);
+    drawingContext.SetEngine(this);
+    drawingContext.SetDPI(dpi);
+    return &drawingContext;
 }
 
 rct_drawpixelinfo* X8DrawingEngine::GetDrawingPixelInfo()
@@ -283,7 +437,7 @@ rct_drawpixelinfo* X8DrawingEngine::GetDrawingPixelInfo()
 
 DRAWING_ENGINE_FLAGS X8DrawingEngine::GetFlags()
 {
-    return DEF_DIRTY_OPTIMISATIONS;
+    return static_cast<DRAWING_ENGINE_FLAGS>(DEF_DIRTY_OPTIMISATIONS | DEF_PARALLEL_DRAWING | DEF_DRAWS_TO_BITS);
 }
 
 void X8DrawingEngine::InvalidateImage([[maybe_unused]] uint32_t image)
@@ -345,7 +499,7 @@ void X8DrawingEngine::ConfigureBits(uint32_t width, uint32_t height, uint32_t pi
     dpi->height = height;
     dpi->pitch = _pitch - width;
 
-    ConfigureDirtyGrid();
+    _dirtyGrid.Configure(_width, _height);
 
 #ifdef __ENABLE_LIGHTFX__
     if (lightfx_is_available())
@@ -360,82 +514,19 @@ void X8DrawingEngine::OnDrawDirtyBlock(
 {
 }
 
-void X8DrawingEngine::ConfigureDirtyGrid()
-{
-    _dirtyGrid.BlockShiftX = 7;
-    _dirtyGrid.BlockShiftY = 6;
-    _dirtyGrid.BlockWidth = 1 << _dirtyGrid.BlockShiftX;
-    _dirtyGrid.BlockHeight = 1 << _dirtyGrid.BlockShiftY;
-    _dirtyGrid.BlockColumns = (_width >> _dirtyGrid.BlockShiftX) + 1;
-    _dirtyGrid.BlockRows = (_height >> _dirtyGrid.BlockShiftY) + 1;
-
-    delete[] _dirtyGrid.Blocks;
-    _dirtyGrid.Blocks = new uint8_t[_dirtyGrid.BlockColumns * _dirtyGrid.BlockRows];
-}
-
 void X8DrawingEngine::DrawAllDirtyBlocks()
 {
-    for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
-    {
-        for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
-        {
-            uint32_t yOffset = y * _dirtyGrid.BlockColumns;
-            if (_dirtyGrid.Blocks[yOffset + x] == 0)
-            {
-                continue;
-            }
-
-            // Determine columns
-            uint32_t xx;
-            for (xx = x; xx < _dirtyGrid.BlockColumns; xx++)
-            {
-                if (_dirtyGrid.Blocks[yOffset + xx] == 0)
-                {
-                    break;
-                }
-            }
-
-            // Check rows
-            uint32_t columns = xx - x;
-            auto rows = GetNumDirtyRows(x, y, columns);
-            DrawDirtyBlocks(x, y, columns, rows);
-        }
-    }
-}
-
-uint32_t X8DrawingEngine::GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns)
-{
-    uint32_t yy = y;
+    // Collect all dirty rectangles first so that neighbouring ones can be drawn, and therefore painted, together.
+    _dirtyGrid.CollectDirtyRects(_dirtyRects);
 
-    for (yy = y; yy < _dirtyGrid.BlockRows; yy++)
+    for (const auto& rect : _dirtyRects)
     {
-        uint32_t yyOffset = yy * _dirtyGrid.BlockColumns;
-        for (uint32_t xx = x; xx < x + columns; xx++)
-        {
-            if (_dirtyGrid.Blocks[yyOffset + xx] == 0)
-            {
-                return yy - y;
-            }
-        }
+        DrawDirtyBlocks(rect.X, rect.Y, rect.Columns, rect.Rows);
     }
-    return yy - y;
 }
 
 void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows)
 {
-    uint32_t dirtyBlockColumns = _dirtyGrid.BlockColumns;
-    uint8_t* screenDirtyBlocks = _dirtyGrid.Blocks;
-
-    // Unset dirty blocks
-    for (uint32_t top = y; top < y + rows; top++)
-    {
-        uint32_t topOffset = top * dirtyBlockColumns;
-        for (uint32_t left = x; left < x + columns; left++)
-        {
-            screenDirtyBlocks[topOffset + left] = 0;
-        }
-    }
-
     // Determine region in pixels
     uint32_t left = std::max<uint32_t>(0, x * _dirtyGrid.BlockWidth);
     uint32_t top = std::max<uint32_t>(0, y * _dirtyGrid.BlockHeight);
@@ -752,6 +843,11 @@ void X8DrawingContext::DrawGlyph(uint32_t image, int32_t x, int32_t y, const Pal
     gfx_draw_sprite_palette_set_software(_dpi, ImageId::FromUInt32(image), { x, y }, paletteMap);
 }
 
+void X8DrawingContext::SetEngine(X8DrawingEngine* engine)
+{
+    _engine = engine;
+}
+
 void X8DrawingContext::SetDPI(rct_drawpixelinfo* dpi)
 {
     _dpi = dpi;
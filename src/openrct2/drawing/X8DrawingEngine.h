@@ -13,6 +13,8 @@
 #include "IDrawingContext.h"
 #include "IDrawingEngine.h"
 
+#include <vector>
+
 namespace OpenRCT2
 {
     namespace Ui
@@ -24,8 +26,19 @@ namespace OpenRCT2
     {
         class X8DrawingContext;
 
+        // A rectangle of dirty blocks, in block units.
+        struct DirtyRect
+        {
+            uint32_t X;
+            uint32_t Y;
+            uint32_t Columns;
+            uint32_t Rows;
+        };
+
         struct DirtyGrid
         {
+            uint32_t Width;
+            uint32_t Height;
             uint32_t BlockShiftX;
             uint32_t BlockShiftY;
             uint32_t BlockWidth;
@@ -33,6 +46,19 @@ namespace OpenRCT2
             uint32_t BlockColumns;
             uint32_t BlockRows;
             uint8_t* Blocks;
+
+            void Configure(uint32_t width, uint32_t height);
+            void Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom);
+
+            /**
+             * Clears all dirty blocks, replacing the contents of the given list with them as rectangles. Neighbouring
+             * rectangles are merged.
+             */
+            void CollectDirtyRects(std::vector<DirtyRect>& rects);
+
+        private:
+            uint32_t GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns) const;
+            static void CoalesceDirtyRects(std::vector<DirtyRect>& rects);
         };
 
         class X8WeatherDrawer final : public IWeatherDrawer
@@ -44,16 +70,11 @@ namespace OpenRCT2
                 uint8_t Colour;
             };
 
-            static constexpr uint32_t MaxWeatherPixels = 0xFFFE;
-
-            size_t _weatherPixelsCapacity = MaxWeatherPixels;
-            uint32_t _weatherPixelsCount = 0;
-            WeatherPixel* _weatherPixels = nullptr;
+            // The pixels drawn over and the colours they had, the buffer is kept between frames.
+            std::vector<WeatherPixel> _weatherPixels;
             rct_drawpixelinfo* _screenDPI = nullptr;
 
         public:
-            X8WeatherDrawer();
-            ~X8WeatherDrawer();
             void SetDPI(rct_drawpixelinfo* dpi);
             void Draw(
                 int32_t x, int32_t y, int32_t width, int32_t height, int32_t xStart, int32_t yStart,
@@ -75,6 +96,7 @@ namespace OpenRCT2
             uint8_t* _bits = nullptr;
 
             DirtyGrid _dirtyGrid = {};
+            std::vector<DirtyRect> _dirtyRects;
 
             rct_drawpixelinfo _bitsDPI = {};
 
@@ -83,7 +105,6 @@ namespace OpenRCT2
 #endif
 
             X8WeatherDrawer _weatherDrawer;
-            X8DrawingContext* _drawingContext;
 
         public:
             explicit X8DrawingEngine(const std::shared_ptr<Ui::IUiContext>& uiContext);
@@ -121,10 +142,8 @@ namespace OpenRCT2
             virtual void OnDrawDirtyBlock(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
 
         private:
-            void ConfigureDirtyGrid();
             static void ResetWindowVisbilities();
             void DrawAllDirtyBlocks();
-            uint32_t GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns);
             void DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
         };
 #ifdef __WARN_SUGGEST_FINAL_TYPES__
@@ -151,6 +170,7 @@ namespace OpenRCT2
             void DrawSpriteSolid(uint32_t image, int32_t x, int32_t y, uint8_t colour) override;
             void DrawGlyph(uint32_t image, int32_t x, int32_t y, const PaletteMap& paletteMap) override;
 
+            void SetEngine(X8DrawingEngine* engine);
             void SetDPI(rct_drawpixelinfo* dpi);
         };
     } // namespace Drawing
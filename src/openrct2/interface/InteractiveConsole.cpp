@@ -11,12 +11,14 @@
 
 #include "../Context.h"
 #include "../EditorObjectSelectionSession.h"
+#include "../FrameProfiler.h"
 #include "../Game.h"
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
 #include "../ReplayManager.h"
 #include "../Version.h"
 #include "../actions/ClimateSetAction.h"
+#include "../actions/GameAction.h"
 #include "../actions/RideSetPriceAction.h"
 #include "../actions/RideSetSettingAction.h"
 #include "../actions/SetCheatAction.h"
@@ -24,10 +26,12 @@
 #include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/Guard.hpp"
+#include "../core/MemoryUsage.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../drawing/Drawing.h"
 #include "../drawing/Font.h"
+#include "../drawing/RemappedSpriteCache.h"
 #include "../interface/Chat.h"
 #include "../interface/Colour.h"
 #include "../interface/Window_internal.h"
@@ -45,6 +49,7 @@
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
 #include "../ride/Vehicle.h"
+#include "../scripting/ScriptEngine.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
 #include "../world/Climate.h"
@@ -55,6 +60,8 @@
 #include "Viewport.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cinttypes>
 #include <cmath>
 #include <cstdarg>
 #include <cstdlib>
@@ -1247,8 +1254,7 @@ static int32_t cc_remove_park_fences(InteractiveConsole& console, [[maybe_unused
 
 static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
-    const auto& tileElements = GetTileElements();
-    const auto tileElementCount = tileElements.size();
+    const auto tileElementCount = GetTileElements().size();
 
     int32_t rideCount = ride_get_count();
     int32_t spriteCount = 0;
@@ -1503,8 +1509,15 @@ static int32_t cc_replay_start(InteractiveConsole& console, const arguments_t& a
 
     std::string name = argv[0];
 
+    // If a tick is specified playback skips ahead to it.
+    uint32_t tick = 0;
+    if (argv.size() >= 2)
+    {
+        tick = atol(argv[1].c_str());
+    }
+
     auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
-    if (replayManager->StartPlayback(name))
+    if (replayManager->StartPlayback(name, tick))
     {
         OpenRCT2::ReplayRecordInfo info;
         replayManager->GetCurrentReplayInfo(info);
@@ -1717,6 +1730,169 @@ static int32_t cc_add_news_item([[maybe_unused]] InteractiveConsole& console, [[
     return 0;
 }
 
+static int32_t cc_game_action_stats(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (!argv.empty() && argv[0] == "reset")
+    {
+        GameActions::ResetStats();
+        console.WriteLine("Game action stats reset");
+        return 0;
+    }
+
+    // List the actions that have taken the longest first.
+    auto totalTime = [](const GameActions::ActionStats& stats) { return stats.TotalQueryTime + stats.TotalExecuteTime; };
+    std::vector<const GameActions::ActionStats*> sorted;
+    for (size_t i = 0; i < EnumValue(GameCommand::Count); i++)
+    {
+        const auto& stats = GameActions::GetStats(static_cast<GameCommand>(i));
+        if (stats.NumQueries != 0 || stats.NumExecutes != 0)
+        {
+            sorted.push_back(&stats);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(), [&totalTime](const GameActions::ActionStats* a, const GameActions::ActionStats* b) {
+        return totalTime(*a) > totalTime(*b);
+    });
+
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    for (const auto* stats : sorted)
+    {
+        console.WriteFormatLine(
+            "%-32s %8" PRIu64 " queries %10.1f ms total %8.3f ms max %8" PRIu64
+            " executes %10.1f ms total %8.3f ms max %10" PRIu64 " tiles",
+            stats->Name, stats->NumQueries, Milliseconds(stats->TotalQueryTime).count(),
+            Milliseconds(stats->MaxQueryTime).count(), stats->NumExecutes, Milliseconds(stats->TotalExecuteTime).count(),
+            Milliseconds(stats->MaxExecuteTime).count(), stats->TilesChanged);
+    }
+    return 0;
+}
+
+static int32_t cc_profiler(InteractiveConsole& console, const arguments_t& argv)
+{
+    auto& profiler = OpenRCT2::FrameProfiler::Get();
+    if (argv.empty())
+    {
+        console.WriteFormatLine(
+            "Profiler is %s, %zu ticks and %zu frames recorded", profiler.IsEnabled() ? "running" : "stopped",
+            profiler.GetNumTicks(), profiler.GetNumFrames());
+    }
+    else if (argv[0] == "start")
+    {
+        profiler.SetEnabled(true);
+        console.WriteLine("Profiler started");
+    }
+    else if (argv[0] == "stop")
+    {
+        profiler.SetEnabled(false);
+        console.WriteLine("Profiler stopped");
+    }
+    else if (argv[0] == "clear")
+    {
+        profiler.Clear();
+        console.WriteLine("Profiler samples cleared");
+    }
+    else if (argv[0] == "export" && argv.size() > 1)
+    {
+        try
+        {
+            profiler.WriteChromeTrace(argv[1]);
+            console.WriteFormatLine(
+                "Wrote %zu ticks and %zu frames to %s", profiler.GetNumTicks(), profiler.GetNumFrames(), argv[1].c_str());
+        }
+        catch (const std::exception& e)
+        {
+            console.WriteLineError(String::StdFormat("Unable to write trace: %s", e.what()));
+        }
+    }
+    else
+    {
+        console.WriteLineError("Usage: profiler [start|stop|clear|export <file>]");
+    }
+    return 0;
+}
+
+static int32_t cc_sprite_cache(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (!argv.empty() && argv[0] == "clear")
+    {
+        RemappedSpriteCache::ClearAll();
+        console.WriteLine("Remapped sprite cache cleared");
+        return 0;
+    }
+
+    auto stats = RemappedSpriteCache::GetTotalStats();
+    auto lookups = stats.Hits + stats.Misses;
+    console.WriteFormatLine(
+        "%zu sprites using %zu KiB, %" PRIu64 " hits, %" PRIu64 " misses (%.1f%% hit rate), %.1f ms spent remapping",
+        stats.NumEntries, stats.MemoryUsed / 1024, stats.Hits, stats.Misses,
+        lookups != 0 ? 100.0 * stats.Hits / lookups : 0.0,
+        std::chrono::duration<double, std::milli>(stats.DecodeTime).count());
+    return 0;
+}
+
+static int32_t cc_memory_usage(InteractiveConsole& console, const arguments_t& argv)
+{
+    using namespace OpenRCT2;
+
+    if (!argv.empty() && argv[0] == "reset")
+    {
+        MemoryUsage::ResetPeaks();
+        console.WriteLine("Memory usage peaks reset");
+        return 0;
+    }
+
+    size_t totalCurrent = 0;
+    for (size_t i = 0; i < static_cast<size_t>(MemoryUsage::Category::Count); i++)
+    {
+        auto category = static_cast<MemoryUsage::Category>(i);
+        auto stats = MemoryUsage::GetStats(category);
+        totalCurrent += stats.Current;
+        console.WriteFormatLine(
+            "  %-16s %10zu KiB %10zu KiB peak", MemoryUsage::GetName(category), stats.Current / 1024, stats.Peak / 1024);
+    }
+    console.WriteFormatLine("  %-16s %10zu KiB", "total", totalCurrent / 1024);
+    return 0;
+}
+
+#ifdef ENABLE_SCRIPTING
+static int32_t cc_plugin_timings(InteractiveConsole& console, const arguments_t& argv)
+{
+    using namespace OpenRCT2::Scripting;
+
+    auto& scriptEngine = OpenRCT2::GetContext()->GetScriptEngine();
+    if (!argv.empty() && argv[0] == "reset")
+    {
+        scriptEngine.ResetPluginTimings();
+        console.WriteLine("Plugin timings reset");
+        return 0;
+    }
+
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    auto writeTiming = [&console](HOOK_TYPE type, const PluginTiming& timing) {
+        if (timing.NumCalls == 0)
+            return;
+
+        auto total = Milliseconds(timing.TotalTime).count();
+        console.WriteFormatLine(
+            "  %-24s %8" PRIu64 " calls %10.1f ms total %8.3f ms average %8.3f ms max",
+            std::string(ScriptEngine::GetPluginTimingName(type)).c_str(), timing.NumCalls, total,
+            total / timing.NumCalls, Milliseconds(timing.MaxTime).count());
+    };
+
+    for (const auto& plugin : scriptEngine.GetPlugins())
+    {
+        console.WriteLine(plugin->GetMetadata().Name);
+        for (size_t i = 0; i < NUM_HOOK_TYPES; i++)
+        {
+            auto type = static_cast<HOOK_TYPE>(i);
+            writeTiming(type, plugin->GetHookTiming(type));
+        }
+        writeTiming(HOOK_TYPE::UNDEFINED, plugin->GetIntervalTiming());
+    }
+    return 0;
+}
+#endif
+
 using console_command_func = int32_t (*)(InteractiveConsole& console, const arguments_t& argv);
 struct console_command
 {
@@ -1785,6 +1961,7 @@ static constexpr const console_command console_command_table[] = {
     { "dereference", cc_dereference, "Dereferences a nullptr, for testing purposes only", "dereference" },
     { "echo", cc_echo, "Echoes the text to the console.", "echo <text>" },
     { "exit", cc_close, "Closes the console.", "exit" },
+    { "game_action_stats", cc_game_action_stats, "Shows how long each type of game action has spent in query and execute.", "game_action_stats [reset]" },
     { "get", cc_get, "Gets the value of the specified variable.", "get <variable>" },
     { "help", cc_help, "Lists commands or info about a command.", "help [command]" },
     { "hide", cc_hide, "Hides the console.", "hide" },
@@ -1793,8 +1970,13 @@ static constexpr const console_command console_command_table[] = {
                                     "This is a safer method opposed to \"open object_selection\".",
                                     "load_object <objectfilenodat>" },
     { "load_park", cc_load_park, "Load park from save directory or by absolute path", "load_park <filename>" },
+    { "memory_usage", cc_memory_usage, "Shows how much memory each subsystem is using.", "memory_usage [reset]" },
     { "object_count", cc_object_count, "Shows the number of objects of each type in the scenario.", "object_count" },
     { "open", cc_open, "Opens the window with the give name.", "open <window>." },
+#ifdef ENABLE_SCRIPTING
+    { "plugin_timings", cc_plugin_timings, "Shows how long each plugin has spent in each hook and timer.", "plugin_timings [reset]" },
+#endif
+    { "profiler", cc_profiler, "Records logic and paint timings, exportable as a Chrome trace.", "profiler [start|stop|clear|export <file>]" },
     { "quit", cc_close, "Closes the console.", "quit" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences" },
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
@@ -1804,13 +1986,14 @@ static constexpr const console_command console_command_table[] = {
     { "say", cc_say, "Say to other players.", "say <message>" },
     { "set", cc_set, "Sets the variable to the specified value.", "set <variable> <value>" },
     { "show_limits", cc_show_limits, "Shows the map data counts and limits.", "show_limits" },
+    { "sprite_cache", cc_sprite_cache, "Shows how well the remapped sprite cache of the software renderer is doing.", "sprite_cache [clear]" },
     { "staff", cc_staff, "Staff management.", "staff <subcommand>" },
     { "terminate", cc_terminate, "Calls std::terminate(), for testing purposes only.", "terminate" },
     { "variables", cc_variables, "Lists all the variables that can be used with get and sometimes set.", "variables" },
     { "windows", cc_windows, "Lists all the windows that can be opened.", "windows" },
     { "replay_startrecord", cc_replay_startrecord, "Starts recording a new replay.", "replay_startrecord <name> [max_ticks]"},
     { "replay_stoprecord", cc_replay_stoprecord, "Stops recording a new replay.", "replay_stoprecord"},
-    { "replay_start", cc_replay_start, "Starts a replay", "replay_start <name>"},
+    { "replay_start", cc_replay_start, "Starts a replay", "replay_start <name> [tick]"},
     { "replay_stop", cc_replay_stop, "Stops the replay", "replay_stop"},
     { "replay_normalise", cc_replay_normalise, "Normalises the replay to remove all gaps", "replay_normalise <input file> <output file>"},
     { "mp_desync", cc_mp_desync, "Forces a multiplayer desync", "cc_mp_desync [desync_type, 0 = Random t-shirt color on random guest, 1 = Remove random guest ]"},
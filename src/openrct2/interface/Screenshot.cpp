@@ -16,8 +16,10 @@
 #include "../OpenRCT2.h"
 #include "../actions/SetCheatAction.h"
 #include "../audio/audio.h"
+#include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/Imaging.h"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
 #include "../drawing/X8DrawingEngine.h"
 #include "../localisation/Localisation.h"
@@ -29,12 +31,15 @@
 #include "../world/Surface.h"
 #include "Viewport.h"
 
+#include <array>
 #include <cctype>
 #include <chrono>
 #include <cstdlib>
+#include <fstream>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 using namespace std::literals::string_literals;
 using namespace OpenRCT2;
@@ -55,7 +60,7 @@ static bool WriteDpiToFile(std::string_view path, const rct_drawpixelinfo* dpi,
         image.Stride = dpi->width + dpi->pitch;
         image.Palette = std::make_unique<GamePalette>(palette);
         image.Pixels = std::vector<uint8_t>(pixels8, pixels8 + pixelsLen);
-        Imaging::WriteToFile(path, image, IMAGE_FORMAT::PNG);
+        Imaging::WriteToFile(path, image, IMAGE_FORMAT::PNG, PngCompression::Fast);
         return true;
     }
     catch (const std::exception& e)
@@ -196,7 +201,7 @@ std::string screenshot_dump_png_32bpp(int32_t width, int32_t height, const void*
         image.Depth = 32;
         image.Stride = width * 4;
         image.Pixels = std::vector<uint8_t>(pixels8, pixels8 + pixelsLen);
-        Imaging::WriteToFile(path->c_str(), image, IMAGE_FORMAT::PNG_32);
+        Imaging::WriteToFile(path->c_str(), image, IMAGE_FORMAT::PNG_32, PngCompression::Fast);
         return *path;
     }
     catch (const std::exception& e)
@@ -378,9 +383,119 @@ static void RenderViewport(IDrawingEngine* drawingEngine, const rct_viewport& vi
     viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
 }
 
+/**
+ * Renders the viewport into a PNG file a strip at a time, so that only two strips of the image are ever held in memory.
+ * Each strip is painted with parallel paint sessions while the previous strip is compressed on another thread.
+ */
+static void RenderViewportToFile(const rct_viewport& viewport, std::string_view path, const GamePalette& palette)
+{
+    constexpr int32_t StripHeight = 256;
+
+    if (viewport.width <= 0 || viewport.height <= 0)
+    {
+        throw std::runtime_error("Screenshot failed, the image has no size.");
+    }
+
+    Image header;
+    header.Width = viewport.width;
+    header.Height = viewport.height;
+    header.Depth = 8;
+    header.Palette = std::make_unique<GamePalette>(palette);
+    Imaging::PngStripWriter writer(path, header);
+
+    struct Strip
+    {
+        std::vector<uint8_t> Pixels;
+        int32_t Rows{};
+    };
+    std::array<Strip, 2> strips;
+    const auto stripSize = static_cast<size_t>(viewport.width) * std::min<int32_t>(StripHeight, viewport.height);
+    for (auto& strip : strips)
+    {
+        try
+        {
+            strip.Pixels.resize(stripSize);
+        }
+        catch (const std::bad_alloc&)
+        {
+            throw std::runtime_error("Screenshot failed, unable to allocate memory for image.");
+        }
+    }
+
+    // Ensure sprites appear regardless of rotation
+    reset_all_sprite_quadrant_placements();
+    X8DrawingEngine drawingEngine(GetContext()->GetUiContext());
+
+    // The writer is only ever used by one task at a time, the next strip is not handed over before the last has finished.
+    std::optional<TaskGroup> encodeTask;
+    if (gConfigGeneral.multithreading)
+    {
+        encodeTask.emplace(GetContext()->GetTaskScheduler());
+    }
+    std::string encodeError;
+    auto encodeStrip = [&writer, &encodeError, &viewport](const Strip* strip) {
+        try
+        {
+            writer.WriteRows(strip->Pixels.data(), strip->Rows, viewport.width);
+        }
+        catch (const std::exception& e)
+        {
+            encodeError = e.what();
+        }
+    };
+
+    for (int32_t top = 0, index = 0; top < viewport.height; top += StripHeight, index ^= 1)
+    {
+        auto& strip = strips[index];
+        strip.Rows = std::min<int32_t>(StripHeight, viewport.height - top);
+        if (viewport.flags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND)
+        {
+            std::fill(strip.Pixels.begin(), strip.Pixels.end(), PALETTE_INDEX_0);
+        }
+
+        rct_drawpixelinfo dpi{};
+        dpi.bits = strip.Pixels.data();
+        dpi.x = 0;
+        dpi.y = top;
+        dpi.width = viewport.width;
+        dpi.height = strip.Rows;
+        dpi.DrawingEngine = &drawingEngine;
+        viewport_render(&dpi, &viewport, 0, top, viewport.width, top + strip.Rows);
+
+        if (encodeTask)
+        {
+            // Wait for the previous strip, its buffer is drawn to next.
+            encodeTask->Wait();
+            if (!encodeError.empty())
+            {
+                break;
+            }
+            const auto* stripPtr = &strip;
+            encodeTask->Run([&encodeStrip, stripPtr]() { encodeStrip(stripPtr); });
+        }
+        else
+        {
+            encodeStrip(&strip);
+            if (!encodeError.empty())
+            {
+                break;
+            }
+        }
+    }
+
+    if (encodeTask)
+    {
+        encodeTask->Wait();
+    }
+    if (!encodeError.empty())
+    {
+        throw std::runtime_error("Unable to write png: " + encodeError);
+    }
+    writer.Finish();
+}
+
 void screenshot_giant()
 {
-    rct_drawpixelinfo dpi{};
     try
     {
         auto path = screenshot_get_next_path();
@@ -409,10 +524,7 @@ void screenshot_giant()
             viewport.flags |= VIEWPORT_FLAG_TRANSPARENT_BACKGROUND;
         }
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(path->c_str(), &dpi, gPalette);
+        RenderViewportToFile(viewport, *path, gPalette);
 
         // Show user that screenshot saved successfully
         Formatter ft;
@@ -425,8 +537,6 @@ void screenshot_giant()
         log_error("%s", e.what());
         context_show_error(STR_SCREENSHOT_FAILED, STR_NONE, {});
     }
-
-    ReleaseDPI(dpi);
 }
 
 // TODO: Move this at some point into a more appropriate place.
@@ -597,7 +707,13 @@ static void ApplyOptions(const ScreenshotOptions* options, rct_viewport& viewpor
     }
 }
 
-int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOptions* options)
+static bool IsScreenshotArgCountValid(const char** argv, int32_t argc)
+{
+    bool giantScreenshot = (argc == 5) && _stricmp(argv[2], "giant") == 0;
+    return argc == 4 || argc == 8 || giantScreenshot;
+}
+
+static int32_t CountScreenshotArgs(const char** argv, int32_t argc)
 {
     // Don't include options in the count (they have been handled by CommandLine::ParseOptions already)
     for (int32_t i = 0; i < argc; i++)
@@ -605,137 +721,268 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
         if (argv[i][0] == '-')
         {
             // Setting argc to i works, because options can only be at the end of the command
-            argc = i;
-            break;
+            return i;
         }
     }
+    return argc;
+}
+
+static void PrintScreenshotUsage()
+{
+    std::printf("Usage: openrct2 screenshot <file> <output_image> <width> <height> [<x> <y> <zoom> <rotation>]\n");
+    std::printf("Usage: openrct2 screenshot <file> <output_image> giant <zoom> <rotation>\n");
+    std::printf("Usage: openrct2 screenshot batch <job_file>\n");
+}
 
+/**
+ * Loads a park and renders one screenshot of it, using a context that has already been initialised.
+ * @param argv The screenshot arguments, already validated by IsScreenshotArgCountValid.
+ */
+static void RenderParkScreenshot(IContext& context, const char** argv, int32_t argc, const ScreenshotOptions* options)
+{
     bool giantScreenshot = (argc == 5) && _stricmp(argv[2], "giant") == 0;
-    if (argc != 4 && argc != 8 && !giantScreenshot)
+    bool customLocation = false;
+    bool centreMapX = false;
+    bool centreMapY = false;
+
+    const char* inputPath = argv[0];
+    const char* outputPath = argv[1];
+
+    if (!context.LoadParkFromFile(inputPath))
     {
-        std::printf("Usage: openrct2 screenshot <file> <output_image> <width> <height> [<x> <y> <zoom> <rotation>]\n");
-        std::printf("Usage: openrct2 screenshot <file> <output_image> giant <zoom> <rotation>\n");
-        return -1;
+        throw std::runtime_error("Failed to load park.");
     }
 
-    int32_t exitCode = 1;
-    rct_drawpixelinfo dpi;
-    try
+    gIntroState = IntroState::None;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+    rct_viewport viewport{};
+    if (giantScreenshot)
+    {
+        auto zoom = std::atoi(argv[3]);
+        auto rotation = std::atoi(argv[4]) & 3;
+        viewport = GetGiantViewport(gMapSize, rotation, zoom);
+        gCurrentRotation = rotation;
+    }
+    else
     {
-        core_init();
-        bool customLocation = false;
-        bool centreMapX = false;
-        bool centreMapY = false;
+        int32_t resolutionWidth = std::atoi(argv[2]);
+        int32_t resolutionHeight = std::atoi(argv[3]);
+        int32_t customX = 0;
+        int32_t customY = 0;
+        int32_t customZoom = 0;
+        int32_t customRotation = 0;
+        if (argc == 8)
+        {
+            customLocation = true;
+            if (argv[4][0] == 'c')
+                centreMapX = true;
+            else
+                customX = std::atoi(argv[4]);
 
-        const char* inputPath = argv[0];
-        const char* outputPath = argv[1];
+            if (argv[5][0] == 'c')
+                centreMapY = true;
+            else
+                customY = std::atoi(argv[5]);
 
-        gOpenRCT2Headless = true;
-        auto context = CreateContext();
-        if (!context->Initialise())
-        {
-            throw std::runtime_error("Failed to initialize context.");
+            customZoom = std::atoi(argv[6]);
+            customRotation = std::atoi(argv[7]) & 3;
         }
 
-        drawing_engine_init();
-
-        if (!context->LoadParkFromFile(inputPath))
+        int32_t mapSize = gMapSize;
+        if (resolutionWidth == 0 || resolutionHeight == 0)
         {
-            throw std::runtime_error("Failed to load park.");
-        }
+            resolutionWidth = (mapSize * 32 * 2) >> customZoom;
+            resolutionHeight = (mapSize * 32 * 1) >> customZoom;
 
-        gIntroState = IntroState::None;
-        gScreenFlags = SCREEN_FLAGS_PLAYING;
+            resolutionWidth += 8;
+            resolutionHeight += 128;
+        }
 
-        rct_viewport viewport{};
-        if (giantScreenshot)
+        viewport.width = resolutionWidth;
+        viewport.height = resolutionHeight;
+        viewport.view_width = viewport.width;
+        viewport.view_height = viewport.height;
+        if (customLocation)
         {
-            auto zoom = std::atoi(argv[3]);
-            auto rotation = std::atoi(argv[4]) & 3;
-            viewport = GetGiantViewport(gMapSize, rotation, zoom);
-            gCurrentRotation = rotation;
+            if (centreMapX)
+                customX = (mapSize / 2) * 32 + 16;
+            if (centreMapY)
+                customY = (mapSize / 2) * 32 + 16;
+
+            int32_t z = tile_element_height({ customX, customY });
+            CoordsXYZ coords3d = { customX, customY, z };
+
+            auto coords2d = translate_3d_to_2d_with_z(customRotation, coords3d);
+
+            viewport.viewPos = { coords2d.x - ((viewport.view_width << customZoom) / 2),
+                                 coords2d.y - ((viewport.view_height << customZoom) / 2) };
+            viewport.zoom = customZoom;
+            gCurrentRotation = customRotation;
         }
         else
         {
-            int32_t resolutionWidth = std::atoi(argv[2]);
-            int32_t resolutionHeight = std::atoi(argv[3]);
-            int32_t customX = 0;
-            int32_t customY = 0;
-            int32_t customZoom = 0;
-            int32_t customRotation = 0;
-            if (argc == 8)
-            {
-                customLocation = true;
-                if (argv[4][0] == 'c')
-                    centreMapX = true;
-                else
-                    customX = std::atoi(argv[4]);
-
-                if (argv[5][0] == 'c')
-                    centreMapY = true;
-                else
-                    customY = std::atoi(argv[5]);
-
-                customZoom = std::atoi(argv[6]);
-                customRotation = std::atoi(argv[7]) & 3;
-            }
+            viewport.viewPos = { gSavedView - ScreenCoordsXY{ (viewport.view_width / 2), (viewport.view_height / 2) } };
+            viewport.zoom = gSavedViewZoom;
+            gCurrentRotation = gSavedViewRotation;
+        }
+    }
 
-            int32_t mapSize = gMapSize;
-            if (resolutionWidth == 0 || resolutionHeight == 0)
-            {
-                resolutionWidth = (mapSize * 32 * 2) >> customZoom;
-                resolutionHeight = (mapSize * 32 * 1) >> customZoom;
+    ApplyOptions(options, viewport);
 
-                resolutionWidth += 8;
-                resolutionHeight += 128;
-            }
+    RenderViewportToFile(viewport, outputPath, gPalette);
+}
 
-            viewport.width = resolutionWidth;
-            viewport.height = resolutionHeight;
-            viewport.view_width = viewport.width;
-            viewport.view_height = viewport.height;
-            if (customLocation)
-            {
-                if (centreMapX)
-                    customX = (mapSize / 2) * 32 + 16;
-                if (centreMapY)
-                    customY = (mapSize / 2) * 32 + 16;
+static std::unique_ptr<IContext> CreateScreenshotContext()
+{
+    core_init();
+
+    gOpenRCT2Headless = true;
+    auto context = CreateContext();
+    if (!context->Initialise())
+    {
+        throw std::runtime_error("Failed to initialize context.");
+    }
+
+    drawing_engine_init();
+    return context;
+}
+
+int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOptions* options)
+{
+    argc = CountScreenshotArgs(argv, argc);
+    if (!IsScreenshotArgCountValid(argv, argc))
+    {
+        PrintScreenshotUsage();
+        return -1;
+    }
+
+    int32_t exitCode = 1;
+    try
+    {
+        auto context = CreateScreenshotContext();
+        RenderParkScreenshot(*context, argv, argc, options);
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        exitCode = -1;
+    }
 
-                int32_t z = tile_element_height({ customX, customY });
-                CoordsXYZ coords3d = { customX, customY, z };
+    drawing_engine_dispose();
 
-                auto coords2d = translate_3d_to_2d_with_z(customRotation, coords3d);
+    return exitCode;
+}
+
+/**
+ * Splits a line of a batch job file into arguments. Arguments are separated by whitespace and can be quoted.
+ */
+static std::vector<std::string> SplitScreenshotJob(std::string_view line)
+{
+    std::vector<std::string> args;
+    size_t i = 0;
+    while (i < line.size())
+    {
+        if (std::isspace(static_cast<unsigned char>(line[i])))
+        {
+            i++;
+            continue;
+        }
 
-                viewport.viewPos = { coords2d.x - ((viewport.view_width << customZoom) / 2),
-                                     coords2d.y - ((viewport.view_height << customZoom) / 2) };
-                viewport.zoom = customZoom;
-                gCurrentRotation = customRotation;
+        std::string arg;
+        if (line[i] == '"')
+        {
+            auto end = line.find('"', i + 1);
+            if (end == std::string_view::npos)
+            {
+                end = line.size();
             }
-            else
+            arg = line.substr(i + 1, end - i - 1);
+            i = end + 1;
+        }
+        else
+        {
+            auto end = i;
+            while (end < line.size() && !std::isspace(static_cast<unsigned char>(line[end])))
             {
-                viewport.viewPos = { gSavedView - ScreenCoordsXY{ (viewport.view_width / 2), (viewport.view_height / 2) } };
-                viewport.zoom = gSavedViewZoom;
-                gCurrentRotation = gSavedViewRotation;
+                end++;
             }
+            arg = line.substr(i, end - i);
+            i = end;
         }
+        args.push_back(std::move(arg));
+    }
+    return args;
+}
 
-        ApplyOptions(options, viewport);
-
-        dpi = CreateDPI(viewport);
+int32_t cmdline_for_screenshot_batch(const char* jobPath, ScreenshotOptions* options)
+{
+    std::ifstream jobFile(fs::u8path(jobPath));
+    if (!jobFile.is_open())
+    {
+        std::printf("Unable to open job file: %s\n", jobPath);
+        return -1;
+    }
 
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(outputPath, &dpi, gPalette);
+    // The context, and with it the object repository and graphics, is only loaded once for all jobs. Objects that
+    // consecutive parks have in common also stay loaded between them.
+    std::unique_ptr<IContext> context;
+    try
+    {
+        context = CreateScreenshotContext();
     }
     catch (const std::exception& e)
     {
         std::printf("%s\n", e.what());
-        exitCode = -1;
+        drawing_engine_dispose();
+        return -1;
+    }
+
+    int32_t numJobs = 0;
+    int32_t numFailed = 0;
+    int32_t lineNumber = 0;
+    std::string line;
+    while (std::getline(jobFile, line))
+    {
+        lineNumber++;
+
+        auto args = SplitScreenshotJob(line);
+        if (args.empty() || args[0][0] == '#')
+        {
+            continue;
+        }
+
+        numJobs++;
+        std::vector<const char*> argv;
+        for (const auto& arg : args)
+        {
+            argv.push_back(arg.c_str());
+        }
+        const auto argc = static_cast<int32_t>(argv.size());
+        if (!IsScreenshotArgCountValid(argv.data(), argc))
+        {
+            std::printf("Line %d: invalid screenshot job.\n", lineNumber);
+            numFailed++;
+            continue;
+        }
+
+        try
+        {
+            RenderParkScreenshot(*context, argv.data(), argc, options);
+            std::printf("%s -> %s\n", argv[0], argv[1]);
+        }
+        catch (const std::exception& e)
+        {
+            std::printf("Line %d: %s\n", lineNumber, e.what());
+            numFailed++;
+        }
     }
-    ReleaseDPI(dpi);
 
+    std::printf("Rendered %d of %d screenshots.\n", numJobs - numFailed, numJobs);
+    context = nullptr;
     drawing_engine_dispose();
 
-    return exitCode;
+    return numFailed == 0 ? 1 : -1;
 }
 
 static bool IsPathChildOf(fs::path x, const fs::path& parent)
@@ -820,10 +1067,14 @@ void CaptureImage(const CaptureOptions& options)
     }
 
     auto outputPath = ResolveFilenameForCapture(options.Filename);
-    auto dpi = CreateDPI(viewport);
-    RenderViewport(nullptr, viewport, dpi);
-    WriteDpiToFile(outputPath, &dpi, gPalette);
-    ReleaseDPI(dpi);
+    try
+    {
+        RenderViewportToFile(viewport, outputPath, gPalette);
+    }
+    catch (const std::exception& e)
+    {
+        log_error("%s", e.what());
+    }
 
     gCurrentRotation = backupRotation;
 }
@@ -59,6 +59,7 @@ std::string screenshot_dump_png_32bpp(int32_t width, int32_t height, const void*
 
 void screenshot_giant();
 int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOptions* options);
+int32_t cmdline_for_screenshot_batch(const char* jobPath, ScreenshotOptions* options);
 int32_t cmdline_for_gfxbench(const char** argv, int32_t argc);
 
 void CaptureImage(const CaptureOptions& options);
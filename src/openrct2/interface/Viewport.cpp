@@ -10,15 +10,19 @@
 #include "Viewport.h"
 
 #include "../Context.h"
+#include "../FrameProfiler.h"
 #include "../Game.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
-#include "../core/JobPool.h"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
 #include "../drawing/IDrawingEngine.h"
 #include "../paint/Paint.h"
+#include "../paint/PaintImpostorCache.h"
+#include "../paint/PaintTileCache.h"
+#include "../paint/VirtualFloor.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
 #include "../ride/TrackDesign.h"
@@ -33,8 +37,10 @@
 #include "Window_internal.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <list>
+#include <optional>
 #include <unordered_map>
 
 using namespace OpenRCT2;
@@ -45,11 +51,19 @@ uint8_t gShowLandRightsRefCount;
 uint8_t gShowConstuctionRightsRefCount;
 
 static std::list<rct_viewport> _viewports;
+static std::unordered_map<const rct_viewport*, std::unique_ptr<PaintTileCache>> _viewportTileCaches;
+static std::unordered_map<const rct_viewport*, std::unique_ptr<PaintImpostorCache>> _viewportImpostorCaches;
 rct_viewport* g_music_tracking_viewport;
 
-static std::unique_ptr<JobPool> _paintJobs;
 static std::vector<paint_session*> _paintColumns;
 
+struct PaintColumnTimings
+{
+    ProfilerDuration Generate;
+    ProfilerDuration Arrange;
+};
+static std::vector<PaintColumnTimings> _paintColumnTimings;
+
 ScreenCoordsXY gSavedView;
 ZoomLevel gSavedViewZoom;
 uint8_t gSavedViewRotation;
@@ -148,6 +162,8 @@ void viewport_create(
     auto itViewport = _viewports.insert(_viewports.end(), rct_viewport{});
 
     viewport = &*itViewport;
+    _viewportTileCaches[viewport] = std::make_unique<PaintTileCache>();
+    _viewportImpostorCaches[viewport] = std::make_unique<PaintImpostorCache>();
     viewport->pos = screenCoords;
     viewport->width = width;
     viewport->height = height;
@@ -203,6 +219,8 @@ void viewport_remove(rct_viewport* viewport)
         log_error("Unable to remove viewport: %p", viewport);
         return;
     }
+    _viewportTileCaches.erase(viewport);
+    _viewportImpostorCaches.erase(viewport);
     _viewports.erase(it);
 }
 
@@ -908,39 +926,63 @@ static void record_session(
 }
 
 static void viewport_fill_column(
-    paint_session* session, std::vector<RecordedPaintSession>* recorded_sessions, size_t record_index)
+    paint_session* session, std::vector<RecordedPaintSession>* recorded_sessions, size_t record_index,
+    PaintColumnTimings* timings)
 {
+    const auto generateStart = timings != nullptr ? ProfilerClock::now() : ProfilerClock::time_point();
     PaintSessionGenerate(session);
     if (recorded_sessions != nullptr)
     {
         record_session(session, recorded_sessions, record_index);
     }
+
+    const auto arrangeStart = timings != nullptr ? ProfilerClock::now() : ProfilerClock::time_point();
     PaintSessionArrange(session);
+    if (timings != nullptr)
+    {
+        timings->Generate = arrangeStart - generateStart;
+        timings->Arrange = ProfilerClock::now() - arrangeStart;
+    }
 }
 
-static void viewport_paint_column(paint_session* session)
+static void viewport_clear_background(rct_drawpixelinfo* dpi, uint32_t viewFlags)
 {
-    if (session->ViewFlags
+    if (viewFlags
             & (VIEWPORT_FLAG_HIDE_VERTICAL | VIEWPORT_FLAG_HIDE_BASE | VIEWPORT_FLAG_UNDERGROUND_INSIDE
                | VIEWPORT_FLAG_CLIP_VIEW)
-        && (~session->ViewFlags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND))
+        && (~viewFlags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND))
     {
         uint8_t colour = COLOUR_AQUAMARINE;
-        if (session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
+        if (viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
         {
             colour = COLOUR_BLACK;
         }
-        gfx_clear(&session->DPI, colour);
+        gfx_clear(dpi, colour);
     }
+}
+
+static bool viewport_has_weather_gloom(uint32_t viewFlags)
+{
+    return gConfigGeneral.render_weather_gloom && !gTrackDesignSaveMode && !(viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
+        && !(viewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES);
+}
+
+// Draws the sprites of the column, which only touches the pixels of its own part of the viewport.
+static void viewport_draw_column(paint_session* session)
+{
+    viewport_clear_background(&session->DPI, session->ViewFlags);
 
     PaintDrawStructs(session);
 
-    if (gConfigGeneral.render_weather_gloom && !gTrackDesignSaveMode && !(session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
-        && !(session->ViewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES))
+    if (viewport_has_weather_gloom(session->ViewFlags))
     {
         viewport_paint_weather_gloom(&session->DPI);
     }
+}
 
+// Draws the text of the column and frees it, which has to be done on the main thread.
+static void viewport_finish_column(paint_session* session)
+{
     if (session->PSStringHead != nullptr)
     {
         PaintDrawMoneyStructs(&session->DPI, session->PSStringHead);
@@ -949,6 +991,135 @@ static void viewport_paint_column(paint_session* session)
     PaintSessionFree(session);
 }
 
+// Paints a cell of the impostor cache, the weather gloom is left to be drawn over the whole viewport.
+static void viewport_paint_impostor_cell(paint_session* session)
+{
+    PaintSessionGenerate(session);
+    PaintSessionArrange(session);
+    viewport_clear_background(&session->DPI, session->ViewFlags);
+    PaintDrawStructs(session);
+}
+
+// Copies the painted pixels of the cell that are within the area of the viewport dpi.
+static void viewport_blit_impostor_cell(
+    rct_drawpixelinfo* dpi, const PaintImpostorCache::Cell& cell, const ScreenCoordsXY& cellPos)
+{
+    const auto zoom = dpi->zoom_level;
+    const auto left = std::max<int32_t>(dpi->x, cellPos.x);
+    const auto right = std::min<int32_t>(dpi->x + dpi->width, cellPos.x + PaintImpostorCache::CellWidth);
+    const auto top = std::max<int32_t>(dpi->y, cellPos.y);
+    const auto bottom = std::min<int32_t>(dpi->y + dpi->height, cellPos.y + PaintImpostorCache::CellHeight);
+    if (left >= right || top >= bottom)
+        return;
+
+    const int32_t srcStride = PaintImpostorCache::CellWidth / zoom;
+    const int32_t dstStride = (dpi->width / zoom) + dpi->pitch;
+    const int32_t rowLength = (right - left) / zoom;
+    const int32_t rowCount = (bottom - top) / zoom;
+    const uint8_t* src = cell.Pixels.data() + ((top - cellPos.y) / zoom) * srcStride + ((left - cellPos.x) / zoom);
+    uint8_t* dst = dpi->bits + ((top - dpi->y) / zoom) * dstStride + ((left - dpi->x) / zoom);
+    for (int32_t row = 0; row < rowCount; row++, src += srcStride, dst += dstStride)
+    {
+        for (int32_t i = 0; i < rowLength; i++)
+        {
+            if (src[i] != 0)
+                dst[i] = src[i];
+        }
+    }
+}
+
+/**
+ * Paints a viewport that is zoomed out all the way from the cells of its impostor cache, which only have to be painted
+ * again when a tile inside them changes.
+ */
+static void viewport_paint_impostors(
+    const rct_viewport* viewport, rct_drawpixelinfo* dpi, uint32_t viewFlags, PaintImpostorCache& impostorCache)
+{
+    auto& profiler = FrameProfiler::Get();
+    const bool isProfiling = profiler.IsEnabled();
+    const auto paintStart = isProfiling ? ProfilerClock::now() : ProfilerClock::time_point();
+
+    std::optional<TaskGroup> paintTasks;
+    if (gConfigGeneral.multithreading)
+    {
+        paintTasks.emplace(GetContext()->GetTaskScheduler());
+    }
+
+    const auto zoom = dpi->zoom_level;
+    const int32_t left = floor2(dpi->x, PaintImpostorCache::CellWidth);
+    const int32_t top = floor2(dpi->y, PaintImpostorCache::CellHeight);
+    const int32_t right = dpi->x + dpi->width;
+    const int32_t bottom = dpi->y + dpi->height;
+
+    _paintColumns.clear();
+    for (int32_t cellY = top; cellY < bottom; cellY += PaintImpostorCache::CellHeight)
+    {
+        for (int32_t cellX = left; cellX < right; cellX += PaintImpostorCache::CellWidth)
+        {
+            auto& cell = impostorCache.GetCell(static_cast<int16_t>(cellX), static_cast<int16_t>(cellY));
+            if (PaintImpostorCache::IsUpToDate(cell))
+                continue;
+
+            impostorCache.BeginPaintCell(cell);
+            rct_drawpixelinfo cellDpi;
+            cellDpi.DrawingEngine = dpi->DrawingEngine;
+            cellDpi.bits = cell.Pixels.data();
+            cellDpi.x = cellX;
+            cellDpi.y = cellY;
+            cellDpi.width = PaintImpostorCache::CellWidth;
+            cellDpi.height = PaintImpostorCache::CellHeight;
+            cellDpi.pitch = 0;
+            cellDpi.zoom_level = zoom;
+
+            paint_session* session = PaintSessionAlloc(&cellDpi, viewFlags);
+            session->PaintedBlocks = &cell.Blocks;
+            _paintColumns.push_back(session);
+            if (paintTasks)
+            {
+                paintTasks->Run([session]() -> void { viewport_paint_impostor_cell(session); });
+            }
+            else
+            {
+                viewport_paint_impostor_cell(session);
+            }
+        }
+    }
+
+    if (paintTasks)
+    {
+        paintTasks->Wait();
+    }
+
+    // Sessions are only given the blocks of their own cell, so the cell of each session is found by them again.
+    for (auto session : _paintColumns)
+    {
+        auto& cell = impostorCache.GetCell(static_cast<int16_t>(session->DPI.x), static_cast<int16_t>(session->DPI.y));
+        PaintImpostorCache::EndPaintCell(cell, session->PaintedAnimatedTiles);
+        PaintSessionFree(session);
+    }
+
+    const auto drawStart = isProfiling ? ProfilerClock::now() : ProfilerClock::time_point();
+    for (int32_t cellY = top; cellY < bottom; cellY += PaintImpostorCache::CellHeight)
+    {
+        for (int32_t cellX = left; cellX < right; cellX += PaintImpostorCache::CellWidth)
+        {
+            const auto& cell = impostorCache.GetCell(static_cast<int16_t>(cellX), static_cast<int16_t>(cellY));
+            viewport_blit_impostor_cell(dpi, cell, { cellX, cellY });
+        }
+    }
+
+    if (viewport_has_weather_gloom(viewFlags))
+    {
+        viewport_paint_weather_gloom(dpi);
+    }
+
+    if (isProfiling)
+    {
+        profiler.RecordViewportPaint(
+            viewport, _paintColumns.size(), drawStart - paintStart, ProfilerDuration::zero(), ProfilerClock::now() - drawStart);
+    }
+}
+
 /**
  *
  *  rct2: 0x00685CBF
@@ -1002,25 +1173,61 @@ void viewport_paint(
 
     _paintColumns.clear();
 
-    bool useMultithreading = gConfigGeneral.multithreading;
-    if (useMultithreading && _paintJobs == nullptr)
+    // The columns may be generated on other threads, which only read the height bounds
+    map_update_tile_height_bounds();
+
+    // Impostors are drawn into memory, which only works for engines that draw to the bits of the dpi. The viewport has
+    // to start on a whole pixel for them to line up with its pixels.
+    auto* impostorEngine = dpi1.DrawingEngine;
+    if (recorded_sessions == nullptr && viewport->zoom == ZoomLevel::max() && dpi1.remX == 0 && dpi1.remY == 0
+        && impostorEngine != nullptr && (impostorEngine->GetFlags() & DEF_DRAWS_TO_BITS))
     {
-        _paintJobs = std::make_unique<JobPool>();
+        auto itImpostorCache = _viewportImpostorCaches.find(viewport);
+        if (itImpostorCache != _viewportImpostorCaches.end() && itImpostorCache->second->BeginPaint(viewFlags, viewport->zoom))
+        {
+            viewport_paint_impostors(viewport, &dpi1, viewFlags, *itImpostorCache->second);
+            return;
+        }
     }
-    else if (useMultithreading == false && _paintJobs != nullptr)
+
+    // Only viewports of windows have a tile cache, not the temporary ones used for screenshots.
+    PaintTileCache* tileCache = nullptr;
+    if (recorded_sessions == nullptr)
     {
-        _paintJobs.reset();
+        auto itTileCache = _viewportTileCaches.find(viewport);
+        if (itTileCache != _viewportTileCaches.end() && itTileCache->second->BeginPaint())
+        {
+            tileCache = itTileCache->second.get();
+        }
+    }
+
+    // The columns only read the virtual floor, so it is updated before they are painted in parallel.
+    virtual_floor_update_tile_cache();
+
+    bool useMultithreading = gConfigGeneral.multithreading;
+    std::optional<TaskGroup> paintTasks;
+    if (useMultithreading)
+    {
+        paintTasks.emplace(GetContext()->GetTaskScheduler());
     }
 
     // Create space to record sessions and keep track which index is being drawn
     size_t index = 0;
+    const uint16_t columnSize = rightBorder - alignedX;
+    const uint16_t columnCount = (columnSize + 31) / 32;
     if (recorded_sessions != nullptr)
     {
-        const uint16_t columnSize = rightBorder - alignedX;
-        const uint16_t columnCount = (columnSize + 31) / 32;
         recorded_sessions->resize(columnCount);
     }
 
+    // The timings are sized up front, the columns are filled in parallel.
+    auto& profiler = FrameProfiler::Get();
+    const bool isProfiling = profiler.IsEnabled();
+    if (isProfiling)
+    {
+        _paintColumnTimings.assign(columnCount, {});
+    }
+
     // Splits the area into 32 pixel columns and renders them
     for (x = alignedX; x < rightBorder; x += 32, index++)
     {
@@ -1046,25 +1253,63 @@ void viewport_paint(
         }
         dpi2.width = paintRight - dpi2.x;
 
-        if (useMultithreading)
+        if (tileCache != nullptr)
+        {
+            session->TileCache = tileCache->GetColumn(dpi2, viewFlags);
+        }
+
+        PaintColumnTimings* timings = isProfiling ? &_paintColumnTimings[index] : nullptr;
+        if (paintTasks)
         {
-            _paintJobs->AddTask(
-                [session, recorded_sessions, index]() -> void { viewport_fill_column(session, recorded_sessions, index); });
+            paintTasks->Run([session, recorded_sessions, index, timings]() -> void {
+                viewport_fill_column(session, recorded_sessions, index, timings);
+            });
         }
         else
         {
-            viewport_fill_column(session, recorded_sessions, index);
+            viewport_fill_column(session, recorded_sessions, index, timings);
         }
     }
 
-    if (useMultithreading)
+    if (paintTasks)
     {
-        _paintJobs->Join();
+        paintTasks->Wait();
     }
 
-    for (auto column : _paintColumns)
+    const auto drawStart = isProfiling ? ProfilerClock::now() : ProfilerClock::time_point();
+    auto* drawingEngine = dpi1.DrawingEngine;
+    if (paintTasks && drawingEngine != nullptr && (drawingEngine->GetFlags() & DEF_PARALLEL_DRAWING))
     {
-        viewport_paint_column(column);
+        for (auto column : _paintColumns)
+        {
+            paintTasks->Run([column]() -> void { viewport_draw_column(column); });
+        }
+        paintTasks->Wait();
+
+        for (auto column : _paintColumns)
+        {
+            viewport_finish_column(column);
+        }
+    }
+    else
+    {
+        for (auto column : _paintColumns)
+        {
+            viewport_draw_column(column);
+            viewport_finish_column(column);
+        }
+    }
+
+    if (isProfiling)
+    {
+        auto generate = ProfilerDuration::zero();
+        auto arrange = ProfilerDuration::zero();
+        for (const auto& timings : _paintColumnTimings)
+        {
+            generate += timings.Generate;
+            arrange += timings.Arrange;
+        }
+        profiler.RecordViewportPaint(viewport, _paintColumns.size(), generate, arrange, ProfilerClock::now() - drawStart);
     }
 }
 
@@ -1698,6 +1943,45 @@ InteractionInfo get_map_coordinates_from_pos(const ScreenCoordsXY& screenCoords,
     return get_map_coordinates_from_pos_window(window, screenCoords, flags);
 }
 
+namespace
+{
+    // Tools ask what is under the cursor several times for each mouse move, mostly for the same position and filter. What
+    // is found only changes once the view moves, the map is changed, the entities have moved on to the next tick or the
+    // global paint state such as the rotation and the clip settings changes, which can happen while the game is paused.
+    struct InteractionQuery
+    {
+        const rct_viewport* Viewport{};
+        ScreenCoordsXY ViewLoc;
+        ZoomLevel Zoom;
+        uint32_t ViewFlags{};
+        int32_t Flags{};
+        uint32_t Tick{};
+        uint32_t MapVersion{};
+        uint64_t TileChangeCount{};
+        PaintTileCacheEnvironment Environment;
+        InteractionInfo Info;
+    };
+} // namespace
+
+static constexpr size_t MAX_INTERACTION_QUERIES = 4;
+static std::array<InteractionQuery, MAX_INTERACTION_QUERIES> _interactionQueries;
+static size_t _nextInteractionQuery;
+
+static InteractionQuery* get_cached_interaction_query(const InteractionQuery& query)
+{
+    for (auto& cached : _interactionQueries)
+    {
+        if (cached.Viewport == query.Viewport && cached.ViewLoc == query.ViewLoc && cached.Zoom == query.Zoom
+            && cached.ViewFlags == query.ViewFlags && cached.Flags == query.Flags && cached.Tick == query.Tick
+            && cached.MapVersion == query.MapVersion && cached.TileChangeCount == query.TileChangeCount
+            && cached.Environment == query.Environment)
+        {
+            return &cached;
+        }
+    }
+    return nullptr;
+}
+
 InteractionInfo get_map_coordinates_from_pos_window(rct_window* window, const ScreenCoordsXY& screenCoords, int32_t flags)
 {
     InteractionInfo info{};
@@ -1720,6 +2004,22 @@ InteractionInfo get_map_coordinates_from_pos_window(rct_window* window, const Sc
             viewLoc.x &= (0xFFFF * myviewport->zoom) & 0xFFFF;
             viewLoc.y &= (0xFFFF * myviewport->zoom) & 0xFFFF;
         }
+        InteractionQuery query;
+        query.Viewport = myviewport;
+        query.ViewLoc = viewLoc;
+        query.Zoom = myviewport->zoom;
+        query.ViewFlags = myviewport->flags;
+        query.Flags = flags;
+        query.Tick = gCurrentTicks;
+        query.MapVersion = map_get_version();
+        query.TileChangeCount = map_get_tile_change_count();
+        query.Environment = PaintTileCacheEnvironment::GetCurrent();
+        auto cached = get_cached_interaction_query(query);
+        if (cached != nullptr)
+        {
+            return cached->Info;
+        }
+
         rct_drawpixelinfo dpi;
         dpi.x = viewLoc.x;
         dpi.y = viewLoc.y;
@@ -1732,6 +2032,10 @@ InteractionInfo get_map_coordinates_from_pos_window(rct_window* window, const Sc
         PaintSessionArrange(session);
         info = set_interaction_info_from_paint_session(session, flags & 0xFFFF);
         PaintSessionFree(session);
+
+        query.Info = info;
+        _interactionQueries[_nextInteractionQuery] = query;
+        _nextInteractionQuery = (_nextInteractionQuery + 1) % MAX_INTERACTION_QUERIES;
     }
     return info;
 }
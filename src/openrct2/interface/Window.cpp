@@ -11,6 +11,7 @@
 
 #include "../Context.h"
 #include "../Editor.h"
+#include "../FrameProfiler.h"
 #include "../Game.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
@@ -518,6 +519,14 @@ void widget_invalidate(rct_window* w, rct_widgetindex widgetIndex)
 
     gfx_set_dirty_blocks({ { w->windowPos + ScreenCoordsXY{ widget->left, widget->top } },
                            { w->windowPos + ScreenCoordsXY{ widget->right + 1, widget->bottom + 1 } } });
+
+    auto& profiler = OpenRCT2::FrameProfiler::Get();
+    if (profiler.IsEnabled())
+    {
+        auto numPixels = static_cast<uint64_t>(std::max(widget->width() + 1, 0))
+            * static_cast<uint64_t>(std::max(widget->height() + 1, 0));
+        profiler.RecordWindowInvalidate(w->classification, numPixels);
+    }
 }
 
 template<typename _TPred> static void widget_invalidate_by_condition(_TPred pred)
@@ -1223,6 +1232,9 @@ static void window_draw_single(rct_drawpixelinfo* dpi, rct_window* w, int32_t le
             return;
     }
 
+    auto& profiler = OpenRCT2::FrameProfiler::Get();
+    auto drawStart = profiler.IsEnabled() ? OpenRCT2::ProfilerClock::now() : OpenRCT2::ProfilerClock::time_point{};
+
     // Invalidate modifies the window colours so first get the correct
     // colour before setting the global variables for the string painting
     window_event_invalidate_call(w);
@@ -1234,6 +1246,11 @@ static void window_draw_single(rct_drawpixelinfo* dpi, rct_window* w, int32_t le
     gCurrentWindowColours[3] = NOT_TRANSLUCENT(w->colours[3]);
 
     window_event_paint_call(w, dpi);
+
+    if (profiler.IsEnabled())
+    {
+        profiler.RecordWindowDraw(w->classification, OpenRCT2::ProfilerClock::now() - drawStart);
+    }
 }
 
 /**
@@ -1,5 +1,6 @@
 #include "Window_internal.h"
 
+#include "../FrameProfiler.h"
 #include "../world/Entity.h"
 #include "../world/EntityList.h"
 #include "Viewport.h"
@@ -43,6 +44,12 @@ void rct_window::ScrollToViewport()
 void rct_window::Invalidate()
 {
     gfx_set_dirty_blocks({ windowPos, windowPos + ScreenCoordsXY{ width, height } });
+
+    auto& profiler = OpenRCT2::FrameProfiler::Get();
+    if (profiler.IsEnabled())
+    {
+        profiler.RecordWindowInvalidate(classification, static_cast<uint64_t>(width) * static_cast<uint64_t>(height));
+    }
 }
 
 void rct_window::RemoveViewport()
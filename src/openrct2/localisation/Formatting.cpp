@@ -9,13 +9,16 @@
 
 #include "Formatting.h"
 
+#include "../Context.h"
 #include "../config/Config.h"
 #include "../util/Util.h"
 #include "Localisation.h"
+#include "LocalisationService.h"
 #include "StringIds.h"
 
 #include <cmath>
 #include <cstdint>
+#include <unordered_map>
 
 namespace OpenRCT2
 {
@@ -86,8 +89,23 @@ namespace OpenRCT2
         update();
     }
 
+    FmtString::iterator::iterator(const token* t, size_t count, size_t i)
+        : index(i)
+        , tokens(t)
+        , numTokens(count)
+        , isTokenised(true)
+    {
+        update();
+    }
+
     void FmtString::iterator::update()
     {
+        if (isTokenised)
+        {
+            current = index < numTokens ? tokens[index] : token();
+            return;
+        }
+
         auto i = index;
         if (i >= str.size())
         {
@@ -202,9 +220,9 @@ namespace OpenRCT2
 
     FmtString::iterator& FmtString::iterator::operator++()
     {
-        if (index < str.size())
+        if (!eol())
         {
-            index += current.text.size();
+            index += isTokenised ? 1 : current.text.size();
             update();
         }
         return *this;
@@ -213,17 +231,13 @@ namespace OpenRCT2
     FmtString::iterator FmtString::iterator::operator++(int)
     {
         auto result = *this;
-        if (index < str.size())
-        {
-            index += current.text.size();
-            update();
-        }
+        ++(*this);
         return result;
     }
 
     bool FmtString::iterator::eol() const
     {
-        return index >= str.size();
+        return index >= (isTokenised ? numTokens : str.size());
     }
 
     FmtString::FmtString(std::string&& s)
@@ -242,13 +256,27 @@ namespace OpenRCT2
     {
     }
 
+    FmtString::FmtString(std::string_view s, std::shared_ptr<const std::vector<token>> tokens)
+        : _str(s)
+        , _tokens(std::move(tokens))
+    {
+    }
+
     FmtString::iterator FmtString::begin() const
     {
+        if (_tokens != nullptr)
+        {
+            return iterator(_tokens->data(), _tokens->size(), 0);
+        }
         return iterator(_str, 0);
     }
 
     FmtString::iterator FmtString::end() const
     {
+        if (_tokens != nullptr)
+        {
+            return iterator(_tokens->data(), _tokens->size(), _tokens->size());
+        }
         return iterator(_str, _str.size());
     }
 
@@ -626,8 +654,36 @@ namespace OpenRCT2
 
     FmtString GetFmtStringById(rct_string_id id)
     {
-        auto fmtc = language_get_string(id);
-        return FmtString(fmtc);
+        struct TokenisedString
+        {
+            const char* Source{};
+            uint32_t Version{};
+            std::shared_ptr<const std::vector<FmtString::token>> Tokens;
+        };
+
+        const auto& localisationService = GetContext()->GetLocalisationService();
+        auto fmtc = localisationService.GetString(id);
+        if (fmtc == nullptr)
+        {
+            return FmtString(fmtc);
+        }
+
+        // Language strings are tokenised the first time they are formatted and reused until the strings change
+        thread_local std::unordered_map<rct_string_id, TokenisedString> tokenisedStrings;
+        auto version = localisationService.GetStringsVersion();
+        auto& entry = tokenisedStrings[id];
+        if (entry.Source != fmtc || entry.Version != version || entry.Tokens == nullptr)
+        {
+            auto tokens = std::make_shared<std::vector<FmtString::token>>();
+            for (const auto& token : FmtString(fmtc))
+            {
+                tokens->push_back(token);
+            }
+            entry.Source = fmtc;
+            entry.Version = version;
+            entry.Tokens = std::move(tokens);
+        }
+        return FmtString(fmtc, entry.Tokens);
     }
 
     FormatBuffer& GetThreadFormatStream()
@@ -663,7 +719,7 @@ namespace OpenRCT2
         }
         else if (std::holds_alternative<std::string>(value))
         {
-            FormatArgument(ss, token, std::get<std::string>(value));
+            FormatArgument(ss, token, std::string_view(std::get<std::string>(value)));
         }
         else
         {
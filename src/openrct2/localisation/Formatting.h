@@ -14,6 +14,7 @@
 #include "Language.h"
 
 #include <cstring>
+#include <memory>
 #include <sstream>
 #include <stack>
 #include <string>
@@ -171,13 +172,18 @@ namespace OpenRCT2
         {
         private:
             std::string_view str;
-            size_t index;
+            size_t index{};
             token current;
+            const token* tokens{};
+            size_t numTokens{};
+            bool isTokenised{};
 
             void update();
 
         public:
+            iterator() = default;
             iterator(std::string_view s, size_t i);
+            iterator(const token* t, size_t count, size_t i);
             bool operator==(iterator& rhs);
             bool operator!=(iterator& rhs);
             token CreateToken(size_t len);
@@ -188,16 +194,60 @@ namespace OpenRCT2
             bool eol() const;
         };
 
+    private:
+        // Tokens of _str when it has already been tokenised, e.g. language strings
+        std::shared_ptr<const std::vector<token>> _tokens;
+
+    public:
         FmtString() = default;
         FmtString(std::string&& s);
         FmtString(std::string_view s);
         FmtString(const char* s);
+        FmtString(std::string_view s, std::shared_ptr<const std::vector<token>> tokens);
         iterator begin() const;
         iterator end() const;
 
         std::string WithoutFormatTokens() const;
     };
 
+    /**
+     * The strings currently being formatted, nested string ids push a new entry. This is kept on the caller's stack
+     * so formatting a string does not allocate.
+     */
+    class FormatStack
+    {
+    private:
+        static constexpr size_t MaxDepth = 16;
+
+        FmtString::iterator _items[MaxDepth];
+        size_t _size{};
+
+    public:
+        bool empty() const
+        {
+            return _size == 0;
+        }
+
+        FmtString::iterator& top()
+        {
+            return _items[_size - 1];
+        }
+
+        void push(const FmtString::iterator& it)
+        {
+            // Language strings are never nested this deep, anything deeper is left out
+            if (_size < MaxDepth)
+            {
+                _items[_size++] = it;
+            }
+        }
+
+        void pop()
+        {
+            _size--;
+        }
+    };
+
     template<typename T> void FormatArgument(FormatBuffer& ss, FormatToken token, T arg);
 
     bool IsRealNameStringId(rct_string_id id);
@@ -206,7 +256,7 @@ namespace OpenRCT2
     FormatBuffer& GetThreadFormatStream();
     size_t CopyStringStreamToBuffer(char* buffer, size_t bufferLen, FormatBuffer& ss);
 
-    inline void FormatString(FormatBuffer& ss, std::stack<FmtString::iterator>& stack)
+    inline void FormatString(FormatBuffer& ss, FormatStack& stack)
     {
         while (!stack.empty())
         {
@@ -225,7 +275,7 @@ namespace OpenRCT2
     }
 
     template<typename TArg0, typename... TArgs>
-    static void FormatString(FormatBuffer& ss, std::stack<FmtString::iterator>& stack, TArg0 arg0, TArgs&&... argN)
+    static void FormatString(FormatBuffer& ss, FormatStack& stack, TArg0 arg0, TArgs&&... argN)
     {
         while (!stack.empty())
         {
@@ -268,7 +318,7 @@ namespace OpenRCT2
 
     template<typename... TArgs> static void FormatString(FormatBuffer& ss, const FmtString& fmt, TArgs&&... argN)
     {
-        std::stack<FmtString::iterator> stack;
+        FormatStack stack;
         stack.push(fmt.begin());
         FormatString(ss, stack, argN...);
     }
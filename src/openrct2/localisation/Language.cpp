@@ -79,6 +79,8 @@ bool language_open(int32_t id)
     auto& objectManager = context->GetObjectManager();
     try
     {
+        // Scenario names are translated while they are scanned, let that finish with the current language
+        context->GetScenarioRepository();
         localisationService.OpenLanguage(id);
         // Objects and their localised strings need to be refreshed
         objectManager.ResetObjects();
@@ -10,8 +10,11 @@
 #include "LanguagePack.h"
 
 #include "../common.h"
+#include "../core/File.h"
 #include "../core/FileStream.h"
+#include "../core/MappedFile.h"
 #include "../core/Memory.hpp"
+#include "../core/Path.hpp"
 #include "../core/RTL.h"
 #include "../core/String.hpp"
 #include "../core/StringBuilder.h"
@@ -20,7 +23,11 @@
 #include "Localisation.h"
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // Don't try to load more than language files that exceed 64 MiB
@@ -34,6 +41,27 @@ constexpr int32_t ObjectOverrideMaxStringCount = 3;
 constexpr rct_string_id ScenarioOverrideBase = 0x7000;
 constexpr int32_t ScenarioOverrideMaxStringCount = 3;
 
+constexpr uint32_t CACHE_MAGIC = 0x474E414C; // LANG
+constexpr uint16_t CACHE_VERSION = 1;
+constexpr uint32_t NO_STRING = std::numeric_limits<uint32_t>::max();
+
+/**
+ * A language cache file starts with this header, followed by the offset of each string into the string data (or
+ * NO_STRING), the null terminated string data itself, and finally the object and scenario overrides.
+ */
+struct LanguageCacheHeader
+{
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t LanguageId;
+    uint64_t SourceSize;
+    uint64_t SourceLastModified;
+    uint32_t NumStrings;
+    uint32_t StringDataLength;
+    uint32_t NumObjectOverrides;
+    uint32_t NumScenarioOverrides;
+};
+
 struct ObjectOverride
 {
     char name[8] = { 0 };
@@ -50,7 +78,11 @@ class LanguagePack final : public ILanguagePack
 {
 private:
     uint16_t const _id;
-    std::vector<std::string> _strings;
+    // Points into _stringData, _cacheFile or _changedStrings, nullptr for strings that are not set
+    std::vector<const utf8*> _strings;
+    std::vector<utf8> _stringData;
+    OpenRCT2::MappedFile _cacheFile;
+    std::unordered_map<rct_string_id, std::string> _changedStrings;
     std::vector<ObjectOverride> _objectOverrides;
     std::vector<ScenarioOverride> _scenarioOverrides;
 
@@ -60,12 +92,27 @@ private:
     std::string _currentGroup;
     ObjectOverride* _currentObjectOverride = nullptr;
     ScenarioOverride* _currentScenarioOverride = nullptr;
+    std::vector<uint32_t> _stringOffsets;
 
 public:
-    static LanguagePack* FromFile(uint16_t id, const utf8* path)
+    static LanguagePack* FromFile(uint16_t id, const utf8* path, const std::string& cachePath)
     {
         Guard::ArgumentNotNull(path);
 
+        // Use the compiled cache of the language file if it is still up to date
+        uint64_t sourceSize = 0;
+        uint64_t sourceLastModified = 0;
+        if (!cachePath.empty())
+        {
+            sourceSize = File::GetSize(path);
+            sourceLastModified = File::GetLastModified(path);
+            auto cached = FromCache(id, cachePath, sourceSize, sourceLastModified);
+            if (cached != nullptr)
+            {
+                return cached;
+            }
+        }
+
         // Load file directly into memory
         utf8* fileData = nullptr;
         try
@@ -93,6 +140,11 @@ public:
         LanguagePack* result = FromText(id, fileData);
 
         Memory::Free(fileData);
+
+        if (!cachePath.empty())
+        {
+            result->WriteCache(cachePath, sourceSize, sourceLastModified);
+        }
         return result;
     }
 
@@ -101,6 +153,11 @@ public:
         return new LanguagePack(id, text);
     }
 
+    explicit LanguagePack(uint16_t id)
+        : _id(id)
+    {
+    }
+
     LanguagePack(uint16_t id, const utf8* text)
         : _id(id)
     {
@@ -112,10 +169,18 @@ public:
             ParseLine(&reader);
         }
 
+        // All strings are in place now, so pointers to them will stay valid
+        _strings.resize(_stringOffsets.size());
+        for (size_t i = 0; i < _stringOffsets.size(); i++)
+        {
+            _strings[i] = _stringOffsets[i] == NO_STRING ? nullptr : _stringData.data() + _stringOffsets[i];
+        }
+
         // Clean up the parsing work data
         _currentGroup = std::string();
         _currentObjectOverride = nullptr;
         _currentScenarioOverride = nullptr;
+        _stringOffsets = {};
     }
 
     uint16_t GetId() const override
@@ -130,17 +195,25 @@ public:
 
     void RemoveString(rct_string_id stringId) override
     {
-        if (_strings.size() >= static_cast<size_t>(stringId))
+        if (_strings.size() > static_cast<size_t>(stringId))
         {
-            _strings[stringId] = std::string();
+            _strings[stringId] = nullptr;
+            _changedStrings.erase(stringId);
         }
     }
 
     void SetString(rct_string_id stringId, const std::string& str) override
     {
-        if (_strings.size() >= static_cast<size_t>(stringId))
+        if (_strings.size() > static_cast<size_t>(stringId))
         {
-            _strings[stringId] = str;
+            if (str.empty())
+            {
+                RemoveString(stringId);
+                return;
+            }
+            auto& changedString = _changedStrings[stringId];
+            changedString = str;
+            _strings[stringId] = changedString.c_str();
         }
     }
 
@@ -180,9 +253,9 @@ public:
         }
         else
         {
-            if ((_strings.size() > static_cast<size_t>(stringId)) && !_strings[stringId].empty())
+            if (_strings.size() > static_cast<size_t>(stringId))
             {
-                return _strings[stringId].c_str();
+                return _strings[stringId];
             }
             else
             {
@@ -235,6 +308,173 @@ public:
     }
 
 private:
+    static LanguagePack* FromCache(
+        uint16_t id, const std::string& cachePath, uint64_t sourceSize, uint64_t sourceLastModified)
+    {
+        if (!File::Exists(cachePath))
+        {
+            return nullptr;
+        }
+
+        try
+        {
+            auto result = std::make_unique<LanguagePack>(id);
+            if (result->LoadCache(OpenRCT2::MappedFile(cachePath), sourceSize, sourceLastModified))
+            {
+                return result.release();
+            }
+            log_verbose("Language cache '%s' is out of date", cachePath.c_str());
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to read language cache '%s': %s", cachePath.c_str(), e.what());
+        }
+        return nullptr;
+    }
+
+    bool LoadCache(OpenRCT2::MappedFile&& file, uint64_t sourceSize, uint64_t sourceLastModified)
+    {
+        auto data = reinterpret_cast<const utf8*>(file.GetData());
+        auto length = file.GetLength();
+
+        LanguageCacheHeader header{};
+        if (length < sizeof(header))
+        {
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (header.Magic != CACHE_MAGIC || header.Version != CACHE_VERSION || header.LanguageId != _id
+            || header.SourceSize != sourceSize || header.SourceLastModified != sourceLastModified
+            || header.NumStrings > std::numeric_limits<rct_string_id>::max())
+        {
+            return false;
+        }
+
+        size_t offsetsStart = sizeof(header);
+        size_t stringDataStart = offsetsStart + header.NumStrings * sizeof(uint32_t);
+        size_t position = stringDataStart + header.StringDataLength;
+        if (position > length || (header.StringDataLength != 0 && data[position - 1] != '\0'))
+        {
+            return false;
+        }
+
+        // The strings are used straight from the mapped file
+        _strings.resize(header.NumStrings);
+        for (size_t i = 0; i < header.NumStrings; i++)
+        {
+            uint32_t offset;
+            std::memcpy(&offset, data + offsetsStart + (i * sizeof(uint32_t)), sizeof(offset));
+            if (offset == NO_STRING)
+            {
+                _strings[i] = nullptr;
+            }
+            else if (offset < header.StringDataLength)
+            {
+                _strings[i] = data + stringDataStart + offset;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        auto readString = [&](std::string& dst) {
+            auto end = static_cast<const utf8*>(std::memchr(data + position, '\0', length - position));
+            if (end == nullptr)
+            {
+                return false;
+            }
+            dst.assign(data + position, end);
+            position = (end - data) + 1;
+            return true;
+        };
+        _objectOverrides.resize(header.NumObjectOverrides);
+        for (auto& objectOverride : _objectOverrides)
+        {
+            if (position + sizeof(objectOverride.name) > length)
+            {
+                return false;
+            }
+            std::copy_n(data + position, sizeof(objectOverride.name), objectOverride.name);
+            position += sizeof(objectOverride.name);
+            for (auto& str : objectOverride.strings)
+            {
+                if (!readString(str))
+                {
+                    return false;
+                }
+            }
+        }
+        _scenarioOverrides.resize(header.NumScenarioOverrides);
+        for (auto& scenarioOverride : _scenarioOverrides)
+        {
+            if (!readString(scenarioOverride.filename))
+            {
+                return false;
+            }
+            for (auto& str : scenarioOverride.strings)
+            {
+                if (!readString(str))
+                {
+                    return false;
+                }
+            }
+        }
+
+        _cacheFile = std::move(file);
+        return true;
+    }
+
+    void WriteCache(const std::string& cachePath, uint64_t sourceSize, uint64_t sourceLastModified) const
+    {
+        try
+        {
+            log_verbose("LanguagePack: Writing '%s'", cachePath.c_str());
+            Path::CreateDirectory(Path::GetDirectory(cachePath));
+            auto fs = OpenRCT2::FileStream(cachePath, OpenRCT2::FILE_MODE_WRITE);
+
+            LanguageCacheHeader header{};
+            header.Magic = CACHE_MAGIC;
+            header.Version = CACHE_VERSION;
+            header.LanguageId = _id;
+            header.SourceSize = sourceSize;
+            header.SourceLastModified = sourceLastModified;
+            header.NumStrings = static_cast<uint32_t>(_strings.size());
+            header.StringDataLength = static_cast<uint32_t>(_stringData.size());
+            header.NumObjectOverrides = static_cast<uint32_t>(_objectOverrides.size());
+            header.NumScenarioOverrides = static_cast<uint32_t>(_scenarioOverrides.size());
+            fs.WriteValue(header);
+
+            for (const auto* str : _strings)
+            {
+                fs.WriteValue<uint32_t>(str == nullptr ? NO_STRING : static_cast<uint32_t>(str - _stringData.data()));
+            }
+            fs.Write(_stringData.data(), _stringData.size());
+
+            for (const auto& objectOverride : _objectOverrides)
+            {
+                fs.Write(objectOverride.name, sizeof(objectOverride.name));
+                for (const auto& str : objectOverride.strings)
+                {
+                    fs.Write(str.c_str(), str.size() + 1);
+                }
+            }
+            for (const auto& scenarioOverride : _scenarioOverrides)
+            {
+                fs.Write(scenarioOverride.filename.c_str(), scenarioOverride.filename.size() + 1);
+                for (const auto& str : scenarioOverride.strings)
+                {
+                    fs.Write(str.c_str(), str.size() + 1);
+                }
+            }
+            fs.Flush();
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to write language cache '%s': %s", cachePath.c_str(), e.what());
+        }
+    }
+
     ObjectOverride* GetObjectOverride(const std::string& objectIdentifier)
     {
         for (auto& oo : _objectOverrides)
@@ -557,11 +797,20 @@ private:
         if (_currentGroup.empty())
         {
             // Make sure the list is big enough to contain this string id
-            if (static_cast<size_t>(stringId) >= _strings.size())
+            if (static_cast<size_t>(stringId) >= _stringOffsets.size())
+            {
+                _stringOffsets.resize(stringId + 1, NO_STRING);
+            }
+            if (s.empty())
+            {
+                _stringOffsets[stringId] = NO_STRING;
+            }
+            else
             {
-                _strings.resize(stringId + 1);
+                _stringOffsets[stringId] = static_cast<uint32_t>(_stringData.size());
+                _stringData.insert(_stringData.end(), s.begin(), s.end());
+                _stringData.push_back('\0');
             }
-            _strings[stringId] = s;
         }
         else
         {
@@ -579,9 +828,9 @@ private:
 
 namespace LanguagePackFactory
 {
-    ILanguagePack* FromFile(uint16_t id, const utf8* path)
+    ILanguagePack* FromFile(uint16_t id, const utf8* path, const std::string& cachePath)
     {
-        auto languagePack = LanguagePack::FromFile(id, path);
+        auto languagePack = LanguagePack::FromFile(id, path, cachePath);
         return languagePack;
     }
 
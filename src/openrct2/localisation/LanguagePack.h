@@ -30,6 +30,10 @@ struct ILanguagePack
 
 namespace LanguagePackFactory
 {
-    ILanguagePack* FromFile(uint16_t id, const utf8* path);
+    /**
+     * Loads a language file. If a cache path is given, the parsed strings are kept in a compiled cache file there
+     * which is mapped instead of parsing the language file again, until the language file changes.
+     */
+    ILanguagePack* FromFile(uint16_t id, const utf8* path, const std::string& cachePath = {});
     ILanguagePack* FromText(uint16_t id, const utf8* text);
 } // namespace LanguagePackFactory
@@ -377,6 +377,21 @@ void format_string_to_upper(utf8* dest, size_t size, rct_string_id format, const
 
     format_string(dest, size, format, args);
 
+    // Most signs and banners are plain ASCII, which can be converted in place without allocating as long as the
+    // user's locale upper cases ASCII the usual way (it does not for 'i' in Turkish, for example)
+    static const bool asciiUpperCaseIsPlain = String::ToUpper("abcdefghijklmnopqrstuvwxyz") == "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    if (asciiUpperCaseIsPlain && std::all_of(dest, dest + strlen(dest), [](char c) { return (c & 0x80) == 0; }))
+    {
+        for (auto ch = dest; *ch != '\0'; ch++)
+        {
+            if (*ch >= 'a' && *ch <= 'z')
+            {
+                *ch = *ch - 'a' + 'A';
+            }
+        }
+        return;
+    }
+
     std::string upperString = String::ToUpper(dest);
 
     if (upperString.size() + 1 >= size)
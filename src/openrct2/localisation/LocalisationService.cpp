@@ -74,6 +74,13 @@ std::string LocalisationService::GetLanguagePath(uint32_t languageId) const
     return languagePath;
 }
 
+std::string LocalisationService::GetLanguageCachePath(uint32_t languageId) const
+{
+    auto locale = std::string(LanguagesDescriptors[languageId].locale);
+    auto cacheDirectory = _env->GetDirectoryPath(DIRBASE::CACHE);
+    return Path::Combine(cacheDirectory, "language_" + locale + ".idx");
+}
+
 void LocalisationService::OpenLanguage(int32_t id)
 {
     CloseLanguages();
@@ -87,11 +94,12 @@ void LocalisationService::OpenLanguage(int32_t id)
     {
         filename = GetLanguagePath(LANGUAGE_ENGLISH_UK);
         _languageFallback = std::unique_ptr<ILanguagePack>(
-            LanguagePackFactory::FromFile(LANGUAGE_ENGLISH_UK, filename.c_str()));
+            LanguagePackFactory::FromFile(LANGUAGE_ENGLISH_UK, filename.c_str(), GetLanguageCachePath(LANGUAGE_ENGLISH_UK)));
     }
 
     filename = GetLanguagePath(id);
-    _languageCurrent = std::unique_ptr<ILanguagePack>(LanguagePackFactory::FromFile(id, filename.c_str()));
+    _languageCurrent = std::unique_ptr<ILanguagePack>(
+        LanguagePackFactory::FromFile(id, filename.c_str(), GetLanguageCachePath(id)));
     if (_languageCurrent != nullptr)
     {
         _currentLanguage = id;
@@ -105,6 +113,7 @@ void LocalisationService::OpenLanguage(int32_t id)
 
 void LocalisationService::CloseLanguages()
 {
+    _stringsVersion++;
     _languageFallback = nullptr;
     _languageCurrent = nullptr;
     _currentLanguage = LANGUAGE_UNDEFINED;
@@ -133,6 +142,7 @@ rct_string_id LocalisationService::AllocateObjectString(const std::string& targe
     auto stringId = _availableObjectStringIds.top();
     _availableObjectStringIds.pop();
     _languageCurrent->SetString(stringId, target);
+    _stringsVersion++;
     return stringId;
 }
 
@@ -145,6 +155,7 @@ void LocalisationService::FreeObjectString(rct_string_id stringId)
             _languageCurrent->RemoveString(stringId);
         }
         _availableObjectStringIds.push(stringId);
+        _stringsVersion++;
     }
 }
 
@@ -11,6 +11,7 @@
 
 #include "../common.h"
 
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -36,6 +37,7 @@ namespace OpenRCT2::Localisation
         std::unique_ptr<ILanguagePack> _languageFallback;
         std::unique_ptr<ILanguagePack> _languageCurrent;
         std::stack<rct_string_id> _availableObjectStringIds;
+        std::atomic<uint32_t> _stringsVersion{};
 
     public:
         int32_t GetCurrentLanguage() const
@@ -51,6 +53,14 @@ namespace OpenRCT2::Localisation
             _useTrueTypeFont = value;
         }
 
+        /**
+         * Changes every time a language is opened or closed, or an object string is added or removed.
+         */
+        uint32_t GetStringsVersion() const
+        {
+            return _stringsVersion;
+        }
+
         LocalisationService(const std::shared_ptr<IPlatformEnvironment>& env);
         ~LocalisationService();
 
@@ -59,6 +69,7 @@ namespace OpenRCT2::Localisation
             const std::string& scenarioFilename) const;
         rct_string_id GetObjectOverrideStringId(std::string_view legacyIdentifier, uint8_t index) const;
         std::string GetLanguagePath(uint32_t languageId) const;
+        std::string GetLanguageCachePath(uint32_t languageId) const;
 
         void OpenLanguage(int32_t id);
         void CloseLanguages();
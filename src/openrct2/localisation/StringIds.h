@@ -3951,6 +3951,9 @@ enum
 
     STR_COPY_BUILD_HASH = 6453,
 
+    STR_LOADSAVE_PARK_NAME_DATE = 6454,
+    STR_LOADSAVE_PARK_DETAILS = 6455,
+
     // Have to include resource strings (from scenarios and objects) for the time being now that language is partially working
     /* MAX_STR_COUNT = 32768 */ // MAX_STR_COUNT - upper limit for number of strings, not the current count strings
 };
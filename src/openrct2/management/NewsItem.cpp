@@ -305,11 +305,10 @@ News::Item* News::ItemQueues::FirstOpenOrNewSlot()
  */
 News::Item* News::AddItemToQueue(News::ItemType type, rct_string_id string_id, uint32_t assoc, const Formatter& formatter)
 {
-    utf8 buffer[256];
-
-    // overflows possible?
-    format_string(buffer, 256, string_id, formatter.Data());
-    return News::AddItemToQueue(type, buffer, assoc);
+    // Format straight into the item rather than through a temporary buffer
+    News::Item* newsItem = AddItemToQueue(type, "", assoc);
+    newsItem->Text = format_string(string_id, formatter.Data());
+    return newsItem;
 }
 
 News::Item* News::AddItemToQueue(News::ItemType type, const utf8* text, uint32_t assoc)
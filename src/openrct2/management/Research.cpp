@@ -32,6 +32,8 @@
 #include "NewsItem.h"
 
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <iterator>
 
 static constexpr const int32_t _researchRate[] = {
@@ -56,9 +58,9 @@ std::vector<ResearchItem> gResearchItemsInvented;
 // 0x00EE787C
 uint8_t gResearchUncompletedCategories;
 
-static bool _researchedRideTypes[RIDE_TYPE_COUNT];
-static bool _researchedRideEntries[MAX_RIDE_OBJECTS];
-static bool _researchedSceneryItems[SCENERY_TYPE_COUNT][UINT16_MAX];
+static std::bitset<RIDE_TYPE_COUNT> _researchedRideTypes;
+static std::bitset<MAX_RIDE_OBJECTS> _researchedRideEntries;
+static std::array<std::bitset<UINT16_MAX>, SCENERY_TYPE_COUNT> _researchedSceneryItems;
 
 bool gSilentResearch = false;
 
@@ -536,7 +538,7 @@ bool ride_type_is_invented(uint32_t rideType)
 
 bool ride_entry_is_invented(int32_t rideEntryIndex)
 {
-    return _researchedRideEntries[rideEntryIndex];
+    return rideEntryIndex >= 0 && rideEntryIndex < MAX_RIDE_OBJECTS ? _researchedRideEntries[rideEntryIndex] : false;
 }
 
 void ride_type_set_invented(uint32_t rideType)
@@ -549,7 +551,10 @@ void ride_type_set_invented(uint32_t rideType)
 
 void ride_entry_set_invented(int32_t rideEntryIndex)
 {
-    _researchedRideEntries[rideEntryIndex] = true;
+    if (rideEntryIndex >= 0 && rideEntryIndex < MAX_RIDE_OBJECTS)
+    {
+        _researchedRideEntries[rideEntryIndex] = true;
+    }
 }
 
 bool scenery_is_invented(const ScenerySelection& sceneryItem)
@@ -649,7 +654,7 @@ void set_all_scenery_items_invented()
 {
     for (auto sceneryType = 0; sceneryType < SCENERY_TYPE_COUNT; sceneryType++)
     {
-        std::fill(std::begin(_researchedSceneryItems[sceneryType]), std::end(_researchedSceneryItems[sceneryType]), true);
+        _researchedSceneryItems[sceneryType].set();
     }
 }
 
@@ -657,28 +662,28 @@ void set_all_scenery_items_not_invented()
 {
     for (auto sceneryType = 0; sceneryType < SCENERY_TYPE_COUNT; sceneryType++)
     {
-        std::fill(std::begin(_researchedSceneryItems[sceneryType]), std::end(_researchedSceneryItems[sceneryType]), false);
+        _researchedSceneryItems[sceneryType].reset();
     }
 }
 
 void set_every_ride_type_invented()
 {
-    std::fill(std::begin(_researchedRideTypes), std::end(_researchedRideTypes), true);
+    _researchedRideTypes.set();
 }
 
 void set_every_ride_type_not_invented()
 {
-    std::fill(std::begin(_researchedRideTypes), std::end(_researchedRideTypes), false);
+    _researchedRideTypes.reset();
 }
 
 void set_every_ride_entry_invented()
 {
-    std::fill(std::begin(_researchedRideEntries), std::end(_researchedRideEntries), true);
+    _researchedRideEntries.set();
 }
 
 void set_every_ride_entry_not_invented()
 {
-    std::fill(std::begin(_researchedRideEntries), std::end(_researchedRideEntries), false);
+    _researchedRideEntries.reset();
 }
 
 /**
@@ -31,13 +31,15 @@
 #include "network.h"
 
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <iterator>
 #include <stdexcept>
 
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "20"
+#define NETWORK_STREAM_VERSION "24"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static Peep* _pickup_peep = nullptr;
@@ -49,14 +51,26 @@ static int32_t _pickup_peep_old_x = LOCATION_NULL;
 // with uint16_t and needs some spare room for other data in the packet.
 static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 
+// How many objects are listed in each objects list packet, each takes 16 bytes so a batch stays well within CHUNK_SIZE.
+static constexpr size_t OBJECTS_LIST_BATCH_SIZE = 1024;
+
+// How many ticks a joining client may have to catch up on when it is sent a map exported earlier.
+static constexpr uint32_t MAP_SNAPSHOT_MAX_AGE = 160;
+
+// How many ticks it takes for the tick checksums to have covered every entity and every tile once.
+static constexpr uint32_t NETWORK_CHECKSUM_SLICES = 100;
+
 #    include "../Cheats.h"
 #    include "../ParkImporter.h"
 #    include "../Version.h"
 #    include "../actions/GameAction.h"
 #    include "../config/Config.h"
+#    include "../core/ChecksumStream.h"
 #    include "../core/Console.hpp"
+#    include "../core/DataSerialiser.h"
 #    include "../core/FileStream.h"
 #    include "../core/MemoryStream.h"
+#    include "../core/MemoryUsage.h"
 #    include "../core/Nullable.hpp"
 #    include "../core/Path.hpp"
 #    include "../core/String.hpp"
@@ -66,9 +80,13 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include "../localisation/Localisation.h"
 #    include "../object/ObjectManager.h"
 #    include "../object/ObjectRepository.h"
+#    include "../peep/Peep.h"
 #    include "../rct2/S6Exporter.h"
+#    include "../ride/Vehicle.h"
 #    include "../scenario/Scenario.h"
 #    include "../util/Util.h"
+#    include "../world/Litter.h"
+#    include "../world/Map.h"
 #    include "../world/Park.h"
 #    include "NetworkAction.h"
 #    include "NetworkConnection.h"
@@ -201,6 +219,7 @@ void NetworkBase::Close()
         _serverTickData.clear();
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
+        _lastMapSnapshot = {};
 
         gfx_invalidate_screen();
 
@@ -296,6 +315,7 @@ bool NetworkBase::BeginClient(const std::string& host, uint16_t port)
         {
             auto fs = FileStream(keyPath, FILE_MODE_WRITE);
             _key.SavePrivate(&fs);
+            fs.Flush();
         }
         catch (const std::exception&)
         {
@@ -312,6 +332,7 @@ bool NetworkBase::BeginClient(const std::string& host, uint16_t port)
         {
             auto fs = FileStream(keyPath, FILE_MODE_WRITE);
             _key.SavePublic(&fs);
+            fs.Flush();
         }
         catch (const std::exception&)
         {
@@ -502,13 +523,32 @@ void NetworkBase::Flush()
 
 void NetworkBase::UpdateServer()
 {
+    // Check every socket at once, rather than trying to read from each idle connection.
+    std::vector<const ITcpSocket*> sockets;
+    sockets.reserve(client_connection_list.size() + 1);
+    sockets.push_back(_listenSocket.get());
     for (auto& connection : client_connection_list)
     {
+        sockets.push_back(connection->Socket.get());
+    }
+    const auto readable = GetReadableTcpSockets(sockets);
+
+    size_t socketIndex = 1;
+    for (auto& connection : client_connection_list)
+    {
+        const bool canRead = readable[socketIndex++];
+
         // This can be called multiple times before the connection is removed.
         if (!connection->IsValid())
             continue;
 
-        if (!ProcessConnection(*connection))
+        auto& pendingAuth = connection->PendingAuth.Verified;
+        if (pendingAuth.valid() && pendingAuth.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            Server_Complete_AUTH(*connection);
+        }
+
+        if (!ProcessConnection(*connection, canRead))
         {
             connection->Disconnect();
         }
@@ -525,15 +565,25 @@ void NetworkBase::UpdateServer()
         Server_Send_PINGLIST();
     }
 
+    if (gConfigNetwork.stats_dump_interval > 0
+        && ticks > _lastStatsDumpTime + static_cast<uint32_t>(gConfigNetwork.stats_dump_interval) * 1000)
+    {
+        _lastStatsDumpTime = ticks;
+        WriteServerStats();
+    }
+
     if (_advertiser != nullptr)
     {
         _advertiser->Update();
     }
 
-    std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
-    if (tcpSocket != nullptr)
+    if (readable[0])
     {
-        AddClient(std::move(tcpSocket));
+        std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
+        if (tcpSocket != nullptr)
+        {
+            AddClient(std::move(tcpSocket));
+        }
     }
 }
 
@@ -715,6 +765,8 @@ const char* NetworkBase::FormatChat(NetworkPlayer* fromplayer, const char* text)
 
 void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd)
 {
+    // Serialise the packet once, every connection queues the same buffer.
+    const NetworkOutboundPacket outboundPacket(packet);
     for (auto& client_connection : client_connection_list)
     {
         if (gameCmd)
@@ -728,11 +780,65 @@ void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, b
                 continue;
             }
         }
-        auto packetCopy = packet;
-        client_connection->QueuePacket(std::move(packetCopy), front);
+        client_connection->QueuePacket(outboundPacket, front);
     }
 }
 
+template<typename T> static void SerialiseEntitySlice(DataSerialiser& ds, uint32_t slice)
+{
+    for (auto* ent : EntityList<T>())
+    {
+        if (ent->sprite_index % NETWORK_CHECKSUM_SLICES == slice)
+        {
+            ent->Serialise(ds);
+        }
+    }
+}
+
+template<typename... T> static void SerialiseEntitySlices(DataSerialiser& ds, uint32_t slice)
+{
+    (SerialiseEntitySlice<T>(ds, slice), ...);
+}
+
+/**
+ * The checksum sent with every tick only covers a slice of the game state, the slice depends on the tick. Every entity
+ * and every tile is part of one of the slices, so all of them are checked every NETWORK_CHECKSUM_SLICES ticks without
+ * any tick having to hash the whole park.
+ */
+static rct_sprite_checksum GetTickChecksum(uint32_t tick)
+{
+    const auto slice = tick % NETWORK_CHECKSUM_SLICES;
+
+    rct_sprite_checksum checksum{};
+    OpenRCT2::ChecksumStream ms(checksum.raw);
+    DataSerialiser ds(true, ms);
+    SerialiseEntitySlices<Guest, Staff, Vehicle, Litter>(ds, slice);
+
+    // Only the layout of the tiles is compared, some tile element bits are changed locally, e.g. to highlight track.
+    for (int32_t y = static_cast<int32_t>(slice); y < gMapSize; y += NETWORK_CHECKSUM_SLICES)
+    {
+        for (int32_t x = 0; x < gMapSize; x++)
+        {
+            const auto* tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            if (tileElement == nullptr)
+                continue;
+            do
+            {
+                // Ghosts are only placed on the client that is building.
+                if (tileElement->IsGhost())
+                    continue;
+
+                uint8_t type = tileElement->GetType();
+                uint8_t direction = tileElement->GetDirection();
+                uint8_t baseHeight = tileElement->base_height;
+                uint8_t clearanceHeight = tileElement->clearance_height;
+                ds << type << direction << baseHeight << clearanceHeight;
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+    return checksum;
+}
+
 bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
 {
     // We have to wait for the map to be loaded first, ticks may match current loaded map.
@@ -754,7 +860,7 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
 
     if (!storedTick.spriteHash.empty())
     {
-        rct_sprite_checksum checksum = sprite_checksum();
+        rct_sprite_checksum checksum = GetTickChecksum(tick);
         std::string clientSpriteHash = checksum.ToString();
         if (clientSpriteHash != storedTick.spriteHash)
         {
@@ -1181,6 +1287,132 @@ void NetworkBase::CloseServerLog()
     _server_log_fs.close();
 }
 
+static constexpr const char* NetworkCommandNames[] = {
+    "Auth",
+    "Map",
+    "Chat",
+    "",
+    "Tick",
+    "PlayerList",
+    "Ping",
+    "PingList",
+    "DisconnectMessage",
+    "GameInfo",
+    "ShowError",
+    "GroupList",
+    "Event",
+    "Token",
+    "ObjectsList",
+    "MapRequest",
+    "GameAction",
+    "PlayerInfo",
+    "RequestGameState",
+    "GameState",
+    "Scripts",
+    "Heartbeat",
+};
+static_assert(std::size(NetworkCommandNames) == EnumValue(NetworkCommand::Max));
+
+static json_t GetCommandBytesJson(const uint64_t (&commandBytes)[EnumValue(NetworkCommand::Max)])
+{
+    auto result = json_t::object();
+    for (size_t i = 0; i < std::size(NetworkCommandNames); i++)
+    {
+        if (NetworkCommandNames[i][0] != '\0')
+        {
+            result[NetworkCommandNames[i]] = commandBytes[i];
+        }
+    }
+    return result;
+}
+
+static json_t GetGameActionStatsJson()
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    auto result = json_t::object();
+    for (size_t i = 0; i < EnumValue(GameCommand::Count); i++)
+    {
+        const auto& stats = GameActions::GetStats(static_cast<GameCommand>(i));
+        if (stats.NumQueries == 0 && stats.NumExecutes == 0)
+            continue;
+
+        result[stats.Name] = {
+            { "queries", stats.NumQueries },
+            { "queryTime", Milliseconds(stats.TotalQueryTime).count() },
+            { "maxQueryTime", Milliseconds(stats.MaxQueryTime).count() },
+            { "executes", stats.NumExecutes },
+            { "executeTime", Milliseconds(stats.TotalExecuteTime).count() },
+            { "maxExecuteTime", Milliseconds(stats.MaxExecuteTime).count() },
+            { "tilesChanged", stats.TilesChanged },
+        };
+    }
+    return result;
+}
+
+static json_t GetMemoryUsageJson()
+{
+    auto result = json_t::object();
+    for (size_t i = 0; i < static_cast<size_t>(MemoryUsage::Category::Count); i++)
+    {
+        auto category = static_cast<MemoryUsage::Category>(i);
+        auto stats = MemoryUsage::GetStats(category);
+        result[MemoryUsage::GetName(category)] = {
+            { "current", stats.Current },
+            { "peak", stats.Peak },
+        };
+    }
+    return result;
+}
+
+/**
+ * Writes the traffic of every connection to network_stats.json in the server log directory, replacing the previous
+ * dump. The byte counts and the round trip time histogram are totals since the client connected. The game action
+ * timings are totals since they were last reset with the game_action_stats console command, and the memory usage of
+ * each subsystem is included as well.
+ */
+void NetworkBase::WriteServerStats()
+{
+    auto connections = json_t::array();
+    for (const auto& connection : client_connection_list)
+    {
+        const auto& stats = connection->Stats;
+        json_t jsonConnection = {
+            { "host", connection->Socket->GetHostName() },
+            { "ping", connection->Player != nullptr ? connection->Player->Ping : 0 },
+            { "queuedPackets", connection->GetQueuedPacketCount() },
+            { "bytesSent", GetCommandBytesJson(stats.commandBytesSent) },
+            { "bytesReceived", GetCommandBytesJson(stats.commandBytesReceived) },
+            { "pingHistogram", stats.pingHistogram },
+        };
+        if (connection->Player != nullptr)
+        {
+            jsonConnection["player"] = connection->Player->Name;
+            jsonConnection["playerId"] = connection->Player->Id;
+        }
+        connections.push_back(std::move(jsonConnection));
+    }
+
+    json_t jsonStats = {
+        { "tick", gCurrentTicks },
+        { "time", platform_get_ticks() },
+        { "pingHistogramBounds", NETWORK_PING_HISTOGRAM_BOUNDS },
+        { "connections", std::move(connections) },
+        { "gameActions", GetGameActionStatsJson() },
+        { "memoryUsage", GetMemoryUsageJson() },
+    };
+
+    auto directory = _env->GetDirectoryPath(DIRBASE::USER, DIRID::LOG_SERVER);
+    platform_ensure_directory_exists(directory.c_str());
+    try
+    {
+        Json::WriteToFile(Path::Combine(directory, "network_stats.json"), jsonStats);
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to write network stats: %s", e.what());
+    }
+}
+
 void NetworkBase::Client_Send_RequestGameState(uint32_t tick)
 {
     if (_serverState.gamestateSnapshotsEnabled == false)
@@ -1245,29 +1477,25 @@ void NetworkBase::Server_Send_OBJECTS_LIST(
 {
     log_verbose("Server sends objects list with %u items", objects.size());
 
-    if (objects.empty())
+    // The list is sent in batches, a packet always starts with the index of its first object, the total number of
+    // objects and the number of objects in the packet. An empty list is a single packet with no objects.
+    size_t i = 0;
+    do
     {
-        NetworkPacket packet(NetworkCommand::ObjectsList);
-        packet << static_cast<uint32_t>(0) << static_cast<uint32_t>(objects.size());
+        auto count = std::min(OBJECTS_LIST_BATCH_SIZE, objects.size() - i);
 
-        connection.QueuePacket(std::move(packet));
-    }
-    else
-    {
-        for (size_t i = 0; i < objects.size(); ++i)
+        NetworkPacket packet(NetworkCommand::ObjectsList);
+        packet << static_cast<uint32_t>(i) << static_cast<uint32_t>(objects.size()) << static_cast<uint32_t>(count);
+        for (size_t j = i; j < i + count; j++)
         {
-            const auto* object = objects[i];
-
-            NetworkPacket packet(NetworkCommand::ObjectsList);
-            packet << static_cast<uint32_t>(i) << static_cast<uint32_t>(objects.size());
-
+            const auto* object = objects[j];
             log_verbose("Object %.8s (checksum %x)", object->ObjectEntry.name, object->ObjectEntry.checksum);
             packet.Write(reinterpret_cast<const uint8_t*>(object->ObjectEntry.name), 8);
             packet << object->ObjectEntry.checksum << object->ObjectEntry.flags;
-
-            connection.QueuePacket(std::move(packet));
         }
-    }
+        connection.QueuePacket(std::move(packet));
+        i += count;
+    } while (i < objects.size());
 }
 
 void NetworkBase::Server_Send_SCRIPTS(NetworkConnection& connection) const
@@ -1371,7 +1599,19 @@ void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
         objects = objManager.GetPackableObjects();
     }
 
-    auto header = save_for_network(objects);
+    // Clients joining at about the same time get the same map. Without game actions, which change the map version, the
+    // game state only changes by ticking, which the client repeats to catch up with the server.
+    auto& snapshot = _lastMapSnapshot;
+    if (snapshot.Data.empty() || gCurrentTicks - snapshot.Tick > MAP_SNAPSHOT_MAX_AGE
+        || snapshot.MapVersion != map_get_version() || snapshot.Objects != objects)
+    {
+        snapshot.Data = save_for_network(objects);
+        snapshot.Tick = gCurrentTicks;
+        snapshot.MapVersion = map_get_version();
+        snapshot.Objects = objects;
+    }
+
+    const auto& header = snapshot.Data;
     if (header.empty())
     {
         if (connection)
@@ -1405,7 +1645,9 @@ std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const Objec
     bool RLEState = gUseRLE;
     gUseRLE = false;
 
+    // Without RLE the chunks are stored as they are, so the park is about the size of the S6 data.
     auto ms = OpenRCT2::MemoryStream();
+    ms.Reserve(sizeof(rct_s6_data) + objects.size() * sizeof(rct_object_entry));
     if (!SaveMap(&ms, objects))
     {
         log_warning("Failed to export map.");
@@ -1416,20 +1658,17 @@ std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const Objec
     const void* data = ms.GetData();
     int32_t size = ms.GetLength();
 
-    auto compressed = util_zlib_deflate(static_cast<const uint8_t*>(data), size);
-    if (compressed != std::nullopt)
+    // The compressed data is appended straight after the header string, so it is never copied.
+    std::string headerString = "open2_sv6_zlib";
+    header.assign(headerString.c_str(), headerString.c_str() + headerString.size() + 1);
+    if (util_zlib_deflate(static_cast<const uint8_t*>(data), size, header))
     {
-        std::string headerString = "open2_sv6_zlib";
-        header.resize(headerString.size() + 1 + compressed->size());
-        std::memcpy(&header[0], headerString.c_str(), headerString.size() + 1);
-        std::memcpy(&header[headerString.size() + 1], compressed->data(), compressed->size());
-        log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, headerString.size() + 1 + compressed->size());
+        log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, header.size());
     }
     else
     {
         log_warning("Failed to compress the data, falling back to non-compressed sv6.");
-        header.resize(size);
-        std::memcpy(header.data(), data, size);
+        header.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
     }
     return header;
 }
@@ -1501,23 +1740,14 @@ void NetworkBase::Server_Send_TICK()
 {
     NetworkPacket packet(NetworkCommand::Tick);
     packet << gCurrentTicks << scenario_rand_state().s0;
-    uint32_t flags = 0;
-    // Simple counter which limits how often a sprite checksum gets sent.
-    // This can get somewhat expensive, so we don't want to push it every tick in release,
-    // but debug version can check more often.
-    static int32_t checksum_counter = 0;
-    checksum_counter++;
-    if (checksum_counter >= 100)
-    {
-        checksum_counter = 0;
-        flags |= NETWORK_TICK_FLAG_CHECKSUMS;
-    }
+    // The checksum only covers a slice of the park, it is cheap enough to be sent every tick.
+    uint32_t flags = NETWORK_TICK_FLAG_CHECKSUMS;
     // Send flags always, so we can understand packet structure on the other end,
     // and allow for some expansion.
     packet << flags;
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        rct_sprite_checksum checksum = sprite_checksum();
+        rct_sprite_checksum checksum = GetTickChecksum(gCurrentTicks);
         packet.WriteString(checksum.ToString().c_str());
     }
 
@@ -1651,12 +1881,11 @@ void NetworkBase::Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName,
     SendPacketToClients(packet);
 }
 
-bool NetworkBase::ProcessConnection(NetworkConnection& connection)
+bool NetworkBase::ProcessConnection(NetworkConnection& connection, bool canRead)
 {
-    NetworkReadPacket packetStatus;
-    do
+    while (canRead)
     {
-        packetStatus = connection.ReadPacket();
+        auto packetStatus = connection.ReadPacket();
         switch (packetStatus)
         {
             case NetworkReadPacket::Disconnected:
@@ -1681,7 +1910,8 @@ bool NetworkBase::ProcessConnection(NetworkConnection& connection)
                 // could not read anything from socket
                 break;
         }
-    } while (packetStatus == NetworkReadPacket::Success);
+        canRead = packetStatus == NetworkReadPacket::Success;
+    }
 
     if (!connection.ReceivedPacketRecently())
     {
@@ -2297,7 +2527,8 @@ void NetworkBase::Client_Handle_OBJECTS_LIST(NetworkConnection& connection, Netw
 
     uint32_t index = 0;
     uint32_t totalObjects = 0;
-    packet >> index >> totalObjects;
+    uint32_t count = 0;
+    packet >> index >> totalObjects >> count;
 
     static constexpr uint32_t OBJECT_START_INDEX = 0;
     if (index == OBJECT_START_INDEX)
@@ -2305,7 +2536,7 @@ void NetworkBase::Client_Handle_OBJECTS_LIST(NetworkConnection& connection, Netw
         _missingObjects.clear();
     }
 
-    if (totalObjects > OBJECT_ENTRY_COUNT)
+    if (totalObjects > OBJECT_ENTRY_COUNT || count > totalObjects - std::min(index, totalObjects))
     {
         connection.SetLastDisconnectReason(STR_MULTIPLAYER_SERVER_INVALID_REQUEST);
         connection.Disconnect();
@@ -2313,11 +2544,11 @@ void NetworkBase::Client_Handle_OBJECTS_LIST(NetworkConnection& connection, Netw
         return;
     }
 
-    if (totalObjects > 0)
+    if (count > 0)
     {
         char objectListMsg[256];
         const uint32_t args[] = {
-            index + 1,
+            index + count,
             totalObjects,
         };
         format_string(objectListMsg, 256, STR_MULTIPLAYER_RECEIVING_OBJECTS_LIST, &args);
@@ -2326,9 +2557,21 @@ void NetworkBase::Client_Handle_OBJECTS_LIST(NetworkConnection& connection, Netw
         intent.putExtra(INTENT_EXTRA_MESSAGE, std::string{ objectListMsg });
         intent.putExtra(INTENT_EXTRA_CALLBACK, []() -> void { gNetwork.Close(); });
         context_open_intent(&intent);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const auto* name = packet.Read(8);
+        if (name == nullptr)
+        {
+            connection.SetLastDisconnectReason(STR_MULTIPLAYER_SERVER_INVALID_REQUEST);
+            connection.Disconnect();
+            log_warning("Server sent a truncated objects list");
+            return;
+        }
 
         char objectName[12]{};
-        std::memcpy(objectName, packet.Read(8), 8);
+        std::memcpy(objectName, name, 8);
 
         uint32_t checksum = 0;
         uint32_t flags = 0;
@@ -2350,7 +2593,7 @@ void NetworkBase::Client_Handle_OBJECTS_LIST(NetworkConnection& connection, Netw
         }
     }
 
-    if (index + 1 >= totalObjects)
+    if (index + count >= totalObjects)
     {
         log_verbose("client received object list, it has %u entries", totalObjects);
         Client_Send_MAPREQUEST(_missingObjects);
@@ -2495,121 +2738,138 @@ void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, Networ
 
 void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
 {
-    if (connection.AuthStatus != NetworkAuth::Ok)
-    {
-        const char* hostName = connection.Socket->GetHostName();
+    if (connection.AuthStatus == NetworkAuth::Ok || connection.PendingAuth.Verified.valid())
+        return;
+
+    const char* gameversion = packet.ReadString();
+    const char* name = packet.ReadString();
+    const char* password = packet.ReadString();
+    const char* pubkey = packet.ReadString();
+    uint32_t sigsize;
+    packet >> sigsize;
 
-        const char* gameversion = packet.ReadString();
-        const char* name = packet.ReadString();
-        const char* password = packet.ReadString();
-        const char* pubkey = packet.ReadString();
-        uint32_t sigsize;
-        packet >> sigsize;
-        if (pubkey == nullptr)
+    auto& pendingAuth = connection.PendingAuth;
+    pendingAuth.GameVersion = gameversion != nullptr ? std::make_optional<std::string>(gameversion) : std::nullopt;
+    pendingAuth.Name = name != nullptr ? std::make_optional<std::string>(name) : std::nullopt;
+    pendingAuth.Password = password != nullptr ? std::make_optional<std::string>(password) : std::nullopt;
+
+    const uint8_t* signatureData = pubkey != nullptr ? packet.Read(sigsize) : nullptr;
+    if (signatureData == nullptr)
+    {
+        connection.AuthStatus = NetworkAuth::VerificationFailure;
+        if (pubkey != nullptr)
         {
-            connection.AuthStatus = NetworkAuth::VerificationFailure;
+            log_verbose("Connection %s: Signature verification failed, invalid data!", connection.Socket->GetHostName());
         }
-        else
-        {
+        Server_Complete_AUTH(connection);
+        return;
+    }
+
+    // Loading the key and checking the signature are slow enough to stall the server when many players join at once,
+    // they are done on a worker thread and the join is completed by UpdateServer once the result is in.
+    std::vector<uint8_t> signature(signatureData, signatureData + sigsize);
+    pendingAuth.Verified = std::async(
+        std::launch::async,
+        [key = &connection.Key, challenge = connection.Challenge, publicKey = std::string(pubkey),
+         signature = std::move(signature), hostName = std::string(connection.Socket->GetHostName())]() {
             try
             {
-                std::vector<uint8_t> signature;
-                signature.resize(sigsize);
-
-                const uint8_t* signatureData = packet.Read(sigsize);
-                if (signatureData == nullptr)
-                {
-                    throw std::runtime_error("Failed to read packet.");
-                }
-
-                std::memcpy(signature.data(), signatureData, sigsize);
-
-                auto ms = MemoryStream(pubkey, strlen(pubkey));
-                if (!connection.Key.LoadPublic(&ms))
+                auto ms = MemoryStream(publicKey.data(), publicKey.size());
+                if (!key->LoadPublic(&ms))
                 {
                     throw std::runtime_error("Failed to load public key.");
                 }
-
-                bool verified = connection.Key.Verify(connection.Challenge.data(), connection.Challenge.size(), signature);
-                const std::string hash = connection.Key.PublicKeyHash();
-                if (verified)
-                {
-                    log_verbose("Connection %s: Signature verification ok. Hash %s", hostName, hash.c_str());
-                    if (gConfigNetwork.known_keys_only && _userManager.GetUserByHash(hash) == nullptr)
-                    {
-                        log_verbose("Connection %s: Hash %s, not known", hostName, hash.c_str());
-                        connection.AuthStatus = NetworkAuth::UnknownKeyDisallowed;
-                    }
-                    else
-                    {
-                        connection.AuthStatus = NetworkAuth::Verified;
-                    }
-                }
-                else
-                {
-                    connection.AuthStatus = NetworkAuth::VerificationFailure;
-                    log_verbose("Connection %s: Signature verification failed!", hostName);
-                }
+                return key->Verify(challenge.data(), challenge.size(), signature);
             }
             catch (const std::exception&)
             {
-                connection.AuthStatus = NetworkAuth::VerificationFailure;
-                log_verbose("Connection %s: Signature verification failed, invalid data!", hostName);
+                log_verbose("Connection %s: Signature verification failed, invalid data!", hostName.c_str());
+                return false;
             }
-        }
+        });
+}
 
-        bool passwordless = false;
-        if (connection.AuthStatus == NetworkAuth::Verified)
+void NetworkBase::Server_Complete_AUTH(NetworkConnection& connection)
+{
+    const char* hostName = connection.Socket->GetHostName();
+    auto pendingAuth = std::move(connection.PendingAuth);
+    connection.PendingAuth = {};
+
+    if (pendingAuth.Verified.valid())
+    {
+        const std::string hash = connection.Key.PublicKeyHash();
+        if (pendingAuth.Verified.get())
         {
-            const NetworkGroup* group = GetGroupByID(GetGroupIDByHash(connection.Key.PublicKeyHash()));
-            passwordless = group->CanPerformCommand(GameCommand::PasswordlessLogin);
+            log_verbose("Connection %s: Signature verification ok. Hash %s", hostName, hash.c_str());
+            if (gConfigNetwork.known_keys_only && _userManager.GetUserByHash(hash) == nullptr)
+            {
+                log_verbose("Connection %s: Hash %s, not known", hostName, hash.c_str());
+                connection.AuthStatus = NetworkAuth::UnknownKeyDisallowed;
+            }
+            else
+            {
+                connection.AuthStatus = NetworkAuth::Verified;
+            }
         }
-        if (!gameversion || network_get_version() != gameversion)
+        else
         {
-            connection.AuthStatus = NetworkAuth::BadVersion;
-            log_info("Connection %s: Bad version.", hostName);
+            connection.AuthStatus = NetworkAuth::VerificationFailure;
+            log_verbose("Connection %s: Signature verification failed!", hostName);
         }
-        else if (!name)
+    }
+
+    bool passwordless = false;
+    if (connection.AuthStatus == NetworkAuth::Verified)
+    {
+        const NetworkGroup* group = GetGroupByID(GetGroupIDByHash(connection.Key.PublicKeyHash()));
+        passwordless = group->CanPerformCommand(GameCommand::PasswordlessLogin);
+    }
+    if (!pendingAuth.GameVersion || network_get_version() != *pendingAuth.GameVersion)
+    {
+        connection.AuthStatus = NetworkAuth::BadVersion;
+        log_info("Connection %s: Bad version.", hostName);
+    }
+    else if (!pendingAuth.Name)
+    {
+        connection.AuthStatus = NetworkAuth::BadName;
+        log_info("Connection %s: Bad name.", hostName);
+    }
+    else if (!passwordless)
+    {
+        const auto& password = pendingAuth.Password;
+        if ((!password || password->empty()) && !_password.empty())
         {
-            connection.AuthStatus = NetworkAuth::BadName;
-            log_info("Connection %s: Bad name.", connection.Socket->GetHostName());
+            connection.AuthStatus = NetworkAuth::RequirePassword;
+            log_info("Connection %s: Requires password.", hostName);
         }
-        else if (!passwordless)
+        else if (password && _password != *password)
         {
-            if ((!password || strlen(password) == 0) && !_password.empty())
-            {
-                connection.AuthStatus = NetworkAuth::RequirePassword;
-                log_info("Connection %s: Requires password.", hostName);
-            }
-            else if (password && _password != password)
-            {
-                connection.AuthStatus = NetworkAuth::BadPassword;
-                log_info("Connection %s: Bad password.", hostName);
-            }
+            connection.AuthStatus = NetworkAuth::BadPassword;
+            log_info("Connection %s: Bad password.", hostName);
         }
+    }
 
-        if (static_cast<size_t>(gConfigNetwork.maxplayers) <= player_list.size())
+    if (static_cast<size_t>(gConfigNetwork.maxplayers) <= player_list.size())
+    {
+        connection.AuthStatus = NetworkAuth::Full;
+        log_info("Connection %s: Server is full.", hostName);
+    }
+    else if (connection.AuthStatus == NetworkAuth::Verified)
+    {
+        const std::string hash = connection.Key.PublicKeyHash();
+        if (ProcessPlayerAuthenticatePluginHooks(connection, *pendingAuth.Name, hash))
         {
-            connection.AuthStatus = NetworkAuth::Full;
-            log_info("Connection %s: Server is full.", hostName);
+            connection.AuthStatus = NetworkAuth::Ok;
+            Server_Client_Joined(pendingAuth.Name->c_str(), hash, connection);
         }
-        else if (connection.AuthStatus == NetworkAuth::Verified)
+        else
         {
-            const std::string hash = connection.Key.PublicKeyHash();
-            if (ProcessPlayerAuthenticatePluginHooks(connection, name, hash))
-            {
-                connection.AuthStatus = NetworkAuth::Ok;
-                Server_Client_Joined(name, hash, connection);
-            }
-            else
-            {
-                connection.AuthStatus = NetworkAuth::VerificationFailure;
-                log_info("Connection %s: Denied by plugin.", hostName);
-            }
+            connection.AuthStatus = NetworkAuth::VerificationFailure;
+            log_info("Connection %s: Denied by plugin.", hostName);
         }
-
-        Server_Send_AUTH(connection);
     }
+
+    Server_Send_AUTH(connection);
 }
 
 void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
@@ -3070,6 +3330,7 @@ void NetworkBase::Server_Handle_PING(NetworkConnection& connection, [[maybe_unus
     {
         ping = 0;
     }
+    connection.RecordPing(static_cast<uint32_t>(ping));
     if (connection.Player)
     {
         connection.Player->Ping = ping;
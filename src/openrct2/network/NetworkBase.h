@@ -9,6 +9,7 @@
 #include "NetworkUser.h"
 
 #include <fstream>
+#include <list>
 
 #ifndef DISABLE_NETWORK
 
@@ -43,7 +44,7 @@ public: // Common
     void CloseChatLog();
     NetworkStats_t GetStats() const;
     json_t GetServerInfoAsJson() const;
-    bool ProcessConnection(NetworkConnection& connection);
+    bool ProcessConnection(NetworkConnection& connection, bool canRead = true);
     void CloseConnection();
     NetworkPlayer* AddPlayer(const std::string& name, const std::string& keyhash);
     void ProcessPacket(NetworkConnection& connection, NetworkPacket& packet);
@@ -60,6 +61,7 @@ public: // Server
     void BeginServerLog();
     void AppendServerLog(const std::string& s);
     void CloseServerLog();
+    void WriteServerStats();
     void DecayCooldown(NetworkPlayer* player);
     void AddClient(std::unique_ptr<ITcpSocket>&& socket);
     std::string GetMasterServerUrl();
@@ -96,6 +98,7 @@ public: // Server
     void Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_HEARTBEAT(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Complete_AUTH(NetworkConnection& connection);
     void Server_Client_Joined(const char* name, const std::string& keyhash, NetworkConnection& connection);
     void Server_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
@@ -194,6 +197,17 @@ private: // Server Data
     std::ofstream _server_log_fs;
     uint16_t listening_port = 0;
     bool _playerListInvalidated = false;
+    uint32_t _lastStatsDumpTime = 0;
+
+    // The last map sent, reused for clients joining shortly after it as long as no game action has run since.
+    struct MapSnapshot
+    {
+        uint32_t Tick{};
+        uint32_t MapVersion{};
+        std::vector<const ObjectRepositoryItem*> Objects;
+        std::vector<uint8_t> Data;
+    };
+    MapSnapshot _lastMapSnapshot;
 
 private: // Client Data
     struct PlayerListUpdate
@@ -17,6 +17,8 @@
 #    include "Socket.h"
 #    include "network.h"
 
+#    include <algorithm>
+
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
 constexpr size_t NetworkBufferSize = 1024 * 64; // 64 KiB, maximum packet size.
 
@@ -89,7 +91,7 @@ NetworkReadPacket NetworkConnection::ReadPacket()
             // Received complete packet.
             _lastPacketTime = platform_get_ticks();
 
-            RecordPacketStats(InboundPacket, false);
+            RecordPacketStats(InboundPacket.GetCommand(), InboundPacket.BytesTransferred, false);
 
             return NetworkReadPacket::Success;
         }
@@ -98,12 +100,11 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     return NetworkReadPacket::MoreData;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+NetworkOutboundPacket::NetworkOutboundPacket(const NetworkPacket& packet)
+    : Command(packet.GetCommand())
+    , RequiresAuth(packet.CommandRequiresAuth())
 {
-    auto header = packet.Header;
-
-    std::vector<uint8_t> buffer;
-    buffer.reserve(sizeof(header) + header.Size);
+    PacketHeader header = { static_cast<uint16_t>(packet.Data.size()), packet.GetCommand() };
 
     // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
     // Previously the Id field was not part of the header rather part of the body.
@@ -111,8 +112,16 @@ bool NetworkConnection::SendPacket(NetworkPacket& packet)
     header.Size = Convert::HostToNetwork(header.Size);
     header.Id = ByteSwapBE(header.Id);
 
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
-    buffer.insert(buffer.end(), packet.Data.begin(), packet.Data.end());
+    auto buffer = std::make_shared<std::vector<uint8_t>>();
+    buffer->reserve(sizeof(header) + packet.Data.size());
+    buffer->insert(buffer->end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
+    buffer->insert(buffer->end(), packet.Data.begin(), packet.Data.end());
+    Buffer = std::move(buffer);
+}
+
+bool NetworkConnection::SendPacket(NetworkOutboundPacket& packet)
+{
+    const auto& buffer = *packet.Buffer;
 
     size_t bufferSize = buffer.size() - packet.BytesTransferred;
     size_t sent = Socket->SendData(buffer.data() + packet.BytesTransferred, bufferSize);
@@ -124,16 +133,15 @@ bool NetworkConnection::SendPacket(NetworkPacket& packet)
     bool sendComplete = packet.BytesTransferred == buffer.size();
     if (sendComplete)
     {
-        RecordPacketStats(packet, true);
+        RecordPacketStats(packet.Command, packet.BytesTransferred, true);
     }
     return sendComplete;
 }
 
-void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
+void NetworkConnection::QueuePacket(const NetworkOutboundPacket& packet, bool front)
 {
-    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    if (AuthStatus == NetworkAuth::Ok || !packet.RequiresAuth)
     {
-        packet.Header.Size = static_cast<uint16_t>(packet.Data.size());
         if (front)
         {
             // If the first packet was already partially sent add new packet to second position
@@ -141,16 +149,16 @@ void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
             {
                 auto it = _outboundPackets.begin();
                 it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
+                _outboundPackets.insert(it, packet);
             }
             else
             {
-                _outboundPackets.push_front(std::move(packet));
+                _outboundPackets.push_front(packet);
             }
         }
         else
         {
-            _outboundPackets.push_back(std::move(packet));
+            _outboundPackets.push_back(packet);
         }
     }
 }
@@ -167,10 +175,63 @@ bool NetworkConnection::IsValid() const
 
 void NetworkConnection::SendQueuedPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(_outboundPackets.front()))
+    while (!_outboundPackets.empty())
+    {
+        auto& front = _outboundPackets.front();
+        if (_outboundPackets.size() == 1 || front.Buffer->size() - front.BytesTransferred >= NetworkBufferSize)
+        {
+            if (!SendPacket(front))
+                break;
+
+            _outboundPackets.pop_front();
+            continue;
+        }
+
+        // The socket has Nagle's algorithm disabled, small packets such as the game actions of a tick are written
+        // together so they don't each go out in their own segment.
+        _sendBuffer.clear();
+        for (const auto& packet : _outboundPackets)
+        {
+            const auto& buffer = *packet.Buffer;
+            if (_sendBuffer.size() + (buffer.size() - packet.BytesTransferred) > NetworkBufferSize)
+                break;
+
+            _sendBuffer.insert(_sendBuffer.end(), buffer.begin() + packet.BytesTransferred, buffer.end());
+        }
+
+        size_t sent = Socket->SendData(_sendBuffer.data(), _sendBuffer.size());
+        const bool sendComplete = sent == _sendBuffer.size();
+        while (sent > 0)
+        {
+            auto& packet = _outboundPackets.front();
+            const auto length = std::min(sent, packet.Buffer->size() - packet.BytesTransferred);
+            packet.BytesTransferred += length;
+            sent -= length;
+            if (packet.BytesTransferred == packet.Buffer->size())
+            {
+                RecordPacketStats(packet.Command, packet.BytesTransferred, true);
+                _outboundPackets.pop_front();
+            }
+        }
+
+        if (!sendComplete)
+            break;
+    }
+}
+
+size_t NetworkConnection::GetQueuedPacketCount() const
+{
+    return _outboundPackets.size();
+}
+
+void NetworkConnection::RecordPing(uint32_t ping)
+{
+    size_t bucket = 0;
+    while (bucket < std::size(NETWORK_PING_HISTOGRAM_BOUNDS) && ping > NETWORK_PING_HISTOGRAM_BOUNDS[bucket])
     {
-        _outboundPackets.pop_front();
+        bucket++;
     }
+    Stats.pingHistogram[bucket]++;
 }
 
 void NetworkConnection::ResetLastPacketTime()
@@ -217,12 +278,11 @@ void NetworkConnection::SetLastDisconnectReason(const rct_string_id string_id, v
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+void NetworkConnection::RecordPacketStats(NetworkCommand command, size_t packetSize, bool sending)
 {
-    uint32_t packetSize = static_cast<uint32_t>(packet.BytesTransferred);
     NetworkStatisticsGroup trafficGroup;
 
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NetworkCommand::GameAction:
             trafficGroup = NetworkStatisticsGroup::Commands;
@@ -235,15 +295,21 @@ void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool send
             break;
     }
 
+    // Received packets may carry any command id, only the known ones are counted separately.
+    const bool isKnownCommand = EnumValue(command) < EnumValue(NetworkCommand::Max);
     if (sending)
     {
         Stats.bytesSent[EnumValue(trafficGroup)] += packetSize;
         Stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        if (isKnownCommand)
+            Stats.commandBytesSent[EnumValue(command)] += packetSize;
     }
     else
     {
         Stats.bytesReceived[EnumValue(trafficGroup)] += packetSize;
         Stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        if (isKnownCommand)
+            Stats.commandBytesReceived[EnumValue(command)] += packetSize;
     }
 }
 
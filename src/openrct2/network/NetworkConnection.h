@@ -17,12 +17,41 @@
 #    include "Socket.h"
 
 #    include <deque>
+#    include <future>
 #    include <memory>
+#    include <optional>
+#    include <string>
 #    include <vector>
 
 class NetworkPlayer;
 struct ObjectRepositoryItem;
 
+/**
+ * A packet as it is sent over the wire, header included. The buffer is shared by every connection the packet is
+ * queued on, so a packet sent to all clients is only serialised once.
+ */
+struct NetworkOutboundPacket
+{
+    NetworkCommand Command = NetworkCommand::Invalid;
+    bool RequiresAuth = true;
+    std::shared_ptr<const std::vector<uint8_t>> Buffer;
+    size_t BytesTransferred = 0;
+
+    NetworkOutboundPacket() = default;
+    explicit NetworkOutboundPacket(const NetworkPacket& packet);
+};
+
+/**
+ * The details of an auth request, kept while the signature sent with it is verified on a worker thread.
+ */
+struct NetworkPendingAuth
+{
+    std::optional<std::string> GameVersion;
+    std::optional<std::string> Name;
+    std::optional<std::string> Password;
+    std::future<bool> Verified;
+};
+
 class NetworkConnection final
 {
 public:
@@ -36,17 +65,18 @@ public:
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
     bool ShouldDisconnect = false;
+    // Declared after Key, which the verification loads into, so it is waited on before the key is destroyed.
+    NetworkPendingAuth PendingAuth;
 
     NetworkConnection();
     ~NetworkConnection();
 
     NetworkReadPacket ReadPacket();
-    void QueuePacket(NetworkPacket&& packet, bool front = false);
     void QueuePacket(const NetworkPacket& packet, bool front = false)
     {
-        auto copy = packet;
-        return QueuePacket(std::move(copy), front);
+        QueuePacket(NetworkOutboundPacket(packet), front);
     }
+    void QueuePacket(const NetworkOutboundPacket& packet, bool front = false);
 
     // This will not immediately disconnect the client. The disconnect
     // will happen post-tick.
@@ -54,6 +84,8 @@ public:
 
     bool IsValid() const;
     void SendQueuedPackets();
+    size_t GetQueuedPacketCount() const;
+    void RecordPing(uint32_t ping);
     void ResetLastPacketTime();
     bool ReceivedPacketRecently();
 
@@ -62,12 +94,13 @@ public:
     void SetLastDisconnectReason(const rct_string_id string_id, void* args = nullptr);
 
 private:
-    std::deque<NetworkPacket> _outboundPackets;
+    std::deque<NetworkOutboundPacket> _outboundPackets;
+    std::vector<uint8_t> _sendBuffer;
     uint32_t _lastPacketTime = 0;
     utf8* _lastDisconnectReason = nullptr;
 
-    void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    void RecordPacketStats(NetworkCommand command, size_t packetSize, bool sending);
+    bool SendPacket(NetworkOutboundPacket& packet);
 };
 
 #endif // DISABLE_NETWORK
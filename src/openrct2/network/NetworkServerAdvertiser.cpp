@@ -45,6 +45,7 @@ enum class MasterServerStatus
 #    ifndef DISABLE_HTTP
 constexpr int32_t MASTER_SERVER_REGISTER_TIME = 120 * 1000; // 2 minutes
 constexpr int32_t MASTER_SERVER_HEARTBEAT_TIME = 60 * 1000; // 1 minute
+constexpr uint32_t MASTER_SERVER_REQUEST_TIMEOUT = 30;      // 30 seconds, so requests never pile up
 #    endif
 
 class NetworkServerAdvertiser final : public INetworkServerAdvertiser
@@ -174,6 +175,7 @@ private:
         request.url = GetMasterServerUrl();
         request.method = Http::Method::POST;
         request.forceIPv4 = forceIPv4;
+        request.timeout = MASTER_SERVER_REQUEST_TIMEOUT;
 
         json_t body = {
             { "key", _key },
@@ -206,6 +208,7 @@ private:
         Http::Request request;
         request.url = GetMasterServerUrl();
         request.method = Http::Method::PUT;
+        request.timeout = MASTER_SERVER_REQUEST_TIMEOUT;
 
         json_t body = GetHeartbeatJson();
         request.body = body.dump();
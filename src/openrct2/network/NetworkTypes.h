@@ -14,6 +14,8 @@
 #include "../ride/RideTypes.h"
 #include "../util/Util.h"
 
+#include <iterator>
+
 enum
 {
     SERVER_EVENT_PLAYER_JOINED,
@@ -141,8 +143,15 @@ enum class NetworkStatisticsGroup : uint32_t
     Max,
 };
 
+// Upper bounds of the round trip time histogram buckets in milliseconds, the last bucket holds everything above them.
+constexpr uint32_t NETWORK_PING_HISTOGRAM_BOUNDS[] = { 25, 50, 100, 200, 400, 800, 1600 };
+constexpr size_t NETWORK_PING_HISTOGRAM_BUCKETS = std::size(NETWORK_PING_HISTOGRAM_BOUNDS) + 1;
+
 struct NetworkStats_t
 {
     uint64_t bytesReceived[EnumValue(NetworkStatisticsGroup::Max)];
     uint64_t bytesSent[EnumValue(NetworkStatisticsGroup::Max)];
+    uint64_t commandBytesReceived[EnumValue(NetworkCommand::Max)];
+    uint64_t commandBytesSent[EnumValue(NetworkCommand::Max)];
+    uint32_t pingHistogram[NETWORK_PING_HISTOGRAM_BUCKETS];
 };
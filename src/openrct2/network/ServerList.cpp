@@ -229,6 +229,7 @@ bool ServerList::WriteFavourites(const std::vector<ServerListEntry>& entries) co
             fs.WriteString(entry.Name);
             fs.WriteString(entry.Description);
         }
+        fs.Flush();
         return true;
     }
     catch (const std::exception& e)
@@ -345,6 +346,7 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync
     request.url = masterServerUrl;
     request.method = Http::Method::GET;
     request.header["Accept"] = "application/json";
+    request.timeout = 15;
     Http::DoAsync(request, [p](Http::Response& response) -> void {
         json_t root;
         try
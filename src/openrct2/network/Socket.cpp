@@ -49,6 +49,7 @@
     #include <netdb.h>
     #include <netinet/in.h>
     #include <netinet/tcp.h>
+    #include <poll.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
     #include "../common.h"
@@ -629,6 +630,11 @@ public:
         return _ipAddress;
     }
 
+    SOCKET GetSocket() const
+    {
+        return _socket;
+    }
+
 private:
     explicit TcpSocket(SOCKET socket, const std::string& hostName, const std::string& ipAddress)
     {
@@ -895,6 +901,49 @@ std::unique_ptr<IUdpSocket> CreateUdpSocket()
     return std::make_unique<UdpSocket>();
 }
 
+std::vector<bool> GetReadableTcpSockets(const std::vector<const ITcpSocket*>& sockets)
+{
+    std::vector<bool> readable(sockets.size(), true);
+#    if defined(_WIN32) && _WIN32_WINNT < 0x0600
+    // WSAPoll is not available, every socket will be read.
+    return readable;
+#    else
+    std::vector<size_t> indices;
+    std::vector<pollfd> fds;
+    indices.reserve(sockets.size());
+    fds.reserve(sockets.size());
+    for (size_t i = 0; i < sockets.size(); i++)
+    {
+        const auto* tcpSocket = dynamic_cast<const TcpSocket*>(sockets[i]);
+        if (tcpSocket == nullptr || tcpSocket->GetSocket() == INVALID_SOCKET)
+            continue;
+
+        pollfd fd{};
+        fd.fd = tcpSocket->GetSocket();
+        fd.events = POLLIN;
+        indices.push_back(i);
+        fds.push_back(fd);
+    }
+    if (fds.empty())
+        return readable;
+
+#        ifdef _WIN32
+    int32_t result = WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), 0);
+#        else
+    int32_t result = poll(fds.data(), static_cast<nfds_t>(fds.size()), 0);
+#        endif
+    if (result == SOCKET_ERROR)
+        return readable;
+
+    // Errors and hang ups are left for the read to report.
+    for (size_t i = 0; i < fds.size(); i++)
+    {
+        readable[indices[i]] = fds[i].revents != 0;
+    }
+    return readable;
+#    endif
+}
+
 #    ifdef _WIN32
 static std::vector<INTERFACE_INFO> GetNetworkInterfaces()
 {
@@ -102,6 +102,12 @@ std::unique_ptr<ITcpSocket> CreateTcpSocket();
 std::unique_ptr<IUdpSocket> CreateUdpSocket();
 std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
+/**
+ * Checks which of the given sockets have data to read, an incoming connection or an error with a single system call,
+ * without waiting. Sockets that can not be checked are reported as readable.
+ */
+std::vector<bool> GetReadableTcpSockets(const std::vector<const ITcpSocket*>& sockets);
+
 namespace Convert
 {
     uint16_t HostToNetwork(uint16_t value);
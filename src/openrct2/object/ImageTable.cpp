@@ -16,6 +16,7 @@
 #include "../core/FileScanner.h"
 #include "../core/IStream.hpp"
 #include "../core/Json.hpp"
+#include "../core/MemoryUsage.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../drawing/ImageImporter.h"
@@ -78,6 +79,21 @@ struct ImageTable::RequiredImage
     {
         delete[] g1.offset;
     }
+
+    /**
+     * Hands the image over to the caller, who becomes responsible for freeing its data.
+     */
+    rct_g1_element Release()
+    {
+        auto result = g1;
+        if (result.offset != nullptr && g1_calculate_data_size(&result) == 0)
+        {
+            delete[] result.offset;
+            result.offset = nullptr;
+        }
+        g1.offset = nullptr;
+        return result;
+    }
 };
 
 std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ParseImages(IReadObjectContext* context, std::string s)
@@ -290,6 +306,7 @@ std::string ImageTable::FindLegacyObject(const std::string& name)
 
 ImageTable::~ImageTable()
 {
+    OpenRCT2::MemoryUsage::Remove(OpenRCT2::MemoryUsage::Category::ObjectImages, _memoryUsage);
     if (_data == nullptr)
     {
         for (auto& entry : _entries)
@@ -359,6 +376,8 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
         }
 
         _data = std::move(data);
+        _memoryUsage += dataSize;
+        OpenRCT2::MemoryUsage::Add(OpenRCT2::MemoryUsage::Category::ObjectImages, dataSize);
         _entries.insert(_entries.end(), newEntries.begin(), newEntries.end());
     }
     catch (const std::exception&)
@@ -395,12 +414,11 @@ void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
             }
         }
 
-        // Now add all the images to the image table
+        // Now add all the images to the image table, the table takes over their data rather than copying it.
         auto imagesStartIndex = GetCount();
         for (const auto& img : allImages)
         {
-            const auto& g1 = img->g1;
-            AddImage(&g1);
+            _entries.push_back(img->Release());
         }
 
         // Add all the zoom images at the very end of the image table.
@@ -408,7 +426,7 @@ void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
         for (size_t j = 0; j < allImages.size(); j++)
         {
             const auto tableIndex = imagesStartIndex + j;
-            const auto* img = allImages[j].get();
+            auto* img = allImages[j].get();
             if (img->next_zoom != nullptr)
             {
                 img = img->next_zoom.get();
@@ -419,12 +437,12 @@ void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
 
                 while (img != nullptr)
                 {
-                    auto g1b = img->g1;
+                    auto g1b = img->Release();
                     if (img->next_zoom != nullptr)
                     {
                         g1b.zoomed_offset = -1;
                     }
-                    AddImage(&g1b);
+                    _entries.push_back(g1b);
                     img = img->next_zoom.get();
                 }
             }
@@ -444,6 +462,8 @@ void ImageTable::AddImage(const rct_g1_element* g1)
     {
         newg1.offset = new uint8_t[length];
         std::copy_n(g1->offset, length, newg1.offset);
+        _memoryUsage += length;
+        OpenRCT2::MemoryUsage::Add(OpenRCT2::MemoryUsage::Category::ObjectImages, length);
     }
     _entries.push_back(std::move(newg1));
 }
@@ -27,6 +27,7 @@ class ImageTable
 private:
     std::unique_ptr<uint8_t[]> _data;
     std::vector<rct_g1_element> _entries;
+    size_t _memoryUsage{};
 
     /**
      * Container for a G1 image, additional information and RAII. Used by ReadJson
@@ -178,11 +178,11 @@ std::optional<uint8_t> rct_object_entry::GetSceneryType() const
 class ZipStreamWrapper final : public IStream
 {
 private:
-    std::unique_ptr<IZipArchive> _zipArchive;
+    std::shared_ptr<IZipArchive> _zipArchive;
     std::unique_ptr<IStream> _base;
 
 public:
-    ZipStreamWrapper(std::unique_ptr<IZipArchive> zipArchive, std::unique_ptr<IStream> base)
+    ZipStreamWrapper(std::shared_ptr<IZipArchive> zipArchive, std::unique_ptr<IStream> base)
         : _zipArchive(std::move(zipArchive))
         , _base(std::move(base))
     {
@@ -247,7 +247,7 @@ bool ObjectAsset::IsAvailable() const
     }
     else
     {
-        auto zipArchive = Zip::TryOpen(_zipPath, ZIP_ACCESS::READ);
+        auto zipArchive = Zip::OpenShared(_zipPath);
         return zipArchive != nullptr && zipArchive->Exists(_path);
     }
 }
@@ -260,7 +260,7 @@ uint64_t ObjectAsset::GetSize() const
     }
     else
     {
-        auto zipArchive = Zip::TryOpen(_zipPath, ZIP_ACCESS::READ);
+        auto zipArchive = Zip::OpenShared(_zipPath);
         if (zipArchive != nullptr)
         {
             auto index = zipArchive->GetIndexFromPath(_path);
@@ -282,7 +282,7 @@ std::unique_ptr<IStream> ObjectAsset::GetStream() const
     }
     else
     {
-        auto zipArchive = Zip::TryOpen(_zipPath, ZIP_ACCESS::READ);
+        auto zipArchive = Zip::OpenShared(_zipPath);
         if (zipArchive != nullptr)
         {
             auto stream = zipArchive->GetFileStream(_path);
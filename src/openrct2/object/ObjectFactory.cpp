@@ -399,7 +399,11 @@ namespace ObjectFactory
     {
         try
         {
-            auto archive = Zip::Open(path, ZIP_ACCESS::READ);
+            auto archive = Zip::OpenShared(path);
+            if (archive == nullptr)
+            {
+                throw std::runtime_error("Unable to open zip file.");
+            }
             auto jsonBytes = archive->GetFileData("object.json");
             if (jsonBytes.empty())
             {
@@ -13,6 +13,8 @@
 #include "../ParkImporter.h"
 #include "../core/Console.hpp"
 #include "../core/Memory.hpp"
+#include "../core/TaskScheduler.h"
+#include "../core/Zip.h"
 #include "../localisation/StringIds.h"
 #include "../util/Util.h"
 #include "FootpathItemObject.h"
@@ -27,9 +29,10 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <memory>
 #include <mutex>
-#include <thread>
+#include <optional>
 #include <unordered_set>
 
 class ObjectManager final : public IObjectManager
@@ -627,28 +630,21 @@ private:
         return requiredObjects;
     }
 
-    template<typename T, typename TFunc> static void ParallelFor(const std::vector<T>& items, TFunc func)
+    template<typename T, typename TFunc> static void ParallelFor(const std::vector<T>& items, const TFunc& func)
     {
-        auto partitions = std::thread::hardware_concurrency();
-        auto partitionSize = (items.size() + (partitions - 1)) / partitions;
-        std::vector<std::thread> threads;
-        for (size_t n = 0; n < partitions; n++)
-        {
-            auto begin = n * partitionSize;
-            auto end = std::min(items.size(), begin + partitionSize);
-            threads.emplace_back(
-                [func](size_t pbegin, size_t pend) {
-                    for (size_t i = pbegin; i < pend; i++)
-                    {
-                        func(i);
-                    }
-                },
-                begin, end);
-        }
-        for (auto& t : threads)
+        // Use the context's scheduler, commands that run without a context get a scheduler of their own.
+        auto context = OpenRCT2::GetContext();
+        std::optional<OpenRCT2::TaskScheduler> localScheduler;
+        auto& scheduler = context != nullptr ? context->GetTaskScheduler() : localScheduler.emplace();
+
+        // Objects take very different times to read, a zipped object with many images takes much longer than a small
+        // scenery item, so each one is a task of its own rather than the list being split into equal parts.
+        OpenRCT2::TaskGroup tasks(scheduler);
+        for (size_t i = 0; i < items.size(); i++)
         {
-            t.join();
+            tasks.Run([&func, i]() { func(i); });
         }
+        tasks.Wait();
     }
 
     std::vector<std::unique_ptr<Object>> LoadObjects(
@@ -661,8 +657,9 @@ private:
         loadedObjects.reserve(OBJECT_ENTRY_COUNT);
 
         // Read objects
+        auto readStartTime = std::chrono::high_resolution_clock::now();
         std::mutex commonMutex;
-        ParallelFor(requiredObjects, [this, &commonMutex, requiredObjects, &objects, &badObjects, &loadedObjects](size_t i) {
+        ParallelFor(requiredObjects, [this, &commonMutex, &requiredObjects, &objects, &badObjects, &loadedObjects](size_t i) {
             auto requiredObject = requiredObjects[i];
             std::unique_ptr<Object> object;
             if (requiredObject != nullptr)
@@ -705,10 +702,20 @@ private:
         });
 
         // Load objects
+        auto loadStartTime = std::chrono::high_resolution_clock::now();
         for (auto obj : loadedObjects)
         {
             obj->Load();
         }
+        auto loadEndTime = std::chrono::high_resolution_clock::now();
+
+        // The archives the objects were read from do not have to stay open, this also stops them from being locked.
+        Zip::CloseShared();
+
+        log_verbose(
+            "Read %zu objects in %.2f ms, loaded them in %.2f ms", loadedObjects.size(),
+            std::chrono::duration<double, std::milli>(loadStartTime - readStartTime).count(),
+            std::chrono::duration<double, std::milli>(loadEndTime - loadStartTime).count());
 
         if (!badObjects.empty())
         {
@@ -793,13 +800,19 @@ private:
 
     static int32_t GetIndexFromTypeEntry(ObjectType objectType, size_t entryIndex)
     {
-        int32_t result = 0;
-        for (int32_t i = 0; i < EnumValue(objectType); i++)
-        {
-            result += object_entry_group_counts[i];
-        }
-        result += static_cast<int32_t>(entryIndex);
-        return result;
+        // Objects are looked up by type and index many times a frame, e.g. several times for every surface painted, so
+        // the index of the first object of each type is only summed up once.
+        static const auto firstIndices = []() {
+            std::array<int32_t, EnumValue(ObjectType::Count)> result{};
+            int32_t firstIndex = 0;
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                result[i] = firstIndex;
+                firstIndex += object_entry_group_counts[i];
+            }
+            return result;
+        }();
+        return firstIndices[EnumValue(objectType)] + static_cast<int32_t>(entryIndex);
     }
 };
 
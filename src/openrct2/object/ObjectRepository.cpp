@@ -39,8 +39,9 @@
 #include "RideObject.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 // windows.h defines CP_UTF8
@@ -48,9 +49,16 @@
 
 using namespace OpenRCT2;
 
-struct ObjectEntryHash
+struct ObjectEntryKey
 {
-    size_t operator()(const rct_object_entry& entry) const
+    using Key = rct_object_entry;
+
+    static const rct_object_entry& Get(const ObjectRepositoryItem& item)
+    {
+        return item.ObjectEntry;
+    }
+
+    static size_t Hash(const rct_object_entry& entry)
     {
         uint32_t hash = 5381;
         for (auto i : entry.name)
@@ -59,18 +67,116 @@ struct ObjectEntryHash
         }
         return hash;
     }
+
+    static bool Equal(const rct_object_entry& lhs, const rct_object_entry& rhs)
+    {
+        return memcmp(&lhs.name, &rhs.name, 8) == 0;
+    }
 };
 
-struct ObjectEntryEqual
+struct ObjectIdentifierKey
 {
-    bool operator()(const rct_object_entry& lhs, const rct_object_entry& rhs) const
+    using Key = std::string_view;
+
+    static std::string_view Get(const ObjectRepositoryItem& item)
     {
-        return memcmp(&lhs.name, &rhs.name, 8) == 0;
+        return item.Identifier;
+    }
+
+    static size_t Hash(std::string_view identifier)
+    {
+        return std::hash<std::string_view>()(identifier);
+    }
+
+    static bool Equal(std::string_view lhs, std::string_view rhs)
+    {
+        return lhs == rhs;
     }
 };
 
-using ObjectIdentifierMap = std::unordered_map<std::string, size_t>;
-using ObjectEntryMap = std::unordered_map<rct_object_entry, size_t, ObjectEntryHash, ObjectEntryEqual>;
+/**
+ * An open addressing hash table from a key of a repository item to the index of that item. The keys are not copied,
+ * they are read from the items when probing, so the table only holds indices and stays valid when the items move.
+ */
+template<typename TKey> class ObjectItemIndex
+{
+private:
+    static constexpr uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t MIN_SLOTS = 64;
+
+    std::vector<uint32_t> _slots;
+    size_t _count{};
+
+public:
+    void Clear()
+    {
+        _slots.clear();
+        _count = 0;
+    }
+
+    size_t Find(const std::vector<ObjectRepositoryItem>& items, const typename TKey::Key& key) const
+    {
+        if (_slots.empty())
+            return SIZE_MAX;
+
+        auto slot = GetFirstSlot(key);
+        while (_slots[slot] != EMPTY_SLOT)
+        {
+            if (TKey::Equal(TKey::Get(items[_slots[slot]]), key))
+                return _slots[slot];
+            slot = (slot + 1) & (_slots.size() - 1);
+        }
+        return SIZE_MAX;
+    }
+
+    /**
+     * Adds the item at the given index, replacing any item that has the same key.
+     */
+    void Insert(const std::vector<ObjectRepositoryItem>& items, size_t index)
+    {
+        // Keep the table at most three quarters full, so that probing stays short.
+        if ((_count + 1) * 4 > _slots.size() * 3)
+        {
+            Rehash(items, std::max(MIN_SLOTS, _slots.size() * 2));
+        }
+
+        const auto& key = TKey::Get(items[index]);
+        auto slot = GetFirstSlot(key);
+        while (_slots[slot] != EMPTY_SLOT)
+        {
+            if (TKey::Equal(TKey::Get(items[_slots[slot]]), key))
+            {
+                _slots[slot] = static_cast<uint32_t>(index);
+                return;
+            }
+            slot = (slot + 1) & (_slots.size() - 1);
+        }
+        _slots[slot] = static_cast<uint32_t>(index);
+        _count++;
+    }
+
+private:
+    size_t GetFirstSlot(const typename TKey::Key& key) const
+    {
+        // Fibonacci hashing spreads weak hashes, such as the one for legacy entries, over the power of two table.
+        return static_cast<size_t>((static_cast<uint64_t>(TKey::Hash(key)) * 11400714819323198485ULL) >> 32)
+            & (_slots.size() - 1);
+    }
+
+    void Rehash(const std::vector<ObjectRepositoryItem>& items, size_t numSlots)
+    {
+        auto oldSlots = std::move(_slots);
+        _slots.assign(numSlots, EMPTY_SLOT);
+        _count = 0;
+        for (auto index : oldSlots)
+        {
+            if (index != EMPTY_SLOT)
+            {
+                Insert(items, index);
+            }
+        }
+    }
+};
 
 class ObjectFileIndex final : public FileIndex<ObjectRepositoryItem>
 {
@@ -166,8 +272,8 @@ class ObjectRepository final : public IObjectRepository
     std::shared_ptr<IPlatformEnvironment> const _env;
     ObjectFileIndex const _fileIndex;
     std::vector<ObjectRepositoryItem> _items;
-    ObjectIdentifierMap _newItemMap;
-    ObjectEntryMap _itemMap;
+    ObjectItemIndex<ObjectIdentifierKey> _newItemMap;
+    ObjectItemIndex<ObjectEntryKey> _itemMap;
 
 public:
     explicit ObjectRepository(const std::shared_ptr<IPlatformEnvironment>& env)
@@ -211,30 +317,25 @@ public:
         rct_object_entry entry = {};
         entry.SetName(legacyIdentifier);
 
-        auto kvp = _itemMap.find(entry);
-        if (kvp != _itemMap.end())
-        {
-            return &_items[kvp->second];
-        }
-        return nullptr;
+        return FindObject(&entry);
     }
 
     const ObjectRepositoryItem* FindObject(std::string_view identifier) const override final
     {
-        auto kvp = _newItemMap.find(std::string(identifier));
-        if (kvp != _newItemMap.end())
+        auto index = _newItemMap.Find(_items, identifier);
+        if (index != SIZE_MAX)
         {
-            return &_items[kvp->second];
+            return &_items[index];
         }
         return nullptr;
     }
 
     const ObjectRepositoryItem* FindObject(const rct_object_entry* objectEntry) const override final
     {
-        auto kvp = _itemMap.find(*objectEntry);
-        if (kvp != _itemMap.end())
+        auto index = _itemMap.Find(_items, *objectEntry);
+        if (index != SIZE_MAX)
         {
-            return &_items[kvp->second];
+            return &_items[index];
         }
         return nullptr;
     }
@@ -366,8 +467,8 @@ private:
     void ClearItems()
     {
         _items.clear();
-        _newItemMap.clear();
-        _itemMap.clear();
+        _newItemMap.Clear();
+        _itemMap.Clear();
     }
 
     void SortItems()
@@ -383,15 +484,14 @@ private:
         }
 
         // Rebuild item map
-        _itemMap.clear();
-        _newItemMap.clear();
+        _itemMap.Clear();
+        _newItemMap.Clear();
         for (size_t i = 0; i < _items.size(); i++)
         {
-            rct_object_entry entry = _items[i].ObjectEntry;
-            _itemMap[entry] = i;
+            _itemMap.Insert(_items, i);
             if (!_items[i].Identifier.empty())
             {
-                _newItemMap[_items[i].Identifier] = i;
+                _newItemMap.Insert(_items, i);
             }
         }
     }
@@ -423,9 +523,9 @@ private:
             _items.push_back(std::move(copy));
             if (!item.Identifier.empty())
             {
-                _newItemMap[item.Identifier] = index;
+                _newItemMap.Insert(_items, index);
             }
-            _itemMap[item.ObjectEntry] = index;
+            _itemMap.Insert(_items, index);
             return true;
         }
         else
@@ -514,6 +614,7 @@ private:
             auto fs = FileStream(std::string(path), FILE_MODE_WRITE);
             fs.Write(entry, sizeof(rct_object_entry));
             fs.Write(encodedDataBuffer, encodedDataSize);
+            fs.Flush();
 
             Memory::Free(encodedDataBuffer);
         }
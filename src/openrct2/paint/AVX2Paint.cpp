@@ -0,0 +1,79 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "Paint.h"
+
+#ifdef __AVX2__
+
+#    include <immintrin.h>
+
+// Unsigned a >= b
+static __m256i CompareGreaterEqual(__m256i a, __m256i b)
+{
+    return _mm256_cmpeq_epi16(_mm256_max_epu16(a, b), a);
+}
+
+uint32_t PaintCheckBoundBoxesAVX2(
+    const paint_struct_bound_box& initialBBox, const PaintBoundBoxBatch& batch, size_t count, uint8_t rotation)
+{
+    static_assert(PAINT_BOUND_BOX_BATCH_SIZE == 16, "The batch must fill exactly one register.");
+
+    // Rotating the view flips the x and / or y comparisons, see CheckBoundingBox.
+    const __m256i flipX = _mm256_set1_epi16((rotation == 1 || rotation == 2) ? -1 : 0);
+    const __m256i flipY = _mm256_set1_epi16((rotation == 2 || rotation == 3) ? -1 : 0);
+    const __m256i ones = _mm256_set1_epi16(-1);
+
+    const __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(batch.x));
+    const __m256i y = _mm256_load_si256(reinterpret_cast<const __m256i*>(batch.y));
+    const __m256i z = _mm256_load_si256(reinterpret_cast<const __m256i*>(batch.z));
+    const __m256i xEnd = _mm256_load_si256(reinterpret_cast<const __m256i*>(batch.x_end));
+    const __m256i yEnd = _mm256_load_si256(reinterpret_cast<const __m256i*>(batch.y_end));
+    const __m256i zEnd = _mm256_load_si256(reinterpret_cast<const __m256i*>(batch.z_end));
+
+    // The initial box reaches the current box...
+    __m256i reaches = CompareGreaterEqual(_mm256_set1_epi16(static_cast<int16_t>(initialBBox.z_end)), z);
+    reaches = _mm256_and_si256(
+        reaches, _mm256_xor_si256(CompareGreaterEqual(_mm256_set1_epi16(static_cast<int16_t>(initialBBox.y_end)), y), flipY));
+    reaches = _mm256_and_si256(
+        reaches, _mm256_xor_si256(CompareGreaterEqual(_mm256_set1_epi16(static_cast<int16_t>(initialBBox.x_end)), x), flipX));
+
+    // ...but does not start before the current box ends.
+    __m256i before = _mm256_xor_si256(CompareGreaterEqual(_mm256_set1_epi16(static_cast<int16_t>(initialBBox.z)), zEnd), ones);
+    before = _mm256_and_si256(
+        before,
+        _mm256_xor_si256(
+            CompareGreaterEqual(_mm256_set1_epi16(static_cast<int16_t>(initialBBox.y)), yEnd), _mm256_xor_si256(flipY, ones)));
+    before = _mm256_and_si256(
+        before,
+        _mm256_xor_si256(
+            CompareGreaterEqual(_mm256_set1_epi16(static_cast<int16_t>(initialBBox.x)), xEnd), _mm256_xor_si256(flipX, ones)));
+
+    // Pack the 16 bit lanes down to bytes, in order, to get one bit per bound box.
+    const __m256i lanes = _mm256_andnot_si256(before, reaches);
+    const __m128i packed = _mm_packs_epi16(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+    const auto result = static_cast<uint32_t>(_mm_movemask_epi8(packed));
+    return result & ((1u << count) - 1);
+}
+
+#else
+
+#    ifdef OPENRCT2_X86
+#        error You have to compile this file with AVX2 enabled, when targeting x86!
+#    endif
+
+uint32_t PaintCheckBoundBoxesAVX2(
+    const paint_struct_bound_box& initialBBox, const PaintBoundBoxBatch& batch, size_t count, uint8_t rotation)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+    return 0;
+}
+
+#endif // __AVX2__
@@ -12,17 +12,25 @@
 #include "../Context.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/MemoryUsage.h"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
+#include "../drawing/IDrawingEngine.h"
 #include "../interface/Viewport.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/LocalisationService.h"
 #include "../paint/Painter.h"
+#include "../util/Util.h"
+#include "../world/Map.h"
+#include "PaintTileCache.h"
+#include "VirtualFloor.h"
 #include "sprite/Paint.Sprite.h"
 #include "tile_element/Paint.TileElement.h"
 
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -75,7 +83,7 @@ static constexpr int32_t CalculatePositionHash(const paint_struct& ps, uint8_t r
     return pos.x + pos.y;
 }
 
-static void PaintSessionAddPSToQuadrant(paint_session* session, paint_struct* ps)
+void PaintSessionAddPSToQuadrant(paint_session* session, paint_struct* ps)
 {
     auto positionHash = CalculatePositionHash(*ps, session->CurrentRotation);
     uint32_t paintQuadrantIndex = std::clamp(positionHash / 32, 0, MAX_PAINT_QUADRANTS - 1);
@@ -85,6 +93,11 @@ static void PaintSessionAddPSToQuadrant(paint_session* session, paint_struct* ps
 
     session->QuadrantBackIndex = std::min(session->QuadrantBackIndex, paintQuadrantIndex);
     session->QuadrantFrontIndex = std::max(session->QuadrantFrontIndex, paintQuadrantIndex);
+
+    if (session->TileCache != nullptr)
+    {
+        session->TileCache->OnAddToQuadrant(ps);
+    }
 }
 
 static constexpr bool ImageWithinDPI(const ScreenCoordsXY& imagePos, const rct_g1_element& g1, const rct_drawpixelinfo& dpi)
@@ -186,6 +199,85 @@ static paint_struct* CreateNormalPaintStruct(
     return ps;
 }
 
+/**
+ * Whether the elements of the tile could be drawn inside the area of the session, going by the height bounds of the
+ * tile and the same screen position sub_68B3FB works out for it. Tiles outside the map, the tile the selection arrow is
+ * on and tiles that have changed since their bounds were worked out are always painted.
+ */
+static bool PaintSessionTileMayBeVisible(const paint_session* session, const CoordsXY& mapPos, bool checkMinZ)
+{
+    if (mapPos.x >= gMapSizeUnits || mapPos.y >= gMapSizeUnits || mapPos.x < 32 || mapPos.y < 32)
+        return true;
+
+    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_ARROW) && mapPos.x == gMapSelectArrowPosition.x
+        && mapPos.y == gMapSelectArrowPosition.y)
+        return true;
+
+    auto bounds = map_get_tile_height_bounds(TileCoordsXY(mapPos));
+    if (!bounds)
+        return true;
+
+    int32_t x = mapPos.x;
+    int32_t y = mapPos.y;
+    int32_t dx = 0;
+    switch (session->CurrentRotation)
+    {
+        case 0:
+            dx = x + y;
+            break;
+        case 1:
+            x += 32;
+            dx = y - x;
+            break;
+        case 2:
+            x += 32;
+            y += 32;
+            dx = -(x + y);
+            break;
+        case 3:
+            y += 32;
+            dx = x - y;
+            break;
+    }
+    dx >>= 1;
+
+    const rct_drawpixelinfo& dpi = session->DPI;
+    if (dx - bounds->MaxZ - 32 - dpi.height >= dpi.y)
+        return false;
+
+    // Leaves the same space below the lowest element as sub_68B3FB does below the bottom of the map, plus one tile
+    if (checkMinZ && dx + 52 + 32 - bounds->MinZ <= dpi.y)
+        return false;
+
+    return true;
+}
+
+static void PaintSessionTileElementSetup(paint_session* session, const CoordsXY& mapPos, bool cullTiles, bool checkMinZ)
+{
+    // Tiles that are culled are recorded too, they may grow tall enough to be painted once they change
+    auto* paintedBlocks = session->PaintedBlocks;
+    if (paintedBlocks != nullptr && mapPos.x >= 0 && mapPos.y >= 0 && mapPos.x < MAXIMUM_MAP_SIZE_BIG
+        && mapPos.y < MAXIMUM_MAP_SIZE_BIG)
+    {
+        const auto blockX = mapPos.x / (COORDS_XY_STEP * MAP_BLOCK_SIZE);
+        const auto blockY = mapPos.y / (COORDS_XY_STEP * MAP_BLOCK_SIZE);
+        const auto blockIndex = static_cast<uint16_t>(blockX + (blockY * MAP_BLOCK_COUNT));
+        if (paintedBlocks->empty() || paintedBlocks->back() != blockIndex)
+            paintedBlocks->push_back(blockIndex);
+    }
+
+    if (cullTiles && !PaintSessionTileMayBeVisible(session, mapPos, checkMinZ))
+        return;
+
+    if (paintedBlocks != nullptr && !session->PaintedAnimatedTiles && map_is_location_valid(mapPos))
+    {
+        const auto* tileElement = map_get_first_element_at(mapPos);
+        if (tileElement != nullptr && !PaintTileCacheColumn::IsTileCacheable(tileElement))
+            session->PaintedAnimatedTiles = true;
+    }
+    tile_element_paint_setup(session, mapPos);
+}
+
 template<uint8_t direction> void PaintSessionGenerateRotate(paint_session* session)
 {
     // Optimised modified version of viewport_coord_to_map_coord
@@ -207,16 +299,22 @@ template<uint8_t direction> void PaintSessionGenerateRotate(paint_session* sessi
                                            CoordsXY{ 32, 0 }.Rotate(direction) };
     constexpr CoordsXY nextVerticalTile = CoordsXY{ 32, 32 }.Rotate(direction);
 
+    // The column is walked down far enough for the highest anything can be built, the height bounds of each tile skip
+    // the ones that can not reach it. The virtual floor can be drawn at any height, so it turns culling off, and the
+    // underground and clipped views draw the edges of surfaces lower than the bounds account for.
+    const bool cullTiles = !virtual_floor_is_enabled();
+    const bool checkMinZ = !(session->ViewFlags & (VIEWPORT_FLAG_UNDERGROUND_INSIDE | VIEWPORT_FLAG_CLIP_VIEW));
+
     for (; numVerticalTiles > 0; --numVerticalTiles)
     {
-        tile_element_paint_setup(session, mapTile);
+        PaintSessionTileElementSetup(session, mapTile, cullTiles, checkMinZ);
         sprite_paint_setup(session, mapTile.x, mapTile.y);
 
         auto loc1 = mapTile + adjacentTiles[0];
         sprite_paint_setup(session, loc1.x, loc1.y);
 
         auto loc2 = mapTile + adjacentTiles[1];
-        tile_element_paint_setup(session, loc2);
+        PaintSessionTileElementSetup(session, loc2, cullTiles, checkMinZ);
         sprite_paint_setup(session, loc2.x, loc2.y);
 
         auto loc3 = mapTile + adjacentTiles[2];
@@ -299,84 +397,234 @@ template<> bool CheckBoundingBox<3>(const paint_struct_bound_box& initialBBox, c
     return false;
 }
 
+template<uint8_t TRotation>
+static uint32_t PaintCheckBoundBoxesScalar(
+    const paint_struct_bound_box& initialBBox, const PaintBoundBoxBatch& batch, size_t count)
+{
+    uint32_t result = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const paint_struct_bound_box currentBBox = {
+            batch.x[i], batch.y[i], batch.z[i], batch.x_end[i], batch.y_end[i], batch.z_end[i],
+        };
+        if (CheckBoundingBox<TRotation>(initialBBox, currentBBox))
+        {
+            result |= 1u << i;
+        }
+    }
+    return result;
+}
+
+uint32_t PaintCheckBoundBoxesScalar(
+    const paint_struct_bound_box& initialBBox, const PaintBoundBoxBatch& batch, size_t count, uint8_t rotation)
+{
+    switch (rotation)
+    {
+        case 0:
+            return PaintCheckBoundBoxesScalar<0>(initialBBox, batch, count);
+        case 1:
+            return PaintCheckBoundBoxesScalar<1>(initialBBox, batch, count);
+        case 2:
+            return PaintCheckBoundBoxesScalar<2>(initialBBox, batch, count);
+        case 3:
+            return PaintCheckBoundBoxesScalar<3>(initialBBox, batch, count);
+    }
+    return 0;
+}
+
+// Defaults to the scalar version so that paint sessions can be arranged before PaintCheckBoundBoxesInit has been called.
+uint32_t (*PaintCheckBoundBoxesFn)(
+    const paint_struct_bound_box& initialBBox, const PaintBoundBoxBatch& batch, size_t count, uint8_t rotation)
+    = PaintCheckBoundBoxesScalar;
+
+void PaintCheckBoundBoxesInit()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 bound box function");
+        PaintCheckBoundBoxesFn = PaintCheckBoundBoxesAVX2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 bound box function");
+        PaintCheckBoundBoxesFn = PaintCheckBoundBoxesSSE41;
+    }
+    else
+    {
+        log_verbose("registering scalar bound box function");
+        PaintCheckBoundBoxesFn = PaintCheckBoundBoxesScalar;
+    }
+}
+
+/**
+ * Struct of arrays copy of the paint structs being arranged. The arrange passes only look at the bound boxes and the
+ * links between structs, so these are gathered into compact arrays and linked by index instead of walking the
+ * paint structs themselves. Index 0 is the head of the list and doubles as the end of list marker, as the head is
+ * never linked to.
+ */
+struct PaintArrangeBuffer
+{
+    struct Link
+    {
+        uint32_t Next;
+        uint16_t QuadrantIndex;
+        uint8_t QuadrantFlags;
+    };
+
+    static constexpr uint32_t End = 0;
+
+    std::vector<paint_struct*> Structs;
+    std::vector<Link> Links;
+    std::vector<paint_struct_bound_box> Bounds;
+    PaintBoundBoxBatch Batch;
+
+    void Clear()
+    {
+        Structs.clear();
+        Links.clear();
+        Bounds.clear();
+    }
+
+    uint32_t Add(paint_struct* ps)
+    {
+        const auto index = static_cast<uint32_t>(Structs.size());
+        Structs.push_back(ps);
+        Links.push_back({ End, ps->quadrant_index, ps->quadrant_flags });
+        Bounds.push_back(ps->bounds);
+        return index;
+    }
+};
+
+/**
+ * Gathers the bound boxes of the structs that the arrange pass compares next, starting with ps, into the batch.
+ * @returns the number of bound boxes gathered.
+ */
+static size_t PaintArrangeFillBatch(PaintArrangeBuffer& buffer, uint32_t ps)
+{
+    const auto* const links = buffer.Links.data();
+    const auto* const bounds = buffer.Bounds.data();
+    auto& batch = buffer.Batch;
+
+    size_t count = 0;
+    do
+    {
+        const auto& link = links[ps];
+        if (link.QuadrantFlags & PAINT_QUADRANT_FLAG_BIGGER)
+            break;
+        if (link.QuadrantFlags & PAINT_QUADRANT_FLAG_NEXT)
+        {
+            const auto& bbox = bounds[ps];
+            batch.x[count] = bbox.x;
+            batch.y[count] = bbox.y;
+            batch.z[count] = bbox.z;
+            batch.x_end[count] = bbox.x_end;
+            batch.y_end[count] = bbox.y_end;
+            batch.z_end[count] = bbox.z_end;
+            count++;
+        }
+        ps = link.Next;
+    } while (ps != PaintArrangeBuffer::End && count < PAINT_BOUND_BOX_BATCH_SIZE);
+    return count;
+}
+
+// Arranging runs on the paint threads, each of them keeps its buffer to avoid allocating for every session.
+static thread_local PaintArrangeBuffer _arrangeBuffer;
+
 template<uint8_t _TRotation>
-static paint_struct* PaintArrangeStructsHelperRotation(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag)
+static uint32_t PaintArrangeStructsHelperRotation(
+    PaintArrangeBuffer& buffer, uint32_t ps_next, uint16_t quadrantIndex, uint8_t flag)
 {
-    paint_struct* ps;
-    paint_struct* ps_temp;
+    constexpr auto End = PaintArrangeBuffer::End;
+    auto* const links = buffer.Links.data();
+    const auto* const bounds = buffer.Bounds.data();
+
+    uint32_t ps;
+    uint32_t ps_temp;
     do
     {
         ps = ps_next;
-        ps_next = ps_next->next_quadrant_ps;
-        if (ps_next == nullptr)
+        ps_next = links[ps_next].Next;
+        if (ps_next == End)
             return ps;
-    } while (quadrantIndex > ps_next->quadrant_index);
+    } while (quadrantIndex > links[ps_next].QuadrantIndex);
 
     // Cache the last visited node so we don't have to walk the whole list again
-    paint_struct* ps_cache = ps;
+    uint32_t ps_cache = ps;
 
     ps_temp = ps;
     do
     {
-        ps = ps->next_quadrant_ps;
-        if (ps == nullptr)
+        ps = links[ps].Next;
+        if (ps == End)
             break;
 
-        if (ps->quadrant_index > quadrantIndex + 1)
+        auto& link = links[ps];
+        if (link.QuadrantIndex > quadrantIndex + 1)
         {
-            ps->quadrant_flags = PAINT_QUADRANT_FLAG_BIGGER;
+            link.QuadrantFlags = PAINT_QUADRANT_FLAG_BIGGER;
         }
-        else if (ps->quadrant_index == quadrantIndex + 1)
+        else if (link.QuadrantIndex == quadrantIndex + 1)
         {
-            ps->quadrant_flags = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+            link.QuadrantFlags = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
         }
-        else if (ps->quadrant_index == quadrantIndex)
+        else if (link.QuadrantIndex == quadrantIndex)
         {
-            ps->quadrant_flags = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+            link.QuadrantFlags = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
         }
-    } while (ps->quadrant_index <= quadrantIndex + 1);
+    } while (links[ps].QuadrantIndex <= quadrantIndex + 1);
     ps = ps_temp;
 
     while (true)
     {
         while (true)
         {
-            ps_next = ps->next_quadrant_ps;
-            if (ps_next == nullptr)
+            ps_next = links[ps].Next;
+            if (ps_next == End)
                 return ps_cache;
-            if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_BIGGER)
+            if (links[ps_next].QuadrantFlags & PAINT_QUADRANT_FLAG_BIGGER)
                 return ps_cache;
-            if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_IDENTICAL)
+            if (links[ps_next].QuadrantFlags & PAINT_QUADRANT_FLAG_IDENTICAL)
                 break;
             ps = ps_next;
         }
 
-        ps_next->quadrant_flags &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+        links[ps_next].QuadrantFlags &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
         ps_temp = ps;
 
-        const paint_struct_bound_box& initialBBox = ps_next->bounds;
+        const paint_struct_bound_box initialBBox = bounds[ps_next];
 
+        // Moving a struct behind the initial one does not change which structs follow, so the bound boxes ahead are
+        // compared in batches and the results consumed one by one while walking.
+        uint32_t batchResult = 0;
+        size_t batchRemaining = 0;
         while (true)
         {
             ps = ps_next;
-            ps_next = ps_next->next_quadrant_ps;
-            if (ps_next == nullptr)
+            ps_next = links[ps_next].Next;
+            if (ps_next == End)
                 break;
-            if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_BIGGER)
+            if (links[ps_next].QuadrantFlags & PAINT_QUADRANT_FLAG_BIGGER)
                 break;
-            if (!(ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_NEXT))
+            if (!(links[ps_next].QuadrantFlags & PAINT_QUADRANT_FLAG_NEXT))
                 continue;
 
-            const paint_struct_bound_box& currentBBox = ps_next->bounds;
-
-            const bool compareResult = CheckBoundingBox<_TRotation>(initialBBox, currentBBox);
+            if (batchRemaining == 0)
+            {
+                batchRemaining = PaintArrangeFillBatch(buffer, ps_next);
+                batchResult = batchRemaining == 1
+                    ? CheckBoundingBox<_TRotation>(initialBBox, bounds[ps_next])
+                    : PaintCheckBoundBoxesFn(initialBBox, buffer.Batch, batchRemaining, _TRotation);
+            }
+            const bool compareResult = (batchResult & 1) != 0;
+            batchResult >>= 1;
+            batchRemaining--;
 
             if (compareResult)
             {
-                ps->next_quadrant_ps = ps_next->next_quadrant_ps;
-                paint_struct* ps_temp2 = ps_temp->next_quadrant_ps;
-                ps_temp->next_quadrant_ps = ps_next;
-                ps_next->next_quadrant_ps = ps_temp2;
+                links[ps].Next = links[ps_next].Next;
+                uint32_t ps_temp2 = links[ps_temp].Next;
+                links[ps_temp].Next = ps_next;
+                links[ps_next].Next = ps_temp2;
                 ps_next = ps;
             }
         }
@@ -385,82 +633,208 @@ static paint_struct* PaintArrangeStructsHelperRotation(paint_struct* ps_next, ui
     }
 }
 
-template<int TRotation> static void PaintSessionArrange(PaintSessionCore* session, bool)
+/**
+ * Links and arranges the quadrants backIndex to frontIndex inclusive behind psHead. The quadrant before backIndex must
+ * either be empty or backIndex must be the back quadrant of the session. Paint structs are never moved past an empty
+ * quadrant, so a session split into such ranges arranges to the same order as the whole session at once.
+ * @returns the last paint struct visited, the list continues from there to its tail.
+ */
+template<int TRotation>
+static paint_struct* PaintSessionArrangeQuadrants(
+    PaintSessionCore* session, paint_struct* psHead, uint32_t backIndex, uint32_t frontIndex)
 {
-    paint_struct* psHead = &session->PaintHead;
+    auto& buffer = _arrangeBuffer;
+    buffer.Clear();
 
-    paint_struct* ps = psHead;
-    ps->next_quadrant_ps = nullptr;
-
-    uint32_t quadrantIndex = session->QuadrantBackIndex;
-    if (quadrantIndex != UINT32_MAX)
+    uint32_t ps = buffer.Add(psHead);
+    uint32_t quadrantIndex = backIndex;
+    do
     {
-        do
+        for (auto* ps_next = session->Quadrants[quadrantIndex]; ps_next != nullptr; ps_next = ps_next->next_quadrant_ps)
         {
-            paint_struct* ps_next = session->Quadrants[quadrantIndex];
-            if (ps_next != nullptr)
-            {
-                ps->next_quadrant_ps = ps_next;
-                do
-                {
-                    ps = ps_next;
-                    ps_next = ps_next->next_quadrant_ps;
+            const auto index = buffer.Add(ps_next);
+            buffer.Links[ps].Next = index;
+            ps = index;
+        }
+    } while (++quadrantIndex <= frontIndex);
 
-                } while (ps_next != nullptr);
-            }
-        } while (++quadrantIndex <= session->QuadrantFrontIndex);
+    uint32_t ps_cache;
+    if (backIndex == session->QuadrantBackIndex)
+    {
+        quadrantIndex = backIndex;
+        ps_cache = PaintArrangeStructsHelperRotation<TRotation>(buffer, 0, quadrantIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT);
+    }
+    else
+    {
+        // Run the pass of the empty quadrant before this range, it arranges the first quadrant against itself.
+        quadrantIndex = backIndex - 1;
+        ps_cache = PaintArrangeStructsHelperRotation<TRotation>(buffer, 0, quadrantIndex & 0xFFFF, 0);
+    }
 
-        paint_struct* ps_cache = PaintArrangeStructsHelperRotation<TRotation>(
-            psHead, session->QuadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT);
+    // The pass of the last quadrant can still move back quadrant structs when the range ends before the front quadrant.
+    const uint32_t endIndex = frontIndex == session->QuadrantFrontIndex ? frontIndex : frontIndex + 1;
+    while (++quadrantIndex < endIndex)
+    {
+        ps_cache = PaintArrangeStructsHelperRotation<TRotation>(buffer, ps_cache, quadrantIndex & 0xFFFF, 0);
+    }
 
-        quadrantIndex = session->QuadrantBackIndex;
-        while (++quadrantIndex < session->QuadrantFrontIndex)
-        {
-            ps_cache = PaintArrangeStructsHelperRotation<TRotation>(ps_cache, quadrantIndex & 0xFFFF, 0);
-        }
+    // Write the arranged order back to the paint structs.
+    const auto numStructs = buffer.Structs.size();
+    for (size_t i = 0; i < numStructs; i++)
+    {
+        const auto& link = buffer.Links[i];
+        auto* structPS = buffer.Structs[i];
+        structPS->next_quadrant_ps = link.Next == PaintArrangeBuffer::End ? nullptr : buffer.Structs[link.Next];
+        structPS->quadrant_flags = link.QuadrantFlags;
     }
+    return buffer.Structs[ps_cache];
 }
 
-/**
- *
- *  rct2: 0x00688217
- */
-void PaintSessionArrange(PaintSessionCore* session)
+static paint_struct* PaintSessionArrangeQuadrants(
+    PaintSessionCore* session, paint_struct* psHead, uint32_t backIndex, uint32_t frontIndex)
 {
     switch (session->CurrentRotation)
     {
         case 0:
-            return PaintSessionArrange<0>(session, true);
+            return PaintSessionArrangeQuadrants<0>(session, psHead, backIndex, frontIndex);
         case 1:
-            return PaintSessionArrange<1>(session, true);
+            return PaintSessionArrangeQuadrants<1>(session, psHead, backIndex, frontIndex);
         case 2:
-            return PaintSessionArrange<2>(session, true);
+            return PaintSessionArrangeQuadrants<2>(session, psHead, backIndex, frontIndex);
         case 3:
-            return PaintSessionArrange<3>(session, true);
+            return PaintSessionArrangeQuadrants<3>(session, psHead, backIndex, frontIndex);
     }
     Guard::Assert(false);
+    return psHead;
 }
 
-static void PaintDrawStruct(paint_session* session, paint_struct* ps)
+/**
+ *
+ *  rct2: 0x00688217
+ */
+void PaintSessionArrange(PaintSessionCore* session)
 {
-    rct_drawpixelinfo* dpi = &session->DPI;
+    if (session->QuadrantBackIndex == UINT32_MAX)
+    {
+        session->PaintHead.next_quadrant_ps = nullptr;
+        return;
+    }
+    PaintSessionArrangeQuadrants(session, &session->PaintHead, session->QuadrantBackIndex, session->QuadrantFrontIndex);
+}
+
+void PaintSessionArrange(PaintSessionCore* const* sessions, size_t count, TaskScheduler& scheduler)
+{
+    struct ArrangeRange
+    {
+        PaintSessionCore* Session{};
+        uint32_t BackIndex{};
+        uint32_t FrontIndex{};
+        paint_struct Head{};
+        paint_struct* Tail{};
+    };
+
+    if (count == 0)
+        return;
+
+    // Aim for a couple of ranges per thread so that uneven ranges still balance out.
+    const size_t targetRanges = scheduler.CountThreads() * 2;
+    const uint32_t rangesPerSession = static_cast<uint32_t>(std::max<size_t>(1, (targetRanges + count - 1) / count));
+
+    std::vector<ArrangeRange> ranges;
+    ranges.reserve(count * rangesPerSession);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto* session = sessions[i];
+        if (session->QuadrantBackIndex == UINT32_MAX)
+        {
+            session->PaintHead.next_quadrant_ps = nullptr;
+            continue;
+        }
+
+        const uint32_t backIndex = session->QuadrantBackIndex;
+        const uint32_t frontIndex = session->QuadrantFrontIndex;
+        const uint32_t rangeSize = std::max<uint32_t>(1, (frontIndex - backIndex + 1) / rangesPerSession);
 
+        // Ranges can only be split at empty quadrants.
+        uint32_t rangeBack = backIndex;
+        for (uint32_t quadrantIndex = backIndex + 1; quadrantIndex < frontIndex; quadrantIndex++)
+        {
+            if (quadrantIndex - rangeBack >= rangeSize && session->Quadrants[quadrantIndex] == nullptr)
+            {
+                auto& range = ranges.emplace_back();
+                range.Session = session;
+                range.BackIndex = rangeBack;
+                range.FrontIndex = quadrantIndex - 1;
+                rangeBack = quadrantIndex + 1;
+            }
+        }
+        auto& range = ranges.emplace_back();
+        range.Session = session;
+        range.BackIndex = rangeBack;
+        range.FrontIndex = frontIndex;
+    }
+
+    TaskGroup tasks(scheduler);
+    for (auto& range : ranges)
+    {
+        tasks.Run([&range]() -> void {
+            auto* ps = PaintSessionArrangeQuadrants(range.Session, &range.Head, range.BackIndex, range.FrontIndex);
+            while (ps->next_quadrant_ps != nullptr)
+            {
+                ps = ps->next_quadrant_ps;
+            }
+            range.Tail = ps;
+        });
+    }
+    tasks.Wait();
+
+    // Stitch the arranged ranges back together in quadrant order.
+    paint_struct* tail = nullptr;
+    PaintSessionCore* session = nullptr;
+    for (auto& range : ranges)
+    {
+        if (range.Session != session)
+        {
+            session = range.Session;
+            tail = &session->PaintHead;
+            tail->next_quadrant_ps = nullptr;
+        }
+        if (range.Head.next_quadrant_ps != nullptr)
+        {
+            tail->next_quadrant_ps = range.Head.next_quadrant_ps;
+            tail = range.Tail;
+        }
+    }
+}
+
+static ScreenCoordsXY PaintPSGetScreenCoords(const rct_drawpixelinfo& dpi, const paint_struct* ps)
+{
     int16_t x = ps->x;
     int16_t y = ps->y;
 
     if (ps->sprite_type == ViewportInteractionItem::Entity)
     {
-        if (dpi->zoom_level >= 1)
+        if (dpi.zoom_level >= 1)
         {
             x = floor2(x, 2);
             y = floor2(y, 2);
-            if (dpi->zoom_level >= 2)
+            if (dpi.zoom_level >= 2)
             {
                 x = floor2(x, 4);
                 y = floor2(y, 4);
             }
         }
     }
+    return { x, y };
+}
+
+static void PaintDrawStruct(paint_session* session, paint_struct* ps)
+{
+    rct_drawpixelinfo* dpi = &session->DPI;
+
+    auto screenCoords = PaintPSGetScreenCoords(*dpi, ps);
+    int16_t x = screenCoords.x;
+    int16_t y = screenCoords.y;
 
     uint32_t imageId = PaintPSColourifyImage(ps->image_id, ps->sprite_type, session->ViewFlags);
     if (gPaintBoundingBoxes && dpi->zoom_level == 0)
@@ -482,6 +856,31 @@ static void PaintDrawStruct(paint_session* session, paint_struct* ps)
     }
 }
 
+static void PaintQueueStruct(paint_session* session, const paint_struct* ps)
+{
+    auto& sprites = session->SpriteDrawCalls;
+
+    auto screenCoords = PaintPSGetScreenCoords(session->DPI, ps);
+    uint32_t imageId = PaintPSColourifyImage(ps->image_id, ps->sprite_type, session->ViewFlags);
+    sprites.push_back(
+        { imageId, ps->tertiary_colour, screenCoords.x, screenCoords.y, (ps->flags & PAINT_STRUCT_FLAG_IS_MASKED) != 0 });
+
+    if (ps->children != nullptr)
+    {
+        PaintQueueStruct(session, ps->children);
+        return;
+    }
+
+    for (auto* attached_ps = ps->attached_ps; attached_ps != nullptr; attached_ps = attached_ps->next)
+    {
+        imageId = PaintPSColourifyImage(attached_ps->image_id, ps->sprite_type, session->ViewFlags);
+        const bool isMasked = (attached_ps->flags & PAINT_STRUCT_FLAG_IS_MASKED) != 0;
+        sprites.push_back(
+            { imageId, isMasked ? attached_ps->colour_image_id : ps->tertiary_colour, attached_ps->x + ps->x,
+              attached_ps->y + ps->y, isMasked });
+    }
+}
+
 /**
  *
  *  rct2: 0x00688485
@@ -490,12 +889,35 @@ void PaintDrawStructs(paint_session* session)
 {
     paint_struct* ps = &session->PaintHead;
 
+    // The bounding boxes are drawn in between the sprites, so they are drawn one at a time.
+    rct_drawpixelinfo* dpi = &session->DPI;
+    if (gPaintBoundingBoxes && dpi->zoom_level == 0)
+    {
+        for (ps = ps->next_quadrant_ps; ps;)
+        {
+            PaintDrawStruct(session, ps);
+
+            ps = ps->next_quadrant_ps;
+        }
+        return;
+    }
+
+    // Otherwise the sorted sprites are handed to the drawing engine together, so it can queue them without a call for
+    // each of them.
+    auto& sprites = session->SpriteDrawCalls;
+    sprites.clear();
     for (ps = ps->next_quadrant_ps; ps;)
     {
-        PaintDrawStruct(session, ps);
+        PaintQueueStruct(session, ps);
 
         ps = ps->next_quadrant_ps;
     }
+
+    auto* drawingEngine = dpi->DrawingEngine;
+    if (drawingEngine != nullptr && !sprites.empty())
+    {
+        drawingEngine->GetDrawingContext(dpi)->DrawSprites(sprites.data(), sprites.size());
+    }
 }
 
 /**
@@ -729,6 +1151,10 @@ paint_struct* PaintAddImageAsParent(
 {
     session->LastPS = nullptr;
     session->LastAttachedPS = nullptr;
+    if (session->TileCache != nullptr)
+    {
+        session->TileCache->OnResetLastPS();
+    }
 
     auto* ps = CreateNormalPaintStruct(session, image_id, offset, boundBoxSize, boundBoxOffset);
     if (ps == nullptr)
@@ -778,6 +1204,10 @@ paint_struct* PaintAddImageAsParent(
 
     session->LastPS = nullptr;
     session->LastAttachedPS = nullptr;
+    if (session->TileCache != nullptr)
+    {
+        session->TileCache->OnResetLastPS();
+    }
 
     CoordsXYZ offset = { x_offset, y_offset, z_offset };
     CoordsXYZ boundBoxSize = { bound_box_length_x, bound_box_length_y, bound_box_length_z };
@@ -813,6 +1243,11 @@ paint_struct* PaintAddImageAsChild(
     paint_session* session, uint32_t image_id, const CoordsXYZ& offset, const CoordsXYZ& boundBoxLength,
     const CoordsXYZ& boundBoxOffset)
 {
+    if (session->TileCache != nullptr)
+    {
+        session->TileCache->OnReadLastPS();
+    }
+
     paint_struct* parentPS = session->LastPS;
     if (parentPS == nullptr)
     {
@@ -852,6 +1287,11 @@ paint_struct* PaintAddImageAsChild(
  */
 bool PaintAttachToPreviousAttach(paint_session* session, uint32_t image_id, int16_t x, int16_t y)
 {
+    if (session->TileCache != nullptr)
+    {
+        session->TileCache->OnReadLastPS();
+    }
+
     auto* previousAttachedPS = session->LastAttachedPS;
     if (previousAttachedPS == nullptr)
     {
@@ -885,6 +1325,11 @@ bool PaintAttachToPreviousAttach(paint_session* session, uint32_t image_id, int1
  */
 bool PaintAttachToPreviousPS(paint_session* session, uint32_t image_id, int16_t x, int16_t y)
 {
+    if (session->TileCache != nullptr)
+    {
+        session->TileCache->OnReadLastPS();
+    }
+
     auto* masterPs = session->LastPS;
     if (masterPs == nullptr)
     {
@@ -989,6 +1434,7 @@ PaintEntryPool::Chain::~Chain()
 
 PaintEntryPool::Chain& PaintEntryPool::Chain::operator=(Chain&& chain) noexcept
 {
+    Clear();
     Pool = chain.Pool;
     Head = chain.Head;
     Current = chain.Current;
@@ -1036,12 +1482,12 @@ void PaintEntryPool::Chain::Clear()
 {
     if (Pool != nullptr)
     {
-        Pool->FreeNodes(Head);
-        Head = nullptr;
-        Current = nullptr;
+        // The nodes are reclaimed when the pool is reset.
+        Pool->ReleaseChain();
+        Pool = nullptr;
     }
-    assert(Head == nullptr);
-    assert(Current == nullptr);
+    Head = nullptr;
+    Current = nullptr;
 }
 
 size_t PaintEntryPool::Chain::GetCount() const
@@ -1056,48 +1502,85 @@ size_t PaintEntryPool::Chain::GetCount() const
     return count;
 }
 
+static std::atomic<uint32_t> _nextPaintEntryPoolId{ 1 };
+
+PaintEntryPool::PaintEntryPool()
+    : _id(_nextPaintEntryPoolId++)
+{
+}
+
 PaintEntryPool::~PaintEntryPool()
 {
-    for (auto node : _available)
+    size_t numNodes = 0;
+    for (const auto& arena : _arenas)
     {
-        delete node;
+        numNodes += arena->Nodes.size();
     }
-    _available.clear();
+    OpenRCT2::MemoryUsage::Remove(OpenRCT2::MemoryUsage::Category::PaintEntries, numNodes * sizeof(Node));
 }
 
-PaintEntryPool::Node* PaintEntryPool::AllocateNode()
+PaintEntryPool::Arena& PaintEntryPool::GetArena()
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-
-    PaintEntryPool::Node* result;
-    if (_available.size() > 0)
+    // Pools are identified by id rather than address in case a new pool is created where an old one used to be.
+    thread_local uint32_t cachedPoolId = 0;
+    thread_local Arena* cachedArena = nullptr;
+    if (cachedPoolId != _id)
     {
-        result = _available.back();
-        _available.pop_back();
+        std::lock_guard<std::mutex> lock(_mutex);
+        cachedArena = _arenas.emplace_back(std::make_unique<Arena>()).get();
+        cachedPoolId = _id;
     }
-    else
+    return *cachedArena;
+}
+
+PaintEntryPool::Node* PaintEntryPool::AllocateNode()
+{
+    auto& arena = GetArena();
+    if (arena.NumUsed == arena.Nodes.size())
     {
-        result = new (std::nothrow) PaintEntryPool::Node();
+        auto* node = new (std::nothrow) PaintEntryPool::Node();
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+        arena.Nodes.emplace_back(node);
+        OpenRCT2::MemoryUsage::Add(OpenRCT2::MemoryUsage::Category::PaintEntries, sizeof(Node));
     }
+
+    auto* result = arena.Nodes[arena.NumUsed++].get();
+    result->Next = nullptr;
+    result->Count = 0;
     return result;
 }
 
 PaintEntryPool::Chain PaintEntryPool::Create()
 {
+    _numChains++;
     return PaintEntryPool::Chain(this);
 }
 
-void PaintEntryPool::FreeNodes(PaintEntryPool::Node* head)
+void PaintEntryPool::ReleaseChain()
+{
+    if (--_numChains == 0)
+    {
+        Reset();
+    }
+}
+
+void PaintEntryPool::Reset()
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    auto node = head;
-    while (node != nullptr)
+    size_t numUsed = 0;
+    for (auto& arena : _arenas)
     {
-        auto next = node->Next;
-        node->Next = nullptr;
-        node->Count = 0;
-        _available.push_back(node);
-        node = next;
+        numUsed += arena->NumUsed;
+        arena->NumUsed = 0;
     }
+    _highWaterMark = std::max(_highWaterMark, numUsed * sizeof(Node));
+}
+
+size_t PaintEntryPool::GetHighWaterMark() const
+{
+    return _highWaterMark;
 }
@@ -12,14 +12,23 @@
 #include "../common.h"
 #include "../core/FixedVector.h"
 #include "../drawing/Drawing.h"
+#include "../drawing/IDrawingContext.h"
 #include "../interface/Colour.h"
 #include "../world/Location.hpp"
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
+namespace OpenRCT2
+{
+    class TaskScheduler;
+}
 struct TileElement;
 enum class ViewportInteractionItem : uint8_t;
+class PaintTileCacheColumn;
 
 #pragma pack(push, 1)
 /* size 0x12 */
@@ -60,6 +69,22 @@ struct paint_struct_bound_box
     uint16_t z_end;
 };
 
+constexpr size_t PAINT_BOUND_BOX_BATCH_SIZE = 16;
+
+/**
+ * The bound boxes of several paint structs, one array per coordinate so that they can be compared against a single bound
+ * box with vector instructions.
+ */
+struct PaintBoundBoxBatch
+{
+    alignas(32) uint16_t x[PAINT_BOUND_BOX_BATCH_SIZE];
+    alignas(32) uint16_t y[PAINT_BOUND_BOX_BATCH_SIZE];
+    alignas(32) uint16_t z[PAINT_BOUND_BOX_BATCH_SIZE];
+    alignas(32) uint16_t x_end[PAINT_BOUND_BOX_BATCH_SIZE];
+    alignas(32) uint16_t y_end[PAINT_BOUND_BOX_BATCH_SIZE];
+    alignas(32) uint16_t z_end[PAINT_BOUND_BOX_BATCH_SIZE];
+};
+
 /* size 0x34 */
 struct paint_struct
 {
@@ -142,8 +167,11 @@ struct tunnel_entry
  * A pool of paint_entry instances that can be rented out.
  * The internal implementation uses an unrolled linked list so that each
  * paint session can quickly allocate a new paint entry until it requires
- * another node / block of paint entries. Only the node allocation needs to
- * be thread safe.
+ * another node / block of paint entries. Nodes are taken from an arena
+ * owned by the thread doing the painting, so painting on several threads
+ * does not contend on a lock. Nodes are never returned one by one, all
+ * arenas are reset at once when the last chain has been cleared, i.e. at
+ * the end of each viewport paint.
  */
 class PaintEntryPool
 {
@@ -176,16 +204,33 @@ public:
     };
 
 private:
-    std::vector<Node*> _available;
+    struct Arena
+    {
+        std::vector<std::unique_ptr<Node>> Nodes;
+        size_t NumUsed{};
+    };
+
+    const uint32_t _id;
+    std::vector<std::unique_ptr<Arena>> _arenas;
     std::mutex _mutex;
+    std::atomic<size_t> _numChains{};
+    size_t _highWaterMark{};
 
+    Arena& GetArena();
     Node* AllocateNode();
+    void ReleaseChain();
+    void Reset();
 
 public:
+    PaintEntryPool();
     ~PaintEntryPool();
 
     Chain Create();
-    void FreeNodes(Node* head);
+
+    /**
+     * Gets the largest amount of memory, in bytes, that has been in use at the same time.
+     */
+    size_t GetHighWaterMark() const;
 };
 
 struct PaintSessionCore
@@ -225,6 +270,13 @@ struct paint_session : public PaintSessionCore
 {
     rct_drawpixelinfo DPI;
     PaintEntryPool::Chain PaintEntryChain;
+    PaintTileCacheColumn* TileCache{};
+    // The map blocks of the tiles the session has visited, see map_get_block_change_count.
+    std::vector<uint16_t>* PaintedBlocks{};
+    // Whether any of those tiles look different over time or depend on more than the map, only set if PaintedBlocks is.
+    bool PaintedAnimatedTiles{};
+    // The sprites of the sorted paint structs, handed to the drawing engine in one go. Kept to reuse its memory.
+    std::vector<OpenRCT2::Drawing::SpriteDrawCall> SpriteDrawCalls;
 
     paint_struct* AllocateNormalPaintEntry() noexcept
     {
@@ -336,8 +388,25 @@ void PaintFloatingMoneyEffect(
 paint_session* PaintSessionAlloc(rct_drawpixelinfo* dpi, uint32_t viewFlags);
 void PaintSessionFree(paint_session* session);
 void PaintSessionGenerate(paint_session* session);
+void PaintSessionAddPSToQuadrant(paint_session* session, paint_struct* ps);
 void PaintSessionArrange(PaintSessionCore* session);
+void PaintSessionArrange(PaintSessionCore* const* sessions, size_t count, OpenRCT2::TaskScheduler& scheduler);
 void PaintDrawStructs(paint_session* session);
+
+/**
+ * Checks which of the first count bound boxes of the batch must be drawn after initialBBox for the given rotation.
+ * @returns a mask with bit i set if paint struct i of the batch has to be moved behind the initial paint struct.
+ */
+uint32_t PaintCheckBoundBoxesScalar(
+    const paint_struct_bound_box& initialBBox, const PaintBoundBoxBatch& batch, size_t count, uint8_t rotation);
+uint32_t PaintCheckBoundBoxesSSE41(
+    const paint_struct_bound_box& initialBBox, const PaintBoundBoxBatch& batch, size_t count, uint8_t rotation);
+uint32_t PaintCheckBoundBoxesAVX2(
+    const paint_struct_bound_box& initialBBox, const PaintBoundBoxBatch& batch, size_t count, uint8_t rotation);
+void PaintCheckBoundBoxesInit();
+
+extern uint32_t (*PaintCheckBoundBoxesFn)(
+    const paint_struct_bound_box& initialBBox, const PaintBoundBoxBatch& batch, size_t count, uint8_t rotation);
 void PaintDrawMoneyStructs(rct_drawpixelinfo* dpi, paint_string_struct* ps);
 
 // TESTING
@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PaintImpostorCache.h"
+
+#include "../interface/Viewport.h"
+#include "../world/Map.h"
+
+#ifdef __ENABLE_LIGHTFX__
+#    include "../drawing/LightFX.h"
+#endif
+
+#include <algorithm>
+
+// Cells that have not been painted for this number of viewport paints are discarded.
+static constexpr uint32_t CellMaxAge = 64;
+
+bool PaintImpostorCache::BeginPaint(uint32_t viewFlags, ZoomLevel zoom)
+{
+    _frame++;
+
+    // The background shows through pixels that have not been painted, and lights are added while tiles are painted.
+    bool canPaint = zoom == ZoomLevel::max() && !(viewFlags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND)
+        && PaintTileCacheEnvironment::CanCache();
+#ifdef __ENABLE_LIGHTFX__
+    canPaint = canPaint && !lightfx_is_available();
+#endif
+    if (!canPaint)
+    {
+        _cells.clear();
+        return false;
+    }
+
+    auto environment = PaintTileCacheEnvironment::GetCurrent();
+    if (environment != _environment || viewFlags != _viewFlags || zoom != _zoom || gMapSize != _mapSize)
+    {
+        _environment = environment;
+        _viewFlags = viewFlags;
+        _zoom = zoom;
+        _mapSize = gMapSize;
+        _cells.clear();
+    }
+
+    for (auto it = _cells.begin(); it != _cells.end();)
+    {
+        if (_frame - it->second.LastUsedFrame > CellMaxAge)
+            it = _cells.erase(it);
+        else
+            ++it;
+    }
+    return true;
+}
+
+PaintImpostorCache::Cell& PaintImpostorCache::GetCell(int16_t x, int16_t y)
+{
+    const auto key = (static_cast<uint32_t>(static_cast<uint16_t>(x)) << 16) | static_cast<uint16_t>(y);
+    auto& cell = _cells[key];
+    cell.LastUsedFrame = _frame;
+    return cell;
+}
+
+bool PaintImpostorCache::IsUpToDate(const Cell& cell)
+{
+    if (!cell.IsPainted || cell.IsAnimated)
+        return false;
+
+    for (size_t i = 0; i < cell.Blocks.size(); i++)
+    {
+        if (map_get_block_change_count(cell.Blocks[i]) != cell.BlockChangeCounts[i])
+            return false;
+    }
+    return true;
+}
+
+void PaintImpostorCache::BeginPaintCell(Cell& cell) const
+{
+    cell.Pixels.assign((CellWidth / _zoom) * (CellHeight / _zoom), 0);
+    cell.Blocks.clear();
+    cell.BlockChangeCounts.clear();
+    cell.IsPainted = false;
+}
+
+void PaintImpostorCache::EndPaintCell(Cell& cell, bool isAnimated)
+{
+    std::sort(cell.Blocks.begin(), cell.Blocks.end());
+    cell.Blocks.erase(std::unique(cell.Blocks.begin(), cell.Blocks.end()), cell.Blocks.end());
+    for (auto blockIndex : cell.Blocks)
+    {
+        cell.BlockChangeCounts.push_back(map_get_block_change_count(blockIndex));
+    }
+    cell.IsPainted = true;
+    cell.IsAnimated = isAnimated;
+}
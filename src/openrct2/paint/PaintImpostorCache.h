@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../interface/ZoomLevel.h"
+#include "PaintTileCache.h"
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Keeps the pixels of a viewport that is zoomed out all the way, in cells of one paint session column by CellHeight.
+ * Entities are not painted at that zoom level, so what a cell looks like only depends on the map: it is only painted
+ * again when one of the map blocks its tiles are in changes, see map_get_block_change_count, or every time if it shows
+ * animated tiles. Pixels that nothing has been painted on are left at 0.
+ */
+class PaintImpostorCache
+{
+public:
+    // The size of a cell in screen coordinates at zoom level 0.
+    static constexpr int32_t CellWidth = 32;
+    static constexpr int32_t CellHeight = 1024;
+
+    struct Cell
+    {
+        std::vector<uint8_t> Pixels;
+        std::vector<uint16_t> Blocks;
+        std::vector<uint32_t> BlockChangeCounts;
+        uint32_t LastUsedFrame{};
+        bool IsPainted{};
+        bool IsAnimated{};
+    };
+
+private:
+    PaintTileCacheEnvironment _environment;
+    uint32_t _viewFlags{};
+    ZoomLevel _zoom;
+    int32_t _mapSize{};
+    uint32_t _frame{};
+    std::unordered_map<uint32_t, Cell> _cells;
+
+public:
+    /**
+     * Must be called once before the cells of a viewport paint are looked at. Returns false if the viewport can not be
+     * painted from cells, in which case it has to be painted as usual.
+     */
+    bool BeginPaint(uint32_t viewFlags, ZoomLevel zoom);
+
+    /**
+     * Gets the cell with the given top left corner, which must be a multiple of the cell size.
+     */
+    Cell& GetCell(int16_t x, int16_t y);
+
+    /**
+     * Whether the cell has been painted and none of its map blocks have changed since. Cells that show animated tiles
+     * are never up to date.
+     */
+    static bool IsUpToDate(const Cell& cell);
+
+    /**
+     * Resizes the pixels of the cell and clears its blocks, so its paint session can fill them.
+     */
+    void BeginPaintCell(Cell& cell) const;
+
+    /**
+     * Takes the change counts of the blocks the paint session of the cell has recorded.
+     */
+    static void EndPaintCell(Cell& cell, bool isAnimated);
+};
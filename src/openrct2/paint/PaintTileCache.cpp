@@ -0,0 +1,494 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PaintTileCache.h"
+
+#include "../Cheats.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../drawing/LightFX.h"
+#include "../interface/Viewport.h"
+#include "../peep/Staff.h"
+#include "../ride/TrackDesign.h"
+#include "../world/Map.h"
+#include "../world/Scenery.h"
+#include "../world/SmallScenery.h"
+#include "VirtualFloor.h"
+#include "tile_element/Paint.TileElement.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// Columns that have not been painted for this number of viewport paints are discarded.
+static constexpr uint32_t ColumnMaxAge = 64;
+
+static constexpr CoordsXY NeighbourOffsets[] = { { 32, 0 }, { 0, 32 }, { -32, 0 }, { 0, -32 } };
+
+static uint32_t _paintTileCacheGeneration = 0;
+
+void PaintTileCacheInvalidateAll()
+{
+    _paintTileCacheGeneration++;
+}
+
+bool PaintTileCacheEnvironment::CanCache()
+{
+    // Tools, the virtual floor and the debug overlays change how tiles are painted without changing the map.
+    return gMapSelectFlags == 0 && !virtual_floor_is_enabled() && gStaffDrawPatrolAreas == SPRITE_INDEX_NULL
+        && !gTrackDesignSaveMode && !gShowSupportSegmentHeights && !gCheatsSandboxMode
+        && !(gScreenFlags & (SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER));
+}
+
+PaintTileCacheEnvironment PaintTileCacheEnvironment::GetCurrent()
+{
+    PaintTileCacheEnvironment environment;
+    environment.Generation = _paintTileCacheGeneration;
+    environment.Rotation = get_current_rotation();
+    environment.ClipHeight = gClipHeight;
+    environment.ClipSelectionA = gClipSelectionA;
+    environment.ClipSelectionB = gClipSelectionB;
+    environment.MapBaseZ = gMapBaseZ;
+    environment.PaintBlockedTiles = gPaintBlockedTiles;
+    environment.PaintWidePathsAsGhost = gPaintWidePathsAsGhost;
+    environment.LandscapeSmoothing = gConfigGeneral.landscape_smoothing;
+    environment.TransparentWater = gConfigGeneral.transparent_water;
+    environment.ShowHeightAsUnits = gConfigGeneral.show_height_as_units;
+    environment.MeasurementFormat = static_cast<uint8_t>(gConfigGeneral.measurement_format);
+#ifdef __ENABLE_LIGHTFX__
+    environment.LightFx = lightfx_is_available();
+#endif
+    return environment;
+}
+
+bool PaintTileCacheEnvironment::operator==(const PaintTileCacheEnvironment& rhs) const
+{
+    return Generation == rhs.Generation && Rotation == rhs.Rotation && ClipHeight == rhs.ClipHeight
+        && ClipSelectionA == rhs.ClipSelectionA && ClipSelectionB == rhs.ClipSelectionB && MapBaseZ == rhs.MapBaseZ
+        && PaintBlockedTiles == rhs.PaintBlockedTiles && PaintWidePathsAsGhost == rhs.PaintWidePathsAsGhost
+        && LandscapeSmoothing == rhs.LandscapeSmoothing && TransparentWater == rhs.TransparentWater
+        && ShowHeightAsUnits == rhs.ShowHeightAsUnits && MeasurementFormat == rhs.MeasurementFormat && LightFx == rhs.LightFx;
+}
+
+bool PaintTileCacheEnvironment::operator!=(const PaintTileCacheEnvironment& rhs) const
+{
+    return !(*this == rhs);
+}
+
+static uint32_t GetTileIndex(const CoordsXY& mapCoords)
+{
+    return static_cast<uint32_t>(mapCoords.x / COORDS_XY_STEP) * MAXIMUM_MAP_SIZE_TECHNICAL
+        + static_cast<uint32_t>(mapCoords.y / COORDS_XY_STEP);
+}
+
+bool PaintTileCacheColumn::IsTileCacheable(const TileElement* tileElement)
+{
+    do
+    {
+        // Elements at height zero would see the element pointers of the tile painted before them.
+        if (tileElement->GetBaseZ() == 0)
+            return false;
+
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_SURFACE:
+                break;
+            case TILE_ELEMENT_TYPE_PATH:
+                // Queues show the scrolling name of their ride.
+                if (tileElement->AsPath()->IsQueue())
+                    return false;
+#ifdef __ENABLE_LIGHTFX__
+                // Lamps add their lights while the path is painted, which a replayed tile would not do.
+                if (lightfx_is_available() && tileElement->AsPath()->HasAddition())
+                {
+                    auto* additionEntry = tileElement->AsPath()->GetAdditionEntry();
+                    if (additionEntry != nullptr && (additionEntry->flags & PATH_BIT_FLAG_LAMP))
+                        return false;
+                }
+#endif
+                break;
+            case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+            {
+                auto* entry = tileElement->AsSmallScenery()->GetEntry();
+                if (entry == nullptr || scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_ANIMATED))
+                    return false;
+                break;
+            }
+            case TILE_ELEMENT_TYPE_WALL:
+            {
+                auto* entry = tileElement->AsWall()->GetEntry();
+                if (entry == nullptr || (entry->flags2 & WALL_SCENERY_2_ANIMATED)
+                    || entry->scrolling_mode != SCROLLING_MODE_NONE)
+                    return false;
+                break;
+            }
+            case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+            {
+                auto* entry = tileElement->AsLargeScenery()->GetEntry();
+                if (entry == nullptr || (entry->flags & LARGE_SCENERY_FLAG_3D_TEXT)
+                    || entry->scrolling_mode != SCROLLING_MODE_NONE)
+                    return false;
+                break;
+            }
+            default:
+                // Track, entrances and banners are animated or read ride and banner state.
+                return false;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+    return true;
+}
+
+void PaintTileCacheColumn::TakeSnapshot(CachedTile& tile, const CoordsXY& mapCoords, const TileElement* firstElement)
+{
+    tile.FirstElement = firstElement;
+    tile.Elements.clear();
+    const auto* tileElement = firstElement;
+    do
+    {
+        tile.Elements.push_back(*tileElement);
+    } while (!(tileElement++)->IsLastForTile());
+
+    // Surfaces are painted with the edges of the surrounding surfaces.
+    tile.NeighbourMask = 0;
+    for (size_t i = 0; i < std::size(NeighbourOffsets); i++)
+    {
+        const auto* surfaceElement = map_get_surface_element_at(mapCoords + NeighbourOffsets[i]);
+        if (surfaceElement != nullptr)
+        {
+            tile.Neighbours[i] = *reinterpret_cast<const TileElement*>(surfaceElement);
+            tile.NeighbourMask |= 1 << i;
+        }
+    }
+}
+
+bool PaintTileCacheColumn::MatchesSnapshot(const CachedTile& tile, const CoordsXY& mapCoords, const TileElement* firstElement)
+{
+    if (tile.FirstElement != firstElement)
+        return false;
+
+    const auto* tileElement = firstElement;
+    for (const auto& element : tile.Elements)
+    {
+        if (std::memcmp(&element, tileElement, sizeof(TileElement)) != 0)
+            return false;
+        tileElement++;
+    }
+
+    for (size_t i = 0; i < std::size(NeighbourOffsets); i++)
+    {
+        const auto* surfaceElement = map_get_surface_element_at(mapCoords + NeighbourOffsets[i]);
+        if ((surfaceElement != nullptr) != ((tile.NeighbourMask & (1 << i)) != 0))
+            return false;
+        if (surfaceElement != nullptr && std::memcmp(&tile.Neighbours[i], surfaceElement, sizeof(TileElement)) != 0)
+            return false;
+    }
+    return true;
+}
+
+bool PaintTileCacheColumn::Replay(paint_session* session, const CoordsXY& mapCoords)
+{
+    auto it = _tiles.find(GetTileIndex(mapCoords));
+    if (it == _tiles.end())
+        return false;
+
+    const auto& tile = it->second;
+    if (session->WoodenSupportsPrependTo != nullptr)
+        return false;
+
+    const auto* firstElement = map_get_first_element_at(mapCoords);
+    if (firstElement == nullptr || !MatchesSnapshot(tile, mapCoords, firstElement))
+        return false;
+
+    if (!tile.Cacheable)
+    {
+        // Nothing has changed since the tile was found to be uncacheable, no need to look at it again.
+        _skipRecording = true;
+        return false;
+    }
+
+    _entries.resize(tile.Entries.size());
+    for (auto& entry : _entries)
+    {
+        entry = session->PaintEntryChain.Allocate();
+        if (entry == nullptr)
+        {
+            // Out of paint entries, painting the tile would not have managed either.
+            return true;
+        }
+    }
+
+    auto getBasic = [this](int16_t index) { return index == -1 ? nullptr : &_entries[index]->basic; };
+    auto getAttached = [this](int16_t index) { return index == -1 ? nullptr : &_entries[index]->attached; };
+    for (size_t i = 0; i < _entries.size(); i++)
+    {
+        auto* entry = _entries[i];
+        *entry = tile.Entries[i];
+
+        const auto& links = tile.Links[i];
+        if (links.IsAttached)
+        {
+            entry->attached.next = getAttached(links.First);
+        }
+        else
+        {
+            entry->basic.children = getBasic(links.First);
+            entry->basic.attached_ps = getAttached(links.Second);
+            entry->basic.next_quadrant_ps = nullptr;
+        }
+    }
+
+    for (auto index : tile.Parents)
+    {
+        PaintSessionAddPSToQuadrant(session, &_entries[index]->basic);
+    }
+
+    if (tile.OwnsLastPS)
+    {
+        session->LastPS = getBasic(tile.LastPS);
+        session->LastAttachedPS = getAttached(tile.LastAttachedPS);
+    }
+
+    std::copy(std::begin(tile.SupportSegments), std::end(tile.SupportSegments), std::begin(session->SupportSegments));
+    session->Support = tile.Support;
+    std::copy(std::begin(tile.LeftTunnels), std::end(tile.LeftTunnels), std::begin(session->LeftTunnels));
+    session->LeftTunnelCount = tile.LeftTunnelCount;
+    std::copy(std::begin(tile.RightTunnels), std::end(tile.RightTunnels), std::begin(session->RightTunnels));
+    session->RightTunnelCount = tile.RightTunnelCount;
+    session->VerticalTunnelHeight = tile.VerticalTunnelHeight;
+    session->MapPosition = tile.MapPosition;
+    session->SpritePosition = tile.SpritePosition;
+    session->InteractionType = tile.InteractionType;
+    session->CurrentlyDrawnItem = tile.CurrentlyDrawnItem;
+    if (tile.SurfaceElement != nullptr)
+    {
+        session->SurfaceElement = tile.SurfaceElement;
+    }
+    session->PathElementOnSameHeight = tile.PathElementOnSameHeight;
+    session->TrackElementOnSameHeight = tile.TrackElementOnSameHeight;
+    session->DidPassSurface = tile.DidPassSurface;
+    session->Unk141E9DB = tile.Unk141E9DB;
+    session->WaterHeight = tile.WaterHeight;
+    return true;
+}
+
+void PaintTileCacheColumn::BeginRecord(paint_session* session, const CoordsXY& mapCoords)
+{
+    if (_skipRecording || session->WoodenSupportsPrependTo != nullptr)
+    {
+        _skipRecording = false;
+        return;
+    }
+
+    _recording = true;
+    _ownsLastPS = false;
+    _dependsOnSession = false;
+    _paintedElements = false;
+    _recordingCoords = mapCoords;
+    _recordingNode = session->PaintEntryChain.Current;
+    _recordingNodeOffset = _recordingNode != nullptr ? _recordingNode->Count : 0;
+    _recordingLastPSString = session->LastPSString;
+    _recordingSurfaceElement = session->SurfaceElement;
+    _recordingParents.clear();
+}
+
+void PaintTileCacheColumn::EndRecord(paint_session* session)
+{
+    if (!_recording)
+        return;
+    _recording = false;
+
+    const auto* firstElement = map_get_first_element_at(_recordingCoords);
+    if (firstElement == nullptr)
+        return;
+
+    auto& tile = _tiles[GetTileIndex(_recordingCoords)];
+    TakeSnapshot(tile, _recordingCoords, firstElement);
+    tile.Cacheable = false;
+    tile.Entries.clear();
+    tile.Links.clear();
+    tile.Parents.clear();
+
+    // Tiles that are culled or clipped before painting any of their elements are cheap, they are not worth storing.
+    if (!_paintedElements || _dependsOnSession || session->LastPSString != _recordingLastPSString
+        || session->WoodenSupportsPrependTo != nullptr || !IsTileCacheable(firstElement))
+        return;
+
+    Store(session, tile);
+}
+
+void PaintTileCacheColumn::Store(paint_session* session, CachedTile& tile)
+{
+    // Gather every entry allocated while painting the tile.
+    _entries.clear();
+    auto* node = _recordingNode != nullptr ? _recordingNode : session->PaintEntryChain.Head;
+    size_t offset = _recordingNode != nullptr ? _recordingNodeOffset : 0;
+    for (; node != nullptr; node = node->Next, offset = 0)
+    {
+        for (size_t i = offset; i < node->Count; i++)
+        {
+            _entries.push_back(&node->PaintStructs[i]);
+        }
+    }
+    if (_entries.size() > static_cast<size_t>(std::numeric_limits<int16_t>::max()))
+        return;
+
+    _entryIndices.clear();
+    for (size_t i = 0; i < _entries.size(); i++)
+    {
+        _entryIndices.emplace(_entries[i], static_cast<int16_t>(i));
+    }
+
+    // Every entry must be reachable from the structs the tile added to the quadrants, and must only link to entries of
+    // the tile, otherwise the tile is changing something painted before it.
+    constexpr int16_t unvisited = -2;
+    tile.Links.assign(_entries.size(), EntryLinks{ unvisited, unvisited, false });
+    auto visit = [this, &tile](const void* ptr, bool isAttached) -> int16_t {
+        if (ptr == nullptr)
+            return -1;
+        auto it = _entryIndices.find(ptr);
+        if (it == _entryIndices.end() || tile.Links[it->second].First != unvisited)
+            return unvisited;
+        tile.Links[it->second] = { -1, -1, isAttached };
+        return it->second;
+    };
+
+    size_t numVisited = 0;
+    for (auto* parent : _recordingParents)
+    {
+        auto index = visit(parent, false);
+        while (index >= 0)
+        {
+            auto* ps = &_entries[index]->basic;
+
+            auto attachedIndex = visit(ps->attached_ps, true);
+            tile.Links[index].Second = attachedIndex;
+            while (attachedIndex >= 0)
+            {
+                auto nextIndex = visit(_entries[attachedIndex]->attached.next, true);
+                tile.Links[attachedIndex].First = nextIndex;
+                numVisited++;
+                if (nextIndex == unvisited)
+                    return;
+                attachedIndex = nextIndex;
+            }
+            if (attachedIndex == unvisited)
+                return;
+
+            auto childIndex = visit(ps->children, false);
+            tile.Links[index].First = childIndex;
+            numVisited++;
+            if (childIndex == unvisited)
+                return;
+            index = childIndex;
+        }
+        if (index == unvisited)
+            return;
+
+        tile.Parents.push_back(_entryIndices[parent]);
+    }
+    if (numVisited != _entries.size())
+        return;
+
+    tile.OwnsLastPS = _ownsLastPS;
+    if (_ownsLastPS)
+    {
+        auto lastPS = _entryIndices.find(session->LastPS);
+        auto lastAttachedPS = _entryIndices.find(session->LastAttachedPS);
+        if ((session->LastPS != nullptr && lastPS == _entryIndices.end())
+            || (session->LastAttachedPS != nullptr && lastAttachedPS == _entryIndices.end()))
+            return;
+        tile.LastPS = session->LastPS != nullptr ? lastPS->second : -1;
+        tile.LastAttachedPS = session->LastAttachedPS != nullptr ? lastAttachedPS->second : -1;
+    }
+
+    tile.Entries.reserve(_entries.size());
+    for (const auto* entry : _entries)
+    {
+        tile.Entries.push_back(*entry);
+    }
+
+    std::copy(std::begin(session->SupportSegments), std::end(session->SupportSegments), std::begin(tile.SupportSegments));
+    tile.Support = session->Support;
+    std::copy(std::begin(session->LeftTunnels), std::end(session->LeftTunnels), std::begin(tile.LeftTunnels));
+    tile.LeftTunnelCount = session->LeftTunnelCount;
+    std::copy(std::begin(session->RightTunnels), std::end(session->RightTunnels), std::begin(tile.RightTunnels));
+    tile.RightTunnelCount = session->RightTunnelCount;
+    tile.VerticalTunnelHeight = session->VerticalTunnelHeight;
+    tile.MapPosition = session->MapPosition;
+    tile.SpritePosition = session->SpritePosition;
+    tile.InteractionType = session->InteractionType;
+    tile.CurrentlyDrawnItem = session->CurrentlyDrawnItem;
+    tile.SurfaceElement = session->SurfaceElement != _recordingSurfaceElement ? session->SurfaceElement : nullptr;
+    tile.PathElementOnSameHeight = session->PathElementOnSameHeight;
+    tile.TrackElementOnSameHeight = session->TrackElementOnSameHeight;
+    tile.DidPassSurface = session->DidPassSurface;
+    tile.Unk141E9DB = session->Unk141E9DB;
+    tile.WaterHeight = session->WaterHeight;
+    tile.Cacheable = true;
+}
+
+bool PaintTileCache::ColumnKey::operator==(const ColumnKey& rhs) const
+{
+    return X == rhs.X && Y == rhs.Y && Width == rhs.Width && Height == rhs.Height && ZoomLevel == rhs.ZoomLevel
+        && ViewFlags == rhs.ViewFlags;
+}
+
+size_t PaintTileCache::ColumnKeyHash::operator()(const ColumnKey& key) const
+{
+    size_t hash = static_cast<uint16_t>(key.X);
+    hash = hash * 31 + static_cast<uint16_t>(key.Y);
+    hash = hash * 31 + static_cast<uint16_t>(key.Width);
+    hash = hash * 31 + static_cast<uint16_t>(key.Height);
+    hash = hash * 31 + static_cast<uint8_t>(key.ZoomLevel);
+    hash = hash * 31 + key.ViewFlags;
+    return hash;
+}
+
+bool PaintTileCache::BeginPaint()
+{
+    _frame++;
+
+    _enabled = PaintTileCacheEnvironment::CanCache();
+    if (!_enabled)
+    {
+        _columns.clear();
+        return false;
+    }
+
+    auto environment = PaintTileCacheEnvironment::GetCurrent();
+    if (environment != _environment)
+    {
+        _environment = environment;
+        _columns.clear();
+    }
+
+    for (auto it = _columns.begin(); it != _columns.end();)
+    {
+        if (_frame - it->second->_lastUsedFrame > ColumnMaxAge)
+            it = _columns.erase(it);
+        else
+            ++it;
+    }
+    return true;
+}
+
+PaintTileCacheColumn* PaintTileCache::GetColumn(const rct_drawpixelinfo& dpi, uint32_t viewFlags)
+{
+    if (!_enabled)
+        return nullptr;
+
+    ColumnKey key{ dpi.x, dpi.y, dpi.width, dpi.height, static_cast<int8_t>(dpi.zoom_level), viewFlags };
+    auto& column = _columns[key];
+    if (column == nullptr)
+    {
+        column = std::make_unique<PaintTileCacheColumn>();
+    }
+    column->_lastUsedFrame = _frame;
+    return column.get();
+}
@@ -0,0 +1,225 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+#include "../world/TileElement.h"
+#include "Paint.h"
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The global state that static tile elements read while painting. A change to any of it invalidates every cached tile.
+ */
+struct PaintTileCacheEnvironment
+{
+    uint32_t Generation{};
+    uint8_t Rotation{};
+    uint8_t ClipHeight{};
+    CoordsXY ClipSelectionA;
+    CoordsXY ClipSelectionB;
+    int16_t MapBaseZ{};
+    bool PaintBlockedTiles{};
+    bool PaintWidePathsAsGhost{};
+    bool LandscapeSmoothing{};
+    bool TransparentWater{};
+    bool ShowHeightAsUnits{};
+    uint8_t MeasurementFormat{};
+    bool LightFx{};
+
+    /**
+     * Whether tiles are currently painted from nothing but the map and the environment, which is not the case while
+     * tools or debug overlays are showing.
+     */
+    static bool CanCache();
+    static PaintTileCacheEnvironment GetCurrent();
+
+    bool operator==(const PaintTileCacheEnvironment& rhs) const;
+    bool operator!=(const PaintTileCacheEnvironment& rhs) const;
+};
+
+/**
+ * Stores the paint structs produced by the tiles of one paint session column, so that tiles which have not changed can
+ * be replayed into the next session with the same drawing area instead of being painted again. A cached tile is only
+ * replayed when its tile elements and the surfaces around it are identical to when it was recorded, and only tiles
+ * whose painting does not depend on anything other than the map and the environment are stored.
+ *
+ * A column is only ever used by the paint session it has been handed to, so no locking is required.
+ */
+class PaintTileCacheColumn
+{
+    friend class PaintTileCache;
+
+private:
+    struct EntryLinks
+    {
+        // Indices into Entries, -1 for nullptr. For attached paint structs only First is used, for next.
+        int16_t First;
+        int16_t Second;
+        bool IsAttached;
+    };
+
+    struct CachedTile
+    {
+        const TileElement* FirstElement{};
+        std::vector<TileElement> Elements;
+        std::array<TileElement, 4> Neighbours{};
+        uint8_t NeighbourMask{};
+        bool Cacheable{};
+
+        std::vector<paint_entry> Entries;
+        std::vector<EntryLinks> Links;
+        std::vector<int16_t> Parents;
+        bool OwnsLastPS{};
+        int16_t LastPS{};
+        int16_t LastAttachedPS{};
+
+        support_height SupportSegments[9];
+        support_height Support;
+        tunnel_entry LeftTunnels[TUNNEL_MAX_COUNT];
+        uint8_t LeftTunnelCount;
+        tunnel_entry RightTunnels[TUNNEL_MAX_COUNT];
+        uint8_t RightTunnelCount;
+        uint8_t VerticalTunnelHeight;
+        CoordsXY MapPosition;
+        CoordsXY SpritePosition;
+        ViewportInteractionItem InteractionType;
+        const void* CurrentlyDrawnItem;
+        const TileElement* SurfaceElement;
+        TileElement* PathElementOnSameHeight;
+        TileElement* TrackElementOnSameHeight;
+        bool DidPassSurface;
+        uint8_t Unk141E9DB;
+        uint16_t WaterHeight;
+    };
+
+    uint32_t _lastUsedFrame{};
+    std::unordered_map<uint32_t, CachedTile> _tiles;
+
+    // State of the tile currently being recorded.
+    bool _recording{};
+    bool _ownsLastPS{};
+    bool _dependsOnSession{};
+    bool _paintedElements{};
+    bool _skipRecording{};
+    CoordsXY _recordingCoords;
+    PaintEntryPool::Node* _recordingNode{};
+    size_t _recordingNodeOffset{};
+    const paint_string_struct* _recordingLastPSString{};
+    const TileElement* _recordingSurfaceElement{};
+    std::vector<paint_struct*> _recordingParents;
+
+    // Scratch space, kept to avoid allocating for every tile.
+    std::vector<paint_entry*> _entries;
+    std::unordered_map<const void*, int16_t> _entryIndices;
+
+public:
+    /**
+     * Whether the paint result of the tile only depends on its elements and the environment, and not on the time or the
+     * state of rides and banners.
+     */
+    static bool IsTileCacheable(const TileElement* tileElement);
+
+    /**
+     * Replays the tile at the given position if it is cached and has not changed.
+     * @returns true if the tile has been replayed and must not be painted.
+     */
+    bool Replay(paint_session* session, const CoordsXY& mapCoords);
+
+    /**
+     * Starts recording the tile at the given position, unless it is already known to be uncacheable. The tile is
+     * stored by EndRecord if it turns out to be cacheable. Replay must have been tried first.
+     */
+    void BeginRecord(paint_session* session, const CoordsXY& mapCoords);
+    void EndRecord(paint_session* session);
+
+    bool IsRecording() const
+    {
+        return _recording;
+    }
+
+    void OnAddToQuadrant(paint_struct* ps)
+    {
+        if (_recording)
+            _recordingParents.push_back(ps);
+    }
+
+    void OnResetLastPS()
+    {
+        _ownsLastPS = true;
+    }
+
+    void OnReadLastPS()
+    {
+        // The tile attaches to something painted before it, so it cannot be replayed on its own.
+        if (!_ownsLastPS)
+            _dependsOnSession = true;
+    }
+
+    void OnPaintElement()
+    {
+        _paintedElements = true;
+    }
+
+private:
+    void Store(paint_session* session, CachedTile& tile);
+    static void TakeSnapshot(CachedTile& tile, const CoordsXY& mapCoords, const TileElement* firstElement);
+    static bool MatchesSnapshot(const CachedTile& tile, const CoordsXY& mapCoords, const TileElement* firstElement);
+};
+
+/**
+ * The paint tile cache of a viewport, one column per distinct paint session drawing area.
+ */
+class PaintTileCache
+{
+private:
+    struct ColumnKey
+    {
+        int16_t X;
+        int16_t Y;
+        int16_t Width;
+        int16_t Height;
+        int8_t ZoomLevel;
+        uint32_t ViewFlags;
+
+        bool operator==(const ColumnKey& rhs) const;
+    };
+
+    struct ColumnKeyHash
+    {
+        size_t operator()(const ColumnKey& key) const;
+    };
+
+    PaintTileCacheEnvironment _environment;
+    bool _enabled{};
+    uint32_t _frame{};
+    std::unordered_map<ColumnKey, std::unique_ptr<PaintTileCacheColumn>, ColumnKeyHash> _columns;
+
+public:
+    /**
+     * Must be called once before the sessions of a viewport paint are created. Returns false if the cache can not
+     * be used for this paint, e.g. while a tool is highlighting parts of the map.
+     */
+    bool BeginPaint();
+
+    /**
+     * Gets the column for a session, must be called on the thread that called BeginPaint.
+     */
+    PaintTileCacheColumn* GetColumn(const rct_drawpixelinfo& dpi, uint32_t viewFlags);
+};
+
+/**
+ * Discards all cached tiles of all viewports, for when something other than the map changes how tiles are painted.
+ */
+void PaintTileCacheInvalidateAll();
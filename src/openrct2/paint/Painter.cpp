@@ -9,6 +9,7 @@
 
 #include "Painter.h"
 
+#include "../FrameProfiler.h"
 #include "../Game.h"
 #include "../Intro.h"
 #include "../OpenRCT2.h"
@@ -24,6 +25,13 @@
 #include "../paint/Paint.h"
 #include "../title/TitleScreen.h"
 #include "../ui/UiContext.h"
+#include "../util/Util.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <numeric>
+#include <vector>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
@@ -77,6 +85,13 @@ void Painter::Paint(IDrawingEngine& de)
     {
         PaintFPS(dpi);
     }
+    if (FrameProfiler::Get().IsEnabled())
+    {
+        int32_t y = 2;
+        if (gConfigGeneral.show_fps)
+            y += gConfigGeneral.debugging_tools ? 24 : 12;
+        PaintFrameProfile(dpi, { _uiContext->GetWidth() / 2, y });
+    }
     gCurrentDrawCount++;
 }
 
@@ -113,6 +128,240 @@ void Painter::PaintFPS(rct_drawpixelinfo* dpi)
 
     // Make area dirty so the text doesn't get drawn over the last
     gfx_set_dirty_blocks({ { screenCoords - ScreenCoordsXY{ 16, 4 } }, { dpi->lastStringPos.x + 16, 16 } });
+
+    if (gConfigGeneral.debugging_tools)
+    {
+        PaintArenaUsage(dpi, { _uiContext->GetWidth() / 2, 14 });
+    }
+}
+
+void Painter::PaintArenaUsage(rct_drawpixelinfo* dpi, ScreenCoordsXY screenCoords)
+{
+    const auto highWaterMarkKiB = static_cast<int32_t>(_paintStructPool.GetHighWaterMark() / 1024);
+
+    char buffer[64]{};
+    FormatStringToBuffer(buffer, sizeof(buffer), "{OUTLINE}{WHITE}{INT32} KiB", highWaterMarkKiB);
+
+    int32_t stringWidth = gfx_get_string_width(buffer, FontSpriteBase::MEDIUM);
+    screenCoords.x = screenCoords.x - (stringWidth / 2);
+    gfx_draw_string(dpi, screenCoords, buffer);
+
+    gfx_set_dirty_blocks({ { screenCoords - ScreenCoordsXY{ 16, 4 } }, { dpi->lastStringPos.x + 16, screenCoords.y + 16 } });
+}
+
+void Painter::PaintProfileLine(rct_drawpixelinfo* dpi, ScreenCoordsXY& screenCoords, const char* text)
+{
+    char buffer[256]{};
+    FormatStringToBuffer(buffer, sizeof(buffer), "{OUTLINE}{WHITE}{STRING}", text);
+
+    int32_t stringWidth = gfx_get_string_width(buffer, FontSpriteBase::MEDIUM);
+    ScreenCoordsXY lineCoords(screenCoords.x - (stringWidth / 2), screenCoords.y);
+    gfx_draw_string(dpi, lineCoords, buffer);
+
+    gfx_set_dirty_blocks({ { lineCoords - ScreenCoordsXY{ 16, 4 } }, { dpi->lastStringPos.x + 16, lineCoords.y + 16 } });
+    screenCoords.y += 12;
+}
+
+void Painter::PaintFrameProfile(rct_drawpixelinfo* dpi, ScreenCoordsXY screenCoords)
+{
+    // Average over about a second, so the numbers are readable.
+    constexpr size_t NumSamples = 40;
+    constexpr size_t NumLogicParts = static_cast<size_t>(LogicTimePart::Count);
+    constexpr size_t NumPaintParts = static_cast<size_t>(PaintTimePart::Count);
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    const auto& profiler = FrameProfiler::Get();
+    char text[256]{};
+
+    const auto numTicks = std::min(profiler.GetNumTicks(), NumSamples);
+    if (numTicks > 0)
+    {
+        std::array<ProfilerDuration, NumLogicParts> parts{};
+        auto total = ProfilerDuration::zero();
+        auto longest = ProfilerDuration::zero();
+        for (size_t age = 0; age < numTicks; age++)
+        {
+            for (size_t i = 0; i < NumLogicParts; i++)
+            {
+                parts[i] += profiler.GetTickPartDuration(age, static_cast<LogicTimePart>(i));
+            }
+            const auto duration = profiler.GetTickDuration(age);
+            total += duration;
+            longest = std::max(longest, duration);
+        }
+
+        // Only show the parts that take the longest, there is not enough room for all of them.
+        std::array<size_t, NumLogicParts> order{};
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(
+            order.begin(), order.begin() + 3, order.end(), [&parts](size_t a, size_t b) { return parts[a] > parts[b]; });
+
+        snprintf(
+            text, sizeof(text), "Tick %.2f ms (max %.2f)  %s %.2f  %s %.2f  %s %.2f", Milliseconds(total).count() / numTicks,
+            Milliseconds(longest).count(), FrameProfiler::GetLogicTimePartName(static_cast<LogicTimePart>(order[0])),
+            Milliseconds(parts[order[0]]).count() / numTicks,
+            FrameProfiler::GetLogicTimePartName(static_cast<LogicTimePart>(order[1])),
+            Milliseconds(parts[order[1]]).count() / numTicks,
+            FrameProfiler::GetLogicTimePartName(static_cast<LogicTimePart>(order[2])),
+            Milliseconds(parts[order[2]]).count() / numTicks);
+        PaintProfileLine(dpi, screenCoords, text);
+    }
+
+    const auto numFrames = std::min(profiler.GetNumFrames(), NumSamples);
+    if (numFrames == 0)
+        return;
+
+    // The viewports of the last frame, each averaged over the frames it has been painted in.
+    const auto& lastFrame = profiler.GetFrame(0);
+    std::array<std::array<ProfilerDuration, NumPaintParts>, PROFILER_MAX_VIEWPORTS> viewportParts{};
+    std::array<size_t, PROFILER_MAX_VIEWPORTS> viewportSamples{};
+    std::array<ProfilerDuration, NumPaintParts> frameParts{};
+    auto frameTotal = ProfilerDuration::zero();
+    auto presentLatency = ProfilerDuration::zero();
+    uint64_t textCacheHits = 0;
+    uint64_t textCacheMisses = 0;
+    ProfilerGpuSample gpu;
+    size_t numGpuSamples = 0;
+    for (size_t age = 0; age < numFrames; age++)
+    {
+        const auto& frame = profiler.GetFrame(age);
+        frameTotal += frame.Duration;
+        presentLatency += frame.PresentLatency;
+        textCacheHits += frame.TextCacheHits;
+        textCacheMisses += frame.TextCacheMisses;
+        if (frame.Gpu.Valid)
+        {
+            for (size_t p = 0; p < static_cast<size_t>(GpuTimePart::Count); p++)
+            {
+                gpu.Parts[p] += frame.Gpu.Parts[p];
+            }
+            gpu.NumBatches += frame.Gpu.NumBatches;
+            gpu.NumInstances += frame.Gpu.NumInstances;
+            gpu.UploadedBytes += frame.Gpu.UploadedBytes;
+            gpu.AtlasMisses += frame.Gpu.AtlasMisses;
+            numGpuSamples++;
+        }
+        for (size_t i = 0; i < frame.NumViewports; i++)
+        {
+            const auto& sample = frame.Viewports[i];
+            for (size_t p = 0; p < NumPaintParts; p++)
+            {
+                frameParts[p] += sample.Parts[p];
+            }
+
+            for (size_t j = 0; j < lastFrame.NumViewports; j++)
+            {
+                if (lastFrame.Viewports[j].Viewport == sample.Viewport)
+                {
+                    for (size_t p = 0; p < NumPaintParts; p++)
+                    {
+                        viewportParts[j][p] += sample.Parts[p];
+                    }
+                    viewportSamples[j]++;
+                }
+            }
+        }
+    }
+
+    snprintf(
+        text, sizeof(text), "Frame %.2f ms  Generate %.2f  Arrange %.2f  Draw %.2f  Latency %.2f",
+        Milliseconds(frameTotal).count() / numFrames,
+        Milliseconds(frameParts[EnumValue(PaintTimePart::Generate)]).count() / numFrames,
+        Milliseconds(frameParts[EnumValue(PaintTimePart::Arrange)]).count() / numFrames,
+        Milliseconds(frameParts[EnumValue(PaintTimePart::Draw)]).count() / numFrames,
+        Milliseconds(presentLatency).count() / numFrames);
+    PaintProfileLine(dpi, screenCoords, text);
+
+    const auto textCacheLookups = textCacheHits + textCacheMisses;
+    snprintf(
+        text, sizeof(text), "Text cache %.1f hits  %.1f misses  (%.1f%% hit rate)",
+        static_cast<double>(textCacheHits) / numFrames, static_cast<double>(textCacheMisses) / numFrames,
+        textCacheLookups != 0 ? 100.0 * textCacheHits / textCacheLookups : 0.0);
+    PaintProfileLine(dpi, screenCoords, text);
+
+    const auto& textureStats = profiler.GetTextureStats();
+    if (textureStats)
+    {
+        constexpr double BytesPerMegabyte = 1024.0 * 1024.0;
+        snprintf(
+            text, sizeof(text), "Textures %zu images (%zu pending)  %.1f of %.1f MB used  %" PRIu64 " evicted  %" PRIu64
+            " compactions",
+            textureStats->NumImages, textureStats->NumPendingImages, textureStats->UsedBytes / BytesPerMegabyte,
+            textureStats->AllocatedBytes / BytesPerMegabyte, textureStats->NumEvictedImages, textureStats->NumCompactions);
+        PaintProfileLine(dpi, screenCoords, text);
+    }
+
+    if (numGpuSamples > 0)
+    {
+        auto gpuTotal = ProfilerDuration::zero();
+        for (const auto& part : gpu.Parts)
+        {
+            gpuTotal += part;
+        }
+        snprintf(
+            text, sizeof(text), "GPU %.2f ms  Lines %.2f  Rectangles %.2f  Transparency %.2f  Palette %.2f",
+            Milliseconds(gpuTotal).count() / numGpuSamples,
+            Milliseconds(gpu.Parts[EnumValue(GpuTimePart::Lines)]).count() / numGpuSamples,
+            Milliseconds(gpu.Parts[EnumValue(GpuTimePart::Rectangles)]).count() / numGpuSamples,
+            Milliseconds(gpu.Parts[EnumValue(GpuTimePart::Transparency)]).count() / numGpuSamples,
+            Milliseconds(gpu.Parts[EnumValue(GpuTimePart::Palette)]).count() / numGpuSamples);
+        PaintProfileLine(dpi, screenCoords, text);
+
+        snprintf(
+            text, sizeof(text), "Batches %.1f  Instances %.0f  Uploaded %.1f KB  Atlas misses %.1f",
+            static_cast<double>(gpu.NumBatches) / numGpuSamples, static_cast<double>(gpu.NumInstances) / numGpuSamples,
+            gpu.UploadedBytes / 1024.0 / numGpuSamples, static_cast<double>(gpu.AtlasMisses) / numGpuSamples);
+        PaintProfileLine(dpi, screenCoords, text);
+    }
+
+    for (size_t j = 0; j < lastFrame.NumViewports; j++)
+    {
+        const auto numSamples = std::max<size_t>(viewportSamples[j], 1);
+        snprintf(
+            text, sizeof(text), "Viewport %zu  Generate %.2f  Arrange %.2f  Draw %.2f", j + 1,
+            Milliseconds(viewportParts[j][EnumValue(PaintTimePart::Generate)]).count() / numSamples,
+            Milliseconds(viewportParts[j][EnumValue(PaintTimePart::Arrange)]).count() / numSamples,
+            Milliseconds(viewportParts[j][EnumValue(PaintTimePart::Draw)]).count() / numSamples);
+        PaintProfileLine(dpi, screenCoords, text);
+    }
+
+    // The window classes that cost the most to redraw, the main window includes painting its viewport.
+    std::vector<ProfilerWindowSample> windowClasses;
+    for (size_t age = 0; age < numFrames; age++)
+    {
+        const auto& frame = profiler.GetFrame(age);
+        for (size_t i = 0; i < frame.NumWindowClasses; i++)
+        {
+            const auto& sample = frame.WindowClasses[i];
+            auto it = std::find_if(windowClasses.begin(), windowClasses.end(), [&sample](const ProfilerWindowSample& s) {
+                return s.WindowClass == sample.WindowClass;
+            });
+            if (it == windowClasses.end())
+            {
+                windowClasses.push_back(sample);
+                continue;
+            }
+            it->NumDraws += sample.NumDraws;
+            it->DrawDuration += sample.DrawDuration;
+            it->NumInvalidations += sample.NumInvalidations;
+            it->InvalidatedPixels += sample.InvalidatedPixels;
+        }
+    }
+
+    const auto numWindowLines = std::min<size_t>(windowClasses.size(), 3);
+    std::partial_sort(
+        windowClasses.begin(), windowClasses.begin() + numWindowLines, windowClasses.end(),
+        [](const ProfilerWindowSample& a, const ProfilerWindowSample& b) { return a.DrawDuration > b.DrawDuration; });
+    for (size_t i = 0; i < numWindowLines; i++)
+    {
+        const auto& sample = windowClasses[i];
+        snprintf(
+            text, sizeof(text), "Window class %u  Draw %.2f ms (%.1f draws)  %.1f invalidations  %.0f px",
+            static_cast<unsigned>(sample.WindowClass), Milliseconds(sample.DrawDuration).count() / numFrames,
+            static_cast<double>(sample.NumDraws) / numFrames, static_cast<double>(sample.NumInvalidations) / numFrames,
+            static_cast<double>(sample.InvalidatedPixels) / numFrames);
+        PaintProfileLine(dpi, screenCoords, text);
+    }
 }
 
 void Painter::MeasureFPS()
@@ -152,6 +401,9 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
     session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
     session->QuadrantFrontIndex = 0;
     session->PaintEntryChain = _paintStructPool.Create();
+    session->TileCache = nullptr;
+    session->PaintedBlocks = nullptr;
+    session->PaintedAnimatedTiles = false;
 
     std::fill(std::begin(session->Quadrants), std::end(session->Quadrants), nullptr);
     session->LastPS = nullptr;
@@ -53,6 +53,9 @@ namespace OpenRCT2
         private:
             void PaintReplayNotice(rct_drawpixelinfo* dpi, const char* text);
             void PaintFPS(rct_drawpixelinfo* dpi);
+            void PaintArenaUsage(rct_drawpixelinfo* dpi, ScreenCoordsXY screenCoords);
+            void PaintFrameProfile(rct_drawpixelinfo* dpi, ScreenCoordsXY screenCoords);
+            void PaintProfileLine(rct_drawpixelinfo* dpi, ScreenCoordsXY& screenCoords, const char* text);
             void MeasureFPS();
         };
     } // namespace Paint
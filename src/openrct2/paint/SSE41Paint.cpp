@@ -0,0 +1,79 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "Paint.h"
+
+#ifdef __SSE4_1__
+
+#    include <immintrin.h>
+
+// Unsigned a >= b, _mm_max_epu16 is SSE4.1
+static __m128i CompareGreaterEqual(__m128i a, __m128i b)
+{
+    return _mm_cmpeq_epi16(_mm_max_epu16(a, b), a);
+}
+
+uint32_t PaintCheckBoundBoxesSSE41(
+    const paint_struct_bound_box& initialBBox, const PaintBoundBoxBatch& batch, size_t count, uint8_t rotation)
+{
+    // Rotating the view flips the x and / or y comparisons, see CheckBoundingBox.
+    const __m128i flipX = _mm_set1_epi16((rotation == 1 || rotation == 2) ? -1 : 0);
+    const __m128i flipY = _mm_set1_epi16((rotation == 2 || rotation == 3) ? -1 : 0);
+    const __m128i ones = _mm_set1_epi16(-1);
+
+    const __m128i initialX = _mm_set1_epi16(static_cast<int16_t>(initialBBox.x));
+    const __m128i initialY = _mm_set1_epi16(static_cast<int16_t>(initialBBox.y));
+    const __m128i initialZ = _mm_set1_epi16(static_cast<int16_t>(initialBBox.z));
+    const __m128i initialXEnd = _mm_set1_epi16(static_cast<int16_t>(initialBBox.x_end));
+    const __m128i initialYEnd = _mm_set1_epi16(static_cast<int16_t>(initialBBox.y_end));
+    const __m128i initialZEnd = _mm_set1_epi16(static_cast<int16_t>(initialBBox.z_end));
+
+    uint32_t result = 0;
+    for (size_t i = 0; i < count; i += 8)
+    {
+        const __m128i x = _mm_load_si128(reinterpret_cast<const __m128i*>(&batch.x[i]));
+        const __m128i y = _mm_load_si128(reinterpret_cast<const __m128i*>(&batch.y[i]));
+        const __m128i z = _mm_load_si128(reinterpret_cast<const __m128i*>(&batch.z[i]));
+        const __m128i xEnd = _mm_load_si128(reinterpret_cast<const __m128i*>(&batch.x_end[i]));
+        const __m128i yEnd = _mm_load_si128(reinterpret_cast<const __m128i*>(&batch.y_end[i]));
+        const __m128i zEnd = _mm_load_si128(reinterpret_cast<const __m128i*>(&batch.z_end[i]));
+
+        // The initial box reaches the current box...
+        __m128i reaches = CompareGreaterEqual(initialZEnd, z);
+        reaches = _mm_and_si128(reaches, _mm_xor_si128(CompareGreaterEqual(initialYEnd, y), flipY));
+        reaches = _mm_and_si128(reaches, _mm_xor_si128(CompareGreaterEqual(initialXEnd, x), flipX));
+
+        // ...but does not start before the current box ends.
+        __m128i before = _mm_xor_si128(CompareGreaterEqual(initialZ, zEnd), ones);
+        before = _mm_and_si128(before, _mm_xor_si128(CompareGreaterEqual(initialY, yEnd), _mm_xor_si128(flipY, ones)));
+        before = _mm_and_si128(before, _mm_xor_si128(CompareGreaterEqual(initialX, xEnd), _mm_xor_si128(flipX, ones)));
+
+        const __m128i lanes = _mm_andnot_si128(before, reaches);
+        const auto laneMask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(lanes, _mm_setzero_si128())));
+        result |= laneMask << i;
+    }
+    return result & ((1u << count) - 1);
+}
+
+#else
+
+#    ifdef OPENRCT2_X86
+#        error You have to compile this file with SSE4.1 enabled, when targeting x86!
+#    endif
+
+uint32_t PaintCheckBoundBoxesSSE41(
+    const paint_struct_bound_box& initialBBox, const PaintBoundBoxBatch& batch, size_t count, uint8_t rotation)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+#endif // __SSE4_1__
@@ -15,6 +15,8 @@
 #include "Paint.h"
 #include "tile_element/Paint.TileElement.h"
 
+#include <algorithm>
+
 /** rct2: 0x0097AF20, 0x0097AF21 */
 // clang-format off
 static constexpr const CoordsXY SupportBoundBoxes[] = {
@@ -567,14 +569,15 @@ bool wooden_a_supports_paint_setup(
     }
 
     // Draw repeated supports for left over space
+    const uint32_t fullImageId = WoodenSupportImageIds[supportType].full | imageColourFlags;
+    const uint32_t halfImageId = WoodenSupportImageIds[supportType].half | imageColourFlags;
     while (height != 0)
     {
         if ((z & 16) == 0 && height >= 2 && z + 16 != session->WaterHeight)
         {
             // Full support
-            int32_t imageId = WoodenSupportImageIds[supportType].full | imageColourFlags;
             uint8_t ah = height == 2 ? 23 : 28;
-            PaintAddImageAsParent(session, imageId, { 0, 0, z }, { 32, 32, ah });
+            PaintAddImageAsParent(session, fullImageId, { 0, 0, z }, { 32, 32, ah });
             hasSupports = true;
             z += 32;
             height -= 2;
@@ -582,9 +585,8 @@ bool wooden_a_supports_paint_setup(
         else
         {
             // Half support
-            int32_t imageId = WoodenSupportImageIds[supportType].half | imageColourFlags;
             uint8_t ah = height == 1 ? 7 : 12;
-            PaintAddImageAsParent(session, imageId, { 0, 0, z }, { 32, 32, ah });
+            PaintAddImageAsParent(session, halfImageId, { 0, 0, z }, { 32, 32, ah });
             hasSupports = true;
             z += 16;
             height -= 1;
@@ -815,6 +817,33 @@ bool wooden_b_supports_paint_setup(
     return _9E32B1;
 }
 
+/**
+ * Paints the repeated beams of a metal support column from baseHeight up to topHeight. The column is made of full 16 unit
+ * beams, every fourth of which uses the sprite with a cross piece, topped by a single shorter beam for what is left over.
+ */
+static void PaintMetalSupportColumn(
+    paint_session* session, uint8_t supportType, const CoordsXY& offset, int32_t baseHeight, int32_t topHeight,
+    uint32_t imageColourFlags)
+{
+    const uint32_t beamImageId = _97B15C[supportType].beam_id;
+    const uint32_t fullBeamImageId = (beamImageId + 15) | imageColourFlags;
+    const uint32_t crossBeamImageId = (beamImageId + 16) | imageColourFlags;
+    const int32_t numFullBeams = std::max(0, (topHeight - baseHeight) / 16);
+    for (int32_t i = 0; i < numFullBeams; i++)
+    {
+        const uint32_t imageId = (i % 4 == 3) ? crossBeamImageId : fullBeamImageId;
+        PaintAddImageAsParent(session, imageId, { offset, baseHeight }, { 0, 0, 15 });
+        baseHeight += 16;
+    }
+
+    const int32_t beamLength = topHeight - baseHeight;
+    if (beamLength > 0)
+    {
+        PaintAddImageAsParent(
+            session, (beamImageId + (beamLength - 1)) | imageColourFlags, { offset, baseHeight }, { 0, 0, beamLength - 1 });
+    }
+}
+
 /**
  * Metal pole supports
  * @param supportType (edi)
@@ -936,35 +965,7 @@ bool metal_a_supports_paint_setup(
     height += heightDiff;
     // 6632e6
 
-    for (uint8_t count = 0;; count++)
-    {
-        if (count >= 4)
-            count = 0;
-
-        int16_t z = height + 16;
-        if (z > si)
-        {
-            z = si;
-        }
-
-        z -= height;
-        if (z <= 0)
-            break;
-
-        int8_t xOffset = SupportBoundBoxes[segment].x;
-        int8_t yOffset = SupportBoundBoxes[segment].y;
-
-        uint32_t image_id = _97B15C[supportType].beam_id;
-        image_id += z - 1;
-        image_id |= imageColourFlags;
-
-        if (count == 3 && z == 0x10)
-            image_id++;
-
-        PaintAddImageAsParent(session, image_id, { xOffset, yOffset, height }, { 0, 0, z - 1 });
-
-        height += z;
-    }
+    PaintMetalSupportColumn(session, supportType, SupportBoundBoxes[segment], height, si, imageColourFlags);
 
     supportSegments[segment].height = unk9E3294;
     supportSegments[segment].slope = 0x20;
@@ -1121,42 +1122,7 @@ bool metal_b_supports_paint_setup(
 
     baseHeight += heightDiff;
 
-    int16_t endHeight;
-
-    int32_t i = 1;
-    while (true)
-    {
-        endHeight = baseHeight + 16;
-        if (endHeight > si)
-        {
-            endHeight = si;
-        }
-
-        int16_t beamLength = endHeight - baseHeight;
-
-        if (beamLength <= 0)
-        {
-            break;
-        }
-
-        uint32_t imageId = _97B15C[supportType].beam_id + (beamLength - 1);
-
-        if (i % 4 == 0)
-        {
-            // Each fourth run, draw a special image
-            if (beamLength == 16)
-            {
-                imageId += 1;
-            }
-        }
-
-        PaintAddImageAsParent(
-            session, imageId | imageColourFlags, SupportBoundBoxes[segment].x, SupportBoundBoxes[segment].y, 0, 0,
-            beamLength - 1, baseHeight);
-
-        baseHeight += beamLength;
-        i++;
-    }
+    PaintMetalSupportColumn(session, supportType, SupportBoundBoxes[segment], baseHeight, si, imageColourFlags);
 
     supportSegments[segment].height = _9E3294;
     supportSegments[segment].slope = 0x20;
@@ -1167,7 +1133,7 @@ bool metal_b_supports_paint_setup(
         si = height + special;
         while (true)
         {
-            endHeight = baseHeight + 16;
+            int32_t endHeight = baseHeight + 16;
             if (endHeight > si)
             {
                 endHeight = si;
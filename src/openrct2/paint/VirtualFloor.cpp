@@ -24,6 +24,8 @@
 
 #include <algorithm>
 #include <limits>
+#include <optional>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -32,6 +34,33 @@ static uint16_t _virtualFloorHeight = 0;
 static CoordsXYZ _virtualFloorLastMinPos;
 static CoordsXYZ _virtualFloorLastMaxPos;
 static uint32_t _virtualFloorFlags = 0;
+static std::vector<MapRange> _virtualFloorLastSelection;
+
+struct VirtualFloorTileProperties
+{
+    bool Occupied{};
+    bool Owned{};
+    bool BelowGround{};
+    bool AboveGround{};
+    bool Lit{};
+    uint8_t OccupiedEdges{};
+};
+
+// The properties of the tiles around the selection, gathered before the viewports are painted so the floor of each tile
+// does not have to look through the elements of all its neighbours again. Paint only reads it.
+struct VirtualFloorTileCache
+{
+    bool Valid{};
+    uint32_t MapVersion{};
+    uint64_t TileChangeCount{};
+    int16_t FloorHeight{};
+    std::vector<MapRange> Selection;
+    TileCoordsXY Origin;
+    int32_t Width{};
+    int32_t Height{};
+    std::vector<VirtualFloorTileProperties> Tiles;
+};
+static VirtualFloorTileCache _virtualFloorTileCache;
 
 enum VirtualFloorFlags
 {
@@ -66,6 +95,8 @@ static void virtual_floor_reset()
     _virtualFloorLastMaxPos.x = std::numeric_limits<int32_t>::lowest();
     _virtualFloorLastMaxPos.y = std::numeric_limits<int32_t>::lowest();
     _virtualFloorHeight = 0;
+    _virtualFloorLastSelection.clear();
+    _virtualFloorTileCache = {};
 }
 
 void virtual_floor_enable()
@@ -96,28 +127,149 @@ void virtual_floor_disable()
     virtual_floor_reset();
 }
 
-void virtual_floor_invalidate()
+/**
+ * Gets the ranges of the map selection the virtual floor is drawn around, which are also the tiles that are lit.
+ */
+static std::vector<MapRange> virtual_floor_get_selection()
 {
-    // First, let's figure out how big our selection is.
-    CoordsXY min_position = { std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max() };
-    CoordsXY max_position = { std::numeric_limits<int32_t>::lowest(), std::numeric_limits<int32_t>::lowest() };
-
+    std::vector<MapRange> selection;
     if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE)
     {
-        min_position = gMapSelectPositionA;
-        max_position = gMapSelectPositionB;
+        selection.push_back(MapRange(gMapSelectPositionA, gMapSelectPositionB).Normalise());
     }
-
     if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT)
     {
         for (const auto& tile : gMapSelectionTiles)
         {
-            min_position.x = std::min(min_position.x, tile.x);
-            min_position.y = std::min(min_position.y, tile.y);
-            max_position.x = std::max(max_position.x, tile.x);
-            max_position.y = std::max(max_position.y, tile.y);
+            selection.emplace_back(tile, tile);
         }
     }
+    return selection;
+}
+
+static bool virtual_floor_selection_equals(const std::vector<MapRange>& a, const std::vector<MapRange>& b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const MapRange& lhs, const MapRange& rhs) {
+        return lhs.Point1 == rhs.Point1 && lhs.Point2 == rhs.Point2;
+    });
+}
+
+/**
+ * Gets the tiles covered by the floors of the given selection, with a border of one tile for the edges of the floor.
+ */
+static MapRange virtual_floor_get_tile_bounds(const std::vector<MapRange>& selection)
+{
+    const int32_t border = _virtualFloorBaseSize / COORDS_XY_STEP + 1;
+    int32_t left = std::numeric_limits<int32_t>::max();
+    int32_t top = std::numeric_limits<int32_t>::max();
+    int32_t right = std::numeric_limits<int32_t>::lowest();
+    int32_t bottom = std::numeric_limits<int32_t>::lowest();
+    for (const auto& range : selection)
+    {
+        left = std::min(left, range.GetLeft() / COORDS_XY_STEP - border);
+        top = std::min(top, range.GetTop() / COORDS_XY_STEP - border);
+        right = std::max(right, range.GetRight() / COORDS_XY_STEP + border);
+        bottom = std::max(bottom, range.GetBottom() / COORDS_XY_STEP + border);
+    }
+    return { left, top, right, bottom };
+}
+
+/**
+ * Invalidates only the tiles that look different after the floor has moved at the same height: the tiles that are only
+ * part of one of the two floors, and the tiles that are lit in only one of them along with their neighbours, whose
+ * edges change colour.
+ */
+static void virtual_floor_invalidate_changed_tiles(
+    const std::vector<MapRange>& oldSelection, const std::vector<MapRange>& newSelection)
+{
+    static constexpr uint8_t TILE_FLOOR = 1 << 0;
+    static constexpr uint8_t TILE_LIT = 1 << 1;
+
+    const auto oldBounds = virtual_floor_get_tile_bounds(oldSelection);
+    const auto newBounds = virtual_floor_get_tile_bounds(newSelection);
+    const int32_t left = std::min(oldBounds.GetLeft(), newBounds.GetLeft());
+    const int32_t top = std::min(oldBounds.GetTop(), newBounds.GetTop());
+    const int32_t right = std::max(oldBounds.GetRight(), newBounds.GetRight());
+    const int32_t bottom = std::max(oldBounds.GetBottom(), newBounds.GetBottom());
+    const int32_t width = right - left + 1;
+    const int32_t height = bottom - top + 1;
+
+    const int32_t floorSize = _virtualFloorBaseSize / COORDS_XY_STEP;
+    auto rasterise = [&](const std::vector<MapRange>& selection) {
+        std::vector<uint8_t> tiles(static_cast<size_t>(width) * height);
+        auto fill = [&](int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint8_t flag) {
+            for (int32_t y = y1; y <= y2; y++)
+            {
+                for (int32_t x = x1; x <= x2; x++)
+                {
+                    tiles[(y - top) * width + (x - left)] |= flag;
+                }
+            }
+        };
+        for (const auto& range : selection)
+        {
+            const int32_t x1 = range.GetLeft() / COORDS_XY_STEP;
+            const int32_t y1 = range.GetTop() / COORDS_XY_STEP;
+            const int32_t x2 = range.GetRight() / COORDS_XY_STEP;
+            const int32_t y2 = range.GetBottom() / COORDS_XY_STEP;
+            fill(x1 - floorSize, y1 - floorSize, x2 + floorSize, y2 + floorSize, TILE_FLOOR);
+            fill(x1, y1, x2, y2, TILE_LIT);
+        }
+        return tiles;
+    };
+    const auto oldTiles = rasterise(oldSelection);
+    const auto newTiles = rasterise(newSelection);
+
+    auto getChange = [&](int32_t x, int32_t y) -> uint8_t {
+        if (x < left || x > right || y < top || y > bottom)
+            return 0;
+        const auto index = (y - top) * width + (x - left);
+        return oldTiles[index] ^ newTiles[index];
+    };
+
+    // Consecutive changed tiles along each row are invalidated together.
+    for (int32_t y = top; y <= bottom; y++)
+    {
+        std::optional<int32_t> runStart;
+        for (int32_t x = left; x <= right + 1; x++)
+        {
+            bool changed = false;
+            if (x <= right)
+            {
+                const auto isFloor = (newTiles[(y - top) * width + (x - left)] & TILE_FLOOR) != 0;
+                const auto neighbourChanges = getChange(x - 1, y) | getChange(x + 1, y) | getChange(x, y - 1)
+                    | getChange(x, y + 1);
+                changed = getChange(x, y) != 0 || (isFloor && (neighbourChanges & TILE_LIT) != 0);
+            }
+
+            if (changed && !runStart)
+            {
+                runStart = x;
+            }
+            else if (!changed && runStart)
+            {
+                map_invalidate_region(
+                    { *runStart * COORDS_XY_STEP, y * COORDS_XY_STEP }, { (x - 1) * COORDS_XY_STEP, y * COORDS_XY_STEP });
+                runStart = std::nullopt;
+            }
+        }
+    }
+}
+
+void virtual_floor_invalidate()
+{
+    // First, let's figure out how big our selection is.
+    CoordsXY min_position = { std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max() };
+    CoordsXY max_position = { std::numeric_limits<int32_t>::lowest(), std::numeric_limits<int32_t>::lowest() };
+
+    auto selection = virtual_floor_get_selection();
+    for (const auto& range : selection)
+    {
+        min_position.x = std::min(min_position.x, range.GetLeft());
+        min_position.y = std::min(min_position.y, range.GetTop());
+        max_position.x = std::max(max_position.x, range.GetRight());
+        max_position.y = std::max(max_position.y, range.GetBottom());
+    }
 
     // Apply the virtual floor size to the computed invalidation area.
     min_position.x -= _virtualFloorBaseSize + 16;
@@ -125,11 +277,31 @@ void virtual_floor_invalidate()
     max_position.x += _virtualFloorBaseSize + 16;
     max_position.y += _virtualFloorBaseSize + 16;
 
-    // Invalidate previous region if appropriate.
-    if (_virtualFloorLastMinPos.x != std::numeric_limits<int32_t>::max()
+    const bool hasPreviousRegion = _virtualFloorLastMinPos.x != std::numeric_limits<int32_t>::max()
         && _virtualFloorLastMinPos.y != std::numeric_limits<int32_t>::max()
         && _virtualFloorLastMaxPos.x != std::numeric_limits<int32_t>::lowest()
-        && _virtualFloorLastMaxPos.y != std::numeric_limits<int32_t>::lowest())
+        && _virtualFloorLastMaxPos.y != std::numeric_limits<int32_t>::lowest();
+
+    // When the floor only moves, most of it is painted the same as before.
+    if (hasPreviousRegion && (_virtualFloorFlags & VIRTUAL_FLOOR_FLAG_ENABLED) != 0
+        && (_virtualFloorFlags & VIRTUAL_FLOOR_FORCE_INVALIDATION) == 0 && _virtualFloorLastMinPos.z == _virtualFloorHeight
+        && !selection.empty() && !_virtualFloorLastSelection.empty())
+    {
+        if (!virtual_floor_selection_equals(selection, _virtualFloorLastSelection))
+        {
+            virtual_floor_invalidate_changed_tiles(_virtualFloorLastSelection, selection);
+
+            _virtualFloorLastMinPos.x = min_position.x;
+            _virtualFloorLastMinPos.y = min_position.y;
+            _virtualFloorLastMaxPos.x = max_position.x;
+            _virtualFloorLastMaxPos.y = max_position.y;
+            _virtualFloorLastSelection = std::move(selection);
+        }
+        return;
+    }
+
+    // Invalidate previous region if appropriate.
+    if (hasPreviousRegion)
     {
         if (_virtualFloorLastMinPos != min_position || _virtualFloorLastMaxPos != max_position
             || (_virtualFloorFlags & VIRTUAL_FLOOR_FORCE_INVALIDATION) != 0)
@@ -168,6 +340,7 @@ void virtual_floor_invalidate()
         _virtualFloorLastMaxPos.x = max_position.x;
         _virtualFloorLastMaxPos.y = max_position.y;
         _virtualFloorLastMaxPos.z = _virtualFloorHeight;
+        _virtualFloorLastSelection = std::move(selection);
     }
 }
 
@@ -202,23 +375,16 @@ bool virtual_floor_tile_is_floor(const CoordsXY& loc)
     return false;
 }
 
-static void virtual_floor_get_tile_properties(
-    const CoordsXY& loc, int16_t height, bool* outOccupied, bool* tileOwned, uint8_t* outOccupiedEdges, bool* outBelowGround,
-    bool* aboveGround, bool* outLit)
+static VirtualFloorTileProperties virtual_floor_get_tile_properties(const CoordsXY& loc, int16_t height)
 {
-    *outOccupied = false;
-    *outOccupiedEdges = 0;
-    *outBelowGround = false;
-    *outLit = false;
-    *aboveGround = false;
-    *tileOwned = false;
+    VirtualFloorTileProperties properties;
 
     // See if we are a selected tile
     if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE))
     {
         if (loc >= gMapSelectPositionA && loc <= gMapSelectPositionB)
         {
-            *outLit = true;
+            properties.Lit = true;
         }
     }
 
@@ -229,16 +395,16 @@ static void virtual_floor_get_tile_properties(
         {
             if (tile == loc)
             {
-                *outLit = true;
+                properties.Lit = true;
                 break;
             }
         }
     }
 
-    *tileOwned = map_is_location_owned({ loc, height });
+    properties.Owned = map_is_location_owned({ loc, height });
 
     if (gCheatsSandboxMode)
-        *tileOwned = true;
+        properties.Owned = true;
 
     // Iterate through the map elements of the current tile to find:
     //  * Surfaces, which may put us underground
@@ -252,16 +418,16 @@ static void virtual_floor_get_tile_properties(
         {
             if (height < tileElement->GetClearanceZ())
             {
-                *outBelowGround = true;
+                properties.BelowGround = true;
             }
             else if (height < (tileElement->GetBaseZ() + LAND_HEIGHT_STEP) && tileElement->AsSurface()->GetSlope() != 0)
             {
-                *outBelowGround = true;
-                *outOccupied = true;
+                properties.BelowGround = true;
+                properties.Occupied = true;
             }
             if (height > tileElement->GetBaseZ())
             {
-                *aboveGround = true;
+                properties.AboveGround = true;
             }
             continue;
         }
@@ -274,18 +440,82 @@ static void virtual_floor_get_tile_properties(
         if (elementType == TILE_ELEMENT_TYPE_WALL || elementType == TILE_ELEMENT_TYPE_BANNER)
         {
             int32_t direction = tileElement->GetDirection();
-            *outOccupiedEdges |= 1 << direction;
+            properties.OccupiedEdges |= 1 << direction;
             continue;
         }
 
         if (tileElement->IsGhost())
         {
-            *outLit = true;
+            properties.Lit = true;
             continue;
         }
 
-        *outOccupied = true;
+        properties.Occupied = true;
     }
+    return properties;
+}
+
+void virtual_floor_update_tile_cache()
+{
+    auto& cache = _virtualFloorTileCache;
+    if (!virtual_floor_is_enabled() || gConfigGeneral.virtual_floor_style == VirtualFloorStyles::Off
+        || _virtualFloorHeight < MINIMUM_LAND_HEIGHT)
+    {
+        cache.Valid = false;
+        return;
+    }
+
+    auto selection = virtual_floor_get_selection();
+    if (selection.empty())
+    {
+        cache.Valid = false;
+        return;
+    }
+
+    const auto mapVersion = map_get_version();
+    const auto tileChangeCount = map_get_tile_change_count();
+    if (cache.Valid && cache.MapVersion == mapVersion && cache.TileChangeCount == tileChangeCount
+        && cache.FloorHeight == _virtualFloorHeight && virtual_floor_selection_equals(cache.Selection, selection))
+    {
+        return;
+    }
+
+    const auto bounds = virtual_floor_get_tile_bounds(selection);
+    cache.Origin = { bounds.GetLeft(), bounds.GetTop() };
+    cache.Width = bounds.GetRight() - bounds.GetLeft() + 1;
+    cache.Height = bounds.GetBottom() - bounds.GetTop() + 1;
+    cache.Tiles.resize(static_cast<size_t>(cache.Width) * cache.Height);
+    for (int32_t y = 0; y < cache.Height; y++)
+    {
+        for (int32_t x = 0; x < cache.Width; x++)
+        {
+            const auto loc = TileCoordsXY{ cache.Origin.x + x, cache.Origin.y + y }.ToCoordsXY();
+            cache.Tiles[y * cache.Width + x] = virtual_floor_get_tile_properties(loc, _virtualFloorHeight);
+        }
+    }
+
+    cache.Valid = true;
+    cache.MapVersion = mapVersion;
+    cache.TileChangeCount = tileChangeCount;
+    cache.FloorHeight = _virtualFloorHeight;
+    cache.Selection = std::move(selection);
+}
+
+static VirtualFloorTileProperties virtual_floor_get_cached_tile_properties(const CoordsXY& loc, int16_t height)
+{
+    // Anything painted without the cache being updated first, or after the map has changed, is looked up directly.
+    const auto& cache = _virtualFloorTileCache;
+    if (cache.Valid && cache.FloorHeight == height && cache.MapVersion == map_get_version()
+        && cache.TileChangeCount == map_get_tile_change_count())
+    {
+        const int32_t x = loc.x / COORDS_XY_STEP - cache.Origin.x;
+        const int32_t y = loc.y / COORDS_XY_STEP - cache.Origin.y;
+        if (x >= 0 && y >= 0 && x < cache.Width && y < cache.Height)
+        {
+            return cache.Tiles[y * cache.Width + x];
+        }
+    }
+    return virtual_floor_get_tile_properties(loc, height);
 }
 
 void virtual_floor_paint(paint_session* session)
@@ -308,18 +538,13 @@ void virtual_floor_paint(paint_session* session)
     int16_t virtualFloorClipHeight = _virtualFloorHeight;
 
     // Check for occupation and walls
-    bool weAreOccupied;
-    uint8_t occupiedEdges;
-    bool weAreBelowGround;
-    bool weAreLit;
-    bool weAreOwned;
-    bool weAreAboveGround;
+    const auto ours = virtual_floor_get_cached_tile_properties(session->MapPosition, virtualFloorClipHeight);
+    const bool weAreOccupied = ours.Occupied;
+    const bool weAreLit = ours.Lit;
+    const bool weAreOwned = ours.Owned;
+    uint8_t occupiedEdges = ours.OccupiedEdges;
     uint8_t litEdges = 0;
 
-    virtual_floor_get_tile_properties(
-        session->MapPosition, virtualFloorClipHeight, &weAreOccupied, &weAreOwned, &occupiedEdges, &weAreBelowGround,
-        &weAreAboveGround, &weAreLit);
-
     // Move the bits around to match the current rotation
     occupiedEdges |= occupiedEdges << 4;
     occupiedEdges >>= (4 - direction);
@@ -332,26 +557,17 @@ void virtual_floor_paint(paint_session* session)
         uint8_t effectiveRotation = (NumOrthogonalDirections + i - direction) % NumOrthogonalDirections;
         CoordsXY theirLocation = session->MapPosition + scenery_half_tile_offsets[effectiveRotation];
 
-        bool theyAreOccupied;
-        uint8_t theirOccupiedEdges;
-        bool theyAreBelowGround;
-        bool theyAreLit;
-        bool theyAreOwned;
-        bool theyAreAboveGround;
-
-        virtual_floor_get_tile_properties(
-            theirLocation, virtualFloorClipHeight, &theyAreOccupied, &theyAreOwned, &theirOccupiedEdges, &theyAreBelowGround,
-            &theyAreAboveGround, &theyAreLit);
+        const auto theirs = virtual_floor_get_cached_tile_properties(theirLocation, virtualFloorClipHeight);
 
-        if (theirOccupiedEdges & (1 << ((effectiveRotation + 2) % NumOrthogonalDirections)) && (weAreOwned && !theyAreOwned))
+        if (theirs.OccupiedEdges & (1 << ((effectiveRotation + 2) % NumOrthogonalDirections)) && (weAreOwned && !theirs.Owned))
         {
             occupiedEdges |= 1 << i;
         }
-        if (weAreLit != theyAreLit || (weAreOwned && !theyAreOwned))
+        if (weAreLit != theirs.Lit || (weAreOwned && !theirs.Owned))
         {
             litEdges |= 1 << i;
         }
-        else if ((weAreOccupied != theyAreOccupied || weAreBelowGround != theyAreBelowGround) && weAreOwned)
+        else if ((weAreOccupied != theirs.Occupied || ours.BelowGround != theirs.BelowGround) && weAreOwned)
         {
             occupiedEdges |= 1 << i;
         }
@@ -403,7 +619,7 @@ void virtual_floor_paint(paint_session* session)
     if (gConfigGeneral.virtual_floor_style != VirtualFloorStyles::Glassy)
         return;
 
-    if (!weAreOccupied && !weAreLit && weAreAboveGround && weAreOwned)
+    if (!weAreOccupied && !weAreLit && ours.AboveGround && weAreOwned)
     {
         int32_t imageColourFlats = SPR_G2_SURFACE_GLASSY_RECOLOURABLE | IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT
             | EnumValue(FilterPaletteID::PaletteWater) << 19;
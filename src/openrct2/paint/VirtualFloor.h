@@ -33,4 +33,9 @@ void virtual_floor_invalidate();
 
 bool virtual_floor_tile_is_floor(const CoordsXY& loc);
 
+/**
+ * Gathers what the floor needs to know about the tiles around the selection, if the map, selection or floor height has
+ * changed since. Must be called before the viewports are painted, not while.
+ */
+void virtual_floor_update_tile_cache();
 void virtual_floor_paint(paint_session* session);
@@ -81,28 +81,25 @@ template<> void PaintEntity(paint_session* session, const Peep* peep, int32_t im
     uint32_t imageId = baseImageId | peep->TshirtColour << 19 | peep->TrousersColour << 24 | IMAGE_TYPE_REMAP
         | IMAGE_TYPE_REMAP_2_PLUS;
     PaintAddImageAsParent(session, imageId, 0, 0, 1, 1, 11, peep->z, 0, 0, peep->z + 5);
+
+    // Only the sprites of guests holding a hat, balloon or umbrella have an item drawn on top of them.
+    if (baseImageId < 10717 || baseImageId >= 11229)
+        return;
+
     auto* guest = peep->As<Guest>();
-    if (guest != nullptr)
-    {
-        if (baseImageId >= 10717 && baseImageId < 10749)
-        {
-            imageId = (baseImageId + 32) | guest->HatColour << 19 | IMAGE_TYPE_REMAP;
-            PaintAddImageAsChild(session, imageId, { 0, 0, peep->z }, { 1, 1, 11 }, { 0, 0, peep->z + 5 });
-            return;
-        }
+    if (guest == nullptr)
+        return;
 
-        if (baseImageId >= 10781 && baseImageId < 10813)
-        {
-            imageId = (baseImageId + 32) | guest->BalloonColour << 19 | IMAGE_TYPE_REMAP;
-            PaintAddImageAsChild(session, imageId, { 0, 0, peep->z }, { 1, 1, 11 }, { 0, 0, peep->z + 5 });
-            return;
-        }
+    uint8_t itemColour;
+    if (baseImageId < 10749)
+        itemColour = guest->HatColour;
+    else if (baseImageId >= 10781 && baseImageId < 10813)
+        itemColour = guest->BalloonColour;
+    else if (baseImageId >= 11197)
+        itemColour = guest->UmbrellaColour;
+    else
+        return;
 
-        if (baseImageId >= 11197 && baseImageId < 11229)
-        {
-            imageId = (baseImageId + 32) | guest->UmbrellaColour << 19 | IMAGE_TYPE_REMAP;
-            PaintAddImageAsChild(session, imageId, { 0, 0, peep->z }, { 1, 1, 11 }, { 0, 0, peep->z + 5 });
-            return;
-        }
-    }
+    imageId = (baseImageId + 32) | itemColour << 19 | IMAGE_TYPE_REMAP;
+    PaintAddImageAsChild(session, imageId, { 0, 0, peep->z }, { 1, 1, 11 }, { 0, 0, peep->z + 5 });
 }
@@ -434,7 +434,7 @@ static uint8_t viewport_surface_paint_setup_get_relative_slope(const TileElement
  *  rct2: 0x0065E890, 0x0065E946, 0x0065E9FC, 0x0065EAB2
  */
 static void viewport_surface_smoothen_edge(
-    paint_session* session, enum edge_t edge, struct tile_descriptor self, struct tile_descriptor neighbour)
+    paint_session* session, enum edge_t edge, const tile_descriptor& self, const tile_descriptor& neighbour)
 {
     if (neighbour.tile_element == nullptr)
         return;
@@ -552,8 +552,8 @@ static bool tile_is_inside_clip_view(const tile_descriptor& tile)
 }
 
 static void viewport_surface_draw_tile_side_bottom(
-    paint_session* session, enum edge_t edge, uint16_t height, uint8_t edgeStyle, struct tile_descriptor self,
-    struct tile_descriptor neighbour, bool isWater)
+    paint_session* session, enum edge_t edge, uint16_t height, uint8_t edgeStyle, const tile_descriptor& self,
+    const tile_descriptor& neighbour, bool isWater)
 {
     // From big Z to tiny Z
     height /= COORDS_Z_PER_TINY_Z;
@@ -752,8 +752,8 @@ static void viewport_surface_draw_tile_side_bottom(
  *  rct2: 0x0065EB7D, 0x0065F0D8
  */
 static void viewport_surface_draw_land_side_bottom(
-    paint_session* session, enum edge_t edge, uint16_t height, uint8_t edgeStyle, struct tile_descriptor self,
-    struct tile_descriptor neighbour)
+    paint_session* session, enum edge_t edge, uint16_t height, uint8_t edgeStyle, const tile_descriptor& self,
+    const tile_descriptor& neighbour)
 {
     viewport_surface_draw_tile_side_bottom(session, edge, height, edgeStyle, self, neighbour, false);
 }
@@ -762,15 +762,15 @@ static void viewport_surface_draw_land_side_bottom(
  *  rct2: 0x0065F8B9, 0x0065FE26
  */
 static void viewport_surface_draw_water_side_bottom(
-    paint_session* session, enum edge_t edge, uint16_t height, uint8_t edgeStyle, struct tile_descriptor self,
-    struct tile_descriptor neighbour)
+    paint_session* session, enum edge_t edge, uint16_t height, uint8_t edgeStyle, const tile_descriptor& self,
+    const tile_descriptor& neighbour)
 {
     viewport_surface_draw_tile_side_bottom(session, edge, height, edgeStyle, self, neighbour, true);
 }
 
 static void viewport_surface_draw_tile_side_top(
-    paint_session* session, enum edge_t edge, uint16_t height, uint8_t terrain, struct tile_descriptor self,
-    struct tile_descriptor neighbour, bool isWater)
+    paint_session* session, enum edge_t edge, uint16_t height, uint8_t terrain, const tile_descriptor& self,
+    const tile_descriptor& neighbour, bool isWater)
 {
     // From big Z to tiny Z
     height /= COORDS_Z_PER_TINY_Z;
@@ -913,8 +913,8 @@ static void viewport_surface_draw_tile_side_top(
  *  rct2: 0x0065F63B, 0x0065F77D
  */
 static void viewport_surface_draw_land_side_top(
-    paint_session* session, enum edge_t edge, uint16_t height, uint8_t terrain, struct tile_descriptor self,
-    struct tile_descriptor neighbour)
+    paint_session* session, enum edge_t edge, uint16_t height, uint8_t terrain, const tile_descriptor& self,
+    const tile_descriptor& neighbour)
 {
     viewport_surface_draw_tile_side_top(session, edge, height, terrain, self, neighbour, false);
 }
@@ -923,8 +923,8 @@ static void viewport_surface_draw_land_side_top(
  *  rct2: 0x0066039B, 0x006604F1
  */
 static void viewport_surface_draw_water_side_top(
-    paint_session* session, enum edge_t edge, uint16_t height, uint8_t terrain, struct tile_descriptor self,
-    struct tile_descriptor neighbour)
+    paint_session* session, enum edge_t edge, uint16_t height, uint8_t terrain, const tile_descriptor& self,
+    const tile_descriptor& neighbour)
 {
     viewport_surface_draw_tile_side_top(session, edge, height, terrain, self, neighbour, true);
 }
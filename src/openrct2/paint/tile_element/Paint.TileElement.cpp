@@ -25,11 +25,13 @@
 #include "../../world/Scenery.h"
 #include "../../world/Surface.h"
 #include "../Paint.h"
+#include "../PaintTileCache.h"
 #include "../Supports.h"
 #include "../VirtualFloor.h"
 #include "Paint.Surface.h"
 
 #include <algorithm>
+#include <limits>
 
 #ifdef __TESTPAINT__
 uint16_t testPaintVerticalTunnelHeight;
@@ -54,6 +56,21 @@ void tile_element_paint_setup(paint_session* session, const CoordsXY& mapCoords,
         session->Unk141E9DB = isTrackPiecePreview ? PaintSessionFlags::IsTrackPiecePreview : 0;
         session->WaterHeight = 0xFFFF;
 
+#ifndef __TESTPAINT__
+        auto* tileCache = session->TileCache;
+        if (tileCache != nullptr && !isTrackPiecePreview)
+        {
+            if (tileCache->Replay(session, mapCoords))
+            {
+                return;
+            }
+            tileCache->BeginRecord(session, mapCoords);
+            sub_68B3FB(session, mapCoords.x, mapCoords.y);
+            tileCache->EndRecord(session);
+            return;
+        }
+#endif // __TESTPAINT__
+
         sub_68B3FB(session, mapCoords.x, mapCoords.y);
     }
     else if (!(session->ViewFlags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND))
@@ -220,10 +237,12 @@ static void sub_68B3FB(paint_session* session, int32_t x, int32_t y)
     session->SpritePosition.y = y;
     session->DidPassSurface = false;
     int32_t previousBaseZ = 0;
+    const int32_t maxBaseZ = (session->ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) ? gClipHeight * COORDS_Z_STEP
+                                                                            : std::numeric_limits<int32_t>::max();
     do
     {
         // Only paint tile_elements below the clip height.
-        if ((session->ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) && (tile_element->GetBaseZ() > gClipHeight * COORDS_Z_STEP))
+        if (tile_element->GetBaseZ() > maxBaseZ)
             continue;
 
         Direction direction = tile_element->GetDirectionWithOffset(rotation);
@@ -266,6 +285,12 @@ static void sub_68B3FB(paint_session* session, int32_t x, int32_t y)
 
         CoordsXY mapPosition = session->MapPosition;
         session->CurrentlyDrawnItem = tile_element;
+#ifndef __TESTPAINT__
+        if (session->TileCache != nullptr)
+        {
+            session->TileCache->OnPaintElement();
+        }
+#endif // __TESTPAINT__
         // Setup the painting of for example: the underground, signs, rides, scenery, etc.
         switch (tile_element->GetType())
         {
@@ -48,6 +48,7 @@
 #include "Staff.h"
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <iterator>
 
@@ -408,6 +409,8 @@ static constexpr const ride_rating NauseaMinimumThresholds[] = {
 };
 // clang-format on
 
+static std::array<GuestColdData, MAX_ENTITIES> _guestColdData;
+
 static bool peep_has_voucher_for_free_ride(Guest* peep, Ride* ride);
 static void peep_ride_is_too_intense(Guest* peep, Ride* ride, bool peepAtRide);
 static void peep_reset_ride_heading(Guest* peep);
@@ -762,6 +765,16 @@ void Guest::loc_68F9F3()
     }
 }
 
+/**
+ * Moves a stat towards its target by at most step, without going past the target.
+ */
+static uint8_t peep_ease_stat_towards(uint8_t value, uint8_t target, uint8_t step)
+{
+    if (value >= target)
+        return static_cast<uint8_t>(std::max(value - step, static_cast<int32_t>(target)));
+    return static_cast<uint8_t>(std::min(value + step, static_cast<int32_t>(target)));
+}
+
 void Guest::loc_68FA89()
 {
     // 68FA89
@@ -832,44 +845,11 @@ void Guest::loc_68FA89()
         WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_2;
     }
 
-    uint8_t newHappiness = Happiness;
-    uint8_t newHappinessGrowth = HappinessTarget;
-    if (newHappiness >= newHappinessGrowth)
-    {
-        newHappiness = std::max(newHappiness - 4, 0);
-        if (newHappiness < newHappinessGrowth)
-            newHappiness = newHappinessGrowth;
-    }
-    else
-    {
-        newHappiness = std::min(255, newHappiness + 4);
-        if (newHappiness > newHappinessGrowth)
-            newHappiness = newHappinessGrowth;
-    }
-
-    if (newHappiness != Happiness)
+    const uint8_t newHappiness = peep_ease_stat_towards(Happiness, HappinessTarget, 4);
+    const uint8_t newNausea = peep_ease_stat_towards(Nausea, NauseaTarget, 4);
+    if (newHappiness != Happiness || newNausea != Nausea)
     {
         Happiness = newHappiness;
-        WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_2;
-    }
-
-    uint8_t newNausea = Nausea;
-    uint8_t newNauseaGrowth = NauseaTarget;
-    if (newNausea >= newNauseaGrowth)
-    {
-        newNausea = std::max(newNausea - 4, 0);
-        if (newNausea < newNauseaGrowth)
-            newNausea = newNauseaGrowth;
-    }
-    else
-    {
-        newNausea = std::min(255, newNausea + 4);
-        if (newNausea > newNauseaGrowth)
-            newNausea = newNauseaGrowth;
-    }
-
-    if (newNausea != Nausea)
-    {
         Nausea = newNausea;
         WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_2;
     }
@@ -1838,6 +1818,52 @@ Ride* Guest::FindBestRideToGoOn()
     return mostExcitingRide;
 }
 
+struct NearbyRidesCacheEntry
+{
+    bool IsValid{};
+    uint32_t MapVersion{};
+    CoordsXY Centre;
+    std::bitset<MAX_RIDES> Rides;
+};
+
+// The rides near a tile only change when the map does, so guests walking around the same area share the result.
+static std::array<NearbyRidesCacheEntry, 1024> _nearbyRidesCache;
+
+/**
+ * Gets the rides with track within 10 tiles of the given tile.
+ */
+static const std::bitset<MAX_RIDES>& guest_get_nearby_rides(const CoordsXY& centre)
+{
+    const auto tileCentre = TileCoordsXY{ centre };
+    auto& entry = _nearbyRidesCache[(tileCentre.x & 31) | ((tileCentre.y & 31) << 5)];
+    const auto mapVersion = map_get_version();
+    if (entry.IsValid && entry.MapVersion == mapVersion && entry.Centre == centre)
+        return entry.Rides;
+
+    entry.IsValid = true;
+    entry.MapVersion = mapVersion;
+    entry.Centre = centre;
+    entry.Rides.reset();
+
+    constexpr auto radius = 10 * 32;
+    for (int32_t tileX = centre.x - radius; tileX <= centre.x + radius; tileX += COORDS_XY_STEP)
+    {
+        for (int32_t tileY = centre.y - radius; tileY <= centre.y + radius; tileY += COORDS_XY_STEP)
+        {
+            auto location = CoordsXY{ tileX, tileY };
+            if (!map_is_location_valid(location))
+                continue;
+
+            for (auto* trackElement : TileElementsView<TrackElement>(location))
+            {
+                auto rideIndex = trackElement->GetRideIndex();
+                entry.Rides[rideIndex] = true;
+            }
+        }
+    }
+    return entry.Rides;
+}
+
 std::bitset<MAX_RIDES> Guest::FindRidesToGoOn()
 {
     std::bitset<MAX_RIDES> rideConsideration;
@@ -1859,24 +1885,7 @@ std::bitset<MAX_RIDES> Guest::FindRidesToGoOn()
     else
     {
         // Take nearby rides into consideration
-        constexpr auto radius = 10 * 32;
-        int32_t cx = floor2(x, 32);
-        int32_t cy = floor2(y, 32);
-        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
-        {
-            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
-            {
-                auto location = CoordsXY{ tileX, tileY };
-                if (!map_is_location_valid(location))
-                    continue;
-
-                for (auto* trackElement : TileElementsView<TrackElement>(location))
-                {
-                    auto rideIndex = trackElement->GetRideIndex();
-                    rideConsideration[rideIndex] = true;
-                }
-            }
-        }
+        rideConsideration = guest_get_nearby_rides(CoordsXY{ x, y }.ToTileStart());
 
         // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
         for (auto& ride : GetRideManager())
@@ -2296,27 +2305,27 @@ void Guest::SpendMoney(money16& peep_expend_type, money32 amount, ExpenditureTyp
 
 void Guest::SetHasRidden(const Ride* ride)
 {
-    RidesBeenOn[ride->id / 8] |= 1 << (ride->id % 8);
+    GetRidesBeenOn()[ride->id / 8] |= 1 << (ride->id % 8);
     SetHasRiddenRideType(ride->type);
 }
 
 bool Guest::HasRidden(const Ride* ride) const
 {
-    return RidesBeenOn[ride->id / 8] & (1 << (ride->id % 8));
+    return GetRidesBeenOn()[ride->id / 8] & (1 << (ride->id % 8));
 }
 
 void Guest::SetHasRiddenRideType(int32_t rideType)
 {
     // This is needed to avoid desyncs. TODO: remove once the new save format is introduced.
     rideType = OpenRCT2RideTypeToRCT2RideType(rideType);
-    RideTypesBeenOn[rideType / 8] |= 1 << (rideType % 8);
+    GetRideTypesBeenOn()[rideType / 8] |= 1 << (rideType % 8);
 }
 
 bool Guest::HasRiddenRideType(int32_t rideType) const
 {
     // This is needed to avoid desyncs. TODO: remove once the new save format is introduced.
     rideType = OpenRCT2RideTypeToRCT2RideType(rideType);
-    return RideTypesBeenOn[rideType / 8] & (1 << (rideType % 8));
+    return GetRideTypesBeenOn()[rideType / 8] & (1 << (rideType % 8));
 }
 
 void Guest::SetParkEntryTime(int32_t entryTime)
@@ -2950,14 +2959,9 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
         }
     }
 
-    for (auto litter : EntityList<Litter>())
+    for ([[maybe_unused]] auto litter : EntityRangeList<Litter>({ centre_x, centre_y }, 160))
     {
-        int16_t dist_x = abs(litter->x - centre_x);
-        int16_t dist_y = abs(litter->y - centre_y);
-        if (std::max(dist_x, dist_y) <= 160)
-        {
-            num_rubbish++;
-        }
+        num_rubbish++;
     }
 
     if (num_fountains >= 5 && num_rubbish < 20)
@@ -3226,9 +3230,10 @@ void Guest::StopPurchaseThought(uint8_t ride_type)
     }
 
     // Remove the related thought
+    auto& thoughts = GetThoughts();
     for (int32_t i = 0; i < PEEP_MAX_THOUGHTS; ++i)
     {
-        rct_peep_thought* thought = &Thoughts[i];
+        rct_peep_thought* thought = &thoughts[i];
 
         if (thought->type == PeepThoughtType::None)
             break;
@@ -3241,7 +3246,7 @@ void Guest::StopPurchaseThought(uint8_t ride_type)
             memmove(thought, thought + 1, sizeof(rct_peep_thought) * (PEEP_MAX_THOUGHTS - i - 1));
         }
 
-        Thoughts[PEEP_MAX_THOUGHTS - 1].type = PeepThoughtType::None;
+        thoughts[PEEP_MAX_THOUGHTS - 1].type = PeepThoughtType::None;
 
         WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
         i--;
@@ -6098,18 +6103,9 @@ static void peep_update_walking_break_scenery(Guest* peep)
         return;
     }
 
-    for (auto inner_peep : EntityList<Staff>())
+    for (auto inner_peep : EntityRangeList<Staff>({ peep->x, peep->y }, 223))
     {
-        if (inner_peep->AssignedStaffType != StaffType::Security)
-            continue;
-
-        if (inner_peep->x == LOCATION_NULL)
-            continue;
-
-        int32_t x_diff = abs(inner_peep->x - peep->x);
-        int32_t y_diff = abs(inner_peep->y - peep->y);
-
-        if (std::max(x_diff, y_diff) < 224)
+        if (inner_peep->AssignedStaffType == StaffType::Security)
         {
             inner_peep->StaffVandalsStopped++;
             return;
@@ -6815,9 +6811,10 @@ void Guest::InsertNewThought(PeepThoughtType thoughtType, uint8_t thoughtArgumen
         UpdateCurrentActionSpriteType();
     }
 
+    auto& thoughts = GetThoughts();
     for (int32_t i = 0; i < PEEP_MAX_THOUGHTS; ++i)
     {
-        rct_peep_thought* thought = &Thoughts[i];
+        rct_peep_thought* thought = &thoughts[i];
         // Remove the oldest thought by setting it to NONE.
         if (thought->type == PeepThoughtType::None)
             break;
@@ -6835,12 +6832,12 @@ void Guest::InsertNewThought(PeepThoughtType thoughtType, uint8_t thoughtArgumen
         }
     }
 
-    memmove(&Thoughts[1], &Thoughts[0], sizeof(rct_peep_thought) * (PEEP_MAX_THOUGHTS - 1));
+    memmove(&thoughts[1], &thoughts[0], sizeof(rct_peep_thought) * (PEEP_MAX_THOUGHTS - 1));
 
-    Thoughts[0].type = thoughtType;
-    Thoughts[0].item = thoughtArguments;
-    Thoughts[0].freshness = 0;
-    Thoughts[0].fresh_timeout = 0;
+    thoughts[0].type = thoughtType;
+    thoughts[0].item = thoughtArguments;
+    thoughts[0].freshness = 0;
+    thoughts[0].fresh_timeout = 0;
 
     WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
 }
@@ -6954,7 +6951,7 @@ Guest* Guest::Generate(const CoordsXYZ& coords)
     peep->PathCheckOptimisation = 0;
     peep->InteractionRideIndex = RIDE_ID_NULL;
     peep->PreviousRide = RIDE_ID_NULL;
-    peep->Thoughts[0].type = PeepThoughtType::None;
+    peep->GetThoughts()[0].type = PeepThoughtType::None;
     peep->WindowInvalidateFlags = 0;
 
     uint8_t intensityHighest = (scenario_rand() & 0x7) + 3;
@@ -7030,10 +7027,10 @@ Guest* Guest::Generate(const CoordsXYZ& coords)
 
     peep->Toilet = 0;
     peep->TimeToConsume = 0;
-    std::fill_n(peep->RidesBeenOn, 32, 0x00);
+    peep->GetRidesBeenOn().fill(0x00);
 
     peep->GuestNumRides = 0;
-    std::fill_n(peep->RideTypesBeenOn, 16, 0x00);
+    peep->GetRideTypesBeenOn().fill(0x00);
     peep->Id = gNextGuestNumber++;
     peep->Name = nullptr;
 
@@ -7287,6 +7284,73 @@ bool Guest::UpdateQueuePosition(PeepActionType previous_action)
     return true;
 }
 
+struct QueueGuestsBehind
+{
+    bool IsValid{};
+    uint32_t MapVersion{};
+    std::vector<uint16_t> Guests;
+};
+
+// The queues only link each guest to the guest in front of them, this remembers the guest behind each guest so that
+// leaving the queue does not have to walk it from the back. It is rebuilt from the queues when the map changes.
+static QueueGuestsBehind _queueGuestsBehind;
+
+static bool guest_queue_is_guest_behind_valid()
+{
+    return _queueGuestsBehind.IsValid && _queueGuestsBehind.MapVersion == map_get_version();
+}
+
+static void guest_queue_rebuild_guests_behind()
+{
+    _queueGuestsBehind.IsValid = true;
+    _queueGuestsBehind.MapVersion = map_get_version();
+    _queueGuestsBehind.Guests.assign(MAX_ENTITIES, SPRITE_INDEX_NULL);
+    for (const auto& ride : GetRideManager())
+    {
+        for (const auto& station : ride.stations)
+        {
+            // The walk is limited, should the queue loop back on itself.
+            size_t numGuests = 0;
+            for (auto* guest = TryGetEntity<Guest>(station.LastPeepInQueue); guest != nullptr && numGuests < MAX_ENTITIES;
+                 guest = TryGetEntity<Guest>(guest->GuestNextInQueue), numGuests++)
+            {
+                auto nextIndex = guest->GuestNextInQueue;
+                if (nextIndex < MAX_ENTITIES && _queueGuestsBehind.Guests[nextIndex] == SPRITE_INDEX_NULL)
+                {
+                    _queueGuestsBehind.Guests[nextIndex] = guest->sprite_index;
+                }
+            }
+        }
+    }
+}
+
+void guest_queue_set_guest_behind(uint16_t spriteIndex, uint16_t behindIndex)
+{
+    if (spriteIndex < MAX_ENTITIES && guest_queue_is_guest_behind_valid())
+    {
+        _queueGuestsBehind.Guests[spriteIndex] = behindIndex;
+    }
+}
+
+/**
+ * Gets the guest behind the given guest in their queue, or nullptr if it is not known.
+ */
+static Guest* guest_queue_get_guest_behind(const Guest& guest)
+{
+    if (!guest_queue_is_guest_behind_valid())
+    {
+        guest_queue_rebuild_guests_behind();
+    }
+
+    auto* guestBehind = TryGetEntity<Guest>(_queueGuestsBehind.Guests[guest.sprite_index]);
+    if (guestBehind == nullptr || guestBehind->GuestNextInQueue != guest.sprite_index
+        || guestBehind->CurrentRide != guest.CurrentRide || guestBehind->CurrentRideStation != guest.CurrentRideStation)
+    {
+        return nullptr;
+    }
+    return guestBehind;
+}
+
 /**
  *
  *  rct2: 0x006966A9
@@ -7308,6 +7372,7 @@ void Guest::RemoveFromQueue()
     if (sprite_index == station.LastPeepInQueue)
     {
         station.LastPeepInQueue = GuestNextInQueue;
+        guest_queue_set_guest_behind(GuestNextInQueue, SPRITE_INDEX_NULL);
         return;
     }
 
@@ -7317,11 +7382,19 @@ void Guest::RemoveFromQueue()
         log_error("Invalid Guest Queue list!");
         return;
     }
+
+    // Only the guest behind can be linked to this guest, unless the queue is broken, in which case it is walked.
+    auto* guestBehind = guest_queue_get_guest_behind(*this);
+    if (guestBehind != nullptr)
+    {
+        otherGuest = guestBehind;
+    }
     for (; otherGuest != nullptr; otherGuest = GetEntity<Guest>(otherGuest->GuestNextInQueue))
     {
         if (sprite_index == otherGuest->GuestNextInQueue)
         {
             otherGuest->GuestNextInQueue = GuestNextInQueue;
+            guest_queue_set_guest_behind(GuestNextInQueue, otherGuest->sprite_index);
             return;
         }
     }
@@ -7356,3 +7429,13 @@ bool Guest::HasItem(ShopItem peepItem) const
 {
     return GetItemFlags() & EnumToFlag(peepItem);
 }
+
+GuestColdData& Guest::GetColdData()
+{
+    return _guestColdData[sprite_index];
+}
+
+const GuestColdData& Guest::GetColdData() const
+{
+    return _guestColdData[sprite_index];
+}
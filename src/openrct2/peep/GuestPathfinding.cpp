@@ -9,7 +9,12 @@
 
 #include "GuestPathfinding.h"
 
+#include "../Context.h"
+#include "../ReplayManager.h"
+#include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/TaskScheduler.h"
+#include "../network/network.h"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -20,17 +25,28 @@
 #include "Peep.h"
 #include "Staff.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
-
-static bool _peepPathFindIsStaff;
-static int8_t _peepPathFindNumJunctions;
-static int8_t _peepPathFindMaxJunctions;
-static int32_t _peepPathFindTilesChecked;
-static uint8_t _peepPathFindFewestNumSteps;
-
-TileCoordsXYZ gPeepPathFindGoalPosition;
-bool gPeepPathFindIgnoreForeignQueues;
-ride_id_t gPeepPathFindQueueRideIndex;
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// The search state is per thread, so guest searches can be run ahead of time by PathfindPrepareGuestSearches.
+static thread_local bool _peepPathFindIsStaff;
+static thread_local bool _peepPathFindIsPrepared;
+static thread_local int8_t _peepPathFindNumJunctions;
+static thread_local int8_t _peepPathFindMaxJunctions;
+static thread_local int32_t _peepPathFindTilesChecked;
+static thread_local uint8_t _peepPathFindFewestNumSteps;
+// The number of tiles guest searches may still check in this tick, negative for no limit.
+static int32_t _peepPathFindTickBudget = -1;
+static PathfindStatistics _peepPathFindStatistics;
+
+thread_local TileCoordsXYZ gPeepPathFindGoalPosition;
+thread_local bool gPeepPathFindIgnoreForeignQueues;
+thread_local ride_id_t gPeepPathFindQueueRideIndex;
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 // Use to guard calls to log messages
@@ -45,7 +61,7 @@ static int32_t guest_surface_path_finding(Peep* peep);
  * The magic number 16 is the largest value returned by
  * peep_pathfind_get_max_number_junctions() which should eventually
  * be declared properly. */
-static struct
+static thread_local struct
 {
     TileCoordsXYZ location;
     Direction direction;
@@ -93,10 +109,9 @@ static TileElement* get_banner_on_path(TileElement* path_element)
     return nullptr;
 }
 
-static int32_t banner_clear_path_edges(PathElement* pathElement, int32_t edges)
+static int32_t banner_get_path_allowed_edges(PathElement* pathElement)
 {
-    if (_peepPathFindIsStaff)
-        return edges;
+    int32_t edges = 0xFF;
     TileElement* bannerElement = get_banner_on_path(reinterpret_cast<TileElement*>(pathElement));
     if (bannerElement != nullptr)
     {
@@ -108,6 +123,13 @@ static int32_t banner_clear_path_edges(PathElement* pathElement, int32_t edges)
     return edges;
 }
 
+static int32_t banner_clear_path_edges(PathElement* pathElement, int32_t edges)
+{
+    if (_peepPathFindIsStaff)
+        return edges;
+    return edges & banner_get_path_allowed_edges(pathElement);
+}
+
 /**
  * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
  */
@@ -475,6 +497,22 @@ static int32_t guest_path_find_aimless(Peep* peep, uint8_t edges)
     }
 }
 
+static uint8_t guest_pathfind_get_max_number_junctions(const Guest* guest)
+{
+    if (guest->PeepFlags & PEEP_FLAGS_LEAVING_PARK && guest->GuestIsLostCountdown < 90)
+    {
+        return 8;
+    }
+
+    if (guest->HasItem(ShopItem::Map))
+        return 7;
+
+    if (guest->PeepFlags & PEEP_FLAGS_LEAVING_PARK)
+        return 7;
+
+    return 5;
+}
+
 /**
  *
  *  rct2: 0x0069A60A
@@ -497,18 +535,7 @@ static uint8_t peep_pathfind_get_max_number_junctions(Peep* peep)
     if (guest == nullptr)
         return 8;
 
-    if (guest->PeepFlags & PEEP_FLAGS_LEAVING_PARK && guest->GuestIsLostCountdown < 90)
-    {
-        return 8;
-    }
-
-    if (guest->HasItem(ShopItem::Map))
-        return 7;
-
-    if (guest->PeepFlags & PEEP_FLAGS_LEAVING_PARK)
-        return 7;
-
-    return 5;
+    return guest_pathfind_get_max_number_junctions(guest);
 }
 
 /**
@@ -601,6 +628,258 @@ static constexpr const char* pathSearchToString(uint8_t pathFindSearchResult)
 }
 #endif
 
+/**
+ * What the heuristic search finds when it steps onto a tile in a given direction, for tiles that only have a thin path
+ * going straight or around a corner. Every other tile is walked element by element.
+ */
+struct PathfindStep
+{
+    uint64_t TileVersion{};
+    uint8_t EntryZ{};
+    bool IsThinPath{};
+    uint8_t BaseZ{};
+    // The permitted edges without the edge back to the previous tile.
+    uint8_t GuestEdges{};
+    uint8_t StaffEdges{};
+    // The edge the path slopes up towards, or INVALID_DIRECTION.
+    uint8_t RaisedEdge{};
+};
+
+static std::vector<PathfindStep> _pathfindSteps;
+
+static void peep_pathfind_update_step(PathfindStep& step, const TileCoordsXYZ& loc, Direction direction)
+{
+    step.IsThinPath = false;
+
+    /* Walk the elements the same way peep_pathfind_heuristic_search does, the step is only a thin path if the path is
+     * the only element the search would look at. */
+    PathElement* pathElement = nullptr;
+    int32_t z = loc.z;
+    TileElement* tileElement = map_get_first_element_at(loc.ToCoordsXY());
+    if (tileElement == nullptr)
+        return;
+    do
+    {
+        if (tileElement->IsGhost())
+            continue;
+
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_TRACK:
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+                if (z == tileElement->base_height)
+                    return;
+                break;
+            case TILE_ELEMENT_TYPE_PATH:
+                if (!IsValidPathZAndDirection(tileElement, z, direction))
+                    break;
+                if (pathElement != nullptr)
+                    return;
+                pathElement = tileElement->AsPath();
+                z = tileElement->base_height;
+                break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+
+    if (pathElement == nullptr || pathElement->IsWide() || pathElement->IsQueue() || bitcount(pathElement->GetEdges()) != 2)
+        return;
+
+    const uint8_t edges = (pathElement->GetEdgesAndCorners() & 0x0F) & ~(1 << direction_reverse(direction));
+    step.IsThinPath = true;
+    step.BaseZ = pathElement->base_height;
+    step.StaffEdges = edges;
+    step.GuestEdges = edges & banner_get_path_allowed_edges(pathElement);
+    step.RaisedEdge = pathElement->IsSloped() ? pathElement->GetSlopeDirection() : INVALID_DIRECTION;
+}
+
+/**
+ * Gets the step onto the given tile, the tile version tells when the tile has to be walked again.
+ */
+static const PathfindStep* peep_pathfind_get_step(const TileCoordsXYZ& loc, Direction direction)
+{
+    if (loc.x < 0 || loc.y < 0 || loc.x >= MAXIMUM_MAP_SIZE_TECHNICAL || loc.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return nullptr;
+
+    if (_pathfindSteps.empty())
+    {
+        if (_peepPathFindIsPrepared)
+            return nullptr;
+        _pathfindSteps.resize(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL * NumOrthogonalDirections);
+    }
+
+    auto& step = _pathfindSteps[((loc.x + (loc.y * MAXIMUM_MAP_SIZE_TECHNICAL)) * NumOrthogonalDirections) + direction];
+    const auto tileVersion = map_get_tile_version({ loc.x, loc.y });
+    if (step.TileVersion != tileVersion || step.EntryZ != loc.z)
+    {
+        // Searches run ahead of time share the steps, they must not change them.
+        if (_peepPathFindIsPrepared)
+        {
+            static thread_local PathfindStep preparedStep;
+            peep_pathfind_update_step(preparedStep, loc, direction);
+            return &preparedStep;
+        }
+
+        peep_pathfind_update_step(step, loc, direction);
+        step.TileVersion = tileVersion;
+        step.EntryZ = static_cast<uint8_t>(loc.z);
+    }
+    return &step;
+}
+
+/**
+ * Everything the direction a guest chooses at a junction depends on, other than the map. Guests heading for the same
+ * destination usually arrive at a junction the same way, so most searches do not have to be done again.
+ */
+struct PathfindSearchKey
+{
+    TileCoordsXYZ Start;
+    TileCoordsXYZ Goal;
+    uint8_t Edges{};
+    int8_t MaxJunctions{};
+    bool IgnoreForeignQueues{};
+    ride_id_t QueueRideIndex{};
+    std::array<rct12_xyzd8, 4> History{};
+
+    bool operator==(const PathfindSearchKey& rhs) const
+    {
+        return Start == rhs.Start && Goal == rhs.Goal && Edges == rhs.Edges && MaxJunctions == rhs.MaxJunctions
+            && IgnoreForeignQueues == rhs.IgnoreForeignQueues && QueueRideIndex == rhs.QueueRideIndex
+            && std::memcmp(History.data(), rhs.History.data(), sizeof(History)) == 0;
+    }
+};
+
+struct PathfindSearchKeyHash
+{
+    size_t operator()(const PathfindSearchKey& key) const
+    {
+        size_t hash = 0;
+        auto combine = [&hash](uint32_t value) { hash = (hash * 31) ^ std::hash<uint32_t>{}(value); };
+        combine((key.Start.x << 16) | (key.Start.y << 8) | key.Start.z);
+        combine((key.Goal.x << 16) | (key.Goal.y << 8) | key.Goal.z);
+        combine((key.Edges << 16) | (static_cast<uint8_t>(key.MaxJunctions) << 8) | key.IgnoreForeignQueues);
+        combine(static_cast<uint32_t>(key.QueueRideIndex));
+        for (const auto& history : key.History)
+        {
+            combine((history.x << 24) | (history.y << 16) | (history.z << 8) | history.direction);
+        }
+        return hash;
+    }
+};
+
+struct PathfindSearchResult
+{
+    Direction Edge{};
+    int32_t TilesChecked{};
+    uint32_t LastUsed{};
+};
+
+// The number of searches remembered, the one used least recently is forgotten first.
+static constexpr size_t PathfindSearchCacheSize = 4096;
+
+static struct
+{
+    uint32_t MapVersion{};
+    uint32_t Clock{};
+    std::unordered_map<PathfindSearchKey, PathfindSearchResult, PathfindSearchKeyHash> Results;
+} _pathfindSearchCache;
+
+static PathfindSearchKey peep_pathfind_get_search_key(const TileCoordsXYZ& loc, Peep* peep, uint8_t edges)
+{
+    PathfindSearchKey key;
+    key.Start = loc;
+    key.Goal = gPeepPathFindGoalPosition;
+    key.Edges = edges;
+    key.MaxJunctions = _peepPathFindMaxJunctions;
+    key.IgnoreForeignQueues = gPeepPathFindIgnoreForeignQueues;
+    key.QueueRideIndex = gPeepPathFindQueueRideIndex;
+    std::copy(std::begin(peep->PathfindHistory), std::end(peep->PathfindHistory), key.History.begin());
+    return key;
+}
+
+static std::optional<PathfindSearchResult> peep_pathfind_find_cached_search(const PathfindSearchKey& key)
+{
+    // Any change to the map may change the outcome of every search.
+    auto& cache = _pathfindSearchCache;
+    if (cache.MapVersion != map_get_version())
+    {
+        cache.MapVersion = map_get_version();
+        cache.Results.clear();
+        return std::nullopt;
+    }
+
+    auto it = cache.Results.find(key);
+    if (it == cache.Results.end())
+        return std::nullopt;
+
+    it->second.LastUsed = ++cache.Clock;
+    return it->second;
+}
+
+static bool peep_pathfind_is_search_cached(const PathfindSearchKey& key)
+{
+    auto& cache = _pathfindSearchCache;
+    if (cache.MapVersion != map_get_version())
+    {
+        cache.MapVersion = map_get_version();
+        cache.Results.clear();
+        return false;
+    }
+    return cache.Results.find(key) != cache.Results.end();
+}
+
+static void peep_pathfind_cache_search(const PathfindSearchKey& key, const PathfindSearchResult& result)
+{
+    auto& cache = _pathfindSearchCache;
+    if (cache.Results.size() >= PathfindSearchCacheSize)
+    {
+        auto leastRecentlyUsed = std::min_element(
+            cache.Results.begin(), cache.Results.end(),
+            [](const auto& a, const auto& b) { return a.second.LastUsed < b.second.LastUsed; });
+        cache.Results.erase(leastRecentlyUsed);
+    }
+    auto& entry = cache.Results[key];
+    entry = result;
+    entry.LastUsed = ++cache.Clock;
+}
+
+void PathfindResetTickBudget()
+{
+    // The budget changes where guests walk but is only configured locally, so it can not be used when other players or
+    // a replay have to make the same choices.
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    const bool isReplay = replayManager != nullptr
+        && (replayManager->IsRecording() || replayManager->IsReplaying() || replayManager->IsNormalising());
+    if (network_get_mode() != NETWORK_MODE_NONE || isReplay)
+    {
+        _peepPathFindTickBudget = -1;
+        return;
+    }
+
+    _peepPathFindTickBudget = gConfigGeneral.pathfinding_tick_budget > 0 ? gConfigGeneral.pathfinding_tick_budget : -1;
+}
+
+const PathfindStatistics& PathfindGetStatistics()
+{
+    return _peepPathFindStatistics;
+}
+
+void PathfindResetStatistics()
+{
+    _peepPathFindStatistics = {};
+}
+
+/**
+ * Gets whether the heuristic search treats the path it is leaving as wide.
+ */
+static bool peep_pathfind_is_wide(Peep* peep, const TileCoordsXYZ& loc, TileElement* pathElement)
+{
+    if (!pathElement->AsPath()->IsWide())
+        return false;
+
+    const Staff* staff = peep->As<Staff>();
+    return staff == nullptr || !staff->CanIgnoreWideFlag(loc.ToCoordsXYZ(), pathElement);
+}
+
 /**
  * Searches for the tile with the best heuristic score within the search limits
  * starting from the given tile x,y,z and going in the given direction test_edge.
@@ -678,20 +957,12 @@ static constexpr const char* pathSearchToString(uint8_t pathFindSearchResult)
  *  rct2: 0x0069A997
  */
 static void peep_pathfind_heuristic_search(
-    TileCoordsXYZ loc, Peep* peep, TileElement* currentTileElement, bool inPatrolArea, uint8_t counter, uint16_t* endScore,
+    TileCoordsXYZ loc, Peep* peep, bool currentElementIsWide, bool inPatrolArea, uint8_t counter, uint16_t* endScore,
     Direction test_edge, uint8_t* endJunctions, TileCoordsXYZ junctionList[16], uint8_t directionList[16],
     TileCoordsXYZ* endXYZ, uint8_t* endSteps)
 {
     uint8_t searchResult = PATH_SEARCH_FAILED;
 
-    bool currentElementIsWide = currentTileElement->AsPath()->IsWide();
-    if (currentElementIsWide)
-    {
-        const Staff* staff = peep->As<Staff>();
-        if (staff != nullptr && staff->CanIgnoreWideFlag(loc.ToCoordsXYZ(), currentTileElement))
-            currentElementIsWide = false;
-    }
-
     loc += TileDirectionDelta[test_edge];
 
     ++counter;
@@ -732,6 +1003,58 @@ static void peep_pathfind_heuristic_search(
         }
     }
 
+    /* A thin path that is not a junction is followed without walking its elements again. The checks are the same as
+     * for a PATH_SEARCH_THIN path below. */
+    const PathfindStep* step = peep_pathfind_get_step(loc, test_edge);
+    if (step != nullptr && step->IsThinPath)
+    {
+        loc.z = step->BaseZ;
+
+        uint16_t new_score = CalculateHeuristicPathingScore(loc, gPeepPathFindGoalPosition);
+        uint8_t edges = _peepPathFindIsStaff ? step->StaffEdges : step->GuestEdges;
+        if (new_score != 0 && edges == 0)
+            return;
+
+        if (new_score == 0 || counter >= 200 || _peepPathFindTilesChecked <= 0)
+        {
+            if (new_score < *endScore || (new_score == *endScore && counter < *endSteps))
+            {
+                *endScore = new_score;
+                *endSteps = counter;
+                *endXYZ = loc;
+                *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+                for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
+                {
+                    uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
+                    junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
+                    junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
+                    junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
+                    directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
+                }
+            }
+            return;
+        }
+
+        int32_t next_test_edge;
+        while ((next_test_edge = bitscanforward(edges)) != -1)
+        {
+            edges &= ~(1 << next_test_edge);
+            uint8_t savedNumJunctions = _peepPathFindNumJunctions;
+
+            uint8_t height = loc.z;
+            if (step->RaisedEdge == next_test_edge)
+            {
+                height += 2;
+            }
+
+            peep_pathfind_heuristic_search(
+                { loc.x, loc.y, height }, peep, false, nextInPatrolArea, counter, endScore, next_test_edge, endJunctions,
+                junctionList, directionList, endXYZ, endSteps);
+            _peepPathFindNumJunctions = savedNumJunctions;
+        }
+        return;
+    }
+
     /* Get the next map element of interest in the direction of test_edge. */
     bool found = false;
     TileElement* tileElement = map_get_first_element_at(loc.ToCoordsXY());
@@ -1214,8 +1537,9 @@ static void peep_pathfind_heuristic_search(
             }
 
             peep_pathfind_heuristic_search(
-                { loc.x, loc.y, height }, peep, tileElement, nextInPatrolArea, counter, endScore, next_test_edge, endJunctions,
-                junctionList, directionList, endXYZ, endSteps);
+                { loc.x, loc.y, height }, peep, peep_pathfind_is_wide(peep, { loc.x, loc.y, height }, tileElement),
+                nextInPatrolArea, counter, endScore, next_test_edge, endJunctions, junctionList, directionList, endXYZ,
+                endSteps);
             _peepPathFindNumJunctions = savedNumJunctions;
 
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
@@ -1253,33 +1577,13 @@ static void peep_pathfind_heuristic_search(
 }
 
 /**
- * Returns:
- *   -1   - no direction chosen
- *   0..3 - chosen direction
- *
- *  rct2: 0x0069A5F0
+ * Gets the paths at the position of the peep for peep_pathfind_choose_direction.
+ * @returns the first of them, or nullptr if the peep is not on a path.
  */
-Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
+static TileElement* peep_pathfind_get_start_path(const TileCoordsXYZ& loc, uint8_t* permittedEdges, bool* isThin)
 {
-    // The max number of thin junctions searched - a per-search-path limit.
-    _peepPathFindMaxJunctions = peep_pathfind_get_max_number_junctions(peep);
-
-    /* The max number of tiles to check - a whole-search limit.
-     * Mainly to limit the performance impact of the path finding. */
-    int32_t maxTilesChecked = (peep->Is<Staff>()) ? 50000 : 15000;
-    // Used to allow walking through no entry banners
-    _peepPathFindIsStaff = peep->Is<Staff>();
-
-    TileCoordsXYZ goal = gPeepPathFindGoalPosition;
-
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-    if (_pathFindDebug)
-    {
-        log_verbose(
-            "Choose direction for %s for goal %d,%d,%d from %d,%d,%d", _pathFindDebugPeepName, goal.x, goal.y, goal.z, loc.x,
-            loc.y, loc.z);
-    }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    *permittedEdges = 0;
+    *isThin = false;
 
     // Get the path element at this location
     TileElement* dest_tile_element = map_get_first_element_at(loc.ToCoordsXY());
@@ -1299,10 +1603,6 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
      * In particular common edges at different heights will not work
      * in a useful way. Simply do not do it! :-) */
     TileElement* first_tile_element = nullptr;
-
-    bool found = false;
-    uint8_t permitted_edges = 0;
-    bool isThin = false;
     do
     {
         if (dest_tile_element == nullptr)
@@ -1311,7 +1611,6 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
             continue;
         if (dest_tile_element->GetType() != TILE_ELEMENT_TYPE_PATH)
             continue;
-        found = true;
         if (first_tile_element == nullptr)
         {
             first_tile_element = dest_tile_element;
@@ -1323,16 +1622,224 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
          * check if the combination is 'thin'!
          * The junction is considered 'thin' simply if any of the
          * overlaid path elements there is a 'thin junction'. */
-        isThin = isThin || path_is_thin_junction(dest_tile_element->AsPath(), loc);
+        *isThin = *isThin || path_is_thin_junction(dest_tile_element->AsPath(), loc);
 
         // Collect the permitted edges of ALL matching path elements at this location.
-        permitted_edges |= path_get_permitted_edges(dest_tile_element->AsPath());
+        *permittedEdges |= path_get_permitted_edges(dest_tile_element->AsPath());
     } while (!(dest_tile_element++)->IsLastForTile());
+
+    *permittedEdges &= 0xF;
+    return first_tile_element;
+}
+
+/**
+ * Runs the heuristic search along each of the given edges of the path the peep is on.
+ * @returns the edge that gets closest to the goal in the fewest steps, or INVALID_DIRECTION if none of them lead
+ *          anywhere. tilesChecked is set to the number of tiles the search looked at.
+ */
+static Direction peep_pathfind_search_edges(
+    const TileCoordsXYZ& loc, Peep* peep, TileElement* first_tile_element, uint8_t edges, int32_t* tilesChecked)
+{
+    /* The max number of tiles to check - a whole-search limit.
+     * Mainly to limit the performance impact of the path finding. */
+    const int32_t maxTilesChecked = (peep->Is<Staff>()) ? 50000 : 15000;
+    int32_t chosen_edge = bitscanforward(edges);
+    *tilesChecked = 0;
+
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    const TileCoordsXYZ goal = gPeepPathFindGoalPosition;
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+    uint16_t best_score = 0xFFFF;
+    uint8_t best_sub = 0xFF;
+
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    uint8_t bestJunctions = 0;
+    TileCoordsXYZ bestJunctionList[16];
+    uint8_t bestDirectionList[16];
+    TileCoordsXYZ bestXYZ;
+
+    if (_pathFindDebug)
+    {
+        log_verbose("Pathfind start for goal %d,%d,%d from %d,%d,%d", goal.x, goal.y, goal.z, loc.x, loc.y, loc.z);
+    }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+    /* Call the search heuristic on each edge, keeping track of the
+     * edge that gives the best (i.e. smallest) value (best_score)
+     * or for different edges with equal value, the edge with the
+     * least steps (best_sub). */
+    int32_t numEdges = bitcount(edges);
+    for (int32_t test_edge = chosen_edge; test_edge != -1; test_edge = bitscanforward(edges))
+    {
+        edges &= ~(1 << test_edge);
+        uint8_t height = loc.z;
+
+        if (first_tile_element->AsPath()->IsSloped() && first_tile_element->AsPath()->GetSlopeDirection() == test_edge)
+        {
+            height += 0x2;
+        }
+
+        _peepPathFindFewestNumSteps = 255;
+        /* Divide the maxTilesChecked global search limit
+         * between the remaining edges to ensure the search
+         * covers all of the remaining edges. */
+        _peepPathFindTilesChecked = maxTilesChecked / numEdges;
+        _peepPathFindNumJunctions = _peepPathFindMaxJunctions;
+
+        // Initialise _peepPathFindHistory.
+        std::memset(static_cast<void*>(_peepPathFindHistory), 0xFF, sizeof(_peepPathFindHistory));
+
+        /* The pathfinding will only use elements
+         * 1.._peepPathFindMaxJunctions, so the starting point
+         * is placed in element 0 */
+        _peepPathFindHistory[0].location.x = static_cast<uint8_t>(loc.x);
+        _peepPathFindHistory[0].location.y = static_cast<uint8_t>(loc.y);
+        _peepPathFindHistory[0].location.z = loc.z;
+        _peepPathFindHistory[0].direction = 0xF;
+
+        uint16_t score = 0xFFFF;
+        /* Variable endXYZ contains the end location of the
+         * search path. */
+        TileCoordsXYZ endXYZ;
+        endXYZ.x = 0;
+        endXYZ.y = 0;
+        endXYZ.z = 0;
+
+        uint8_t endSteps = 255;
+
+        /* Variable endJunctions is the number of junctions
+         * passed through in the search path.
+         * Variables endJunctionList and endDirectionList
+         * contain the junctions and corresponding directions
+         * of the search path.
+         * In the future these could be used to visualise the
+         * pathfinding on the map. */
+        uint8_t endJunctions = 0;
+        TileCoordsXYZ endJunctionList[16];
+        uint8_t endDirectionList[16] = { 0 };
+
+        bool inPatrolArea = false;
+        auto* staff = peep->As<Staff>();
+        if (staff != nullptr && staff->IsMechanic())
+        {
+            /* Mechanics are the only staff type that
+             * pathfind to a destination. Determine if the
+             * mechanic is in their patrol area. */
+            inPatrolArea = staff->IsLocationInPatrol(peep->NextLoc);
+        }
+
+#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+        if (gPathFindDebug)
+        {
+            log_verbose("Pathfind searching in direction: %d from %d,%d,%d", test_edge, loc.x >> 5, loc.y >> 5, loc.z);
+        }
+#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+
+        peep_pathfind_heuristic_search(
+            { loc.x, loc.y, height }, peep, peep_pathfind_is_wide(peep, { loc.x, loc.y, height }, first_tile_element),
+            inPatrolArea, 0, &score, test_edge, &endJunctions, endJunctionList, endDirectionList, &endXYZ, &endSteps);
+
+        *tilesChecked += (maxTilesChecked / numEdges) - _peepPathFindTilesChecked;
+
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        if (_pathFindDebug)
+        {
+            log_verbose(
+                "Pathfind test edge: %d score: %d steps: %d end: %d,%d,%d junctions: %d", test_edge, score, endSteps,
+                endXYZ.x, endXYZ.y, endXYZ.z, endJunctions);
+            for (uint8_t listIdx = 0; listIdx < endJunctions; listIdx++)
+            {
+                log_info(
+                    "Junction#%d %d,%d,%d Direction %d", listIdx + 1, endJunctionList[listIdx].x,
+                    endJunctionList[listIdx].y, endJunctionList[listIdx].z, endDirectionList[listIdx]);
+            }
+        }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+        if (score < best_score || (score == best_score && endSteps < best_sub))
+        {
+            chosen_edge = test_edge;
+            best_score = score;
+            best_sub = endSteps;
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+            bestJunctions = endJunctions;
+            for (uint8_t index = 0; index < endJunctions; index++)
+            {
+                bestJunctionList[index].x = endJunctionList[index].x;
+                bestJunctionList[index].y = endJunctionList[index].y;
+                bestJunctionList[index].z = endJunctionList[index].z;
+                bestDirectionList[index] = endDirectionList[index];
+            }
+            bestXYZ.x = endXYZ.x;
+            bestXYZ.y = endXYZ.y;
+            bestXYZ.z = endXYZ.z;
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        }
+    }
+
+    /* Check if the heuristic search failed. e.g. all connected
+     * paths are within the search limits and none reaches the
+     * goal. */
+    if (best_score == 0xFFFF)
+    {
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        if (_pathFindDebug)
+        {
+            log_verbose("Pathfind heuristic search failed.");
+        }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        return INVALID_DIRECTION;
+    }
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    if (_pathFindDebug)
+    {
+        log_verbose("Pathfind best edge %d with score %d steps %d", chosen_edge, best_score, best_sub);
+        for (uint8_t listIdx = 0; listIdx < bestJunctions; listIdx++)
+        {
+            log_verbose(
+                "Junction#%d %d,%d,%d Direction %d", listIdx + 1, bestJunctionList[listIdx].x, bestJunctionList[listIdx].y,
+                bestJunctionList[listIdx].z, bestDirectionList[listIdx]);
+        }
+        log_verbose("End at %d,%d,%d", bestXYZ.x, bestXYZ.y, bestXYZ.z);
+    }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    return chosen_edge;
+}
+
+/**
+ * Returns:
+ *   -1   - no direction chosen
+ *   0..3 - chosen direction
+ *
+ *  rct2: 0x0069A5F0
+ */
+Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
+{
+    // The max number of thin junctions searched - a per-search-path limit.
+    _peepPathFindMaxJunctions = peep_pathfind_get_max_number_junctions(peep);
+
+    // Used to allow walking through no entry banners
+    _peepPathFindIsStaff = peep->Is<Staff>();
+
+    TileCoordsXYZ goal = gPeepPathFindGoalPosition;
+
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    if (_pathFindDebug)
+    {
+        log_verbose(
+            "Choose direction for %s for goal %d,%d,%d from %d,%d,%d", _pathFindDebugPeepName, goal.x, goal.y, goal.z, loc.x,
+            loc.y, loc.z);
+    }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+    uint8_t permitted_edges;
+    bool isThin;
+    TileElement* first_tile_element = peep_pathfind_get_start_path(loc, &permitted_edges, &isThin);
     // Peep is not on a path.
-    if (!found)
+    if (first_tile_element == nullptr)
         return INVALID_DIRECTION;
 
-    permitted_edges &= 0xF;
     uint8_t edges = permitted_edges;
     if (isThin && peep->PathfindGoal.x == goal.x && peep->PathfindGoal.y == goal.y && peep->PathfindGoal.z == goal.z)
     {
@@ -1425,161 +1932,47 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
 
     int32_t chosen_edge = bitscanforward(edges);
 
-    // Peep has multiple edges still to try.
-    if (edges & ~(1 << chosen_edge))
+    /* Staff searches depend on the staff member, e.g. their patrol area, so only the searches of guests are kept. */
+    const bool isGuestSearch = !_peepPathFindIsStaff && (edges & ~(1 << chosen_edge));
+    if (isGuestSearch && _peepPathFindTickBudget == 0 && (edges & (1 << peep->PeepDirection)))
     {
-        uint16_t best_score = 0xFFFF;
-        uint8_t best_sub = 0xFF;
-
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-        uint8_t bestJunctions = 0;
-        TileCoordsXYZ bestJunctionList[16];
-        uint8_t bestDirectionList[16];
-        TileCoordsXYZ bestXYZ;
-
-        if (_pathFindDebug)
+        // The searches of this tick have used up the budget, carry on and decide at the next junction.
+        chosen_edge = peep->PeepDirection;
+    }
+    else if (isGuestSearch)
+    {
+        const auto searchKey = peep_pathfind_get_search_key(loc, peep, edges);
+        auto result = peep_pathfind_find_cached_search(searchKey);
+        if (!result.has_value())
         {
-            log_verbose("Pathfind start for goal %d,%d,%d from %d,%d,%d", goal.x, goal.y, goal.z, loc.x, loc.y, loc.z);
+            result.emplace();
+            result->Edge = peep_pathfind_search_edges(loc, peep, first_tile_element, edges, &result->TilesChecked);
+            peep_pathfind_cache_search(searchKey, *result);
+            _peepPathFindStatistics.Searches++;
+            _peepPathFindStatistics.TilesChecked += result->TilesChecked;
         }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-
-        /* Call the search heuristic on each edge, keeping track of the
-         * edge that gives the best (i.e. smallest) value (best_score)
-         * or for different edges with equal value, the edge with the
-         * least steps (best_sub). */
-        int32_t numEdges = bitcount(edges);
-        for (int32_t test_edge = chosen_edge; test_edge != -1; test_edge = bitscanforward(edges))
+        else
         {
-            edges &= ~(1 << test_edge);
-            uint8_t height = loc.z;
-
-            if (first_tile_element->AsPath()->IsSloped() && first_tile_element->AsPath()->GetSlopeDirection() == test_edge)
-            {
-                height += 0x2;
-            }
-
-            _peepPathFindFewestNumSteps = 255;
-            /* Divide the maxTilesChecked global search limit
-             * between the remaining edges to ensure the search
-             * covers all of the remaining edges. */
-            _peepPathFindTilesChecked = maxTilesChecked / numEdges;
-            _peepPathFindNumJunctions = _peepPathFindMaxJunctions;
-
-            // Initialise _peepPathFindHistory.
-            std::memset(static_cast<void*>(_peepPathFindHistory), 0xFF, sizeof(_peepPathFindHistory));
-
-            /* The pathfinding will only use elements
-             * 1.._peepPathFindMaxJunctions, so the starting point
-             * is placed in element 0 */
-            _peepPathFindHistory[0].location.x = static_cast<uint8_t>(loc.x);
-            _peepPathFindHistory[0].location.y = static_cast<uint8_t>(loc.y);
-            _peepPathFindHistory[0].location.z = loc.z;
-            _peepPathFindHistory[0].direction = 0xF;
-
-            uint16_t score = 0xFFFF;
-            /* Variable endXYZ contains the end location of the
-             * search path. */
-            TileCoordsXYZ endXYZ;
-            endXYZ.x = 0;
-            endXYZ.y = 0;
-            endXYZ.z = 0;
-
-            uint8_t endSteps = 255;
-
-            /* Variable endJunctions is the number of junctions
-             * passed through in the search path.
-             * Variables endJunctionList and endDirectionList
-             * contain the junctions and corresponding directions
-             * of the search path.
-             * In the future these could be used to visualise the
-             * pathfinding on the map. */
-            uint8_t endJunctions = 0;
-            TileCoordsXYZ endJunctionList[16];
-            uint8_t endDirectionList[16] = { 0 };
-
-            bool inPatrolArea = false;
-            auto* staff = peep->As<Staff>();
-            if (staff != nullptr && staff->IsMechanic())
-            {
-                /* Mechanics are the only staff type that
-                 * pathfind to a destination. Determine if the
-                 * mechanic is in their patrol area. */
-                inPatrolArea = staff->IsLocationInPatrol(peep->NextLoc);
-            }
-
-#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
-            if (gPathFindDebug)
-            {
-                log_verbose("Pathfind searching in direction: %d from %d,%d,%d", test_edge, loc.x >> 5, loc.y >> 5, loc.z);
-            }
-#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
-
-            peep_pathfind_heuristic_search(
-                { loc.x, loc.y, height }, peep, first_tile_element, inPatrolArea, 0, &score, test_edge, &endJunctions,
-                endJunctionList, endDirectionList, &endXYZ, &endSteps);
-
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-            if (_pathFindDebug)
-            {
-                log_verbose(
-                    "Pathfind test edge: %d score: %d steps: %d end: %d,%d,%d junctions: %d", test_edge, score, endSteps,
-                    endXYZ.x, endXYZ.y, endXYZ.z, endJunctions);
-                for (uint8_t listIdx = 0; listIdx < endJunctions; listIdx++)
-                {
-                    log_info(
-                        "Junction#%d %d,%d,%d Direction %d", listIdx + 1, endJunctionList[listIdx].x,
-                        endJunctionList[listIdx].y, endJunctionList[listIdx].z, endDirectionList[listIdx]);
-                }
-            }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-
-            if (score < best_score || (score == best_score && endSteps < best_sub))
-            {
-                chosen_edge = test_edge;
-                best_score = score;
-                best_sub = endSteps;
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-                bestJunctions = endJunctions;
-                for (uint8_t index = 0; index < endJunctions; index++)
-                {
-                    bestJunctionList[index].x = endJunctionList[index].x;
-                    bestJunctionList[index].y = endJunctionList[index].y;
-                    bestJunctionList[index].z = endJunctionList[index].z;
-                    bestDirectionList[index] = endDirectionList[index];
-                }
-                bestXYZ.x = endXYZ.x;
-                bestXYZ.y = endXYZ.y;
-                bestXYZ.z = endXYZ.z;
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-            }
+            _peepPathFindStatistics.CachedSearches++;
         }
 
-        /* Check if the heuristic search failed. e.g. all connected
-         * paths are within the search limits and none reaches the
-         * goal. */
-        if (best_score == 0xFFFF)
-        {
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-            if (_pathFindDebug)
-            {
-                log_verbose("Pathfind heuristic search failed.");
-            }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        // Remembered searches count towards the budget too, so what is remembered does not change any choices.
+        if (_peepPathFindTickBudget > 0)
+            _peepPathFindTickBudget = std::max(0, _peepPathFindTickBudget - result->TilesChecked);
+
+        if (result->Edge == INVALID_DIRECTION)
+            return INVALID_DIRECTION;
+        chosen_edge = result->Edge;
+    }
+    // Peep has multiple edges still to try.
+    else if (edges & ~(1 << chosen_edge))
+    {
+        int32_t tilesChecked;
+        chosen_edge = peep_pathfind_search_edges(loc, peep, first_tile_element, edges, &tilesChecked);
+        _peepPathFindStatistics.Searches++;
+        _peepPathFindStatistics.TilesChecked += tilesChecked;
+        if (chosen_edge == INVALID_DIRECTION)
             return INVALID_DIRECTION;
-        }
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-        if (_pathFindDebug)
-        {
-            log_verbose("Pathfind best edge %d with score %d steps %d", chosen_edge, best_score, best_sub);
-            for (uint8_t listIdx = 0; listIdx < bestJunctions; listIdx++)
-            {
-                log_verbose(
-                    "Junction#%d %d,%d,%d Direction %d", listIdx + 1, bestJunctionList[listIdx].x, bestJunctionList[listIdx].y,
-                    bestJunctionList[listIdx].z, bestDirectionList[listIdx]);
-            }
-            log_verbose("End at %d,%d,%d", bestXYZ.x, bestXYZ.y, bestXYZ.z);
-        }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     }
 
     if (isThin)
@@ -1633,6 +2026,155 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
     return chosen_edge;
 }
 
+/**
+ * A search a guest is expected to run when it reaches the middle of the tile it has stepped onto.
+ */
+struct PreparedGuestSearch
+{
+    PathfindSearchKey Key;
+    Guest* Searcher{};
+    TileElement* FirstElement{};
+    PathfindSearchResult Result;
+};
+
+static std::vector<PreparedGuestSearch> _preparedGuestSearches;
+
+/**
+ * Gets the search the guest will run at the junction it is walking onto, assuming it keeps heading for the same goal.
+ * Mirrors what guest_path_finding and peep_pathfind_choose_direction do without changing the guest.
+ */
+static uint8_t get_nearest_park_entrance_index(uint16_t x, uint16_t y);
+
+static bool guest_pathfind_get_upcoming_search(Guest* guest, PreparedGuestSearch& search)
+{
+    if (guest->GetNextIsSurface() || (guest->PeepFlags & PEEP_FLAGS_2))
+        return false;
+
+    const TileCoordsXYZ loc{ guest->NextLoc };
+    if (TileCoordsXY(CoordsXY{ guest->DestinationX, guest->DestinationY }) != TileCoordsXY(loc.x, loc.y))
+        return false;
+
+    // Walking guests are expected to keep heading for the same goal, guests arriving at the park always head for the
+    // nearest park entrance.
+    TileCoordsXYZ goal;
+    if (guest->State == PeepState::Walking)
+    {
+        if (!direction_valid(guest->PathfindGoal.direction))
+            return false;
+        goal = { guest->PathfindGoal.x, guest->PathfindGoal.y, guest->PathfindGoal.z };
+    }
+    else if (guest->State == PeepState::EnteringPark && guest->OutsideOfPark)
+    {
+        auto chosenEntrance = get_nearest_park_entrance_index(guest->NextLoc.x, guest->NextLoc.y);
+        if (chosenEntrance == 0xFF)
+            return false;
+        goal = TileCoordsXYZ(gParkEntrances[chosenEntrance]);
+    }
+    else
+    {
+        return false;
+    }
+
+    uint8_t permittedEdges;
+    bool isThin;
+    TileElement* firstElement = peep_pathfind_get_start_path(loc, &permittedEdges, &isThin);
+    if (firstElement == nullptr)
+        return false;
+
+    auto& key = search.Key;
+    key.Start = loc;
+    key.Goal = goal;
+    std::copy(std::begin(guest->PathfindHistory), std::end(guest->PathfindHistory), key.History.begin());
+
+    const bool isSameGoal = guest->PathfindGoal.x == goal.x && guest->PathfindGoal.y == goal.y
+        && guest->PathfindGoal.z == goal.z;
+    uint8_t edges = permittedEdges;
+    if (isThin && isSameGoal)
+    {
+        for (auto& history : key.History)
+        {
+            if (history.x == loc.x && history.y == loc.y && history.z == loc.z)
+            {
+                history.direction &= permittedEdges;
+                if (history.direction == 0)
+                    history.direction = permittedEdges;
+                edges = history.direction;
+                break;
+            }
+        }
+    }
+
+    // A new goal clears the history, as peep_pathfind_choose_direction does.
+    if (!direction_valid(guest->PathfindGoal.direction) || !isSameGoal)
+        key.History.fill({ 0xFF, 0xFF, 0xFF, 0xFF });
+
+    // Only junctions with more than one edge left to try are searched.
+    if ((edges & (edges - 1)) == 0)
+        return false;
+
+    key.Edges = edges;
+    key.MaxJunctions = guest_pathfind_get_max_number_junctions(guest);
+    key.IgnoreForeignQueues = true;
+    key.QueueRideIndex = (guest->OutsideOfPark || (guest->PeepFlags & PEEP_FLAGS_LEAVING_PARK)) ? RIDE_ID_NULL
+                                                                                              : guest->GuestHeadingToRideId;
+    search.Searcher = guest;
+    search.FirstElement = firstElement;
+    return true;
+}
+
+static void guest_pathfind_run_prepared_search(PreparedGuestSearch& search)
+{
+    _peepPathFindIsStaff = false;
+    _peepPathFindIsPrepared = true;
+    _peepPathFindMaxJunctions = search.Key.MaxJunctions;
+    gPeepPathFindGoalPosition = search.Key.Goal;
+    gPeepPathFindIgnoreForeignQueues = search.Key.IgnoreForeignQueues;
+    gPeepPathFindQueueRideIndex = search.Key.QueueRideIndex;
+
+    search.Result.Edge = peep_pathfind_search_edges(
+        search.Key.Start, search.Searcher, search.FirstElement, search.Key.Edges, &search.Result.TilesChecked);
+
+    _peepPathFindIsPrepared = false;
+}
+
+void PathfindPrepareGuestSearches()
+{
+    if (!gConfigGeneral.multithreaded_pathfinding)
+        return;
+
+    // Nothing changes the map or the guests while the searches run, they only read them.
+    _peepPathFindIsStaff = false;
+    auto& searches = _preparedGuestSearches;
+    searches.clear();
+    std::unordered_set<PathfindSearchKey, PathfindSearchKeyHash> keys;
+    for (auto* guest : EntityList<Guest>())
+    {
+        PreparedGuestSearch search;
+        if (!guest_pathfind_get_upcoming_search(guest, search))
+            continue;
+        if (peep_pathfind_is_search_cached(search.Key) || !keys.insert(search.Key).second)
+            continue;
+
+        searches.push_back(search);
+    }
+    if (searches.empty())
+        return;
+
+    OpenRCT2::TaskGroup tasks(OpenRCT2::GetContext()->GetTaskScheduler());
+    for (auto& search : searches)
+    {
+        auto* searchPtr = &search;
+        tasks.Run([searchPtr]() { guest_pathfind_run_prepared_search(*searchPtr); });
+    }
+    tasks.Wait();
+
+    // Remembered in entity order, so every machine remembers the same results.
+    for (const auto& search : searches)
+    {
+        peep_pathfind_cache_search(search.Key, search.Result);
+    }
+}
+
 /**
  * Gets the nearest park entrance relative to point, by using Manhattan distance.
  * @param x x coordinate of location
@@ -1982,6 +2524,8 @@ static StationIndex guest_pathfinding_select_random_station(
  */
 int32_t guest_path_finding(Guest* peep)
 {
+    _peepPathFindStatistics.Decisions++;
+
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     PathfindLoggingEnable(peep);
     if (_pathFindDebug)
@@ -22,12 +22,12 @@ struct TileElement;
 //
 // This gets copied into Peep::PathfindGoal. The two separate variables are needed because
 // when the goal changes the peep's pathfind history needs to be reset.
-extern TileCoordsXYZ gPeepPathFindGoalPosition;
+extern thread_local TileCoordsXYZ gPeepPathFindGoalPosition;
 
 // When the heuristic pathfinder is examining neighboring tiles, one possibility is that it finds a
 // queue tile; furthermore, this queue tile may or may not be for the ride that the peep is trying
 // to get to, if any. This first var is used to store the ride that the peep is currently headed to.
-extern ride_id_t gPeepPathFindQueueRideIndex;
+extern thread_local ride_id_t gPeepPathFindQueueRideIndex;
 
 // Furthermore, staff members don't care about this stuff; even if they are e.g. a mechanic headed
 // to a particular ride, they have no issues with walking over queues for other rides to get there.
@@ -35,12 +35,40 @@ extern ride_id_t gPeepPathFindQueueRideIndex;
 // than their target ride, and if false, they will treat it like a regular path.
 //
 // In practice, if this is false, gPeepPathFindQueueRideIndex is always RIDE_ID_NULL.
-extern bool gPeepPathFindIgnoreForeignQueues;
+extern thread_local bool gPeepPathFindIgnoreForeignQueues;
 
 // Given a peep 'peep' at tile 'loc', who is trying to get to 'gPeepPathFindGoalPosition', decide
 // the direction the peep should walk in from the current tile.
 Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep);
 
+// Resets the number of tiles guest searches may check in the current tick, see
+// gConfigGeneral.pathfinding_tick_budget. Once it has been used up, guests at a junction keep
+// walking straight on when they can instead of searching. The budget is a local setting, so there
+// is no limit in network games and while a replay is recorded or played back.
+void PathfindResetTickBudget();
+
+// Runs the searches of guests that are about to arrive at a junction on all cores and remembers
+// the results, so the guests find them when they get there. Only the results of searches the
+// guests would run anyway are kept, so the guests choose the same directions as without it.
+// Enabled by gConfigGeneral.multithreaded_pathfinding.
+void PathfindPrepareGuestSearches();
+
+// Counts of the pathfinding work done on the main thread since the last call to
+// PathfindResetStatistics, used by the pathfinding benchmarks.
+struct PathfindStatistics
+{
+    // Calls to guest_path_finding.
+    uint64_t Decisions;
+    // Junctions where the heuristic search was run, and where a remembered guest search was used instead.
+    uint64_t Searches;
+    uint64_t CachedSearches;
+    // Tiles checked by the searches that were run.
+    uint64_t TilesChecked;
+};
+
+const PathfindStatistics& PathfindGetStatistics();
+void PathfindResetStatistics();
+
 // Test whether the given tile can be walked onto, if the peep is currently at height currentZ and
 // moving in direction currentDirection.
 bool IsValidPathZAndDirection(TileElement* tileElement, int32_t currentZ, int32_t currentDirection);
@@ -202,6 +202,9 @@ void peep_update_all()
     if (gScreenFlags & SCREEN_FLAGS_EDITOR)
         return;
 
+    PathfindResetTickBudget();
+    PathfindPrepareGuestSearches();
+
     int32_t i = 0;
     // Warning this loop can delete peeps
     for (auto peep : EntityList<Guest>())
@@ -855,42 +858,42 @@ static void peep_update_thoughts(Guest* peep)
     // 220 ticks in age between them. In order to
     // allow this when a thought is new it enters
     // a holding zone. Before it becomes fresh.
+    auto& thoughts = peep->GetThoughts();
     int32_t add_fresh = 1;
     int32_t fresh_thought = -1;
     for (int32_t i = 0; i < PEEP_MAX_THOUGHTS; i++)
     {
-        if (peep->Thoughts[i].type == PeepThoughtType::None)
+        if (thoughts[i].type == PeepThoughtType::None)
             break;
 
-        if (peep->Thoughts[i].freshness == 1)
+        if (thoughts[i].freshness == 1)
         {
             add_fresh = 0;
             // If thought is fresh we wait 220 ticks
             // before allowing a new thought to become fresh.
-            if (++peep->Thoughts[i].fresh_timeout >= 220)
+            if (++thoughts[i].fresh_timeout >= 220)
             {
-                peep->Thoughts[i].fresh_timeout = 0;
+                thoughts[i].fresh_timeout = 0;
                 // Thought is no longer fresh
-                peep->Thoughts[i].freshness++;
+                thoughts[i].freshness++;
                 add_fresh = 1;
             }
         }
-        else if (peep->Thoughts[i].freshness > 1)
+        else if (thoughts[i].freshness > 1)
         {
-            if (++peep->Thoughts[i].fresh_timeout == 0)
+            if (++thoughts[i].fresh_timeout == 0)
             {
                 // When thought is older than ~6900 ticks remove it
-                if (++peep->Thoughts[i].freshness >= 28)
+                if (++thoughts[i].freshness >= 28)
                 {
                     peep->WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
 
                     // Clear top thought, push others up
                     if (i < PEEP_MAX_THOUGHTS - 2)
                     {
-                        memmove(
-                            &peep->Thoughts[i], &peep->Thoughts[i + 1], sizeof(rct_peep_thought) * (PEEP_MAX_THOUGHTS - i - 1));
+                        memmove(&thoughts[i], &thoughts[i + 1], sizeof(rct_peep_thought) * (PEEP_MAX_THOUGHTS - i - 1));
                     }
-                    peep->Thoughts[PEEP_MAX_THOUGHTS - 1].type = PeepThoughtType::None;
+                    thoughts[PEEP_MAX_THOUGHTS - 1].type = PeepThoughtType::None;
                 }
             }
         }
@@ -904,7 +907,7 @@ static void peep_update_thoughts(Guest* peep)
     // fresh.
     if (add_fresh && fresh_thought != -1)
     {
-        peep->Thoughts[fresh_thought].freshness = 1;
+        thoughts[fresh_thought].freshness = 1;
         peep->WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
     }
 }
@@ -1001,10 +1004,10 @@ void peep_problem_warnings_update()
 
     for (auto peep : EntityList<Guest>())
     {
-        if (peep->OutsideOfPark || peep->Thoughts[0].freshness > 5)
+        if (peep->OutsideOfPark || peep->GetThoughts()[0].freshness > 5)
             continue;
 
-        switch (peep->Thoughts[0].type)
+        switch (peep->GetThoughts()[0].type)
         {
             case PeepThoughtType::Lost: // 0x10
                 lost_counter++;
@@ -1695,6 +1698,8 @@ static bool peep_interact_with_entrance(Peep* peep, const CoordsXYE& coords, uin
         ride->stations[stationNum].LastPeepInQueue = guest->sprite_index;
         guest->GuestNextInQueue = previous_last;
         ride->stations[stationNum].QueueLength++;
+        guest_queue_set_guest_behind(guest->sprite_index, SPRITE_INDEX_NULL);
+        guest_queue_set_guest_behind(previous_last, guest->sprite_index);
 
         guest->CurrentRide = rideIndex;
         guest->CurrentRideStation = stationNum;
@@ -2121,6 +2126,8 @@ static void peep_interact_with_path(Peep* peep, const CoordsXYE& coords)
                     ride->stations[stationNum].LastPeepInQueue = guest->sprite_index;
                     guest->GuestNextInQueue = old_last_peep;
                     ride->stations[stationNum].QueueLength++;
+                    guest_queue_set_guest_behind(guest->sprite_index, SPRITE_INDEX_NULL);
+                    guest_queue_set_guest_behind(old_last_peep, guest->sprite_index);
 
                     peep_decrement_num_riders(guest);
                     guest->CurrentRide = rideIndex;
@@ -494,6 +494,19 @@ struct rct_peep_thought
     uint8_t fresh_timeout; // 3 updates every tick
 };
 
+/**
+ * The parts of a guest that are rarely read during the game tick. They are kept in a table indexed by sprite index
+ * next to the guests rather than in the guest entity, so that the fields the tick does read stay close together.
+ */
+struct GuestColdData
+{
+    std::array<uint8_t, 16> RideTypesBeenOn;
+    // 255 bit bitmap of every ride the peep has been on see
+    // window_peep_rides_update for how to use.
+    std::array<uint8_t, 32> RidesBeenOn;
+    std::array<rct_peep_thought, PEEP_MAX_THOUGHTS> Thoughts;
+};
+
 struct Guest;
 struct Staff;
 
@@ -693,11 +706,7 @@ public:
     uint8_t TimeToConsume;
     IntensityRange Intensity{ 0 };
     PeepNauseaTolerance NauseaTolerance;
-    uint8_t RideTypesBeenOn[16];
     uint16_t TimeInQueue;
-    // 255 bit bitmap of every ride the peep has been on see
-    // window_peep_rides_update for how to use.
-    uint8_t RidesBeenOn[32];
     money32 CashInPocket;
     money32 CashSpent;
     ride_id_t Photo1RideRef;
@@ -708,7 +717,6 @@ public:
     int8_t RejoinQueueTimeout; // whilst waiting for a free vehicle (or pair) in the entrance
     ride_id_t PreviousRide;
     uint16_t PreviousRideTimeOut;
-    std::array<rct_peep_thought, PEEP_MAX_THOUGHTS> Thoughts;
     // 0x3F Litter Count split into lots of 3 with time, 0xC0 Time since last recalc
     uint8_t LitterCount;
     // 0x3F Sick Count split into lots of 3 with time, 0xC0 Time since last recalc
@@ -783,6 +791,38 @@ public:
     void GiveItem(ShopItem item);
     bool HasItem(ShopItem peepItem) const;
     void Serialise(DataSerialiser& stream);
+    /**
+     * Serialises the guest with the given cold data instead of its own, for guests that are not part of the game state,
+     * such as the ones in a snapshot.
+     */
+    void Serialise(DataSerialiser& stream, GuestColdData& coldData);
+
+    GuestColdData& GetColdData();
+    const GuestColdData& GetColdData() const;
+    std::array<rct_peep_thought, PEEP_MAX_THOUGHTS>& GetThoughts()
+    {
+        return GetColdData().Thoughts;
+    }
+    const std::array<rct_peep_thought, PEEP_MAX_THOUGHTS>& GetThoughts() const
+    {
+        return GetColdData().Thoughts;
+    }
+    std::array<uint8_t, 32>& GetRidesBeenOn()
+    {
+        return GetColdData().RidesBeenOn;
+    }
+    const std::array<uint8_t, 32>& GetRidesBeenOn() const
+    {
+        return GetColdData().RidesBeenOn;
+    }
+    std::array<uint8_t, 16>& GetRideTypesBeenOn()
+    {
+        return GetColdData().RideTypesBeenOn;
+    }
+    const std::array<uint8_t, 16>& GetRideTypesBeenOn() const
+    {
+        return GetColdData().RideTypesBeenOn;
+    }
 
 private:
     void UpdateRide();
@@ -861,6 +901,7 @@ public:
     bool IsMechanic() const;
     bool IsPatrolAreaSet(const CoordsXY& coords) const;
     bool IsLocationInPatrol(const CoordsXY& loc) const;
+    bool IsOwnedLocationInPatrol(const CoordsXY& loc) const;
     bool IsLocationOnPatrolEdge(const CoordsXY& loc) const;
     bool DoPathFinding();
     uint8_t GetCostume() const;
@@ -1018,6 +1059,12 @@ void peep_update_names(bool realNames);
 
 void guest_set_name(uint16_t spriteIndex, const char* name);
 
+/**
+ * Tells the queues which guest is now directly behind the given guest, behindIndex being SPRITE_INDEX_NULL when the
+ * guest is at the back of their queue.
+ */
+void guest_queue_set_guest_behind(uint16_t spriteIndex, uint16_t behindIndex);
+
 void increment_guests_in_park();
 void increment_guests_heading_for_park();
 void decrement_guests_in_park();
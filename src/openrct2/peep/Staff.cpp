@@ -173,6 +173,14 @@ bool Staff::IsLocationInPatrol(const CoordsXY& loc) const
     if (!map_is_location_owned_or_has_rights(loc))
         return false;
 
+    return IsOwnedLocationInPatrol(loc);
+}
+
+/**
+ * Same as IsLocationInPatrol for a location that is known to be owned or to have construction rights.
+ */
+bool Staff::IsOwnedLocationInPatrol(const CoordsXY& loc) const
+{
     // Check if staff has patrol area
     if (gStaffModes[StaffId] != StaffMode::Patrol)
         return true;
@@ -424,7 +432,8 @@ Direction Staff::HandymanDirectionToNearestLitter() const
 {
     uint16_t nearestLitterDist = 0xFFFF;
     Litter* nearestLitter = nullptr;
-    for (auto litter : EntityList<Litter>())
+    // Litter can only be within MAX_LITTER_DISTANCE if it is that close on both axes.
+    for (auto litter : EntityRangeList<Litter>({ x, y }, MAX_LITTER_DISTANCE))
     {
         uint16_t distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
 
@@ -961,24 +970,12 @@ bool Staff::DoMiscPathFinding()
  */
 void Staff::EntertainerUpdateNearbyPeeps() const
 {
-    for (auto guest : EntityList<Guest>())
+    for (auto guest : EntityRangeList<Guest>({ x, y }, 96))
     {
-        if (guest->x == LOCATION_NULL)
-            continue;
-
         int16_t z_dist = abs(z - guest->z);
         if (z_dist > 48)
             continue;
 
-        int16_t x_dist = abs(x - guest->x);
-        int16_t y_dist = abs(y - guest->y);
-
-        if (x_dist > 96)
-            continue;
-
-        if (y_dist > 96)
-            continue;
-
         if (guest->State == PeepState::Walking)
         {
             guest->HappinessTarget = std::min(guest->HappinessTarget + 4, PEEP_MAX_HAPPINESS);
@@ -16,6 +16,7 @@
 #    include "platform.h"
 
 #    include <clocale>
+#    include <cstdio>
 #    include <cstdlib>
 #    include <cstring>
 #    include <ctime>
@@ -190,6 +191,30 @@ namespace Platform
         return size;
     }
 
+    uint64_t GetProcessBytesRead()
+    {
+        uint64_t bytesRead = 0;
+#    ifdef __linux__
+        // rchar counts all bytes passed to read calls, including those served from the page cache.
+        auto file = fopen("/proc/self/io", "r");
+        if (file != nullptr)
+        {
+            char line[64];
+            while (fgets(line, sizeof(line), file) != nullptr)
+            {
+                unsigned long long value;
+                if (sscanf(line, "rchar: %llu", &value) == 1)
+                {
+                    bytesRead = value;
+                    break;
+                }
+            }
+            fclose(file);
+        }
+#    endif // __linux__
+        return bytesRead;
+    }
+
     bool ShouldIgnoreCase()
     {
         return false;
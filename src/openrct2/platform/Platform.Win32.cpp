@@ -259,6 +259,16 @@ namespace Platform
         return result;
     }
 
+    uint64_t GetProcessBytesRead()
+    {
+        IO_COUNTERS counters{};
+        if (GetProcessIoCounters(GetCurrentProcess(), &counters))
+        {
+            return counters.ReadTransferCount;
+        }
+        return 0;
+    }
+
     bool IsRunningInWine()
     {
         HMODULE ntdllMod = GetModuleHandleW(L"ntdll.dll");
@@ -40,6 +40,10 @@ namespace Platform
     utf8* GetAbsolutePath(utf8* buffer, size_t bufferSize, const utf8* relativePath);
     uint64_t GetLastModified(const std::string& path);
     uint64_t GetFileSize(std::string_view path);
+    /**
+     * Returns the number of bytes the process has read from files so far, or 0 where the platform does not report it.
+     */
+    uint64_t GetProcessBytesRead();
     std::string ResolveCasing(const std::string& path, bool fileExists);
     rct2_time GetTimeLocal();
     rct2_date GetDateLocal();
@@ -143,9 +143,6 @@ private:
     std::bitset<MAX_RIDE_OBJECTS> _researchRideEntryUsed{};
     std::bitset<RCT1_RIDE_TYPE_COUNT> _researchRideTypeUsed{};
 
-    // Scenario repository - used for determining scenario name
-    IScenarioRepository* _scenarioRepository = GetScenarioRepository();
-
 public:
     ParkLoadResult Load(const utf8* path) override
     {
@@ -280,6 +277,37 @@ public:
         return true;
     }
 
+    bool LoadInfo(const utf8* path, ParkFileInfo* dst) override
+    {
+        // The whole park is a single chunk in RCT1, so only loading the objects and the map can be skipped.
+        auto fs = FileStream(path, FILE_MODE_OPEN);
+        _s4 = *ReadAndDecodeS4(&fs, String::Equals(Path::GetExtension(path), ".sc4", true));
+        _gameVersion = sawyercoding_detect_rct1_version(_s4.game_version) & FILE_VERSION_MASK;
+
+        dst->Name = rct2_to_utf8(_s4.scenario_name, RCT2LanguageId::EnglishUK);
+        if (is_user_string_id(static_cast<rct_string_id>(_s4.park_name_string_index)))
+        {
+            std::string userString = GetUserString(_s4.park_name_string_index);
+            if (!userString.empty())
+            {
+                dst->Name = userString;
+            }
+        }
+        dst->MonthsElapsed = _s4.month;
+        dst->NumGuests = _s4.guests_in_park;
+        dst->Cash = _s4.cash;
+        dst->ParkRating = _s4.park_rating;
+        dst->ObjectiveType = _s4.scenario_objective_type;
+        dst->ObjectiveYear = _s4.scenario_objective_years;
+        dst->ObjectiveNumGuests = _s4.scenario_objective_type == OBJECTIVE_BUILD_THE_BEST
+            ? GetBuildTheBestRideId()
+            : _s4.scenario_objective_num_guests;
+        dst->ObjectiveCurrency = _s4.scenario_objective_type == OBJECTIVE_PARK_VALUE_BY
+            ? CorrectRCT1ParkValue(_s4.scenario_objective_currency)
+            : _s4.scenario_objective_currency;
+        return true;
+    }
+
     int32_t CorrectRCT1ParkValue(money32 oldParkValue)
     {
         if (oldParkValue == MONEY32_UNDEFINED)
@@ -356,7 +384,8 @@ private:
 
     std::string GetRCT1ScenarioName()
     {
-        const scenario_index_entry* scenarioEntry = _scenarioRepository->GetByInternalName(_s4.scenario_name);
+        // The repository is only asked for here, as the scenario index creates importers while it is being scanned.
+        const scenario_index_entry* scenarioEntry = GetScenarioRepository()->GetByInternalName(_s4.scenario_name);
         if (scenarioEntry == nullptr)
         {
             return "";
@@ -2828,11 +2857,11 @@ template<> void S4Importer::ImportEntity<Guest>(const RCT12SpriteBase& srcBase)
 
     for (size_t i = 0; i < 32; i++)
     {
-        dst->RidesBeenOn[i] = src->rides_been_on[i];
+        dst->GetRidesBeenOn()[i] = src->rides_been_on[i];
     }
     for (size_t i = 0; i < 16; i++)
     {
-        dst->RideTypesBeenOn[i] = src->ride_types_been_on[i];
+        dst->GetRideTypesBeenOn()[i] = src->ride_types_been_on[i];
     }
 
     dst->Photo1RideRef = RCT12RideIdToOpenRCT2RideId(src->photo1_ride_ref);
@@ -2840,7 +2869,7 @@ template<> void S4Importer::ImportEntity<Guest>(const RCT12SpriteBase& srcBase)
     for (size_t i = 0; i < std::size(src->thoughts); i++)
     {
         auto srcThought = &src->thoughts[i];
-        auto dstThought = &dst->Thoughts[i];
+        auto dstThought = &dst->GetThoughts()[i];
         dstThought->type = static_cast<PeepThoughtType>(srcThought->type);
         dstThought->item = srcThought->item;
         dstThought->freshness = srcThought->freshness;
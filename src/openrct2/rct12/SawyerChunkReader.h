@@ -14,7 +14,11 @@
 #include "../util/SawyerCoding.h"
 #include "SawyerChunk.h"
 
+#include <array>
+#include <initializer_list>
 #include <memory>
+#include <utility>
+#include <vector>
 
 class SawyerChunkException : public IOException
 {
@@ -34,6 +38,53 @@ namespace OpenRCT2
     struct IStream;
 }
 
+/**
+ * Where a chunk is in a stream, so that it can be read later without reading the chunks before it again.
+ */
+struct SawyerChunkLocation
+{
+    uint64_t Position{};
+    sawyercoding_chunk_header Header{};
+};
+
+/**
+ * Decodes a chunk a part at a time, so that a large chunk can be converted as it is decoded rather than being decoded
+ * into a buffer of its own first.
+ */
+class SawyerChunkDecoder final
+{
+private:
+    sawyercoding_chunk_header _header{};
+    std::vector<uint8_t> _data;
+    size_t _srcPosition{};
+    size_t _dstPosition{};
+
+    // The RLE run being decoded
+    size_t _runLength{};
+    uint8_t _runValue{};
+    bool _runIsRepeat{};
+
+    // The repeat being decoded, which copies from the last 32 decoded bytes
+    std::array<uint8_t, 32> _history{};
+    size_t _copyLength{};
+    size_t _copyDistance{};
+
+public:
+    SawyerChunkDecoder() = default;
+    SawyerChunkDecoder(const sawyercoding_chunk_header& header, std::vector<uint8_t>&& data);
+
+    /**
+     * Decodes the next part of the chunk.
+     * @returns The number of bytes decoded, which is less than length once the end of the chunk is reached.
+     */
+    size_t Read(void* dst, size_t length);
+
+private:
+    size_t ReadRLE(uint8_t* dst, size_t length);
+    size_t ReadRepeat(uint8_t* dst, size_t length);
+    size_t ReadRotate(uint8_t* dst, size_t length);
+};
+
 /**
  * Reads sawyer encoding chunks from a data stream. This can be used to read
  * SC6, SV6 and RCT2 objects. persistentChunks is a hint to the reader that the chunk will be preserved,
@@ -51,8 +102,15 @@ public:
     /**
      * Skips the next chunk in the stream without decoding or reading its data
      * into RAM.
+     * @returns Where the skipped chunk is, for ReadChunkAt.
+     */
+    SawyerChunkLocation SkipChunk();
+
+    /**
+     * Reads the chunk at a location returned by SkipChunk, leaving the stream
+     * after it. Only that chunk is decoded.
      */
-    void SkipChunk();
+    std::shared_ptr<SawyerChunk> ReadChunkAt(const SawyerChunkLocation& location);
 
     /**
      * Reads the next chunk from the stream.
@@ -64,6 +122,12 @@ public:
      */
     std::shared_ptr<SawyerChunk> ReadChunkTrack();
 
+    /**
+     * Reads the next chunk from the stream without decoding it, the returned
+     * decoder decodes it a part at a time.
+     */
+    SawyerChunkDecoder ReadChunkDecoder();
+
     /**
      * Reads the next chunk from the stream and copies it directly to the
      * destination buffer. If the chunk is larger than length, only length
@@ -86,6 +150,14 @@ public:
         return result;
     }
 
+    /**
+     * Reads the next chunks from the stream, one for each destination, as
+     * ReadChunk(dst, length) would. The chunks are read from the stream in
+     * order and then decoded concurrently, each straight into its destination.
+     * @param destinations The destination buffer and its size for each chunk.
+     */
+    void ReadChunks(std::initializer_list<std::pair<void*, size_t>> destinations);
+
     /**
      * Frees the chunk data, to be used when destructing SawyerChunks
      */
@@ -93,10 +165,13 @@ public:
 
 private:
     static size_t DecodeChunk(void* dst, size_t dstCapacity, const void* src, const sawyercoding_chunk_header& header);
+    static void DecodeChunkInto(void* dst, size_t length, const void* src, const sawyercoding_chunk_header& header);
     static size_t DecodeChunkRLERepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRLE(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRotate(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
+    static size_t GetDecodedLengthRLE(const void* src, size_t srcLength);
+    static size_t GetDecodedLengthRepeat(const void* src, size_t srcLength);
 
     static void* AllocateLargeTempBuffer();
     static void* FinaliseLargeTempBuffer(void* buffer, size_t len);
@@ -72,6 +72,7 @@ void S6Exporter::SaveGame(const utf8* path)
 {
     auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_WRITE);
     SaveGame(&fs);
+    fs.Flush();
 }
 
 void S6Exporter::SaveGame(OpenRCT2::IStream* stream)
@@ -83,6 +84,7 @@ void S6Exporter::SaveScenario(const utf8* path)
 {
     auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_WRITE);
     SaveScenario(&fs);
+    fs.Flush();
 }
 
 void S6Exporter::SaveScenario(OpenRCT2::IStream* stream)
@@ -194,8 +196,6 @@ void S6Exporter::Export()
     _s6.scenario_srand_0 = state.s0;
     _s6.scenario_srand_1 = state.s1;
 
-    // Map elements must be reorganised prior to saving otherwise save may be invalid
-    ReorganiseTileElements();
     ExportTileElements();
     ExportEntities();
     ExportParkName();
@@ -1195,9 +1195,9 @@ template<> void S6Exporter::ExportEntity(RCT2SpritePeep* dst, const Guest* src)
     dst->intensity = static_cast<uint8_t>(src->Intensity);
     dst->nausea_tolerance = EnumValue(src->NauseaTolerance);
     dst->paid_on_drink = src->PaidOnDrink;
-    for (size_t i = 0; i < std::size(src->RideTypesBeenOn); i++)
+    for (size_t i = 0; i < std::size(src->GetRideTypesBeenOn()); i++)
     {
-        dst->ride_types_been_on[i] = src->RideTypesBeenOn[i];
+        dst->ride_types_been_on[i] = src->GetRideTypesBeenOn()[i];
     }
     dst->item_extra_flags = static_cast<uint32_t>(src->GetItemFlags() >> 32);
     dst->photo1_ride_ref = OpenRCT2RideIdToRCT12RideId(src->Photo1RideRef);
@@ -1206,9 +1206,9 @@ template<> void S6Exporter::ExportEntity(RCT2SpritePeep* dst, const Guest* src)
     dst->photo4_ride_ref = OpenRCT2RideIdToRCT12RideId(src->Photo4RideRef);
     dst->next_in_queue = src->GuestNextInQueue;
     dst->time_in_queue = src->TimeInQueue;
-    for (size_t i = 0; i < std::size(src->RidesBeenOn); i++)
+    for (size_t i = 0; i < std::size(src->GetRidesBeenOn()); i++)
     {
-        dst->rides_been_on[i] = src->RidesBeenOn[i];
+        dst->rides_been_on[i] = src->GetRidesBeenOn()[i];
     }
     dst->cash_in_pocket = src->CashInPocket;
     dst->cash_spent = src->CashSpent;
@@ -1216,9 +1216,9 @@ template<> void S6Exporter::ExportEntity(RCT2SpritePeep* dst, const Guest* src)
     dst->rejoin_queue_timeout = src->RejoinQueueTimeout;
     dst->previous_ride = OpenRCT2RideIdToRCT12RideId(src->PreviousRide);
     dst->previous_ride_time_out = src->PreviousRideTimeOut;
-    for (size_t i = 0; i < std::size(src->Thoughts); i++)
+    for (size_t i = 0; i < std::size(src->GetThoughts()); i++)
     {
-        auto srcThought = &src->Thoughts[i];
+        auto srcThought = &src->GetThoughts()[i];
         auto dstThought = &dst->thoughts[i];
         dstThought->type = static_cast<uint8_t>(srcThought->type);
         dstThought->item = srcThought->item;
@@ -1580,7 +1580,8 @@ void S6Exporter::ExportMapAnimations()
 
 void S6Exporter::ExportTileElements()
 {
-    const auto& tileElements = GetTileElements();
+    // The elements are returned in the order of their tiles, as the saved park requires.
+    const auto tileElements = GetTileElements();
     for (uint32_t index = 0; index < RCT2_MAX_TILE_ELEMENTS; index++)
     {
         auto dst = &_s6.tile_elements[index];
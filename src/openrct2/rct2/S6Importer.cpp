@@ -77,7 +77,8 @@ private:
     IObjectRepository& _objectRepository;
 
     const utf8* _s6Path = nullptr;
-    rct_s6_data _s6{};
+    rct_s6_data _s6;
+    SawyerChunkDecoder _tileElementsDecoder;
     uint8_t _gameVersion = 0;
     bool _isSV7 = false;
 
@@ -85,6 +86,13 @@ public:
     S6Importer(IObjectRepository& objectRepository)
         : _objectRepository(objectRepository)
     {
+        // The tile elements are converted straight from their chunk, so the legacy tile element array is left alone
+        // and its memory is never touched.
+        auto data = reinterpret_cast<uint8_t*>(&_s6);
+        auto tileElementsBegin = reinterpret_cast<uint8_t*>(_s6.tile_elements);
+        auto tileElementsEnd = tileElementsBegin + sizeof(_s6.tile_elements);
+        std::fill(data, tileElementsBegin, 0);
+        std::fill(tileElementsEnd, data + sizeof(_s6), 0);
     }
 
     ParkLoadResult Load(const utf8* path) override
@@ -167,27 +175,12 @@ public:
             _isSV7 = _stricmp(extension, ".sv7") == 0;
         }
 
-        if (isScenario)
-        {
-            chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
-            chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.tile_elements, sizeof(_s6.tile_elements));
-            chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 2560076);
-            chunkReader.ReadChunk(&_s6.guests_in_park, 4);
-            chunkReader.ReadChunk(&_s6.last_guests_in_park, 8);
-            chunkReader.ReadChunk(&_s6.park_rating, 2);
-            chunkReader.ReadChunk(&_s6.active_research_types, 1082);
-            chunkReader.ReadChunk(&_s6.current_expenditure, 16);
-            chunkReader.ReadChunk(&_s6.park_value, 4);
-            chunkReader.ReadChunk(&_s6.completed_company_value, 483816);
-        }
-        else
-        {
-            chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
-            chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.tile_elements, sizeof(_s6.tile_elements));
-            chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 3048816);
-        }
+        chunkReader.ReadChunks({
+            { &_s6.objects, sizeof(_s6.objects) },
+            { &_s6.elapsed_months, 16 },
+        });
+        _tileElementsDecoder = chunkReader.ReadChunkDecoder();
+        ReadGameStateChunks(chunkReader, isScenario);
 
         _s6Path = path;
 
@@ -200,6 +193,73 @@ public:
         return false;
     }
 
+    bool LoadInfo(const utf8* path, ParkFileInfo* dst) override
+    {
+        auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+        auto chunkReader = SawyerChunkReader(&fs);
+        chunkReader.ReadChunk(&_s6.header, sizeof(_s6.header));
+
+        bool isScenario = _s6.header.type == S6_TYPE_SCENARIO;
+        if (isScenario)
+        {
+            chunkReader.ReadChunk(&_s6.info, sizeof(_s6.info));
+        }
+        else if (_s6.header.type != S6_TYPE_SAVEDGAME)
+        {
+            return false;
+        }
+
+        // Nothing the details are made of is in the packed objects, the object list or the map.
+        for (uint16_t i = 0; i < _s6.header.num_packed_objects; i++)
+        {
+            fs.Seek(sizeof(rct_object_entry), OpenRCT2::STREAM_SEEK_CURRENT);
+            chunkReader.SkipChunk();
+        }
+        chunkReader.SkipChunk();
+        chunkReader.ReadChunk(&_s6.elapsed_months, 16);
+        chunkReader.SkipChunk();
+        ReadGameStateChunks(chunkReader, isScenario);
+
+        dst->Name = GetUserString(_s6.park_name);
+        dst->MonthsElapsed = _s6.elapsed_months;
+        dst->NumGuests = _s6.guests_in_park;
+        dst->Cash = DECRYPT_MONEY(_s6.cash);
+        dst->ParkRating = _s6.park_rating;
+        dst->ObjectiveType = _s6.objective_type;
+        dst->ObjectiveYear = _s6.objective_year;
+        dst->ObjectiveNumGuests = _s6.objective_type == OBJECTIVE_BUILD_THE_BEST
+            ? _s6.objective_guests - RCT2_RIDE_STRING_START
+            : _s6.objective_guests;
+        dst->ObjectiveCurrency = _s6.objective_currency;
+        return true;
+    }
+
+    /**
+     * Reads the chunks that follow the tile elements, which hold the entities and the rest of the game state.
+     */
+    void ReadGameStateChunks(SawyerChunkReader& chunkReader, bool isScenario)
+    {
+        if (isScenario)
+        {
+            chunkReader.ReadChunks({
+                { &_s6.next_free_tile_element_pointer_index, 2560076 },
+                { &_s6.guests_in_park, 4 },
+                { &_s6.last_guests_in_park, 8 },
+                { &_s6.park_rating, 2 },
+                { &_s6.active_research_types, 1082 },
+                { &_s6.current_expenditure, 16 },
+                { &_s6.park_value, 4 },
+                { &_s6.completed_company_value, 483816 },
+            });
+        }
+        else
+        {
+            chunkReader.ReadChunks({
+                { &_s6.next_free_tile_element_pointer_index, 3048816 },
+            });
+        }
+    }
+
     void Import() override
     {
         Initialise();
@@ -1034,10 +1094,27 @@ public:
         dst->num_riders = numRiders;
     }
 
+    /**
+     * Decodes the next element of the tile elements chunk, padding the chunk with zero up to the size of the legacy
+     * tile element array.
+     */
+    bool ReadTileElement(RCT12TileElement& element, size_t& numElementsRead)
+    {
+        if (numElementsRead >= RCT2_MAX_TILE_ELEMENTS)
+            return false;
+
+        auto length = _tileElementsDecoder.Read(&element, sizeof(element));
+        std::fill_n(reinterpret_cast<uint8_t*>(&element) + length, sizeof(element) - length, 0);
+        numElementsRead++;
+        return true;
+    }
+
     void ImportTileElements()
     {
-        // Build tile pointer cache (needed to get the first element at a certain location)
-        auto tilePointerIndex = TilePointerIndex<RCT12TileElement>(RCT2_MAXIMUM_MAP_SIZE_TECHNICAL, _s6.tile_elements);
+        // The elements are stored one tile after another in the same order as they are imported, so each one can be
+        // converted as it is decoded.
+        RCT12TileElement srcElement;
+        size_t numElementsRead = 0;
 
         std::vector<TileElement> tileElements;
         for (TileCoordsXY coords = { 0, 0 }; coords.y < MAXIMUM_MAP_SIZE_TECHNICAL; coords.y++)
@@ -1052,9 +1129,8 @@ public:
                     continue;
                 }
 
-                RCT12TileElement* srcElement = tilePointerIndex.GetFirstElementAt(coords);
                 // This might happen with damaged parks. Make sure there is *something* to avoid crashes.
-                if (srcElement == nullptr)
+                if (!ReadTileElement(srcElement, numElementsRead))
                 {
                     auto& dstElement = tileElements.emplace_back();
                     dstElement.ClearAs(TILE_ELEMENT_TYPE_SURFACE);
@@ -1065,22 +1141,22 @@ public:
                 do
                 {
                     auto& dstElement = tileElements.emplace_back();
-                    if (srcElement->base_height == RCT12_MAX_ELEMENT_HEIGHT)
+                    if (srcElement.base_height == RCT12_MAX_ELEMENT_HEIGHT)
                     {
-                        std::memcpy(&dstElement, srcElement, sizeof(*srcElement));
+                        std::memcpy(&dstElement, &srcElement, sizeof(srcElement));
                     }
                     else
                     {
-                        auto tileElementType = static_cast<RCT12TileElementType>(srcElement->GetType());
+                        auto tileElementType = static_cast<RCT12TileElementType>(srcElement.GetType());
                         // Todo: replace with setting invisibility bit
                         if (tileElementType == RCT12TileElementType::Corrupt
                             || tileElementType == RCT12TileElementType::EightCarsCorrupt14
                             || tileElementType == RCT12TileElementType::EightCarsCorrupt15)
-                            std::memcpy(&dstElement, srcElement, sizeof(*srcElement));
+                            std::memcpy(&dstElement, &srcElement, sizeof(srcElement));
                         else
-                            ImportTileElement(&dstElement, srcElement);
+                            ImportTileElement(&dstElement, &srcElement);
                     }
-                } while (!(srcElement++)->IsLastForTile());
+                } while (!srcElement.IsLastForTile() && ReadTileElement(srcElement, numElementsRead));
 
                 // Set last element flag in case the original last element was never added
                 if (tileElements.size() > 0)
@@ -1633,7 +1709,7 @@ template<> void S6Importer::ImportEntity<Guest>(const RCT12SpriteBase& baseSrc)
     dst->PaidOnDrink = src->paid_on_drink;
     for (size_t i = 0; i < std::size(src->ride_types_been_on); i++)
     {
-        dst->RideTypesBeenOn[i] = src->ride_types_been_on[i];
+        dst->GetRideTypesBeenOn()[i] = src->ride_types_been_on[i];
     }
     dst->SetItemFlags(src->GetItemFlags());
     dst->Photo1RideRef = RCT12RideIdToOpenRCT2RideId(src->photo1_ride_ref);
@@ -1644,7 +1720,7 @@ template<> void S6Importer::ImportEntity<Guest>(const RCT12SpriteBase& baseSrc)
     dst->TimeInQueue = src->time_in_queue;
     for (size_t i = 0; i < std::size(src->rides_been_on); i++)
     {
-        dst->RidesBeenOn[i] = src->rides_been_on[i];
+        dst->GetRidesBeenOn()[i] = src->rides_been_on[i];
     }
     dst->CashInPocket = src->cash_in_pocket;
     dst->CashSpent = src->cash_spent;
@@ -1655,7 +1731,7 @@ template<> void S6Importer::ImportEntity<Guest>(const RCT12SpriteBase& baseSrc)
     for (size_t i = 0; i < std::size(src->thoughts); i++)
     {
         auto srcThought = &src->thoughts[i];
-        auto dstThought = &dst->Thoughts[i];
+        auto dstThought = &dst->GetThoughts()[i];
         dstThought->type = static_cast<PeepThoughtType>(srcThought->type);
         dstThought->item = srcThought->item;
         dstThought->freshness = srcThought->freshness;
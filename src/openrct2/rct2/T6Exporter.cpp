@@ -36,7 +36,9 @@ bool T6Exporter::SaveTrack(const utf8* path)
     try
     {
         auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_WRITE);
-        return SaveTrack(&fs);
+        auto result = SaveTrack(&fs);
+        fs.Flush();
+        return result;
     }
     catch (const std::exception& e)
     {
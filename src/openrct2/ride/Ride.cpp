@@ -73,6 +73,7 @@
 #include <iterator>
 #include <limits>
 #include <optional>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -130,6 +131,15 @@ Direction gRideEntranceExitPlaceDirection;
 
 uint8_t gLastEntranceStyle;
 
+// While the rides are updated the staff does not change, so the mechanics are only gathered once for every breakdown
+// and inspection call in the tick.
+static struct
+{
+    bool Active{};
+    bool Gathered{};
+    std::vector<Staff*> Mechanics;
+} _rideUpdateMechanics;
+
 // Static function declarations
 Staff* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspection);
 static void ride_breakdown_status_update(Ride* ride);
@@ -345,10 +355,12 @@ void Ride::QueueInsertGuestAtFront(StationIndex stationIndex, Guest* peep)
     if (queueHeadGuest == nullptr)
     {
         stations[peep->CurrentRideStation].LastPeepInQueue = peep->sprite_index;
+        guest_queue_set_guest_behind(peep->sprite_index, SPRITE_INDEX_NULL);
     }
     else
     {
         queueHeadGuest->GuestNextInQueue = peep->sprite_index;
+        guest_queue_set_guest_behind(peep->sprite_index, queueHeadGuest->sprite_index);
     }
     UpdateQueueLength(peep->CurrentRideStation);
 }
@@ -1998,8 +2010,12 @@ void Ride::UpdateAll()
     window_update_viewport_ride_music();
 
     // Update rides
+    _rideUpdateMechanics.Active = true;
     for (auto& ride : GetRideManager())
         ride.Update();
+    _rideUpdateMechanics.Active = false;
+    _rideUpdateMechanics.Gathered = false;
+    _rideUpdateMechanics.Mechanics.clear();
 
     OpenRCT2::RideAudio::UpdateMusicChannels();
 }
@@ -2734,37 +2750,36 @@ Staff* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspec
     Staff* closestMechanic = nullptr;
     uint32_t closestDistance = std::numeric_limits<uint32_t>::max();
 
-    for (auto peep : EntityList<Staff>())
-    {
-        if (!peep->IsMechanic())
-            continue;
+    // Whether the entrance is in the park and owned is the same for every mechanic, so only look it up once.
+    const auto location = entrancePosition.ToTileStart();
+    const bool isInPark = map_is_location_in_park(location);
+    const bool isOwned = isInPark && map_is_location_owned_or_has_rights(location);
 
+    auto checkMechanic = [&](Staff* peep) {
         if (!forInspection)
         {
             if (peep->State == PeepState::HeadingToInspection)
             {
                 if (peep->SubState >= 4)
-                    continue;
+                    return;
             }
             else if (peep->State != PeepState::Patrolling)
-                continue;
+                return;
 
             if (!(peep->StaffOrders & STAFF_ORDERS_FIX_RIDES))
-                continue;
+                return;
         }
         else
         {
             if (peep->State != PeepState::Patrolling || !(peep->StaffOrders & STAFF_ORDERS_INSPECT_RIDES))
-                continue;
+                return;
         }
 
-        auto location = entrancePosition.ToTileStart();
-        if (map_is_location_in_park(location))
-            if (!peep->IsLocationInPatrol(location))
-                continue;
+        if (isInPark && (!isOwned || !peep->IsOwnedLocationInPatrol(location)))
+            return;
 
         if (peep->x == LOCATION_NULL)
-            continue;
+            return;
 
         // Manhattan distance
         uint32_t distance = std::abs(peep->x - entrancePosition.x) + std::abs(peep->y - entrancePosition.y);
@@ -2773,8 +2788,32 @@ Staff* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspec
             closestDistance = distance;
             closestMechanic = peep;
         }
+    };
+
+    if (!_rideUpdateMechanics.Active)
+    {
+        for (auto peep : EntityList<Staff>())
+        {
+            if (peep->IsMechanic())
+                checkMechanic(peep);
+        }
+        return closestMechanic;
     }
 
+    // The mechanics are kept in entity order, so ties are still broken the same way.
+    if (!_rideUpdateMechanics.Gathered)
+    {
+        for (auto peep : EntityList<Staff>())
+        {
+            if (peep->IsMechanic())
+                _rideUpdateMechanics.Mechanics.push_back(peep);
+        }
+        _rideUpdateMechanics.Gathered = true;
+    }
+    for (auto* peep : _rideUpdateMechanics.Mechanics)
+    {
+        checkMechanic(peep);
+    }
     return closestMechanic;
 }
 
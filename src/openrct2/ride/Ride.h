@@ -169,6 +169,11 @@ struct RideStation
     CoordsXYZ GetStart() const;
 };
 
+/**
+ * The samples shown in the ride graphs, one byte per sample for each graph and one sample every two ticks. A measurement
+ * is only created once the graphs of a ride are opened and at most MAX_RIDE_MEASUREMENTS are kept, so the memory used
+ * does not grow with the number of rides.
+ */
 struct RideMeasurement
 {
     static constexpr size_t MAX_ITEMS = 4800;
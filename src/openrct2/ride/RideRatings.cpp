@@ -122,7 +122,10 @@ void ride_ratings_update_all()
         return;
 
     // NOTE: Until the new save format only one ride can be updated at once.
-    // The SV6 format can store only a single state.
+    // The SV6 format can store only a single state, and the state is part of what a joining network client and a
+    // replay load, so any additional states would be lost and the ratings would go out of sync. The state machine
+    // already works on the state it is given, so updating several rides at once only needs a list of states that
+    // is saved and loaded in ride order.
     ride_ratings_update_state(gRideRatingUpdateState);
 }
 
@@ -848,11 +848,16 @@ void track_design_mirror(TrackDesign* td6)
 
 static void track_design_add_selection_tile(const CoordsXY& coords)
 {
-    auto tileIterator = std::find(gMapSelectionTiles.begin(), gMapSelectionTiles.end(), coords);
-    if (tileIterator == gMapSelectionTiles.end())
-    {
-        gMapSelectionTiles.push_back(coords);
-    }
+    // Duplicates are removed once the whole design has been outlined, see track_design_remove_duplicate_selection_tiles.
+    gMapSelectionTiles.push_back(coords);
+}
+
+static void track_design_remove_duplicate_selection_tiles()
+{
+    std::sort(gMapSelectionTiles.begin(), gMapSelectionTiles.end(), [](const CoordsXY& a, const CoordsXY& b) {
+        return a.y != b.y ? a.y < b.y : a.x < b.x;
+    });
+    gMapSelectionTiles.erase(std::unique(gMapSelectionTiles.begin(), gMapSelectionTiles.end()), gMapSelectionTiles.end());
 }
 
 static void track_design_update_max_min_coordinates(const CoordsXYZ& coords)
@@ -1834,6 +1839,7 @@ int32_t place_virtual_track(TrackDesign* td6, uint8_t ptdOperation, bool placeSc
     // 0x6D0FE6
     if (_trackDesignPlaceOperation == PTD_OPERATION_DRAW_OUTLINES)
     {
+        track_design_remove_duplicate_selection_tiles();
         gMapSelectFlags |= MAP_SELECT_FLAG_ENABLE_CONSTRUCT;
         gMapSelectFlags |= MAP_SELECT_FLAG_ENABLE_ARROW;
         gMapSelectFlags &= ~MAP_SELECT_FLAG_GREEN;
@@ -27,6 +27,9 @@
 #include "TrackData.h"
 #include "TrackDesign.h"
 
+#include <array>
+#include <memory>
+
 // clang-format off
 /* rct2: 0x007667AC */
 static constexpr TileCoordsXY EntranceOffsetEdgeNE[] = {
@@ -2159,6 +2162,38 @@ void track_paint_util_left_corkscrew_up_supports(paint_session* session, Directi
     }
 }
 
+using TrackPaintFunctionTable = std::array<std::array<TRACK_PAINT_FUNCTION, TrackElemType::Count>, RIDE_TYPE_COUNT>;
+
+/**
+ * Gets the paint function of every track piece of every ride type up front, as the getters switch over the track type
+ * every time they are called. The getters do not depend on anything but the track type, so the table never changes.
+ */
+static std::unique_ptr<TrackPaintFunctionTable> CreateTrackPaintFunctionTable()
+{
+    auto table = std::make_unique<TrackPaintFunctionTable>();
+    for (size_t rideType = 0; rideType < RIDE_TYPE_COUNT; rideType++)
+    {
+        auto paintFunctionGetter = RideTypeDescriptors[rideType].TrackPaintFunction;
+        for (track_type_t trackType = 0; trackType < TrackElemType::Count; trackType++)
+        {
+            (*table)[rideType][trackType] = paintFunctionGetter != nullptr ? paintFunctionGetter(trackType) : nullptr;
+        }
+    }
+    return table;
+}
+
+static TRACK_PAINT_FUNCTION GetTrackPaintFunction(ObjectEntryIndex rideType, track_type_t trackType)
+{
+    // Paint sessions may run on several threads, the initialisation of the static is thread safe.
+    static const auto table = CreateTrackPaintFunctionTable();
+    if (trackType >= TrackElemType::Count)
+    {
+        auto paintFunctionGetter = RideTypeDescriptors[rideType].TrackPaintFunction;
+        return paintFunctionGetter != nullptr ? paintFunctionGetter(trackType) : nullptr;
+    }
+    return (*table)[rideType][trackType];
+}
+
 /**
  *
  *  rct2: 0x006C4794
@@ -2237,14 +2272,10 @@ void track_paint(paint_session* session, Direction direction, int32_t height, co
         {
             return;
         }
-        TRACK_PAINT_FUNCTION_GETTER paintFunctionGetter = ride->GetRideTypeDescriptor().TrackPaintFunction;
-        if (paintFunctionGetter != nullptr)
+        TRACK_PAINT_FUNCTION paintFunction = GetTrackPaintFunction(ride->type, trackType);
+        if (paintFunction != nullptr)
         {
-            TRACK_PAINT_FUNCTION paintFunction = paintFunctionGetter(trackType);
-            if (paintFunction != nullptr)
-            {
-                paintFunction(session, rideIndex, trackSequence, direction, height, tileElement);
-            }
+            paintFunction(session, rideIndex, trackSequence, direction, height, tileElement);
         }
     }
 }
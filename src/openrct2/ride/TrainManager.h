@@ -7,8 +7,9 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 #pragma once
+#include "../world/EntityList.h"
+
 #include <cstdint>
-#include <list>
 
 struct Vehicle;
 
@@ -18,17 +19,17 @@ namespace TrainManager
     class View
     {
     private:
-        const std::list<uint16_t>* vec;
+        const EntityIndexSet* vec;
 
         class Iterator
         {
         private:
-            std::list<uint16_t>::const_iterator iter;
-            std::list<uint16_t>::const_iterator end;
+            EntityIndexSet::const_iterator iter;
+            EntityIndexSet::const_iterator end;
             Vehicle* Entity = nullptr;
 
         public:
-            Iterator(std::list<uint16_t>::const_iterator _iter, std::list<uint16_t>::const_iterator _end)
+            Iterator(EntityIndexSet::const_iterator _iter, EntityIndexSet::const_iterator _end)
                 : iter(_iter)
                 , end(_end)
             {
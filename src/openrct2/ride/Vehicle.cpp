@@ -738,72 +738,58 @@ template<> bool SpriteBase::Is<Vehicle>() const
     return Type == EntityType::Vehicle;
 }
 
-static bool vehicle_move_info_valid(
-    VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction, int32_t offset)
-{
-    uint16_t typeAndDirection = (type << 2) | (direction & 3);
+// The number of track type and direction combinations that have move info, for each subposition.
+static constexpr uint16_t VehicleMoveInfoListCounts[] = {
+    VehicleTrackSubpositionSizeDefault, // Default
+    692,                                // ChairliftGoingOut
+    404,                                // ChairliftGoingBack
+    404,                                // ChairliftEndBullwheel
+    404,                                // ChairliftStartBullwheel
+    208,                                // GoKartsLeftLane
+    208,                                // GoKartsRightLane
+    208,                                // GoKartsMovingToRightLane
+    208,                                // GoKartsMovingToLeftLane
+    824,                                // MiniGolfPathA9
+    824,                                // MiniGolfBallPathA10
+    824,                                // MiniGolfPathB11
+    824,                                // MiniGolfBallPathB12
+    824,                                // MiniGolfPathC13
+    824,                                // MiniGolfBallPathC14
+    868,                                // ReverserRCFrontBogie
+    868,                                // ReverserRCRearBogie
+};
+static_assert(std::size(VehicleMoveInfoListCounts) == EnumValue(VehicleTrackSubposition::Count));
 
-    if (trackSubposition >= VehicleTrackSubposition{ std::size(gTrackVehicleInfo) })
-    {
-        return false;
-    }
-    int32_t size = 0;
-    switch (trackSubposition)
-    {
-        case VehicleTrackSubposition::Default:
-            size = VehicleTrackSubpositionSizeDefault;
-            break;
-        case VehicleTrackSubposition::ChairliftGoingOut:
-            size = 692;
-            break;
-        case VehicleTrackSubposition::ChairliftGoingBack:
-        case VehicleTrackSubposition::ChairliftEndBullwheel:
-        case VehicleTrackSubposition::ChairliftStartBullwheel:
-            size = 404;
-            break;
-        case VehicleTrackSubposition::GoKartsLeftLane:
-        case VehicleTrackSubposition::GoKartsRightLane:
-        case VehicleTrackSubposition::GoKartsMovingToRightLane:
-        case VehicleTrackSubposition::GoKartsMovingToLeftLane:
-            size = 208;
-            break;
-        case VehicleTrackSubposition::MiniGolfPathA9: // VehicleTrackSubposition::MiniGolfStart9
-        case VehicleTrackSubposition::MiniGolfBallPathA10:
-        case VehicleTrackSubposition::MiniGolfPathB11:
-        case VehicleTrackSubposition::MiniGolfBallPathB12:
-        case VehicleTrackSubposition::MiniGolfPathC13:
-        case VehicleTrackSubposition::MiniGolfBallPathC14:
-            size = 824;
-            break;
-        case VehicleTrackSubposition::ReverserRCFrontBogie:
-        case VehicleTrackSubposition::ReverserRCRearBogie:
-            size = 868;
-            break;
-        default:
-            break;
-    }
-    if (typeAndDirection >= size)
+/**
+ * Gets the move info of a track piece with a table lookup, vehicles look it up for every step they move.
+ */
+static const rct_vehicle_info_list* vehicle_get_move_info_list(
+    VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction)
+{
+    const auto subposition = static_cast<uint8_t>(trackSubposition);
+    if (subposition >= std::size(VehicleMoveInfoListCounts))
     {
-        return false;
+        return nullptr;
     }
-    if (offset >= gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->size)
+
+    uint16_t typeAndDirection = (type << 2) | (direction & 3);
+    if (typeAndDirection >= VehicleMoveInfoListCounts[subposition])
     {
-        return false;
+        return nullptr;
     }
-    return true;
+    return GetTrackVehicleInfoList(trackSubposition, typeAndDirection);
 }
 
 static const rct_vehicle_info* vehicle_get_move_info(
     VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction, int32_t offset)
 {
-    uint16_t typeAndDirection = (type << 2) | (direction & 3);
-
-    if (!vehicle_move_info_valid(trackSubposition, type, direction, offset))
+    const auto* moveInfoList = vehicle_get_move_info_list(trackSubposition, type, direction);
+    if (moveInfoList == nullptr || offset >= moveInfoList->size)
     {
         static constexpr const rct_vehicle_info zero = {};
         return &zero;
     }
-    return &gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->info[offset];
+    return &moveInfoList->info[offset];
 }
 
 const rct_vehicle_info* Vehicle::GetMoveInfo() const
@@ -813,13 +799,12 @@ const rct_vehicle_info* Vehicle::GetMoveInfo() const
 
 static uint16_t vehicle_get_move_info_size(VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction)
 {
-    uint16_t typeAndDirection = (type << 2) | (direction & 3);
-
-    if (!vehicle_move_info_valid(trackSubposition, type, direction, 0))
+    const auto* moveInfoList = vehicle_get_move_info_list(trackSubposition, type, direction);
+    if (moveInfoList == nullptr)
     {
         return 0;
     }
-    return gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->size;
+    return moveInfoList->size;
 }
 
 uint16_t Vehicle::GetTrackProgress() const
@@ -1224,6 +1209,31 @@ template<SoundType type> static bool ShouldUpdateChannelRate(const OpenRCT2::Aud
     return type == SoundType::TrackNoises || !(_soundParams[static_cast<uint8_t>(id)][1] & 1);
 }
 
+template<SoundType type>
+static void PlaySound(
+    const OpenRCT2::Audio::SoundId id, int32_t volume, OpenRCT2::Audio::VehicleSoundParams* sound_params,
+    OpenRCT2::Audio::Sound& sound)
+{
+    sound.Id = id;
+    sound.Pan = sound_params->pan_x;
+    sound.Volume = volume;
+    sound.Frequency = sound_params->frequency;
+    sound.Channel = nullptr;
+
+    // Sounds that can not be heard are not given a mixer channel. Looping sounds are started once they become audible,
+    // anything else is treated as played.
+    int32_t mixerVolume = DStoMixerVolume(volume);
+    if (mixerVolume > 0)
+    {
+        uint16_t frequency = SoundFrequency<type>(id, sound_params->frequency);
+        uint8_t looping = _soundParams[static_cast<uint8_t>(id)][0];
+        int32_t pan = sound_params->pan_x;
+        sound.Channel = Mixer_Play_Effect(
+            id, looping ? MIXER_LOOP_INFINITE : MIXER_LOOP_NONE, mixerVolume, DStoMixerPan(pan), DStoMixerRate(frequency),
+            0);
+    }
+}
+
 template<SoundType type>
 static void UpdateSound(
     const OpenRCT2::Audio::SoundId id, int32_t volume, OpenRCT2::Audio::VehicleSoundParams* sound_params,
@@ -1250,16 +1260,24 @@ static void UpdateSound(
 
     if ((sound.Id == OpenRCT2::Audio::SoundId::Null) || (id != sound.Id))
     {
-        sound.Id = id;
-        sound.Pan = sound_params->pan_x;
-        sound.Volume = volume;
-        sound.Frequency = sound_params->frequency;
-        uint16_t frequency = SoundFrequency<type>(id, sound_params->frequency);
-        uint8_t looping = _soundParams[static_cast<uint8_t>(id)][0];
-        int32_t pan = sound_params->pan_x;
-        sound.Channel = Mixer_Play_Effect(
-            id, looping ? MIXER_LOOP_INFINITE : MIXER_LOOP_NONE, DStoMixerVolume(volume), DStoMixerPan(pan),
-            DStoMixerRate(frequency), 0);
+        PlaySound<type>(id, volume, sound_params, sound);
+        return;
+    }
+
+    bool looping = _soundParams[static_cast<uint8_t>(id)][0] != 0;
+    if (sound.Channel == nullptr)
+    {
+        if (looping && DStoMixerVolume(volume) > 0)
+        {
+            PlaySound<type>(id, volume, sound_params, sound);
+        }
+        return;
+    }
+    if (looping && DStoMixerVolume(volume) <= 0)
+    {
+        // Free the mixer channel until the sound can be heard again
+        Mixer_Stop_Channel(sound.Channel);
+        sound.Channel = nullptr;
         return;
     }
     if (volume != sound.Volume)
@@ -1297,9 +1315,13 @@ void vehicle_sounds_update()
 
     vehicle_sounds_update_window_setup();
 
-    for (auto vehicle : TrainManager::View())
+    // No vehicle can be heard without a viewport to listen from
+    if (g_music_tracking_viewport != nullptr)
     {
-        vehicle->UpdateSoundParams(vehicleSoundParamsList);
+        for (auto vehicle : TrainManager::View())
+        {
+            vehicle->UpdateSoundParams(vehicleSoundParamsList);
+        }
     }
 
     // Stop all playing sounds that no longer have priority to play after vehicle_update_sound_params
@@ -9531,7 +9553,6 @@ int32_t Vehicle::UpdateTrackMotion(int32_t* outStation)
         unk_F64E20.x = car->x;
         unk_F64E20.y = car->y;
         unk_F64E20.z = car->z;
-        car->Invalidate();
 
         while (true)
         {
@@ -9555,7 +9576,9 @@ int32_t Vehicle::UpdateTrackMotion(int32_t* outStation)
             }
             if (car->remaining_distance < 0x368A)
             {
-                // Location found
+                // Location found, the car stays where it is but its sprite may have changed. Cars that move are
+                // invalidated at both positions by MoveTo.
+                car->Invalidate();
                 goto loc_6DBF3E;
             }
             if (car->UpdateTrackMotionForwards(vehicleEntry, curRide, rideEntry))
@@ -11,9 +11,103 @@
 
 #include "Vehicle.h"
 
+#include <array>
+#include <iterator>
+#include <vector>
+
+/*
+ * The move info is delta encoded at compile time, so only the encoded bytes end up in the binary. Each entry is
+ * encoded relative to the one before it, the entry before the first one being all zeroes:
+ *   0..26  x, y and z each change by -1, 0 or 1, the direction, pitch and bank rotation stay the same.
+ *   27..53 as above, followed by the new direction, pitch and bank rotation.
+ *   255    followed by the whole entry, with x, y and z little endian.
+ */
+static constexpr uint8_t VehicleInfoUnitDeltaCodes = 27;
+static constexpr uint8_t VehicleInfoFullCode = 255;
+static constexpr size_t VehicleInfoFullSize = 10;
+
+static constexpr bool IsUnitDelta(int32_t from, int32_t to)
+{
+    return to - from >= -1 && to - from <= 1;
+}
+
+static constexpr bool HasSameAttributes(const rct_vehicle_info& a, const rct_vehicle_info& b)
+{
+    return a.direction == b.direction && a.Pitch == b.Pitch && a.bank_rotation == b.bank_rotation;
+}
+
+static constexpr size_t GetEncodedVehicleInfoSize(const rct_vehicle_info& prev, const rct_vehicle_info& cur)
+{
+    if (!IsUnitDelta(prev.x, cur.x) || !IsUnitDelta(prev.y, cur.y) || !IsUnitDelta(prev.z, cur.z))
+        return VehicleInfoFullSize;
+    return HasSameAttributes(prev, cur) ? 1 : 4;
+}
+
+template<size_t TCount> static constexpr size_t GetEncodedVehicleInfoSize(const rct_vehicle_info (&data)[TCount])
+{
+    size_t size = 0;
+    rct_vehicle_info prev{};
+    for (size_t i = 0; i < TCount; i++)
+    {
+        size += GetEncodedVehicleInfoSize(prev, data[i]);
+        prev = data[i];
+    }
+    return size;
+}
+
+template<size_t TSize, size_t TCount>
+static constexpr std::array<uint8_t, TSize> EncodeVehicleInfo(const rct_vehicle_info (&data)[TCount])
+{
+    std::array<uint8_t, TSize> result{};
+    size_t pos = 0;
+    rct_vehicle_info prev{};
+    for (size_t i = 0; i < TCount; i++)
+    {
+        const auto& cur = data[i];
+        const auto entrySize = GetEncodedVehicleInfoSize(prev, cur);
+        if (entrySize == VehicleInfoFullSize)
+        {
+            result[pos++] = VehicleInfoFullCode;
+            for (int16_t value : { cur.x, cur.y, cur.z })
+            {
+                result[pos++] = static_cast<uint8_t>(value & 0xFF);
+                result[pos++] = static_cast<uint8_t>((value >> 8) & 0xFF);
+            }
+        }
+        else
+        {
+            auto code = (cur.x - prev.x + 1) + (cur.y - prev.y + 1) * 3 + (cur.z - prev.z + 1) * 9;
+            if (entrySize != 1)
+                code += VehicleInfoUnitDeltaCodes;
+            result[pos++] = static_cast<uint8_t>(code);
+        }
+        if (entrySize != 1)
+        {
+            result[pos++] = cur.direction;
+            result[pos++] = cur.Pitch;
+            result[pos++] = cur.bank_rotation;
+        }
+        prev = cur;
+    }
+    return result;
+}
+
+struct rct_vehicle_info_encoded_list
+{
+    uint16_t index;
+    uint16_t size;
+    const uint8_t* data;
+};
+
+static constexpr int32_t VehicleInfoListIndexBase = __COUNTER__ + 1;
+
 #define CREATE_VEHICLE_INFO(VAR, ...)                                                                                          \
     static constexpr const rct_vehicle_info VAR##_data[] = __VA_ARGS__;                                                        \
-    static constexpr const rct_vehicle_info_list VAR = { static_cast<uint16_t>(std::size(VAR##_data)), VAR##_data };
+    static constexpr const auto VAR##_encoded = EncodeVehicleInfo<GetEncodedVehicleInfoSize(VAR##_data)>(VAR##_data);         \
+    static constexpr const rct_vehicle_info_encoded_list VAR = {                                                               \
+        static_cast<uint16_t>(__COUNTER__ - VehicleInfoListIndexBase), static_cast<uint16_t>(std::size(VAR##_data)),           \
+        VAR##_encoded.data()                                                                                                   \
+    };
 
 // clang-format off
 CREATE_VEHICLE_INFO(TrackVehicleInfo_8BE57A, {
@@ -23891,7 +23985,7 @@ namespace RightLane
 
 CREATE_VEHICLE_INFO(TrackVehicleInfo_000000, { { 0, 0, 0, 0, 0, 0 } })
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListDefault[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListDefault[] = {
     &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C, &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0,  // Flat
     &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C, &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0,  // EndStation
     &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C, &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0,  // BeginStation
@@ -24162,7 +24256,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListDefault[] = {
 };
 static_assert(std::size(TrackVehicleInfoListDefault) == VehicleTrackSubpositionSizeDefault);
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListChairliftGoingOut[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListChairliftGoingOut[] = {
     &TrackVehicleInfo_8CDBE2, &TrackVehicleInfo_8CDD04, &TrackVehicleInfo_8CDE26, &TrackVehicleInfo_8CDF48, &TrackVehicleInfo_8CDBE2, &TrackVehicleInfo_8CDD04,
     &TrackVehicleInfo_8CDE26, &TrackVehicleInfo_8CDF48, &TrackVehicleInfo_8CDBE2, &TrackVehicleInfo_8CDD04, &TrackVehicleInfo_8CDE26, &TrackVehicleInfo_8CDF48,
     &TrackVehicleInfo_8CDBE2, &TrackVehicleInfo_8CDD04, &TrackVehicleInfo_8CDE26, &TrackVehicleInfo_8CDF48, &TrackVehicleInfo_8CFB6E, &TrackVehicleInfo_8CFC90,
@@ -24281,7 +24375,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListChairliftGoing
     &TrackVehicleInfo_91C1BC, &TrackVehicleInfo_91C377,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListChairliftGoingBack[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListChairliftGoingBack[] = {
     &TrackVehicleInfo_8CDE26, &TrackVehicleInfo_8CDF48, &TrackVehicleInfo_8CDBE2, &TrackVehicleInfo_8CDD04, &TrackVehicleInfo_8CDE26, &TrackVehicleInfo_8CDF48,
     &TrackVehicleInfo_8CDBE2, &TrackVehicleInfo_8CDD04, &TrackVehicleInfo_8CDE26, &TrackVehicleInfo_8CDF48, &TrackVehicleInfo_8CDBE2, &TrackVehicleInfo_8CDD04,
     &TrackVehicleInfo_8CDE26, &TrackVehicleInfo_8CDF48, &TrackVehicleInfo_8CDBE2, &TrackVehicleInfo_8CDD04, &TrackVehicleInfo_8D023A, &TrackVehicleInfo_8D035C,
@@ -24352,7 +24446,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListChairliftGoing
     &TrackVehicleInfo_8CDBE2, &TrackVehicleInfo_8CDD04,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListChairliftEndBullwheel[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListChairliftEndBullwheel[] = {
     &TrackVehicleInfo_8CE06A, &TrackVehicleInfo_8CE291, &TrackVehicleInfo_8CE4B8, &TrackVehicleInfo_8CE6DF, &TrackVehicleInfo_8CE06A, &TrackVehicleInfo_8CE291,
     &TrackVehicleInfo_8CE4B8, &TrackVehicleInfo_8CE6DF, &TrackVehicleInfo_8CE06A, &TrackVehicleInfo_8CE291, &TrackVehicleInfo_8CE4B8, &TrackVehicleInfo_8CE6DF,
     &TrackVehicleInfo_8CE06A, &TrackVehicleInfo_8CE291, &TrackVehicleInfo_8CE4B8, &TrackVehicleInfo_8CE6DF, &TrackVehicleInfo_8C232A, &TrackVehicleInfo_8C244C,
@@ -24423,7 +24517,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListChairliftEndBu
     &TrackVehicleInfo_8CE4B8, &TrackVehicleInfo_8CE6DF,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListChairliftStartBullwheel[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListChairliftStartBullwheel[] = {
     &TrackVehicleInfo_8CE4B8, &TrackVehicleInfo_8CE6DF, &TrackVehicleInfo_8CE06A, &TrackVehicleInfo_8CE291, &TrackVehicleInfo_8CE4B8, &TrackVehicleInfo_8CE6DF,
     &TrackVehicleInfo_8CE06A, &TrackVehicleInfo_8CE291, &TrackVehicleInfo_8CE4B8, &TrackVehicleInfo_8CE6DF, &TrackVehicleInfo_8CE06A, &TrackVehicleInfo_8CE291,
     &TrackVehicleInfo_8CE4B8, &TrackVehicleInfo_8CE6DF, &TrackVehicleInfo_8CE06A, &TrackVehicleInfo_8CE291, &TrackVehicleInfo_8C232A, &TrackVehicleInfo_8C244C,
@@ -24494,7 +24588,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListChairliftStart
     &TrackVehicleInfo_8CE06A, &TrackVehicleInfo_8CE291,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListGoKartsLeftLane[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListGoKartsLeftLane[] = {
     &TrackVehicleInfo_8FF2DA, &TrackVehicleInfo_8FF3FC, &TrackVehicleInfo_8FF51E, &TrackVehicleInfo_8FF640, // TrackElemType::Flat
     &TrackVehicleInfo_8FF2DA, &TrackVehicleInfo_8FF3FC, &TrackVehicleInfo_8FF51E, &TrackVehicleInfo_8FF640, // TrackElemType::EndStation
     &TrackVehicleInfo_8FF2DA, &TrackVehicleInfo_8FF3FC, &TrackVehicleInfo_8FF51E, &TrackVehicleInfo_8FF640, // TrackElemType::BeginStation
@@ -24549,7 +24643,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListGoKartsLeftLan
     &TrackVehicleInfo_901762, &TrackVehicleInfo_901884, &TrackVehicleInfo_9019AF, &TrackVehicleInfo_901AE3, // TrackElemType::RightQuarterTurn1Tile
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListGoKartsRightLane[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListGoKartsRightLane[] = {
     &TrackVehicleInfo_901DE1, &TrackVehicleInfo_901F03, &TrackVehicleInfo_902025, &TrackVehicleInfo_902147, // TrackElemType::Flat
     &TrackVehicleInfo_901DE1, &TrackVehicleInfo_901F03, &TrackVehicleInfo_902025, &TrackVehicleInfo_902147, // TrackElemType::EndStation
     &TrackVehicleInfo_901DE1, &TrackVehicleInfo_901F03, &TrackVehicleInfo_902025, &TrackVehicleInfo_902147, // TrackElemType::BeginStation
@@ -24604,7 +24698,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListGoKartsRightLa
     &TrackVehicleInfo_904284, &TrackVehicleInfo_9042F2, &TrackVehicleInfo_904369, &TrackVehicleInfo_9043E9, // TrackElemType::RightQuarterTurn1Tile
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListGoKartsMovingToRightLane[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListGoKartsMovingToRightLane[] = {
     &TrackVehicleInfo_8FF762, &TrackVehicleInfo_8FF884, &TrackVehicleInfo_8FF9A6, &TrackVehicleInfo_8FFAC8, &TrackVehicleInfo_8FF762, &TrackVehicleInfo_8FF884,
     &TrackVehicleInfo_8FF9A6, &TrackVehicleInfo_8FFAC8, &TrackVehicleInfo_8FF762, &TrackVehicleInfo_8FF884, &TrackVehicleInfo_8FF9A6, &TrackVehicleInfo_8FFAC8,
     &TrackVehicleInfo_8FF762, &TrackVehicleInfo_8FF884, &TrackVehicleInfo_8FF9A6, &TrackVehicleInfo_8FFAC8, &TrackVehicleInfo_900E52, &TrackVehicleInfo_900F74,
@@ -24642,7 +24736,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListGoKartsMovingT
     &TrackVehicleInfo_901762, &TrackVehicleInfo_901884, &TrackVehicleInfo_9019AF, &TrackVehicleInfo_901AE3,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListGoKartsMovingToLeftLane[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListGoKartsMovingToLeftLane[] = {
     &TrackVehicleInfo_904460, &TrackVehicleInfo_904582, &TrackVehicleInfo_9046A4, &TrackVehicleInfo_9047C6, &TrackVehicleInfo_904460, &TrackVehicleInfo_904582,
     &TrackVehicleInfo_9046A4, &TrackVehicleInfo_9047C6, &TrackVehicleInfo_904460, &TrackVehicleInfo_904582, &TrackVehicleInfo_9046A4, &TrackVehicleInfo_9047C6,
     &TrackVehicleInfo_904460, &TrackVehicleInfo_904582, &TrackVehicleInfo_9046A4, &TrackVehicleInfo_9047C6, &TrackVehicleInfo_9034D1, &TrackVehicleInfo_9035F3,
@@ -24680,7 +24774,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListGoKartsMovingT
     &TrackVehicleInfo_904284, &TrackVehicleInfo_9042F2, &TrackVehicleInfo_904369, &TrackVehicleInfo_9043E9,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfStartPathA9[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListMiniGolfStartPathA9[] = {
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4,
     &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8,
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938D7A, &TrackVehicleInfo_938E0C,
@@ -24821,7 +24915,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfStartP
     &TrackVehicleInfo_94AE31, &TrackVehicleInfo_94DAEF,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfBallPathA10[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListMiniGolfBallPathA10[] = {
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4,
     &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8,
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938D7A, &TrackVehicleInfo_938E0C,
@@ -24962,7 +25056,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfBallPa
     &TrackVehicleInfo_94B0DF, &TrackVehicleInfo_94DD9D,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfPathB11[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListMiniGolfPathB11[] = {
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4,
     &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8,
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938D7A, &TrackVehicleInfo_938E0C,
@@ -25103,7 +25197,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfPathB1
     &TrackVehicleInfo_94B37B, &TrackVehicleInfo_94E039,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfBallPathB12[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListMiniGolfBallPathB12[] = {
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4,
     &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8,
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938D7A, &TrackVehicleInfo_938E0C,
@@ -25244,7 +25338,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfBallPa
     &TrackVehicleInfo_94B6B9, &TrackVehicleInfo_94E377,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfPathC13[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListMiniGolfPathC13[] = {
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4,
     &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8,
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938D7A, &TrackVehicleInfo_938E0C,
@@ -25385,7 +25479,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfPathC1
     &TrackVehicleInfo_94BA7E, &TrackVehicleInfo_94E73C,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfPathC14[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListMiniGolfPathC14[] = {
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4,
     &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8,
     &TrackVehicleInfo_938212, &TrackVehicleInfo_9382A4, &TrackVehicleInfo_938336, &TrackVehicleInfo_9383C8, &TrackVehicleInfo_938D7A, &TrackVehicleInfo_938E0C,
@@ -25526,7 +25620,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListMiniGolfPathC1
     &TrackVehicleInfo_94BE16, &TrackVehicleInfo_94EAD4,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListReverserRCFrontBogie[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListReverserRCFrontBogie[] = {
     &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C, &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0, &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C,
     &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0, &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C, &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0,
     &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C, &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0, &TrackVehicleInfo_8C232A, &TrackVehicleInfo_8C244C,
@@ -25674,7 +25768,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListReverserRCFron
     &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C, &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0,
 };
 
-static constexpr const rct_vehicle_info_list *TrackVehicleInfoListReverserRCRearBogie[] = {
+static constexpr const rct_vehicle_info_encoded_list *TrackVehicleInfoListReverserRCRearBogie[] = {
     &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C, &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0, &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C,
     &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0, &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C, &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0,
     &TrackVehicleInfo_8BE57A, &TrackVehicleInfo_8BE69C, &TrackVehicleInfo_8BE7BE, &TrackVehicleInfo_8BE8E0, &TrackVehicleInfo_8C232A, &TrackVehicleInfo_8C244C,
@@ -25823,7 +25917,7 @@ static constexpr const rct_vehicle_info_list *TrackVehicleInfoListReverserRCRear
 };
 
 // rct2: 0x008B8F30
-constexpr const rct_vehicle_info_list * const * gTrackVehicleInfo[static_cast<uint8_t>(VehicleTrackSubposition::Count)] = {
+static constexpr const rct_vehicle_info_encoded_list * const * TrackVehicleInfo[static_cast<uint8_t>(VehicleTrackSubposition::Count)] = {
     TrackVehicleInfoListDefault,                  // VehicleTrackSubposition::Default
     TrackVehicleInfoListChairliftGoingOut,        // VehicleTrackSubposition::ChairliftGoingOut
     TrackVehicleInfoListChairliftGoingBack,       // VehicleTrackSubposition::ChairliftGoingBack
@@ -25844,3 +25938,56 @@ constexpr const rct_vehicle_info_list * const * gTrackVehicleInfo[static_cast<ui
 };
 
 // clang-format on
+
+static constexpr size_t NumVehicleInfoLists = __COUNTER__ - VehicleInfoListIndexBase;
+
+static rct_vehicle_info_list _decodedVehicleInfoLists[NumVehicleInfoLists];
+static std::vector<rct_vehicle_info> _decodedVehicleInfo[NumVehicleInfoLists];
+
+static void DecodeVehicleInfo(const rct_vehicle_info_encoded_list& encoded, std::vector<rct_vehicle_info>& result)
+{
+    result.resize(encoded.size);
+    const uint8_t* src = encoded.data;
+    rct_vehicle_info prev{};
+    for (auto& cur : result)
+    {
+        const uint8_t code = *src++;
+        cur = prev;
+        if (code == VehicleInfoFullCode)
+        {
+            cur.x = static_cast<int16_t>(src[0] | (src[1] << 8));
+            cur.y = static_cast<int16_t>(src[2] | (src[3] << 8));
+            cur.z = static_cast<int16_t>(src[4] | (src[5] << 8));
+            src += 6;
+        }
+        else
+        {
+            const uint8_t delta = code % VehicleInfoUnitDeltaCodes;
+            cur.x += (delta % 3) - 1;
+            cur.y += ((delta / 3) % 3) - 1;
+            cur.z += (delta / 9) - 1;
+        }
+        if (code >= VehicleInfoUnitDeltaCodes)
+        {
+            cur.direction = src[0];
+            cur.Pitch = src[1];
+            cur.bank_rotation = src[2];
+            src += 3;
+        }
+        prev = cur;
+    }
+}
+
+const rct_vehicle_info_list* GetTrackVehicleInfoList(VehicleTrackSubposition trackSubposition, uint16_t typeAndDirection)
+{
+    const auto& encoded = *TrackVehicleInfo[EnumValue(trackSubposition)][typeAndDirection];
+    auto& decoded = _decodedVehicleInfoLists[encoded.index];
+    if (decoded.info == nullptr)
+    {
+        auto& storage = _decodedVehicleInfo[encoded.index];
+        DecodeVehicleInfo(encoded, storage);
+        decoded.size = encoded.size;
+        decoded.info = storage.data();
+    }
+    return &decoded;
+}
@@ -49,4 +49,8 @@ struct rct_vehicle_info_list
     const rct_vehicle_info* info;
 };
 
-extern const rct_vehicle_info_list* const* const gTrackVehicleInfo[EnumValue(VehicleTrackSubposition::Count)];
+/**
+ * Gets the move info of the given track piece, typeAndDirection being (track type << 2) | direction. The move info is
+ * decoded the first time it is used, so this is only to be called from the game logic thread.
+ */
+const rct_vehicle_info_list* GetTrackVehicleInfoList(VehicleTrackSubposition trackSubposition, uint16_t typeAndDirection);
@@ -729,6 +729,7 @@ private:
                 fs.WriteValue(highscore->company_value);
                 fs.WriteValue(highscore->timestamp);
             }
+            fs.Flush();
         }
         catch (const std::exception&)
         {
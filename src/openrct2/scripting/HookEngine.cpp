@@ -13,27 +13,60 @@
 
 #    include "ScriptEngine.h"
 
+#    include <algorithm>
+#    include <chrono>
 #    include <unordered_map>
 
 using namespace OpenRCT2::Scripting;
 
+static const std::unordered_map<std::string, HOOK_TYPE> HookTypeLookupTable({
+    { "action.query", HOOK_TYPE::ACTION_QUERY },
+    { "action.execute", HOOK_TYPE::ACTION_EXECUTE },
+    { "interval.tick", HOOK_TYPE::INTERVAL_TICK },
+    { "interval.day", HOOK_TYPE::INTERVAL_DAY },
+    { "network.chat", HOOK_TYPE::NETWORK_CHAT },
+    { "network.authenticate", HOOK_TYPE::NETWORK_AUTHENTICATE },
+    { "network.join", HOOK_TYPE::NETWORK_JOIN },
+    { "network.leave", HOOK_TYPE::NETWORK_LEAVE },
+    { "ride.ratings.calculate", HOOK_TYPE::RIDE_RATINGS_CALCULATE },
+    { "action.location", HOOK_TYPE::ACTION_LOCATION },
+    { "guest.generation", HOOK_TYPE::GUEST_GENERATION },
+});
+
 HOOK_TYPE OpenRCT2::Scripting::GetHookType(const std::string& name)
 {
-    static const std::unordered_map<std::string, HOOK_TYPE> LookupTable({
-        { "action.query", HOOK_TYPE::ACTION_QUERY },
-        { "action.execute", HOOK_TYPE::ACTION_EXECUTE },
-        { "interval.tick", HOOK_TYPE::INTERVAL_TICK },
-        { "interval.day", HOOK_TYPE::INTERVAL_DAY },
-        { "network.chat", HOOK_TYPE::NETWORK_CHAT },
-        { "network.authenticate", HOOK_TYPE::NETWORK_AUTHENTICATE },
-        { "network.join", HOOK_TYPE::NETWORK_JOIN },
-        { "network.leave", HOOK_TYPE::NETWORK_LEAVE },
-        { "ride.ratings.calculate", HOOK_TYPE::RIDE_RATINGS_CALCULATE },
-        { "action.location", HOOK_TYPE::ACTION_LOCATION },
-        { "guest.generation", HOOK_TYPE::GUEST_GENERATION },
-    });
-    auto result = LookupTable.find(name);
-    return (result != LookupTable.end()) ? result->second : HOOK_TYPE::UNDEFINED;
+    auto result = HookTypeLookupTable.find(name);
+    return (result != HookTypeLookupTable.end()) ? result->second : HOOK_TYPE::UNDEFINED;
+}
+
+std::string_view OpenRCT2::Scripting::GetHookName(HOOK_TYPE type)
+{
+    for (const auto& [name, hookType] : HookTypeLookupTable)
+    {
+        if (hookType == type)
+        {
+            return name;
+        }
+    }
+    return {};
+}
+
+bool Hook::ShouldCall(std::string_view filterKey)
+{
+    // Events without a key, such as those of hooks that are not filtered by anything, always pass the filter
+    if (!filterKey.empty() && !Options.Filter.empty()
+        && std::find(Options.Filter.begin(), Options.Filter.end(), filterKey) == Options.Filter.end())
+    {
+        return false;
+    }
+
+    NumSkipped++;
+    if (NumSkipped < Options.Every)
+    {
+        return false;
+    }
+    NumSkipped = 0;
+    return true;
 }
 
 HookEngine::HookEngine(ScriptEngine& scriptEngine)
@@ -46,11 +79,11 @@ HookEngine::HookEngine(ScriptEngine& scriptEngine)
     }
 }
 
-uint32_t HookEngine::Subscribe(HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function)
+uint32_t HookEngine::Subscribe(HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function, HookOptions options)
 {
     auto& hookList = GetHookList(type);
     auto cookie = _nextCookie++;
-    hookList.Hooks.emplace_back(cookie, owner, function);
+    hookList.Hooks.emplace_back(cookie, owner, function, std::move(options));
     return cookie;
 }
 
@@ -87,27 +120,27 @@ void HookEngine::UnsubscribeAll()
     }
 }
 
-bool HookEngine::HasSubscriptions(HOOK_TYPE type) const
-{
-    auto& hookList = GetHookList(type);
-    return !hookList.Hooks.empty();
-}
-
 void HookEngine::Call(HOOK_TYPE type, bool isGameStateMutable)
 {
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, {}, isGameStateMutable);
+        if (hook.ShouldCall({}))
+        {
+            CallHook(type, hook, {}, isGameStateMutable);
+        }
     }
 }
 
-void HookEngine::Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable)
+void HookEngine::Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable, std::string_view filterKey)
 {
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, { arg }, isGameStateMutable);
+        if (hook.ShouldCall(filterKey))
+        {
+            CallHook(type, hook, { arg }, isGameStateMutable);
+        }
     }
 }
 
@@ -117,6 +150,9 @@ void HookEngine::Call(
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
+        if (!hook.ShouldCall({}))
+            continue;
+
         auto ctx = _scriptEngine.GetContext();
 
         // Convert key/value pairs into an object
@@ -142,20 +178,15 @@ void HookEngine::Call(
 
         std::vector<DukValue> dukArgs;
         dukArgs.push_back(DukValue::take_from_stack(ctx));
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, dukArgs, isGameStateMutable);
+        CallHook(type, hook, dukArgs, isGameStateMutable);
     }
 }
 
-HookList& HookEngine::GetHookList(HOOK_TYPE type)
-{
-    auto index = static_cast<size_t>(type);
-    return _hookMap[index];
-}
-
-const HookList& HookEngine::GetHookList(HOOK_TYPE type) const
+void HookEngine::CallHook(HOOK_TYPE type, const Hook& hook, const std::vector<DukValue>& args, bool isGameStateMutable)
 {
-    auto index = static_cast<size_t>(type);
-    return _hookMap[index];
+    auto startTime = std::chrono::high_resolution_clock::now();
+    _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, args, isGameStateMutable);
+    _scriptEngine.RecordPluginTime(hook.Owner, type, std::chrono::high_resolution_clock::now() - startTime);
 }
 
 #endif
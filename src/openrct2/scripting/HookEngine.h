@@ -17,6 +17,7 @@
 #    include <any>
 #    include <memory>
 #    include <string>
+#    include <string_view>
 #    include <tuple>
 #    include <vector>
 
@@ -44,20 +45,38 @@ namespace OpenRCT2::Scripting
     };
     constexpr size_t NUM_HOOK_TYPES = static_cast<size_t>(HOOK_TYPE::COUNT);
     HOOK_TYPE GetHookType(const std::string& name);
+    std::string_view GetHookName(HOOK_TYPE type);
+
+    /**
+     * Lets a subscription skip events natively, without calling into the script for them.
+     */
+    struct HookOptions
+    {
+        // Only every nth event that passes the filter is passed on
+        uint32_t Every = 1;
+
+        // If not empty, only events with one of these keys are passed on, e.g. the names of actions
+        std::vector<std::string> Filter;
+    };
 
     struct Hook
     {
         uint32_t Cookie;
         std::shared_ptr<Plugin> Owner;
         DukValue Function;
+        HookOptions Options;
+        uint32_t NumSkipped{};
 
         Hook() = default;
-        Hook(uint32_t cookie, std::shared_ptr<Plugin> owner, const DukValue& function)
+        Hook(uint32_t cookie, std::shared_ptr<Plugin> owner, const DukValue& function, HookOptions options)
             : Cookie(cookie)
             , Owner(owner)
             , Function(function)
+            , Options(std::move(options))
         {
         }
+
+        bool ShouldCall(std::string_view filterKey);
     };
 
     struct HookList
@@ -80,19 +99,31 @@ namespace OpenRCT2::Scripting
     public:
         HookEngine(ScriptEngine& scriptEngine);
         HookEngine(const HookEngine&) = delete;
-        uint32_t Subscribe(HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function);
+        uint32_t Subscribe(
+            HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function, HookOptions options = {});
         void Unsubscribe(HOOK_TYPE type, uint32_t cookie);
         void UnsubscribeAll(std::shared_ptr<const Plugin> owner);
         void UnsubscribeAll();
-        bool HasSubscriptions(HOOK_TYPE type) const;
+        bool HasSubscriptions(HOOK_TYPE type) const
+        {
+            return !GetHookList(type).Hooks.empty();
+        }
         void Call(HOOK_TYPE type, bool isGameStateMutable);
-        void Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable);
+        void Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable, std::string_view filterKey = {});
         void Call(
             HOOK_TYPE type, const std::initializer_list<std::pair<std::string_view, std::any>>& args, bool isGameStateMutable);
 
     private:
-        HookList& GetHookList(HOOK_TYPE type);
-        const HookList& GetHookList(HOOK_TYPE type) const;
+        void CallHook(HOOK_TYPE type, const Hook& hook, const std::vector<DukValue>& args, bool isGameStateMutable);
+        HookList& GetHookList(HOOK_TYPE type)
+        {
+            return _hookMap[static_cast<size_t>(type)];
+        }
+
+        const HookList& GetHookList(HOOK_TYPE type) const
+        {
+            return _hookMap[static_cast<size_t>(type)];
+        }
     };
 } // namespace OpenRCT2::Scripting
 
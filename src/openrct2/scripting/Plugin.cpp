@@ -13,15 +13,47 @@
 
 #    include "../Diagnostic.h"
 #    include "../OpenRCT2.h"
+#    include "../Version.h"
 #    include "../core/File.h"
+#    include "../core/FileStream.h"
+#    include "../core/Path.hpp"
+#    include "../core/String.hpp"
 #    include "Duktape.hpp"
 
 #    include <algorithm>
+#    include <cinttypes>
 #    include <fstream>
 #    include <memory>
 
 using namespace OpenRCT2::Scripting;
 
+static constexpr uint32_t BYTECODE_MAGIC_NUMBER = 0x4342534A; // JSBC
+static constexpr uint16_t BYTECODE_VERSION = 1;
+
+// Bytecode is only valid for the exact build of duktape that dumped it, so the cache is keyed on the build as well.
+static std::string GetBytecodeEngineVersion()
+{
+    return String::StdFormat("%s duktape %ld", gVersionInfoFull, static_cast<long>(DUK_VERSION));
+}
+
+static uint64_t GetCodeHash(std::string_view code)
+{
+    // FNV-1a
+    uint64_t hash = 0xCBF29CE484222325;
+    for (auto c : code)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+static duk_ret_t duk_load_function_wrapper(duk_context* ctx, void*)
+{
+    duk_load_function(ctx);
+    return 1;
+}
+
 Plugin::Plugin(duk_context* context, const std::string& path)
     : _context(context)
     , _path(path)
@@ -33,7 +65,7 @@ void Plugin::SetCode(std::string_view code)
     _code = code;
 }
 
-void Plugin::Load()
+void Plugin::Load(const std::string& bytecodeCacheDirectory)
 {
     if (!_path.empty())
     {
@@ -62,9 +94,29 @@ void Plugin::Load()
         "     })(" + projectedVariables + ");";
     // clang-format on
 
-    auto flags = DUK_COMPILE_EVAL | DUK_COMPILE_SAFE | DUK_COMPILE_NOSOURCE | DUK_COMPILE_NOFILENAME;
-    auto result = duk_eval_raw(_context, code.c_str(), code.size(), flags);
-    if (result != DUK_ERR_NONE)
+    std::string bytecodePath;
+    auto codeHash = GetCodeHash(code);
+    if (!bytecodeCacheDirectory.empty())
+    {
+        bytecodePath = Path::Combine(bytecodeCacheDirectory, String::StdFormat("%016" PRIx64 ".jsc", codeHash));
+    }
+
+    if (bytecodePath.empty() || !LoadBytecode(bytecodePath, codeHash, code.size()))
+    {
+        auto flags = DUK_COMPILE_SAFE | DUK_COMPILE_NOSOURCE | DUK_COMPILE_NOFILENAME;
+        if (duk_compile_raw(_context, code.c_str(), code.size(), flags) != DUK_ERR_NONE)
+        {
+            auto val = std::string(duk_safe_to_string(_context, -1));
+            duk_pop(_context);
+            throw std::runtime_error("Failed to load plug-in script: " + val);
+        }
+        if (!bytecodePath.empty())
+        {
+            SaveBytecode(bytecodePath, codeHash, code.size());
+        }
+    }
+
+    if (duk_pcall(_context, 0) != DUK_EXEC_SUCCESS)
     {
         auto val = std::string(duk_safe_to_string(_context, -1));
         duk_pop(_context);
@@ -105,6 +157,63 @@ void Plugin::LoadCodeFromFile()
     _code = File::ReadAllText(_path);
 }
 
+bool Plugin::LoadBytecode(const std::string& path, uint64_t codeHash, size_t codeLength)
+{
+    if (!File::Exists(path))
+        return false;
+
+    try
+    {
+        auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+        if (fs.ReadValue<uint32_t>() != BYTECODE_MAGIC_NUMBER || fs.ReadValue<uint16_t>() != BYTECODE_VERSION
+            || fs.ReadStdString() != GetBytecodeEngineVersion() || fs.ReadValue<uint64_t>() != codeHash
+            || fs.ReadValue<uint64_t>() != codeLength)
+        {
+            return false;
+        }
+
+        auto bytecodeLength = fs.GetLength() - fs.GetPosition();
+        auto bytecode = duk_push_fixed_buffer(_context, static_cast<duk_size_t>(bytecodeLength));
+        fs.Read(bytecode, bytecodeLength);
+        if (duk_safe_call(_context, duk_load_function_wrapper, nullptr, 1, 1) != DUK_EXEC_SUCCESS)
+        {
+            duk_pop(_context);
+            return false;
+        }
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        log_verbose("Unable to load plug-in bytecode '%s': %s", path.c_str(), e.what());
+        return false;
+    }
+}
+
+void Plugin::SaveBytecode(const std::string& path, uint64_t codeHash, size_t codeLength)
+{
+    duk_dup(_context, -1);
+    duk_dump_function(_context);
+    duk_size_t bytecodeLength{};
+    auto bytecode = duk_get_buffer(_context, -1, &bytecodeLength);
+    try
+    {
+        Path::CreateDirectory(Path::GetDirectory(path));
+        auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_WRITE);
+        fs.WriteValue<uint32_t>(BYTECODE_MAGIC_NUMBER);
+        fs.WriteValue<uint16_t>(BYTECODE_VERSION);
+        fs.WriteString(GetBytecodeEngineVersion());
+        fs.WriteValue<uint64_t>(codeHash);
+        fs.WriteValue<uint64_t>(codeLength);
+        fs.Write(bytecode, bytecodeLength);
+        fs.Flush();
+    }
+    catch (const std::exception& e)
+    {
+        log_verbose("Unable to save plug-in bytecode '%s': %s", path.c_str(), e.what());
+    }
+    duk_pop(_context);
+}
+
 static std::string TryGetString(const DukValue& value, const std::string& message)
 {
     if (value.type() != DukValue::Type::STRING)
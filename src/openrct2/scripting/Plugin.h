@@ -12,7 +12,11 @@
 #ifdef ENABLE_SCRIPTING
 
 #    include "Duktape.hpp"
+#    include "HookEngine.h"
 
+#    include <algorithm>
+#    include <array>
+#    include <chrono>
 #    include <memory>
 #    include <string>
 #    include <string_view>
@@ -45,6 +49,23 @@ namespace OpenRCT2::Scripting
         DukValue Main;
     };
 
+    /**
+     * How long a plugin has spent in one kind of callback since its timings were last reset.
+     */
+    struct PluginTiming
+    {
+        uint64_t NumCalls{};
+        std::chrono::nanoseconds TotalTime{};
+        std::chrono::nanoseconds MaxTime{};
+
+        void Record(std::chrono::nanoseconds time)
+        {
+            NumCalls++;
+            TotalTime += time;
+            MaxTime = std::max(MaxTime, time);
+        }
+    };
+
     class Plugin
     {
     private:
@@ -53,6 +74,8 @@ namespace OpenRCT2::Scripting
         PluginMetadata _metadata{};
         std::string _code;
         bool _hasStarted{};
+        std::array<PluginTiming, NUM_HOOK_TYPES> _hookTimings{};
+        PluginTiming _intervalTiming{};
 
     public:
         std::string GetPath() const
@@ -80,18 +103,43 @@ namespace OpenRCT2::Scripting
             return _hasStarted;
         }
 
+        PluginTiming& GetHookTiming(HOOK_TYPE type)
+        {
+            return _hookTimings[static_cast<size_t>(type)];
+        }
+
+        /**
+         * The time spent in callbacks registered with setInterval and setTimeout.
+         */
+        PluginTiming& GetIntervalTiming()
+        {
+            return _intervalTiming;
+        }
+
+        void ResetTimings()
+        {
+            _hookTimings = {};
+            _intervalTiming = {};
+        }
+
         Plugin() = default;
         Plugin(duk_context* context, const std::string& path);
         Plugin(const Plugin&) = delete;
         Plugin(Plugin&&) = delete;
 
         void SetCode(std::string_view code);
-        void Load();
+        /**
+         * Compiles and runs the plug-in's code to register it. If a bytecode cache directory is given, the compiled code
+         * is kept there and used the next time the same code is loaded by the same build.
+         */
+        void Load(const std::string& bytecodeCacheDirectory = {});
         void Start();
         void Stop();
 
     private:
         void LoadCodeFromFile();
+        bool LoadBytecode(const std::string& path, uint64_t codeHash, size_t codeLength);
+        void SaveBytecode(const std::string& path, uint64_t codeHash, size_t codeLength);
 
         static PluginMetadata GetMetadata(const DukValue& dukMetadata);
         static PluginType ParsePluginType(std::string_view type);
@@ -21,8 +21,10 @@
 #    include "ScConfiguration.hpp"
 #    include "ScDisposable.hpp"
 #    include "ScObject.hpp"
+#    include "ScWorker.hpp"
 #    include "ScriptEngine.h"
 
+#    include <chrono>
 #    include <cstdio>
 #    include <memory>
 
@@ -152,6 +154,47 @@ namespace OpenRCT2::Scripting
             return result;
         }
 
+        std::vector<DukValue> getPluginTimings() const
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto ctx = scriptEngine.GetContext();
+
+            using Milliseconds = std::chrono::duration<double, std::milli>;
+            std::vector<DukValue> result;
+            auto addTiming = [&](const Plugin& plugin, HOOK_TYPE type, const PluginTiming& timing) {
+                if (timing.NumCalls == 0)
+                    return;
+
+                DukObject obj(ctx);
+                obj.Set("plugin", plugin.GetMetadata().Name);
+                obj.Set("type", ScriptEngine::GetPluginTimingName(type));
+                obj.Set("calls", timing.NumCalls);
+                obj.Set("totalTime", Milliseconds(timing.TotalTime).count());
+                obj.Set("maxTime", Milliseconds(timing.MaxTime).count());
+                result.push_back(obj.Take());
+            };
+
+            for (const auto& plugin : scriptEngine.GetPlugins())
+            {
+                for (size_t i = 0; i < NUM_HOOK_TYPES; i++)
+                {
+                    auto type = static_cast<HOOK_TYPE>(i);
+                    addTiming(*plugin, type, plugin->GetHookTiming(type));
+                }
+                addTiming(*plugin, HOOK_TYPE::UNDEFINED, plugin->GetIntervalTiming());
+            }
+            return result;
+        }
+
+        std::shared_ptr<ScWorker> createWorker(const std::string& code, const DukValue& callback)
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto plugin = _execInfo.GetCurrentPlugin();
+            auto worker = std::make_shared<ScWorker>(plugin, code, callback);
+            scriptEngine.AddWorker(worker);
+            return worker;
+        }
+
         int32_t getRandom(int32_t min, int32_t max)
         {
             ThrowIfGameStateNotMutable();
@@ -204,7 +247,7 @@ namespace OpenRCT2::Scripting
             return 1;
         }
 
-        std::shared_ptr<ScDisposable> subscribe(const std::string& hook, const DukValue& callback)
+        std::shared_ptr<ScDisposable> subscribe(const std::string& hook, const DukValue& callback, const DukValue& options)
         {
             auto& scriptEngine = GetContext()->GetScriptEngine();
             auto ctx = scriptEngine.GetContext();
@@ -226,7 +269,30 @@ namespace OpenRCT2::Scripting
                 duk_error(ctx, DUK_ERR_ERROR, "Not in a plugin context");
             }
 
-            auto cookie = _hookEngine.Subscribe(hookType, owner, callback);
+            HookOptions hookOptions;
+            if (options.type() == DukValue::Type::OBJECT)
+            {
+                auto every = AsOrDefault(options["every"], 1);
+                if (every < 1)
+                {
+                    duk_error(ctx, DUK_ERR_ERROR, "Expected every to be at least 1");
+                }
+                hookOptions.Every = static_cast<uint32_t>(every);
+
+                auto dukFilter = options["filter"];
+                if (dukFilter.is_array())
+                {
+                    for (const auto& item : dukFilter.as_array())
+                    {
+                        if (item.type() == DukValue::Type::STRING)
+                        {
+                            hookOptions.Filter.push_back(item.as_string());
+                        }
+                    }
+                }
+            }
+
+            auto cookie = _hookEngine.Subscribe(hookType, owner, callback, std::move(hookOptions));
             return std::make_shared<ScDisposable>([this, hookType, cookie]() { _hookEngine.Unsubscribe(hookType, cookie); });
         }
 
@@ -240,6 +306,16 @@ namespace OpenRCT2::Scripting
             QueryOrExecuteAction(action, args, callback, true);
         }
 
+        void queryActionBatch(const std::string& action, const DukValue& args, const DukValue& callback)
+        {
+            QueryOrExecuteActionBatch(action, args, callback, false);
+        }
+
+        void executeActionBatch(const std::string& action, const DukValue& args, const DukValue& callback)
+        {
+            QueryOrExecuteActionBatch(action, args, callback, true);
+        }
+
         void QueryOrExecuteAction(const std::string& actionid, const DukValue& args, const DukValue& callback, bool isExecute)
         {
             auto& scriptEngine = GetContext()->GetScriptEngine();
@@ -249,20 +325,7 @@ namespace OpenRCT2::Scripting
                 auto action = scriptEngine.CreateGameAction(actionid, args);
                 if (action != nullptr)
                 {
-                    auto plugin = scriptEngine.GetExecInfo().GetCurrentPlugin();
-                    if (isExecute)
-                    {
-                        action->SetCallback(
-                            [this, plugin, callback](const GameAction*, const GameActions::Result* res) -> void {
-                                HandleGameActionResult(plugin, *res, callback);
-                            });
-                        GameActions::Execute(action.get());
-                    }
-                    else
-                    {
-                        auto res = GameActions::Query(action.get());
-                        HandleGameActionResult(plugin, *res, callback);
-                    }
+                    QueryOrExecuteGameAction(*action, callback, isExecute);
                 }
                 else
                 {
@@ -275,6 +338,40 @@ namespace OpenRCT2::Scripting
             }
         }
 
+        void QueryOrExecuteActionBatch(
+            const std::string& actionid, const DukValue& args, const DukValue& callback, bool isExecute)
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto ctx = scriptEngine.GetContext();
+            auto action = scriptEngine.CreateCustomGameActionBatch(actionid, args);
+            if (action != nullptr)
+            {
+                QueryOrExecuteGameAction(*action, callback, isExecute);
+            }
+            else
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Only custom actions can be batched, with an array of arguments.");
+            }
+        }
+
+        void QueryOrExecuteGameAction(GameAction& action, const DukValue& callback, bool isExecute)
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto plugin = scriptEngine.GetExecInfo().GetCurrentPlugin();
+            if (isExecute)
+            {
+                action.SetCallback([this, plugin, callback](const GameAction*, const GameActions::Result* res) -> void {
+                    HandleGameActionResult(plugin, *res, callback);
+                });
+                GameActions::Execute(&action);
+            }
+            else
+            {
+                auto res = GameActions::Query(&action);
+                HandleGameActionResult(plugin, *res, callback);
+            }
+        }
+
         void HandleGameActionResult(
             const std::shared_ptr<Plugin>& plugin, const GameActions::Result& res, const DukValue& callback)
         {
@@ -384,11 +481,15 @@ namespace OpenRCT2::Scripting
             dukglue_register_method(ctx, &ScContext::captureImage, "captureImage");
             dukglue_register_method(ctx, &ScContext::getObject, "getObject");
             dukglue_register_method(ctx, &ScContext::getAllObjects, "getAllObjects");
+            dukglue_register_method(ctx, &ScContext::createWorker, "createWorker");
+            dukglue_register_method(ctx, &ScContext::getPluginTimings, "getPluginTimings");
             dukglue_register_method(ctx, &ScContext::getRandom, "getRandom");
             dukglue_register_method_varargs(ctx, &ScContext::formatString, "formatString");
             dukglue_register_method(ctx, &ScContext::subscribe, "subscribe");
             dukglue_register_method(ctx, &ScContext::queryAction, "queryAction");
             dukglue_register_method(ctx, &ScContext::executeAction, "executeAction");
+            dukglue_register_method(ctx, &ScContext::queryActionBatch, "queryActionBatch");
+            dukglue_register_method(ctx, &ScContext::executeActionBatch, "executeActionBatch");
             dukglue_register_method(ctx, &ScContext::registerAction, "registerAction");
             dukglue_register_method(ctx, &ScContext::setInterval, "setInterval");
             dukglue_register_method(ctx, &ScContext::setTimeout, "setTimeout");
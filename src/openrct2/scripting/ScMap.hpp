@@ -11,6 +11,7 @@
 
 #ifdef ENABLE_SCRIPTING
 
+#    include "../Game.h"
 #    include "../common.h"
 #    include "../ride/Ride.h"
 #    include "../ride/TrainManager.h"
@@ -18,13 +19,172 @@
 #    include "../world/Duck.h"
 #    include "../world/EntityList.h"
 #    include "../world/Map.h"
+#    include "../world/Sprite.h"
 #    include "Duktape.hpp"
 #    include "ScEntity.hpp"
 #    include "ScRide.hpp"
 #    include "ScTile.hpp"
 
+#    include <algorithm>
+#    include <cstring>
+#    include <string_view>
+#    include <utility>
+#    include <vector>
+
 namespace OpenRCT2::Scripting
 {
+    using EntityFieldGetter = int32_t (*)(const SpriteBase& entity);
+
+    template<typename T, typename TValue, TValue T::*Member> int32_t GetEntityField(const SpriteBase& entity)
+    {
+        auto value = entity.As<T>();
+        return value != nullptr ? static_cast<int32_t>(value->*Member) : 0;
+    }
+
+    /**
+     * The fields queryEntities can read, named after the entity properties they match. Fields that do not apply to
+     * an entity read as 0, the same as the properties.
+     */
+    inline EntityFieldGetter GetEntityFieldGetter(std::string_view name)
+    {
+        static const std::pair<std::string_view, EntityFieldGetter> Getters[] = {
+            { "id", &GetEntityField<SpriteBase, uint16_t, &SpriteBase::sprite_index> },
+            { "x", &GetEntityField<SpriteBase, int16_t, &SpriteBase::x> },
+            { "y", &GetEntityField<SpriteBase, int16_t, &SpriteBase::y> },
+            { "z", &GetEntityField<SpriteBase, int16_t, &SpriteBase::z> },
+            { "energy", &GetEntityField<Peep, uint8_t, &Peep::Energy> },
+            { "energyTarget", &GetEntityField<Peep, uint8_t, &Peep::EnergyTarget> },
+            { "mass", &GetEntityField<Peep, uint8_t, &Peep::Mass> },
+            { "happiness", &GetEntityField<Guest, uint8_t, &Guest::Happiness> },
+            { "happinessTarget", &GetEntityField<Guest, uint8_t, &Guest::HappinessTarget> },
+            { "nausea", &GetEntityField<Guest, uint8_t, &Guest::Nausea> },
+            { "nauseaTarget", &GetEntityField<Guest, uint8_t, &Guest::NauseaTarget> },
+            { "hunger", &GetEntityField<Guest, uint8_t, &Guest::Hunger> },
+            { "thirst", &GetEntityField<Guest, uint8_t, &Guest::Thirst> },
+            { "toilet", &GetEntityField<Guest, uint8_t, &Guest::Toilet> },
+            { "cash", &GetEntityField<Guest, money32, &Guest::CashInPocket> },
+            { "minIntensity",
+              [](const SpriteBase& entity) -> int32_t {
+                  auto guest = entity.As<Guest>();
+                  return guest != nullptr ? guest->Intensity.GetMinimum() : 0;
+              } },
+            { "maxIntensity",
+              [](const SpriteBase& entity) -> int32_t {
+                  auto guest = entity.As<Guest>();
+                  return guest != nullptr ? guest->Intensity.GetMaximum() : 0;
+              } },
+            { "nauseaTolerance",
+              [](const SpriteBase& entity) -> int32_t {
+                  auto guest = entity.As<Guest>();
+                  return guest != nullptr ? EnumValue(guest->NauseaTolerance) : 0;
+              } },
+        };
+        for (const auto& [getterName, getter] : Getters)
+        {
+            if (getterName == name)
+            {
+                return getter;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Reads the given fields of each of the entities into an object holding the number of entities as count and an
+     * Int32Array for each field.
+     */
+    inline DukValue QueryEntityFields(
+        duk_context* ctx, const std::vector<const SpriteBase*>& entities, const std::vector<std::string>& fields)
+    {
+        std::vector<EntityFieldGetter> getters;
+        for (const auto& field : fields)
+        {
+            auto getter = GetEntityFieldGetter(field);
+            if (getter == nullptr)
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Invalid entity field.");
+            }
+            getters.push_back(getter);
+        }
+
+        auto objIdx = duk_push_object(ctx);
+        duk_push_uint(ctx, static_cast<duk_uint_t>(entities.size()));
+        duk_put_prop_string(ctx, objIdx, "count");
+
+        auto dataLen = entities.size() * sizeof(int32_t);
+        for (size_t i = 0; i < fields.size(); i++)
+        {
+            auto data = static_cast<int32_t*>(duk_push_fixed_buffer(ctx, dataLen));
+            auto getter = getters[i];
+            for (size_t j = 0; j < entities.size(); j++)
+            {
+                data[j] = getter(*entities[j]);
+            }
+            duk_push_buffer_object(ctx, -1, 0, dataLen, DUK_BUFOBJ_INT32ARRAY);
+            duk_remove(ctx, -2);
+            duk_put_prop_string(ctx, objIdx, fields[i].c_str());
+        }
+        return DukValue::take_from_stack(ctx);
+    }
+
+    /**
+     * A copy of entities taken at one moment. Reading it does not touch the park, so a plugin can capture once and then
+     * work through the copy a part at a time over as many ticks as it likes.
+     */
+    class ScEntitySnapshot
+    {
+    private:
+        duk_context* _context;
+        uint32_t _tick;
+        std::vector<rct_sprite> _entities;
+
+    public:
+        ScEntitySnapshot(duk_context* ctx, const std::vector<const SpriteBase*>& entities)
+            : _context(ctx)
+            , _tick(gCurrentTicks)
+        {
+            _entities.reserve(entities.size());
+            for (const auto* entity : entities)
+            {
+                _entities.push_back(*reinterpret_cast<const rct_sprite*>(entity));
+            }
+        }
+
+        uint32_t tick_get() const
+        {
+            return _tick;
+        }
+
+        int32_t count_get() const
+        {
+            return static_cast<int32_t>(_entities.size());
+        }
+
+        /**
+         * The same as map.queryEntities, but for the copied entities from start, up to count of them.
+         */
+        DukValue query(const std::vector<std::string>& fields, const DukValue& dukStart, const DukValue& dukCount) const
+        {
+            auto start = std::clamp<int32_t>(AsOrDefault(dukStart, 0), 0, count_get());
+            auto count = std::clamp<int32_t>(AsOrDefault(dukCount, count_get()), 0, count_get() - start);
+
+            std::vector<const SpriteBase*> entities;
+            entities.reserve(static_cast<size_t>(count));
+            for (int32_t i = start; i < start + count; i++)
+            {
+                entities.push_back(&_entities[i].base);
+            }
+            return QueryEntityFields(_context, entities, fields);
+        }
+
+        static void Register(duk_context* ctx)
+        {
+            dukglue_register_property(ctx, &ScEntitySnapshot::tick_get, nullptr, "tick");
+            dukglue_register_property(ctx, &ScEntitySnapshot::count_get, nullptr, "count");
+            dukglue_register_method(ctx, &ScEntitySnapshot::query, "query");
+        }
+    };
+
     class ScMap
     {
     private:
@@ -103,21 +263,213 @@ namespace OpenRCT2::Scripting
         std::vector<DukValue> getAllEntities(const std::string& type) const
         {
             std::vector<DukValue> result;
+            for (auto entity : GetEntities(type))
+            {
+                result.push_back(GetEntityAsDukValue(entity));
+            }
+            return result;
+        }
+
+        /**
+         * Returns an object with the number of entities of the given type as count, and an Int32Array for each of the
+         * fields, holding that field for every entity in the same order. All of it is read in one go, without creating
+         * an object for each entity.
+         */
+        DukValue queryEntities(const std::string& type, const std::vector<std::string>& fields) const
+        {
+            return QueryEntityFields(_context, GetEntities(type), fields);
+        }
+
+        /**
+         * Copies every entity of the given type, so they can be queried later as they were at this moment.
+         */
+        std::shared_ptr<ScEntitySnapshot> captureEntities(const std::string& type) const
+        {
+            return std::make_shared<ScEntitySnapshot>(_context, GetEntities(type));
+        }
+
+        /**
+         * Returns the elements of every tile in the range as an ArrayBuffer, a tile at a time, row by row. Each element is
+         * copied as is, 16 bytes each, with the last element of each tile flagged as such.
+         */
+        DukValue getTileData(int32_t x, int32_t y, int32_t width, int32_t height) const
+        {
+            auto ctx = _context;
+            if (!IsTileRangeValid(x, y, width, height))
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Invalid tile range.");
+            }
+
+            std::vector<const TileElement*> firstElements;
+            firstElements.reserve(static_cast<size_t>(width) * height);
+            size_t numElements = 0;
+            for (int32_t tileY = y; tileY < y + height; tileY++)
+            {
+                for (int32_t tileX = x; tileX < x + width; tileX++)
+                {
+                    const auto* element = map_get_first_element_at(TileCoordsXY(tileX, tileY).ToCoordsXY());
+                    firstElements.push_back(element);
+                    numElements += CountTileElements(element);
+                }
+            }
+
+            auto dataLen = numElements * sizeof(TileElement);
+            auto data = static_cast<uint8_t*>(duk_push_fixed_buffer(ctx, dataLen));
+            for (const auto* element : firstElements)
+            {
+                auto count = CountTileElements(element);
+                std::memcpy(data, element, count * sizeof(TileElement));
+                data += count * sizeof(TileElement);
+            }
+            duk_push_buffer_object(ctx, -1, 0, dataLen, DUK_BUFOBJ_ARRAYBUFFER);
+            duk_remove(ctx, -2);
+            return DukValue::take_from_stack(ctx);
+        }
+
+        /**
+         * Replaces the elements of every tile in the range with the elements in the buffer, in the same layout as
+         * getTileData. The whole buffer is checked before any tile is changed, so an invalid buffer leaves the map as it was.
+         */
+        void setTileData(int32_t x, int32_t y, int32_t width, int32_t height, const DukValue& dukData)
+        {
+            ThrowIfGameStateNotMutable();
+
+            auto ctx = _context;
+            if (!IsTileRangeValid(x, y, width, height))
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Invalid tile range.");
+            }
+
+            duk_size_t dataLen{};
+            dukData.push();
+            auto data = static_cast<const uint8_t*>(duk_get_buffer_data(ctx, -1, &dataLen));
+            duk_pop(ctx);
+            if (data == nullptr || dataLen % sizeof(TileElement) != 0)
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Tile data must be a buffer of 16 byte elements.");
+            }
+
+            std::vector<TileElement> elements(dataLen / sizeof(TileElement));
+            std::memcpy(elements.data(), data, dataLen);
+
+            // Find where each tile starts, making sure every tile has exactly one surface
+            std::vector<size_t> tileStarts;
+            size_t tileStart = 0;
+            size_t numSurfaces = 0;
+            for (size_t i = 0; i < elements.size(); i++)
+            {
+                auto type = elements[i].GetType();
+                if (type > TILE_ELEMENT_TYPE_CORRUPT)
+                {
+                    duk_error(ctx, DUK_ERR_ERROR, "Invalid tile element type.");
+                }
+                if (type == TILE_ELEMENT_TYPE_SURFACE)
+                {
+                    numSurfaces++;
+                }
+                if (elements[i].IsLastForTile())
+                {
+                    if (numSurfaces != 1)
+                    {
+                        duk_error(ctx, DUK_ERR_ERROR, "Each tile must have exactly one surface element.");
+                    }
+                    tileStarts.push_back(tileStart);
+                    tileStart = i + 1;
+                    numSurfaces = 0;
+                }
+            }
+            if (tileStart != elements.size() || tileStarts.size() != static_cast<size_t>(width) * height)
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Tile data does not match the size of the range.");
+            }
+
+            size_t numElementsInRange = 0;
+            for (int32_t tileY = y; tileY < y + height; tileY++)
+            {
+                for (int32_t tileX = x; tileX < x + width; tileX++)
+                {
+                    numElementsInRange += CountTileElements(
+                        map_get_first_element_at(TileCoordsXY(tileX, tileY).ToCoordsXY()));
+                }
+            }
+            if (elements.size() > numElementsInRange
+                && !MapCheckCapacityAndReorganise(TileCoordsXY(x, y).ToCoordsXY(), elements.size() - numElementsInRange))
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Not enough room for the tile elements.");
+            }
+
+            size_t tileIndex = 0;
+            for (int32_t tileY = y; tileY < y + height; tileY++)
+            {
+                for (int32_t tileX = x; tileX < x + width; tileX++)
+                {
+                    auto start = tileStarts[tileIndex];
+                    auto end = tileIndex + 1 < tileStarts.size() ? tileStarts[tileIndex + 1] : elements.size();
+                    auto tilePos = TileCoordsXY(tileX, tileY);
+                    map_replace_tile_elements(tilePos, &elements[start], end - start);
+                    map_invalidate_tile_full(tilePos.ToCoordsXY());
+                    tileIndex++;
+                }
+            }
+
+            // The caches that depend on the map are only invalidated once for the whole range.
+            map_on_all_tiles_changed();
+        }
+
+        static void Register(duk_context* ctx)
+        {
+            dukglue_register_property(ctx, &ScMap::size_get, nullptr, "size");
+            dukglue_register_property(ctx, &ScMap::numRides_get, nullptr, "numRides");
+            dukglue_register_property(ctx, &ScMap::numEntities_get, nullptr, "numEntities");
+            dukglue_register_property(ctx, &ScMap::rides_get, nullptr, "rides");
+            dukglue_register_method(ctx, &ScMap::getRide, "getRide");
+            dukglue_register_method(ctx, &ScMap::getTile, "getTile");
+            dukglue_register_method(ctx, &ScMap::getEntity, "getEntity");
+            dukglue_register_method(ctx, &ScMap::getAllEntities, "getAllEntities");
+            dukglue_register_method(ctx, &ScMap::queryEntities, "queryEntities");
+            dukglue_register_method(ctx, &ScMap::captureEntities, "captureEntities");
+            dukglue_register_method(ctx, &ScMap::getTileData, "getTileData");
+            dukglue_register_method(ctx, &ScMap::setTileData, "setTileData");
+        }
+
+    private:
+        static bool IsTileRangeValid(int32_t x, int32_t y, int32_t width, int32_t height)
+        {
+            return x >= 0 && y >= 0 && width > 0 && height > 0 && int64_t{ x } + width <= gMapSize
+                && int64_t{ y } + height <= gMapSize;
+        }
+
+        static size_t CountTileElements(const TileElement* element)
+        {
+            size_t count = 0;
+            if (element != nullptr)
+            {
+                do
+                {
+                    count++;
+                } while (!(element++)->IsLastForTile());
+            }
+            return count;
+        }
+
+        std::vector<const SpriteBase*> GetEntities(const std::string& type) const
+        {
+            std::vector<const SpriteBase*> result;
             if (type == "balloon")
             {
                 for (auto sprite : EntityList<Balloon>())
                 {
-                    result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScEntity>(sprite->sprite_index)));
+                    result.push_back(sprite);
                 }
             }
-            if (type == "car")
+            else if (type == "car")
             {
                 for (auto trainHead : TrainManager::View())
                 {
                     for (auto carId = trainHead->sprite_index; carId != SPRITE_INDEX_NULL;)
                     {
                         auto car = GetEntity<Vehicle>(carId);
-                        result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScVehicle>(carId)));
+                        result.push_back(car);
                         carId = car->next_vehicle_on_train;
                     }
                 }
@@ -126,48 +478,34 @@ namespace OpenRCT2::Scripting
             {
                 for (auto sprite : EntityList<Litter>())
                 {
-                    result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScEntity>(sprite->sprite_index)));
+                    result.push_back(sprite);
                 }
             }
             else if (type == "duck")
             {
                 for (auto sprite : EntityList<Duck>())
                 {
-                    result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScEntity>(sprite->sprite_index)));
+                    result.push_back(sprite);
                 }
             }
             else if (type == "peep")
             {
                 for (auto sprite : EntityList<Guest>())
                 {
-                    result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScGuest>(sprite->sprite_index)));
+                    result.push_back(sprite);
                 }
                 for (auto sprite : EntityList<Staff>())
                 {
-                    result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScStaff>(sprite->sprite_index)));
+                    result.push_back(sprite);
                 }
             }
             else
             {
                 duk_error(_context, DUK_ERR_ERROR, "Invalid entity type.");
             }
-
             return result;
         }
 
-        static void Register(duk_context* ctx)
-        {
-            dukglue_register_property(ctx, &ScMap::size_get, nullptr, "size");
-            dukglue_register_property(ctx, &ScMap::numRides_get, nullptr, "numRides");
-            dukglue_register_property(ctx, &ScMap::numEntities_get, nullptr, "numEntities");
-            dukglue_register_property(ctx, &ScMap::rides_get, nullptr, "rides");
-            dukglue_register_method(ctx, &ScMap::getRide, "getRide");
-            dukglue_register_method(ctx, &ScMap::getTile, "getTile");
-            dukglue_register_method(ctx, &ScMap::getEntity, "getEntity");
-            dukglue_register_method(ctx, &ScMap::getAllEntities, "getAllEntities");
-        }
-
-    private:
         DukValue GetEntityAsDukValue(const SpriteBase* sprite) const
         {
             auto spriteId = sprite->sprite_index;
@@ -116,7 +116,15 @@ namespace OpenRCT2::Scripting
             return _plugin;
         }
 
-        virtual void Update() = 0;
+        /**
+         * Returns the underlying socket, so the script engine can check every socket for data at once.
+         */
+        virtual const ITcpSocket* GetTcpSocket() const = 0;
+
+        /**
+         * @param canRead Whether the socket has data to read, an incoming connection or an error.
+         */
+        virtual void Update(bool canRead) = 0;
 
         virtual void Dispose()
         {
@@ -133,12 +141,21 @@ namespace OpenRCT2::Scripting
         static constexpr uint32_t EVENT_DATA = 1;
         static constexpr uint32_t EVENT_CONNECT_ONCE = 2;
         static constexpr uint32_t EVENT_ERROR = 3;
+        static constexpr uint32_t EVENT_DRAIN = 4;
+
+        // Limits how much is read in one update, so a busy connection can not stall the game
+        static constexpr size_t READ_CHUNK_SIZE = 16 * 1024;
+        static constexpr size_t MAX_READ_SIZE = 1024 * 1024;
 
         EventList _eventList;
         std::unique_ptr<ITcpSocket> _socket;
+        std::vector<uint8_t> _pendingData;
         bool _disposed{};
         bool _connecting{};
         bool _wasConnected{};
+        bool _ending{};
+        bool _needsDrain{};
+        bool _rawData{};
 
     public:
         ScSocket(const std::shared_ptr<Plugin>& plugin)
@@ -213,43 +230,137 @@ namespace OpenRCT2::Scripting
             }
             else if (_socket != nullptr)
             {
-                if (data.type() == DukValue::Type::STRING)
+                if (data.type() != DukValue::Type::UNDEFINED)
                 {
-                    write(data.as_string());
-                    _socket->Finish();
+                    write(data);
                 }
-                else
+
+                // Anything still queued is sent before the connection is finished
+                _ending = true;
+                if (_pendingData.empty())
                 {
                     _socket->Finish();
-                    auto ctx = GetContext()->GetScriptEngine().GetContext();
-                    duk_error(ctx, DUK_ERR_ERROR, "Only sending strings is currently supported.");
                 }
             }
             return this;
         }
 
-        bool write(const std::string& data)
+        /**
+         * Sends a string or the contents of a buffer. Anything the socket can not take straight away is queued and sent
+         * on later updates. Returns false if anything is queued, in which case a drain event is raised once it has all
+         * been sent.
+         */
+        bool write(const DukValue& data)
         {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
             if (_disposed)
             {
-                auto ctx = GetContext()->GetScriptEngine().GetContext();
                 duk_error(ctx, DUK_ERR_ERROR, "Socket is disposed.");
             }
             else if (_socket != nullptr)
             {
-                try
+                // Send straight from the string or buffer, without copying it first
+                const void* buffer{};
+                duk_size_t length{};
+                data.push();
+                if (duk_is_string(ctx, -1))
                 {
-                    auto sentBytes = _socket->SendData(data.c_str(), data.size());
-                    return sentBytes != data.size();
+                    buffer = duk_get_lstring(ctx, -1, &length);
                 }
-                catch (const std::exception&)
+                else
                 {
-                    return false;
+                    buffer = duk_get_buffer_data(ctx, -1, &length);
                 }
+                if (buffer == nullptr)
+                {
+                    duk_pop(ctx);
+                    duk_error(ctx, DUK_ERR_ERROR, "Only strings and buffers can be sent.");
+                }
+
+                bool flushed = Send(buffer, length);
+                duk_pop(ctx);
+                return flushed;
             }
             return false;
         }
 
+        uint32_t writableLength_get() const
+        {
+            return static_cast<uint32_t>(_pendingData.size());
+        }
+
+        ScSocket* setEncoding(const std::string& encoding)
+        {
+            if (encoding == "utf8")
+            {
+                _rawData = false;
+            }
+            else if (encoding == "arraybuffer")
+            {
+                _rawData = true;
+            }
+            else
+            {
+                auto ctx = GetContext()->GetScriptEngine().GetContext();
+                duk_error(ctx, DUK_ERR_ERROR, "Unknown encoding.");
+            }
+            return this;
+        }
+
+        bool Send(const void* buffer, size_t length)
+        {
+            try
+            {
+                // Data must go out in order, so nothing can be sent while older data is still queued
+                size_t sentBytes = 0;
+                if (_pendingData.empty())
+                {
+                    sentBytes = _socket->SendData(buffer, length);
+                }
+                if (sentBytes < length)
+                {
+                    const auto* bytes = static_cast<const uint8_t*>(buffer);
+                    _pendingData.insert(_pendingData.end(), bytes + sentBytes, bytes + length);
+                    _needsDrain = true;
+                    return false;
+                }
+                return true;
+            }
+            catch (const std::exception&)
+            {
+                return false;
+            }
+        }
+
+        void FlushPendingData()
+        {
+            if (_pendingData.empty())
+                return;
+
+            try
+            {
+                auto sentBytes = _socket->SendData(_pendingData.data(), _pendingData.size());
+                _pendingData.erase(_pendingData.begin(), _pendingData.begin() + sentBytes);
+            }
+            catch (const std::exception&)
+            {
+                _pendingData.clear();
+            }
+
+            if (_pendingData.empty())
+            {
+                if (_ending)
+                {
+                    _socket->Finish();
+                }
+                if (_needsDrain)
+                {
+                    _needsDrain = false;
+                    _eventList.Raise(EVENT_DRAIN, GetPlugin(), {}, false);
+                }
+            }
+        }
+
         ScSocket* on(const std::string& eventType, const DukValue& callback)
         {
             auto eventId = GetEventType(eventType);
@@ -276,6 +387,9 @@ namespace OpenRCT2::Scripting
             {
                 _socket->Close();
                 _socket = nullptr;
+                _pendingData.clear();
+                _needsDrain = false;
+                _ending = false;
                 if (_wasConnected)
                 {
                     _wasConnected = false;
@@ -290,11 +404,51 @@ namespace OpenRCT2::Scripting
             _eventList.Raise(EVENT_CLOSE, GetPlugin(), { ToDuk(ctx, hadError) }, false);
         }
 
-        void RaiseOnData(const std::string& data)
+        /**
+         * Reads everything that has arrived, up to a limit, straight into a Duktape buffer and raises a single data event
+         * for it. Returns false if the connection has been closed.
+         */
+        bool ReadData()
         {
             auto& scriptEngine = GetContext()->GetScriptEngine();
             auto ctx = scriptEngine.GetContext();
-            _eventList.Raise(EVENT_DATA, GetPlugin(), { ToDuk(ctx, data) }, false);
+
+            auto result = NetworkReadPacket::Success;
+            size_t length = 0;
+            auto* buffer = duk_push_dynamic_buffer(ctx, READ_CHUNK_SIZE);
+            while (result == NetworkReadPacket::Success && length < MAX_READ_SIZE)
+            {
+                if (length + READ_CHUNK_SIZE > duk_get_length(ctx, -1))
+                {
+                    buffer = duk_resize_buffer(ctx, -1, length + READ_CHUNK_SIZE);
+                }
+
+                size_t bytesRead{};
+                result = _socket->ReceiveData(static_cast<uint8_t*>(buffer) + length, READ_CHUNK_SIZE, &bytesRead);
+                length += bytesRead;
+                if (bytesRead < READ_CHUNK_SIZE)
+                    break;
+            }
+
+            if (length > 0)
+            {
+                if (_rawData)
+                {
+                    duk_push_buffer_object(ctx, -1, 0, length, DUK_BUFOBJ_ARRAYBUFFER);
+                }
+                else
+                {
+                    duk_push_lstring(ctx, static_cast<const char*>(buffer), length);
+                }
+                duk_remove(ctx, -2);
+                auto data = DukValue::take_from_stack(ctx);
+                _eventList.Raise(EVENT_DATA, GetPlugin(), { data }, false);
+            }
+            else
+            {
+                duk_pop(ctx);
+            }
+            return result != NetworkReadPacket::Disconnected;
         }
 
         uint32_t GetEventType(std::string_view name)
@@ -305,11 +459,18 @@ namespace OpenRCT2::Scripting
                 return EVENT_DATA;
             if (name == "error")
                 return EVENT_ERROR;
+            if (name == "drain")
+                return EVENT_DRAIN;
             return EVENT_NONE;
         }
 
     public:
-        void Update() override
+        const ITcpSocket* GetTcpSocket() const override
+        {
+            return _socket.get();
+        }
+
+        void Update(bool canRead) override
         {
             if (_disposed)
                 return;
@@ -343,21 +504,10 @@ namespace OpenRCT2::Scripting
                 }
                 else if (status == SocketStatus::Connected)
                 {
-                    char buffer[2048];
-                    size_t bytesRead{};
-                    auto result = _socket->ReceiveData(buffer, sizeof(buffer), &bytesRead);
-                    switch (result)
+                    FlushPendingData();
+                    if (canRead && _socket != nullptr && !ReadData())
                     {
-                        case NetworkReadPacket::Success:
-                            RaiseOnData(std::string(buffer, bytesRead));
-                            break;
-                        case NetworkReadPacket::NoData:
-                            break;
-                        case NetworkReadPacket::MoreData:
-                            break;
-                        case NetworkReadPacket::Disconnected:
-                            CloseSocket();
-                            break;
+                        CloseSocket();
                     }
                 }
                 else
@@ -380,7 +530,9 @@ namespace OpenRCT2::Scripting
 
         static void Register(duk_context* ctx)
         {
+            dukglue_register_property(ctx, &ScSocket::writableLength_get, nullptr, "writableLength");
             dukglue_register_method(ctx, &ScSocket::destroy, "destroy");
+            dukglue_register_method(ctx, &ScSocket::setEncoding, "setEncoding");
             dukglue_register_method(ctx, &ScSocket::setNoDelay, "setNoDelay");
             dukglue_register_method(ctx, &ScSocket::connect, "connect");
             dukglue_register_method(ctx, &ScSocket::end, "end");
@@ -497,7 +649,12 @@ namespace OpenRCT2::Scripting
         {
         }
 
-        void Update() override
+        const ITcpSocket* GetTcpSocket() const override
+        {
+            return _socket.get();
+        }
+
+        void Update(bool canRead) override
         {
             if (_disposed)
                 return;
@@ -505,7 +662,7 @@ namespace OpenRCT2::Scripting
             if (_socket == nullptr)
                 return;
 
-            if (_socket->GetStatus() == SocketStatus::Listening)
+            if (canRead && _socket->GetStatus() == SocketStatus::Listening)
             {
                 auto client = _socket->Accept();
                 if (client != nullptr)
@@ -41,6 +41,20 @@ namespace OpenRCT2::Scripting
             : _coords(coords)
             , _element(element)
         {
+            // The element must stay on this tile for as long as the plugin can use it.
+            MapAddTileElementHolder();
+        }
+
+        ScTileElement(const ScTileElement& other)
+            : ScTileElement(other._coords, other._element)
+        {
+        }
+
+        ScTileElement& operator=(const ScTileElement& other) = default;
+
+        ~ScTileElement()
+        {
+            MapRemoveTileElementHolder();
         }
 
     private:
@@ -1476,6 +1490,7 @@ namespace OpenRCT2::Scripting
         void Invalidate()
         {
             map_invalidate_tile_full(_coords);
+            map_on_all_tiles_changed();
         }
 
     public:
@@ -0,0 +1,110 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "../Context.h"
+#    include "Duktape.hpp"
+#    include "ScriptEngine.h"
+#    include "ScriptWorker.h"
+
+#    include <memory>
+#    include <string>
+
+namespace OpenRCT2::Scripting
+{
+    class ScWorker
+    {
+    private:
+        std::shared_ptr<Plugin> _plugin;
+        ScriptWorker _worker;
+        DukValue _onMessage;
+        bool _disposed{};
+
+    public:
+        ScWorker(const std::shared_ptr<Plugin>& plugin, const std::string& code, const DukValue& onMessage)
+            : _plugin(plugin)
+            , _worker(code)
+            , _onMessage(onMessage)
+        {
+        }
+
+        const std::shared_ptr<Plugin>& GetPlugin() const
+        {
+            return _plugin;
+        }
+
+        void Update()
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto ctx = scriptEngine.GetContext();
+            for (const auto& message : _worker.Receive())
+            {
+                switch (message.Type)
+                {
+                    case ScriptWorkerMessage::Kind::Message:
+                    {
+                        auto value = DuktapeTryParseJson(ctx, message.Data);
+                        if (value && !_disposed)
+                        {
+                            scriptEngine.ExecutePluginCall(_plugin, _onMessage, { *value }, false);
+                        }
+                        break;
+                    }
+                    case ScriptWorkerMessage::Kind::Log:
+                    case ScriptWorkerMessage::Kind::Error:
+                        scriptEngine.LogPluginInfo(_plugin, "[worker] " + message.Data);
+                        break;
+                }
+            }
+        }
+
+        void Dispose()
+        {
+            _worker.Terminate();
+            _onMessage = {};
+            _disposed = true;
+        }
+
+        bool IsDisposed() const
+        {
+            return _disposed;
+        }
+
+    private:
+        void postMessage(const DukValue& value)
+        {
+            if (_disposed)
+                return;
+
+            auto ctx = value.context();
+            value.push();
+            duk_json_encode(ctx, -1);
+            auto json = duk_get_string(ctx, -1);
+            _worker.Post(json != nullptr ? json : "null");
+            duk_pop(ctx);
+        }
+
+        void terminate()
+        {
+            Dispose();
+        }
+
+    public:
+        static void Register(duk_context* ctx)
+        {
+            dukglue_register_method(ctx, &ScWorker::postMessage, "postMessage");
+            dukglue_register_method(ctx, &ScWorker::terminate, "terminate");
+        }
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
@@ -11,6 +11,7 @@
 
 #    include "ScriptEngine.h"
 
+#    include "../Game.h"
 #    include "../PlatformEnvironment.h"
 #    include "../actions/CustomAction.h"
 #    include "../actions/GameAction.h"
@@ -19,7 +20,9 @@
 #    include "../config/Config.h"
 #    include "../core/File.h"
 #    include "../core/FileScanner.h"
+#    include "../core/MemoryUsage.h"
 #    include "../core/Path.hpp"
+#    include "../core/String.hpp"
 #    include "../interface/InteractiveConsole.h"
 #    include "../platform/Platform2.h"
 #    include "Duktape.hpp"
@@ -38,7 +41,11 @@
 #    include "ScScenario.hpp"
 #    include "ScSocket.hpp"
 #    include "ScTile.hpp"
+#    include "ScWorker.hpp"
 
+#    include <cstddef>
+#    include <cstdlib>
+#    include <cstring>
 #    include <iostream>
 #    include <stdexcept>
 
@@ -353,9 +360,58 @@ public:
     }
 };
 
+// Each allocation made by duktape is prefixed with its size, so the scripting heap can be accounted for in memory usage.
+static constexpr size_t DUK_ALLOC_HEADER_SIZE = alignof(std::max_align_t);
+
+static void* DukAlloc(void* udata, duk_size_t size)
+{
+    auto* block = static_cast<uint8_t*>(std::malloc(size + DUK_ALLOC_HEADER_SIZE));
+    if (block == nullptr)
+        return nullptr;
+
+    std::memcpy(block, &size, sizeof(size));
+    MemoryUsage::Add(MemoryUsage::Category::Scripting, size);
+    return block + DUK_ALLOC_HEADER_SIZE;
+}
+
+static void DukFree(void* udata, void* ptr)
+{
+    if (ptr == nullptr)
+        return;
+
+    auto* block = static_cast<uint8_t*>(ptr) - DUK_ALLOC_HEADER_SIZE;
+    duk_size_t size;
+    std::memcpy(&size, block, sizeof(size));
+    MemoryUsage::Remove(MemoryUsage::Category::Scripting, size);
+    std::free(block);
+}
+
+static void* DukRealloc(void* udata, void* ptr, duk_size_t newSize)
+{
+    if (ptr == nullptr)
+        return DukAlloc(udata, newSize);
+    if (newSize == 0)
+    {
+        DukFree(udata, ptr);
+        return nullptr;
+    }
+
+    auto* block = static_cast<uint8_t*>(ptr) - DUK_ALLOC_HEADER_SIZE;
+    duk_size_t oldSize;
+    std::memcpy(&oldSize, block, sizeof(oldSize));
+    auto* newBlock = static_cast<uint8_t*>(std::realloc(block, newSize + DUK_ALLOC_HEADER_SIZE));
+    if (newBlock == nullptr)
+        return nullptr;
+
+    std::memcpy(newBlock, &newSize, sizeof(newSize));
+    MemoryUsage::Remove(MemoryUsage::Category::Scripting, oldSize);
+    MemoryUsage::Add(MemoryUsage::Category::Scripting, newSize);
+    return newBlock + DUK_ALLOC_HEADER_SIZE;
+}
+
 DukContext::DukContext()
 {
-    _context = duk_create_heap_default();
+    _context = duk_create_heap(DukAlloc, DukRealloc, DukFree, nullptr, nullptr);
     if (_context == nullptr)
     {
         throw std::runtime_error("Unable to initialise duktape context.");
@@ -385,6 +441,7 @@ void ScriptEngine::Initialise()
     ScContext::Register(ctx);
     ScDate::Register(ctx);
     ScDisposable::Register(ctx);
+    ScEntitySnapshot::Register(ctx);
     ScMap::Register(ctx);
     ScNetwork::Register(ctx);
     ScObject::Register(ctx);
@@ -410,6 +467,7 @@ void ScriptEngine::Initialise()
     ScScenario::Register(ctx);
     ScScenarioObjective::Register(ctx);
     ScStaff::Register(ctx);
+    ScWorker::Register(ctx);
 
     dukglue_register_global(ctx, std::make_shared<ScCheats>(), "cheats");
     dukglue_register_global(ctx, std::make_shared<ScClimate>(), "climate");
@@ -473,7 +531,7 @@ void ScriptEngine::LoadPlugin(std::shared_ptr<Plugin>& plugin)
     try
     {
         ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, false);
-        plugin->Load();
+        plugin->Load(GetBytecodeCacheDirectory(*plugin));
 
         auto metadata = plugin->GetMetadata();
         if (metadata.MinApiVersion <= OPENRCT2_PLUGIN_API_VERSION)
@@ -492,6 +550,14 @@ void ScriptEngine::LoadPlugin(std::shared_ptr<Plugin>& plugin)
     }
 }
 
+std::string ScriptEngine::GetBytecodeCacheDirectory(const Plugin& plugin) const
+{
+    // Only plug-ins from disk are worth caching, network plug-ins are different for every server.
+    if (!plugin.HasPath())
+        return {};
+    return Path::Combine(_env.GetDirectoryPath(DIRBASE::CACHE), "plugin");
+}
+
 void ScriptEngine::StopPlugin(std::shared_ptr<Plugin> plugin)
 {
     if (plugin->HasStarted())
@@ -499,6 +565,7 @@ void ScriptEngine::StopPlugin(std::shared_ptr<Plugin> plugin)
         RemoveCustomGameActions(plugin);
         RemoveIntervals(plugin);
         RemoveSockets(plugin);
+        RemoveWorkers(plugin);
         _hookEngine.UnsubscribeAll(plugin);
         for (const auto& callback : _pluginStoppedSubscriptions)
         {
@@ -528,11 +595,10 @@ void ScriptEngine::SetupHotReloading()
     try
     {
         auto base = _env.GetDirectoryPath(DIRBASE::USER, DIRID::PLUGIN);
-        _pluginFileWatcher = std::make_unique<FileWatcher>(base);
-        _pluginFileWatcher->OnFileChanged = [this](const std::string& path) {
+        _pluginFileWatcher = std::make_unique<FileWatcher>(base, [this](const std::string& path) {
             std::lock_guard<std::mutex> guard(_changedPluginFilesMutex);
             _changedPluginFiles.emplace(path);
-        };
+        });
     }
     catch (const std::exception& e)
     {
@@ -558,7 +624,7 @@ void ScriptEngine::AutoReloadPlugins()
                     StopPlugin(plugin);
 
                     ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, false);
-                    plugin->Load();
+                    plugin->Load(GetBytecodeCacheDirectory(*plugin));
                     LogPluginInfo(plugin, "Reloaded");
                     plugin->Start();
                 }
@@ -662,7 +728,9 @@ void ScriptEngine::Update()
 
     UpdateIntervals();
     UpdateSockets();
+    UpdateWorkers();
     ProcessREPL();
+    CheckTickBudget();
 }
 
 void ScriptEngine::ProcessREPL()
@@ -755,7 +823,7 @@ void ScriptEngine::AddNetworkPlugin(std::string_view code)
 }
 
 std::unique_ptr<GameActions::Result> ScriptEngine::QueryOrExecuteCustomGameAction(
-    std::string_view id, std::string_view args, bool isExecute)
+    std::string_view id, std::string_view args, bool isExecute, bool isBatch)
 {
     std::string actionz = std::string(id);
     auto kvp = _customActions.find(actionz);
@@ -775,6 +843,11 @@ std::unique_ptr<GameActions::Result> ScriptEngine::QueryOrExecuteCustomGameActio
             return action;
         }
 
+        if (isBatch)
+        {
+            return QueryOrExecuteCustomGameActionBatch(customAction, *dukArgs, isExecute);
+        }
+
         // Ready to call plugin handler
         DukValue dukResult;
         if (!isExecute)
@@ -796,6 +869,50 @@ std::unique_ptr<GameActions::Result> ScriptEngine::QueryOrExecuteCustomGameActio
     }
 }
 
+std::unique_ptr<GameActions::Result> ScriptEngine::QueryOrExecuteCustomGameActionBatch(
+    const CustomActionInfo& customAction, const DukValue& args, bool isExecute)
+{
+    if (!args.is_array())
+    {
+        auto action = std::make_unique<GameActions::Result>();
+        action->Error = GameActions::Status::InvalidParameters;
+        action->ErrorTitle = "Invalid batch";
+        return action;
+    }
+
+    // Every item is queried before any is executed, so an invalid item stops the whole batch rather than leaving it
+    // half done. The costs of the items are added up.
+    auto items = args.as_array();
+    auto result = std::make_unique<GameActions::Result>();
+    for (const auto& item : items)
+    {
+        auto itemResult = DukToGameActionResult(ExecutePluginCall(customAction.Owner, customAction.Query, { item }, false));
+        if (itemResult->Error != GameActions::Status::Ok)
+        {
+            return itemResult;
+        }
+        result->Cost += itemResult->Cost;
+        result->Expenditure = itemResult->Expenditure;
+    }
+
+    if (isExecute)
+    {
+        result->Cost = 0;
+        for (const auto& item : items)
+        {
+            auto itemResult = DukToGameActionResult(
+                ExecutePluginCall(customAction.Owner, customAction.Execute, { item }, true));
+            if (itemResult->Error != GameActions::Status::Ok)
+            {
+                return itemResult;
+            }
+            result->Cost += itemResult->Cost;
+            result->Expenditure = itemResult->Expenditure;
+        }
+    }
+    return result;
+}
+
 std::unique_ptr<GameActions::Result> ScriptEngine::DukToGameActionResult(const DukValue& d)
 {
     auto result = std::make_unique<GameActions::Result>();
@@ -1091,18 +1208,20 @@ static std::unique_ptr<GameAction> CreateGameActionFromActionId(const std::strin
 
 void ScriptEngine::RunGameActionHooks(const GameAction& action, std::unique_ptr<GameActions::Result>& result, bool isExecute)
 {
-    DukStackFrame frame(_context);
-
     auto hookType = isExecute ? HOOK_TYPE::ACTION_EXECUTE : HOOK_TYPE::ACTION_QUERY;
     if (_hookEngine.HasSubscriptions(hookType))
     {
+        DukStackFrame frame(_context);
         DukObject obj(_context);
 
+        // Subscriptions can be filtered by the name of the action
+        std::string actionName;
         auto actionId = action.GetType();
         if (action.GetType() == GameCommand::Custom)
         {
-            auto customAction = static_cast<const CustomAction&>(action);
-            obj.Set("action", customAction.GetId());
+            const auto& customAction = static_cast<const CustomAction&>(action);
+            actionName = customAction.GetId();
+            obj.Set("action", actionName);
 
             auto dukArgs = DuktapeTryParseJson(_context, customAction.GetJson());
             if (dukArgs)
@@ -1117,7 +1236,7 @@ void ScriptEngine::RunGameActionHooks(const GameAction& action, std::unique_ptr<
         }
         else
         {
-            auto actionName = GetActionName(actionId);
+            actionName = GetActionName(actionId);
             if (!actionName.empty())
             {
                 obj.Set("action", actionName);
@@ -1135,11 +1254,15 @@ void ScriptEngine::RunGameActionHooks(const GameAction& action, std::unique_ptr<
 
         auto flags = action.GetActionFlags();
         obj.Set("isClientOnly", (flags & GameActions::Flags::ClientOnly) != 0);
+        if (actionId == GameCommand::Custom)
+        {
+            obj.Set("isBatch", static_cast<const CustomAction&>(action).IsBatch());
+        }
 
         obj.Set("result", GameActionResultToDuk(action, result));
         auto dukEventArgs = obj.Take();
 
-        _hookEngine.Call(hookType, dukEventArgs, false);
+        _hookEngine.Call(hookType, dukEventArgs, false, actionName);
 
         if (!isExecute)
         {
@@ -1191,6 +1314,21 @@ std::unique_ptr<GameAction> ScriptEngine::CreateGameAction(const std::string& ac
     }
 }
 
+std::unique_ptr<GameAction> ScriptEngine::CreateCustomGameActionBatch(const std::string& actionid, const DukValue& args)
+{
+    // Only plug-in actions can be batched, built-in actions are sent with their own parameters.
+    if (ActionNameToType.find(actionid) != ActionNameToType.end() || !args.is_array())
+    {
+        return nullptr;
+    }
+
+    auto ctx = args.context();
+    args.push();
+    auto json = std::string(duk_json_encode(ctx, -1));
+    duk_pop(ctx);
+    return std::make_unique<CustomAction>(actionid, json, true);
+}
+
 void ScriptEngine::InitSharedStorage()
 {
     duk_push_object(_context);
@@ -1298,18 +1436,40 @@ void ScriptEngine::UpdateIntervals()
     }
     _lastIntervalTimestamp = timestamp;
 
-    for (auto& interval : _intervals)
+    // Callbacks can add intervals, so they are looked up by index rather than held by reference
+    auto budget = GetTickBudget();
+    auto numIntervals = _intervals.size();
+    auto hasCalledInterval = false;
+    for (size_t i = 0; i < numIntervals; i++)
     {
-        if (interval.IsValid())
+        auto index = (_nextIntervalIndex + i) % numIntervals;
+        if (budget && hasCalledInterval && _budgetTimeUsed >= *budget)
         {
-            if (timestamp >= interval.LastTimestamp + interval.Delay)
-            {
-                ExecutePluginCall(interval.Owner, interval.Callback, {}, false);
+            // Leave the remaining intervals until the next update, starting with the first one that missed out. At
+            // least one is always called so that a plugin over budget can not stop the others' intervals entirely.
+            _nextIntervalIndex = index;
+            break;
+        }
+
+        auto& interval = _intervals[index];
+        if (interval.IsValid() && timestamp >= interval.LastTimestamp + interval.Delay)
+        {
+            auto owner = interval.Owner;
+            auto handle = interval.Handle;
+            auto callback = interval.Callback;
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            ExecutePluginCall(owner, callback, {}, false);
+            RecordPluginTime(owner, HOOK_TYPE::UNDEFINED, std::chrono::high_resolution_clock::now() - startTime);
+            hasCalledInterval = true;
 
-                interval.LastTimestamp = timestamp;
-                if (!interval.Repeat)
+            auto& calledInterval = _intervals[index];
+            if (calledInterval.Handle == handle)
+            {
+                calledInterval.LastTimestamp = timestamp;
+                if (!calledInterval.Repeat)
                 {
-                    RemoveInterval(nullptr, interval.Handle);
+                    RemoveInterval(nullptr, handle);
                 }
             }
         }
@@ -1327,6 +1487,72 @@ void ScriptEngine::RemoveIntervals(const std::shared_ptr<Plugin>& plugin)
     }
 }
 
+void ScriptEngine::RecordPluginTime(const std::shared_ptr<Plugin>& plugin, HOOK_TYPE type, std::chrono::nanoseconds time)
+{
+    if (plugin == nullptr)
+        return;
+
+    auto& timing = type == HOOK_TYPE::UNDEFINED ? plugin->GetIntervalTiming() : plugin->GetHookTiming(type);
+    timing.Record(time);
+
+    _budgetTimeUsed += time;
+    if (time > _slowestCallTime)
+    {
+        _slowestCallPlugin = plugin;
+        _slowestCallType = type;
+        _slowestCallTime = time;
+    }
+}
+
+void ScriptEngine::ResetPluginTimings()
+{
+    for (auto& plugin : _plugins)
+    {
+        plugin->ResetTimings();
+    }
+}
+
+std::string_view ScriptEngine::GetPluginTimingName(HOOK_TYPE type)
+{
+    return type == HOOK_TYPE::UNDEFINED ? "timers" : GetHookName(type);
+}
+
+std::optional<std::chrono::nanoseconds> ScriptEngine::GetTickBudget() const
+{
+    if (gConfigPlugin.tick_budget <= 0)
+        return std::nullopt;
+
+    // The game can run several ticks in one update, each of which gets its own share of the budget
+    auto numTicks = gCurrentTicks > _budgetLastTick ? gCurrentTicks - _budgetLastTick : 1;
+    return std::chrono::milliseconds(gConfigPlugin.tick_budget) * numTicks;
+}
+
+void ScriptEngine::CheckTickBudget()
+{
+    auto budget = GetTickBudget();
+    if (budget && _budgetTimeUsed > *budget && _slowestCallPlugin != nullptr)
+    {
+        // Only warn every few seconds, a plugin that is slow will usually be slow on every tick
+        auto timestamp = Platform::GetTicks();
+        if (_budgetLastWarningTimestamp == 0 || timestamp - _budgetLastWarningTimestamp >= 10000)
+        {
+            using Milliseconds = std::chrono::duration<double, std::milli>;
+            auto message = String::StdFormat(
+                "Plugins took %.1f ms, over the budget of %.1f ms. Slowest was %s, taking %.1f ms.",
+                Milliseconds(_budgetTimeUsed).count(), Milliseconds(*budget).count(),
+                std::string(GetPluginTimingName(_slowestCallType)).c_str(), Milliseconds(_slowestCallTime).count());
+            LogPluginInfo(_slowestCallPlugin, message);
+            _budgetLastWarningTimestamp = timestamp;
+        }
+    }
+
+    _budgetTimeUsed = {};
+    _budgetLastTick = gCurrentTicks;
+    _slowestCallPlugin = nullptr;
+    _slowestCallType = {};
+    _slowestCallTime = {};
+}
+
 #    ifndef DISABLE_NETWORK
 void ScriptEngine::AddSocket(const std::shared_ptr<ScSocketBase>& socket)
 {
@@ -1337,12 +1563,25 @@ void ScriptEngine::AddSocket(const std::shared_ptr<ScSocketBase>& socket)
 void ScriptEngine::UpdateSockets()
 {
 #    ifndef DISABLE_NETWORK
+    // Check every socket at once, so only those with something to read are read from
+    std::vector<const ITcpSocket*> tcpSockets;
+    tcpSockets.reserve(_sockets.size());
+    for (const auto& socket : _sockets)
+    {
+        tcpSockets.push_back(socket->GetTcpSocket());
+    }
+    const auto readable = GetReadableTcpSockets(tcpSockets);
+
     // Use simple for i loop as Update calls can modify the list
+    size_t socketIndex = 0;
     auto it = _sockets.begin();
     while (it != _sockets.end())
     {
+        // Sockets accepted during this update have not been checked yet
         auto& socket = *it;
-        socket->Update();
+        bool canRead = socketIndex >= readable.size() || readable[socketIndex];
+        socketIndex++;
+        socket->Update(canRead);
         if (socket->IsDisposed())
         {
             it = _sockets.erase(it);
@@ -1375,6 +1614,48 @@ void ScriptEngine::RemoveSockets(const std::shared_ptr<Plugin>& plugin)
 #    endif
 }
 
+void ScriptEngine::AddWorker(const std::shared_ptr<ScWorker>& worker)
+{
+    _workers.push_back(worker);
+}
+
+void ScriptEngine::UpdateWorkers()
+{
+    // Message callbacks can create or terminate workers
+    auto it = _workers.begin();
+    while (it != _workers.end())
+    {
+        auto worker = *it;
+        worker->Update();
+        if (worker->IsDisposed())
+        {
+            it = _workers.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+void ScriptEngine::RemoveWorkers(const std::shared_ptr<Plugin>& plugin)
+{
+    auto it = _workers.begin();
+    while (it != _workers.end())
+    {
+        auto worker = it->get();
+        if (worker->GetPlugin() == plugin)
+        {
+            worker->Dispose();
+            it = _workers.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
 std::string OpenRCT2::Scripting::Stringify(const DukValue& val)
 {
     return ExpressionStringifier::StringifyExpression(val);
@@ -18,10 +18,12 @@
 #    include "HookEngine.h"
 #    include "Plugin.h"
 
+#    include <chrono>
 #    include <future>
 #    include <list>
 #    include <memory>
 #    include <mutex>
+#    include <optional>
 #    include <queue>
 #    include <string>
 #    include <unordered_map>
@@ -46,11 +48,12 @@ namespace OpenRCT2
 
 namespace OpenRCT2::Scripting
 {
-    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 31;
+    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 39;
 
 #    ifndef DISABLE_NETWORK
     class ScSocketBase;
 #    endif
+    class ScWorker;
 
     class ScriptExecutionInfo
     {
@@ -153,6 +156,15 @@ namespace OpenRCT2::Scripting
 
         uint32_t _lastIntervalTimestamp{};
         std::vector<ScriptInterval> _intervals;
+        size_t _nextIntervalIndex{};
+
+        // Time spent in plugin callbacks since the tick budget was last checked
+        std::chrono::nanoseconds _budgetTimeUsed{};
+        uint32_t _budgetLastTick{};
+        uint32_t _budgetLastWarningTimestamp{};
+        std::shared_ptr<Plugin> _slowestCallPlugin;
+        HOOK_TYPE _slowestCallType{};
+        std::chrono::nanoseconds _slowestCallTime{};
 
         std::unique_ptr<FileWatcher> _pluginFileWatcher;
         std::unordered_set<std::string> _changedPluginFiles;
@@ -171,6 +183,7 @@ namespace OpenRCT2::Scripting
 #    ifndef DISABLE_NETWORK
         std::list<std::shared_ptr<ScSocketBase>> _sockets;
 #    endif
+        std::list<std::shared_ptr<ScWorker>> _workers;
 
     public:
         ScriptEngine(InteractiveConsole& console, IPlatformEnvironment& env);
@@ -218,20 +231,30 @@ namespace OpenRCT2::Scripting
         void AddNetworkPlugin(std::string_view code);
 
         std::unique_ptr<GameActions::Result> QueryOrExecuteCustomGameAction(
-            std::string_view id, std::string_view args, bool isExecute);
+            std::string_view id, std::string_view args, bool isExecute, bool isBatch);
         bool RegisterCustomAction(
             const std::shared_ptr<Plugin>& plugin, std::string_view action, const DukValue& query, const DukValue& execute);
         void RunGameActionHooks(const GameAction& action, std::unique_ptr<GameActions::Result>& result, bool isExecute);
         std::unique_ptr<GameAction> CreateGameAction(const std::string& actionid, const DukValue& args);
+        std::unique_ptr<GameAction> CreateCustomGameActionBatch(const std::string& actionid, const DukValue& args);
 
         void SaveSharedStorage();
 
         IntervalHandle AddInterval(const std::shared_ptr<Plugin>& plugin, int32_t delay, bool repeat, DukValue&& callback);
         void RemoveInterval(const std::shared_ptr<Plugin>& plugin, IntervalHandle handle);
 
+        /**
+         * Adds the time a plugin spent in a callback to its timings and the tick budget. HOOK_TYPE::UNDEFINED is used
+         * for callbacks registered with setInterval and setTimeout.
+         */
+        void RecordPluginTime(const std::shared_ptr<Plugin>& plugin, HOOK_TYPE type, std::chrono::nanoseconds time);
+        void ResetPluginTimings();
+        static std::string_view GetPluginTimingName(HOOK_TYPE type);
+
 #    ifndef DISABLE_NETWORK
         void AddSocket(const std::shared_ptr<ScSocketBase>& socket);
 #    endif
+        void AddWorker(const std::shared_ptr<ScWorker>& worker);
 
     private:
         void Initialise();
@@ -239,6 +262,7 @@ namespace OpenRCT2::Scripting
         void StopPlugins();
         void LoadPlugin(const std::string& path);
         void LoadPlugin(std::shared_ptr<Plugin>& plugin);
+        std::string GetBytecodeCacheDirectory(const Plugin& plugin) const;
         void StopPlugin(std::shared_ptr<Plugin> plugin);
         bool ShouldLoadScript(const std::string& path);
         bool ShouldStartPlugin(const std::shared_ptr<Plugin>& plugin);
@@ -248,6 +272,8 @@ namespace OpenRCT2::Scripting
         void RemoveCustomGameActions(const std::shared_ptr<Plugin>& plugin);
         std::unique_ptr<GameActions::Result> DukToGameActionResult(const DukValue& d);
         DukValue GameActionResultToDuk(const GameAction& action, const std::unique_ptr<GameActions::Result>& result);
+        std::unique_ptr<GameActions::Result> QueryOrExecuteCustomGameActionBatch(
+            const CustomActionInfo& customAction, const DukValue& args, bool isExecute);
         static std::string_view ExpenditureTypeToString(ExpenditureType expenditureType);
         static ExpenditureType StringToExpenditureType(std::string_view expenditureType);
 
@@ -256,10 +282,15 @@ namespace OpenRCT2::Scripting
 
         IntervalHandle AllocateHandle();
         void UpdateIntervals();
+        std::optional<std::chrono::nanoseconds> GetTickBudget() const;
+        void CheckTickBudget();
         void RemoveIntervals(const std::shared_ptr<Plugin>& plugin);
 
         void UpdateSockets();
         void RemoveSockets(const std::shared_ptr<Plugin>& plugin);
+
+        void UpdateWorkers();
+        void RemoveWorkers(const std::shared_ptr<Plugin>& plugin);
     };
 
     bool IsGameStateMutable();
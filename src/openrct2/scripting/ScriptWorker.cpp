@@ -0,0 +1,174 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "ScriptWorker.h"
+
+#    include "Duktape.hpp"
+#    include "ScriptEngine.h"
+
+#    include <condition_variable>
+#    include <deque>
+#    include <mutex>
+#    include <thread>
+#    include <utility>
+
+using namespace OpenRCT2::Scripting;
+
+static constexpr const char* WorkerStashKey = "worker";
+
+struct OpenRCT2::Scripting::ScriptWorkerState
+{
+    std::mutex Mutex;
+    std::condition_variable Signal;
+    std::deque<std::string> Inbox;
+    std::vector<ScriptWorkerMessage> Outbox;
+    bool Terminated{};
+
+    void Send(ScriptWorkerMessage::Kind kind, std::string data)
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Outbox.push_back({ kind, std::move(data) });
+    }
+};
+
+ScriptWorker::ScriptWorker(const std::string& code)
+    : _state(std::make_shared<ScriptWorkerState>())
+{
+    // The thread shares the state rather than the worker, so it can carry on after the worker is gone.
+    std::thread(Run, _state, code).detach();
+}
+
+ScriptWorker::~ScriptWorker()
+{
+    Terminate();
+}
+
+void ScriptWorker::Post(std::string json)
+{
+    {
+        std::lock_guard<std::mutex> lock(_state->Mutex);
+        _state->Inbox.push_back(std::move(json));
+    }
+    _state->Signal.notify_one();
+}
+
+std::vector<ScriptWorkerMessage> ScriptWorker::Receive()
+{
+    std::lock_guard<std::mutex> lock(_state->Mutex);
+    return std::exchange(_state->Outbox, {});
+}
+
+void ScriptWorker::Terminate()
+{
+    {
+        std::lock_guard<std::mutex> lock(_state->Mutex);
+        _state->Terminated = true;
+        _state->Inbox.clear();
+    }
+    _state->Signal.notify_one();
+}
+
+bool ScriptWorker::IsTerminated() const
+{
+    std::lock_guard<std::mutex> lock(_state->Mutex);
+    return _state->Terminated;
+}
+
+static ScriptWorkerState* GetWorkerState(duk_context* ctx)
+{
+    duk_push_global_stash(ctx);
+    duk_get_prop_string(ctx, -1, WorkerStashKey);
+    auto state = static_cast<ScriptWorkerState*>(duk_get_pointer(ctx, -1));
+    duk_pop_2(ctx);
+    return state;
+}
+
+static duk_ret_t WorkerPostMessage(duk_context* ctx)
+{
+    duk_dup(ctx, 0);
+    duk_json_encode(ctx, -1);
+    auto json = duk_get_string(ctx, -1);
+    GetWorkerState(ctx)->Send(ScriptWorkerMessage::Kind::Message, json != nullptr ? json : "null");
+    return 0;
+}
+
+static duk_ret_t WorkerConsoleLog(duk_context* ctx)
+{
+    std::string line;
+    auto numArgs = duk_get_top(ctx);
+    for (duk_idx_t i = 0; i < numArgs; i++)
+    {
+        if (i != 0)
+            line.push_back(' ');
+        line += duk_safe_to_string(ctx, i);
+    }
+    GetWorkerState(ctx)->Send(ScriptWorkerMessage::Kind::Log, std::move(line));
+    return 0;
+}
+
+void ScriptWorker::Run(std::shared_ptr<ScriptWorkerState> state, std::string code)
+{
+    try
+    {
+        DukContext context;
+        duk_context* ctx = context;
+
+        duk_push_global_stash(ctx);
+        duk_push_pointer(ctx, state.get());
+        duk_put_prop_string(ctx, -2, WorkerStashKey);
+        duk_pop(ctx);
+
+        duk_push_c_function(ctx, WorkerPostMessage, 1);
+        duk_put_global_string(ctx, "postMessage");
+        duk_push_object(ctx);
+        duk_push_c_function(ctx, WorkerConsoleLog, DUK_VARARGS);
+        duk_put_prop_string(ctx, -2, "log");
+        duk_put_global_string(ctx, "console");
+
+        if (duk_peval_lstring(ctx, code.data(), code.size()) != 0)
+        {
+            state->Send(ScriptWorkerMessage::Kind::Error, duk_safe_to_string(ctx, -1));
+        }
+        duk_pop(ctx);
+
+        while (true)
+        {
+            std::string json;
+            {
+                std::unique_lock<std::mutex> lock(state->Mutex);
+                state->Signal.wait(lock, [&state]() { return state->Terminated || !state->Inbox.empty(); });
+                if (state->Terminated)
+                    break;
+
+                json = std::move(state->Inbox.front());
+                state->Inbox.pop_front();
+            }
+
+            auto value = DuktapeTryParseJson(ctx, json);
+            duk_get_global_string(ctx, "onmessage");
+            if (value && duk_is_function(ctx, -1))
+            {
+                value->push();
+                if (duk_pcall(ctx, 1) != DUK_EXEC_SUCCESS)
+                {
+                    state->Send(ScriptWorkerMessage::Kind::Error, duk_safe_to_string(ctx, -1));
+                }
+            }
+            duk_pop(ctx);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        state->Send(ScriptWorkerMessage::Kind::Error, e.what());
+    }
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "../common.h"
+
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+namespace OpenRCT2::Scripting
+{
+    struct ScriptWorkerMessage
+    {
+        enum class Kind
+        {
+            // A value posted by the worker, as JSON
+            Message,
+            // A line written with console.log
+            Log,
+            // An error thrown by the worker
+            Error,
+        };
+
+        Kind Type{};
+        std::string Data;
+    };
+
+    struct ScriptWorkerState;
+
+    /**
+     * Runs code in its own duktape heap on a background thread. The worker has no access to the game, the only way in or out
+     * is by posting messages, which are passed as JSON. Inside the worker, postMessage sends a value back and onmessage is
+     * called with each value posted to it.
+     */
+    class ScriptWorker final
+    {
+    private:
+        std::shared_ptr<ScriptWorkerState> _state;
+
+    public:
+        explicit ScriptWorker(const std::string& code);
+        ScriptWorker(const ScriptWorker&) = delete;
+        ~ScriptWorker();
+
+        void Post(std::string json);
+        std::vector<ScriptWorkerMessage> Receive();
+
+        /**
+         * Stops the worker once it has finished what it is running. The game does not wait for it, a worker stuck in a loop
+         * is left to finish on its own.
+         */
+        void Terminate();
+        bool IsTerminated() const;
+
+    private:
+        static void Run(std::shared_ptr<ScriptWorkerState> state, std::string code);
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
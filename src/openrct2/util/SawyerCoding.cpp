@@ -41,7 +41,7 @@ uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
  */
 size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* buffer, sawyercoding_chunk_header chunkHeader)
 {
-    uint8_t *encode_buffer, *encode_buffer2;
+    uint8_t* encode_buffer;
 
     if (!gUseRLE)
     {
@@ -50,47 +50,30 @@ size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* buffer,
             chunkHeader.encoding = CHUNK_ENCODING_NONE;
         }
     }
+
+    // The chunk data is encoded straight into the destination after the header, the header is written last as the
+    // encoded length is not known until then.
+    uint8_t* dst_data = dst_file + sizeof(sawyercoding_chunk_header);
     switch (chunkHeader.encoding)
     {
         case CHUNK_ENCODING_NONE:
-            std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
-            dst_file += sizeof(sawyercoding_chunk_header);
-            std::memcpy(dst_file, buffer, chunkHeader.length);
-            // fwrite(&chunkHeader, sizeof(sawyercoding_chunk_header), 1, file);
-            // fwrite(buffer, 1, chunkHeader.length, file);
+            std::memcpy(dst_data, buffer, chunkHeader.length);
             break;
         case CHUNK_ENCODING_RLE:
-            encode_buffer = static_cast<uint8_t*>(malloc(0x600000));
-            chunkHeader.length = static_cast<uint32_t>(encode_chunk_rle(buffer, encode_buffer, chunkHeader.length));
-            std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
-            dst_file += sizeof(sawyercoding_chunk_header);
-            std::memcpy(dst_file, encode_buffer, chunkHeader.length);
-
-            free(encode_buffer);
+            chunkHeader.length = static_cast<uint32_t>(encode_chunk_rle(buffer, dst_data, chunkHeader.length));
             break;
         case CHUNK_ENCODING_RLECOMPRESSED:
             encode_buffer = static_cast<uint8_t*>(malloc(chunkHeader.length * 2));
-            encode_buffer2 = static_cast<uint8_t*>(malloc(0x600000));
             chunkHeader.length = static_cast<uint32_t>(encode_chunk_repeat(buffer, encode_buffer, chunkHeader.length));
-            chunkHeader.length = static_cast<uint32_t>(encode_chunk_rle(encode_buffer, encode_buffer2, chunkHeader.length));
-            std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
-            dst_file += sizeof(sawyercoding_chunk_header);
-            std::memcpy(dst_file, encode_buffer2, chunkHeader.length);
-
-            free(encode_buffer2);
+            chunkHeader.length = static_cast<uint32_t>(encode_chunk_rle(encode_buffer, dst_data, chunkHeader.length));
             free(encode_buffer);
             break;
         case CHUNK_ENCODING_ROTATE:
-            encode_buffer = static_cast<uint8_t*>(malloc(chunkHeader.length));
-            std::memcpy(encode_buffer, buffer, chunkHeader.length);
-            encode_chunk_rotate(encode_buffer, chunkHeader.length);
-            std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
-            dst_file += sizeof(sawyercoding_chunk_header);
-            std::memcpy(dst_file, encode_buffer, chunkHeader.length);
-
-            free(encode_buffer);
+            std::memcpy(dst_data, buffer, chunkHeader.length);
+            encode_chunk_rotate(dst_data, chunkHeader.length);
             break;
     }
+    std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
 
     return chunkHeader.length + sizeof(sawyercoding_chunk_header);
 }
@@ -379,9 +362,17 @@ static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer
 
 static void encode_chunk_rotate(uint8_t* buffer, size_t length)
 {
-    size_t i;
+    // See SawyerChunkReader::DecodeChunkRotate, four bytes at a time keeps the shifts constant
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        buffer[i + 0] = rol8(buffer[i + 0], 1);
+        buffer[i + 1] = rol8(buffer[i + 1], 3);
+        buffer[i + 2] = rol8(buffer[i + 2], 5);
+        buffer[i + 3] = rol8(buffer[i + 3], 7);
+    }
     uint8_t code = 1;
-    for (i = 0; i < length; i++)
+    for (; i < length; i++)
     {
         buffer[i] = rol8(buffer[i], code);
         code = (code + 2) % 8;
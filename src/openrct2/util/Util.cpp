@@ -9,8 +9,10 @@
 
 #include "Util.h"
 
+#include "../Context.h"
 #include "../common.h"
 #include "../core/Guard.hpp"
+#include "../core/TaskScheduler.h"
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
 #include "../platform/platform.h"
@@ -21,6 +23,7 @@
 #include <cctype>
 #include <cmath>
 #include <ctime>
+#include <optional>
 #include <random>
 
 int32_t squaredmetres_to_squaredfeet(int32_t squaredMetres)
@@ -614,28 +617,177 @@ uint8_t* util_zlib_inflate(uint8_t* data, size_t data_in_size, size_t* data_out_
  * @return Returns an optional std::vector of bytes, which is equal to std::nullopt when deflate has failed
  */
 std::optional<std::vector<uint8_t>> util_zlib_deflate(const uint8_t* data, size_t data_in_size)
+{
+    std::vector<uint8_t> buffer;
+    if (!util_zlib_deflate(data, data_in_size, buffer))
+    {
+        return std::nullopt;
+    }
+    return buffer;
+}
+
+static bool util_zlib_deflate_serial(const uint8_t* data, size_t data_in_size, std::vector<uint8_t>& output, int32_t level)
 {
     int32_t ret = Z_OK;
-    uLongf out_size = 0;
+    size_t offset = output.size();
     uLong buffer_size = compressBound(static_cast<uLong>(data_in_size));
-    std::vector<uint8_t> buffer(buffer_size);
+    uLongf out_size = buffer_size;
+    output.resize(offset + buffer_size);
     do
     {
         if (ret == Z_BUF_ERROR)
         {
             buffer_size *= 2;
             out_size = buffer_size;
-            buffer.resize(buffer_size);
+            output.resize(offset + buffer_size);
         }
         else if (ret == Z_STREAM_ERROR)
         {
             log_error("Your build is shipped with broken zlib. Please use the official build.");
-            return std::nullopt;
+            output.resize(offset);
+            return false;
         }
-        ret = compress(buffer.data(), &out_size, data, static_cast<uLong>(data_in_size));
+        ret = compress2(output.data() + offset, &out_size, data, static_cast<uLong>(data_in_size), level);
     } while (ret != Z_OK);
-    buffer.resize(out_size);
-    return buffer;
+    output.resize(offset + out_size);
+    return true;
+}
+
+namespace
+{
+    // The same block and window sizes as pigz.
+    constexpr size_t ZlibDeflateBlockSize = 128 * 1024;
+    constexpr size_t ZlibDeflateDictionarySize = 32 * 1024;
+
+    struct ZlibDeflateBlock
+    {
+        const uint8_t* Data{};
+        size_t Length{};
+        size_t DictionaryLength{};
+        int32_t Level{};
+        bool Last{};
+        uLong Adler{};
+        bool Success{};
+        std::vector<uint8_t> Output;
+    };
+} // namespace
+
+/**
+ * Compresses a single block as raw deflate data, primed with the input that precedes it. Every block but the last ends
+ * with a sync flush, so the blocks can simply be concatenated into one deflate stream.
+ */
+static void util_zlib_deflate_block(ZlibDeflateBlock& block)
+{
+    block.Adler = adler32(adler32(0, nullptr, 0), block.Data, static_cast<uInt>(block.Length));
+
+    z_stream strm{};
+    if (deflateInit2(&strm, block.Level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return;
+
+    if (block.DictionaryLength != 0
+        && deflateSetDictionary(&strm, block.Data - block.DictionaryLength, static_cast<uInt>(block.DictionaryLength))
+            != Z_OK)
+    {
+        deflateEnd(&strm);
+        return;
+    }
+
+    // Leave room for the sync flush marker on top of the bound zlib gives for the block itself.
+    block.Output.resize(deflateBound(&strm, static_cast<uLong>(block.Length)) + 16);
+    strm.next_in = const_cast<Bytef*>(block.Data);
+    strm.avail_in = static_cast<uInt>(block.Length);
+    strm.next_out = block.Output.data();
+    strm.avail_out = static_cast<uInt>(block.Output.size());
+    int32_t flush = block.Last ? Z_FINISH : Z_SYNC_FLUSH;
+    int32_t ret = deflate(&strm, flush);
+    while (ret == Z_OK && strm.avail_out == 0)
+    {
+        size_t written = block.Output.size();
+        block.Output.resize(written * 2);
+        strm.next_out = block.Output.data() + written;
+        strm.avail_out = static_cast<uInt>(block.Output.size() - written);
+        ret = deflate(&strm, flush);
+    }
+
+    block.Output.resize(block.Output.size() - strm.avail_out);
+    block.Success = block.Last ? ret == Z_STREAM_END : ret == Z_OK;
+    deflateEnd(&strm);
+}
+
+/**
+ * Compresses the data and appends it to the end of output, which lets callers put a header in front of the compressed
+ * data without copying it afterwards. Output is left as it was if compression fails.
+ *
+ * Large inputs are split into blocks that are compressed in parallel, each one primed with the 32 KiB of input before
+ * it so the ratio barely suffers. The result is still a single zlib stream that any inflate implementation can read.
+ *
+ * @param level The zlib compression level, from 0 (none) to 9 (smallest), or -1 for the zlib default.
+ */
+bool util_zlib_deflate(const uint8_t* data, size_t data_in_size, std::vector<uint8_t>& output, int32_t level)
+{
+    if (data_in_size <= ZlibDeflateBlockSize * 2)
+    {
+        return util_zlib_deflate_serial(data, data_in_size, output, level);
+    }
+
+    std::vector<ZlibDeflateBlock> blocks((data_in_size + ZlibDeflateBlockSize - 1) / ZlibDeflateBlockSize);
+    for (size_t i = 0; i < blocks.size(); i++)
+    {
+        auto& block = blocks[i];
+        size_t blockOffset = i * ZlibDeflateBlockSize;
+        block.Data = data + blockOffset;
+        block.Length = std::min(ZlibDeflateBlockSize, data_in_size - blockOffset);
+        block.DictionaryLength = std::min(ZlibDeflateDictionarySize, blockOffset);
+        block.Level = level;
+        block.Last = i == blocks.size() - 1;
+    }
+
+    // Commands that run without a context get a scheduler of their own.
+    auto context = OpenRCT2::GetContext();
+    std::optional<OpenRCT2::TaskScheduler> localScheduler;
+    auto& scheduler = context != nullptr ? context->GetTaskScheduler() : localScheduler.emplace();
+
+    OpenRCT2::TaskGroup tasks(scheduler);
+    for (auto& block : blocks)
+    {
+        auto* pendingBlock = &block;
+        tasks.Run([pendingBlock]() { util_zlib_deflate_block(*pendingBlock); });
+    }
+    tasks.Wait();
+
+    uLong adler = adler32(0, nullptr, 0);
+    size_t compressedSize = 0;
+    for (const auto& block : blocks)
+    {
+        if (!block.Success)
+        {
+            log_warning("Failed to compress a block, compressing the data on a single thread.");
+            return util_zlib_deflate_serial(data, data_in_size, output, level);
+        }
+        adler = adler32_combine(adler, block.Adler, static_cast<z_off_t>(block.Length));
+        compressedSize += block.Output.size();
+    }
+
+    // A zlib header for a 32 KiB window and the compression level, then the blocks and the Adler-32 trailer.
+    uint8_t levelFlags = 0x9C;
+    if (level >= 0 && level <= 1)
+        levelFlags = 0x01;
+    else if (level >= 2 && level <= 5)
+        levelFlags = 0x5E;
+    else if (level >= 7)
+        levelFlags = 0xDA;
+    output.reserve(output.size() + 2 + compressedSize + 4);
+    output.push_back(0x78);
+    output.push_back(levelFlags);
+    for (const auto& block : blocks)
+    {
+        output.insert(output.end(), block.Output.begin(), block.Output.end());
+    }
+    output.push_back(static_cast<uint8_t>(adler >> 24));
+    output.push_back(static_cast<uint8_t>(adler >> 16));
+    output.push_back(static_cast<uint8_t>(adler >> 8));
+    output.push_back(static_cast<uint8_t>(adler));
+    return true;
 }
 
 // Compress the source to gzip-compatible stream, write to dest.
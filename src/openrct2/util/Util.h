@@ -57,6 +57,7 @@ bool str_is_null_or_empty(const char* str);
 uint32_t util_rand();
 
 std::optional<std::vector<uint8_t>> util_zlib_deflate(const uint8_t* data, size_t data_in_size);
+bool util_zlib_deflate(const uint8_t* data, size_t data_in_size, std::vector<uint8_t>& output, int32_t level = -1);
 uint8_t* util_zlib_inflate(uint8_t* data, size_t data_in_size, size_t* data_out_size);
 bool util_gzip_compress(FILE* source, FILE* dest);
 
@@ -162,6 +162,11 @@ static void PeepBaseSerialise(Peep& base, DataSerialiser& stream)
 }
 
 void Guest::Serialise(DataSerialiser& stream)
+{
+    Serialise(stream, GetColdData());
+}
+
+void Guest::Serialise(DataSerialiser& stream, GuestColdData& coldData)
 {
     PeepBaseSerialise(*this, stream);
     stream << GuestNumRides;
@@ -186,9 +191,9 @@ void Guest::Serialise(DataSerialiser& stream)
     stream << TimeToConsume;
     stream << Intensity;
     stream << NauseaTolerance;
-    stream << RideTypesBeenOn;
+    stream << coldData.RideTypesBeenOn;
     stream << TimeInQueue;
-    stream << RidesBeenOn;
+    stream << coldData.RidesBeenOn;
     stream << CashInPocket;
     stream << CashSpent;
     stream << Photo1RideRef;
@@ -198,7 +203,7 @@ void Guest::Serialise(DataSerialiser& stream)
     stream << RejoinQueueTimeout;
     stream << PreviousRide;
     stream << PreviousRideTimeOut;
-    stream << Thoughts;
+    stream << coldData.Thoughts;
     stream << LitterCount;
     stream << DisgustingCount;
     stream << AmountOfFood;
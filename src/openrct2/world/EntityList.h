@@ -13,9 +13,10 @@
 #include "../rct12/RCT12.h"
 #include "Entity.h"
 #include "Location.hpp"
+#include "../util/Util.h"
 #include "SpriteBase.h"
 
-#include <list>
+#include <array>
 #include <vector>
 
 enum class EntityListId : uint8_t
@@ -23,24 +24,150 @@ enum class EntityListId : uint8_t
     Count = 6,
 };
 
-const std::list<uint16_t>& GetEntityList(const EntityType id);
+/**
+ * The sprite indices of all entities of one type, stored as one bit per index. Inserting and removing is constant
+ * time and iterating always visits the entities in sprite_index order, which the game logic relies upon to stay in
+ * sync. The set can be changed while it is being iterated: indices after the current one that are added are visited,
+ * indices that are removed are skipped.
+ */
+class EntityIndexSet
+{
+private:
+    static constexpr size_t NumWords = (MAX_ENTITIES + 63) / 64;
+
+    std::array<uint64_t, NumWords> _words{};
+    uint16_t _count{};
+
+public:
+    class const_iterator
+    {
+    private:
+        const EntityIndexSet* _set;
+        uint16_t _index;
+
+    public:
+        const_iterator(const EntityIndexSet* set, uint16_t index)
+            : _set(set)
+            , _index(set->FindNext(index))
+        {
+        }
+        const_iterator& operator++()
+        {
+            _index = _set->FindNext(_index + 1);
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator retval = *this;
+            ++(*this);
+            return retval;
+        }
+        bool operator==(const const_iterator& other) const
+        {
+            return _index == other._index;
+        }
+        bool operator!=(const const_iterator& other) const
+        {
+            return !(*this == other);
+        }
+        uint16_t operator*() const
+        {
+            return _index;
+        }
+        // iterator traits
+        using difference_type = std::ptrdiff_t;
+        using value_type = uint16_t;
+        using pointer = const uint16_t*;
+        using reference = const uint16_t&;
+        using iterator_category = std::forward_iterator_tag;
+    };
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const
+    {
+        return const_iterator(this, MAX_ENTITIES);
+    }
+
+    size_t size() const
+    {
+        return _count;
+    }
+    bool empty() const
+    {
+        return _count == 0;
+    }
+
+    bool contains(uint16_t index) const
+    {
+        return index < MAX_ENTITIES && (_words[index / 64] & (1ULL << (index % 64))) != 0;
+    }
+
+    void insert(uint16_t index)
+    {
+        if (index < MAX_ENTITIES && !contains(index))
+        {
+            _words[index / 64] |= 1ULL << (index % 64);
+            _count++;
+        }
+    }
+
+    void erase(uint16_t index)
+    {
+        if (contains(index))
+        {
+            _words[index / 64] &= ~(1ULL << (index % 64));
+            _count--;
+        }
+    }
+
+    void clear()
+    {
+        _words.fill(0);
+        _count = 0;
+    }
+
+private:
+    // Returns the first index in the set that is not less than the given one, or MAX_ENTITIES if there is none.
+    uint16_t FindNext(size_t index) const
+    {
+        if (index >= MAX_ENTITIES)
+            return MAX_ENTITIES;
+
+        size_t wordIndex = index / 64;
+        uint64_t word = _words[wordIndex] & (~0ULL << (index % 64));
+        while (word == 0)
+        {
+            if (++wordIndex == NumWords)
+                return MAX_ENTITIES;
+            word = _words[wordIndex];
+        }
+        return static_cast<uint16_t>(wordIndex * 64 + bitscanforward(static_cast<int64_t>(word)));
+    }
+};
+
+const EntityIndexSet& GetEntityList(const EntityType id);
 
 uint16_t GetEntityListCount(EntityType list);
 uint16_t GetMiscEntityCount();
 uint16_t GetNumFreeEntities();
-const std::vector<uint16_t>& GetEntityTileList(const CoordsXY& spritePos);
+/**
+ * The entities on a tile are linked in sprite_index order, SPRITE_INDEX_NULL ends the list.
+ */
+uint16_t GetFirstEntityOnTile(const CoordsXY& spritePos);
+uint16_t GetNextEntityOnTile(uint16_t spriteIndex);
 
 template<typename T> class EntityTileIterator
 {
 private:
-    std::vector<uint16_t>::const_iterator iter;
-    std::vector<uint16_t>::const_iterator end;
+    uint16_t iter;
     T* Entity = nullptr;
 
 public:
-    EntityTileIterator(std::vector<uint16_t>::const_iterator _iter, std::vector<uint16_t>::const_iterator _end)
+    explicit EntityTileIterator(uint16_t _iter)
         : iter(_iter)
-        , end(_end)
     {
         ++(*this);
     }
@@ -48,9 +175,11 @@ public:
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        while (iter != SPRITE_INDEX_NULL && Entity == nullptr)
         {
-            Entity = GetEntity<T>(*iter++);
+            const auto spriteIndex = iter;
+            iter = GetNextEntityOnTile(spriteIndex);
+            Entity = GetEntity<T>(spriteIndex);
         }
         return *this;
     }
@@ -59,7 +188,7 @@ public:
     {
         EntityTileIterator retval = *this;
         ++(*this);
-        return *iter;
+        return retval;
     }
     bool operator==(EntityTileIterator other) const
     {
@@ -84,33 +213,33 @@ public:
 template<typename T = SpriteBase> class EntityTileList
 {
 private:
-    const std::vector<uint16_t>& vec;
+    uint16_t first;
 
 public:
     EntityTileList(const CoordsXY& loc)
-        : vec(GetEntityTileList(loc))
+        : first(GetFirstEntityOnTile(loc))
     {
     }
 
     EntityTileIterator<T> begin()
     {
-        return EntityTileIterator<T>(std::begin(vec), std::end(vec));
+        return EntityTileIterator<T>(first);
     }
     EntityTileIterator<T> end()
     {
-        return EntityTileIterator<T>(std::end(vec), std::end(vec));
+        return EntityTileIterator<T>(SPRITE_INDEX_NULL);
     }
 };
 
-template<typename T> class EntityListIterator
+template<typename T, typename TIndexIterator = EntityIndexSet::const_iterator> class EntityListIterator
 {
 private:
-    std::list<uint16_t>::const_iterator iter;
-    std::list<uint16_t>::const_iterator end;
+    TIndexIterator iter;
+    TIndexIterator end;
     T* Entity = nullptr;
 
 public:
-    EntityListIterator(std::list<uint16_t>::const_iterator _iter, std::list<uint16_t>::const_iterator _end)
+    EntityListIterator(TIndexIterator _iter, TIndexIterator _end)
         : iter(_iter)
         , end(_end)
     {
@@ -157,7 +286,7 @@ template<typename T = SpriteBase> class EntityList
 {
 private:
     using EntityListIterator_t = EntityListIterator<T>;
-    const std::list<uint16_t>& vec;
+    const EntityIndexSet& vec;
 
 public:
     EntityList()
@@ -174,3 +303,36 @@ public:
         return EntityListIterator_t(std::cend(vec), std::cend(vec));
     }
 };
+
+/**
+ * Gets the indices of all entities of the given type whose x and y are both within radius of loc, in sprite_index
+ * order. The candidates are taken from the tiles around loc or from the entity list, whichever is smaller, and their
+ * distances are tested in batches.
+ */
+void GetEntitiesInRange(EntityType type, const CoordsXY& loc, int32_t radius, std::vector<uint16_t>& result);
+
+/**
+ * The entities of a type within a square around a location, see GetEntitiesInRange. The entities are found when the
+ * list is created, entities removed while iterating are skipped.
+ */
+template<typename T> class EntityRangeList
+{
+private:
+    using EntityListIterator_t = EntityListIterator<T, std::vector<uint16_t>::const_iterator>;
+    std::vector<uint16_t> indices;
+
+public:
+    EntityRangeList(const CoordsXY& loc, int32_t radius)
+    {
+        GetEntitiesInRange(T::cEntityType, loc, radius, indices);
+    }
+
+    EntityListIterator_t begin() const
+    {
+        return EntityListIterator_t(std::cbegin(indices), std::cend(indices));
+    }
+    EntityListIterator_t end() const
+    {
+        return EntityListIterator_t(std::cend(indices), std::cend(indices));
+    }
+};
@@ -13,96 +13,117 @@
 #include "EntityList.h"
 #include "Sprite.h"
 
+#include <algorithm>
 #include <cmath>
 
-void EntityTweener::PopulateEntities()
+void EntityTweener::AddEntity(SpriteBase* entity)
 {
-    for (auto ent : EntityList<Guest>())
+    switch (entity->Type)
     {
-        Entities.push_back(ent);
-        PrePos.emplace_back(ent->x, ent->y, ent->z);
-    }
-    for (auto ent : EntityList<Staff>())
-    {
-        Entities.push_back(ent);
-        PrePos.emplace_back(ent->x, ent->y, ent->z);
-    }
-    for (auto ent : EntityList<Vehicle>())
-    {
-        Entities.push_back(ent);
-        PrePos.emplace_back(ent->x, ent->y, ent->z);
+        case EntityType::Guest:
+        case EntityType::Staff:
+        case EntityType::Vehicle:
+            break;
+        default:
+            // Only peeps and vehicles are tweened.
+            return;
     }
+
+    Tracked[entity->sprite_index] = true;
+    Entities.push_back(entity);
+    PreX.push_back(entity->x);
+    PreY.push_back(entity->y);
+    PreZ.push_back(entity->z);
 }
 
 void EntityTweener::PreTick()
 {
     Restore();
     Reset();
-    PopulateEntities();
+    IsInTick = true;
 }
 
 void EntityTweener::PostTick()
 {
-    for (auto* ent : Entities)
+    IsInTick = false;
+
+    // Keep the entities that have a different position than before the tick. Entities moving from or to LOCATION_NULL
+    // have entered or left the map and can not be interpolated.
+    size_t numMoved = 0;
+    for (size_t i = 0; i < Entities.size(); ++i)
     {
-        if (ent == nullptr)
-        {
-            // Sprite was removed, add a dummy position to keep the index aligned.
-            PostPos.emplace_back(0, 0, 0);
-        }
-        else
-        {
-            PostPos.emplace_back(ent->x, ent->y, ent->z);
-        }
+        auto* ent = Entities[i];
+        if (ent == nullptr || PreX[i] == LOCATION_NULL || ent->x == LOCATION_NULL)
+            continue;
+        if (PreX[i] == ent->x && PreY[i] == ent->y && PreZ[i] == ent->z)
+            continue;
+
+        Entities[numMoved] = ent;
+        PreX[numMoved] = PreX[i];
+        PreY[numMoved] = PreY[i];
+        PreZ[numMoved] = PreZ[i];
+        PostX.push_back(ent->x);
+        PostY.push_back(ent->y);
+        PostZ.push_back(ent->z);
+        numMoved++;
     }
+
+    // Entities that have been dropped still have their index marked, which only stops them from being added again.
+    Entities.resize(numMoved);
+    PreX.resize(numMoved);
+    PreY.resize(numMoved);
+    PreZ.resize(numMoved);
 }
 
 void EntityTweener::RemoveEntity(SpriteBase* entity)
 {
-    if (!entity->Is<Peep>() && !entity->Is<Vehicle>())
-    {
-        // Only peeps and vehicles are tweened, bail if type is incorrect.
+    if (!Tracked[entity->sprite_index])
         return;
-    }
 
     auto it = std::find(Entities.begin(), Entities.end(), entity);
     if (it != Entities.end())
         *it = nullptr;
 }
 
-void EntityTweener::Tween(float alpha)
+static void TweenAxis(const int32_t* pre, const int32_t* post, int32_t* result, size_t count, float alpha)
 {
     const float inv = (1.0f - alpha);
-    for (size_t i = 0; i < Entities.size(); ++i)
+    for (size_t i = 0; i < count; ++i)
+    {
+        result[i] = static_cast<int32_t>(std::round(post[i] * alpha + pre[i] * inv));
+    }
+}
+
+void EntityTweener::Tween(float alpha)
+{
+    const auto count = PostX.size();
+    TweenX.resize(count);
+    TweenY.resize(count);
+    TweenZ.resize(count);
+    TweenAxis(PreX.data(), PostX.data(), TweenX.data(), count, alpha);
+    TweenAxis(PreY.data(), PostY.data(), TweenY.data(), count, alpha);
+    TweenAxis(PreZ.data(), PostZ.data(), TweenZ.data(), count, alpha);
+
+    for (size_t i = 0; i < count; ++i)
     {
         auto* ent = Entities[i];
         if (ent == nullptr)
             continue;
 
-        auto& posA = PrePos[i];
-        auto& posB = PostPos[i];
-
-        if (posA == posB)
-            continue;
-
-        sprite_set_coordinates(
-            { static_cast<int32_t>(std::round(posB.x * alpha + posA.x * inv)),
-              static_cast<int32_t>(std::round(posB.y * alpha + posA.y * inv)),
-              static_cast<int32_t>(std::round(posB.z * alpha + posA.z * inv)) },
-            ent);
+        sprite_set_coordinates({ TweenX[i], TweenY[i], TweenZ[i] }, ent);
         ent->Invalidate();
     }
 }
 
 void EntityTweener::Restore()
 {
-    for (size_t i = 0; i < Entities.size(); ++i)
+    for (size_t i = 0; i < PostX.size(); ++i)
     {
         auto* ent = Entities[i];
         if (ent == nullptr)
             continue;
 
-        sprite_set_coordinates(PostPos[i], ent);
+        sprite_set_coordinates({ PostX[i], PostY[i], PostZ[i] }, ent);
         ent->Invalidate();
     }
 }
@@ -110,8 +131,14 @@ void EntityTweener::Restore()
 void EntityTweener::Reset()
 {
     Entities.clear();
-    PrePos.clear();
-    PostPos.clear();
+    PreX.clear();
+    PreY.clear();
+    PreZ.clear();
+    PostX.clear();
+    PostY.clear();
+    PostZ.clear();
+    Tracked.reset();
+    IsInTick = false;
 }
 
 static EntityTweener tweener;
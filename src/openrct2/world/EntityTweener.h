@@ -9,18 +9,35 @@
 
 #pragma once
 
+#include "Entity.h"
 #include "SpriteBase.h"
 
+#include <bitset>
 #include <vector>
 
+/**
+ * Interpolates the positions of peeps and vehicles between two ticks. Only entities that have been moved during the
+ * tick are tracked: MoveTo reports the position an entity had before its first move of the tick, so a tick never
+ * walks over the entities that stand still. The positions are stored as separate arrays per axis.
+ */
 class EntityTweener
 {
     std::vector<SpriteBase*> Entities;
-    std::vector<CoordsXYZ> PrePos;
-    std::vector<CoordsXYZ> PostPos;
+    std::vector<int32_t> PreX;
+    std::vector<int32_t> PreY;
+    std::vector<int32_t> PreZ;
+    std::vector<int32_t> PostX;
+    std::vector<int32_t> PostY;
+    std::vector<int32_t> PostZ;
 
-private:
-    void PopulateEntities();
+    // Scratch space for the interpolated positions.
+    std::vector<int32_t> TweenX;
+    std::vector<int32_t> TweenY;
+    std::vector<int32_t> TweenZ;
+
+    // Set for every sprite index that is in Entities.
+    std::bitset<MAX_ENTITIES> Tracked;
+    bool IsInTick{};
 
 public:
     static EntityTweener& Get();
@@ -31,4 +48,16 @@ public:
     void Tween(float alpha);
     void Restore();
     void Reset();
+
+    /**
+     * Must be called by MoveTo before the entity is moved.
+     */
+    void OnEntityMove(SpriteBase* entity)
+    {
+        if (IsInTick && !Tracked[entity->sprite_index])
+            AddEntity(entity);
+    }
+
+private:
+    void AddEntity(SpriteBase* entity);
 };
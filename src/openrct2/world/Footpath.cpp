@@ -1713,6 +1713,25 @@ static void footpath_clear_wide(const CoordsXY& footpathPos)
     } while (!(tileElement++)->IsLastForTile());
 }
 
+// Gets which of the paths on the tile are wide, one bit for each path in element order.
+static uint32_t footpath_get_wide_paths(const CoordsXY& footpathPos)
+{
+    uint32_t widePaths = 0;
+    uint32_t pathIndex = 0;
+    TileElement* tileElement = map_get_first_element_at(footpathPos);
+    if (tileElement == nullptr)
+        return widePaths;
+    do
+    {
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+            continue;
+        if (tileElement->AsPath()->IsWide())
+            widePaths |= 1u << (pathIndex & 31);
+        pathIndex++;
+    } while (!(tileElement++)->IsLastForTile());
+    return widePaths;
+}
+
 /**
  *
  *  rct2: 0x006A8ACF
@@ -1749,6 +1768,7 @@ void footpath_update_path_wide_flags(const CoordsXY& footpathPos)
     if (map_is_location_at_edge(footpathPos))
         return;
 
+    const auto widePaths = footpath_get_wide_paths(footpathPos);
     footpath_clear_wide(footpathPos);
     /* Rather than clearing the wide flag of the following tiles and
      * checking the state of them later, leave them intact and assume
@@ -1927,6 +1947,28 @@ void footpath_update_path_wide_flags(const CoordsXY& footpathPos)
                 tileElement->AsPath()->SetWide(true);
         }
     } while (!(tileElement++)->IsLastForTile());
+
+    // The flags are recalculated all the time, only report the tile when they end up different.
+    if (footpath_get_wide_paths(footpathPos) != widePaths)
+    {
+        map_on_tile_changed(footpathPos);
+        map_on_all_tiles_changed();
+    }
+}
+
+/**
+ * Updates the wide flags of the paths on the given tile and its eight neighbours, in the same order as
+ * map_update_path_wide_flags visits them, so path edits do not have to wait for the next pass over the map.
+ */
+void footpath_update_path_wide_flags_around(const CoordsXY& footpathPos)
+{
+    for (int32_t yOffset = -COORDS_XY_STEP; yOffset <= COORDS_XY_STEP; yOffset += COORDS_XY_STEP)
+    {
+        for (int32_t xOffset = -COORDS_XY_STEP; xOffset <= COORDS_XY_STEP; xOffset += COORDS_XY_STEP)
+        {
+            footpath_update_path_wide_flags({ footpathPos.x + xOffset, footpathPos.y + yOffset });
+        }
+    }
 }
 
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position)
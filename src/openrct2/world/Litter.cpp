@@ -86,6 +86,10 @@ void Litter::Create(const CoordsXYZD& litterPos, Type type)
  */
 void Litter::RemoveAt(const CoordsXYZ& litterPos)
 {
+    // A clean park has nothing to sweep, so there is no need to walk the entities on the tile.
+    if (GetEntityListCount(EntityType::Litter) == 0)
+        return;
+
     std::vector<Litter*> removals;
     for (auto litter : EntityTileList<Litter>(litterPos))
     {
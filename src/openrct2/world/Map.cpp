@@ -28,6 +28,7 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/MemoryUsage.h"
 #include "../interface/Cursors.h"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
@@ -52,12 +53,17 @@
 #include "Scenery.h"
 #include "SmallScenery.h"
 #include "Surface.h"
+#include "TileElementStorage.h"
 #include "TileElementsView.h"
 #include "TileInspector.h"
 #include "Wall.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
 #include <iterator>
+#include <limits>
 #include <memory>
 
 using namespace OpenRCT2;
@@ -113,10 +119,11 @@ uint16_t gLandRemainingConstructionSales;
 
 bool gMapLandRightsUpdateSuccess;
 
-static TilePointerIndex<TileElement> _tileIndex;
-static std::vector<TileElement> _tileElements;
-static TilePointerIndex<TileElement> _tileIndexStash;
-static std::vector<TileElement> _tileElementsStash;
+static constexpr size_t TILE_ELEMENTS_COMPACT_PER_TICK = 64;
+
+static TileElementStorage _tileElements;
+static TileElementStorage _tileElementsStash;
+static std::atomic<int32_t> _tileElementHolders;
 static size_t _tileElementsInUse;
 static size_t _tileElementsInUseStash;
 static int32_t _mapSizeUnitsStash;
@@ -124,10 +131,61 @@ static int32_t _mapSizeMinus2Stash;
 static int32_t _mapSizeStash;
 static int32_t _currentRotationStash;
 
+// The tiles map_update_tiles may change, tiles with nothing on them that grows or ages are skipped until they change.
+static std::bitset<MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL> _tilesToUpdate;
+
+// Changed whenever the elements of a tile may have changed, see map_get_tile_version.
+static std::vector<uint32_t> _tileVersions;
+static uint32_t _tileVersionEpoch = 1;
+static uint64_t _tileChangeCount = 0;
+
+static int32_t _invalidationBatchDepth = 0;
+static bool _invalidationBatchEmpty = true;
+static CoordsXY _invalidationBatchMin;
+static CoordsXY _invalidationBatchMax;
+
+// Changed whenever a tile in or next to the block changes, see map_get_block_change_count.
+static std::array<uint32_t, MAP_BLOCK_COUNT * MAP_BLOCK_COUNT> _blockChangeCounts{};
+
+/**
+ * The heights each quadrant of a tile is occupied at by anything other than the surface and ghosts, one bit for every
+ * OCCUPANCY_HEIGHT_STEP height units. It is only ever more than what is on the tile, so when a clearance check does not
+ * overlap it the elements of the tile do not have to be looked at. Built when it is first needed after a change.
+ */
+struct TileOccupancy
+{
+    std::array<uint64_t, NumOrthogonalDirections> Quadrants{};
+    uint64_t Version{};
+};
+
+static constexpr int32_t OCCUPANCY_HEIGHT_STEP = 4;
+static std::vector<TileOccupancy> _tileOccupancy;
+
+// See map_get_tile_height_bounds. The bounds of a tile depend on the surfaces of its neighbours, so changing a tile
+// marks them as well. When too many tiles change at once, all of them are worked out again instead.
+static constexpr size_t MAX_DIRTY_HEIGHT_BOUNDS = 16384;
+static std::vector<TileHeightBounds> _tileHeightBounds;
+static std::bitset<MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL> _tileHeightBoundsDirty;
+static std::vector<uint32_t> _dirtyTileHeightBounds;
+static bool _allTileHeightBoundsDirty = true;
+
+static void map_invalidate_all_tile_height_bounds()
+{
+    _allTileHeightBoundsDirty = true;
+    _dirtyTileHeightBounds.clear();
+}
+
+static void UpdateTileElementMemoryUsage()
+{
+    OpenRCT2::MemoryUsage::Set(
+        OpenRCT2::MemoryUsage::Category::TileElements,
+        _tileElements.GetMemoryUsage() + _tileElementsStash.GetMemoryUsage());
+}
+
 void StashMap()
 {
-    _tileIndexStash = std::move(_tileIndex);
     _tileElementsStash = std::move(_tileElements);
+    map_invalidate_all_tile_height_bounds();
     _mapSizeUnitsStash = gMapSizeUnits;
     _mapSizeMinus2Stash = gMapSizeMinus2;
     _mapSizeStash = gMapSize;
@@ -137,41 +195,36 @@ void StashMap()
 
 void UnstashMap()
 {
-    _tileIndex = std::move(_tileIndexStash);
     _tileElements = std::move(_tileElementsStash);
     gMapSizeUnits = _mapSizeUnitsStash;
     gMapSizeMinus2 = _mapSizeMinus2Stash;
     gMapSize = _mapSizeStash;
     gCurrentRotation = _currentRotationStash;
     _tileElementsInUse = _tileElementsInUseStash;
+    _tilesToUpdate.set();
+    _tileVersions.assign(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL, 0);
+    _tileVersionEpoch++;
+    for (auto& count : _blockChangeCounts)
+    {
+        count++;
+    }
+    _tileOccupancy.assign(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL, {});
+    map_invalidate_all_tile_height_bounds();
+    UpdateTileElementMemoryUsage();
 }
 
-const std::vector<TileElement>& GetTileElements()
-{
-    return _tileElements;
-}
-
-void SetTileElements(std::vector<TileElement>&& tileElements)
-{
-    _tileElements = std::move(tileElements);
-    _tileIndex = TilePointerIndex<TileElement>(MAXIMUM_MAP_SIZE_TECHNICAL, _tileElements.data());
-    _tileElementsInUse = _tileElements.size();
-}
-
-static void ReorganiseTileElements(size_t capacity)
+std::vector<TileElement> GetTileElements()
 {
-    context_setcurrentcursor(CursorID::ZZZ);
-
-    std::vector<TileElement> newElements;
-    newElements.reserve(std::max(MIN_TILE_ELEMENTS, capacity));
+    std::vector<TileElement> tileElements;
+    tileElements.reserve(_tileElementsInUse);
     for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
     {
         for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
         {
-            const auto* element = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            const auto* element = _tileElements.GetFirstElementAt(TileCoordsXY{ x, y });
             if (element == nullptr)
             {
-                auto& newElement = newElements.emplace_back();
+                auto& newElement = tileElements.emplace_back();
                 newElement.ClearAs(TILE_ELEMENT_TYPE_SURFACE);
                 newElement.SetLastForTile(true);
                 newElement.base_height = 14;
@@ -188,62 +241,288 @@ static void ReorganiseTileElements(size_t capacity)
             {
                 do
                 {
-                    newElements.push_back(*element);
+                    tileElements.push_back(*element);
                 } while (!(element++)->IsLastForTile());
             }
         }
     }
+    return tileElements;
+}
 
-    SetTileElements(std::move(newElements));
+void SetTileElements(std::vector<TileElement>&& tileElements)
+{
+    // The layout is picked up whenever a map is loaded, it has no effect on the game state.
+    auto layout = gConfigGeneral.morton_tile_layout ? TileElementLayout::Morton : TileElementLayout::RowMajor;
+    _tileElements.Assign(tileElements, layout);
+    _tileElementsInUse = tileElements.size();
+    _tilesToUpdate.set();
+    _tileVersions.assign(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL, 0);
+    _tileVersionEpoch++;
+    for (auto& count : _blockChangeCounts)
+    {
+        count++;
+    }
+    _tileOccupancy.assign(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL, {});
+    map_invalidate_all_tile_height_bounds();
+    UpdateTileElementMemoryUsage();
 }
 
-void ReorganiseTileElements()
+TileElementLayout GetTileElementLayout()
 {
-    ReorganiseTileElements(_tileElements.size());
+    return _tileElements.GetLayout();
 }
 
-static bool map_check_free_elements_and_reorganise(size_t numElementsOnTile, size_t numNewElements)
+void SetTileElementLayout(TileElementLayout layout)
 {
-    // Check hard cap on num in use tiles (this would be the size of _tileElements immediately after a reorg)
-    if (_tileElementsInUse + numNewElements > MAX_TILE_ELEMENTS)
+    _tileElements.Assign(GetTileElements(), layout);
+}
+
+void map_on_tile_changed(const CoordsXY& coords)
+{
+    if (coords.x < 0 || coords.y < 0 || coords.x >= MAXIMUM_MAP_SIZE_BIG || coords.y >= MAXIMUM_MAP_SIZE_BIG)
+        return;
+
+    const auto tilePos = TileCoordsXY(coords);
+    const size_t tileIndex = tilePos.x + (tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL);
+    _tilesToUpdate.set(tileIndex);
+    _tileChangeCount++;
+    if (tileIndex < _tileVersions.size())
     {
-        gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
-        return false;
+        _tileVersions[tileIndex]++;
     }
 
-    auto totalElementsRequired = numElementsOnTile + numNewElements;
-    auto freeElements = _tileElements.capacity() - _tileElements.size();
-    if (freeElements >= totalElementsRequired)
+    // Surfaces are painted with the edges of their neighbours, which may be in another block
+    auto onBlockChanged = [](const TileCoordsXY& pos) {
+        if (pos.x < 0 || pos.y < 0 || pos.x >= MAXIMUM_MAP_SIZE_TECHNICAL || pos.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+            return;
+        _blockChangeCounts[(pos.x / MAP_BLOCK_SIZE) + ((pos.y / MAP_BLOCK_SIZE) * MAP_BLOCK_COUNT)]++;
+    };
+    onBlockChanged(tilePos);
+    for (int32_t i = 0; i < NumOrthogonalDirections; i++)
     {
-        return true;
+        const auto neighbourPos = tilePos + TileDirectionDelta[i];
+        if (neighbourPos.x / MAP_BLOCK_SIZE != tilePos.x / MAP_BLOCK_SIZE
+            || neighbourPos.y / MAP_BLOCK_SIZE != tilePos.y / MAP_BLOCK_SIZE)
+        {
+            onBlockChanged(neighbourPos);
+        }
     }
-    else
+
+    if (!_allTileHeightBoundsDirty)
     {
-        // if space issue is due to fragmentation then Reorg Tiles without increasing capacity
-        if (_tileElements.size() > totalElementsRequired + _tileElementsInUse)
+        auto markDirty = [](const TileCoordsXY& pos) {
+            if (pos.x < 0 || pos.y < 0 || pos.x >= MAXIMUM_MAP_SIZE_TECHNICAL || pos.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+                return;
+            const uint32_t index = pos.x + (pos.y * MAXIMUM_MAP_SIZE_TECHNICAL);
+            if (!_tileHeightBoundsDirty[index])
+            {
+                _tileHeightBoundsDirty.set(index);
+                _dirtyTileHeightBounds.push_back(index);
+            }
+        };
+        markDirty(tilePos);
+        for (int32_t i = 0; i < NumOrthogonalDirections; i++)
+        {
+            markDirty(tilePos + TileDirectionDelta[i]);
+        }
+        if (_dirtyTileHeightBounds.size() > MAX_DIRTY_HEIGHT_BOUNDS)
         {
-            ReorganiseTileElements();
-            // This check is not expected to fail
-            freeElements = _tileElements.capacity() - _tileElements.size();
-            if (freeElements >= totalElementsRequired)
+            map_invalidate_all_tile_height_bounds();
+        }
+    }
+}
+
+void map_on_all_tiles_changed()
+{
+    _tileVersionEpoch++;
+}
+
+uint32_t map_get_version()
+{
+    return _tileVersionEpoch;
+}
+
+uint64_t map_get_tile_change_count()
+{
+    return _tileChangeCount;
+}
+
+uint64_t map_get_tile_version(const TileCoordsXY& tilePos)
+{
+    const size_t tileIndex = tilePos.x + (tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL);
+    const uint32_t tileVersion = tileIndex < _tileVersions.size() ? _tileVersions[tileIndex] : 0;
+    return (static_cast<uint64_t>(_tileVersionEpoch) << 32) | tileVersion;
+}
+
+const std::vector<uint32_t>& map_get_tile_change_counts()
+{
+    return _tileVersions;
+}
+
+uint32_t map_get_block_change_count(uint16_t blockIndex)
+{
+    return blockIndex < _blockChangeCounts.size() ? _blockChangeCounts[blockIndex] : 0;
+}
+
+static TileHeightBounds map_compute_tile_height_bounds(const TileCoordsXY& tilePos)
+{
+    const auto* element = map_get_first_element_at(tilePos.ToCoordsXY());
+    if (element == nullptr)
+        return { 0, 0 };
+
+    int32_t minZ = std::numeric_limits<int16_t>::max();
+    int32_t maxZ = 0;
+    do
+    {
+        minZ = std::min(minZ, element->GetBaseZ());
+        maxZ = std::max(maxZ, element->GetClearanceZ());
+        if (element->GetType() == TILE_ELEMENT_TYPE_SURFACE)
+        {
+            maxZ = std::max(maxZ, element->AsSurface()->GetWaterHeight());
+        }
+    } while (!(element++)->IsLastForTile());
+
+    // The edges of the surface are drawn down to the surfaces next to it, or to the bottom of the map when there are none
+    for (int32_t i = 0; i < NumOrthogonalDirections; i++)
+    {
+        const auto neighbourPos = (tilePos + TileDirectionDelta[i]).ToCoordsXY();
+        const auto* neighbour = map_is_location_valid(neighbourPos) ? map_get_surface_element_at(neighbourPos) : nullptr;
+        minZ = std::min(minZ, neighbour != nullptr ? neighbour->GetBaseZ() : 0);
+    }
+    return { static_cast<int16_t>(minZ), static_cast<int16_t>(std::min<int32_t>(maxZ, std::numeric_limits<int16_t>::max())) };
+}
+
+std::optional<TileHeightBounds> map_get_tile_height_bounds(const TileCoordsXY& tilePos)
+{
+    if (tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= MAXIMUM_MAP_SIZE_TECHNICAL || tilePos.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return std::nullopt;
+
+    const size_t index = tilePos.x + (tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL);
+    if (_allTileHeightBoundsDirty || _tileHeightBoundsDirty[index] || index >= _tileHeightBounds.size())
+        return std::nullopt;
+    return _tileHeightBounds[index];
+}
+
+void map_update_tile_height_bounds()
+{
+    if (_allTileHeightBoundsDirty)
+    {
+        _tileHeightBounds.resize(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+        for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
             {
-                return true;
+                _tileHeightBounds[x + (y * MAXIMUM_MAP_SIZE_TECHNICAL)] = map_compute_tile_height_bounds({ x, y });
+            }
+        }
+        _tileHeightBoundsDirty.reset();
+        _allTileHeightBoundsDirty = false;
+        return;
+    }
+
+    for (auto index : _dirtyTileHeightBounds)
+    {
+        const TileCoordsXY tilePos = { static_cast<int32_t>(index % MAXIMUM_MAP_SIZE_TECHNICAL),
+                                       static_cast<int32_t>(index / MAXIMUM_MAP_SIZE_TECHNICAL) };
+        _tileHeightBounds[index] = map_compute_tile_height_bounds(tilePos);
+        _tileHeightBoundsDirty.reset(index);
+    }
+    _dirtyTileHeightBounds.clear();
+}
+
+static uint64_t map_get_occupancy_mask(int32_t baseHeight, int32_t clearanceHeight)
+{
+    // Covers every step that [baseHeight, clearanceHeight) touches.
+    constexpr int32_t maxHeight = OCCUPANCY_HEIGHT_STEP * 64;
+    baseHeight = std::clamp(baseHeight, 0, maxHeight - 1);
+    clearanceHeight = std::clamp(clearanceHeight, baseHeight + 1, maxHeight);
+    const auto first = baseHeight / OCCUPANCY_HEIGHT_STEP;
+    const auto last = (clearanceHeight - 1) / OCCUPANCY_HEIGHT_STEP;
+    const auto upTo = last == 63 ? ~uint64_t{ 0 } : (uint64_t{ 1 } << (last + 1)) - 1;
+    return upTo & ~((uint64_t{ 1 } << first) - 1);
+}
+
+static const TileOccupancy& map_get_tile_occupancy(const TileCoordsXY& tilePos)
+{
+    auto& occupancy = _tileOccupancy[tilePos.x + (tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL)];
+    const auto version = map_get_tile_version(tilePos);
+    if (occupancy.Version != version)
+    {
+        occupancy.Quadrants = {};
+        for (const auto* element : TileElementsView(tilePos.ToCoordsXY()))
+        {
+            if (element->GetType() == TILE_ELEMENT_TYPE_SURFACE || element->IsGhost())
+                continue;
+
+            // Elements without a height are still in the way of anything going through them.
+            const int32_t baseHeight = element->base_height;
+            const int32_t clearanceHeight = element->clearance_height;
+            const auto mask = map_get_occupancy_mask(
+                std::min(baseHeight, clearanceHeight), std::max(clearanceHeight, baseHeight + 1));
+            const auto quadrants = element->GetOccupiedQuadrants();
+            for (size_t i = 0; i < occupancy.Quadrants.size(); i++)
+            {
+                if (quadrants & (1 << i))
+                    occupancy.Quadrants[i] |= mask;
             }
         }
+        occupancy.Version = version;
+    }
+    return occupancy;
+}
 
-        // Capacity must increase to handle the space (Note capacity can go above MAX_TILE_ELEMENTS)
-        auto newCapacity = _tileElements.capacity() * 2;
-        ReorganiseTileElements(newCapacity);
+/**
+ * Whether anything but the surface could be in the way of pos in the given quadrants. Never false if something is.
+ */
+static bool map_may_be_obstructed(const CoordsXYRangedZ& pos, uint8_t quadrants)
+{
+    if (pos.clearanceZ <= pos.baseZ || _tileOccupancy.empty())
         return true;
+
+    const auto baseHeight = floor2(pos.baseZ, COORDS_Z_STEP) / COORDS_Z_STEP;
+    const auto clearanceHeight = (pos.clearanceZ + COORDS_Z_STEP - 1) / COORDS_Z_STEP;
+    const auto mask = map_get_occupancy_mask(baseHeight, clearanceHeight);
+
+    const auto& occupancy = map_get_tile_occupancy(TileCoordsXY(pos));
+    for (size_t i = 0; i < occupancy.Quadrants.size(); i++)
+    {
+        if ((quadrants & (1 << i)) && (occupancy.Quadrants[i] & mask))
+            return true;
     }
+    return false;
 }
 
-static size_t CountElementsOnTile(const CoordsXY& loc);
+void ReorganiseTileElements()
+{
+    context_setcurrentcursor(CursorID::ZZZ);
+
+    SetTileElements(GetTileElements());
+}
 
-bool MapCheckCapacityAndReorganise(const CoordsXY& loc, size_t numElements)
+static bool map_check_free_elements(size_t numNewElements)
 {
-    auto numElementsOnTile = CountElementsOnTile(loc);
-    return map_check_free_elements_and_reorganise(numElementsOnTile, numElements);
+    // Tiles are given more room as they need it, the limit is how many elements a park can save.
+    if (_tileElementsInUse + numNewElements > MAX_TILE_ELEMENTS)
+    {
+        gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
+        return false;
+    }
+    return true;
+}
+
+bool MapCheckCapacityAndReorganise([[maybe_unused]] const CoordsXY& loc, size_t numElements)
+{
+    return map_check_free_elements(numElements);
+}
+
+void MapAddTileElementHolder()
+{
+    _tileElementHolders++;
+}
+
+void MapRemoveTileElementHolder()
+{
+    _tileElementHolders--;
 }
 
 static void clear_elements_at(const CoordsXY& loc);
@@ -301,7 +580,7 @@ TileElement* map_get_first_element_at(const CoordsXY& elementPos)
         return nullptr;
     }
     auto tileElementPos = TileCoordsXY{ elementPos };
-    return _tileIndex.GetFirstElementAt(tileElementPos);
+    return _tileElements.GetFirstElementAt(tileElementPos);
 }
 
 TileElement* map_get_nth_element_at(const CoordsXY& coords, int32_t n)
@@ -338,7 +617,7 @@ void map_set_tile_element(const TileCoordsXY& tilePos, TileElement* elements)
         log_error("Trying to access element outside of range");
         return;
     }
-    _tileIndex.SetTile(tilePos, elements);
+    _tileElements.SetFirstElementAt(tilePos, elements);
 }
 
 SurfaceElement* map_get_surface_element_at(const CoordsXY& coords)
@@ -468,10 +747,22 @@ void map_count_remaining_land_rights()
  */
 void map_strip_ghost_flag_from_elements()
 {
-    for (auto& element : _tileElements)
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
     {
-        element.SetGhost(false);
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            auto* element = _tileElements.GetFirstElementAt(TileCoordsXY{ x, y });
+            if (element == nullptr)
+                continue;
+
+            do
+            {
+                element->SetGhost(false);
+            } while (!(element++)->IsLastForTile());
+        }
     }
+
+    map_on_all_tiles_changed();
 }
 
 /**
@@ -1027,10 +1318,9 @@ void tile_element_remove(TileElement* tileElement)
     (tileElement - 1)->SetLastForTile(true);
     tileElement->base_height = MAX_ELEMENT_HEIGHT;
     _tileElementsInUse--;
-    if (tileElement == &_tileElements.back())
-    {
-        _tileElements.pop_back();
-    }
+
+    // Which tile the element was on is not known here.
+    map_on_all_tiles_changed();
 }
 
 /**
@@ -1131,29 +1421,18 @@ void map_invalidate_selection_rect()
     viewports_invalidate(left, top, right, bottom);
 }
 
-static size_t CountElementsOnTile(const CoordsXY& loc)
+static size_t CountElementsOnTile(const TileCoordsXY& loc)
 {
     size_t count = 0;
-    auto* element = _tileIndex.GetFirstElementAt(TileCoordsXY(loc));
-    do
+    auto* element = _tileElements.GetFirstElementAt(loc);
+    if (element != nullptr)
     {
-        count++;
-    } while (!(element++)->IsLastForTile());
-    return count;
-}
-
-static TileElement* AllocateTileElements(size_t numElementsOnTile, size_t numNewElements)
-{
-    if (!map_check_free_elements_and_reorganise(numElementsOnTile, numNewElements))
-    {
-        log_error("Cannot insert new element");
-        return nullptr;
+        do
+        {
+            count++;
+        } while (!(element++)->IsLastForTile());
     }
-
-    auto oldSize = _tileElements.size();
-    _tileElements.resize(_tileElements.size() + numElementsOnTile + numNewElements);
-    _tileElementsInUse += numNewElements;
-    return &_tileElements[oldSize];
+    return count;
 }
 
 /**
@@ -1162,75 +1441,65 @@ static TileElement* AllocateTileElements(size_t numElementsOnTile, size_t numNew
  */
 TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants, TileElementType type)
 {
-    const auto& tileLoc = TileCoordsXYZ(loc);
-
-    auto numElementsOnTileOld = CountElementsOnTile(loc);
-    auto* newTileElement = AllocateTileElements(numElementsOnTileOld, 1);
-    auto* originalTileElement = _tileIndex.GetFirstElementAt(tileLoc);
-    if (newTileElement == nullptr)
+    const auto tileLoc = TileCoordsXY(loc);
+    if (!map_check_free_elements(1))
     {
+        log_error("Cannot insert new element");
         return nullptr;
     }
+    map_on_tile_changed(loc);
 
-    // Set tile index pointer to point to new element block
-    _tileIndex.SetTile(tileLoc, newTileElement);
+    // The elements of the tile may move, tiles around it are left alone.
+    const auto numElementsOnTile = CountElementsOnTile(tileLoc);
+    auto* tileElements = _tileElements.Reserve(tileLoc, numElementsOnTile, numElementsOnTile + 1);
+    _tileElementsInUse++;
 
-    bool isLastForTile = false;
-    if (originalTileElement == nullptr)
+    // Make room above all elements that are below the insert height
+    size_t insertIndex = 0;
+    while (insertIndex < numElementsOnTile && loc.z >= tileElements[insertIndex].GetBaseZ())
     {
-        isLastForTile = true;
+        insertIndex++;
     }
-    else
-    {
-        // Copy all elements that are below the insert height
-        while (loc.z >= originalTileElement->GetBaseZ())
-        {
-            // Copy over map element
-            *newTileElement = *originalTileElement;
-            originalTileElement->base_height = MAX_ELEMENT_HEIGHT;
-            originalTileElement++;
-            newTileElement++;
+    std::copy_backward(tileElements + insertIndex, tileElements + numElementsOnTile, tileElements + numElementsOnTile + 1);
 
-            if ((newTileElement - 1)->IsLastForTile())
-            {
-                // No more elements above the insert element
-                (newTileElement - 1)->SetLastForTile(false);
-                isLastForTile = true;
-                break;
-            }
-        }
-    }
-
-    // Insert new map element
-    auto* insertedElement = newTileElement;
-    newTileElement->type = 0;
-    newTileElement->SetType(static_cast<uint8_t>(type));
-    newTileElement->SetBaseZ(loc.z);
-    newTileElement->Flags = 0;
-    newTileElement->SetLastForTile(isLastForTile);
-    newTileElement->SetOccupiedQuadrants(occupiedQuadrants);
-    newTileElement->SetClearanceZ(loc.z);
-    newTileElement->owner = 0;
-    std::memset(&newTileElement->pad_05, 0, sizeof(newTileElement->pad_05));
-    std::memset(&newTileElement->pad_08, 0, sizeof(newTileElement->pad_08));
-    newTileElement++;
-
-    // Insert rest of map elements above insert height
-    if (!isLastForTile)
+    const bool isLastForTile = insertIndex == numElementsOnTile;
+    if (isLastForTile && insertIndex > 0)
     {
-        do
-        {
-            // Copy over map element
-            *newTileElement = *originalTileElement;
-            originalTileElement->base_height = MAX_ELEMENT_HEIGHT;
-            originalTileElement++;
-            newTileElement++;
-        } while (!((newTileElement - 1)->IsLastForTile()));
+        // No more elements above the insert element
+        tileElements[insertIndex - 1].SetLastForTile(false);
     }
 
+    // Insert new map element
+    auto* insertedElement = &tileElements[insertIndex];
+    insertedElement->type = 0;
+    insertedElement->SetType(static_cast<uint8_t>(type));
+    insertedElement->SetBaseZ(loc.z);
+    insertedElement->Flags = 0;
+    insertedElement->SetLastForTile(isLastForTile);
+    insertedElement->SetOccupiedQuadrants(occupiedQuadrants);
+    insertedElement->SetClearanceZ(loc.z);
+    insertedElement->owner = 0;
+    std::memset(&insertedElement->pad_05, 0, sizeof(insertedElement->pad_05));
+    std::memset(&insertedElement->pad_08, 0, sizeof(insertedElement->pad_08));
     return insertedElement;
 }
 
+/**
+ * Replaces all the elements of a tile. Only the last of the given elements may be marked as the last for the tile.
+ */
+bool map_replace_tile_elements(const TileCoordsXY& tilePos, const TileElement* elements, size_t numElements)
+{
+    const auto numElementsOnTile = CountElementsOnTile(tilePos);
+    if (numElements > numElementsOnTile && !map_check_free_elements(numElements - numElementsOnTile))
+        return false;
+
+    auto* tileElements = _tileElements.Reserve(tilePos, 0, numElements);
+    std::copy_n(elements, numElements, tileElements);
+    _tileElementsInUse = _tileElementsInUse - numElementsOnTile + numElements;
+    map_on_tile_changed(tilePos.ToCoordsXY());
+    return true;
+}
+
 /**
  *
  *  rct2: 0x0068BB18
@@ -1341,6 +1610,15 @@ std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructWithClearAt(
         res->ErrorMessage = STR_NONE;
         return res;
     }
+
+    // When nothing else on the tile can be in the way, only the surface has to be checked.
+    const bool checkAllElements = map_may_be_obstructed(pos, quarterTile.GetBaseQuarterOccupied());
+    if (!checkAllElements)
+    {
+        tileElement = reinterpret_cast<TileElement*>(map_get_surface_element_at(pos));
+        if (tileElement == nullptr)
+            return res;
+    }
     do
     {
         if (tileElement->GetType() != TILE_ELEMENT_TYPE_SURFACE)
@@ -1486,7 +1764,7 @@ std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructWithClearAt(
                 return res;
             }
         }
-    } while (!(tileElement++)->IsLastForTile());
+    } while (checkAllElements && !(tileElement++)->IsLastForTile());
     return res;
 }
 
@@ -1494,6 +1772,37 @@ std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructAt(const Coord
 {
     return MapCanConstructWithClearAt(pos, nullptr, bl, 0);
 }
+/**
+ * Whether map_update_tiles can change anything on the tile. Everything that could change the answer either inserts an
+ * element on the tile, invalidates it for redrawing or updates the park fences around it, which all call
+ * map_on_tile_changed.
+ */
+static bool map_tile_needs_update(const CoordsXY& coords)
+{
+    auto* surfaceElement = map_get_surface_element_at(coords);
+    if (surfaceElement == nullptr)
+        return false;
+
+    // Grass under water or outside the park is only ever cut, so it needs no update once it has been.
+    if (surfaceElement->CanGrassGrow())
+    {
+        const bool isCut = (surfaceElement->GetGrassLength() & 7) == GRASS_LENGTH_CLEAR_0;
+        const bool canGrow = surfaceElement->GetWaterHeight() <= surfaceElement->GetBaseZ()
+            && map_is_location_in_park(coords);
+        if (canGrow || !isCut)
+            return true;
+    }
+
+    for (auto* element : TileElementsView(coords))
+    {
+        if (element->GetType() == TILE_ELEMENT_TYPE_SMALL_SCENERY)
+            return true;
+        if (element->GetType() == TILE_ELEMENT_TYPE_PATH && element->AsPath()->HasAddition())
+            return true;
+    }
+    return false;
+}
+
 /**
  * Updates grass length, scenery age and jumping fountains.
  *
@@ -1501,9 +1810,22 @@ std::unique_ptr<GameActions::ConstructClearResult> MapCanConstructAt(const Coord
  */
 void map_update_tiles()
 {
+    // Give tiles that had many elements removed a smaller block, a few at a time. This does not change the game state.
+    // The blocks are handed to other tiles, so it waits while the track design being saved or anything else holds on to
+    // elements.
+    if (!gTrackDesignSaveMode && _tileElementHolders == 0)
+    {
+        _tileElements.Compact(TILE_ELEMENTS_COMPACT_PER_TICK);
+        UpdateTileElementMemoryUsage();
+    }
+
     int32_t ignoreScreenFlags = SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER;
     if (gScreenFlags & ignoreScreenFlags)
+    {
+        // The editors can change the loaded objects, so start over with every tile once they are left.
+        _tilesToUpdate.set();
         return;
+    }
 
     // Update 43 more tiles (for each 256x256 block)
     for (int32_t j = 0; j < 43; j++)
@@ -1525,13 +1847,22 @@ void map_update_tiles()
         {
             for (int32_t blockX = 0; blockX < gMapSize; blockX += 256)
             {
-                auto mapPos = TileCoordsXY{ blockX + x, blockY + y }.ToCoordsXY();
+                const auto tilePos = TileCoordsXY{ blockX + x, blockY + y };
+                const auto tileIndex = tilePos.x + (tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL);
+                if (!_tilesToUpdate.test(tileIndex))
+                    continue;
+
+                auto mapPos = tilePos.ToCoordsXY();
                 auto* surfaceElement = map_get_surface_element_at(mapPos);
                 if (surfaceElement != nullptr)
                 {
                     surfaceElement->UpdateGrassLength(mapPos);
                     scenery_update_tile(mapPos);
                 }
+                if (!map_tile_needs_update(mapPos))
+                {
+                    _tilesToUpdate.reset(tileIndex);
+                }
             }
         }
 
@@ -1589,6 +1920,7 @@ void map_restore_provisional_elements()
 void map_remove_out_of_range_elements()
 {
     int32_t mapMaxXY = gMapSizeMaxXY;
+    map_invalidate_all_tile_height_bounds();
 
     // Ensure that we can remove elements
     //
@@ -1666,6 +1998,8 @@ void map_extend_boundary_surface()
     SurfaceElement *existingTileElement, *newTileElement;
     int32_t x, y;
 
+    map_invalidate_all_tile_height_bounds();
+
     y = gMapSize - 2;
     for (x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
     {
@@ -2027,9 +2361,28 @@ ScreenCoordsXY translate_3d_to_2d_with_z(int32_t rotation, const CoordsXYZ& pos)
 
 static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int32_t z1, int32_t maxZoom)
 {
+    // A tile that has to be redrawn may have changed, including on servers that never draw it.
+    map_on_tile_changed({ x, y });
+
     if (gOpenRCT2Headless)
         return;
 
+    if (_invalidationBatchDepth > 0)
+    {
+        if (_invalidationBatchEmpty)
+        {
+            _invalidationBatchEmpty = false;
+            _invalidationBatchMin = { x, y };
+            _invalidationBatchMax = { x, y };
+        }
+        else
+        {
+            _invalidationBatchMin = { std::min(_invalidationBatchMin.x, x), std::min(_invalidationBatchMin.y, y) };
+            _invalidationBatchMax = { std::max(_invalidationBatchMax.x, x), std::max(_invalidationBatchMax.y, y) };
+        }
+        return;
+    }
+
     int32_t x1, y1, x2, y2;
 
     x += 16;
@@ -2105,6 +2458,22 @@ void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs)
     viewports_invalidate(left, top, right, bottom);
 }
 
+void map_begin_invalidation_batch()
+{
+    _invalidationBatchDepth++;
+}
+
+void map_end_invalidation_batch()
+{
+    Guard::Assert(_invalidationBatchDepth > 0, "Invalidation batch ended without being started");
+    _invalidationBatchDepth--;
+    if (_invalidationBatchDepth == 0 && !_invalidationBatchEmpty)
+    {
+        _invalidationBatchEmpty = true;
+        map_invalidate_region(_invalidationBatchMin, _invalidationBatchMax);
+    }
+}
+
 int32_t map_get_tile_side(const CoordsXY& mapPos)
 {
     int32_t subMapX = mapPos.x & (32 - 1);
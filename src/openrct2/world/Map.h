@@ -15,6 +15,7 @@
 #include "TileElement.h"
 
 #include <initializer_list>
+#include <optional>
 #include <vector>
 
 #define MINIMUM_LAND_HEIGHT 2
@@ -172,9 +173,17 @@ public:
     }
 };
 
+enum class TileElementLayout : uint8_t
+{
+    RowMajor,
+    Morton,
+};
+
 void ReorganiseTileElements();
-const std::vector<TileElement>& GetTileElements();
+std::vector<TileElement> GetTileElements();
 void SetTileElements(std::vector<TileElement>&& tileElements);
+TileElementLayout GetTileElementLayout();
+void SetTileElementLayout(TileElementLayout layout);
 void StashMap();
 void UnstashMap();
 
@@ -215,7 +224,15 @@ void map_remove_all_rides();
 void map_invalidate_map_selection_tiles();
 void map_invalidate_selection_rect();
 bool MapCheckCapacityAndReorganise(const CoordsXY& loc, size_t numElements = 1);
+
+/**
+ * Counts the holders of tile element pointers that are kept across ticks, such as the tile elements given to plugins.
+ * Tiles are not compacted while there are any, so those pointers never end up pointing into another tile.
+ */
+void MapAddTileElementHolder();
+void MapRemoveTileElementHolder();
 TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants, TileElementType type);
+bool map_replace_tile_elements(const TileCoordsXY& tilePos, const TileElement* elements, size_t numElements);
 
 template<typename T> T* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants)
 {
@@ -253,6 +270,62 @@ int32_t tile_element_iterator_next(tile_element_iterator* it);
 void tile_element_iterator_restart_for_tile(tile_element_iterator* it);
 
 void map_update_tiles();
+void map_on_tile_changed(const CoordsXY& coords);
+void map_on_all_tiles_changed();
+
+/**
+ * Gets a number that changes whenever map_on_all_tiles_changed is called, i.e. when a game action is executed or the
+ * elements of any tile may have changed outside of one.
+ */
+uint32_t map_get_version();
+
+/**
+ * Gets the number of times map_on_tile_changed has been called, which counts a tile again each time it changes.
+ */
+uint64_t map_get_tile_change_count();
+
+/**
+ * Gets a number that changes whenever the elements of the tile may have changed, for caches derived from them. The
+ * number of every tile changes when a game action is executed or an element removed.
+ */
+uint64_t map_get_tile_version(const TileCoordsXY& tilePos);
+
+/**
+ * Gets the number of times each tile has been changed or invalidated, indexed by x + (y * MAXIMUM_MAP_SIZE_TECHNICAL).
+ * Unlike map_get_tile_version these do not all change when a game action is executed, so anything drawing every tile
+ * can find the few that have changed.
+ */
+const std::vector<uint32_t>& map_get_tile_change_counts();
+
+constexpr int32_t MAP_BLOCK_SIZE = 8;
+constexpr int32_t MAP_BLOCK_COUNT = MAXIMUM_MAP_SIZE_TECHNICAL / MAP_BLOCK_SIZE;
+
+/**
+ * Gets a number that changes whenever a tile in the block of MAP_BLOCK_SIZE by MAP_BLOCK_SIZE tiles, or a tile next to
+ * the block, changes. Blocks are numbered x + (y * MAP_BLOCK_COUNT).
+ */
+uint32_t map_get_block_change_count(uint16_t blockIndex);
+
+/**
+ * The lowest and highest the elements of a tile can be drawn at, including the edges of its surface that reach down
+ * to its neighbours.
+ */
+struct TileHeightBounds
+{
+    int16_t MinZ;
+    int16_t MaxZ;
+};
+
+/**
+ * Gets the height bounds of the tile, or std::nullopt if the tile has changed since they were last worked out by
+ * map_update_tile_height_bounds. Safe to call from any thread while the map is not being changed.
+ */
+std::optional<TileHeightBounds> map_get_tile_height_bounds(const TileCoordsXY& tilePos);
+
+/**
+ * Works out the height bounds of every tile that has changed since the last call.
+ */
+void map_update_tile_height_bounds();
 int32_t map_get_highest_z(const CoordsXY& loc);
 
 bool tile_element_wants_path_connection_towards(const TileCoordsXYZD& coords, const TileElement* const elementToBeRemoved);
@@ -272,6 +345,27 @@ void map_invalidate_tile_full(const CoordsXY& tilePos);
 void map_invalidate_element(const CoordsXY& elementPos, TileElement* tileElement);
 void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs);
 
+/**
+ * While a batch is open, the tiles that are invalidated are only collected. The area covering all of them is invalidated
+ * at once when the outermost batch ends, for actions that change a large number of tiles.
+ */
+void map_begin_invalidation_batch();
+void map_end_invalidation_batch();
+
+struct MapInvalidationBatch
+{
+    MapInvalidationBatch()
+    {
+        map_begin_invalidation_batch();
+    }
+    ~MapInvalidationBatch()
+    {
+        map_end_invalidation_batch();
+    }
+    MapInvalidationBatch(const MapInvalidationBatch&) = delete;
+    MapInvalidationBatch& operator=(const MapInvalidationBatch&) = delete;
+};
+
 int32_t map_get_tile_side(const CoordsXY& mapPos);
 int32_t map_get_tile_quadrant(const CoordsXY& mapPos);
 int32_t map_get_corner_height(int32_t z, int32_t slope, int32_t direction);
@@ -26,25 +26,30 @@
 #include "Scenery.h"
 #include "SmallScenery.h"
 
+#include <unordered_set>
+
 using map_animation_invalidate_event_handler = bool (*)(const CoordsXYZ& loc);
 
 static std::vector<MapAnimation> _mapAnimations;
 
+// The type and location of every animation in _mapAnimations, so checking for an existing animation does not have to
+// search the list.
+static std::unordered_set<uint64_t> _mapAnimationKeys;
+
 constexpr size_t MAX_ANIMATED_OBJECTS = 2000;
 
 static bool InvalidateMapAnimation(const MapAnimation& obj);
 
+static uint64_t GetAnimationKey(int32_t type, const CoordsXYZ& location)
+{
+    return (static_cast<uint64_t>(static_cast<uint8_t>(type)) << 48)
+        | (static_cast<uint64_t>(static_cast<uint16_t>(location.x)) << 32)
+        | (static_cast<uint64_t>(static_cast<uint16_t>(location.y)) << 16) | static_cast<uint16_t>(location.z);
+}
+
 static bool DoesAnimationExist(int32_t type, const CoordsXYZ& location)
 {
-    for (const auto& a : _mapAnimations)
-    {
-        if (a.type == type && a.location == location)
-        {
-            // Animation already exists
-            return true;
-        }
-    }
-    return false;
+    return _mapAnimationKeys.find(GetAnimationKey(type, location)) != _mapAnimationKeys.end();
 }
 
 void map_animation_create(int32_t type, const CoordsXYZ& loc)
@@ -55,6 +60,7 @@ void map_animation_create(int32_t type, const CoordsXYZ& loc)
         {
             // Create new animation
             _mapAnimations.push_back({ static_cast<uint8_t>(type), loc });
+            _mapAnimationKeys.insert(GetAnimationKey(type, loc));
         }
         else
         {
@@ -69,19 +75,22 @@ void map_animation_create(int32_t type, const CoordsXYZ& loc)
  */
 void map_animation_invalidate_all()
 {
-    auto it = _mapAnimations.begin();
-    while (it != _mapAnimations.end())
+    // Finished animations are removed in a single pass rather than erased one at a time, keeping the order of the rest
+    size_t numAnimations = 0;
+    for (size_t i = 0; i < _mapAnimations.size(); i++)
     {
-        if (InvalidateMapAnimation(*it))
+        const auto& a = _mapAnimations[i];
+        if (InvalidateMapAnimation(a))
         {
             // Map animation has finished, remove it
-            it = _mapAnimations.erase(it);
+            _mapAnimationKeys.erase(GetAnimationKey(a.type, a.location));
         }
         else
         {
-            it++;
+            _mapAnimations[numAnimations++] = a;
         }
     }
+    _mapAnimations.resize(numAnimations);
 }
 
 /**
@@ -608,6 +617,7 @@ const std::vector<MapAnimation>& GetMapAnimations()
 static void ClearMapAnimations()
 {
     _mapAnimations.clear();
+    _mapAnimationKeys.clear();
 }
 
 void AutoCreateMapAnimations()
@@ -15,6 +15,7 @@
 #include "../core/Guard.hpp"
 #include "../core/Imaging.h"
 #include "../core/String.hpp"
+#include "../core/TaskScheduler.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/StringIds.h"
 #include "../object/Object.h"
@@ -33,6 +34,7 @@
 #include <cmath>
 #include <cstring>
 #include <iterator>
+#include <optional>
 #include <vector>
 
 #pragma region Height map struct
@@ -112,6 +114,30 @@ static void set_height(int32_t x, int32_t y, int32_t height)
         _height[x + y * _heightSize] = height;
 }
 
+static constexpr int32_t HeightMapRowsPerTask = 32;
+
+/**
+ * Calls fn(yStart, yEnd) for bands of the given rows of the height map on the task scheduler. The passes run this way
+ * only read values that are not written in the same pass, so the height map comes out the same however the rows are
+ * split.
+ */
+template<typename TFn> static void mapgen_for_each_row_band(int32_t yStart, int32_t yEnd, const TFn& fn)
+{
+    // Commands that run without a context get a scheduler of their own.
+    auto context = OpenRCT2::GetContext();
+    std::optional<OpenRCT2::TaskScheduler> localScheduler;
+    auto& scheduler = context != nullptr ? context->GetTaskScheduler() : localScheduler.emplace();
+
+    const TFn* bandFn = &fn;
+    OpenRCT2::TaskGroup tasks(scheduler);
+    for (int32_t y = yStart; y < yEnd; y += HeightMapRowsPerTask)
+    {
+        auto bandEnd = std::min(y + HeightMapRowsPerTask, yEnd);
+        tasks.Run([bandFn, y, bandEnd]() { (*bandFn)(y, bandEnd); });
+    }
+    tasks.Wait();
+}
+
 void mapgen_generate_blank(mapgen_settings* settings)
 {
     int32_t x, y;
@@ -426,29 +452,30 @@ static void mapgen_set_water_level(int32_t waterLevel)
  */
 static void mapgen_smooth_height(int32_t iterations)
 {
-    int32_t i, x, y, xx, yy, avg;
     int32_t arraySize = _heightSize * _heightSize * sizeof(uint8_t);
     uint8_t* copyHeight = new uint8_t[arraySize];
 
-    for (i = 0; i < iterations; i++)
+    for (int32_t i = 0; i < iterations; i++)
     {
         std::memcpy(copyHeight, _height, arraySize);
-        for (y = 1; y < _heightSize - 1; y++)
-        {
-            for (x = 1; x < _heightSize - 1; x++)
+        mapgen_for_each_row_band(1, _heightSize - 1, [copyHeight](int32_t yStart, int32_t yEnd) {
+            for (int32_t y = yStart; y < yEnd; y++)
             {
-                avg = 0;
-                for (yy = -1; yy <= 1; yy++)
+                for (int32_t x = 1; x < _heightSize - 1; x++)
                 {
-                    for (xx = -1; xx <= 1; xx++)
+                    int32_t avg = 0;
+                    for (int32_t yy = -1; yy <= 1; yy++)
                     {
-                        avg += copyHeight[(y + yy) * _heightSize + (x + xx)];
+                        for (int32_t xx = -1; xx <= 1; xx++)
+                        {
+                            avg += copyHeight[(y + yy) * _heightSize + (x + xx)];
+                        }
                     }
+                    avg /= 9;
+                    set_height(x, y, avg);
                 }
-                avg /= 9;
-                set_height(x, y, avg);
             }
-        }
+        });
     }
 
     delete[] copyHeight;
@@ -635,25 +662,26 @@ static float grad(int32_t hash, float x, float y)
 
 static void mapgen_simplex(mapgen_settings* settings)
 {
-    int32_t x, y;
-
     float freq = settings->simplex_base_freq * (1.0f / _heightSize);
     int32_t octaves = settings->simplex_octaves;
 
     int32_t low = settings->simplex_low;
     int32_t high = settings->simplex_high;
 
+    // The permutation table is the only random part, the noise of each cell only reads it.
     noise_rand();
-    for (y = 0; y < _heightSize; y++)
-    {
-        for (x = 0; x < _heightSize; x++)
+    mapgen_for_each_row_band(0, _heightSize, [freq, octaves, low, high](int32_t yStart, int32_t yEnd) {
+        for (int32_t y = yStart; y < yEnd; y++)
         {
-            float noiseValue = std::clamp(fractal_noise(x, y, freq, octaves, 2.0f, 0.65f), -1.0f, 1.0f);
-            float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
+            for (int32_t x = 0; x < _heightSize; x++)
+            {
+                float noiseValue = std::clamp(fractal_noise(x, y, freq, octaves, 2.0f, 0.65f), -1.0f, 1.0f);
+                float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
 
-            set_height(x, y, low + static_cast<int32_t>(normalisedNoiseValue * high));
+                set_height(x, y, low + static_cast<int32_t>(normalisedNoiseValue * high));
+            }
         }
-    }
+    });
 }
 
 #pragma endregion
@@ -105,6 +105,9 @@ void park_set_open(bool open)
  */
 void update_park_fences(const CoordsXY& coords)
 {
+    // The ownership of the tile may have changed, which decides whether grass grows on it.
+    map_on_tile_changed(coords);
+
     if (map_is_edge(coords))
         return;
 
@@ -312,11 +315,12 @@ void Park::Update(const Date& date)
     // Every ~13 seconds
     if (gCurrentTicks % 512 == 0)
     {
-        gParkRating = CalculateParkRating();
-        gParkValue = CalculateParkValue();
+        const auto rideTotals = CalculateRideTotals();
+        gParkRating = CalculateParkRating(rideTotals);
+        gParkValue = CalculateParkValue(rideTotals);
         gCompanyValue = CalculateCompanyValue();
-        gTotalRideValueForMoney = CalculateTotalRideValueForMoney();
-        _suggestedGuestMaximum = CalculateSuggestedMaxGuests();
+        gTotalRideValueForMoney = CalculateTotalRideValueForMoney(rideTotals);
+        _suggestedGuestMaximum = CalculateSuggestedMaxGuests(rideTotals);
         _guestGenerationProbability = CalculateGuestGenerationProbability();
 
         window_invalidate_by_class(WC_FINANCES);
@@ -339,19 +343,20 @@ void Park::Update(const Date& date)
 
 int32_t Park::CalculateParkSize() const
 {
+    // Only the surface element holds the ownership, so there is no need to visit the rest of each tile's elements.
     int32_t tiles = 0;
-    tile_element_iterator it;
-    tile_element_iterator_begin(&it);
-    do
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
     {
-        if (it.element->GetType() == TILE_ELEMENT_TYPE_SURFACE)
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
         {
-            if (it.element->AsSurface()->GetOwnership() & (OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED | OWNERSHIP_OWNED))
+            auto surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            if (surfaceElement != nullptr
+                && (surfaceElement->GetOwnership() & (OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED | OWNERSHIP_OWNED)))
             {
                 tiles++;
             }
         }
-    } while (tile_element_iterator_next(&it));
+    }
 
     if (tiles != gParkSize)
     {
@@ -363,6 +368,66 @@ int32_t Park::CalculateParkSize() const
 }
 
 int32_t Park::CalculateParkRating() const
+{
+    return CalculateParkRating(CalculateRideTotals());
+}
+
+Park::RideTotals Park::CalculateRideTotals() const
+{
+    RideTotals totals;
+    bool ridePricesUnlocked = park_ride_prices_unlocked() && !(gParkFlags & PARK_FLAGS_NO_MONEY);
+    for (const auto& ride : GetRideManager())
+    {
+        const auto& rtd = ride.GetRideTypeDescriptor();
+
+        // Park rating
+        totals.Uptime += 100 - ride.downtime;
+        if (ride_has_ratings(&ride))
+        {
+            totals.Excitement += ride.excitement / 8;
+            totals.Intensity += ride.intensity / 8;
+            totals.NumRatedRides++;
+        }
+        totals.NumRides++;
+
+        // Park value
+        totals.Value += CalculateRideValue(&ride);
+
+        if (ride.lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED))
+            continue;
+
+        if (ride.status == RideStatus::Open)
+        {
+            // Ride value for money
+            if (ride.value != RIDE_VALUE_UNDEFINED)
+            {
+                money16 rideValue = static_cast<money16>(ride.value);
+                if (ridePricesUnlocked)
+                {
+                    rideValue -= ride.price[0];
+                }
+                if (rideValue > 0)
+                {
+                    totals.ValueForMoney += rideValue * 2;
+                }
+            }
+
+            // Guest score for ride type
+            totals.GuestBonus += rtd.BonusValue;
+        }
+
+        // Bonus guests for good rides, only used for difficult guest generation
+        if ((ride.lifecycle_flags & RIDE_LIFECYCLE_TESTED) && rtd.HasFlag(RIDE_TYPE_FLAG_HAS_TRACK)
+            && rtd.HasFlag(RIDE_TYPE_FLAG_HAS_DATA_LOGGING) && ride.stations[0].SegmentLength >= (600 << 16)
+            && ride.excitement >= RIDE_RATING(6, 00))
+        {
+            totals.GoodRideGuestBonus += rtd.BonusValue * 2;
+        }
+    }
+    return totals;
+}
+
+int32_t Park::CalculateParkRating(const RideTotals& rideTotals) const
 {
     if (_forcedParkRating >= 0)
     {
@@ -414,22 +479,11 @@ int32_t Park::CalculateParkRating() const
 
     // Rides
     {
-        int32_t rideCount = 0;
-        int32_t excitingRideCount = 0;
-        int32_t totalRideUptime = 0;
-        int32_t totalRideIntensity = 0;
-        int32_t totalRideExcitement = 0;
-        for (auto& ride : GetRideManager())
-        {
-            totalRideUptime += 100 - ride.downtime;
-            if (ride_has_ratings(&ride))
-            {
-                totalRideExcitement += ride.excitement / 8;
-                totalRideIntensity += ride.intensity / 8;
-                excitingRideCount++;
-            }
-            rideCount++;
-        }
+        int32_t rideCount = rideTotals.NumRides;
+        int32_t excitingRideCount = rideTotals.NumRatedRides;
+        int32_t totalRideUptime = rideTotals.Uptime;
+        int32_t totalRideIntensity = rideTotals.Intensity;
+        int32_t totalRideExcitement = rideTotals.Excitement;
         result -= 200;
         if (rideCount > 0)
         {
@@ -483,13 +537,14 @@ int32_t Park::CalculateParkRating() const
 }
 
 money32 Park::CalculateParkValue() const
+{
+    return CalculateParkValue(CalculateRideTotals());
+}
+
+money32 Park::CalculateParkValue(const RideTotals& rideTotals) const
 {
     // Sum ride values
-    money32 result = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        result += CalculateRideValue(&ride);
-    }
+    money32 result = rideTotals.Value;
 
     // +7.00 per guest
     result += gNumGuestsInPark * MONEY(7, 00);
@@ -518,78 +573,20 @@ money32 Park::CalculateCompanyValue() const
     return result;
 }
 
-money16 Park::CalculateTotalRideValueForMoney() const
+money16 Park::CalculateTotalRideValueForMoney(const RideTotals& rideTotals) const
 {
-    money16 totalRideValue = 0;
-    bool ridePricesUnlocked = park_ride_prices_unlocked() && !(gParkFlags & PARK_FLAGS_NO_MONEY);
-    for (auto& ride : GetRideManager())
-    {
-        if (ride.status != RideStatus::Open)
-            continue;
-        if (ride.lifecycle_flags & RIDE_LIFECYCLE_BROKEN_DOWN)
-            continue;
-        if (ride.lifecycle_flags & RIDE_LIFECYCLE_CRASHED)
-            continue;
-
-        // Add ride value
-        if (ride.value != RIDE_VALUE_UNDEFINED)
-        {
-            money16 rideValue = static_cast<money16>(ride.value);
-            if (ridePricesUnlocked)
-            {
-                rideValue -= ride.price[0];
-            }
-            if (rideValue > 0)
-            {
-                totalRideValue += rideValue * 2;
-            }
-        }
-    }
-    return totalRideValue;
+    return rideTotals.ValueForMoney;
 }
 
-uint32_t Park::CalculateSuggestedMaxGuests() const
+uint32_t Park::CalculateSuggestedMaxGuests(const RideTotals& rideTotals) const
 {
-    uint32_t suggestedMaxGuests = 0;
-
-    // TODO combine the two ride loops
-    for (auto& ride : GetRideManager())
-    {
-        if (ride.status != RideStatus::Open)
-            continue;
-        if (ride.lifecycle_flags & RIDE_LIFECYCLE_BROKEN_DOWN)
-            continue;
-        if (ride.lifecycle_flags & RIDE_LIFECYCLE_CRASHED)
-            continue;
-
-        // Add guest score for ride type
-        suggestedMaxGuests += ride.GetRideTypeDescriptor().BonusValue;
-    }
+    uint32_t suggestedMaxGuests = rideTotals.GuestBonus;
 
     // If difficult guest generation, extra guests are available for good rides
     if (gParkFlags & PARK_FLAGS_DIFFICULT_GUEST_GENERATION)
     {
         suggestedMaxGuests = std::min<uint32_t>(suggestedMaxGuests, 1000);
-        for (auto& ride : GetRideManager())
-        {
-            if (ride.lifecycle_flags & RIDE_LIFECYCLE_CRASHED)
-                continue;
-            if (ride.lifecycle_flags & RIDE_LIFECYCLE_BROKEN_DOWN)
-                continue;
-            if (!(ride.lifecycle_flags & RIDE_LIFECYCLE_TESTED))
-                continue;
-            if (!ride.GetRideTypeDescriptor().HasFlag(RIDE_TYPE_FLAG_HAS_TRACK))
-                continue;
-            if (!ride.GetRideTypeDescriptor().HasFlag(RIDE_TYPE_FLAG_HAS_DATA_LOGGING))
-                continue;
-            if (ride.stations[0].SegmentLength < (600 << 16))
-                continue;
-            if (ride.excitement < RIDE_RATING(6, 00))
-                continue;
-
-            // Bonus guests for good ride
-            suggestedMaxGuests += ride.GetRideTypeDescriptor().BonusValue * 2;
-        }
+        suggestedMaxGuests += rideTotals.GoodRideGuestBonus;
     }
 
     suggestedMaxGuests = std::min<uint32_t>(suggestedMaxGuests, 65535);
@@ -77,9 +77,28 @@ namespace OpenRCT2
         void UpdateHistories();
 
     private:
+        /**
+         * Everything the periodic park calculations need from the rides, gathered in a single pass over the rides.
+         */
+        struct RideTotals
+        {
+            int32_t NumRides{};
+            int32_t NumRatedRides{};
+            int32_t Uptime{};
+            int32_t Excitement{};
+            int32_t Intensity{};
+            money32 Value{};
+            money16 ValueForMoney{};
+            uint32_t GuestBonus{};
+            uint32_t GoodRideGuestBonus{};
+        };
+
+        RideTotals CalculateRideTotals() const;
+        int32_t CalculateParkRating(const RideTotals& rideTotals) const;
+        money32 CalculateParkValue(const RideTotals& rideTotals) const;
         money32 CalculateRideValue(const Ride* ride) const;
-        money16 CalculateTotalRideValueForMoney() const;
-        uint32_t CalculateSuggestedMaxGuests() const;
+        money16 CalculateTotalRideValueForMoney(const RideTotals& rideTotals) const;
+        uint32_t CalculateSuggestedMaxGuests(const RideTotals& rideTotals) const;
         uint32_t CalculateGuestGenerationProbability() const;
 
         void GenerateGuests();
@@ -15,6 +15,7 @@
 #include "../core/DataSerialiser.h"
 #include "../core/Guard.hpp"
 #include "../core/MemoryStream.h"
+#include "../core/MemoryUsage.h"
 #include "../interface/Viewport.h"
 #include "../peep/Peep.h"
 #include "../ride/Vehicle.h"
@@ -23,17 +24,113 @@
 #include "Duck.h"
 #include "EntityTweener.h"
 #include "Fountain.h"
+#include "Litter.h"
 #include "MoneyEffect.h"
 #include "Particle.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iterator>
+#include <memory>
 #include <numeric>
+#include <type_traits>
 #include <vector>
 
-static rct_sprite _spriteList[MAX_ENTITIES];
-static std::array<std::list<uint16_t>, EnumValue(EntityType::Count)> gEntityLists;
+/**
+ * Storage for the entities of one type. Slots are allocated in chunks that never move, so an entity stays at the same
+ * address until it is removed.
+ */
+class EntityPool
+{
+private:
+    static constexpr size_t ChunkSize = 256;
+
+    size_t _slotSize;
+    std::vector<std::unique_ptr<std::byte[]>> _chunks;
+    std::vector<std::byte*> _freeSlots;
+
+public:
+    explicit EntityPool(size_t entitySize)
+        : _slotSize((entitySize + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1))
+    {
+    }
+
+    // Returns a zeroed slot.
+    SpriteBase* Allocate()
+    {
+        if (_freeSlots.empty())
+        {
+            auto& chunk = _chunks.emplace_back(std::make_unique<std::byte[]>(_slotSize * ChunkSize));
+            OpenRCT2::MemoryUsage::Add(OpenRCT2::MemoryUsage::Category::Entities, _slotSize * ChunkSize);
+            // Hand out the slots of a new chunk in address order.
+            for (size_t i = ChunkSize; i-- > 0;)
+            {
+                _freeSlots.push_back(chunk.get() + i * _slotSize);
+            }
+        }
+
+        auto* slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        std::memset(slot, 0, _slotSize);
+        return reinterpret_cast<SpriteBase*>(slot);
+    }
+
+    void Free(SpriteBase* entity)
+    {
+        // Leave the slot looking like a removed entity, for anything still holding on to it.
+        const auto spriteIndex = entity->sprite_index;
+        std::memset(static_cast<void*>(entity), 0, _slotSize);
+        entity->sprite_index = spriteIndex;
+        entity->Type = EntityType::Null;
+        _freeSlots.push_back(reinterpret_cast<std::byte*>(entity));
+    }
+
+    void Clear()
+    {
+        OpenRCT2::MemoryUsage::Remove(OpenRCT2::MemoryUsage::Category::Entities, _slotSize * ChunkSize * _chunks.size());
+        _freeSlots.clear();
+        _chunks.clear();
+    }
+};
+
+static std::array<EntityPool, EnumValue(EntityType::Count)> _entityPools = {
+    EntityPool(sizeof(Vehicle)),
+    EntityPool(sizeof(Guest)),
+    EntityPool(sizeof(Staff)),
+    EntityPool(sizeof(Litter)),
+    EntityPool(sizeof(SteamParticle)),
+    EntityPool(sizeof(MoneyEffect)),
+    EntityPool(sizeof(VehicleCrashParticle)),
+    EntityPool(sizeof(ExplosionCloud)),
+    EntityPool(sizeof(CrashSplashParticle)),
+    EntityPool(sizeof(ExplosionFlare)),
+    EntityPool(sizeof(JumpingFountain)),
+    EntityPool(sizeof(Balloon)),
+    EntityPool(sizeof(Duck)),
+};
+
+// Every sprite index without an entity points to its own null entity, so that the index space stays the same.
+static std::array<SpriteBase, MAX_ENTITIES> _nullEntities;
+
+static SpriteBase* ResetNullEntity(uint16_t spriteIndex)
+{
+    auto& nullEntity = _nullEntities[spriteIndex];
+    nullEntity = {};
+    nullEntity.Type = EntityType::Null;
+    nullEntity.sprite_index = spriteIndex;
+    return &nullEntity;
+}
+
+static std::array<SpriteBase*, MAX_ENTITIES> _entities = []() {
+    std::array<SpriteBase*, MAX_ENTITIES> entities;
+    for (uint16_t i = 0; i < MAX_ENTITIES; i++)
+    {
+        entities[i] = ResetNullEntity(i);
+    }
+    return entities;
+}();
+static std::array<EntityIndexSet, EnumValue(EntityType::Count)> gEntityLists;
 static std::vector<uint16_t> _freeIdList;
 
 static bool _spriteFlashingList[MAX_ENTITIES];
@@ -41,7 +138,20 @@ static bool _spriteFlashingList[MAX_ENTITIES];
 constexpr const uint32_t SPATIAL_INDEX_SIZE = (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) + 1;
 constexpr const uint32_t SPATIAL_INDEX_LOCATION_NULL = SPATIAL_INDEX_SIZE - 1;
 
-static std::array<std::vector<uint16_t>, SPATIAL_INDEX_SIZE> gSpriteSpatialIndex;
+// Each tile has an intrusive, doubly linked list of the entities on it in sprite_index order. Entities are linked
+// through per entity arrays, so moving an entity between tiles never allocates.
+struct SpriteSpatialLinks
+{
+    uint16_t Next = SPRITE_INDEX_NULL;
+    uint16_t Previous = SPRITE_INDEX_NULL;
+    uint32_t Location = SPATIAL_INDEX_LOCATION_NULL;
+};
+static std::array<uint16_t, SPATIAL_INDEX_SIZE> gSpriteSpatialIndex = []() {
+    std::array<uint16_t, SPATIAL_INDEX_SIZE> heads;
+    heads.fill(SPRITE_INDEX_NULL);
+    return heads;
+}();
+static std::array<SpriteSpatialLinks, MAX_ENTITIES> gSpriteSpatialLinks;
 
 constexpr size_t GetSpatialIndexOffset(int32_t x, int32_t y)
 {
@@ -56,7 +166,7 @@ constexpr size_t GetSpatialIndexOffset(int32_t x, int32_t y)
         index = (flooredX << 3) | tileY;
     }
 
-    if (index >= sizeof(gSpriteSpatialIndex))
+    if (index >= SPATIAL_INDEX_SIZE)
     {
         return SPATIAL_INDEX_LOCATION_NULL;
     }
@@ -140,7 +250,7 @@ std::string rct_sprite_checksum::ToString() const
 
 SpriteBase* try_get_sprite(size_t spriteIndex)
 {
-    return spriteIndex >= MAX_ENTITIES ? nullptr : &_spriteList[spriteIndex].base;
+    return spriteIndex >= MAX_ENTITIES ? nullptr : _entities[spriteIndex];
 }
 
 SpriteBase* get_sprite(size_t spriteIndex)
@@ -153,11 +263,118 @@ SpriteBase* get_sprite(size_t spriteIndex)
     return try_get_sprite(spriteIndex);
 }
 
-const std::vector<uint16_t>& GetEntityTileList(const CoordsXY& spritePos)
+uint16_t GetFirstEntityOnTile(const CoordsXY& spritePos)
 {
     return gSpriteSpatialIndex[GetSpatialIndexOffset(spritePos.x, spritePos.y)];
 }
 
+uint16_t GetNextEntityOnTile(uint16_t spriteIndex)
+{
+    if (spriteIndex >= MAX_ENTITIES)
+        return SPRITE_INDEX_NULL;
+    return gSpriteSpatialLinks[spriteIndex].Next;
+}
+
+/**
+ * Collects candidate entities and tests their distance to a location a batch at a time. The positions of a batch
+ * are gathered first, so that the distance test is a branchless loop over plain arrays which the compiler can
+ * vectorise.
+ */
+class EntityRangeFilter
+{
+private:
+    static constexpr size_t BatchSize = 64;
+
+    CoordsXY _loc;
+    int32_t _radius;
+    std::vector<uint16_t>& _result;
+    size_t _count{};
+    std::array<uint16_t, BatchSize> _indices;
+    std::array<int32_t, BatchSize> _x;
+    std::array<int32_t, BatchSize> _y;
+    std::array<uint8_t, BatchSize> _inRange;
+
+public:
+    EntityRangeFilter(const CoordsXY& loc, int32_t radius, std::vector<uint16_t>& result)
+        : _loc(loc)
+        , _radius(radius)
+        , _result(result)
+    {
+    }
+
+    void Add(uint16_t spriteIndex, const SpriteBase& entity)
+    {
+        _indices[_count] = spriteIndex;
+        _x[_count] = entity.x;
+        _y[_count] = entity.y;
+        if (++_count == BatchSize)
+            Flush();
+    }
+
+    void Flush()
+    {
+        for (size_t i = 0; i < _count; i++)
+        {
+            _inRange[i] = (std::abs(_x[i] - _loc.x) <= _radius) & (std::abs(_y[i] - _loc.y) <= _radius);
+        }
+        for (size_t i = 0; i < _count; i++)
+        {
+            if (_inRange[i])
+                _result.push_back(_indices[i]);
+        }
+        _count = 0;
+    }
+};
+
+void GetEntitiesInRange(EntityType type, const CoordsXY& loc, int32_t radius, std::vector<uint16_t>& result)
+{
+    result.clear();
+    if (radius < 0)
+        return;
+
+    EntityRangeFilter filter(loc, radius, result);
+    const auto& list = GetEntityList(type);
+
+    // Positions outside of the map are clamped or wrapped by the spatial index, the tiles only hold every entity of
+    // the square when it lies within the map.
+    constexpr int32_t maxCoord = (MAXIMUM_MAP_SIZE_TECHNICAL * COORDS_XY_STEP) - 1;
+    const auto minX = loc.x - radius;
+    const auto minY = loc.y - radius;
+    const auto maxX = loc.x + radius;
+    const auto maxY = loc.y + radius;
+    const bool onMap = minX >= 0 && minY >= 0 && maxX <= maxCoord && maxY <= maxCoord;
+    const auto numTiles = ((maxX / COORDS_XY_STEP) - (minX / COORDS_XY_STEP) + 1)
+        * ((maxY / COORDS_XY_STEP) - (minY / COORDS_XY_STEP) + 1);
+    if (!onMap || list.size() <= static_cast<size_t>(numTiles))
+    {
+        for (auto spriteIndex : list)
+        {
+            filter.Add(spriteIndex, *_entities[spriteIndex]);
+        }
+        filter.Flush();
+        return;
+    }
+
+    for (auto tileX = minX / COORDS_XY_STEP; tileX <= maxX / COORDS_XY_STEP; tileX++)
+    {
+        for (auto tileY = minY / COORDS_XY_STEP; tileY <= maxY / COORDS_XY_STEP; tileY++)
+        {
+            const auto tileIndex = GetSpatialIndexOffset(tileX * COORDS_XY_STEP, tileY * COORDS_XY_STEP);
+            for (auto spriteIndex = gSpriteSpatialIndex[tileIndex]; spriteIndex != SPRITE_INDEX_NULL;
+                 spriteIndex = gSpriteSpatialLinks[spriteIndex].Next)
+            {
+                const auto& entity = *_entities[spriteIndex];
+                if (entity.Type == type)
+                    filter.Add(spriteIndex, entity);
+            }
+        }
+    }
+    filter.Flush();
+
+    // The tiles are visited column by column, the game logic expects the entities in sprite_index order.
+    std::sort(result.begin(), result.end());
+}
+
 void SpriteBase::Invalidate()
 {
     if (sprite_left == LOCATION_NULL)
@@ -213,7 +430,7 @@ static void ResetFreeIds()
     std::iota(std::rbegin(_freeIdList), std::rend(_freeIdList), 0);
 }
 
-const std::list<uint16_t>& GetEntityList(const EntityType id)
+const EntityIndexSet& GetEntityList(const EntityType id)
 {
     return gEntityLists[EnumValue(id)];
 }
@@ -225,17 +442,16 @@ const std::list<uint16_t>& GetEntityList(const EntityType id)
 void reset_sprite_list()
 {
     gSavedAge = 0;
-    std::memset(static_cast<void*>(_spriteList), 0, sizeof(_spriteList));
+
+    // The pools release their memory, nothing may keep pointing at the entities they held.
+    EntityTweener::Get().Reset();
+    for (auto& pool : _entityPools)
+    {
+        pool.Clear();
+    }
     for (int32_t i = 0; i < MAX_ENTITIES; ++i)
     {
-        auto* spr = GetEntity(i);
-        if (spr == nullptr)
-        {
-            continue;
-        }
-
-        spr->Type = EntityType::Null;
-        spr->sprite_index = i;
+        _entities[i] = ResetNullEntity(i);
 
         _spriteFlashingList[i] = false;
     }
@@ -254,10 +470,8 @@ static void SpriteSpatialInsert(SpriteBase* sprite, const CoordsXY& newLoc);
  */
 void reset_sprite_spatial_index()
 {
-    for (auto& vec : gSpriteSpatialIndex)
-    {
-        vec.clear();
-    }
+    gSpriteSpatialIndex.fill(SPRITE_INDEX_NULL);
+    gSpriteSpatialLinks.fill({});
     for (size_t i = 0; i < MAX_ENTITIES; i++)
     {
         auto* spr = GetEntity(i);
@@ -270,26 +484,76 @@ void reset_sprite_spatial_index()
 
 #ifndef DISABLE_NETWORK
 
-template<typename T> void NetworkSerialseEntityType(DataSerialiser& ds)
+/**
+ * The words each entity added to the last checksum, along with the entity as it was then. Serialising an entity only
+ * depends on its own bytes and for guests their cold data, so an entity that has not changed since can add the same words
+ * again without being serialised.
+ */
+struct EntityChecksumCache
+{
+    std::vector<std::byte> Bytes;
+    std::vector<uint64_t> Words;
+};
+static std::vector<EntityChecksumCache> _entityChecksumCache;
+
+template<typename T> static bool UpdateEntityChecksumBytes(EntityChecksumCache& cache, const T& entity)
+{
+    constexpr size_t coldDataSize = std::is_same_v<T, Guest> ? sizeof(GuestColdData) : 0;
+    const auto* entityBytes = reinterpret_cast<const std::byte*>(&entity);
+    const std::byte* coldBytes = nullptr;
+    if constexpr (std::is_same_v<T, Guest>)
+    {
+        coldBytes = reinterpret_cast<const std::byte*>(&entity.GetColdData());
+    }
+
+    if (cache.Bytes.size() == sizeof(T) + coldDataSize && std::memcmp(cache.Bytes.data(), entityBytes, sizeof(T)) == 0
+        && (coldDataSize == 0 || std::memcmp(cache.Bytes.data() + sizeof(T), coldBytes, coldDataSize) == 0))
+    {
+        return false;
+    }
+
+    cache.Bytes.resize(sizeof(T) + coldDataSize);
+    std::memcpy(cache.Bytes.data(), entityBytes, sizeof(T));
+    if (coldDataSize != 0)
+    {
+        std::memcpy(cache.Bytes.data() + sizeof(T), coldBytes, coldDataSize);
+    }
+    return true;
+}
+
+template<typename T> void NetworkSerialseEntityType(OpenRCT2::ChecksumStream& ms, DataSerialiser& ds)
 {
     for (auto* ent : EntityList<T>())
     {
-        ent->Serialise(ds);
+        auto& cache = _entityChecksumCache[ent->sprite_index];
+        if (UpdateEntityChecksumBytes(cache, *ent))
+        {
+            cache.Words.clear();
+            ms.SetRecordedWords(&cache.Words);
+            ent->Serialise(ds);
+            ms.SetRecordedWords(nullptr);
+        }
+        else
+        {
+            ms.WriteWords(cache.Words);
+        }
     }
 }
 
-template<typename... T> void NetworkSerialiseEntityTypes(DataSerialiser& ds)
+template<typename... T> void NetworkSerialiseEntityTypes(OpenRCT2::ChecksumStream& ms, DataSerialiser& ds)
 {
-    (NetworkSerialseEntityType<T>(ds), ...);
+    (NetworkSerialseEntityType<T>(ms, ds), ...);
 }
 
 rct_sprite_checksum sprite_checksum()
 {
     rct_sprite_checksum checksum{};
 
+    _entityChecksumCache.resize(MAX_ENTITIES);
+
     OpenRCT2::ChecksumStream ms(checksum.raw);
     DataSerialiser ds(true, ms);
-    NetworkSerialiseEntityTypes<Guest, Staff, Vehicle, Litter>(ds);
+    NetworkSerialiseEntityTypes<Guest, Staff, Vehicle, Litter>(ms, ds);
 
     return checksum;
 }
@@ -302,24 +566,38 @@ rct_sprite_checksum sprite_checksum()
 
 #endif // DISABLE_NETWORK
 
-static void sprite_reset(SpriteBase* sprite)
+static SpriteBase* AllocateEntity(uint16_t spriteIndex, EntityType type)
 {
-    // Need to retain how the sprite is linked in lists
-    uint16_t sprite_index = sprite->sprite_index;
-    _spriteFlashingList[sprite_index] = false;
+    auto* entity = _entityPools[EnumValue(type)].Allocate();
+    entity->sprite_index = spriteIndex;
+    entity->Type = type;
+    _entities[spriteIndex] = entity;
+    _spriteFlashingList[spriteIndex] = false;
+    if (type == EntityType::Guest)
+    {
+        // The cold data lives outside of the pool slot, so it is not zeroed along with it.
+        static_cast<Guest*>(entity)->GetColdData() = {};
+    }
+    return entity;
+}
 
-    std::memset(sprite, 0, sizeof(rct_sprite));
+static void FreeEntity(SpriteBase* entity)
+{
+    const auto spriteIndex = entity->sprite_index;
+    _spriteFlashingList[spriteIndex] = false;
 
-    sprite->sprite_index = sprite_index;
-    sprite->Type = EntityType::Null;
+    _entities[spriteIndex] = ResetNullEntity(spriteIndex);
+
+    if (entity->Type != EntityType::Null)
+    {
+        _entityPools[EnumValue(entity->Type)].Free(entity);
+    }
 }
 
 static constexpr uint16_t MAX_MISC_SPRITES = 300;
 static void AddToEntityList(SpriteBase* entity)
 {
-    auto& list = gEntityLists[EnumValue(entity->Type)];
-    // Entity list must be in sprite_index order to prevent desync issues
-    list.insert(std::lower_bound(std::begin(list), std::end(list), entity->sprite_index), entity->sprite_index);
+    gEntityLists[EnumValue(entity->Type)].insert(entity->sprite_index);
 }
 
 static void AddToFreeList(uint16_t index)
@@ -330,12 +608,7 @@ static void AddToFreeList(uint16_t index)
 
 static void RemoveFromEntityList(SpriteBase* entity)
 {
-    auto& list = gEntityLists[EnumValue(entity->Type)];
-    auto ptr = std::lower_bound(std::begin(list), std::end(list), entity->sprite_index);
-    if (ptr != std::end(list) && *ptr == entity->sprite_index)
-    {
-        list.erase(ptr);
-    }
+    gEntityLists[EnumValue(entity->Type)].erase(entity->sprite_index);
 }
 
 uint16_t GetMiscEntityCount()
@@ -350,13 +623,10 @@ uint16_t GetMiscEntityCount()
     return count;
 }
 
-static void PrepareNewEntity(SpriteBase* base, const EntityType type)
+static SpriteBase* PrepareNewEntity(uint16_t spriteIndex, const EntityType type)
 {
-    // Need to reset all sprite data, as the uninitialised values
-    // may contain garbage and cause a desync later on.
-    sprite_reset(base);
-
-    base->Type = type;
+    // The new entity is zeroed, as uninitialised values may contain garbage and cause a desync later on.
+    auto* base = AllocateEntity(spriteIndex, type);
     AddToEntityList(base);
 
     base->x = LOCATION_NULL;
@@ -368,6 +638,7 @@ static void PrepareNewEntity(SpriteBase* base, const EntityType type)
     base->sprite_left = LOCATION_NULL;
 
     SpriteSpatialInsert(base, { LOCATION_NULL, 0 });
+    return base;
 }
 
 SpriteBase* CreateEntity(EntityType type)
@@ -390,16 +661,15 @@ SpriteBase* CreateEntity(EntityType type)
         }
     }
 
-    auto* entity = GetEntity(_freeIdList.back());
-    if (entity == nullptr)
+    if (type >= EntityType::Count)
     {
         return nullptr;
     }
-    _freeIdList.pop_back();
 
-    PrepareNewEntity(entity, type);
+    const auto spriteIndex = _freeIdList.back();
+    _freeIdList.pop_back();
 
-    return entity;
+    return PrepareNewEntity(spriteIndex, type);
 }
 
 SpriteBase* CreateEntityAt(const uint16_t index, const EntityType type)
@@ -410,16 +680,14 @@ SpriteBase* CreateEntityAt(const uint16_t index, const EntityType type)
         return nullptr;
     }
 
-    auto* entity = GetEntity(index);
-    if (entity == nullptr)
+    if (index >= MAX_ENTITIES || type >= EntityType::Count)
     {
         return nullptr;
     }
 
     _freeIdList.erase(std::next(id).base());
 
-    PrepareNewEntity(entity, type);
-    return entity;
+    return PrepareNewEntity(index, type);
 }
 
 template<typename T> void MiscUpdateAllType()
@@ -449,26 +717,51 @@ void sprite_misc_update_all()
 // Performs a search to ensure that insert keeps next_in_quadrant in sprite_index order
 static void SpriteSpatialInsert(SpriteBase* sprite, const CoordsXY& newLoc)
 {
-    size_t newIndex = GetSpatialIndexOffset(newLoc.x, newLoc.y);
-    auto& spatialVector = gSpriteSpatialIndex[newIndex];
-    auto index = std::lower_bound(std::begin(spatialVector), std::end(spatialVector), sprite->sprite_index);
-    spatialVector.insert(index, sprite->sprite_index);
-}
+    const auto spriteIndex = sprite->sprite_index;
+    const auto newIndex = static_cast<uint32_t>(GetSpatialIndexOffset(newLoc.x, newLoc.y));
 
-static void SpriteSpatialRemove(SpriteBase* sprite)
-{
-    size_t currentIndex = GetSpatialIndexOffset(sprite->x, sprite->y);
-    auto& spatialVector = gSpriteSpatialIndex[currentIndex];
-    auto index = std::lower_bound(std::begin(spatialVector), std::end(spatialVector), sprite->sprite_index);
-    if (index != std::end(spatialVector) && *index == sprite->sprite_index)
+    auto previous = SPRITE_INDEX_NULL;
+    auto next = gSpriteSpatialIndex[newIndex];
+    while (next != SPRITE_INDEX_NULL && next < spriteIndex)
     {
-        spatialVector.erase(index, index + 1);
+        previous = next;
+        next = gSpriteSpatialLinks[next].Next;
     }
+
+    auto& links = gSpriteSpatialLinks[spriteIndex];
+    links.Next = next;
+    links.Previous = previous;
+    links.Location = newIndex;
+    if (previous == SPRITE_INDEX_NULL)
+        gSpriteSpatialIndex[newIndex] = spriteIndex;
     else
+        gSpriteSpatialLinks[previous].Next = spriteIndex;
+    if (next != SPRITE_INDEX_NULL)
+        gSpriteSpatialLinks[next].Previous = spriteIndex;
+}
+
+static void SpriteSpatialRemove(SpriteBase* sprite)
+{
+    const auto spriteIndex = sprite->sprite_index;
+    const auto currentIndex = static_cast<uint32_t>(GetSpatialIndexOffset(sprite->x, sprite->y));
+    auto& links = gSpriteSpatialLinks[spriteIndex];
+    if (links.Location != currentIndex)
     {
         log_warning("Bad sprite spatial index. Rebuilding the spatial index...");
         reset_sprite_spatial_index();
+
+        // The rebuilt index links the sprite at its current location, where it can be unlinked from as usual.
+        if (links.Location != currentIndex)
+            return;
     }
+
+    if (links.Previous == SPRITE_INDEX_NULL)
+        gSpriteSpatialIndex[currentIndex] = links.Next;
+    else
+        gSpriteSpatialLinks[links.Previous].Next = links.Next;
+    if (links.Next != SPRITE_INDEX_NULL)
+        gSpriteSpatialLinks[links.Next].Previous = links.Previous;
+    links = {};
 }
 
 static void SpriteSpatialMove(SpriteBase* sprite, const CoordsXY& newLoc)
@@ -484,6 +777,8 @@ static void SpriteSpatialMove(SpriteBase* sprite, const CoordsXY& newLoc)
 
 void SpriteBase::MoveTo(const CoordsXYZ& newLocation)
 {
+    EntityTweener::Get().OnEntityMove(this);
+
     if (x != LOCATION_NULL)
     {
         // Invalidate old position.
@@ -554,7 +849,7 @@ void sprite_remove(SpriteBase* sprite)
     AddToFreeList(sprite->sprite_index);
 
     SpriteSpatialRemove(sprite);
-    sprite_reset(sprite);
+    FreeEntity(sprite);
 }
 
 /**
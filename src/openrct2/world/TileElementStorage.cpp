@@ -0,0 +1,259 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TileElementStorage.h"
+
+#include "../core/Guard.hpp"
+
+#include <algorithm>
+
+static size_t CountElements(const TileElement* element)
+{
+    size_t count = 0;
+    do
+    {
+        count++;
+    } while (!(element++)->IsLastForTile());
+    return count;
+}
+
+TileElement* TileElementStorage::Region::Allocate(uint8_t sizeClass)
+{
+    auto& freeBlocks = FreeBlocks[sizeClass];
+    if (!freeBlocks.empty())
+    {
+        auto* block = freeBlocks.back();
+        freeBlocks.pop_back();
+        return block;
+    }
+
+    const size_t blockSize = size_t{ 1 } << sizeClass;
+    if (Remaining < blockSize)
+    {
+        AddFreeSpace(Next, Remaining);
+
+        const auto chunkSize = std::max(ChunkSize, blockSize);
+        Chunks.push_back(std::make_unique<TileElement[]>(chunkSize));
+        NumChunkElements += chunkSize;
+        Next = Chunks.back().get();
+        Remaining = chunkSize;
+    }
+
+    auto* block = Next;
+    Next += blockSize;
+    Remaining -= blockSize;
+    return block;
+}
+
+void TileElementStorage::Region::Free(TileElement* block, uint8_t sizeClass)
+{
+    if (block != nullptr)
+    {
+        FreeBlocks[sizeClass].push_back(block);
+    }
+}
+
+void TileElementStorage::Region::AddFreeSpace(TileElement* elements, size_t count)
+{
+    // Split the space into the largest blocks that fit, so that the end of a chunk is not lost.
+    for (uint8_t sizeClass = NumSizeClasses; sizeClass-- > 0 && count > 0;)
+    {
+        const size_t blockSize = size_t{ 1 } << sizeClass;
+        while (count >= blockSize)
+        {
+            FreeBlocks[sizeClass].push_back(elements);
+            elements += blockSize;
+            count -= blockSize;
+        }
+    }
+}
+
+static uint32_t SpreadBits(uint32_t value)
+{
+    // Moves bit n of a 16 bit value to bit 2n.
+    value = (value | (value << 8)) & 0x00FF00FF;
+    value = (value | (value << 4)) & 0x0F0F0F0F;
+    value = (value | (value << 2)) & 0x33333333;
+    value = (value | (value << 1)) & 0x55555555;
+    return value;
+}
+
+void TileElementStorage::SetLayout(TileElementLayout layout)
+{
+    _layout = layout;
+    for (uint32_t i = 0; i < MAXIMUM_MAP_SIZE_TECHNICAL; i++)
+    {
+        if (layout == TileElementLayout::Morton)
+        {
+            _tileIndexX[i] = SpreadBits(i);
+            _tileIndexY[i] = SpreadBits(i) << 1;
+        }
+        else
+        {
+            _tileIndexX[i] = i;
+            _tileIndexY[i] = i * MAXIMUM_MAP_SIZE_TECHNICAL;
+        }
+    }
+}
+
+size_t TileElementStorage::GetTileIndex(const TileCoordsXY& coords) const
+{
+    return _tileIndexX[coords.x] | _tileIndexY[coords.y];
+}
+
+size_t TileElementStorage::GetRegionIndex(size_t tileIndex) const
+{
+    // Regions are square and a power of two wide, so in Z-order the tiles of a region share the upper bits.
+    if (_layout == TileElementLayout::Morton)
+        return tileIndex >> (2 * RegionShift);
+
+    const auto x = (tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL) >> RegionShift;
+    const auto y = (tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL) >> RegionShift;
+    return x + (y * RegionsPerSide);
+}
+
+uint8_t TileElementStorage::GetSizeClass(size_t numElements)
+{
+    uint8_t sizeClass = 0;
+    while ((size_t{ 1 } << sizeClass) < numElements)
+    {
+        sizeClass++;
+    }
+    Guard::Assert(sizeClass < NumSizeClasses, "Too many elements on tile");
+    return sizeClass;
+}
+
+void TileElementStorage::Assign(const std::vector<TileElement>& tileElements, TileElementLayout layout)
+{
+    SetLayout(layout);
+    _tilePointers.assign(NumTiles, nullptr);
+    _tileBlocks.assign(NumTiles, {});
+    _regions.clear();
+    _regions.resize(RegionsPerSide * RegionsPerSide);
+    _compactPosition = 0;
+
+    // Find where each tile starts and how large the chunk of each region has to be.
+    std::vector<size_t> tileStarts(NumTiles, tileElements.size());
+    std::vector<size_t> tileSizes(NumTiles);
+    std::vector<size_t> regionSizes(_regions.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < NumTiles && offset < tileElements.size(); i++)
+    {
+        const TileCoordsXY coords{ static_cast<int32_t>(i % MAXIMUM_MAP_SIZE_TECHNICAL),
+                                   static_cast<int32_t>(i / MAXIMUM_MAP_SIZE_TECHNICAL) };
+        const auto tileIndex = GetTileIndex(coords);
+        tileStarts[tileIndex] = offset;
+        tileSizes[tileIndex] = CountElements(&tileElements[offset]);
+        offset += tileSizes[tileIndex];
+        _tileBlocks[tileIndex].SizeClass = GetSizeClass(tileSizes[tileIndex]);
+        regionSizes[GetRegionIndex(tileIndex)] += size_t{ 1 } << _tileBlocks[tileIndex].SizeClass;
+    }
+
+    // Every region gets one chunk holding all of its tiles plus some room for new elements.
+    for (size_t i = 0; i < _regions.size(); i++)
+    {
+        auto& region = _regions[i];
+        const auto chunkSize = regionSizes[i] + ChunkSize;
+        region.Chunks.push_back(std::make_unique<TileElement[]>(chunkSize));
+        region.NumChunkElements += chunkSize;
+        region.Next = region.Chunks.back().get();
+        region.Remaining = chunkSize;
+    }
+
+    // Blocks are handed out in tile index order, so they are laid out in the same order as the tiles.
+    for (size_t i = 0; i < NumTiles; i++)
+    {
+        if (tileSizes[i] == 0)
+            continue;
+
+        auto& block = _tileBlocks[i];
+        block.Elements = _regions[GetRegionIndex(i)].Allocate(block.SizeClass);
+        std::copy_n(tileElements.begin() + tileStarts[i], tileSizes[i], block.Elements);
+        _tilePointers[i] = block.Elements;
+    }
+}
+
+TileElement* TileElementStorage::GetFirstElementAt(const TileCoordsXY& coords) const
+{
+    return _tilePointers[GetTileIndex(coords)];
+}
+
+void TileElementStorage::SetFirstElementAt(const TileCoordsXY& coords, TileElement* element)
+{
+    _tilePointers[GetTileIndex(coords)] = element;
+}
+
+TileElement* TileElementStorage::Reserve(const TileCoordsXY& coords, size_t numElementsOnTile, size_t numElements)
+{
+    const auto tileIndex = GetTileIndex(coords);
+    auto& block = _tileBlocks[tileIndex];
+    auto* first = _tilePointers[tileIndex];
+    const size_t capacity = block.Elements != nullptr ? size_t{ 1 } << block.SizeClass : 0;
+    if ((first == block.Elements || first == nullptr) && capacity >= numElements)
+    {
+        _tilePointers[tileIndex] = block.Elements;
+        return block.Elements;
+    }
+
+    auto& region = _regions[GetRegionIndex(tileIndex)];
+    const auto sizeClass = GetSizeClass(numElements);
+    auto* elements = region.Allocate(sizeClass);
+    if (first != nullptr)
+    {
+        std::copy_n(first, numElementsOnTile, elements);
+    }
+    region.Free(block.Elements, block.SizeClass);
+
+    block.Elements = elements;
+    block.SizeClass = sizeClass;
+    _tilePointers[tileIndex] = elements;
+    return elements;
+}
+
+void TileElementStorage::Compact(size_t numTiles)
+{
+    if (_tileBlocks.empty())
+        return;
+
+    for (size_t i = 0; i < numTiles; i++)
+    {
+        const auto tileIndex = _compactPosition;
+        _compactPosition = (_compactPosition + 1) % NumTiles;
+
+        auto& block = _tileBlocks[tileIndex];
+        auto* first = _tilePointers[tileIndex];
+        if (first == nullptr || first != block.Elements)
+            continue;
+
+        // Only shrink tiles using at most a quarter of their block, so a tile does not keep moving back and forth.
+        const auto numElements = CountElements(first);
+        const auto sizeClass = GetSizeClass(numElements);
+        if (sizeClass + 2 > block.SizeClass)
+            continue;
+
+        auto& region = _regions[GetRegionIndex(tileIndex)];
+        auto* elements = region.Allocate(sizeClass);
+        std::copy_n(first, numElements, elements);
+        region.Free(block.Elements, block.SizeClass);
+
+        block.Elements = elements;
+        block.SizeClass = sizeClass;
+        _tilePointers[tileIndex] = elements;
+    }
+}
+
+size_t TileElementStorage::GetMemoryUsage() const
+{
+    size_t numBytes = (_tilePointers.capacity() * sizeof(TileElement*)) + (_tileBlocks.capacity() * sizeof(TileBlock));
+    for (const auto& region : _regions)
+    {
+        numBytes += region.NumChunkElements * sizeof(TileElement);
+    }
+    return numBytes;
+}
@@ -0,0 +1,106 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Map.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+/**
+ * Owns the tile elements of the map. Every tile has a block of elements whose capacity is a power of two, taken from
+ * chunks owned by the region of the map the tile is in. Chunks never move, so growing a tile only moves the elements
+ * of that tile and never the rest of the map. Blocks a tile has outgrown are kept by the region for the next tile
+ * that needs one of that size.
+ *
+ * Tiles are indexed either row by row or in Z-order (Morton order), chosen when the elements are assigned. In Z-order
+ * the blocks of neighbouring tiles are next to each other in both directions and each region is a contiguous range of
+ * tile indices, which suits the neighbourhood walks of painting, ride ratings and pathfinding better.
+ */
+class TileElementStorage
+{
+private:
+    static constexpr int32_t RegionShift = 4;
+    static constexpr int32_t RegionsPerSide = MAXIMUM_MAP_SIZE_TECHNICAL >> RegionShift;
+    static constexpr size_t NumTiles = MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL;
+    static constexpr size_t NumSizeClasses = 19;
+    static constexpr size_t ChunkSize = 256;
+
+    struct TileBlock
+    {
+        TileElement* Elements{};
+        uint8_t SizeClass{};
+    };
+
+    struct Region
+    {
+        std::vector<std::unique_ptr<TileElement[]>> Chunks;
+        size_t NumChunkElements{};
+        TileElement* Next{};
+        size_t Remaining{};
+        std::array<std::vector<TileElement*>, NumSizeClasses> FreeBlocks;
+
+        TileElement* Allocate(uint8_t sizeClass);
+        void Free(TileElement* block, uint8_t sizeClass);
+        void AddFreeSpace(TileElement* elements, size_t count);
+    };
+
+    // The first element of each tile, usually the start of its block. It can point elsewhere while a window paints
+    // temporary elements, or be nullptr after a plugin has cleared the tile.
+    std::vector<TileElement*> _tilePointers;
+    std::vector<TileBlock> _tileBlocks;
+    std::vector<Region> _regions;
+    size_t _compactPosition{};
+
+    // The tile index is _tileIndexX[x] | _tileIndexY[y], so looking a tile up does not depend on the layout.
+    TileElementLayout _layout{};
+    std::array<uint32_t, MAXIMUM_MAP_SIZE_TECHNICAL> _tileIndexX{};
+    std::array<uint32_t, MAXIMUM_MAP_SIZE_TECHNICAL> _tileIndexY{};
+
+public:
+    /**
+     * Replaces all elements, tileElements holds the elements of each tile in turn, row by row. The layout only changes
+     * how the elements are stored, not the order tileElements is read in.
+     */
+    void Assign(const std::vector<TileElement>& tileElements, TileElementLayout layout);
+
+    TileElementLayout GetLayout() const
+    {
+        return _layout;
+    }
+
+    TileElement* GetFirstElementAt(const TileCoordsXY& coords) const;
+    void SetFirstElementAt(const TileCoordsXY& coords, TileElement* element);
+
+    /**
+     * Makes room for numElements elements on a tile that currently has numElementsOnTile elements, which are kept at
+     * the start of the returned block. Only pointers to elements of this tile are invalidated.
+     */
+    TileElement* Reserve(const TileCoordsXY& coords, size_t numElementsOnTile, size_t numElements);
+
+    /**
+     * Moves the next numTiles tiles that use much less than their capacity into smaller blocks, invalidating pointers
+     * to their elements.
+     */
+    void Compact(size_t numTiles);
+
+    /**
+     * Gets the number of bytes allocated for the elements and the tile lookups.
+     */
+    size_t GetMemoryUsage() const;
+
+private:
+    void SetLayout(TileElementLayout layout);
+    size_t GetTileIndex(const TileCoordsXY& coords) const;
+    size_t GetRegionIndex(size_t tileIndex) const;
+    static uint8_t GetSizeClass(size_t numElements);
+};
@@ -0,0 +1,172 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2/core/FileStream.h>
+#include <openrct2/core/FileSystem.hpp>
+#include <random>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class FileStreamTest : public testing::Test
+{
+protected:
+    fs::path _path;
+
+    void SetUp() override
+    {
+        const auto* testInfo = testing::UnitTest::GetInstance()->current_test_info();
+        _path = fs::temp_directory_path() / (std::string("openrct2_") + testInfo->name() + ".bin");
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        fs::remove(_path, ec);
+    }
+
+    std::vector<uint8_t> ReadFile()
+    {
+        FileStream fs(_path, FILE_MODE_OPEN);
+        std::vector<uint8_t> data(static_cast<size_t>(fs.GetLength()));
+        fs.Read(data.data(), data.size());
+        return data;
+    }
+
+    static std::vector<uint8_t> CreatePattern(size_t length, uint8_t seed)
+    {
+        std::vector<uint8_t> data(length);
+        for (size_t i = 0; i < length; i++)
+        {
+            data[i] = static_cast<uint8_t>((i * 31) + seed);
+        }
+        return data;
+    }
+};
+
+TEST_F(FileStreamTest, WriteAcrossBuffer)
+{
+    constexpr size_t length = (FileStream::DefaultBufferSize * 3) + 100;
+    auto data = CreatePattern(length, 7);
+    {
+        FileStream fs(_path, FILE_MODE_WRITE);
+        size_t offset = 0;
+        size_t chunk = 1;
+        while (offset < length)
+        {
+            auto n = std::min(chunk, length - offset);
+            fs.Write(data.data() + offset, n);
+            offset += n;
+            chunk = (chunk * 3) % 70001 + 1;
+        }
+        ASSERT_EQ(fs.GetLength(), length);
+        ASSERT_EQ(fs.GetPosition(), length);
+        fs.Flush();
+    }
+    ASSERT_EQ(ReadFile(), data);
+}
+
+TEST_F(FileStreamTest, ReadWriteAtBufferBoundary)
+{
+    constexpr size_t boundary = FileStream::DefaultBufferSize;
+    auto data = CreatePattern(boundary * 2, 1);
+    FileStream fs(_path, FILE_MODE_WRITE);
+    fs.Write(data.data(), data.size());
+
+    // Read across the boundary, then write straight after the data that was read
+    uint8_t readBuffer[32];
+    fs.SetPosition(boundary - 16);
+    fs.Read(readBuffer, 24);
+    ASSERT_TRUE(std::equal(readBuffer, readBuffer + 24, data.begin() + boundary - 16));
+    ASSERT_EQ(fs.GetPosition(), boundary + 8);
+
+    const uint8_t written[] = { 0xAA, 0xBB, 0xCC, 0xDD };
+    fs.Write(written, sizeof(written));
+    std::copy(std::begin(written), std::end(written), data.begin() + boundary + 8);
+    ASSERT_EQ(fs.GetPosition(), boundary + 12);
+
+    // Read back over the data that was just written, while it is still buffered
+    fs.Seek(-20, STREAM_SEEK_CURRENT);
+    fs.Read(readBuffer, 32);
+    ASSERT_TRUE(std::equal(readBuffer, readBuffer + 32, data.begin() + boundary - 8));
+
+    // Write across the boundary from the end of the first buffer
+    fs.SetPosition(boundary - 2);
+    fs.Write(written, sizeof(written));
+    std::copy(std::begin(written), std::end(written), data.begin() + boundary - 2);
+    fs.Seek(0, STREAM_SEEK_END);
+    ASSERT_EQ(fs.GetPosition(), data.size());
+    fs.Flush();
+
+    ASSERT_EQ(fs.GetLength(), data.size());
+    ASSERT_EQ(ReadFile(), data);
+}
+
+TEST_F(FileStreamTest, RandomInterleavedAccess)
+{
+    // Mirror random reads, writes and seeks on a vector, near the boundaries of the buffer and past the end
+    for (size_t bufferSize : { FileStream::DefaultBufferSize, static_cast<size_t>(16), static_cast<size_t>(0) })
+    {
+        std::vector<uint8_t> expected;
+        std::mt19937 random(1234);
+        {
+            FileStream fs(_path, FILE_MODE_WRITE, bufferSize);
+            uint64_t position = 0;
+            std::vector<uint8_t> buffer;
+            for (int32_t i = 0; i < 2000; i++)
+            {
+                auto length = static_cast<size_t>(random() % 300);
+                if (random() % 8 == 0)
+                {
+                    length = static_cast<size_t>(random() % (FileStream::DefaultBufferSize + 100));
+                }
+                switch (random() % 3)
+                {
+                    case 0:
+                    {
+                        buffer = CreatePattern(length, static_cast<uint8_t>(i));
+                        fs.Write(buffer.data(), buffer.size());
+                        if (expected.size() < position + length)
+                        {
+                            expected.resize(static_cast<size_t>(position + length));
+                        }
+                        std::copy(buffer.begin(), buffer.end(), expected.begin() + position);
+                        position += length;
+                        break;
+                    }
+                    case 1:
+                    {
+                        buffer.resize(length);
+                        auto readLength = fs.TryRead(buffer.data(), length);
+                        auto expectedLength = std::min<uint64_t>(length, expected.size() - position);
+                        ASSERT_EQ(readLength, expectedLength);
+                        ASSERT_TRUE(std::equal(
+                            buffer.begin(), buffer.begin() + readLength, expected.begin() + position));
+                        position += readLength;
+                        break;
+                    }
+                    case 2:
+                    {
+                        auto boundary = static_cast<int64_t>((random() % 4) * FileStream::DefaultBufferSize);
+                        auto target = boundary + static_cast<int64_t>(random() % 64) - 32;
+                        position = static_cast<uint64_t>(std::clamp<int64_t>(target, 0, expected.size()));
+                        fs.SetPosition(position);
+                        break;
+                    }
+                }
+                ASSERT_EQ(fs.GetPosition(), position);
+                ASSERT_EQ(fs.GetLength(), expected.size());
+            }
+            fs.Flush();
+        }
+        ASSERT_EQ(ReadFile(), expected);
+    }
+}
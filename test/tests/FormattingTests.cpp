@@ -15,6 +15,7 @@
 #include <openrct2/config/Config.h>
 #include <openrct2/core/String.hpp>
 #include <openrct2/localisation/Localisation.h>
+#include <openrct2/localisation/LocalisationService.h>
 #include <openrct2/localisation/StringIds.h>
 #include <sstream>
 #include <string>
@@ -339,6 +340,74 @@ TEST_F(FormattingTests, using_legacy_buffer_args)
     ASSERT_STREQ("Queuing for Boat Hire 2", buffer);
 }
 
+TEST_F(FormattingTests, reuse_tokens_with_different_args)
+{
+    // Language strings are tokenised once, formatting them again must still use the new arguments
+    ASSERT_EQ("Guest 1", FormatStringId(STR_GUEST_X, 1));
+    ASSERT_EQ("Guest 23", FormatStringId(STR_GUEST_X, 23));
+    ASSERT_EQ("Guest -4", FormatStringId(STR_GUEST_X, -4));
+
+    char buffer[32]{};
+    FormatStringId(buffer, sizeof(buffer), STR_GUEST_X, 56);
+    ASSERT_STREQ("Guest 56", buffer);
+    ASSERT_EQ("Guest 78", FormatStringAny(GetFmtStringById(STR_GUEST_X), { 78 }));
+}
+
+TEST_F(FormattingTests, reuse_tokens_across_formats)
+{
+    // The same nested string ids are formatted through each formatting path in turn
+    constexpr rct_string_id strDefault = STR_RIDE_NAME_DEFAULT;
+    constexpr rct_string_id strBoatHire = STR_RIDE_NAME_BOAT_HIRE;
+    for (int32_t i = 1; i <= 3; i++)
+    {
+        auto expected = "Queuing for Boat Hire " + std::to_string(i);
+        ASSERT_EQ(expected, FormatStringId(STR_QUEUING_FOR, strDefault, strBoatHire, i));
+        ASSERT_EQ(expected, FormatString("Queuing for {STRINGID}", strDefault, strBoatHire, i));
+        ASSERT_EQ(expected, FormatStringAny("Queuing for {STRINGID}", { strDefault, strBoatHire, i }));
+
+        auto ft = Formatter();
+        ft.Add<rct_string_id>(strDefault);
+        ft.Add<rct_string_id>(strBoatHire);
+        ft.Add<uint16_t>(i);
+        char buffer[32]{};
+        FormatStringLegacy(buffer, sizeof(buffer), STR_QUEUING_FOR, ft.Data());
+        ASSERT_EQ(expected, buffer);
+    }
+}
+
+TEST_F(FormattingTests, reuse_tokens_iteration)
+{
+    auto expected = FmtString(language_get_string(STR_QUEUING_FOR));
+    for (int32_t i = 0; i < 2; i++)
+    {
+        auto fmt = GetFmtStringById(STR_QUEUING_FOR);
+        auto it = fmt.begin();
+        auto end = fmt.end();
+        for (const auto& token : expected)
+        {
+            ASSERT_TRUE(it != end);
+            ASSERT_EQ(token.kind, it->kind);
+            ASSERT_EQ(token.text, it->text);
+            it++;
+        }
+        ASSERT_TRUE(it == end);
+        ASSERT_EQ(expected.WithoutFormatTokens(), fmt.WithoutFormatTokens());
+    }
+}
+
+TEST_F(FormattingTests, reuse_tokens_changed_string)
+{
+    // Object strings are reallocated when objects are unloaded and loaded, the old tokens must not be reused
+    auto& localisationService = GetContext()->GetLocalisationService();
+    auto stringId = localisationService.AllocateObjectString("First {INT32}");
+    ASSERT_EQ("First 1", FormatStringId(stringId, 1));
+    localisationService.FreeObjectString(stringId);
+
+    auto newStringId = localisationService.AllocateObjectString("Second {COMMA16} {INT32}");
+    ASSERT_EQ("Second 1,000 2", FormatStringId(newStringId, 1000, 2));
+    localisationService.FreeObjectString(newStringId);
+}
+
 TEST_F(FormattingTests, format_number_basic)
 {
     FormatBuffer ss;
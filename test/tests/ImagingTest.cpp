@@ -0,0 +1,154 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <openrct2/core/FileSystem.hpp>
+#include <openrct2/core/Imaging.h>
+#include <string>
+#include <vector>
+
+class ImagingTest : public testing::Test
+{
+protected:
+    std::string _path;
+
+    void SetUp() override
+    {
+        const auto* testInfo = testing::UnitTest::GetInstance()->current_test_info();
+        _path = (fs::temp_directory_path() / (std::string("openrct2_") + testInfo->name() + ".png")).u8string();
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        fs::remove(fs::u8path(_path), ec);
+    }
+
+    std::vector<uint8_t> ReadFileBytes() const
+    {
+        std::ifstream fs(_path, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>());
+    }
+
+    static bool ContainsChunk(const std::vector<uint8_t>& file, const char* type)
+    {
+        return std::search(file.begin(), file.end(), type, type + 4) != file.end();
+    }
+
+    static Image CreateImage(uint32_t width, uint32_t height, uint32_t depth)
+    {
+        // Smooth gradients and noise, so that every filter gets picked for some rows
+        Image image;
+        image.Width = width;
+        image.Height = height;
+        image.Depth = depth;
+        image.Stride = width * (depth / 8);
+        image.Pixels.resize(static_cast<size_t>(image.Stride) * height);
+        uint32_t noise = 12345;
+        for (uint32_t y = 0; y < height; y++)
+        {
+            for (uint32_t x = 0; x < image.Stride; x++)
+            {
+                noise = noise * 1103515245 + 12345;
+                uint8_t value;
+                switch ((y / 16) % 4)
+                {
+                    case 0:
+                        value = static_cast<uint8_t>(x);
+                        break;
+                    case 1:
+                        value = static_cast<uint8_t>(y * 3);
+                        break;
+                    case 2:
+                        value = static_cast<uint8_t>(x + y);
+                        break;
+                    default:
+                        value = static_cast<uint8_t>(noise >> 16);
+                        break;
+                }
+                image.Pixels[static_cast<size_t>(y) * image.Stride + x] = value;
+            }
+        }
+        return image;
+    }
+};
+
+TEST_F(ImagingTest, write_read_32bpp)
+{
+    // Large enough for the image data to be compressed in several parallel blocks
+    auto image = CreateImage(640, 480, 32);
+    for (auto compression : { PngCompression::Fast, PngCompression::Default, PngCompression::Small })
+    {
+        Imaging::WriteToFile(_path, image, IMAGE_FORMAT::PNG_32, compression);
+        auto file = ReadFileBytes();
+        ASSERT_TRUE(ContainsChunk(file, "zTXt"));
+
+        auto result = Imaging::ReadFromFile(_path, IMAGE_FORMAT::PNG_32);
+        ASSERT_EQ(result.Width, image.Width);
+        ASSERT_EQ(result.Height, image.Height);
+        ASSERT_EQ(result.Pixels, image.Pixels);
+    }
+}
+
+TEST_F(ImagingTest, write_read_8bpp)
+{
+    auto image = CreateImage(700, 500, 8);
+    image.Palette = std::make_unique<GamePalette>();
+    for (uint16_t i = 0; i < PALETTE_SIZE; i++)
+    {
+        auto& entry = (*image.Palette)[i];
+        entry.Red = static_cast<uint8_t>(i);
+        entry.Green = static_cast<uint8_t>(255 - i);
+        entry.Blue = static_cast<uint8_t>(i * 7);
+    }
+    Imaging::WriteToFile(_path, image, IMAGE_FORMAT::PNG);
+    auto file = ReadFileBytes();
+    ASSERT_TRUE(ContainsChunk(file, "PLTE"));
+    ASSERT_TRUE(ContainsChunk(file, "tRNS"));
+    ASSERT_TRUE(ContainsChunk(file, "zTXt"));
+
+    auto indices = Imaging::ReadFromFile(_path, IMAGE_FORMAT::PNG);
+    ASSERT_EQ(indices.Width, image.Width);
+    ASSERT_EQ(indices.Height, image.Height);
+    ASSERT_TRUE(std::equal(image.Pixels.begin(), image.Pixels.end(), indices.Pixels.begin()));
+
+    // Expanded through the palette, with index 0 transparent
+    auto colours = Imaging::ReadFromFile(_path, IMAGE_FORMAT::PNG_32);
+    for (size_t i = 0; i < image.Pixels.size(); i++)
+    {
+        auto index = image.Pixels[i];
+        const auto& entry = (*image.Palette)[index];
+        ASSERT_EQ(colours.Pixels[i * 4 + 0], entry.Red);
+        ASSERT_EQ(colours.Pixels[i * 4 + 1], entry.Green);
+        ASSERT_EQ(colours.Pixels[i * 4 + 2], entry.Blue);
+        ASSERT_EQ(colours.Pixels[i * 4 + 3], index == 0 ? 0 : 255);
+    }
+}
+
+TEST_F(ImagingTest, write_read_strips)
+{
+    auto image = CreateImage(300, 200, 32);
+    {
+        Imaging::PngStripWriter writer(_path, image);
+        for (uint32_t y = 0; y < image.Height; y += 64)
+        {
+            auto rows = std::min<uint32_t>(64, image.Height - y);
+            writer.WriteRows(image.Pixels.data() + static_cast<size_t>(y) * image.Stride, rows, image.Stride);
+        }
+        writer.Finish();
+    }
+
+    auto result = Imaging::ReadFromFile(_path, IMAGE_FORMAT::PNG_32);
+    ASSERT_EQ(result.Width, image.Width);
+    ASSERT_EQ(result.Height, image.Height);
+    ASSERT_EQ(result.Pixels, image.Pixels);
+}
@@ -23,6 +23,9 @@ protected:
     static const std::string duplicate;
     static const std::string untrimmed;
     static const std::string caseInsensitive;
+    static const std::string crlf;
+    static const std::string unterminated;
+    static const std::string unterminatedCrlf;
 };
 
 static auto Enum_Currency = ConfigEnum<int32_t>({});
@@ -126,6 +129,44 @@ TEST_F(IniReaderTest, read_case_insensitive)
     ASSERT_EQ(ir->ReadSection("SeCtIoN"), true);
 }
 
+TEST_F(IniReaderTest, read_crlf)
+{
+    OpenRCT2::MemoryStream ms(crlf.c_str(), crlf.size());
+    auto ir = CreateIniReader(&ms);
+    ASSERT_NE(ir, nullptr);
+    ASSERT_EQ(ir->ReadSection("first"), true);
+    ASSERT_EQ(ir->GetBoolean("boolval", false), true);
+    ASSERT_EQ(ir->GetInt32("one", 42), 1);
+    // no carriage return may be left on the end of a value
+    ASSERT_EQ(ir->GetString("str", "yyy"), "  xxx ");
+    ASSERT_EQ(ir->GetString("unquoted", "yyy"), "abc");
+    ASSERT_EQ(ir->GetString("commented", "yyy"), "def");
+    ASSERT_EQ(ir->ReadSection("second"), true);
+    ASSERT_EQ(ir->GetInt32("two", 42), 2);
+    ASSERT_EQ(ir->GetString("last", "yyy"), "value");
+}
+
+TEST_F(IniReaderTest, read_unterminated_last_line)
+{
+    OpenRCT2::MemoryStream ms(unterminated.c_str(), unterminated.size());
+    auto ir = CreateIniReader(&ms);
+    ASSERT_NE(ir, nullptr);
+    ASSERT_EQ(ir->ReadSection("section"), true);
+    ASSERT_EQ(ir->GetInt32("one", 42), 1);
+    ASSERT_EQ(ir->GetString("last", "yyy"), "no newline");
+    ASSERT_EQ(ir->ReadSection("empty"), true);
+}
+
+TEST_F(IniReaderTest, read_unterminated_last_line_crlf)
+{
+    OpenRCT2::MemoryStream ms(unterminatedCrlf.c_str(), unterminatedCrlf.size());
+    auto ir = CreateIniReader(&ms);
+    ASSERT_NE(ir, nullptr);
+    ASSERT_EQ(ir->ReadSection("section"), true);
+    ASSERT_EQ(ir->GetInt32("one", 42), 1);
+    ASSERT_EQ(ir->GetInt32("last", 42), 7);
+}
+
 const std::string IniReaderTest::predefined = "[bool]\n"
                                               "boolval = true\n\n"
                                               "[int]\n"
@@ -151,3 +192,23 @@ const std::string IniReaderTest::untrimmed = "[section]\n"
 
 const std::string IniReaderTest::caseInsensitive = "[sEcTiOn]\n"
                                                    "foo = \"bar\"\n";
+
+const std::string IniReaderTest::crlf = "[first]\r\n"
+                                        "boolval = true\r\n"
+                                        "one = 1\r\n"
+                                        "str = \"  xxx \"\r\n"
+                                        "unquoted = abc\r\n"
+                                        "commented = def # comment\r\n"
+                                        "\r\n"
+                                        "[second]\r\n"
+                                        "two = 2\r\n"
+                                        "last = \"value\"\r\n";
+
+const std::string IniReaderTest::unterminated = "[section]\n"
+                                                "one = 1\n"
+                                                "last = \"no newline\"\n"
+                                                "[empty]";
+
+const std::string IniReaderTest::unterminatedCrlf = "[section]\r\n"
+                                                    "one = 1\r\n"
+                                                    "last = 7";
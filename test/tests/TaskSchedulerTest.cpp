@@ -0,0 +1,141 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <openrct2/core/TaskScheduler.h>
+#include <stdexcept>
+#include <thread>
+
+using namespace OpenRCT2;
+
+TEST(TaskSchedulerTest, RunsAllTasks)
+{
+    TaskScheduler scheduler(4);
+    std::atomic<int32_t> count{};
+    TaskGroup group(scheduler);
+    for (int32_t i = 0; i < 2000; i++)
+    {
+        group.Run([&count]() { count++; });
+    }
+    group.Wait();
+    ASSERT_EQ(count.load(), 2000);
+    ASSERT_EQ(group.CountPending(), 0U);
+}
+
+TEST(TaskSchedulerTest, SingleThread)
+{
+    TaskScheduler scheduler(1);
+    ASSERT_EQ(scheduler.CountThreads(), 1U);
+
+    int32_t count = 0;
+    TaskGroup group(scheduler);
+    for (int32_t i = 0; i < 100; i++)
+    {
+        group.Run([&count]() { count++; });
+    }
+    group.Wait();
+    ASSERT_EQ(count, 100);
+}
+
+TEST(TaskSchedulerTest, NestedRun)
+{
+    TaskScheduler scheduler(4);
+    std::atomic<int32_t> count{};
+    TaskGroup outer(scheduler);
+    for (int32_t i = 0; i < 16; i++)
+    {
+        outer.Run([&scheduler, &count]() {
+            // Waiting from inside a task runs the nested tasks on this thread or lets other threads take them.
+            TaskGroup inner(scheduler);
+            for (int32_t j = 0; j < 16; j++)
+            {
+                inner.Run([&count]() { count++; });
+            }
+            inner.Wait();
+            ASSERT_EQ(inner.CountPending(), 0U);
+        });
+    }
+    outer.Wait();
+    ASSERT_EQ(count.load(), 16 * 16);
+}
+
+TEST(TaskSchedulerTest, WaitForLongTasks)
+{
+    // The waiting thread has nothing left to run while the workers are busy, so it has to block until they finish.
+    TaskScheduler scheduler(3);
+    std::atomic<int32_t> count{};
+    TaskGroup group(scheduler);
+    for (int32_t i = 0; i < 3; i++)
+    {
+        group.Run([&count]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            count++;
+        });
+    }
+
+    int32_t numReports = 0;
+    group.Wait([&numReports]() { numReports++; });
+    ASSERT_EQ(count.load(), 3);
+    ASSERT_GE(numReports, 1);
+    ASSERT_LE(numReports, 3);
+}
+
+TEST(TaskSchedulerTest, TaskException)
+{
+    TaskScheduler scheduler(4);
+    std::atomic<int32_t> count{};
+    TaskGroup group(scheduler);
+    for (int32_t i = 0; i < 100; i++)
+    {
+        group.Run([&count, i]() {
+            if (i == 50)
+                throw std::runtime_error("task failed");
+            count++;
+        });
+    }
+    ASSERT_THROW(group.Wait(), std::runtime_error);
+
+    // The other tasks still ran, and the exception is only thrown once.
+    ASSERT_EQ(count.load(), 99);
+    ASSERT_EQ(group.CountPending(), 0U);
+    group.Run([&count]() { count++; });
+    ASSERT_NO_THROW(group.Wait());
+    ASSERT_EQ(count.load(), 100);
+}
+
+TEST(TaskSchedulerTest, NestedTaskException)
+{
+    TaskScheduler scheduler(4);
+    TaskGroup outer(scheduler);
+    outer.Run([&scheduler]() {
+        TaskGroup inner(scheduler);
+        inner.Run([]() { throw std::logic_error("nested task failed"); });
+        inner.Wait();
+    });
+    ASSERT_THROW(outer.Wait(), std::logic_error);
+}
+
+TEST(TaskSchedulerTest, DestroyWithoutWait)
+{
+    TaskScheduler scheduler(2);
+    std::atomic<int32_t> count{};
+    {
+        TaskGroup group(scheduler);
+        for (int32_t i = 0; i < 10; i++)
+        {
+            group.Run([&count]() {
+                count++;
+                throw std::runtime_error("not waited for");
+            });
+        }
+    }
+    ASSERT_EQ(count.load(), 10);
+}
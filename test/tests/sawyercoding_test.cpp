@@ -7,10 +7,13 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <iterator>
 #include <openrct2/core/MemoryStream.h>
 #include <openrct2/rct12/SawyerChunkReader.h>
 #include <openrct2/util/SawyerCoding.h>
+#include <vector>
 
 constexpr size_t BUFFER_SIZE = 0x600000;
 
@@ -89,6 +92,64 @@ TEST_F(SawyerCodingTest, write_read_chunk_rotate)
     test_encode_decode(CHUNK_ENCODING_ROTATE);
 }
 
+TEST_F(SawyerCodingTest, write_read_chunk_rotate_odd_lengths)
+{
+    // The rotation is done four bytes at a time, check every length of leftover bytes against the plain byte loop
+    for (size_t length : { 1, 2, 3, 4, 5, 6, 7, 9, 1021, 1022, 1023 })
+    {
+        sawyercoding_chunk_header chdr_in;
+        chdr_in.encoding = CHUNK_ENCODING_ROTATE;
+        chdr_in.length = static_cast<uint32_t>(length);
+        std::vector<uint8_t> encodedData(length + sizeof(sawyercoding_chunk_header));
+        size_t encodedDataSize = sawyercoding_write_chunk_buffer(encodedData.data(), randomdata, chdr_in);
+        ASSERT_EQ(encodedDataSize, encodedData.size());
+
+        uint8_t code = 1;
+        for (size_t i = 0; i < length; i++)
+        {
+            auto expected = static_cast<uint8_t>((randomdata[i] << code) | (randomdata[i] >> (8 - code)));
+            ASSERT_EQ(encodedData[sizeof(sawyercoding_chunk_header) + i], expected) << "length " << length << ", byte " << i;
+            code = (code + 2) % 8;
+        }
+
+        OpenRCT2::MemoryStream ms(encodedData.data(), encodedData.size());
+        SawyerChunkReader reader(&ms);
+        auto chunk = reader.ReadChunk();
+        ASSERT_EQ(chunk->GetEncoding(), SAWYER_ENCODING::ROTATE);
+        ASSERT_EQ(chunk->GetLength(), length);
+        ASSERT_EQ(memcmp(chunk->GetData(), randomdata, length), 0);
+    }
+}
+
+TEST_F(SawyerCodingTest, write_read_chunks_in_place)
+{
+    // Chunks are encoded straight into the destination one after the other, as they are when saving a park
+    constexpr uint8_t encodings[] = {
+        CHUNK_ENCODING_RLE, CHUNK_ENCODING_ROTATE, CHUNK_ENCODING_RLECOMPRESSED, CHUNK_ENCODING_NONE, CHUNK_ENCODING_RLE,
+    };
+    std::vector<uint8_t> encodedData(BUFFER_SIZE, 0xCD);
+    size_t encodedDataSize = 0;
+    for (size_t i = 0; i < std::size(encodings); i++)
+    {
+        sawyercoding_chunk_header chdr_in;
+        chdr_in.encoding = encodings[i];
+        chdr_in.length = static_cast<uint32_t>(sizeof(randomdata) - i);
+        encodedDataSize += sawyercoding_write_chunk_buffer(encodedData.data() + encodedDataSize, randomdata + i, chdr_in);
+    }
+    ASSERT_TRUE(std::all_of(encodedData.begin() + encodedDataSize, encodedData.end(), [](uint8_t b) { return b == 0xCD; }));
+
+    OpenRCT2::MemoryStream ms(encodedData.data(), encodedDataSize);
+    SawyerChunkReader reader(&ms);
+    for (size_t i = 0; i < std::size(encodings); i++)
+    {
+        auto chunk = reader.ReadChunk();
+        ASSERT_EQ(static_cast<uint8_t>(chunk->GetEncoding()), encodings[i]);
+        ASSERT_EQ(chunk->GetLength(), sizeof(randomdata) - i);
+        ASSERT_EQ(memcmp(chunk->GetData(), randomdata + i, sizeof(randomdata) - i), 0);
+    }
+    ASSERT_EQ(ms.GetPosition(), encodedDataSize);
+}
+
 // Note we only check if provided data decompresses to the same data, not if it compresses the same.
 // The reason for that is we may improve encoding at some point, but the test won't be affected,
 // as we already do a decode test and roundtrip (encode + decode), which validates all uses.